@@ -76,6 +76,10 @@ public:	//	CLASS METHODS
 		@param[out]	outPackets			Receives the packets found.
 		@param[in]	inFrameNum			If non-zero, specifies/sets the frame identifier for the packets.
 		@return		AJA_STATUS_SUCCESS if successful.
+		@note		The VANC lines are searched in place (without unpacking them), and lines without any ancillary data
+					flags are skipped quickly. The packets found are the same as those AJAAncillaryData::GetAncPacketsFromVANCLine
+					would find in each line unpacked by ::UnpackLine_10BitYUVtoUWordSequence or
+					AJAAncillaryData::Unpack8BitYCbCrToU16sVANCLine (or its SD variant).
 		@bug		The ::AJAAncDataLink in the ::AJAAncillaryDataLocation in each of the returned packets
 					is currently ::AJAAncDataLink_A, which will be incorrect if, for example, the FrameStore
 					that delivered the \c inFrameBuffer was sourced from the "B" link of a Dual-Link SDI source.
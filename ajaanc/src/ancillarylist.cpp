@@ -17,6 +17,10 @@
 #if defined(AJAANCLISTIMPL_VECTOR)
 	#include <algorithm>
 #endif
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+	#define AJA_ANCLIST_SSE2
+	#include <emmintrin.h>
+#endif
 
 using namespace std;
 
@@ -880,6 +884,138 @@ AJAStatus AJAAncillaryList::AddVANCData (const UWordSequence & inPacketWords, co
 }	//	AddVANCData
 
 
+//	VANC line scanning:  SetFromVANCData searches the packed 'v210' or '2vuy' VANC lines in place, rather than unpacking
+//	each of them into a UWordSequence and scanning it word-by-word (twice in HD). The results are identical to
+//	AJAAncillaryData::GetAncPacketsFromVANCLine applied to the unpacked line.
+
+//	Returns the given 10-bit component of a packed 'v210' line
+static inline UWord V210Component (const ULWord * pInLine, const ULWord inNdx)
+{
+	return UWord((pInLine[inNdx / 3] >> (10 * (inNdx % 3))) & 0x3FF);
+}
+
+//	Returns the index of the first 10-bit component at or after inNdx that's 0x3FF, or inCount if there's none.
+//	Every ancillary data flag contains 0x3FF, which is excluded from video data, so lines without any are skipped.
+static ULWord V210Find3FF (const ULWord * pInLine, const ULWord inNdx, const ULWord inCount)
+{
+	const ULWord	numWords	((inCount + 2) / 3);
+	ULWord			word		(inNdx / 3);
+	for (ULWord ndx(inNdx);  ndx < (word + 1) * 3  &&  ndx < inCount;  ndx++)	//	Rest of the first word
+		if (V210Component(pInLine, ndx) == 0x3FF)
+			return ndx;
+	word++;
+#if defined(AJA_ANCLIST_SSE2)
+	const __m128i	mask0	(_mm_set1_epi32(0x3FF));
+	const __m128i	mask1	(_mm_set1_epi32(0x3FF << 10));
+	const __m128i	mask2	(_mm_set1_epi32(0x3FF << 20));
+	for (;  word + 4 <= numWords;  word += 4)
+	{	//	Test 12 components at a time...
+		const __m128i	words	(_mm_loadu_si128(reinterpret_cast<const __m128i*>(pInLine + word)));
+		const __m128i	hits	(_mm_or_si128(_mm_or_si128(_mm_cmpeq_epi32(_mm_and_si128(words, mask0), mask0),
+																_mm_cmpeq_epi32(_mm_and_si128(words, mask1), mask1)),
+																_mm_cmpeq_epi32(_mm_and_si128(words, mask2), mask2)));
+		if (_mm_movemask_epi8(hits))
+			break;	//	Found one -- pinpoint it below
+	}
+#endif	//	AJA_ANCLIST_SSE2
+	for (;  word < numWords;  word++)
+	{
+		const ULWord	value	(pInLine[word]);
+		if ((value & 0x3FF) == 0x3FF  ||  (value & (0x3FF << 10)) == (0x3FF << 10)  ||  (value & (0x3FF << 20)) == (0x3FF << 20))
+			for (ULWord ndx(word * 3);  ndx < (word + 1) * 3  &&  ndx < inCount;  ndx++)
+				if (V210Component(pInLine, ndx) == 0x3FF)
+					return ndx;
+	}
+	return inCount;
+}
+
+//	Adds the packets found in one channel of a packed 'v210' VANC line to outPkts.
+//	inFirst/inIncr select the channel:  0/2 for chroma (C), 1/2 for luma (Y), or 0/1 for both (SD).
+static void AddV210LinePackets (const ULWord * pInLine, const ULWord inCount, const ULWord inFirst, const ULWord inIncr,
+								AJAAncDataLoc inLoc, AJAAncillaryList & outPkts, const uint32_t inFrameNum,
+								AJAAncillaryData::U16Packet & pkt)
+{
+	if (inCount < 12)
+		return;
+	const ULWord	limit	(inCount - 12);	//	Same search limit as GetAncPacketsFromVANCLine
+	ULWord			ndx		(inFirst);
+	while (ndx < limit)
+	{
+		//	An ADF's 2nd word must be 0x3FF, so skip straight to the next 0x3FF (in either channel)...
+		const ULWord	hit	(V210Find3FF(pInLine, ndx + inIncr, inCount));
+		if (hit >= inCount)
+			return;
+		if (hit - inIncr > ndx)
+			ndx = hit - inIncr + ((hit - inIncr - inFirst) % inIncr);	//	Stay in my channel
+		if (ndx >= limit)
+			return;
+		if (V210Component(pInLine, ndx) == 0x000
+			&&  V210Component(pInLine, ndx + inIncr) == 0x3FF
+			&&  V210Component(pInLine, ndx + 2 * inIncr) == 0x3FF)
+		{
+			const ULWord	totalCount	(7 + (V210Component(pInLine, ndx + 5 * inIncr) & 0xFF));	//	ADF + DID + SDID + DC + UDWs + CS
+			if (ndx + totalCount >= inCount  ||  ndx + (totalCount - 1) * inIncr >= inCount)
+				{LOGMYDEBUG("past end of line: " << ndx << " + " << totalCount << " >= " << inCount);  return;}
+
+			//	Gather the packet, checking parity and checksum as we go...
+			UWord	sum	(0);
+			pkt.resize(totalCount);
+			for (ULWord word(0);  word < totalCount;  word++)
+			{
+				const UWord	value	(V210Component(pInLine, ndx + word * inIncr));
+				pkt[word] = value;
+				if (word < 3  ||  word == totalCount - 1)
+					continue;	//	Skip ADF and checksum
+				if (value != AJAAncillaryData::AddEvenParity(UByte(value)))
+					{LOGMYERROR("Parity error at word " << word << ": " << xHEX0N(value,3));  return;}
+				sum += value & 0x1FF;
+			}
+			const UWord	checksum	(pkt[totalCount - 1]);
+			if (((checksum & BIT(8)) != 0) == ((checksum & BIT(9)) != 0)  ||  (sum & 0x1FF) != (checksum & 0x1FF))
+				{LOGMYERROR("Checksum error: got " << xHEX0N(checksum,3) << ", expected " << xHEX0N(sum & 0x1FF,3));  return;}
+			outPkts.AddVANCData (pkt, inLoc.SetHorizontalOffset(uint16_t(ndx)), inFrameNum);
+		}
+		ndx += inIncr;
+	}	//	scan the line
+}
+
+//	Adds the packets found in one channel of a packed '2vuy' VANC line to outPkts.
+//	Like Unpack8BitYCbCrToU16sVANCLine, this expects the packets to start at the first sample and to follow each other without
+//	gaps, stretches the 8-bit data words to 10 bits with even parity, and recalculates the checksum.
+//	inFirst/inIncr select the channel:  0/2 for chroma (C), 1/2 for luma (Y), or 0/1 for both (SD).
+static void Add2vuyLinePackets (const UByte * pInLine, const ULWord inCount, const ULWord inFirst, const ULWord inIncr,
+								AJAAncDataLoc inLoc, AJAAncillaryList & outPkts, const uint32_t inFrameNum,
+								AJAAncillaryData::U16Packet & pkt)
+{
+	const ULWord	numSamples	(inIncr > 1 ? inCount / 2 : inCount);	//	Samples in my channel
+	if (inCount < 24  ||  (inCount / 2) % 4)
+		return;	//	Unpack8BitYCbCrToU16sVANCLine requires at least 12 pixels, a multiple of 4
+	for (ULWord sample(0);  sample + 7 < numSamples;  )
+	{
+		const ULWord	ndx	(inFirst + sample * inIncr);
+		if (pInLine[ndx] != 0x00  ||  pInLine[ndx + inIncr] != 0xFF  ||  pInLine[ndx + 2 * inIncr] != 0xFF)
+			return;	//	No more packets on this line
+		if (ndx >= inCount - 12)
+			return;	//	Same search limit as GetAncPacketsFromVANCLine
+		const ULWord	totalCount	(7 + pInLine[ndx + 5 * inIncr]);	//	ADF + DID + SDID + DC + UDWs + CS
+		if (ndx + totalCount >= inCount  ||  sample + totalCount > numSamples)
+			{LOGMYDEBUG("past end of line: " << ndx << " + " << totalCount << " >= " << inCount);  return;}
+
+		UWord	sum	(0);
+		pkt.resize(totalCount);
+		pkt[0] = 0x000;  pkt[1] = 0x3FF;  pkt[2] = 0x3FF;
+		for (ULWord word(3);  word < totalCount - 1;  word++)
+		{
+			pkt[word] = AJAAncillaryData::AddEvenParity(pInLine[ndx + word * inIncr]);
+			sum += pkt[word] & 0x1FF;
+		}
+		pkt[totalCount - 1] = UWord((sum & 0x1FF) | ((~sum & 0x100) << 1));
+		outPkts.AddVANCData (pkt, inLoc.SetHorizontalOffset(uint16_t(ndx)), inFrameNum);
+		sample += totalCount;
+	}
+}
+
+
 AJAStatus AJAAncillaryList::SetFromVANCData (const NTV2Buffer &		inFB,
 											const NTV2FormatDesc &	inFD,
 											AJAAncillaryList &		outPkts,
@@ -916,54 +1052,41 @@ AJAStatus AJAAncillaryList::SetFromVANCData (const NTV2Buffer &		inFB,
 		return AJA_STATUS_UNSUPPORTED;	//	Only 'v210' and '2vuy' currently supported
 	}
 
+	const ULWord			numComponents	(fbf == NTV2_FBF_10BIT_YCBCR  ?  inFD.linePitch * 3  :  inFD.GetRasterWidth() * 2);
+	const AJAAncDataLink	defaultLink		(AJAAncDataLink_A);	//	This is most common
+	AJAAncillaryData::U16Packet	pkt;	//	Reused for each packet found
 	for (ULWord lineOffset (0);	 lineOffset < inFD.GetFirstActiveLine();  lineOffset++)
 	{
-		UWordSequence	uwords;
 		bool			isF2			(false);
 		ULWord			smpteLineNum	(0);
-		unsigned		ndx				(0);
-		const AJAAncDataLink	defaultLink (AJAAncDataLink_A);	//	This is most common
-
-		inFD.GetSMPTELineNumber (lineOffset, smpteLineNum, isF2);
+		const void *	pLine			(inFD.GetRowAddress(inFB.GetHostAddress(0), lineOffset));
 		if (fbf == NTV2_FBF_10BIT_YCBCR)
-			::UnpackLine_10BitYUVtoUWordSequence (inFD.GetRowAddress(inFB.GetHostAddress(0), lineOffset), inFD, uwords);
-		else if (isSD)
-			AJAAncillaryData::Unpack8BitYCbCrToU16sVANCLineSD (inFD.GetRowAddress(inFB.GetHostAddress(0), lineOffset),
-																uwords, inFD.GetRasterWidth());
-		else
-			AJAAncillaryData::Unpack8BitYCbCrToU16sVANCLine (inFD.GetRowAddress(inFB.GetHostAddress(0), lineOffset),
-															uwords,	 inFD.GetRasterWidth());
-		if (isSD)
 		{
-			AJAAncillaryData::U16Packets	ycPackets;
-			UWordSequence					ycHOffsets;
-			AJAAncDataLoc					loc (defaultLink, AJAAncDataChannel_Both, AJAAncDataSpace_VANC, uint16_t(smpteLineNum));
-
-			AJAAncillaryData::GetAncPacketsFromVANCLine (uwords, AncChannelSearch_Both, ycPackets, ycHOffsets);
-			NTV2_ASSERT(ycPackets.size() == ycHOffsets.size());
-
-			for (AJAAncillaryData::U16Packets::const_iterator it(ycPackets.begin());  it != ycPackets.end();  ++it, ndx++)
-				outPkts.AddVANCData (*it, loc.SetHorizontalOffset(ycHOffsets[ndx]), inFrameNum);
+			const ULWord *	pV210	(reinterpret_cast<const ULWord*>(pLine));
+			if (V210Find3FF(pV210, 0, numComponents) >= numComponents)
+				continue;	//	No ancillary data flags on this line
+			inFD.GetSMPTELineNumber (lineOffset, smpteLineNum, isF2);
+			if (isSD)
+				AddV210LinePackets (pV210, numComponents, 0, 1, AJAAncDataLoc(defaultLink, AJAAncDataChannel_Both, AJAAncDataSpace_VANC, uint16_t(smpteLineNum)), outPkts, inFrameNum, pkt);
+			else
+			{
+				AddV210LinePackets (pV210, numComponents, 1, 2, AJAAncDataLoc(defaultLink, AJAAncDataChannel_Y, AJAAncDataSpace_VANC, uint16_t(smpteLineNum)), outPkts, inFrameNum, pkt);
+				AddV210LinePackets (pV210, numComponents, 0, 2, AJAAncDataLoc(defaultLink, AJAAncDataChannel_C, AJAAncDataSpace_VANC, uint16_t(smpteLineNum)), outPkts, inFrameNum, pkt);
+			}
 		}
 		else
 		{
-			AJAAncillaryData::U16Packets	yPackets, cPackets;
-			UWordSequence					yHOffsets, cHOffsets;
-			AJAAncDataLoc					yLoc	(defaultLink, AJAAncDataChannel_Y, AJAAncDataSpace_VANC, uint16_t(smpteLineNum));
-			AJAAncDataLoc					cLoc	(defaultLink, AJAAncDataChannel_C, AJAAncDataSpace_VANC, uint16_t(smpteLineNum));
-			//cerr << endl << "SetFromVANCData: +" << DEC0N(lineOffset,2) << ": ";	inFD.PrintSMPTELineNumber(cerr, lineOffset);  cerr << ":" << endl << uwords << endl;
-			AJAAncillaryData::GetAncPacketsFromVANCLine (uwords, AncChannelSearch_Y, yPackets, yHOffsets);
-			AJAAncillaryData::GetAncPacketsFromVANCLine (uwords, AncChannelSearch_C, cPackets, cHOffsets);
-			NTV2_ASSERT(yPackets.size() == yHOffsets.size());
-			NTV2_ASSERT(cPackets.size() == cHOffsets.size());
-
-			unsigned	ndxx(0);
-			for (AJAAncillaryData::U16Packets::const_iterator it(yPackets.begin());	 it != yPackets.end();	++it, ndxx++)
-				outPkts.AddVANCData (*it, yLoc.SetHorizontalOffset(yHOffsets[ndxx]), inFrameNum);
-
-			ndxx = 0;
-			for (AJAAncillaryData::U16Packets::const_iterator it(cPackets.begin());	 it != cPackets.end();	++it, ndxx++)
-				outPkts.AddVANCData (*it, cLoc.SetHorizontalOffset(cHOffsets[ndxx]), inFrameNum);
+			const UByte *	p2vuy	(reinterpret_cast<const UByte*>(pLine));
+			if (p2vuy[0]  &&  p2vuy[1])
+				continue;	//	Packets must start at the first pixel -- nothing on this line
+			inFD.GetSMPTELineNumber (lineOffset, smpteLineNum, isF2);
+			if (isSD)
+				Add2vuyLinePackets (p2vuy, numComponents, 0, 1, AJAAncDataLoc(defaultLink, AJAAncDataChannel_Both, AJAAncDataSpace_VANC, uint16_t(smpteLineNum)), outPkts, inFrameNum, pkt);
+			else
+			{
+				Add2vuyLinePackets (p2vuy, numComponents, 1, 2, AJAAncDataLoc(defaultLink, AJAAncDataChannel_Y, AJAAncDataSpace_VANC, uint16_t(smpteLineNum)), outPkts, inFrameNum, pkt);
+				Add2vuyLinePackets (p2vuy, numComponents, 0, 2, AJAAncDataLoc(defaultLink, AJAAncDataChannel_C, AJAAncDataSpace_VANC, uint16_t(smpteLineNum)), outPkts, inFrameNum, pkt);
+			}
 		}
 	}	//	for each VANC line
 	LOGMYDEBUG("returning " << outPkts);
@@ -12,6 +12,7 @@
 #include "ajabase/common/options_popt.h"
 #include "ajabase/common/performance.h"
 #include "ajabase/system/debug.h"
+#include "ajabase/system/systemtime.h"
 #include "ancillarydata_cea608_line21.h"
 #include "ancillarydata_cea608_vanc.h"
 #include "ancillarydata_cea708.h"
@@ -2358,6 +2359,154 @@ for (unsigned lineOffset(0);  lineOffset < fd.GetFirstActiveLine();  lineOffset+
 		}	//	TEST_CASE("BFT_FBYUV10ToAncListToFBYUV10")
 
 
+//	The way AJAAncillaryList::SetFromVANCData used to work (unpacking each VANC line, then scanning it word-by-word),
+//	used as the reference for BFT_SetFromVANCDataInPlace...
+static void UnpackedSetFromVANCData (const NTV2Buffer & inFB, const NTV2FormatDescriptor & inFD, AJAAncillaryList & outPkts)
+{
+	outPkts.Clear();
+	const bool	isSD	(inFD.IsSD());
+	for (ULWord lineOffset(0);  lineOffset < inFD.GetFirstActiveLine();  lineOffset++)
+	{
+		UWordSequence	uwords;
+		ULWord			smpteLineNum(0);
+		bool			isF2(false);
+		const void *	pLine	(inFD.GetRowAddress(inFB.GetHostPointer(), lineOffset));
+		inFD.GetSMPTELineNumber(lineOffset, smpteLineNum, isF2);
+		if (inFD.GetPixelFormat() == NTV2_FBF_10BIT_YCBCR)
+			::UnpackLine_10BitYUVtoUWordSequence(pLine, inFD, uwords);
+		else if (isSD)
+			AJAAncillaryData::Unpack8BitYCbCrToU16sVANCLineSD(pLine, uwords, inFD.GetRasterWidth());
+		else
+			AJAAncillaryData::Unpack8BitYCbCrToU16sVANCLine(pLine, uwords, inFD.GetRasterWidth());
+		const AncChannelSearchSelect	searches[]	=	{isSD ? AncChannelSearch_Both : AncChannelSearch_Y,  AncChannelSearch_C};
+		const AJAAncDataChannel			channels[]	=	{isSD ? AJAAncDataChannel_Both : AJAAncDataChannel_Y,  AJAAncDataChannel_C};
+		for (unsigned chan(0);  chan < (isSD ? 1U : 2U);  chan++)
+		{
+			AJAAncillaryData::U16Packets	pkts;
+			UWordSequence					hOffsets;
+			AJAAncDataLoc					loc	(AJAAncDataLink_A, channels[chan], AJAAncDataSpace_VANC, uint16_t(smpteLineNum));
+			AJAAncillaryData::GetAncPacketsFromVANCLine(uwords, searches[chan], pkts, hOffsets);
+			for (size_t ndx(0);  ndx < pkts.size();  ndx++)
+				outPkts.AddVANCData(pkts[ndx], loc.SetHorizontalOffset(hOffsets[ndx]));
+		}
+	}
+}
+
+static void PutV210Component (NTV2Buffer & inFB, const NTV2FormatDescriptor & inFD, const ULWord inLineOffset, const ULWord inNdx, const ULWord inValue)
+{
+	ULWord *	pLine	(reinterpret_cast<ULWord*>(inFD.GetWriteableRowAddress(inFB.GetHostPointer(), inLineOffset)));
+	const ULWord	shift	(10 * (inNdx % 3));
+	pLine[inNdx / 3] = (pLine[inNdx / 3] & ~ULWord(0x3FF << shift)) | (inValue << shift);
+}
+
+		TEST_CASE("BFT_SetFromVANCDataInPlace")
+		{
+			const NTV2VideoFormat	vFormats[]	=	{NTV2_FORMAT_525_5994, NTV2_FORMAT_625_5000, NTV2_FORMAT_720p_5994, NTV2_FORMAT_1080i_5994, NTV2_FORMAT_1080p_3000};
+			const NTV2PixelFormat	pFormats[]	=	{NTV2_FBF_10BIT_YCBCR, NTV2_FBF_8BIT_YCBCR};
+			std::mt19937	gen(12345);
+			for (unsigned fmtNdx(0);  fmtNdx < sizeof(vFormats)/sizeof(NTV2VideoFormat);  fmtNdx++)
+				for (unsigned pfNdx(0);  pfNdx < sizeof(pFormats)/sizeof(NTV2PixelFormat);  pfNdx++)
+			{
+				const NTV2FormatDescriptor	fd	(vFormats[fmtNdx], pFormats[pfNdx], NTV2_VANCMODE_TALLER);
+				const bool					is10Bit	(fd.GetPixelFormat() == NTV2_FBF_10BIT_YCBCR);
+				NTV2Buffer					vanc	(fd.GetTotalRasterBytes() - fd.GetVisibleRasterBytes());	//	Just the VANC lines
+
+				//	Fill the VANC lines with noise that has no ancillary data flags in it...
+				std::uniform_int_distribution<>	noise10(0x040, 0x3AC), noise8(0x01, 0xFE);
+				for (ULWord lineOffset(0);  lineOffset < fd.GetFirstActiveLine();  lineOffset++)
+					for (ULWord ndx(0);  ndx < fd.GetBytesPerRow();  ndx += 4)
+					{
+						ULWord &	word	(reinterpret_cast<ULWord*>(fd.GetWriteableRowAddress(vanc.GetHostPointer(), lineOffset))[ndx / 4]);
+						word = is10Bit	?  ULWord(noise10(gen)) | ULWord(noise10(gen)) << 10 | ULWord(noise10(gen)) << 20
+										:  ULWord(noise8(gen)) | ULWord(noise8(gen)) << 8 | ULWord(noise8(gen)) << 16 | ULWord(noise8(gen)) << 24;
+					}
+
+				//	Transmit some packets into it...
+				AJAAncillaryList	txPkts;
+				AJAAncDataLoc		loc;
+				loc.SetDataLink(AJAAncDataLink_A).SetHorizontalOffset(AJAAncDataHorizOffset_AnyVanc);
+				for (UByte pktNdx(0);  pktNdx < 6;  pktNdx++)
+				{
+					AJAAncillaryData	pkt;
+					UByteSequence		payload(size_t(pktNdx * 37 + 1));
+					for (size_t ndx(0);  ndx < payload.size();  ndx++)
+						payload[ndx] = UByte(ndx * 7 + pktNdx);
+					CHECK(AJA_SUCCESS(pkt.SetDataLocation(loc.SetDataChannel(fd.IsSD() ? AJAAncDataChannel_Both : (pktNdx & 1 ? AJAAncDataChannel_C : AJAAncDataChannel_Y))
+																.SetLineNumber(uint16_t(10 + (fd.IsSD() ? pktNdx : pktNdx / 2))))));
+					CHECK(AJA_SUCCESS(pkt.SetDataCoding(AJAAncDataCoding_Digital)));
+					CHECK(AJA_SUCCESS(pkt.SetDID(UByte(0x50 + pktNdx))));
+					CHECK(AJA_SUCCESS(pkt.SetSID(0x01)));
+					CHECK(AJA_SUCCESS(pkt.SetPayloadData(&payload[0], uint32_t(payload.size()))));
+					CHECK(AJA_SUCCESS(txPkts.AddAncillaryData(pkt)));
+				}
+				txPkts.GetVANCTransmitData (vanc, fd);
+
+				//	Add some stray 0x3FFs, and a bogus (bad parity) packet on its own line...
+				if (is10Bit)
+				{
+					const ULWord	numComponents	(fd.linePitch * 3);
+					for (ULWord lineOffset(0);  lineOffset < fd.GetFirstActiveLine();  lineOffset += 3)
+					{
+						PutV210Component(vanc, fd, lineOffset, (lineOffset * 97) % (numComponents - 400) + 200, 0x3FF);
+						PutV210Component(vanc, fd, lineOffset, (lineOffset * 97) % (numComponents - 400) + 201, 0x3FF);
+					}
+					const ULWord	lastLine	(fd.GetFirstActiveLine() - 1);
+					static const ULWord	sBogus[]	=	{0x000, 0x3FF, 0x3FF, 0x1FF, 0x101, 0x102, 0x123, 0x045, 0x200};
+					for (ULWord ndx(0);  ndx < sizeof(sBogus)/sizeof(ULWord);  ndx++)
+						PutV210Component(vanc, fd, lastLine, 101 + ndx * (fd.IsSD() ? 1 : 2), sBogus[ndx]);
+				}
+				else
+				{	//	A packet of noise at the start of the last line...
+					UByte *	pLine	(reinterpret_cast<UByte*>(fd.GetWriteableRowAddress(vanc.GetHostPointer(), fd.GetFirstActiveLine() - 1)));
+					pLine[fd.IsSD() ? 0 : 1] = 0x00;  pLine[fd.IsSD() ? 1 : 3] = 0xFF;  pLine[fd.IsSD() ? 2 : 5] = 0xFF;
+				}
+
+				AJAAncillaryList	expected, actual;
+				UnpackedSetFromVANCData (vanc, fd, expected);
+				CHECK(AJA_SUCCESS(AJAAncillaryList::SetFromVANCData(vanc, fd, actual, 0)));
+				CHECK(expected.CountAncillaryData() >= 6);
+				CHECK_EQ(actual.CountAncillaryData(), expected.CountAncillaryData());
+				CHECK(AJA_SUCCESS(actual.Compare(expected,  false/*ignoreLocation?*/,  false/*ignoreChecksum?*/)));
+				for (uint32_t ndx(0);  ndx < actual.CountAncillaryData()  &&  ndx < expected.CountAncillaryData();  ndx++)
+					CHECK_EQ(actual.GetAncillaryDataAtIndex(ndx)->GetLocationHorizOffset(), expected.GetAncillaryDataAtIndex(ndx)->GetLocationHorizOffset());
+			}	//	for each video format & pixel format
+
+			//	Time a typical 1080i 'v210' capture:  a few lines with packets, the rest blank...
+			const NTV2FormatDescriptor	fd	(NTV2_FORMAT_1080i_5994, NTV2_FBF_10BIT_YCBCR, NTV2_VANCMODE_TALLER);
+			NTV2Buffer					vanc (fd.GetTotalRasterBytes() - fd.GetVisibleRasterBytes());
+			for (ULWord ndx(0);  ndx < vanc.GetByteCount() / 4;  ndx++)
+				vanc.U32(int(ndx)) = (ndx & 1) ? 0x20010200 : 0x04080040;	//	Black
+			AJAAncillaryData	pktCustom;
+			static const uint8_t	pCustomData[]	=	{	0x01, 0x02, 0x03, 0x04, 0x05, 0x06, 0x07, 0x09, 0x0A	};
+			CHECK(AJA_SUCCESS(pktCustom.SetDataLocation(AJAAncDataLoc(AJAAncDataLink_A, AJAAncDataChannel_C, AJAAncDataSpace_VANC, 12, AJAAncDataHorizOffset_AnyVanc))));
+			CHECK(AJA_SUCCESS(pktCustom.SetDataCoding(AJAAncDataCoding_Digital)));
+			CHECK(AJA_SUCCESS(pktCustom.SetDID(0x7A)));
+			CHECK(AJA_SUCCESS(pktCustom.SetSID(0x01)));
+			CHECK(AJA_SUCCESS(pktCustom.SetPayloadData(pCustomData, sizeof(pCustomData))));
+			AJAAncillaryData_HDR_HLG		pktHDR;
+			CHECK(AJA_SUCCESS(pktHDR.GeneratePayloadData()));
+			AJAAncillaryList	txPkts;
+			CHECK(AJA_SUCCESS(txPkts.AddAncillaryData(pktCustom)));
+			CHECK(AJA_SUCCESS(txPkts.AddAncillaryData(pktHDR)));
+			CHECK(AJA_SUCCESS(txPkts.GetVANCTransmitData(vanc, fd)));
+
+			const unsigned	numFrames	(100);
+			AJAAncillaryList	rxPkts;
+			uint64_t	startUs	(AJATime::GetSystemMicroseconds());
+			for (unsigned frame(0);  frame < numFrames;  frame++)
+				UnpackedSetFromVANCData (vanc, fd, rxPkts);
+			const uint64_t	unpackedUs	(AJATime::GetSystemMicroseconds() - startUs);
+			CHECK_EQ(rxPkts.CountAncillaryData(), 2);
+			startUs = AJATime::GetSystemMicroseconds();
+			for (unsigned frame(0);  frame < numFrames;  frame++)
+				AJAAncillaryList::SetFromVANCData (vanc, fd, rxPkts);
+			const uint64_t	inPlaceUs	(AJATime::GetSystemMicroseconds() - startUs);
+			CHECK_EQ(rxPkts.CountAncillaryData(), 2);
+			MESSAGE("SetFromVANCData 1080i v210 (" << fd.GetFirstActiveLine() << " VANC lines): unpacked " << unpackedUs / numFrames
+					<< "us/frame, in place " << inPlaceUs / numFrames << "us/frame");
+		}	//	TEST_CASE("BFT_SetFromVANCDataInPlace")
+
+
 		TEST_CASE("BFT_AddFromDeviceAncBuffer")
 		{	//	This test is intended to elicit crashes (access violations), not to validate outcomes
 			AJAAncillaryList pkts;
@@ -312,6 +312,11 @@
 	#define NULL_PTR (0)
 #endif
 
+//	Defined if the compiler may emit SSE2 instructions (always true for x86-64), so SSE2 intrinsics can be used
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+	#define AJA_HAS_SSE2
+#endif
+
 
 /** 
  *	Macro to define a FourCC. Example: AJA_FCC("dvc ")
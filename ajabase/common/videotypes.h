@@ -266,6 +266,15 @@ enum AJA_VideoConversion
 };
 
 
+enum AJA_ColorMatrix
+{
+	AJA_ColorMatrix_Rec601,				/**< ITU-R BT.601 (SD) */
+	AJA_ColorMatrix_Rec709,				/**< ITU-R BT.709 (HD) */
+	AJA_ColorMatrix_Rec2020,			/**< ITU-R BT.2020 non-constant luminance (UHD) */
+	AJA_ColorMatrix_Size
+};
+
+
 enum AJA_HdrColorimetry		// compare R2HdrColorimetry
 {
 	AJA_HdrColor_Auto,
@@ -7,7 +7,12 @@
 
 #include "common.h"
 #include "videoutilities.h"
+#include "ajabase/system/workerpool.h"
 #include <string.h>
+#include <vector>
+#if defined(AJA_HAS_SSE2)
+	#include <emmintrin.h>
+#endif
 
 
 inline int FixedTrunc(int inFix)
@@ -438,44 +443,396 @@ void AJA_ConvertLineto8BitYCbCr(uint16_t * ycbcr10BitBuffer, uint8_t * ycbcr8Bit
 
 }
 
-// ConvertLineto8BitYCbCr
-// 10 Bit YCbCr to 8 Bit YCbCr
-void AJA_ConvertLineToYCbCr422(AJA_RGBAlphaPixel * RGBLine, 
-						   uint16_t* YCbCrLine, 
-						   int32_t numPixels ,
-						   int32_t startPixel,
-						   bool fUseSDMatrix)
+// YCbCr <-> RGB matrix kernels
+//
+// YCbCr to RGB coefficients are 16.16 fixed-point, applied to (Y-64), (Cb-512) and (Cr-512), rounded with
+// AJA_FixedRound, and clipped. Green is Y' - cbG*Cb' - crG*Cr'. The Rec.601 and Rec.709 values are the ones
+// used by the AJA_SD/HDConvert10BitYCbCrto[10Bit]RGB inline functions.
+typedef struct
 {
-	AJA_YCbCr10BitPixel YCbCr;
-	uint16_t *pYCbCr = &YCbCrLine[(startPixel&~1)*2];	// startPixel needs to be even
+	int32_t y, crR, cbB, cbG, crG;
+} AJA_YCbCrToRGBCoefficients;
+
+static const AJA_YCbCrToRGBCoefficients sYCbCrTo10BitRGB[AJA_ColorMatrix_Size] =
+{
+	{0x12A15, 0x19895, 0x20469, 0x644A, 0xD01F},	// Rec.601
+	{0x12ACF, 0x1DF71, 0x22A86, 0x3806, 0x8C32},	// Rec.709
+	{0x12AF5, 0x1AF01, 0x225E8, 0x3019, 0xA700}		// Rec.2020:  Kr=0.2627 Kb=0.0593, 10-bit narrow to full range
+};
+
+static const AJA_YCbCrToRGBCoefficients sYCbCrTo8BitRGB[AJA_ColorMatrix_Size] =
+{
+	{0x4A86, 0x6626, 0x811B, 0x1913, 0x3408},
+	{0x12ACF>>2, 0x1DF71>>2, 0x22A86>>2, 0x3806>>2, 0x8C32>>2},
+	{0x12AF5>>2, 0x1AF01>>2, 0x225E8>>2, 0x3019>>2, 0xA700>>2}
+};
 
-	AJA_ConvertRGBAlphatoYCbCr convertRGBAlphatoYCbCr;
-	if ( fUseSDMatrix )
-		convertRGBAlphatoYCbCr = AJA_HDConvertRGBAlphatoYCbCr;
+// RGB to YCbCr coefficients are Q14, applied to 8-bit full range RGB, giving 10-bit narrow range YCbCr
+// (the AJA_SD/HDConvertRGBAlphatoYCbCr values for Rec.601 and Rec.709).
+typedef struct
+{
+	int32_t yR, yG, yB, cbR, cbG, cbB, crR, crG, crB;
+} AJA_RGBToYCbCrCoefficients;
+
+static const AJA_RGBToYCbCrCoefficients sRGBToYCbCr[AJA_ColorMatrix_Size] =
+{
+	{0x41BC, 0x810F, 0x1910,	-0x25F1, -0x4A7E, 0x7070,	0x7070, -0x5E27, -0x1249},
+	{0x2E8A, 0x9C9F, 0x0FD2,	-0x18F4, -0x545B, 0x6DA9,	0x6D71, -0x6305, -0x0A06},
+	{0x39C2, 0x9510, 0x0D0A,	-0x1F66, -0x510A, 0x7070,	0x7070, -0x6765, -0x090B}
+};
+
+enum AJA_RGBLineDepth
+{
+	AJA_RGBLineDepth_8Bit,		// AJA_RGBAlphaPixel
+	AJA_RGBLineDepth_10Bit,		// AJA_RGBAlpha10BitPixel
+	AJA_RGBLineDepth_16Bit		// AJA_RGBAlpha16BitPixel (10-bit values shifted left 6)
+};
+
+static inline int32_t YCbCrToRGBComponent(int32_t inFix, int32_t maxValue)
+{
+	const int32_t value = AJA_FixedRound(inFix);
+	return value < 0 ? 0 : (value > maxValue ? maxValue : value);
+}
+
+static inline void StoreRGBPixel(void * pRGBLine, uint32_t pixel, AJA_RGBLineDepth depth, int32_t r, int32_t g, int32_t b, uint16_t alpha)
+{
+	if (depth == AJA_RGBLineDepth_8Bit)
+	{
+		AJA_RGBAlphaPixel & target = reinterpret_cast<AJA_RGBAlphaPixel*>(pRGBLine)[pixel];
+		target.Red = uint8_t(r);  target.Green = uint8_t(g);  target.Blue = uint8_t(b);  target.Alpha = uint8_t(alpha);
+	}
 	else
-		convertRGBAlphatoYCbCr = AJA_SDConvertRGBAlphatoYCbCr;
+	{
+		const int shift = depth == AJA_RGBLineDepth_16Bit ? 6 : 0;
+		AJA_RGBAlpha10BitPixel & target = reinterpret_cast<AJA_RGBAlpha10BitPixel*>(pRGBLine)[pixel];
+		target.Red = uint16_t(r << shift);  target.Green = uint16_t(g << shift);  target.Blue = uint16_t(b << shift);  target.Alpha = alpha;
+	}
+}
 
+static inline void ConvertYCbCrPixel(int32_t y, int32_t cb, int32_t cr, const AJA_YCbCrToRGBCoefficients & c, int32_t maxValue,
+									 void * pRGBLine, uint32_t pixel, AJA_RGBLineDepth depth, uint16_t alpha)
+{
+	const int32_t convertedY = c.y * (y - CCIR601_10BIT_BLACK);
+	cb -= CCIR601_10BIT_CHROMAOFFSET;
+	cr -= CCIR601_10BIT_CHROMAOFFSET;
+	StoreRGBPixel(pRGBLine, pixel, depth,
+				  YCbCrToRGBComponent(convertedY + c.crR * cr, maxValue),
+				  YCbCrToRGBComponent(convertedY - c.cbG * cb - c.crG * cr, maxValue),
+				  YCbCrToRGBComponent(convertedY + c.cbB * cb, maxValue),
+				  alpha);
+}
 
+#if defined(AJA_HAS_SSE2)
+// Splits 32-bit coefficients a and b into the 16-bit (a,b) pairs of the low 15 and remaining high bits,
+// so that _mm_madd_epi16 can apply them exactly (see MulAdd).
+static inline void SplitCoefficients(int32_t a, int32_t b, __m128i & lo, __m128i & hi)
+{
+	lo = _mm_set1_epi32(int32_t(uint32_t(a & 0x7FFF) | uint32_t(b & 0x7FFF) << 16));
+	hi = _mm_set1_epi32(int32_t(uint32_t(uint16_t(a >> 15)) | uint32_t(uint16_t(b >> 15)) << 16));
+}
 
-	for ( int32_t pixel = 0; pixel < numPixels; pixel++ )
+// Returns x0*a + x1*b for each 32-bit lane of (x0,x1) 16-bit pairs
+static inline __m128i MulAdd(__m128i pairs, __m128i lo, __m128i hi)
+{
+	return _mm_add_epi32(_mm_madd_epi16(pairs, lo), _mm_slli_epi32(_mm_madd_epi16(pairs, hi), 15));
+}
+
+// AJA_FixedRound of each 32-bit lane
+static inline __m128i FixedRound4(__m128i fix)
+{
+	const __m128i sign = _mm_srai_epi32(fix, 31);
+	const __m128i magnitude = _mm_sub_epi32(_mm_xor_si128(fix, sign), sign);
+	const __m128i rounded = _mm_srli_epi32(_mm_add_epi32(magnitude, _mm_set1_epi32(0x8000)), 16);
+	return _mm_sub_epi32(_mm_xor_si128(rounded, sign), sign);
+}
+
+typedef struct
+{
+	__m128i yLo, yHi, rLo, rHi, gLo, gHi, bLo, bHi;
+} AJA_YCbCrToRGBVectors;
+
+// Converts 4 pixels, given their Y, Cb and Cr in 32-bit lanes, to R, G and B in 32-bit lanes
+static inline void ConvertYCbCr4(__m128i y, __m128i cb, __m128i cr, const AJA_YCbCrToRGBVectors & v, __m128i & r, __m128i & g, __m128i & b)
+{
+	const __m128i mask16 = _mm_set1_epi32(0xFFFF);
+	const __m128i yPairs = _mm_and_si128(_mm_sub_epi32(y, _mm_set1_epi32(CCIR601_10BIT_BLACK)), mask16);
+	const __m128i cPairs = _mm_or_si128(_mm_and_si128(_mm_sub_epi32(cb, _mm_set1_epi32(CCIR601_10BIT_CHROMAOFFSET)), mask16),
+										_mm_slli_epi32(_mm_sub_epi32(cr, _mm_set1_epi32(CCIR601_10BIT_CHROMAOFFSET)), 16));
+	const __m128i convertedY = MulAdd(yPairs, v.yLo, v.yHi);
+	r = FixedRound4(_mm_add_epi32(convertedY, MulAdd(cPairs, v.rLo, v.rHi)));
+	g = FixedRound4(_mm_add_epi32(convertedY, MulAdd(cPairs, v.gLo, v.gHi)));
+	b = FixedRound4(_mm_add_epi32(convertedY, MulAdd(cPairs, v.bLo, v.bHi)));
+}
+
+// Converts 4 pixels of unpacked 4:2:2 YCbCr (Cb0,Y0,Cr0,Y1,Cb2,Y2,Cr2,Y3), given the next pair's Cb and Cr in
+// the upper 2 lanes of 'next', interpolating the odd pixels' chroma like the scalar code
+static inline void ConvertYCbCr422x4(__m128i ycbcr, __m128i next, const AJA_YCbCrToRGBVectors & v, __m128i & r, __m128i & g, __m128i & b)
+{
+	const __m128i y = _mm_srli_epi32(ycbcr, 16);								// Y0 Y1 Y2 Y3
+	const __m128i c = _mm_and_si128(ycbcr, _mm_set1_epi32(0xFFFF));				// Cb0 Cr0 Cb2 Cr2
+	const __m128i nextC = _mm_unpackhi_epi64(c, next);							// Cb2 Cr2 Cb4 Cr4
+	const __m128i avgC = _mm_srli_epi32(_mm_add_epi32(c, nextC), 1);
+	const __m128i lo = _mm_unpacklo_epi32(c, avgC);								// Cb0 Cb01 Cr0 Cr01
+	const __m128i hi = _mm_unpackhi_epi32(c, avgC);								// Cb2 Cb23 Cr2 Cr23
+	ConvertYCbCr4(y, _mm_unpacklo_epi64(lo, hi), _mm_unpackhi_epi64(lo, hi), v, r, g, b);
+}
+
+// Stores 8 pixels, given R, G and B as clipped 16-bit values
+static inline void StoreRGB8(void * pRGBLine, uint32_t pixel, AJA_RGBLineDepth depth, __m128i r, __m128i g, __m128i b, uint16_t alpha)
+{
+	if (depth == AJA_RGBLineDepth_8Bit)
 	{
-		convertRGBAlphatoYCbCr(&RGBLine[pixel],&YCbCr);
+		const __m128i bg = _mm_unpacklo_epi8(_mm_packus_epi16(b, b), _mm_packus_epi16(g, g));
+		const __m128i ra = _mm_unpacklo_epi8(_mm_packus_epi16(r, r), _mm_set1_epi8(char(alpha)));
+		__m128i * pOut = reinterpret_cast<__m128i*>(reinterpret_cast<AJA_RGBAlphaPixel*>(pRGBLine) + pixel);
+		_mm_storeu_si128(pOut + 0, _mm_unpacklo_epi16(bg, ra));
+		_mm_storeu_si128(pOut + 1, _mm_unpackhi_epi16(bg, ra));
+	}
+	else
+	{
+		if (depth == AJA_RGBLineDepth_16Bit)
+		{
+			r = _mm_slli_epi16(r, 6);  g = _mm_slli_epi16(g, 6);  b = _mm_slli_epi16(b, 6);
+		}
+		const __m128i a = _mm_set1_epi16(short(alpha));
+		const __m128i bgLo = _mm_unpacklo_epi16(b, g),  bgHi = _mm_unpackhi_epi16(b, g);
+		const __m128i raLo = _mm_unpacklo_epi16(r, a),  raHi = _mm_unpackhi_epi16(r, a);
+		__m128i * pOut = reinterpret_cast<__m128i*>(reinterpret_cast<AJA_RGBAlpha10BitPixel*>(pRGBLine) + pixel);
+		_mm_storeu_si128(pOut + 0, _mm_unpacklo_epi32(bgLo, raLo));
+		_mm_storeu_si128(pOut + 1, _mm_unpackhi_epi32(bgLo, raLo));
+		_mm_storeu_si128(pOut + 2, _mm_unpacklo_epi32(bgHi, raHi));
+		_mm_storeu_si128(pOut + 3, _mm_unpackhi_epi32(bgHi, raHi));
+	}
+}
+#endif	// AJA_HAS_SSE2
 
-		if ( pixel & 0x1 )
+// Converts a line of unpacked 10-bit YCbCr 4:2:2 to RGB
+static void ConvertYCbCr422LineToRGB(const uint16_t * ycbcrBuffer, void * pRGBLine, uint32_t numPixels,
+									 const AJA_YCbCrToRGBCoefficients & c, AJA_RGBLineDepth depth, uint16_t alpha)
+{
+	const int32_t maxValue = depth == AJA_RGBLineDepth_8Bit ? MAX_RGB_8BIT : MAX_RGB_10BIT;
+	uint32_t count = 0;
+#if defined(AJA_HAS_SSE2)
+	AJA_YCbCrToRGBVectors v;
+	SplitCoefficients(c.y, 0, v.yLo, v.yHi);
+	SplitCoefficients(0, c.crR, v.rLo, v.rHi);
+	SplitCoefficients(-c.cbG, -c.crG, v.gLo, v.gHi);
+	SplitCoefficients(c.cbB, 0, v.bLo, v.bHi);
+	const __m128i zero = _mm_setzero_si128();
+	const __m128i maxVector = _mm_set1_epi16(short(maxValue));
+	// 8 pixels at a time, as long as the pair after them exists (for chroma interpolation)
+	for ( ; count + 8 < numPixels; count += 8)
+	{
+		const uint16_t * pIn = ycbcrBuffer + count * 2;
+		const __m128i first = _mm_loadu_si128(reinterpret_cast<const __m128i*>(pIn));
+		const __m128i second = _mm_loadu_si128(reinterpret_cast<const __m128i*>(pIn + 8));
+		const __m128i after = _mm_set_epi32(pIn[18], pIn[16], 0, 0);
+		__m128i r0, g0, b0, r1, g1, b1;
+		ConvertYCbCr422x4(first, _mm_slli_si128(_mm_and_si128(second, _mm_set1_epi32(0xFFFF)), 8), v, r0, g0, b0);
+		ConvertYCbCr422x4(second, after, v, r1, g1, b1);
+		StoreRGB8(pRGBLine, count, depth,
+				  _mm_min_epi16(_mm_max_epi16(_mm_packs_epi32(r0, r1), zero), maxVector),
+				  _mm_min_epi16(_mm_max_epi16(_mm_packs_epi32(g0, g1), zero), maxVector),
+				  _mm_min_epi16(_mm_max_epi16(_mm_packs_epi32(b0, b1), zero), maxVector),
+				  alpha);
+	}
+#endif	// AJA_HAS_SSE2
+	// take a line(CbYCrYCbYCrY....) to RGB, 2 pixels at a time,
+	// interpolating the odd pixel's chroma from the pairs on either side
+	for ( ; count < numPixels; count += 2)
+	{
+		const uint16_t * pIn = ycbcrBuffer + count * 2;
+		const bool lastPair = count + 2 >= numPixels;
+		ConvertYCbCrPixel(pIn[1], pIn[0], pIn[2], c, maxValue, pRGBLine, count, depth, alpha);
+		if (count + 1 < numPixels)
+			ConvertYCbCrPixel(pIn[3],
+							  lastPair ? pIn[0] : (pIn[0] + pIn[4]) / 2,
+							  lastPair ? pIn[2] : (pIn[2] + pIn[6]) / 2,
+							  c, maxValue, pRGBLine, count + 1, depth, alpha);
+	}
+}
+
+// Converts a line of 8-bit RGB to unpacked 10-bit YCbCr 4:2:2, taking chroma from the even pixels
+static void ConvertRGBLineToYCbCr422(const AJA_RGBAlphaPixel * RGBLine, uint16_t * pYCbCr, int32_t numPixels, const AJA_RGBToYCbCrCoefficients & c)
+{
+	int32_t pixel = 0;
+#if defined(AJA_HAS_SSE2)
+	// Pixels are B,G,R,A bytes:  apply (B,G) and (R,A) coefficient pairs, then add them
+	__m128i yLo, yHi, cbLo, cbHi, crLo, crHi, lo, hi;
+	SplitCoefficients(c.yB, c.yG, yLo, yHi);		SplitCoefficients(c.yR, 0, lo, hi);
+	yLo = _mm_unpacklo_epi32(yLo, lo);				yHi = _mm_unpacklo_epi32(yHi, hi);
+	SplitCoefficients(c.cbB, c.cbG, cbLo, cbHi);	SplitCoefficients(c.cbR, 0, lo, hi);
+	cbLo = _mm_unpacklo_epi32(cbLo, lo);			cbHi = _mm_unpacklo_epi32(cbHi, hi);
+	SplitCoefficients(c.crB, c.crG, crLo, crHi);	SplitCoefficients(c.crR, 0, lo, hi);
+	crLo = _mm_unpacklo_epi32(crLo, lo);			crHi = _mm_unpacklo_epi32(crHi, hi);
+	const __m128i zero = _mm_setzero_si128();
+	for ( ; pixel + 4 <= numPixels; pixel += 4)
+	{
+		const __m128i rgba = _mm_loadu_si128(reinterpret_cast<const __m128i*>(RGBLine + pixel));
+		const __m128i pixels01 = _mm_unpacklo_epi8(rgba, zero);
+		const __m128i pixels23 = _mm_unpackhi_epi8(rgba, zero);
+		__m128i sums[3];
+		const __m128i * coefficients[3][2] = {{&yLo, &yHi}, {&cbLo, &cbHi}, {&crLo, &crHi}};
+		for (int component = 0; component < 3; component++)
 		{
-			// Just Y
-			*pYCbCr++ = YCbCr.y;
+			const __m128i s01 = _mm_shuffle_epi32(MulAdd(pixels01, *coefficients[component][0], *coefficients[component][1]), _MM_SHUFFLE(3,1,2,0));
+			const __m128i s23 = _mm_shuffle_epi32(MulAdd(pixels23, *coefficients[component][0], *coefficients[component][1]), _MM_SHUFFLE(3,1,2,0));
+			sums[component] = _mm_srai_epi32(_mm_add_epi32(_mm_unpacklo_epi64(s01, s23), _mm_unpackhi_epi64(s01, s23)), 14);
 		}
-		else
+		const __m128i y = _mm_add_epi32(sums[0], _mm_set1_epi32(CCIR601_10BIT_BLACK));
+		const __m128i offset = _mm_set1_epi32(CCIR601_10BIT_CHROMAOFFSET);
+		const __m128i cb = _mm_add_epi32(sums[1], offset),  cr = _mm_add_epi32(sums[2], offset);
+		const __m128i chroma = _mm_unpacklo_epi64(_mm_unpacklo_epi32(cb, cr), _mm_unpackhi_epi32(cb, cr));	// Cb0 Cr0 Cb2 Cr2
+		_mm_storeu_si128(reinterpret_cast<__m128i*>(pYCbCr + pixel * 2),
+						 _mm_or_si128(_mm_and_si128(chroma, _mm_set1_epi32(0x3FF)), _mm_slli_epi32(y, 16)));
+	}
+#endif	// AJA_HAS_SSE2
+	for ( ; pixel < numPixels; pixel++ )
+	{
+		const AJA_RGBAlphaPixel & source = RGBLine[pixel];
+		pYCbCr[pixel * 2 + 1] = uint16_t(CCIR601_10BIT_BLACK + ((c.yR * source.Red + c.yG * source.Green + c.yB * source.Blue) >> 14));
+		if ( !(pixel & 1) )
 		{
-			*pYCbCr++ = YCbCr.cb;
-			*pYCbCr++ = YCbCr.y;
-			*pYCbCr++ = YCbCr.cr;
+			pYCbCr[pixel * 2 + 0] = uint16_t((CCIR601_10BIT_CHROMAOFFSET + ((c.cbR * source.Red + c.cbG * source.Green + c.cbB * source.Blue) >> 14)) & 0x3FF);
+			pYCbCr[pixel * 2 + 2] = uint16_t((CCIR601_10BIT_CHROMAOFFSET + ((c.crR * source.Red + c.crG * source.Green + c.crB * source.Blue) >> 14)) & 0x3FF);
+		}
+	}
+}
+
+void AJA_ConvertLinetoRGB(uint16_t * ycbcrBuffer, AJA_RGBAlphaPixel * rgbaBuffer, uint32_t numPixels, AJA_ColorMatrix matrix, uint8_t alpha)
+{
+	if ( matrix < AJA_ColorMatrix_Size )
+		ConvertYCbCr422LineToRGB(ycbcrBuffer, rgbaBuffer, numPixels, sYCbCrTo8BitRGB[matrix], AJA_RGBLineDepth_8Bit, alpha);
+}
+
+void AJA_ConvertLineto10BitRGB(uint16_t * ycbcrBuffer, AJA_RGBAlpha10BitPixel * rgbaBuffer, uint32_t numPixels, AJA_ColorMatrix matrix, uint16_t alpha)
+{
+	if ( matrix < AJA_ColorMatrix_Size )
+		ConvertYCbCr422LineToRGB(ycbcrBuffer, rgbaBuffer, numPixels, sYCbCrTo10BitRGB[matrix], AJA_RGBLineDepth_10Bit, alpha);
+}
+
+void AJA_ConvertLineto16BitRGB(uint16_t * ycbcrBuffer, AJA_RGBAlpha16BitPixel * rgbaBuffer, uint32_t numPixels, AJA_ColorMatrix matrix, uint16_t alpha)
+{
+	if ( matrix < AJA_ColorMatrix_Size )
+		ConvertYCbCr422LineToRGB(ycbcrBuffer, rgbaBuffer, numPixels, sYCbCrTo10BitRGB[matrix], AJA_RGBLineDepth_16Bit, alpha);
+}
+
+void AJA_ConvertLineToYCbCr422(AJA_RGBAlphaPixel * RGBLine, uint16_t* YCbCrLine, int32_t numPixels, int32_t startPixel, AJA_ColorMatrix matrix)
+{
+	if ( matrix < AJA_ColorMatrix_Size )
+		ConvertRGBLineToYCbCr422(RGBLine, &YCbCrLine[(startPixel&~1)*2], numPixels, sRGBToYCbCr[matrix]);	// startPixel needs to be even
+}
 
+void AJA_ConvertRGBAlpha10LineToYCbCr422(AJA_RGBAlpha10BitPixel * RGBLine, uint16_t* YCbCrLine, int32_t numPixels, int32_t startPixel, AJA_ColorMatrix matrix)
+{
+	if ( matrix >= AJA_ColorMatrix_Size )
+		return;
+	// Same coefficients as the 8-bit version, with two more fraction bits for the 10-bit components
+	const AJA_RGBToYCbCrCoefficients & c = sRGBToYCbCr[matrix];
+	uint16_t * pYCbCr = &YCbCrLine[(startPixel&~1)*2];	// startPixel needs to be even
+	for ( int32_t pixel = 0; pixel < numPixels; pixel++ )
+	{
+		const AJA_RGBAlpha10BitPixel & source = RGBLine[pixel];
+		pYCbCr[pixel * 2 + 1] = uint16_t(CCIR601_10BIT_BLACK + ((c.yR * source.Red + c.yG * source.Green + c.yB * source.Blue) >> 16));
+		if ( !(pixel & 1) )
+		{
+			pYCbCr[pixel * 2 + 0] = uint16_t((CCIR601_10BIT_CHROMAOFFSET + ((c.cbR * source.Red + c.cbG * source.Green + c.cbB * source.Blue) >> 16)) & 0x3FF);
+			pYCbCr[pixel * 2 + 2] = uint16_t((CCIR601_10BIT_CHROMAOFFSET + ((c.crR * source.Red + c.crG * source.Green + c.crB * source.Blue) >> 16)) & 0x3FF);
 		}
+	}
+}
 
+// Whole-frame conversions
+typedef struct
+{
+	const uint8_t *		pSrc;
+	uint32_t			srcRowBytes;
+	uint8_t *			pDst;
+	uint32_t			dstRowBytes;
+	uint32_t			numPixels;
+	AJA_ColorMatrix		matrix;
+	AJA_RGBLineDepth	depth;
+} AJA_FrameConversion;
+
+static void ConvertYCbCrFrameLines(void * pContext, uint32_t firstLine, uint32_t endLine)
+{
+	const AJA_FrameConversion & job = *reinterpret_cast<const AJA_FrameConversion*>(pContext);
+	const AJA_YCbCrToRGBCoefficients & c = job.depth == AJA_RGBLineDepth_8Bit ? sYCbCrTo8BitRGB[job.matrix] : sYCbCrTo10BitRGB[job.matrix];
+	const uint16_t alpha = job.depth == AJA_RGBLineDepth_8Bit ? MAX_RGB_8BIT : MAX_RGB_16BIT;
+	std::vector<uint16_t> ycbcr(job.numPixels * 2 + 6);
+	for (uint32_t line = firstLine; line < endLine; line++)
+	{
+		AJA_UnPack10BitYCbCrBuffer(const_cast<uint32_t*>(reinterpret_cast<const uint32_t*>(job.pSrc + size_t(line) * job.srcRowBytes)), &ycbcr[0], job.numPixels);
+		ConvertYCbCr422LineToRGB(&ycbcr[0], job.pDst + size_t(line) * job.dstRowBytes, job.numPixels, c, job.depth, alpha);
 	}
+}
+
+static void ConvertRGBFrameLines(void * pContext, uint32_t firstLine, uint32_t endLine)
+{
+	const AJA_FrameConversion & job = *reinterpret_cast<const AJA_FrameConversion*>(pContext);
+	std::vector<uint16_t> ycbcr((job.numPixels + 5) / 6 * 12, 0);	// AJA_PackTo10BitYCbCrBuffer packs 6 pixels at a time
+	for (uint32_t line = firstLine; line < endLine; line++)
+	{
+		ConvertRGBLineToYCbCr422(reinterpret_cast<const AJA_RGBAlphaPixel*>(job.pSrc + size_t(line) * job.srcRowBytes), &ycbcr[0],
+								 int32_t(job.numPixels), sRGBToYCbCr[job.matrix]);
+		AJA_PackTo10BitYCbCrBuffer(&ycbcr[0], reinterpret_cast<uint32_t*>(job.pDst + size_t(line) * job.dstRowBytes), job.numPixels);
+	}
+}
 
+static bool ConvertFrame(AJAWorkerPoolFunction * pFunction, const void * pSrc, uint32_t srcRowBytes, void * pDst, uint32_t dstRowBytes,
+						 uint32_t numPixels, uint32_t numLines, AJA_ColorMatrix matrix, AJA_RGBLineDepth depth)
+{
+	if ( !pSrc || !pDst || !numPixels || !numLines || matrix >= AJA_ColorMatrix_Size )
+		return false;
+	AJA_FrameConversion job;
+	job.pSrc = reinterpret_cast<const uint8_t*>(pSrc);
+	job.srcRowBytes = srcRowBytes;
+	job.pDst = reinterpret_cast<uint8_t*>(pDst);
+	job.dstRowBytes = dstRowBytes;
+	job.numPixels = numPixels;
+	job.matrix = matrix;
+	job.depth = depth;
+	return AJA_SUCCESS(AJAWorkerPool::GetSharedPool().ParallelFor(numLines, pFunction, &job));
+}
+
+static inline uint32_t V210RowBytes(uint32_t numPixels)
+{
+	return (numPixels + 47) / 48 * 128;
+}
+
+bool AJA_Convert10BitYCbCrFrametoRGB(const uint32_t * v210Frame, uint32_t srcRowBytes, AJA_RGBAlphaPixel * rgbaFrame, uint32_t dstRowBytes,
+									 uint32_t numPixels, uint32_t numLines, AJA_ColorMatrix matrix)
+{
+	return ConvertFrame(ConvertYCbCrFrameLines, v210Frame, srcRowBytes ? srcRowBytes : V210RowBytes(numPixels),
+						rgbaFrame, dstRowBytes ? dstRowBytes : numPixels * uint32_t(sizeof(AJA_RGBAlphaPixel)),
+						numPixels, numLines, matrix, AJA_RGBLineDepth_8Bit);
+}
+
+bool AJA_Convert10BitYCbCrFrameto16BitRGB(const uint32_t * v210Frame, uint32_t srcRowBytes, AJA_RGBAlpha16BitPixel * rgbaFrame, uint32_t dstRowBytes,
+										  uint32_t numPixels, uint32_t numLines, AJA_ColorMatrix matrix)
+{
+	return ConvertFrame(ConvertYCbCrFrameLines, v210Frame, srcRowBytes ? srcRowBytes : V210RowBytes(numPixels),
+						rgbaFrame, dstRowBytes ? dstRowBytes : numPixels * uint32_t(sizeof(AJA_RGBAlpha16BitPixel)),
+						numPixels, numLines, matrix, AJA_RGBLineDepth_16Bit);
+}
+
+bool AJA_ConvertRGBFrameto10BitYCbCr(const AJA_RGBAlphaPixel * rgbaFrame, uint32_t srcRowBytes, uint32_t * v210Frame, uint32_t dstRowBytes,
+									 uint32_t numPixels, uint32_t numLines, AJA_ColorMatrix matrix)
+{
+	return ConvertFrame(ConvertRGBFrameLines, rgbaFrame, srcRowBytes ? srcRowBytes : numPixels * uint32_t(sizeof(AJA_RGBAlphaPixel)),
+						v210Frame, dstRowBytes ? dstRowBytes : V210RowBytes(numPixels),
+						numPixels, numLines, matrix, AJA_RGBLineDepth_8Bit);
+}
+
+// ConvertLineToYCbCr422
+// 8 Bit RGB to 10 Bit YCbCr
+void AJA_ConvertLineToYCbCr422(AJA_RGBAlphaPixel * RGBLine, 
+						   uint16_t* YCbCrLine, 
+						   int32_t numPixels ,
+						   int32_t startPixel,
+						   bool fUseSDMatrix)
+{
+	AJA_ConvertLineToYCbCr422(RGBLine, YCbCrLine, numPixels, startPixel, fUseSDMatrix ? AJA_ColorMatrix_Rec601 : AJA_ColorMatrix_Rec709);
 }
 
 // ConvertLineto8BitYCbCr
@@ -519,58 +876,7 @@ void AJA_ConvertRGBAlpha10LineToYCbCr422(AJA_RGBAlpha10BitPixel * RGBLine,
 // 10 Bit YCbCr and 10 Bit RGB Version
 void AJA_ConvertLineto10BitRGB(uint16_t * ycbcrBuffer, AJA_RGBAlpha10BitPixel * rgbaBuffer,uint32_t numPixels,bool fUseSDMatrix)
 {
-	AJA_YCbCr10BitAlphaPixel ycbcrPixel;
-	uint16_t Cb1,Y1,Cr1,Cb2,Y2,Cr2;
-
-	// take a line(CbYCrYCbYCrY....) to AJA_RGBAlphaPixels.
-	// 2 AJA_RGBAlphaPixels at a time.
-	Cb1 = *ycbcrBuffer++;
-	Y1 = *ycbcrBuffer++;
-	Cr1 = *ycbcrBuffer++;
-	for ( uint32_t count = 0; count < numPixels; count+=2 )
-	{
-		ycbcrPixel.cb = (uint16_t)Cb1;
-		ycbcrPixel.y = (uint16_t)Y1; 
-		ycbcrPixel.cr = (uint16_t)Cr1; 
-		ycbcrPixel.Alpha = CCIR601_10BIT_WHITE;
-
-		if(fUseSDMatrix) {
-			AJA_SDConvert10BitYCbCrto10BitRGB(&ycbcrPixel,&rgbaBuffer[count]);
-		} else {
-			AJA_HDConvert10BitYCbCrto10BitRGB(&ycbcrPixel,&rgbaBuffer[count]);
-		}
-		// Read lone midde Y;
-		ycbcrPixel.y = *ycbcrBuffer++;
-
-		// Read Next full bandwidth sample
-		// unless we are at the end of a line
-		if ( (count + 2 ) >= numPixels )
-		{
-			Cb2 = (uint16_t)Cb1;
-			Y2 = (uint16_t)Y1;
-			Cr2 = (uint16_t)Cr1;
-		}
-		else
-		{
-			Cb2 = *ycbcrBuffer++;
-			Y2 = *ycbcrBuffer++;
-			Cr2 = *ycbcrBuffer++;
-		}
-		// Interpolate and write Inpterpolated AJA_RGBAlphaPixel
-		ycbcrPixel.cb = (uint16_t)((Cb1+Cb2)/2);
-		ycbcrPixel.cr = (uint16_t)((Cr1+Cr2)/2);
-		if(fUseSDMatrix) {
-			AJA_SDConvert10BitYCbCrto10BitRGB(&ycbcrPixel,&rgbaBuffer[count+1]);
-		} else {
-			AJA_HDConvert10BitYCbCrto10BitRGB(&ycbcrPixel,&rgbaBuffer[count+1]);
-		}
-
-		// Setup for next loop
-		Cb1 = Cb2;
-		Cr1 = Cr2;
-		Y1 = Y2;
-
-	}
+	AJA_ConvertLineto10BitRGB(ycbcrBuffer, rgbaBuffer, numPixels, fUseSDMatrix ? AJA_ColorMatrix_Rec601 : AJA_ColorMatrix_Rec709, CCIR601_10BIT_WHITE);
 }
 
 // ConvertLinetoRGB
@@ -641,129 +947,15 @@ void AJA_ConvertLinetoRGB(uint16_t * ycbcrBuffer,
 					  uint32_t numPixels,
 					  bool fUseSDMatrix)
 {
-	AJA_YCbCr10BitAlphaPixel ycbcrPixel;
-	uint16_t Cb1,Y1,Cr1,Cb2,Y2,Cr2;
-
-	// take a line(CbYCrYCbYCrY....) to AJA_RGBAlphaPixels.
-	// 2 AJA_RGBAlphaPixels at a time.
-	Cb1 = *ycbcrBuffer++;
-	Y1 = *ycbcrBuffer++;
-	Cr1 = *ycbcrBuffer++;
-	for ( uint32_t count = 0; count < numPixels; count+=2 )
-	{
-		ycbcrPixel.cb = (uint16_t)Cb1;
-		ycbcrPixel.y = (uint16_t)Y1; 
-		ycbcrPixel.cr = (uint16_t)Cr1; 
-		ycbcrPixel.Alpha = CCIR601_10BIT_WHITE;
-
-		if(fUseSDMatrix) {
-			AJA_SDConvert10BitYCbCrtoRGB(&ycbcrPixel,&rgbaBuffer[count]);
-		} else {
-			AJA_HDConvert10BitYCbCrtoRGB(&ycbcrPixel,&rgbaBuffer[count]);
-		}
-		// Read lone midde Y;
-		ycbcrPixel.y = *ycbcrBuffer++;
-
-		// Read Next full bandwidth sample
-		// unless we are at the end of a line
-		if ( (count + 2 ) >= numPixels )
-		{
-			Cb2 = (uint16_t)Cb1;
-			Y2 = (uint16_t)Y1;
-			Cr2 = (uint16_t)Cr1;
-		}
-		else
-		{
-			Cb2 = *ycbcrBuffer++;
-			Y2 = *ycbcrBuffer++;
-			Cr2 = *ycbcrBuffer++;
-		}
-		// Interpolate and write Inpterpolated AJA_RGBAlphaPixel
-		ycbcrPixel.cb = (uint16_t)((Cb1+Cb2)/2);
-		ycbcrPixel.cr = (uint16_t)((Cr1+Cr2)/2);
-		if(fUseSDMatrix) {
-			AJA_SDConvert10BitYCbCrtoRGB(&ycbcrPixel,&rgbaBuffer[count+1]);
-		} else {
-			AJA_HDConvert10BitYCbCrtoRGB(&ycbcrPixel,&rgbaBuffer[count+1]);
-		}
-
-		// Setup for next loop
-		Cb1 = Cb2;
-		Cr1 = Cr2;
-		Y1 = Y2;
-
-	}
+	AJA_ConvertLinetoRGB(ycbcrBuffer, rgbaBuffer, numPixels, fUseSDMatrix ? AJA_ColorMatrix_Rec601 : AJA_ColorMatrix_Rec709,
+						 uint8_t(CCIR601_10BIT_WHITE));	// (historical alpha value)
 }
 
 // ConvertLinetoRGB
 // 10 Bit YCbCr 16 Bit RGB version
 void AJA_ConvertLineto16BitRGB(uint16_t * ycbcrBuffer, AJA_RGBAlpha16BitPixel * rgbaBuffer, uint32_t numPixels, bool fUseSDMatrix)
 {
-	AJA_YCbCr10BitAlphaPixel ycbcrPixel;
-	uint16_t Cb1,Y1,Cr1,Cb2,Y2,Cr2;
-
-	// take a line(CbYCrYCbYCrY....) to AJA_RGBAlpha16Pixels.
-	// 2 AJA_RGBAlpha16Pixels at a time.
-	Cb1 = *ycbcrBuffer++;
-	Y1 = *ycbcrBuffer++;
-	Cr1 = *ycbcrBuffer++;
-	for ( uint32_t count = 0; count < numPixels; count+=2 )
-	{
-		ycbcrPixel.cb = (uint16_t)Cb1;
-		ycbcrPixel.y = (uint16_t)Y1; 
-		ycbcrPixel.cr = (uint16_t)Cr1; 
-		ycbcrPixel.Alpha = CCIR601_10BIT_WHITE;
-
-		if(fUseSDMatrix) {
-			AJA_SDConvert10BitYCbCrto10BitRGB(&ycbcrPixel,(AJA_RGBAlpha10BitPixel *)&rgbaBuffer[count]);
-			rgbaBuffer[count].Red = (rgbaBuffer[count].Red) << 6;
-			rgbaBuffer[count].Green = (rgbaBuffer[count].Green) << 6;
-			rgbaBuffer[count].Blue = (rgbaBuffer[count].Blue) << 6;
-		} else {
-			AJA_HDConvert10BitYCbCrto10BitRGB(&ycbcrPixel,(AJA_RGBAlpha10BitPixel *)&rgbaBuffer[count]);
-			rgbaBuffer[count].Red = (rgbaBuffer[count].Red) << 6;
-			rgbaBuffer[count].Green = (rgbaBuffer[count].Green) << 6;
-			rgbaBuffer[count].Blue = (rgbaBuffer[count].Blue) << 6;
-		}
-
-		// Read lone midde Y;
-		ycbcrPixel.y = *ycbcrBuffer++;
-
-		// Read Next full bandwidth sample
-		// unless we are at the end of a line
-		if ( (count + 2 ) >= numPixels )
-		{
-			Cb2 = (uint16_t)Cb1;
-			Y2 = (uint16_t)Y1;
-			Cr2 = (uint16_t)Cr1;
-		}
-		else
-		{
-			Cb2 = *ycbcrBuffer++;
-			Y2 = *ycbcrBuffer++;
-			Cr2 = *ycbcrBuffer++;
-		}
-		// Interpolate and write Inpterpolated AJA_RGBAlpha16Pixel
-		ycbcrPixel.cb = (uint16_t)((Cb1+Cb2)/2);
-		ycbcrPixel.cr = (uint16_t)((Cr1+Cr2)/2);
-		if(fUseSDMatrix) {
-			AJA_SDConvert10BitYCbCrto10BitRGB(&ycbcrPixel,(AJA_RGBAlpha10BitPixel *)&rgbaBuffer[count+1]);
-			rgbaBuffer[count+1].Red = (rgbaBuffer[count+1].Red) << 6;
-			rgbaBuffer[count+1].Green = (rgbaBuffer[count+1].Green) << 6;
-			rgbaBuffer[count+1].Blue = (rgbaBuffer[count+1].Blue) << 6;
-		} else {
-			AJA_HDConvert10BitYCbCrto10BitRGB(&ycbcrPixel,(AJA_RGBAlpha10BitPixel *)&rgbaBuffer[count+1]);
-			rgbaBuffer[count+1].Red = (rgbaBuffer[count+1].Red) << 6;
-			rgbaBuffer[count+1].Green = (rgbaBuffer[count+1].Green) << 6;
-			rgbaBuffer[count+1].Blue = (rgbaBuffer[count+1].Blue) << 6;
-		}
-
-		// Setup for next loop
-		Cb1 = Cb2;
-		Cr1 = Cr2;
-		Y1 = Y2;
-
-	}
+	AJA_ConvertLineto16BitRGB(ycbcrBuffer, rgbaBuffer, numPixels, fUseSDMatrix ? AJA_ColorMatrix_Rec601 : AJA_ColorMatrix_Rec709, CCIR601_10BIT_WHITE);
 }
 
 // ConvertLinetoBayer10BitDPXLJ
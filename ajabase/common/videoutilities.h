@@ -127,6 +127,33 @@ void AJA_EXPORT AJA_ConvertLineto10BitRGB(uint16_t * ycbcrBuffer, AJA_RGBAlpha10
 void AJA_EXPORT AJA_ConvertLinetoRGB(uint8_t * ycbcrBuffer, AJA_RGBAlphaPixel * rgbaBuffer, uint32_t numPixels, bool fUseSDMatrix);
 void AJA_EXPORT AJA_ConvertLinetoRGB(uint16_t * ycbcrBuffer, AJA_RGBAlphaPixel * rgbaBuffer, uint32_t numPixels, bool fUseSDMatrix);
 void AJA_EXPORT AJA_ConvertLineto16BitRGB(uint16_t * ycbcrBuffer, AJA_RGBAlpha16BitPixel * rgbaBuffer, uint32_t numPixels, bool fUseSDMatrix);
+
+// Matrix versions of the YCbCr <-> RGB line conversions, which use SIMD where available, and produce
+// opaque alpha (unless overridden). Rec.601 and Rec.709 give the same RGB/YCbCr values as the fUseSDMatrix
+// versions. The 10-bit YCbCr buffers are unpacked 4:2:2 (Cb,Y,Cr,Y...), as from AJA_UnPack10BitYCbCrBuffer.
+void AJA_EXPORT AJA_ConvertLinetoRGB(uint16_t * ycbcrBuffer, AJA_RGBAlphaPixel * rgbaBuffer, uint32_t numPixels,
+									 AJA_ColorMatrix matrix, uint8_t alpha = MAX_RGB_8BIT);
+void AJA_EXPORT AJA_ConvertLineto10BitRGB(uint16_t * ycbcrBuffer, AJA_RGBAlpha10BitPixel * rgbaBuffer, uint32_t numPixels,
+										  AJA_ColorMatrix matrix, uint16_t alpha = MAX_RGB_10BIT);
+void AJA_EXPORT AJA_ConvertLineto16BitRGB(uint16_t * ycbcrBuffer, AJA_RGBAlpha16BitPixel * rgbaBuffer, uint32_t numPixels,
+										  AJA_ColorMatrix matrix, uint16_t alpha = MAX_RGB_16BIT);
+void AJA_EXPORT AJA_ConvertLineToYCbCr422(AJA_RGBAlphaPixel * RGBLine, uint16_t* YCbCrLine, int32_t numPixels, int32_t startPixel,
+										  AJA_ColorMatrix matrix);
+void AJA_EXPORT AJA_ConvertRGBAlpha10LineToYCbCr422(AJA_RGBAlpha10BitPixel * RGBLine, uint16_t* YCbCrLine, int32_t numPixels, int32_t startPixel,
+													AJA_ColorMatrix matrix);
+
+// Whole-frame conversions between 10-bit YCbCr 4:2:2 (v210) and RGB, split across the threads of the shared
+// AJAWorkerPool. Row bytes of zero mean the pixel format's natural line pitch. Return false if a parameter is invalid.
+bool AJA_EXPORT AJA_Convert10BitYCbCrFrametoRGB(const uint32_t * v210Frame, uint32_t srcRowBytes,
+												AJA_RGBAlphaPixel * rgbaFrame, uint32_t dstRowBytes,
+												uint32_t numPixels, uint32_t numLines, AJA_ColorMatrix matrix);
+bool AJA_EXPORT AJA_Convert10BitYCbCrFrameto16BitRGB(const uint32_t * v210Frame, uint32_t srcRowBytes,
+													 AJA_RGBAlpha16BitPixel * rgbaFrame, uint32_t dstRowBytes,
+													 uint32_t numPixels, uint32_t numLines, AJA_ColorMatrix matrix);
+bool AJA_EXPORT AJA_ConvertRGBFrameto10BitYCbCr(const AJA_RGBAlphaPixel * rgbaFrame, uint32_t srcRowBytes,
+												uint32_t * v210Frame, uint32_t dstRowBytes,
+												uint32_t numPixels, uint32_t numLines, AJA_ColorMatrix matrix);
+
 void AJA_EXPORT AJA_Convert16BitRGBtoBayer10BitDPXLJ(AJA_RGBAlpha16BitPixel * rgbaBuffer, uint32_t * bayerBuffer, 
 													 uint32_t numPixels, uint32_t line, AJA_BayerColorPhase phase = AJA_BayerColorPhase_RedGreen);
 void AJA_EXPORT AJA_Convert16BitRGBtoBayer12BitDPXLJ(AJA_RGBAlpha16BitPixel * rgbaBuffer, uint32_t * bayerBuffer, 
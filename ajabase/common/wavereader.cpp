@@ -0,0 +1,367 @@
+/* SPDX-License-Identifier: MIT */
+/**
+	@file		wavereader.cpp
+	@brief		Implements the AJAWavReader class.
+	@copyright	(C) 2023 AJA Video Systems, Inc.  All rights reserved.
+**/
+
+#include "wavereader.h"
+#include <stdint.h>
+#include <string.h>
+
+#if defined(AJA_WINDOWS)
+	#include "ajabase/system/system.h"	//	for Windows API #includes
+	#define AJA_WAVREADER_MMAP
+#elif !defined(AJA_BAREMETAL)
+	#include <fcntl.h>
+	#include <sys/mman.h>
+	#include <sys/stat.h>
+	#include <unistd.h>
+	#define AJA_WAVREADER_MMAP
+#endif
+
+const uint16_t	kWavFormatPCM			= 1;
+const uint16_t	kWavFormatFloat			= 3;
+const uint16_t	kWavFormatExtensible	= 0xFFFE;
+const uint32_t	kDefaultReadAheadFrames	= 48000;
+
+static inline uint16_t getLE16(const uint8_t* p)	{return uint16_t(p[0] | (p[1] << 8));}
+static inline uint32_t getLE32(const uint8_t* p)	{return uint32_t(p[0]) | (uint32_t(p[1]) << 8) | (uint32_t(p[2]) << 16) | (uint32_t(p[3]) << 24);}
+static inline uint64_t getLE64(const uint8_t* p)	{return uint64_t(getLE32(p)) | (uint64_t(getLE32(p + 4)) << 32);}
+
+
+#if defined(AJA_WAVREADER_MMAP)
+static const uint8_t* mapFile(const std::string& fileName, uint64_t& outSize)
+{
+	void* pMap = NULL;
+#if defined(AJA_WINDOWS)
+	HANDLE hFile = ::CreateFileA(fileName.c_str(), GENERIC_READ, FILE_SHARE_READ | FILE_SHARE_WRITE, NULL, OPEN_EXISTING,
+								 FILE_FLAG_SEQUENTIAL_SCAN, NULL);
+	if (hFile == INVALID_HANDLE_VALUE)
+		return NULL;
+	LARGE_INTEGER size;
+	if (::GetFileSizeEx(hFile, &size)  &&  size.QuadPart > 0  &&  uint64_t(size.QuadPart) <= uint64_t(SIZE_MAX))
+	{
+		// The view keeps the mapping and the file open
+		HANDLE hMap = ::CreateFileMappingA(hFile, NULL, PAGE_READONLY, 0, 0, NULL);
+		if (hMap)
+		{
+			pMap = ::MapViewOfFile(hMap, FILE_MAP_READ, 0, 0, 0);
+			::CloseHandle(hMap);
+		}
+		outSize = uint64_t(size.QuadPart);
+	}
+	::CloseHandle(hFile);
+#else
+	int fd = ::open(fileName.c_str(), O_RDONLY);
+	if (fd < 0)
+		return NULL;
+	struct stat st;
+	if (::fstat(fd, &st) == 0  &&  st.st_size > 0  &&  uint64_t(st.st_size) <= uint64_t(SIZE_MAX))
+	{
+		pMap = ::mmap(NULL, size_t(st.st_size), PROT_READ, MAP_SHARED, fd, 0);
+		if (pMap == MAP_FAILED)
+			pMap = NULL;
+		else
+			::madvise(pMap, size_t(st.st_size), MADV_SEQUENTIAL);
+		outSize = uint64_t(st.st_size);
+	}
+	::close(fd);	// The mapping keeps the file open
+#endif
+	return reinterpret_cast<const uint8_t*>(pMap);
+}
+
+static void unmapFile(const uint8_t* pMap, uint64_t size)
+{
+#if defined(AJA_WINDOWS)
+	AJA_UNUSED(size);
+	::UnmapViewOfFile(pMap);
+#else
+	::munmap(const_cast<uint8_t*>(pMap), size_t(size));
+#endif
+}
+#endif	//	AJA_WAVREADER_MMAP
+
+
+AJAWavReader::AJAWavReader()
+	:	mIsOpen				(false),
+		mFileSize			(0),
+		mpMap				(NULL),
+		mIsFloat			(false),
+		mIsRF64				(false),
+		mHasBext			(false),
+		mTimeReference		(0),
+		mBytesPerFrame		(0),
+		mDataOffset			(0),
+		mFrameCount			(0),
+		mPosition			(0),
+		mReadAheadFrames	(kDefaultReadAheadFrames),
+		mPrefetchedTo		(0)
+{
+}
+
+AJAWavReader::~AJAWavReader()
+{
+	close();
+}
+
+bool AJAWavReader::open(const std::string& fileName)
+{
+	close();
+
+#if defined(AJA_WAVREADER_MMAP)
+	mpMap = mapFile(fileName, mFileSize);
+#endif
+	if (!mpMap)
+	{
+		// Can't map it -- read it through AJAFileIO instead
+		if (mFile.Open(fileName, eAJAReadOnly, eAJABuffered) != AJA_STATUS_SUCCESS)
+			return false;
+		mFile.Seek(0, eAJASeekEnd);
+		const int64_t size = mFile.Tell();
+		mFileSize = size > 0 ? uint64_t(size) : 0;
+	}
+
+	mIsOpen = true;
+	if (!parseHeader())
+	{
+		close();
+		return false;
+	}
+	mPosition = 0;
+	mPrefetchedTo = 0;
+	prefetch();
+	return true;
+}
+
+void AJAWavReader::close()
+{
+#if defined(AJA_WAVREADER_MMAP)
+	if (mpMap)
+		unmapFile(mpMap, mFileSize);
+#endif
+	mpMap = NULL;
+	if (mFile.IsOpen())
+		mFile.Close();
+	mIsOpen = false;
+	mFileSize = 0;
+	mAudioFormat = AJAWavWriterAudioFormat();
+	mIsFloat = mIsRF64 = mHasBext = false;
+	mTimeReference = 0;
+	mBytesPerFrame = 0;
+	mDataOffset = mFrameCount = mPosition = mPrefetchedTo = 0;
+	mScratch.clear();
+}
+
+bool AJAWavReader::readAt(uint64_t offset, void* pBuffer, uint32_t len)
+{
+	if (offset > mFileSize  ||  len > mFileSize - offset)
+		return false;
+	if (mpMap)
+	{
+		::memcpy(pBuffer, mpMap + offset, len);
+		return true;
+	}
+	if (mFile.Seek(int64_t(offset), eAJASeekSet) != AJA_STATUS_SUCCESS)
+		return false;
+	return mFile.Read(reinterpret_cast<uint8_t*>(pBuffer), len) == len;
+}
+
+bool AJAWavReader::parseHeader()
+{
+	uint8_t riff[12];
+	if (!readAt(0, riff, sizeof(riff)))
+		return false;
+	mIsRF64 = ::memcmp(riff, "RF64", 4) == 0;
+	if ((!mIsRF64  &&  ::memcmp(riff, "RIFF", 4) != 0)  ||  ::memcmp(riff + 8, "WAVE", 4) != 0)
+		return false;
+
+	uint64_t ds64DataSize = 0;
+	uint64_t dataSize = 0;
+	bool gotFmt = false;
+	bool gotData = false;
+	uint16_t formatTag = 0;
+	uint64_t offset = sizeof(riff);
+	while (offset + 8 <= mFileSize)
+	{
+		uint8_t chunk[8];
+		if (!readAt(offset, chunk, sizeof(chunk)))
+			break;
+		const uint32_t chunkSize = getLE32(chunk + 4);
+		const uint64_t body = offset + 8;
+
+		if (::memcmp(chunk, "ds64", 4) == 0  &&  chunkSize >= 24)
+		{
+			uint8_t ds64[24];
+			if (!readAt(body, ds64, sizeof(ds64)))
+				return false;
+			ds64DataSize = getLE64(ds64 + 8);			// riffSize, dataSize, sampleCount
+		}
+		else if (::memcmp(chunk, "fmt ", 4) == 0  &&  chunkSize >= 16)
+		{
+			uint8_t fmt[40];
+			const uint32_t len = chunkSize >= 40 ? 40 : 16;
+			if (!readAt(body, fmt, len))
+				return false;
+			formatTag = getLE16(fmt);
+			if (formatTag == kWavFormatExtensible  &&  len >= 40)
+				formatTag = getLE16(fmt + 24);			// The first 2 bytes of the sub-format GUID
+			mAudioFormat.channelCount	= getLE16(fmt + 2);
+			mAudioFormat.sampleRate		= int(getLE32(fmt + 4));
+			mBytesPerFrame				= getLE16(fmt + 12);
+			mAudioFormat.sampleSize		= getLE16(fmt + 14);
+			gotFmt = true;
+		}
+		else if (::memcmp(chunk, "bext", 4) == 0  &&  chunkSize >= 346)
+		{
+			uint8_t timeRef[8];
+			if (readAt(body + 338, timeRef, sizeof(timeRef)))	// After description, originator, reference, date & time
+			{
+				mTimeReference = getLE64(timeRef);
+				mHasBext = true;
+			}
+		}
+		else if (::memcmp(chunk, "data", 4) == 0)
+		{
+			mDataOffset = body;
+			dataSize = chunkSize;
+			if (mIsRF64  &&  chunkSize == 0xFFFFFFFF)
+				dataSize = ds64DataSize;
+			// A recording that's still in progress (or was never closed) has no size yet -- use the rest of the file
+			if (dataSize == 0  ||  dataSize > mFileSize - body)
+				dataSize = mFileSize - body;
+			gotData = true;
+			if (gotFmt)
+				break;
+			offset = body + dataSize + (dataSize & 1);
+			continue;
+		}
+		offset = body + chunkSize + (chunkSize & 1);	// Chunks are word-aligned
+	}
+
+	if (!gotFmt  ||  !gotData)
+		return false;
+	if (formatTag == kWavFormatPCM)
+		mIsFloat = false;
+	else if (formatTag == kWavFormatFloat)
+		mIsFloat = true;
+	else
+		return false;
+	const int bytesPerSample = mAudioFormat.sampleSize / 8;
+	if (mAudioFormat.channelCount <= 0  ||  bytesPerSample <= 0  ||  mBytesPerFrame != uint32_t(mAudioFormat.channelCount * bytesPerSample))
+		return false;
+
+	mFrameCount = dataSize / mBytesPerFrame;
+	return true;
+}
+
+bool AJAWavReader::seek(uint64_t frame)
+{
+	if (!mIsOpen  ||  frame > mFrameCount)
+		return false;
+	mPosition = frame;
+	mPrefetchedTo = frame;
+	prefetch();
+	return true;
+}
+
+void AJAWavReader::setReadAhead(uint32_t frames)
+{
+	mReadAheadFrames = frames;
+	mPrefetchedTo = mPosition;
+	prefetch();
+}
+
+void AJAWavReader::prefetch()
+{
+#if defined(AJA_WAVREADER_MMAP) && !defined(AJA_WINDOWS)
+	// Only ask again once half the window has been read, so the kernel gets big, infrequent requests
+	if (!mpMap  ||  !mReadAheadFrames  ||  mPosition + mReadAheadFrames / 2 < mPrefetchedTo)
+		return;
+	uint64_t end = mPosition + mReadAheadFrames;
+	if (end > mFrameCount)
+		end = mFrameCount;
+	const uint64_t begin = mPrefetchedTo > mPosition ? mPrefetchedTo : mPosition;
+	if (begin >= end)
+		return;
+	static const uint64_t pageSize = uint64_t(::sysconf(_SC_PAGESIZE));
+	const uint64_t first = (mDataOffset + begin * mBytesPerFrame) / pageSize * pageSize;
+	const uint64_t last = mDataOffset + end * mBytesPerFrame;
+	::madvise(const_cast<uint8_t*>(mpMap) + first, size_t(last - first), MADV_WILLNEED);
+	mPrefetchedTo = end;
+#endif	//	Windows reads ahead on its own, as the file is opened for sequential scanning
+}
+
+const uint8_t* AJAWavReader::getFrames(uint32_t frames)
+{
+	const uint64_t offset = mDataOffset + mPosition * mBytesPerFrame;
+	if (mpMap)
+		return mpMap + offset;
+	mScratch.resize(size_t(frames) * mBytesPerFrame);
+	if (!readAt(offset, &mScratch[0], uint32_t(mScratch.size())))
+		return NULL;
+	return &mScratch[0];
+}
+
+uint32_t AJAWavReader::read(char* data, uint32_t frames)
+{
+	if (!mIsOpen  ||  !data)
+		return 0;
+	if (frames > mFrameCount - mPosition)
+		frames = uint32_t(mFrameCount - mPosition);
+	if (!frames)
+		return 0;
+	const uint8_t* pSrc = getFrames(frames);
+	if (!pSrc)
+		return 0;
+	::memcpy(data, pSrc, size_t(frames) * mBytesPerFrame);
+	mPosition += frames;
+	prefetch();
+	return frames;
+}
+
+template <size_t N>
+static void extractChannels(uint8_t* pDst, const uint8_t* pSrc, uint32_t frames, uint32_t bytesPerFrame,
+							const std::vector<uint32_t>& channels)
+{
+	const size_t numChannels = channels.size();
+	for (uint32_t frame = 0;  frame < frames;  frame++)
+	{
+		for (size_t ndx = 0;  ndx < numChannels;  ndx++, pDst += N)
+			::memcpy(pDst, pSrc + channels[ndx] * N, N);	// Fixed size, so inlined
+		pSrc += bytesPerFrame;
+	}
+}
+
+uint32_t AJAWavReader::readChannels(char* data, uint32_t frames, const std::vector<uint32_t>& channels)
+{
+	if (!mIsOpen  ||  !data  ||  channels.empty())
+		return 0;
+	for (size_t ndx = 0;  ndx < channels.size();  ndx++)
+		if (channels[ndx] >= uint32_t(mAudioFormat.channelCount))
+			return 0;
+	if (frames > mFrameCount - mPosition)
+		frames = uint32_t(mFrameCount - mPosition);
+	if (!frames)
+		return 0;
+	const uint8_t* pSrc = getFrames(frames);
+	if (!pSrc)
+		return 0;
+
+	uint8_t* pDst = reinterpret_cast<uint8_t*>(data);
+	const uint32_t bytesPerSample = mBytesPerFrame / uint32_t(mAudioFormat.channelCount);
+	switch (bytesPerSample)
+	{
+		case 2:		extractChannels<2>(pDst, pSrc, frames, mBytesPerFrame, channels);	break;
+		case 3:		extractChannels<3>(pDst, pSrc, frames, mBytesPerFrame, channels);	break;
+		case 4:		extractChannels<4>(pDst, pSrc, frames, mBytesPerFrame, channels);	break;
+		default:
+			for (uint32_t frame = 0;  frame < frames;  frame++, pSrc += mBytesPerFrame)
+				for (size_t ndx = 0;  ndx < channels.size();  ndx++, pDst += bytesPerSample)
+					::memcpy(pDst, pSrc + channels[ndx] * bytesPerSample, bytesPerSample);
+			break;
+	}
+	mPosition += frames;
+	prefetch();
+	return frames;
+}
@@ -0,0 +1,119 @@
+/* SPDX-License-Identifier: MIT */
+/**
+	@file		wavereader.h
+	@brief		Declares the AJAWavReader class.
+	@copyright	(C) 2023 AJA Video Systems, Inc.  All rights reserved.
+**/
+
+#ifndef AJAWAVEREADER_H
+#define AJAWAVEREADER_H
+
+#include "public.h"
+#include "ajabase/common/wavewriter.h"
+#include <string>
+#include <vector>
+
+
+/**
+ *	Reads WAV, BWF and RF64 files, e.g. those written by AJAWavWriter, for playout.
+ *
+ *	Where the platform supports it, the file is memory-mapped, so samples are copied straight from the page cache,
+ *	and the pages ahead of the read position are requested from the disk asynchronously (read-ahead) so that
+ *	reading doesn't stall on I/O. Otherwise the samples are read through AJAFileIO.
+ *	Any subset of the channels can be extracted, in any order, as interleaved samples.
+ *	@ingroup AJAGroupSystem
+ */
+class AJA_EXPORT AJAWavReader
+{
+public:
+	AJAWavReader();
+	virtual ~AJAWavReader();
+
+	/**
+	 *	Open a file and parse its header.
+	 *
+	 *	@param[in]	fileName			The fully qualified file name
+	 *
+	 *	@return		bool				'true' if the file is a WAV, BWF or RF64 file with PCM or float samples
+	 */
+	bool open(const std::string & fileName);
+	void close();
+	bool isOpen() const					{return mIsOpen;}
+
+	const AJAWavWriterAudioFormat & audioFormat() const	{return mAudioFormat;}
+	bool isFloat() const				{return mIsFloat;}		///< @return	'true' if the samples are IEEE float
+	bool isRF64() const					{return mIsRF64;}		///< @return	'true' if the file is RF64
+	bool isMapped() const				{return mpMap != NULL;}	///< @return	'true' if the file is memory-mapped
+	bool hasBext() const				{return mHasBext;}		///< @return	'true' if the file has a BWF bext chunk
+	uint64_t timeReference() const		{return mTimeReference;}///< @return	The bext chunk's start time, in samples since midnight
+	uint32_t bytesPerFrame() const		{return mBytesPerFrame;}///< @return	The size of one sample of every channel, in bytes
+	uint64_t frameCount() const			{return mFrameCount;}	///< @return	The number of sample frames in the file
+	uint64_t position() const			{return mPosition;}		///< @return	The sample frame that will be read next
+
+	/**
+	 *	Move the read position.
+	 *
+	 *	@param[in]	frame				The sample frame to be read next
+	 *
+	 *	@return		bool				'true' if successful, 'false' if past the end of the file
+	 */
+	bool seek(uint64_t frame);
+
+	/**
+	 *	Set how far ahead of the read position the file is prefetched (memory-mapped files only).
+	 *
+	 *	@param[in]	frames				The number of sample frames to prefetch, 0 to disable (defaults to 48000)
+	 */
+	void setReadAhead(uint32_t frames);
+
+	/**
+	 *	Read interleaved samples of all channels, and advance the read position.
+	 *
+	 *	@param[out]	data				Receives the samples
+	 *	@param[in]	frames				The number of sample frames to be read
+	 *
+	 *	@return		uint32_t			The number of sample frames actually read
+	 */
+	uint32_t read(char* data, uint32_t frames);
+
+	/**
+	 *	Read interleaved samples of some of the channels, and advance the read position.
+	 *
+	 *	@param[out]	data				Receives channels.size() samples per sample frame
+	 *	@param[in]	frames				The number of sample frames to be read
+	 *	@param[in]	channels			The zero-based channels to extract, in the order they're wanted
+	 *
+	 *	@return		uint32_t			The number of sample frames actually read, 0 if a channel is out of range
+	 */
+	uint32_t readChannels(char* data, uint32_t frames, const std::vector<uint32_t> & channels);
+
+private:
+	AJAWavReader(const AJAWavReader & inObj);				// Not copyable
+	AJAWavReader & operator = (const AJAWavReader & inRHS);	// Not assignable
+
+	bool parseHeader();
+	bool readAt(uint64_t offset, void* pBuffer, uint32_t len);
+	const uint8_t* getFrames(uint32_t frames);
+	void prefetch();
+
+	AJAFileIO					mFile;
+	bool						mIsOpen;
+	uint64_t					mFileSize;
+	const uint8_t *				mpMap;
+
+	AJAWavWriterAudioFormat		mAudioFormat;
+	bool						mIsFloat;
+	bool						mIsRF64;
+	bool						mHasBext;
+	uint64_t					mTimeReference;
+	uint32_t					mBytesPerFrame;
+	uint64_t					mDataOffset;
+	uint64_t					mFrameCount;
+	uint64_t					mPosition;
+
+	uint32_t					mReadAheadFrames;
+	uint64_t					mPrefetchedTo;
+	std::vector<uint8_t>		mScratch;
+};
+
+#endif	//	AJAWAVEREADER_H
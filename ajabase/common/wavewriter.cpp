@@ -9,6 +9,9 @@
 
 #include "ajabase/common/timebase.h"
 #include "ajabase/common/timecode.h"
+#include "ajabase/system/event.h"
+#include "ajabase/system/lock.h"
+#include "ajabase/system/thread.h"
 #include <time.h>
 #include <assert.h>
 
@@ -21,10 +24,15 @@
 #endif
 
 const int sizeOf_riff	= 12;
+const int sizeOf_ds64	= 36;		// "JUNK" placeholder, becomes "ds64" if needed (EBU Tech 3306)
 const int sizeOf_bext_v1= 610;
 const int sizeOf_fmt	= 24;
+const int sizeOf_fmt_ext= 48;		// WAVE_FORMAT_EXTENSIBLE
 const int sizeOf_data	= 8;
 
+const uint32_t	kMaxFreeBlocks	= 16;
+const uint16_t	kWavFormatExtensible = 0xFFFE;
+
 #if defined(AJA_LITTLE_ENDIAN)
 #define AjaWavLittleEndianHw
 #else
@@ -80,16 +88,28 @@ AJAWavWriter::AJAWavWriter(const std::string & name, const AJAWavWriterAudioForm
 						   const std::string & startTimecode, AJAWavWriterChunkFlag flags,
 						   bool useFloatNotPCM)
 : AJAFileIO(), mFileName(name), mAudioFormat(audioFormat), mVideoFormat(videoFormat), mStartTimecode(startTimecode), mFlags(flags), mLittleEndian(true),
-  mUseFloatData(useFloatNotPCM)
+  mUseFloatData(useFloatNotPCM), mDataBytes(0), mMaxQueuedBytes(0), mQueuedBytes(0), mDroppedBytes(0),
+  mpQueueLock(NULL), mpQueuedEvent(NULL), mpDrainedEvent(NULL), mpThread(NULL), mQuit(false)
 {
-	mSizeOfHeader = sizeOf_riff + sizeOf_fmt + sizeOf_data;
+	mSizeOfHeader = sizeOf_riff + sizeOf_data;
+	mSizeOfHeader += (mFlags & AJAWavWriterChunkFlagExtensible) ? sizeOf_fmt_ext : sizeOf_fmt;
 	
+	if (mFlags & AJAWavWriterChunkFlagRF64)
+	{
+		mSizeOfHeader += sizeOf_ds64;
+	}
 	if (mFlags & AJAWavWriterChunkFlagBextV1)
 	{
 		mSizeOfHeader += sizeOf_bext_v1;
 	}
 }
 
+AJAWavWriter::~AJAWavWriter()
+{
+	if (IsOpen())
+		close();
+}
+
 // making this call not public
 AJAStatus AJAWavWriter::Open(const std::string& fileName, int flags, AJAFileProperties properties)
 {
@@ -109,15 +129,150 @@ bool AJAWavWriter::open()
 	if(result == AJA_STATUS_SUCCESS)
 	{
 		writeHeader();
+		mDataBytes = 0;
+		mQueuedBytes = 0;
+		mDroppedBytes = 0;
 		retVal = true;
+		
+		if (mMaxQueuedBytes)
+		{
+			// Start the write-behind thread -- if it can't be started, write synchronously
+			mpQueueLock = new AJALock;
+			mpQueuedEvent = new AJAEvent(false);
+			mpDrainedEvent = new AJAEvent(true);
+			mpDrainedEvent->Signal();
+			mQuit.Clear();
+			mpThread = new AJAThread;
+			mpThread->Attach(writeBehindThread, this);
+			if (AJA_SUCCESS(mpThread->Start()))
+			{
+				mpThread->SetThreadName("AJAWavWriter");
+			}
+			else
+			{
+				delete mpThread;		mpThread = NULL;
+				delete mpQueuedEvent;	mpQueuedEvent = NULL;
+				delete mpDrainedEvent;	mpDrainedEvent = NULL;
+				delete mpQueueLock;		mpQueueLock = NULL;
+			}
+		}
 	}
 	
 	return retVal;
 }
 
+bool AJAWavWriter::setWriteBehind(uint32_t maxQueuedBytes)
+{
+	if (IsOpen())
+		return false;
+	mMaxQueuedBytes = maxQueuedBytes;
+	return true;
+}
+
 uint32_t AJAWavWriter::write(const char* data, uint32_t len)
 {
-	return writeRawData(data,len);
+	if (!mpThread)
+	{
+		uint32_t written = writeRawData(data,len);
+		mDataBytes += written;
+		mDroppedBytes += len - written;
+		return written;
+	}
+	
+	// Write-behind -- take a block off the free list, fill it outside the lock, then queue it
+	Block* pBlock = NULL;
+	{
+		AJAAutoLock lock(mpQueueLock);
+		if (mQueuedBytes + len > mMaxQueuedBytes)
+		{
+			mDroppedBytes += len;
+			return 0;
+		}
+		mQueuedBytes += len;
+		mDataBytes += len;
+		if (!mFreeBlocks.empty())
+		{
+			pBlock = mFreeBlocks.back();
+			mFreeBlocks.pop_back();
+		}
+	}
+	if (!pBlock)
+		pBlock = new Block;
+	pBlock->assign((const uint8_t*)data, (const uint8_t*)data + len);
+	{
+		AJAAutoLock lock(mpQueueLock);
+		mQueue.push_back(pBlock);
+		mpDrainedEvent->Clear();
+	}
+	mpQueuedEvent->Signal();
+	return len;
+}
+
+bool AJAWavWriter::flush(uint32_t timeout)
+{
+	if (!mpThread)
+		return true;
+	mpQueuedEvent->Signal();
+	return mpDrainedEvent->WaitForSignal(timeout) == AJA_STATUS_SUCCESS;
+}
+
+uint64_t AJAWavWriter::queuedBytes() const
+{
+	AJAAutoLock lock(mpQueueLock);
+	return mQueuedBytes;
+}
+
+uint64_t AJAWavWriter::droppedBytes() const
+{
+	AJAAutoLock lock(mpQueueLock);
+	return mDroppedBytes;
+}
+
+uint64_t AJAWavWriter::dataBytes() const
+{
+	AJAAutoLock lock(mpQueueLock);
+	return mDataBytes;
+}
+
+void AJAWavWriter::writeBehindThread(AJAThread* pThread, void* pContext)
+{
+	AJAWavWriter* pWriter = reinterpret_cast<AJAWavWriter*>(pContext);
+	while (!pThread->Terminate()  &&  !pWriter->mQuit.IsSet())
+	{
+		pWriter->mpQueuedEvent->WaitForSignal(100);
+		pWriter->writeQueuedBlocks();
+	}
+	pWriter->writeQueuedBlocks();	// Drain whatever is left
+}
+
+void AJAWavWriter::writeQueuedBlocks()
+{
+	for (;;)
+	{
+		Block* pBlock = NULL;
+		{
+			AJAAutoLock lock(mpQueueLock);
+			if (mQueue.empty())
+			{
+				mpDrainedEvent->Signal();
+				return;
+			}
+			pBlock = mQueue.front();
+			mQueue.pop_front();
+		}
+		
+		// The disk write happens outside the lock, so write() never waits for it
+		const uint32_t len = uint32_t(pBlock->size());
+		const uint32_t written = Write(&(*pBlock)[0], len);
+		
+		AJAAutoLock lock(mpQueueLock);
+		mQueuedBytes -= len;
+		mDroppedBytes += len - written;
+		if (mFreeBlocks.size() < kMaxFreeBlocks)
+			mFreeBlocks.push_back(pBlock);
+		else
+			delete pBlock;
+	}
 }
 
 uint32_t AJAWavWriter::writeRawData(const char* data,uint32_t len)
@@ -187,6 +342,15 @@ void AJAWavWriter::writeHeader()
 	wtn += writeRaw_uint32_t(0);						   // Placeholder for the RIFF chunk size (filled by close())
 	wtn += writeRawData("WAVE", 4);
 	
+	if (mFlags & AJAWavWriterChunkFlagRF64)
+	{
+		// Reserve room for the ds64 chunk, which must immediately follow "WAVE" -- close() turns this into a
+		// ds64 chunk if the file ends up larger than 4 GB, otherwise readers skip it
+		wtn += writeRawData("JUNK", 4);
+		wtn += writeRaw_uint32_t(sizeOf_ds64 - 8);
+		wtn += writeRaw_uint8_t(0, sizeOf_ds64 - 8);
+	}
+	
 	if (mFlags & AJAWavWriterChunkFlagBextV1)
 	{
 		// bext chunk (version 1)
@@ -234,19 +398,30 @@ void AJAWavWriter::writeHeader()
 	}
 	
 	// Format description chunk
+	const bool extensible = (mFlags & AJAWavWriterChunkFlagExtensible) != 0;
 	wtn += writeRawData("fmt ", 4);
-	wtn += writeRaw_uint32_t(16);							   // "fmt " chunk size (always 16 for PCM)
+	wtn += writeRaw_uint32_t(extensible ? 40 : 16);			   // "fmt " chunk size (16 for PCM, 40 for extensible)
 	int audioFormat = 1; //PCM
 	if (mUseFloatData)
 	{
 		audioFormat = 3; //IEEE Float
 	}
-	wtn += writeRaw_uint16_t(audioFormat);					   // data format (1 => PCM), (3 => IEEE Float)
+	wtn += writeRaw_uint16_t(extensible ? kWavFormatExtensible : audioFormat);	// data format (1 => PCM), (3 => IEEE Float)
 	wtn += writeRaw_uint16_t(mAudioFormat.channelCount);
 	wtn += writeRaw_uint32_t(mAudioFormat.sampleRate);
 	wtn += writeRaw_uint32_t(mAudioFormat.sampleRate * mAudioFormat.channelCount * mAudioFormat.sampleSize / 8 ); // bytes per second
 	wtn += writeRaw_uint16_t(mAudioFormat.channelCount * mAudioFormat.sampleSize / 8); // Block align
 	wtn += writeRaw_uint16_t(mAudioFormat.sampleSize);		   // Significant Bits Per Sample
+	if (extensible)
+	{
+		wtn += writeRaw_uint16_t(22);						   // Size of the extension
+		wtn += writeRaw_uint16_t(mAudioFormat.sampleSize);	   // Valid Bits Per Sample
+		wtn += writeRaw_uint32_t(0);						   // Channel mask (no speaker positions assigned)
+		wtn += writeRaw_uint32_t(audioFormat);				   // Sub-format GUID {0000000x-0000-0010-8000-00AA00389B71}
+		wtn += writeRaw_uint16_t(0x0000);
+		wtn += writeRaw_uint16_t(0x0010);
+		wtn += writeRawData("\x80\x00\x00\xAA\x00\x38\x9B\x71", 8);
+	}
 	
 	// data chunk
 	wtn += writeRawData("data", 4);
@@ -257,18 +432,62 @@ void AJAWavWriter::writeHeader()
 
 void AJAWavWriter::close()
 {
+	if (!IsOpen())
+		return;
+	
+	if (mpThread)
+	{
+		// Write out the queue, then stop the write-behind thread
+		mQuit.Set();
+		mpQueuedEvent->Signal();
+		mpThread->Stop();
+		delete mpThread;		mpThread = NULL;
+		delete mpQueuedEvent;	mpQueuedEvent = NULL;
+		delete mpDrainedEvent;	mpDrainedEvent = NULL;
+		delete mpQueueLock;		mpQueueLock = NULL;
+		for (size_t ndx = 0;  ndx < mFreeBlocks.size();  ndx++)
+			delete mFreeBlocks[ndx];
+		mFreeBlocks.clear();
+	}
+	
 	// Fill the header size placeholders
-	uint32_t fileSize = (uint32_t)Tell();
+	const uint64_t fileSize = uint64_t(Tell());
+	const uint64_t riffSize = fileSize - 8;
+	const uint64_t dataSize = fileSize - mSizeOfHeader;
 	
 	mLittleEndian = true;
 	
-	// RIFF chunk size
-	Seek(4,eAJASeekSet);
-	writeRaw_uint32_t(fileSize - sizeOf_data);
-	
-	// data chunk size
-	Seek(mSizeOfHeader-4,eAJASeekSet);
-	writeRaw_uint32_t(fileSize - mSizeOfHeader);
+	if ((mFlags & AJAWavWriterChunkFlagRF64)  &&  riffSize > 0xFFFFFFFF)
+	{
+		// Too big for RIFF -- switch to RF64, whose 64-bit sizes are in the ds64 chunk
+		const uint32_t blockAlign = mAudioFormat.channelCount * mAudioFormat.sampleSize / 8;
+		const uint64_t sampleCount = blockAlign ? dataSize / blockAlign : 0;
+		Seek(0,eAJASeekSet);
+		writeRawData("RF64", 4);
+		writeRaw_uint32_t(0xFFFFFFFF);
+		Seek(sizeOf_riff,eAJASeekSet);
+		writeRawData("ds64", 4);
+		writeRaw_uint32_t(sizeOf_ds64 - 8);
+		writeRaw_uint32_t(uint32_t(riffSize));
+		writeRaw_uint32_t(uint32_t(riffSize >> 32));
+		writeRaw_uint32_t(uint32_t(dataSize));
+		writeRaw_uint32_t(uint32_t(dataSize >> 32));
+		writeRaw_uint32_t(uint32_t(sampleCount));
+		writeRaw_uint32_t(uint32_t(sampleCount >> 32));
+		writeRaw_uint32_t(0);								   // No table entries
+		Seek(mSizeOfHeader-4,eAJASeekSet);
+		writeRaw_uint32_t(0xFFFFFFFF);
+	}
+	else
+	{
+		// RIFF chunk size
+		Seek(4,eAJASeekSet);
+		writeRaw_uint32_t(riffSize > 0xFFFFFFFF ? 0xFFFFFFFF : uint32_t(riffSize));
+		
+		// data chunk size
+		Seek(mSizeOfHeader-4,eAJASeekSet);
+		writeRaw_uint32_t(dataSize > 0xFFFFFFFF ? 0xFFFFFFFF : uint32_t(dataSize));
+	}
 	
 	Close();
 }
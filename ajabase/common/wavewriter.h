@@ -9,7 +9,13 @@
 #define AJAWAVEWRITER_H
 
 #include "public.h"
+#include "ajabase/system/atomic.h"
 #include "ajabase/system/file_io.h"
+#include <deque>
+
+class AJAEvent;
+class AJALock;
+class AJAThread;
 
 
 class AJA_EXPORT AJAWavWriterAudioFormat
@@ -38,8 +44,10 @@ public:
 
 enum AJAWavWriterChunkFlag
 {
-	AJAWavWriterChunkFlagStandard = 1 << 0,
-	AJAWavWriterChunkFlagBextV1	  = 1 << 1
+	AJAWavWriterChunkFlagStandard	= 1 << 0,
+	AJAWavWriterChunkFlagBextV1		= 1 << 1,
+	AJAWavWriterChunkFlagRF64		= 1 << 2,	///< Reserve a ds64 chunk, and switch to RF64 (EBU Tech 3306) if the file exceeds 4 GB
+	AJAWavWriterChunkFlagExtensible	= 1 << 3	///< Write a WAVE_FORMAT_EXTENSIBLE "fmt " chunk (recommended for more than 2 channels or 16 bits)
 };
 
 
@@ -52,10 +60,46 @@ public:
 				 const AJAWavWriterVideoFormat & videoFormat = AJAWavWriterVideoFormat(),
 				 const std::string & startTimecode = "00:00:00;00", AJAWavWriterChunkFlag flags = AJAWavWriterChunkFlagStandard,
 				 bool useFloatNotPCM = false);
+	virtual ~AJAWavWriter();
+
 	bool open();
 	void close();
-	
+
+	/**
+	 *	Write audio samples.
+	 *
+	 *	If write-behind is enabled, the samples are copied into a queue that's written to the file by a
+	 *	background thread, and the call returns without waiting for the disk. If the queue is full, nothing
+	 *	is queued, and the samples are counted as dropped.
+	 *
+	 *	@param[in]	data				The interleaved samples to be written
+	 *	@param[in]	len					The number of bytes to be written
+	 *
+	 *	@return		uint32_t			The number of bytes written (or queued), 0 if dropped
+	 */
 	uint32_t write(const char* data, uint32_t len);
+
+	/**
+	 *	Enable or disable write-behind. Must be called before open().
+	 *
+	 *	@param[in]	maxQueuedBytes		The most bytes that can be waiting to be written, 0 to write synchronously
+	 *
+	 *	@return		bool				'true' if successful, 'false' if the file is already open
+	 */
+	bool setWriteBehind(uint32_t maxQueuedBytes);
+
+	/**
+	 *	Wait for the write-behind queue to be written to the file.
+	 *
+	 *	@param[in]	timeout				Wait timeout in milliseconds
+	 *
+	 *	@return		bool				'true' if the queue is empty
+	 */
+	bool flush(uint32_t timeout = 0xffffffff);
+
+	uint64_t queuedBytes() const;			///< @return	The number of bytes waiting to be written
+	uint64_t droppedBytes() const;			///< @return	The number of bytes dropped because the queue was full or the disk write failed
+	uint64_t dataBytes() const;				///< @return	The number of sample bytes written (or queued) since open()
 	
 protected:
 	AJAStatus Open(const std::string& fileName, int flags, AJAFileProperties properties);	 
@@ -69,6 +113,8 @@ private:
 	uint32_t writeRaw_uint32_t(uint32_t value, uint32_t count=1);
 	
 	void writeHeader();
+	void writeQueuedBlocks();
+	static void writeBehindThread(AJAThread* pThread, void* pContext);
 	
 	std::string					mFileName;
 	AJAWavWriterAudioFormat		mAudioFormat;
@@ -78,6 +124,20 @@ private:
 	bool						mLittleEndian;
 	int32_t						mSizeOfHeader;
 	bool						mUseFloatData;
+	uint64_t					mDataBytes;
+
+	//	Write-behind
+	typedef std::vector<uint8_t>	Block;
+	uint32_t					mMaxQueuedBytes;
+	uint64_t					mQueuedBytes;
+	uint64_t					mDroppedBytes;
+	std::deque<Block*>			mQueue;
+	std::vector<Block*>			mFreeBlocks;
+	AJALock *					mpQueueLock;
+	AJAEvent *					mpQueuedEvent;
+	AJAEvent *					mpDrainedEvent;
+	AJAThread *					mpThread;
+	AJAAtomicFlag				mQuit;
 };
 
 #endif	//	AJAWAVEWRITER_H
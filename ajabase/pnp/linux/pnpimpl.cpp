@@ -6,52 +6,128 @@
 **/
 
 #include "ajabase/pnp/linux/pnpimpl.h"
+#include "ajabase/system/systemtime.h"
+#include <dirent.h>
+#include <errno.h>
+#include <fcntl.h>
+#include <poll.h>
+#include <string.h>
+#include <unistd.h>
+#include <sys/inotify.h>
 
+using namespace std;
 
-AJAPnpImpl::AJAPnpImpl() : mRefCon(NULL), mCallback(NULL), mDevices(0)
+static const string		kDefaultDeviceDir	("/dev");
+static const char		kDeviceNodePrefix[]	= "ajantv2";	//	e.g. "/dev/ajantv20"
+static const int		kDebounceMs			(20);		//	Report once no more events arrive for this long...
+static const uint64_t	kMaxDebounceMs		(250);		//	...or once a burst has lasted this long
+static const uint32_t	kWatchMask			(IN_CREATE | IN_DELETE | IN_MOVED_FROM | IN_MOVED_TO | IN_ATTRIB | IN_DELETE_SELF);
+
+static bool IsDeviceNodeName (const char * pName)
+{
+	return pName  &&  ::strncmp(pName, kDeviceNodePrefix, sizeof(kDeviceNodePrefix) - 1) == 0;
+}
+
+
+AJAPnpImpl::AJAPnpImpl() : mRefCon(NULL), mCallback(NULL), mDevices(0), mDeviceDir(kDefaultDeviceDir),
+	mpThread(NULL), mInotifyFD(-1), mWatchFD(-1), mQuit(false), mReinstall(false)
 {
+	mWakeFD[0] = mWakeFD[1] = -1;
 }
 
 
 AJAPnpImpl::~AJAPnpImpl()
 {
 	Uninstall();
+	StopWatching();
 }
 
 
-AJAStatus 
+AJAStatus
 AJAPnpImpl::Install(AJAPnpCallback callback, void* refCon, uint32_t devices)
 {
+	if (mpThread  &&  mpThread->IsCurrentThread())
+	{	//	Called from my callback -- my watcher thread can't stop itself, so it starts over once the callback returns
+		AJAAutoLock lock(&mCallbackLock);
+		mCallback = callback;
+		mRefCon = refCon;
+		mDevices = devices;
+		mReinstall = true;
+		if (!mCallback  ||  (mDevices  &&  !(mDevices & AJA_Pnp_PciVideoDevices)))
+			mQuit.Set();	//	Nothing left to watch
+		else
+			mQuit.Clear();	//	In case the callback called Uninstall first
+		return AJA_STATUS_SUCCESS;
+	}
+
+	Uninstall();
+	StopWatching();
+
+	AJAAutoLock lock(&mCallbackLock);
 	mCallback = callback;
 	mRefCon = refCon;
 	mDevices = devices;
-	
-	if (mCallback)
-		(*(mCallback))(AJA_Pnp_DeviceAdded, mRefCon);
-	
+	mQuit.Clear();
+	if (!mCallback)
+		return AJA_STATUS_SUCCESS;
+	if (mDevices  &&  !(mDevices & AJA_Pnp_PciVideoDevices))
+		return AJA_STATUS_SUCCESS;	//	Only PCI video devices have device nodes
+
+	//	Start watching before listing, so that no change goes unnoticed...
+	mInotifyFD = ::inotify_init1(IN_NONBLOCK | IN_CLOEXEC);
+	if (mInotifyFD < 0)
+		{Uninstall();  return AJA_STATUS_FAIL;}
+	if (!WatchDeviceDirectory()  ||  ::pipe(mWakeFD) < 0)
+		{StopWatching();  Uninstall();  return AJA_STATUS_FAIL;}
+
+	mpThread = new AJAThread;
+	mpThread->Attach(WatchThread, this);
+	mReinstall = true;	//	The watcher thread first reports what's already attached
+	if (AJA_FAILURE(mpThread->Start()))
+		{StopWatching();  Uninstall();  return AJA_STATUS_FAIL;}
+	mpThread->SetThreadName("AJAPnp");
 	return AJA_STATUS_SUCCESS;
 }
-	
 
-AJAStatus 
+
+AJAStatus
 AJAPnpImpl::Uninstall(void)
 {
+	AJAAutoLock lock(&mCallbackLock);
 	mCallback = NULL;
 	mRefCon = NULL;
 	mDevices = 0;
-	
+	mQuit.Set();	//	The watcher thread quits once it sees this (e.g. if called from the callback)
+	if (mpThread  &&  !mpThread->IsCurrentThread()  &&  mWakeFD[1] >= 0)
+	{
+		const char wake(0);
+		if (::write(mWakeFD[1], &wake, 1) < 0)
+			{}	//	The thread also checks mQuit
+	}
+
+	return AJA_STATUS_SUCCESS;
+}
+
+
+AJAStatus
+AJAPnpImpl::SetDeviceDirectory(const string & path)
+{
+	if (path.empty())
+		return AJA_STATUS_BAD_PARAM;
+	AJAAutoLock lock(&mCallbackLock);
+	mDeviceDir = path;
 	return AJA_STATUS_SUCCESS;
 }
 
 
-AJAPnpCallback 
+AJAPnpCallback
 AJAPnpImpl::GetCallback()
 {
 	return mCallback;
 }
 
 
-void* 
+void*
 AJAPnpImpl::GetRefCon()
 {
 	return mRefCon;
@@ -65,4 +141,148 @@ AJAPnpImpl::GetPnpDevices()
 }
 
 
+void
+AJAPnpImpl::StopWatching(void)
+{
+	if (mpThread)
+	{
+		if (mpThread->IsCurrentThread())
+			return;	//	Can't join myself -- the destructor (or the next Install from another thread) will finish the job
+		mQuit.Set();
+		if (mWakeFD[1] >= 0)
+		{
+			const char wake(0);
+			if (::write(mWakeFD[1], &wake, 1) < 0)
+				{}	//	The thread also checks mQuit
+		}
+		mpThread->Stop();
+		delete mpThread;
+		mpThread = NULL;
+	}
+	if (mInotifyFD >= 0)
+		{::close(mInotifyFD);  mInotifyFD = -1;}
+	mWatchFD = -1;
+	mReinstall = false;
+	for (int ndx(0);  ndx < 2;  ndx++)
+		if (mWakeFD[ndx] >= 0)
+			{::close(mWakeFD[ndx]);  mWakeFD[ndx] = -1;}
+	mNodes.clear();
+}
+
+
+bool
+AJAPnpImpl::WatchDeviceDirectory(void)
+{
+	if (mWatchFD >= 0)
+		::inotify_rm_watch(mInotifyFD, mWatchFD);	//	Events still queued for the old watch are ignored
+	mWatchFD = ::inotify_add_watch(mInotifyFD, mDeviceDir.c_str(), kWatchMask);
+	return mWatchFD >= 0;
+}
+
+
+void
+AJAPnpImpl::ListDeviceNodes(NodeSet & outNodes) const
+{
+	outNodes.clear();
+	DIR * pDir(::opendir(mDeviceDir.c_str()));
+	if (!pDir)
+		return;
+	for (struct dirent * pEntry(::readdir(pDir));  pEntry;  pEntry = ::readdir(pDir))
+		if (IsDeviceNodeName(pEntry->d_name))
+			outNodes.insert(pEntry->d_name);
+	::closedir(pDir);
+}
+
+
+void
+AJAPnpImpl::Notify(AJAPnpMessage message)
+{
+	AJAAutoLock lock(&mCallbackLock);
+	if (mCallback  &&  !mQuit.IsSet())
+		(*(mCallback))(message, mRefCon);
+}
+
 
+void
+AJAPnpImpl::WatchThread(AJAThread* pThread, void* pContext)
+{
+	AJA_UNUSED(pThread);
+	AJAPnpImpl * pImpl(reinterpret_cast<AJAPnpImpl*>(pContext));
+	pImpl->Watch();
+}
+
+
+void
+AJAPnpImpl::Watch(void)
+{
+	union
+	{
+		struct inotify_event	event;
+		char					bytes[4096];
+	} buffer;
+	struct pollfd fds[2];
+	fds[0].fd = mInotifyFD;		fds[0].events = POLLIN;
+	fds[1].fd = mWakeFD[0];		fds[1].events = POLLIN;
+
+	int timeoutMs(-1);			//	Sleep until something happens
+	bool changed(false);		//	A device node event arrived, and hasn't yet been reported
+	uint64_t burstStartMs(0);
+	while (!mQuit.IsSet()  &&  !mpThread->Terminate())
+	{
+		if (mReinstall)
+		{	//	Just installed (maybe by the callback) -- (re)start watching, and report what's attached
+			AJAAutoLock lock(&mCallbackLock);
+			mReinstall = false;
+			timeoutMs = -1;
+			changed = false;
+			if (!WatchDeviceDirectory())
+				break;
+			ListDeviceNodes(mNodes);
+			for (NodeSet::const_iterator it(mNodes.begin());  it != mNodes.end()  &&  !mReinstall;  ++it)
+				Notify(AJA_Pnp_DeviceAdded);
+			continue;
+		}
+
+		fds[0].revents = fds[1].revents = 0;
+		const int numReady(::poll(fds, 2, timeoutMs));
+		if (numReady < 0  &&  errno != EINTR)
+			break;
+		if (mQuit.IsSet()  ||  fds[1].revents)
+			break;
+
+		if (fds[0].revents & POLLIN)
+		{
+			for (ssize_t len(::read(mInotifyFD, buffer.bytes, sizeof(buffer)));  len > 0;
+					len = ::read(mInotifyFD, buffer.bytes, sizeof(buffer)))
+				for (ssize_t pos(0);  pos < len;  )
+				{
+					const struct inotify_event * pEvent (reinterpret_cast<const struct inotify_event*>(buffer.bytes + pos));
+					if (pEvent->mask & IN_Q_OVERFLOW)
+						changed = true;
+					else if (pEvent->wd == mWatchFD)
+						if ((pEvent->mask & (IN_DELETE_SELF | IN_IGNORED))  ||  (pEvent->len  &&  IsDeviceNodeName(pEvent->name)))
+							changed = true;
+					pos += ssize_t(sizeof(struct inotify_event) + pEvent->len);
+				}
+			if (changed  &&  timeoutMs < 0)
+				{burstStartMs = AJATime::GetSystemMilliseconds();  timeoutMs = kDebounceMs;}
+			if (!changed  ||  AJATime::GetSystemMilliseconds() - burstStartMs < kMaxDebounceMs)
+				continue;	//	Wait for the burst to settle
+		}
+		else if (numReady != 0  ||  !changed)
+			continue;
+
+		//	Quiet for kDebounceMs (or the burst has gone on too long) -- report what changed
+		timeoutMs = -1;
+		changed = false;
+		NodeSet nodes;
+		ListDeviceNodes(nodes);
+		for (NodeSet::const_iterator it(mNodes.begin());  it != mNodes.end()  &&  !mReinstall;  ++it)
+			if (nodes.find(*it) == nodes.end())
+				Notify(AJA_Pnp_DeviceRemoved);
+		for (NodeSet::const_iterator it(nodes.begin());  it != nodes.end()  &&  !mReinstall;  ++it)
+			if (mNodes.find(*it) == mNodes.end())
+				Notify(AJA_Pnp_DeviceAdded);
+		mNodes.swap(nodes);
+	}
+}
@@ -9,6 +9,11 @@
 #define AJA_PNP_IMPL_H
 
 #include "ajabase/pnp/pnp.h"
+#include "ajabase/system/atomic.h"
+#include "ajabase/system/lock.h"
+#include "ajabase/system/thread.h"
+#include <set>
+#include <string>
 
 class AJAPnpImpl
 {
@@ -18,16 +23,34 @@ public:
 
 	AJAStatus Install(AJAPnpCallback callback, void* refCon, uint32_t devices);
 	AJAStatus Uninstall(void);
-	
+	AJAStatus SetDeviceDirectory(const std::string & path);
+
 	AJAPnpCallback GetCallback();
 	void* GetRefCon();
 	uint32_t GetPnpDevices();
 
 private:
-	
+	typedef std::set<std::string>	NodeSet;
+
+	static void WatchThread(AJAThread* pThread, void* pContext);
+	void Watch(void);
+	void StopWatching(void);
+	bool WatchDeviceDirectory(void);
+	void ListDeviceNodes(NodeSet & outNodes) const;
+	void Notify(AJAPnpMessage message);
+
 	void*				mRefCon;
 	AJAPnpCallback		mCallback;
 	uint32_t			mDevices;
+	std::string			mDeviceDir;		///< @brief	Directory watched for device nodes (defaults to "/dev")
+	AJALock				mCallbackLock;	///< @brief	Guards mCallback & mRefCon
+	AJAThread *			mpThread;		///< @brief	Watches mDeviceDir while a callback is installed
+	int					mInotifyFD;
+	int					mWatchFD;		///< @brief	inotify watch descriptor for mDeviceDir
+	int					mWakeFD[2];		///< @brief	Pipe that wakes the watcher thread when it's time to quit
+	AJAAtomicFlag		mQuit;			///< @brief	Set to stop the watcher thread
+	bool				mReinstall;		///< @brief	Set by Install -- the watcher thread rescans & reports attached devices
+	NodeSet				mNodes;			///< @brief	Device nodes present when last reported
 };
 
 #endif	//	AJA_PNP_IMPL_H
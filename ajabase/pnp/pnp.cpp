@@ -69,6 +69,18 @@ AJAPnp::GetPnpDevices() const
 }
 
 
+AJAStatus
+AJAPnp::SetDeviceDirectory(const std::string & path)
+{
+#if defined(AJA_LINUX)
+	return mpImpl->SetDeviceDirectory(path);
+#else
+	AJA_UNUSED(path);
+	return AJA_STATUS_UNSUPPORTED;
+#endif
+}
+
+
 AJAPnp::AJAPnp (const AJAPnp & inObjToCopy)
 {
 	AJA_UNUSED(inObjToCopy); assert (false && "hidden copy constructor");	//	mpImpl=inObjToCopy.mpImpl;
@@ -9,6 +9,7 @@
 #define AJA_PNP_H
 
 #include "ajabase/common/public.h"
+#include <string>
 
 
 typedef enum 
@@ -46,7 +47,11 @@ class AJAPnpImpl;
 	@brief		This is a platform-agnostic plug-and-play class that notifies a client when AJA devices are
 				attached/detached, powered on/off, sleep/wake, etc.
 	@ingroup	AJAGroupPnp
-	@bug		This class has no Linux implementation.
+	@note		On Linux, a background thread watches the device node directory (see SetDeviceDirectory) for
+				"ajantv2" nodes being created or removed, and calls the callback from that thread (including the
+				initial AJA_Pnp_DeviceAdded calls), which may call Install or Uninstall. Bursts of changes
+				are reported once they've settled for a few milliseconds. The callback doesn't say which device was
+				added or removed, so clients typically call CNTV2DeviceScanner::InvalidateDeviceList.
 **/
 class AJA_EXPORT AJAPnp
 {
@@ -105,6 +110,14 @@ public:	//	INSTANCE METHODS
 	 */
 	virtual uint32_t GetPnpDevices() const;
 
+	/**
+	 *	@brief		Changes the directory that's watched for device nodes (Linux only). Takes effect at the next Install.
+	 *	@param[in]	path			Specifies the directory. Defaults to "/dev".
+	 *	@return		AJA_STATUS_SUCCESS		Directory changed
+	 *				AJA_STATUS_UNSUPPORTED	Not Linux
+	 */
+	virtual AJAStatus SetDeviceDirectory(const std::string & path);
+
 
 private:	//	INSTANCE METHODS
 	/**
@@ -27,6 +27,19 @@ void* AJAAtomic::Exchange(void* volatile* pTarget, void* pValue)
 }
 
 
+void* AJAAtomic::CompareAndSwap(void* volatile* pTarget, void* pExpected, void* pValue)
+{
+	// replace pointer target with value if it equals expected
+#if defined(AJA_WINDOWS)
+	return InterlockedCompareExchangePointer((PVOID volatile*)pTarget, (PVOID)pValue, (PVOID)pExpected);
+#endif
+
+#if defined(AJA_LINUX) || defined(AJA_MAC)
+	return __sync_val_compare_and_swap(pTarget, pExpected, pValue);
+#endif
+}
+
+
 int32_t AJAAtomic::Exchange(int32_t volatile* pTarget, int32_t value)
 {
 	// exchange integer value with target
@@ -181,3 +194,48 @@ uint64_t AJAAtomic::Decrement(uint64_t volatile* pTarget)
 	return __sync_sub_and_fetch(pTarget, 1);
 #endif
 }
+
+
+uint64_t AJAAtomic::Add(uint64_t volatile* pTarget, uint64_t value)
+{
+	// add value to target
+#if defined(AJA_WINDOWS)
+	return (uint64_t)InterlockedExchangeAdd64((LONGLONG volatile*)pTarget, (LONGLONG)value) + value;
+#endif
+
+#if defined(AJA_LINUX) || defined(AJA_MAC)
+	return __sync_add_and_fetch(pTarget, value);
+#endif
+}
+
+
+uint64_t AJAAtomic::CompareAndSwap(uint64_t volatile* pTarget, uint64_t expected, uint64_t value)
+{
+	// replace target with value if it equals expected
+#if defined(AJA_WINDOWS)
+	return (uint64_t)InterlockedCompareExchange64((LONGLONG volatile*)pTarget, (LONGLONG)value, (LONGLONG)expected);
+#endif
+
+#if defined(AJA_LINUX) || defined(AJA_MAC)
+	return __sync_val_compare_and_swap(pTarget, expected, value);
+#endif
+}
+
+
+void AJAAtomicFlag::Set(bool value)
+{
+	AJAAtomic::Exchange(&mValue, uint32_t(value ? 1 : 0));
+}
+
+
+bool AJAAtomicFlag::IsSet(void) const
+{
+	// read with a full barrier
+#if defined(AJA_WINDOWS)
+	return InterlockedCompareExchange((LONG volatile*)&mValue, 0, 0) != 0;
+#endif
+
+#if defined(AJA_LINUX) || defined(AJA_MAC)
+	return __sync_add_and_fetch(&mValue, 0) != 0;
+#endif
+}
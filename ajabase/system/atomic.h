@@ -27,6 +27,17 @@ class AJA_EXPORT AJAAtomic
 		 */
 		static void* Exchange(void* volatile* pTarget, void* pValue);
 
+		/**
+		 *	Compare the pointer target with an expected value, and if equal, replace it. Acts as a full memory barrier,
+		 *	so it can both publish a pointer (after initializing what it points to) and read one (with expected == value).
+		 *
+		 *	@param[in,out]	pTarget		The target to compare and replace.
+		 *	@param[in]		pExpected	The value the target is expected to have.
+		 *	@param[in]		pValue		The value to store into the target if it equals the expected value.
+		 *	@return						The value of the target before the operation (equals pExpected if replaced).
+		 */
+		static void* CompareAndSwap(void* volatile* pTarget, void* pExpected, void* pValue);
+
 		/**
 		 *	Exchange the integer value with the target.
 		 *
@@ -126,6 +137,60 @@ class AJA_EXPORT AJAAtomic
 		 *	@return					The target value post decrement.
 		 */
 		static uint64_t Decrement(uint64_t volatile* pTarget);
+
+		/**
+		 *	Add a value to the unsigned integer target.
+		 *
+		 *	@param[in,out]	pTarget The target to add to.
+		 *	@param[in]		value	The value to add.
+		 *	@return					The target value post addition.
+		 */
+		static uint64_t Add(uint64_t volatile* pTarget, uint64_t value);
+
+		/**
+		 *	Compare the unsigned integer target with an expected value, and if equal, replace it.
+		 *
+		 *	@param[in,out]	pTarget		The target to compare and replace.
+		 *	@param[in]		expected	The value the target is expected to have.
+		 *	@param[in]		value		The value to store into the target if it equals the expected value.
+		 *	@return						The value of the target before the operation (equals expected if replaced).
+		 */
+		static uint64_t CompareAndSwap(uint64_t volatile* pTarget, uint64_t expected, uint64_t value);
 };	//	AJAAtomic
 
+
+/** 
+ *	A boolean flag that one thread can safely set while others poll it (e.g. to tell a worker thread to quit).
+ *	Setting and testing it are atomic, and act as memory barriers.
+ *	@ingroup AJAGroupSystem
+ */
+class AJA_EXPORT AJAAtomicFlag
+{
+	public:
+		explicit AJAAtomicFlag(bool value = false) : mValue(value ? 1 : 0)	{}
+
+		/**
+		 *	Set or clear the flag.
+		 *
+		 *	@param[in]	value	The new value of the flag.
+		 */
+		void Set(bool value = true);
+
+		/**
+		 *	Clear the flag.
+		 */
+		void Clear(void)	{Set(false);}
+
+		/**
+		 *	@return		True if the flag is set.
+		 */
+		bool IsSet(void) const;
+
+	private:
+		AJAAtomicFlag(const AJAAtomicFlag&);				//	Not copyable
+		AJAAtomicFlag& operator=(const AJAAtomicFlag&);	//	Not assignable
+
+		mutable uint32_t volatile	mValue;
+};	//	AJAAtomicFlag
+
 #endif	//	AJA_ATOMIC_H
@@ -17,12 +17,30 @@
 	#include <sys/types.h>
 	#include <unistd.h>
 	#include <string.h> //	for strerror
+	#if defined(AJA_LINUX)
+		#include <fstream>
+		#include <sstream>
+		#include <sys/syscall.h>
+	#endif
 #elif defined(MSWindows)
     #include "ajabase/system/system.h"  //  for Windows API #includes
 #elif defined(AJA_BAREMETAL)
   #include <malloc.h>
 #endif
 #include <iostream>
+#include <map>
+
+#if defined(AJA_LINUX)
+	#if !defined(MAP_HUGETLB)
+		#define MAP_HUGETLB		0x40000
+	#endif
+	#if !defined(MAP_HUGE_SHIFT)
+		#define MAP_HUGE_SHIFT	26
+	#endif
+	// from <numaif.h>, to avoid depending on libnuma
+	#define AJA_MPOL_PREFERRED	1
+	#define AJA_MPOL_BIND		2
+#endif
 
 // structure to track shared memory allocations
 struct SharedData
@@ -31,6 +49,7 @@ struct SharedData
 	void*		pMemory;
 	size_t		memorySize;
 	int32_t		refCount;
+	AJAMemoryInfo info;
 #if defined(AJA_WINDOWS)
 	HANDLE		fileMapHandle;
 #else
@@ -57,6 +76,206 @@ static AJALock sSharedLock;
 // list of allocated shared memory
 static std::list<SharedData> sSharedList;
 
+// lock for, and map of, aligned allocations made with options (they're mapped pages rather than heap blocks)
+static AJALock sMappedLock;
+static std::map<const void*, AJAMemoryInfo> sMappedMap;
+
+
+AJAMemoryOptions::AJAMemoryOptions()
+	:	pageSize(AJA_MEMORY_PAGES_DEFAULT),
+		allowFallback(true),
+		prefault(false),
+		lock(false),
+		numaNode(-1)
+{
+}
+
+bool AJAMemoryOptions::IsDefault() const
+{
+	return pageSize == AJA_MEMORY_PAGES_DEFAULT  &&  !prefault  &&  !lock  &&  numaNode < 0;
+}
+
+AJAMemoryInfo::AJAMemoryInfo()
+	:	size(0),
+		pageSize(0),
+		prefaulted(false),
+		locked(false),
+		numaNode(-1)
+{
+}
+
+
+static inline size_t RoundUp(size_t bytes, size_t multiple)
+{
+	return (bytes + multiple - 1) / multiple * multiple;
+}
+
+// Binds the given pages to a NUMA node. Must be called before the pages are first touched.
+static bool BindToNumaNode(void* pMemory, size_t bytes, int32_t numaNode, bool strict)
+{
+#if defined(AJA_LINUX) && defined(SYS_mbind)
+	const size_t kMaxNodes = 1024;
+	const size_t kBitsPerLong = 8 * sizeof(unsigned long);
+	if (numaNode < 0  ||  size_t(numaNode) >= kMaxNodes)
+		return false;
+	unsigned long nodeMask[kMaxNodes / kBitsPerLong] = {0};
+	nodeMask[size_t(numaNode) / kBitsPerLong] = 1UL << (size_t(numaNode) % kBitsPerLong);
+	if (syscall(SYS_mbind, pMemory, bytes, strict ? AJA_MPOL_BIND : AJA_MPOL_PREFERRED, nodeMask, kMaxNodes + 1, 0) == 0)
+		return true;
+	AJA_REPORT(0, AJA_DebugSeverity_Warning, "AJAMemory  mbind to NUMA node %d failed: %s", int(numaNode), strerror(errno));
+	return false;
+#else
+	(void) pMemory;  (void) bytes;  (void) numaNode;  (void) strict;
+	return false;
+#endif
+}
+
+// Faults in every page. Fresh private pages are written (reading them would just map the shared zero page);
+// shared pages are only read, so existing content is left alone.
+static void PrefaultPages(void* pMemory, size_t bytes, size_t pageBytes, bool write)
+{
+	volatile uint8_t* pBytes = reinterpret_cast<volatile uint8_t*>(pMemory);
+	uint8_t sum = 0;
+	for (size_t offset = 0;  offset < bytes;  offset += pageBytes)
+		if (write)
+			pBytes[offset] = 0;
+		else
+			sum = uint8_t(sum + pBytes[offset]);
+	(void) sum;
+}
+
+static bool LockPages(void* pMemory, size_t bytes)
+{
+#if defined(AJA_WINDOWS)
+	if (VirtualLock(pMemory, bytes))
+		return true;
+	AJA_REPORT(0, AJA_DebugSeverity_Warning, "AJAMemory  VirtualLock failed (err=%d)", int(GetLastError()));
+	return false;
+#elif defined(AJA_BAREMETAL)
+	(void) pMemory;  (void) bytes;
+	return false;
+#else
+	if (mlock(pMemory, bytes) == 0)
+		return true;
+	AJA_REPORT(0, AJA_DebugSeverity_Warning, "AJAMemory  mlock of %lu bytes failed: %s", (unsigned long)bytes, strerror(errno));
+	return false;
+#endif
+}
+
+// Applies the NUMA, prefault and lock options to newly mapped pages
+static bool ApplyOptions(void* pMemory, const AJAMemoryOptions& options, bool freshPrivatePages, AJAMemoryInfo& info)
+{
+	if (options.numaNode >= 0  &&  info.numaNode < 0)
+	{
+		if (BindToNumaNode(pMemory, info.size, options.numaNode, !options.allowFallback))
+			info.numaNode = options.numaNode;
+		else if (!options.allowFallback)
+			return false;
+	}
+	if (options.prefault)
+	{
+		PrefaultPages(pMemory, info.size, info.pageSize, freshPrivatePages);
+		info.prefaulted = true;
+	}
+	if (options.lock  &&  !info.locked)
+		info.locked = LockPages(pMemory, info.size);
+	return true;
+}
+
+#if defined(AJA_LINUX)
+// Answers with the mount point of a hugetlbfs filesystem with the given page size, if any
+static std::string HugeTLBFSMountPoint(size_t pageBytes)
+{
+	std::ifstream mounts("/proc/mounts");
+	std::string line;
+	while (std::getline(mounts, line))
+	{
+		std::istringstream iss(line);
+		std::string device, mountPoint, fsType, mountOptions;
+		if (!(iss >> device >> mountPoint >> fsType >> mountOptions)  ||  fsType != "hugetlbfs")
+			continue;
+		const std::string::size_type pos = mountOptions.find("pagesize=");
+		if (pos == std::string::npos)
+			continue;
+		char* pSuffix = NULL;
+		size_t mountPageBytes = size_t(strtoul(mountOptions.c_str() + pos + 9, &pSuffix, 10));
+		switch (pSuffix ? *pSuffix : 0)
+		{
+			case 'G':	mountPageBytes *= 1024;	// fall thru
+			case 'M':	mountPageBytes *= 1024;	// fall thru
+			case 'K':	mountPageBytes *= 1024;	break;
+			default:	break;
+		}
+		if (mountPageBytes == pageBytes)
+			return mountPoint;
+	}
+	return std::string();
+}
+#endif	// AJA_LINUX
+
+// Maps bytes of private memory (a multiple of the page size), aligned to alignment. Returns NULL on failure.
+static void* MapPrivatePages(size_t bytes, size_t alignment, AJAMemoryPageSize pageSize, int32_t numaNode, bool& outNumaBound)
+{
+	outNumaBound = false;
+#if defined(AJA_WINDOWS)
+	SYSTEM_INFO sysInfo;
+	GetSystemInfo(&sysInfo);
+	if (pageSize == AJA_MEMORY_PAGES_1GB  ||  (pageSize == AJA_MEMORY_PAGES_2MB  &&  GetLargePageMinimum() != AJAMemory::PageSizeBytes(pageSize)))
+		return NULL;	// 1GB pages need VirtualAlloc2, and large pages must be 2MB
+	if (alignment > sysInfo.dwAllocationGranularity  &&  pageSize == AJA_MEMORY_PAGES_DEFAULT)
+		return NULL;
+	DWORD allocType = MEM_RESERVE | MEM_COMMIT;
+	if (pageSize != AJA_MEMORY_PAGES_DEFAULT)
+		allocType |= MEM_LARGE_PAGES;
+	void* pMemory = NULL;
+	if (numaNode >= 0)
+		pMemory = VirtualAllocExNuma(GetCurrentProcess(), NULL, bytes, allocType, PAGE_READWRITE, DWORD(numaNode));
+	if (pMemory)
+		outNumaBound = true;
+	else
+		pMemory = VirtualAlloc(NULL, bytes, allocType, PAGE_READWRITE);
+	return pMemory;
+#elif defined(AJA_BAREMETAL)
+	(void) bytes;  (void) alignment;  (void) pageSize;  (void) numaNode;
+	return NULL;
+#else
+	(void) numaNode;
+	int flags = MAP_PRIVATE | MAP_ANON;
+	size_t mapBytes = bytes;
+	if (pageSize != AJA_MEMORY_PAGES_DEFAULT)
+	{
+	#if defined(AJA_LINUX)
+		flags |= MAP_HUGETLB  |  ((pageSize == AJA_MEMORY_PAGES_1GB ? 30 : 21) << MAP_HUGE_SHIFT);
+	#else
+		return NULL;	// no MAP_HUGETLB
+	#endif
+	}
+	else if (alignment > AJAMemory::PageSizeBytes(AJA_MEMORY_PAGES_DEFAULT))
+		mapBytes += alignment;	// over-map, then trim to alignment
+	uint8_t* pMap = reinterpret_cast<uint8_t*>(mmap(NULL, mapBytes, PROT_READ | PROT_WRITE, flags, -1, 0));
+	if (pMap == reinterpret_cast<uint8_t*>(MAP_FAILED))
+		return NULL;
+	uint8_t* pMemory = reinterpret_cast<uint8_t*>((uintptr_t(pMap) + alignment - 1) & ~uintptr_t(alignment - 1));
+	if (pMemory > pMap)
+		munmap(pMap, size_t(pMemory - pMap));
+	if (pMemory + bytes < pMap + mapBytes)
+		munmap(pMemory + bytes, size_t(pMap + mapBytes - (pMemory + bytes)));
+	return pMemory;
+#endif
+}
+
+static void UnmapPrivatePages(void* pMemory, size_t bytes)
+{
+#if defined(AJA_WINDOWS)
+	(void) bytes;
+	VirtualFree(pMemory, 0, MEM_RELEASE);
+#elif defined(AJA_BAREMETAL)
+	(void) pMemory;  (void) bytes;
+#else
+	munmap(pMemory, bytes);
+#endif
+}
+
 AJAMemory::AJAMemory()
 {
 }
@@ -141,6 +360,86 @@ AJAMemory::AllocateAligned(size_t size, size_t alignment)
 }
 
 
+void* 
+AJAMemory::AllocateAligned(size_t size, size_t alignment, const AJAMemoryOptions& options, AJAMemoryInfo* pInfo)
+{
+	AJAMemoryInfo info;
+	if (options.IsDefault())
+	{
+		void* pMemory = AllocateAligned(size, alignment);
+		if (pMemory  &&  pInfo)
+		{
+			info.size = size;
+			info.pageSize = PageSizeBytes(AJA_MEMORY_PAGES_DEFAULT);
+			*pInfo = info;
+		}
+		return pMemory;
+	}
+
+	if (size == 0)
+	{
+		AJA_REPORT(0, AJA_DebugSeverity_Error, "AJAMemory::AllocateAligned	size is 0");
+		return NULL;
+	}
+	if (alignment == 0  ||  (alignment & (alignment - 1)))
+	{
+		AJA_REPORT(0, AJA_DebugSeverity_Error, "AJAMemory::AllocateAligned	alignment=%d is not a power of 2", (int)alignment);
+		return NULL;
+	}
+
+	void* pMemory = NULL;
+	bool numaBound = false;
+	if (options.pageSize != AJA_MEMORY_PAGES_DEFAULT  &&  alignment <= PageSizeBytes(options.pageSize))
+	{
+		info.pageSize = PageSizeBytes(options.pageSize);
+		info.size = RoundUp(size, info.pageSize);
+		pMemory = MapPrivatePages(info.size, alignment, options.pageSize, options.numaNode, numaBound);
+#if defined(AJA_WINDOWS)
+		info.locked = pMemory != NULL;	// large pages are always locked
+#endif
+	}
+	if (pMemory == NULL  &&  options.pageSize != AJA_MEMORY_PAGES_DEFAULT)
+	{
+		if (!options.allowFallback)
+		{
+			AJA_REPORT(0, AJA_DebugSeverity_Error, "AJAMemory::AllocateAligned	huge page allocation failed size=%d", (int)size);
+			return NULL;
+		}
+		AJA_REPORT(0, AJA_DebugSeverity_Warning, "AJAMemory::AllocateAligned	no huge pages available, using default pages");
+	}
+	if (pMemory == NULL)
+	{
+		info.pageSize = PageSizeBytes(AJA_MEMORY_PAGES_DEFAULT);
+		info.size = RoundUp(size, info.pageSize);
+		pMemory = MapPrivatePages(info.size, alignment, AJA_MEMORY_PAGES_DEFAULT, options.numaNode, numaBound);
+		if (pMemory == NULL)
+		{
+			AJA_REPORT(0, AJA_DebugSeverity_Error, "AJAMemory::AllocateAligned	allocation failed size=%d alignment=%d", (int)size, (int)alignment);
+			return NULL;
+		}
+#if defined(AJA_LINUX) && defined(MADV_HUGEPAGE)
+		if (options.pageSize != AJA_MEMORY_PAGES_DEFAULT)
+			madvise(pMemory, info.size, MADV_HUGEPAGE);	// transparent huge pages are better than nothing
+#endif
+	}
+	if (numaBound)
+		info.numaNode = options.numaNode;
+
+	if (!ApplyOptions(pMemory, options, true, info))
+	{
+		AJA_REPORT(0, AJA_DebugSeverity_Error, "AJAMemory::AllocateAligned	can't allocate on NUMA node %d", int(options.numaNode));
+		UnmapPrivatePages(pMemory, info.size);
+		return NULL;
+	}
+
+	AJAAutoLock lock(&sMappedLock);
+	sMappedMap[pMemory] = info;
+	if (pInfo)
+		*pInfo = info;
+	return pMemory;
+}
+
+
 void 
 AJAMemory::FreeAligned(void* pMemory)
 {
@@ -150,9 +449,16 @@ AJAMemory::FreeAligned(void* pMemory)
 		return;
 	}
 
-	if (pMemory == NULL)
 	{
-		return;
+		// allocated with options?
+		AJAAutoLock lock(&sMappedLock);
+		std::map<const void*, AJAMemoryInfo>::iterator it = sMappedMap.find(pMemory);
+		if (it != sMappedMap.end())
+		{
+			UnmapPrivatePages(pMemory, it->second.size);
+			sMappedMap.erase(it);
+			return;
+		}
 	}
 
 	// free aligned memory
@@ -167,6 +473,13 @@ AJAMemory::FreeAligned(void* pMemory)
 
 void* 
 AJAMemory::AllocateShared(size_t* pMemorySize, const char* pShareName, bool global)
+{
+	return AllocateShared(pMemorySize, pShareName, AJAMemoryOptions(), global, NULL);
+}
+
+
+void* 
+AJAMemory::AllocateShared(size_t* pMemorySize, const char* pShareName, const AJAMemoryOptions& options, bool global, AJAMemoryInfo* pInfo)
 {
 	AJAAutoLock lock(&sSharedLock);
 	
@@ -227,11 +540,26 @@ AJAMemory::AllocateShared(size_t* pMemorySize, const char* pShareName, bool glob
 
 			// update memory size and return address
 			*pMemorySize = shareIter->memorySize;
+			if (pInfo)
+				*pInfo = shareIter->info;
 			return shareIter->pMemory;
 		}
 	}
 
 	SharedData newData;
+	newData.info.pageSize = PageSizeBytes(AJA_MEMORY_PAGES_DEFAULT);
+#if !defined(AJA_LINUX)
+	if (options.pageSize != AJA_MEMORY_PAGES_DEFAULT)
+	{
+		// huge page shares need hugetlbfs
+		if (!options.allowFallback)
+		{
+			AJA_REPORT(0, AJA_DebugSeverity_Error, "AJAMemory::AllocateShared  huge page shares aren't supported on this platform");
+			return NULL;
+		}
+		AJA_REPORT(0, AJA_DebugSeverity_Warning, "AJAMemory::AllocateShared  huge page shares aren't supported on this platform, using default pages");
+	}
+#endif
 
 	// allocate new share
 #if defined(AJA_WINDOWS)
@@ -297,6 +625,29 @@ AJAMemory::AllocateShared(size_t* pMemorySize, const char* pShareName, bool glob
 #else	 
 	// Mac and Linux
 	{
+		newData.fileDescriptor = -1;
+#if defined(AJA_LINUX)
+		if (options.pageSize != AJA_MEMORY_PAGES_DEFAULT)
+		{
+			// huge page shares are files in a hugetlbfs mount with the requested page size
+			const std::string mountPoint = HugeTLBFSMountPoint(PageSizeBytes(options.pageSize));
+			if (!mountPoint.empty())
+				newData.fileDescriptor = open ((mountPoint + name).c_str(),  O_CREAT|O_RDWR,  S_IRUSR|S_IWUSR|S_IRGRP|S_IWGRP|S_IROTH|S_IWOTH);
+			if (newData.fileDescriptor >= 0)
+			{
+				newData.info.pageSize = PageSizeBytes(options.pageSize);
+				sizeInBytes = RoundUp(sizeInBytes, newData.info.pageSize);
+			}
+			else if (!options.allowFallback)
+			{
+				syslog(LOG_ERR, "AJAMemory::AllocateShared -- no usable hugetlbfs mount for '%s'", name.c_str());
+				return NULL;
+			}
+			else
+				AJA_REPORT(0, AJA_DebugSeverity_Warning, "AJAMemory::AllocateShared  no usable hugetlbfs mount, using default pages");
+		}
+		if (newData.fileDescriptor < 0)
+#endif
 		newData.fileDescriptor = shm_open (name.c_str(),  O_CREAT|O_RDWR,  S_IRUSR|S_IWUSR|S_IRGRP|S_IWGRP|S_IROTH|S_IWOTH);
 		if (newData.fileDescriptor < 0)
 		{
@@ -306,9 +657,14 @@ AJAMemory::AllocateShared(size_t* pMemorySize, const char* pShareName, bool glob
 
 		bool needsTruncate = false;
 #if defined(AJA_LINUX)
-		needsTruncate = true;
 		// on Linux shm_open() doesn't set S_IROTH|S_IWOTH, so use fchmod()
 		fchmod (newData.fileDescriptor,	 S_IRUSR|S_IWUSR|S_IRGRP|S_IWGRP|S_IROTH|S_IWOTH);
+		// Grow it if need be, but never shrink an existing share out from under the processes using it
+		struct stat mapstat;
+		if (fstat (newData.fileDescriptor, &mapstat) != -1  &&  size_t(mapstat.st_size) > sizeInBytes)
+			sizeInBytes = mapstat.st_size;
+		else
+			needsTruncate = true;
 #else
 		// need this on Mac, see:
 		// http://stackoverflow.com/questions/25502229/ftruncate-not-working-on-posix-shared-memory-in-mac-os-x#25510361
@@ -348,6 +704,20 @@ AJAMemory::AllocateShared(size_t* pMemorySize, const char* pShareName, bool glob
 	}
 #endif	// AJA_LINUX || AJA_MAC
 
+	newData.info.size = sizeInBytes;
+	if (!ApplyOptions(newData.pMemory, options, false, newData.info))
+	{
+		AJA_REPORT(0, AJA_DebugSeverity_Error, "AJAMemory::AllocateShared  can't allocate on NUMA node %d", int(options.numaNode));
+#if defined(AJA_WINDOWS)
+		UnmapViewOfFile(newData.pMemory);
+		CloseHandle(newData.fileMapHandle);
+#elif !defined(AJA_BAREMETAL)
+		munmap(newData.pMemory, sizeInBytes);
+		close(newData.fileDescriptor);
+#endif
+		return NULL;
+	}
+
 	// save details
 	newData.shareName = name;
 	newData.memorySize = sizeInBytes;
@@ -358,6 +728,8 @@ AJAMemory::AllocateShared(size_t* pMemorySize, const char* pShareName, bool glob
 
 	// update memory size and return address
 	*pMemorySize = sizeInBytes;
+	if (pInfo)
+		*pInfo = newData.info;
 	return newData.pMemory;
 }
 
@@ -398,3 +770,49 @@ AJAMemory::FreeShared(void* pMemory)
 
 	AJA_REPORT(0, AJA_DebugSeverity_Error, "AJAMemory::FreeShared  memory not found" /*, pMemory*/);
 }
+
+
+bool
+AJAMemory::GetInfo(const void* pMemory, AJAMemoryInfo& info)
+{
+	{
+		AJAAutoLock lock(&sMappedLock);
+		std::map<const void*, AJAMemoryInfo>::const_iterator it = sMappedMap.find(pMemory);
+		if (it != sMappedMap.end())
+		{
+			info = it->second;
+			return true;
+		}
+	}
+
+	AJAAutoLock lock(&sSharedLock);
+	for (std::list<SharedData>::const_iterator shareIter = sSharedList.begin();  shareIter != sSharedList.end();  ++shareIter)
+		if (pMemory == shareIter->pMemory)
+		{
+			info = shareIter->info;
+			return true;
+		}
+	return false;
+}
+
+
+size_t
+AJAMemory::PageSizeBytes(AJAMemoryPageSize pageSize)
+{
+	switch (pageSize)
+	{
+		case AJA_MEMORY_PAGES_2MB:	return size_t(2) * 1024 * 1024;
+		case AJA_MEMORY_PAGES_1GB:	return size_t(1024) * 1024 * 1024;
+		default:					break;
+	}
+#if defined(AJA_WINDOWS)
+	SYSTEM_INFO sysInfo;
+	GetSystemInfo(&sysInfo);
+	return sysInfo.dwPageSize;
+#elif defined(AJA_BAREMETAL)
+	return AJA_PAGE_SIZE;
+#else
+	const long pageBytes = sysconf(_SC_PAGESIZE);
+	return pageBytes > 0 ? size_t(pageBytes) : size_t(AJA_PAGE_SIZE);
+#endif
+}
@@ -10,6 +10,51 @@
 
 #include "ajabase/common/public.h"
 
+/**
+ *	Page sizes that AJAMemory allocations can be backed with.
+ */
+typedef enum
+{
+	AJA_MEMORY_PAGES_DEFAULT,	///< The system's default page size
+	AJA_MEMORY_PAGES_2MB,		///< 2 MB huge pages
+	AJA_MEMORY_PAGES_1GB		///< 1 GB huge pages
+} AJAMemoryPageSize;
+
+/**
+ *	Options for AJAMemory::AllocateAligned and AJAMemory::AllocateShared.
+ *
+ *	Huge pages cut TLB misses on large frame buffers, and make locking them for DMA cheaper (there are far fewer
+ *	pages to pin). On Linux, private allocations use MAP_HUGETLB, and shared allocations use a hugetlbfs mount
+ *	with the matching page size (e.g. "mount -t hugetlbfs -o pagesize=2M none /dev/hugepages"); huge pages must
+ *	have been reserved (e.g. via /proc/sys/vm/nr_hugepages). On Windows, private allocations use large pages,
+ *	which requires the "Lock pages in memory" privilege.
+ */
+struct AJA_EXPORT AJAMemoryOptions
+{
+	AJAMemoryPageSize	pageSize;		///< Page size to back the allocation with
+	bool				allowFallback;	///< If huge pages (or the NUMA node) are unavailable, fall back to default pages (or any node)?
+	bool				prefault;		///< Fault in every page up front, so first access doesn't pay for it?
+	bool				lock;			///< Lock the pages into physical memory (mlock/VirtualLock)?
+	int32_t				numaNode;		///< NUMA node to allocate from, or -1 for any
+
+	AJAMemoryOptions();
+	bool IsDefault() const;				///< @return	True if these options request nothing special.
+};
+
+/**
+ *	Reports how an AJAMemory allocation is actually backed.
+ */
+struct AJA_EXPORT AJAMemoryInfo
+{
+	size_t	size;			///< Bytes allocated (rounded up to a multiple of pageSize)
+	size_t	pageSize;		///< Size of the pages backing the allocation, in bytes
+	bool	prefaulted;		///< True if every page was faulted in up front
+	bool	locked;			///< True if the pages are locked into physical memory
+	int32_t	numaNode;		///< NUMA node the allocation is bound to, or -1 if none
+
+	AJAMemoryInfo();
+};
+
 /**
  *	Collection of system independent memory allocation functions.
  *	@ingroup AJAGroupSystem
@@ -45,6 +90,17 @@ public:
 	 */
 	static void* AllocateAligned(size_t size, size_t alignment);
 
+	/**
+	 *	Allocate memory aligned to alignment bytes, backed as specified by the given options.
+	 *
+	 *	@param[in]	size		Bytes of memory to allocate.
+	 *	@param[in]	alignment	Alignment of allocated memory in bytes.
+	 *	@param[in]	options		Page size, prefault, lock and NUMA node options.
+	 *	@param[out]	pInfo		If non-NULL, receives the page size etc. actually used.
+	 *	@return					Address of allocated memory (free it with FreeAligned()).  NULL if allocation fails.
+	 */
+	static void* AllocateAligned(size_t size, size_t alignment, const AJAMemoryOptions& options, AJAMemoryInfo* pInfo = NULL);
+
 	/**
 	 *	Free memory allocated using AllocateAligned().
 	 *
@@ -65,12 +121,45 @@ public:
 	 */
 	static void* AllocateShared(size_t* size, const char* pShareName, bool global = true);
 
+	/**
+	 *	Allocate a named system wide memory region, backed as specified by the given options.
+	 *
+	 *	If the named memory already exists that memory is returned and size is updated to reflect the preallocated
+	 *	size. Huge page shares live in a hugetlbfs mount (Linux-only), so processes sharing them must all request
+	 *	the same page size. If no suitable hugetlbfs mount exists, and options.allowFallback is true, a regular
+	 *	share is used instead.
+	 *
+	 *	@param[in,out]	size		Bytes of memory to allocate.
+	 *	@param[in]		pShareName	Name of system wide memory to allocate.
+	 *	@param[in]		options		Page size, prefault, lock and NUMA node options.
+	 *	@param[in]		global		If true, shared memory region will be accessible across user accounts (Windows-only).
+	 *	@param[out]		pInfo		If non-NULL, receives the page size etc. actually used.
+	 *	@return						Address of allocated memory.  NULL if allocation fails.
+	 */
+	static void* AllocateShared(size_t* size, const char* pShareName, const AJAMemoryOptions& options,
+								bool global = true, AJAMemoryInfo* pInfo = NULL);
+
 	/**
 	 *	Free memory allocated using AllocateShared().
 	 *
 	 *	@param[in]	pMemory		Address of memory to free.
 	 */
 	static void  FreeShared(void* pMemory);
+
+	/**
+	 *	Get the backing details of memory allocated using the AllocateAligned() or AllocateShared() that take options.
+	 *
+	 *	@param[in]	pMemory		Address returned by the allocation.
+	 *	@param[out]	info		Receives the page size etc.
+	 *	@return					True if successful; false if pMemory wasn't allocated with options.
+	 */
+	static bool  GetInfo(const void* pMemory, AJAMemoryInfo& info);
+
+	/**
+	 *	@param[in]	pageSize	The page size of interest.
+	 *	@return					The given page size in bytes (the system's page size for AJA_MEMORY_PAGES_DEFAULT).
+	 */
+	static size_t PageSizeBytes(AJAMemoryPageSize pageSize);
 };
 
 #endif	//	AJA_MEMORY_H
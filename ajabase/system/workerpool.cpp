@@ -0,0 +1,158 @@
+/* SPDX-License-Identifier: MIT */
+/**
+	@file		workerpool.cpp
+	@brief		Implements the AJAWorkerPool class.
+	@copyright	(C) 2023 AJA Video Systems, Inc.
+**/
+
+#include "ajabase/system/workerpool.h"
+#include "ajabase/system/atomic.h"
+#include "ajabase/system/debug.h"
+#include "ajabase/system/thread.h"
+#if defined(AJA_WINDOWS)
+	#include "ajabase/system/system.h"	//	for Windows API #includes
+#elif !defined(AJA_BAREMETAL)
+	#include <unistd.h>
+#endif
+
+
+AJAWorkerPool::AJAWorkerPool(uint32_t numThreads)
+	:	mDoneEvent		(false),
+		mpFunction		(NULL),
+		mpContext		(NULL),
+		mCount			(0),
+		mChunkSize		(0),
+		mNumChunks		(0),
+		mNextChunk		(0),
+		mBusyWorkers	(0),
+		mQuit			(false)
+{
+	if (numThreads == 0)
+		numThreads = GetNumCPUs() - 1;
+	for (uint32_t ndx = 0;  ndx < numThreads;  ndx++)
+	{
+		Worker* pWorker = new Worker;
+		pWorker->pThread = new AJAThread;
+		pWorker->pWakeEvent = new AJAEvent(false);
+		pWorker->pPool = this;
+		pWorker->pThread->Attach(WorkerThreadProc, pWorker);
+		if (AJA_FAILURE(pWorker->pThread->Start()))
+		{
+			AJA_REPORT(0, AJA_DebugSeverity_Warning, "AJAWorkerPool: started only %u of %u threads", ndx, numThreads);
+			delete pWorker->pThread;
+			delete pWorker->pWakeEvent;
+			delete pWorker;
+			break;
+		}
+		pWorker->pThread->SetThreadName("AJAWorkerPool");
+		mWorkers.push_back(pWorker);
+	}
+}
+
+
+AJAWorkerPool::~AJAWorkerPool()
+{
+	mQuit.Set();
+	for (size_t ndx = 0;  ndx < mWorkers.size();  ndx++)
+		mWorkers[ndx]->pWakeEvent->Signal();
+	for (size_t ndx = 0;  ndx < mWorkers.size();  ndx++)
+	{
+		mWorkers[ndx]->pThread->Stop();
+		delete mWorkers[ndx]->pThread;
+		delete mWorkers[ndx]->pWakeEvent;
+		delete mWorkers[ndx];
+	}
+	mWorkers.clear();
+}
+
+
+AJAStatus
+AJAWorkerPool::ParallelFor(uint32_t count, AJAWorkerPoolFunction* pFunction, void* pContext, uint32_t chunkSize)
+{
+	if (pFunction == NULL)
+		return AJA_STATUS_NULL;
+	if (count == 0)
+		return AJA_STATUS_SUCCESS;
+
+	const uint32_t numThreads = GetNumThreads() + 1;
+	if (chunkSize == 0)
+		chunkSize = (count + numThreads - 1) / numThreads;
+	const uint32_t numChunks = (count + chunkSize - 1) / chunkSize;
+	if (numChunks < 2  ||  mWorkers.empty())
+	{
+		pFunction(pContext, 0, count);	// not worth waking anyone
+		return AJA_STATUS_SUCCESS;
+	}
+
+	AJAAutoLock lock(&mJobLock);
+	mpFunction = pFunction;
+	mpContext = pContext;
+	mCount = count;
+	mChunkSize = chunkSize;
+	mNumChunks = numChunks;
+	AJAAtomic::Exchange(&mNextChunk, 0);
+
+	const uint32_t numHelpers = uint32_t(mWorkers.size()) < numChunks - 1  ?  uint32_t(mWorkers.size())  :  numChunks - 1;
+	AJAAtomic::Exchange(&mBusyWorkers, numHelpers);
+	for (uint32_t ndx = 0;  ndx < numHelpers;  ndx++)
+		mWorkers[ndx]->pWakeEvent->Signal();
+
+	RunChunks();
+	while (mBusyWorkers != 0)
+		mDoneEvent.WaitForSignal(100);
+	mpFunction = NULL;
+	return AJA_STATUS_SUCCESS;
+}
+
+
+void
+AJAWorkerPool::RunChunks()
+{
+	for (uint32_t chunk = AJAAtomic::Increment(&mNextChunk) - 1;  chunk < mNumChunks;  chunk = AJAAtomic::Increment(&mNextChunk) - 1)
+	{
+		const uint32_t begin = chunk * mChunkSize;
+		const uint32_t end = begin + mChunkSize < mCount  ?  begin + mChunkSize  :  mCount;
+		mpFunction(mpContext, begin, end);
+	}
+}
+
+
+void
+AJAWorkerPool::WorkerThreadProc(AJAThread* pThread, void* pContext)
+{
+	Worker* pWorker = reinterpret_cast<Worker*>(pContext);
+	AJAWorkerPool* pPool = pWorker->pPool;
+	while (!pThread->Terminate()  &&  !pPool->mQuit.IsSet())
+	{
+		if (pWorker->pWakeEvent->WaitForSignal(1000) != AJA_STATUS_SUCCESS)
+			continue;
+		if (pPool->mQuit.IsSet())
+			break;
+		pPool->RunChunks();
+		if (AJAAtomic::Decrement(&pPool->mBusyWorkers) == 0)
+			pPool->mDoneEvent.Signal();
+	}
+}
+
+
+AJAWorkerPool&
+AJAWorkerPool::GetSharedPool()
+{
+	static AJAWorkerPool sSharedPool;
+	return sSharedPool;
+}
+
+
+uint32_t
+AJAWorkerPool::GetNumCPUs()
+{
+	long numCPUs = 1;
+#if defined(AJA_WINDOWS)
+	SYSTEM_INFO sysInfo;
+	GetSystemInfo(&sysInfo);
+	numCPUs = long(sysInfo.dwNumberOfProcessors);
+#elif !defined(AJA_BAREMETAL)
+	numCPUs = sysconf(_SC_NPROCESSORS_ONLN);
+#endif
+	return numCPUs > 1 ? uint32_t(numCPUs) : 1;
+}
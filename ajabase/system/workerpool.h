@@ -0,0 +1,97 @@
+/* SPDX-License-Identifier: MIT */
+/**
+	@file		workerpool.h
+	@brief		Declares the AJAWorkerPool class.
+	@copyright	(C) 2023 AJA Video Systems, Inc.
+**/
+
+#ifndef AJA_WORKERPOOL_H
+#define AJA_WORKERPOOL_H
+
+#include "ajabase/common/public.h"
+#include "ajabase/system/atomic.h"
+#include "ajabase/system/event.h"
+#include "ajabase/system/lock.h"
+#include <vector>
+
+class AJAThread;
+
+
+/**
+ *	Template for a function that processes items [begin, end) of a parallel job.
+ *	@relates AJAWorkerPool
+ */
+typedef void AJAWorkerPoolFunction(void* pContext, uint32_t begin, uint32_t end);
+
+
+/**
+ *	A fixed set of worker threads that split data-parallel jobs (e.g. the lines of a frame) between them.
+ *	@ingroup AJAGroupSystem
+ *
+ *	The calling thread works on the job too, so a pool with N threads runs up to N+1 chunks at a time.
+ *	Jobs are run one at a time: concurrent ParallelFor() calls from different threads are serialized.
+ *	A pool's functions must not call ParallelFor() on the same pool.
+ */
+class AJA_EXPORT AJAWorkerPool
+{
+public:
+	/**
+	 *	@param[in]	numThreads	Number of worker threads. Zero (the default) means one less than the number of CPUs.
+	 */
+	explicit AJAWorkerPool(uint32_t numThreads = 0);
+	virtual ~AJAWorkerPool();
+
+	/**
+	 *	@return		The number of worker threads (not counting the calling thread).
+	 */
+	uint32_t GetNumThreads() const	{return uint32_t(mWorkers.size());}
+
+	/**
+	 *	Calls pFunction on consecutive chunks of the items [0, count), in parallel, and returns when they're all done.
+	 *
+	 *	@param[in]	count		Number of items.
+	 *	@param[in]	pFunction	Function to call for each chunk.
+	 *	@param[in]	pContext	Passed to pFunction.
+	 *	@param[in]	chunkSize	Number of items per chunk. Zero (the default) splits the items evenly between the threads.
+	 *	@return					AJA_STATUS_SUCCESS if successful.
+	 */
+	AJAStatus ParallelFor(uint32_t count, AJAWorkerPoolFunction* pFunction, void* pContext, uint32_t chunkSize = 0);
+
+	/**
+	 *	@return		A process-wide pool with the default number of threads, for callers that don't need their own.
+	 */
+	static AJAWorkerPool& GetSharedPool();
+
+	/**
+	 *	@return		The number of CPUs available to this process.
+	 */
+	static uint32_t GetNumCPUs();
+
+private:
+	AJAWorkerPool(const AJAWorkerPool&);				// not copyable
+	AJAWorkerPool& operator=(const AJAWorkerPool&);		// not assignable
+
+	static void	WorkerThreadProc(AJAThread* pThread, void* pContext);
+	void		RunChunks();
+
+	struct Worker
+	{
+		AJAThread*		pThread;
+		AJAEvent*		pWakeEvent;
+		AJAWorkerPool*	pPool;
+	};
+
+	std::vector<Worker*>	mWorkers;
+	AJALock					mJobLock;		// serializes ParallelFor calls
+	AJAEvent				mDoneEvent;		// signaled by the last worker to finish a job
+	AJAWorkerPoolFunction*	mpFunction;
+	void*					mpContext;
+	uint32_t				mCount;
+	uint32_t				mChunkSize;
+	uint32_t				mNumChunks;
+	uint32_t volatile		mNextChunk;
+	uint32_t volatile		mBusyWorkers;
+	AJAAtomicFlag			mQuit;
+};
+
+#endif	//	AJA_WORKERPOOL_H
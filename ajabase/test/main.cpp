@@ -23,13 +23,20 @@
 #include "ajabase/common/timebase.h"
 #include "ajabase/common/timecode.h"
 #include "ajabase/common/timer.h"
+#include "ajabase/common/videoutilities.h"
+#include "ajabase/common/wavereader.h"
+#include "ajabase/common/wavewriter.h"
 #include "ajabase/common/ajamovingavg.h"
 #include "ajabase/persistence/persistence.h"
+#include "ajabase/pnp/pnp.h"
 #include "ajabase/system/atomic.h"
 #include "ajabase/system/file_io.h"
 #include "ajabase/system/info.h"
+#include "ajabase/system/lock.h"
+#include "ajabase/system/memory.h"
 #include "ajabase/system/systemtime.h"
 #include "ajabase/system/thread.h"
+#include "ajabase/system/workerpool.h"
 
 #include <algorithm>
 #include <clocale>
@@ -1264,6 +1271,40 @@ TEST_SUITE("thread" * doctest::description("functions in ajabase/system/thread.h
 	}
 }
 
+void workerpool_marker() {}
+static void workerpool_square(void* pContext, uint32_t begin, uint32_t end)
+{
+	uint64_t* pValues = (uint64_t*)pContext;
+	for (uint32_t ndx = begin;  ndx < end;  ndx++)
+		pValues[ndx] = uint64_t(ndx) * ndx;
+}
+TEST_SUITE("workerpool" * doctest::description("functions in ajabase/system/workerpool.h")) {
+
+	TEST_CASE("ParallelFor")
+	{
+		AJAWorkerPool pool(4);
+		CHECK(pool.GetNumThreads() == 4);
+		CHECK(AJAWorkerPool::GetNumCPUs() >= 1);
+		std::vector<uint64_t> values(10007, 0);
+		const uint32_t chunkSizes[] = {0, 1, 7, 5000, 20000};
+		for (size_t sizeNdx = 0;  sizeNdx < sizeof(chunkSizes)/sizeof(chunkSizes[0]);  sizeNdx++)
+			for (int pass = 0;  pass < 20;  pass++)
+			{
+				std::fill(values.begin(), values.end(), 0);
+				CHECK(pool.ParallelFor(uint32_t(values.size()), workerpool_square, &values[0], chunkSizes[sizeNdx]) == AJA_STATUS_SUCCESS);
+				bool allOK = true;
+				for (size_t ndx = 0;  ndx < values.size();  ndx++)
+					if (values[ndx] != uint64_t(ndx) * ndx)
+						allOK = false;
+				CHECK(allOK);
+			}
+		CHECK(pool.ParallelFor(0, workerpool_square, &values[0]) == AJA_STATUS_SUCCESS);
+		CHECK(pool.ParallelFor(1, NULL, &values[0]) != AJA_STATUS_SUCCESS);
+		CHECK(AJAWorkerPool::GetSharedPool().ParallelFor(uint32_t(values.size()), workerpool_square, &values[0]) == AJA_STATUS_SUCCESS);
+	}
+
+} //workerpool
+
 void bytestream_marker() {}
 TEST_SUITE("bytestream" * doctest::description("functions in ajabase/common/bytestream.h")) {
 	TEST_CASE("Bytestream Constructor, Pos, Seek, Read/Write methods")
@@ -1908,6 +1949,86 @@ TEST_SUITE("atomic" * doctest::description("functions in ajabase/system/atomic.h
 
 } //atomic
 
+void memory_marker() {}
+TEST_SUITE("memory" * doctest::description("functions in ajabase/system/memory.h")) {
+
+	TEST_CASE("AllocateAligned with options")
+	{
+		AJAMemoryOptions options;
+		options.pageSize = AJA_MEMORY_PAGES_2MB;
+		options.prefault = true;
+		options.lock = true;
+		AJAMemoryInfo info;
+		const size_t size = 3 * 1024 * 1024 + 17;
+		uint8_t* pMemory = (uint8_t*)AJAMemory::AllocateAligned(size, 4096, options, &info);
+		REQUIRE(pMemory != NULL);
+		CHECK((uintptr_t(pMemory) % 4096) == 0);
+		// huge pages may not be available, in which case it falls back to default pages
+		CHECK((info.pageSize == AJAMemory::PageSizeBytes(AJA_MEMORY_PAGES_2MB)
+				|| info.pageSize == AJAMemory::PageSizeBytes(AJA_MEMORY_PAGES_DEFAULT)));
+		CHECK(info.size >= size);
+		CHECK((info.size % info.pageSize) == 0);
+		CHECK(info.prefaulted);
+		CHECK(info.numaNode == -1);
+		pMemory[0] = 1;
+		pMemory[size - 1] = 2;
+
+		AJAMemoryInfo info2;
+		CHECK(AJAMemory::GetInfo(pMemory, info2));
+		CHECK(info2.size == info.size);
+		CHECK(info2.pageSize == info.pageSize);
+		CHECK(info2.locked == info.locked);
+		AJAMemory::FreeAligned(pMemory);
+		CHECK_FALSE(AJAMemory::GetInfo(pMemory, info2));
+
+		// alignment larger than a page
+		options = AJAMemoryOptions();
+		options.prefault = true;
+		pMemory = (uint8_t*)AJAMemory::AllocateAligned(100000, 1024 * 1024, options, &info);
+		REQUIRE(pMemory != NULL);
+		CHECK((uintptr_t(pMemory) % (1024 * 1024)) == 0);
+		CHECK(info.pageSize == AJAMemory::PageSizeBytes(AJA_MEMORY_PAGES_DEFAULT));
+		CHECK(pMemory[99999] == 0);
+		AJAMemory::FreeAligned(pMemory);
+
+		// default options use the heap, as before
+		pMemory = (uint8_t*)AJAMemory::AllocateAligned(1000, 64, AJAMemoryOptions(), &info);
+		REQUIRE(pMemory != NULL);
+		CHECK(info.size == 1000);
+		CHECK_FALSE(AJAMemory::GetInfo(pMemory, info2));
+		AJAMemory::FreeAligned(pMemory);
+	}
+
+	TEST_CASE("AllocateShared with options")
+	{
+		AJAMemoryOptions options;
+		options.pageSize = AJA_MEMORY_PAGES_2MB;
+		options.prefault = true;
+		AJAMemoryInfo info;
+		size_t size = 100000;
+		uint8_t* pMemory = (uint8_t*)AJAMemory::AllocateShared(&size, "ut_ajabase_memory", options, false, &info);
+		REQUIRE(pMemory != NULL);
+		CHECK(size == info.size);
+		CHECK(size >= 100000);
+		CHECK((size % info.pageSize) == 0);
+		CHECK(info.prefaulted);
+		pMemory[0] = 0x5A;
+
+		// same share again
+		size_t size2 = 100000;
+		AJAMemoryInfo info2;
+		uint8_t* pMemory2 = (uint8_t*)AJAMemory::AllocateShared(&size2, "ut_ajabase_memory", options, false, &info2);
+		CHECK(pMemory2 == pMemory);
+		CHECK(size2 == size);
+		CHECK(info2.pageSize == info.pageSize);
+		CHECK(AJAMemory::GetInfo(pMemory, info2));
+		CHECK(info2.size == size);
+		AJAMemory::FreeShared(pMemory2);
+		AJAMemory::FreeShared(pMemory);
+	}
+
+} //memory
+
 void info_marker() {}
 TEST_SUITE("info" * doctest::description("functions in ajabase/system/info.h")) {
 
@@ -2198,3 +2319,495 @@ TEST_SUITE("file" * doctest::description("functions in ajabase/system/file_io.h"
 	}
 
 } //file
+
+void videoutilities_marker() {}
+static void videoutilities_random_ycbcr(std::vector<uint16_t>& ycbcr, uint32_t seed)
+{
+	for (size_t ndx = 0;  ndx < ycbcr.size();  ndx++)
+	{
+		seed = seed * 1664525 + 1013904223;
+		ycbcr[ndx] = uint16_t((seed >> 8) & 0x3FF);
+	}
+}
+// The historical per-pixel conversion loop
+static void videoutilities_reference_rgb10(const std::vector<uint16_t>& ycbcr, std::vector<AJA_RGBAlpha10BitPixel>& rgba, bool sd)
+{
+	for (size_t count = 0;  count < rgba.size();  count += 2)
+	{
+		const uint16_t* p = &ycbcr[count * 2];
+		const bool last = count + 2 >= rgba.size();
+		AJA_YCbCr10BitAlphaPixel pixel = {CCIR601_10BIT_WHITE, p[0], p[1], p[2]};
+		if (sd) AJA_SDConvert10BitYCbCrto10BitRGB(&pixel, &rgba[count]);  else AJA_HDConvert10BitYCbCrto10BitRGB(&pixel, &rgba[count]);
+		pixel.y = p[3];
+		pixel.cb = uint16_t((p[0] + (last ? p[0] : p[4])) / 2);
+		pixel.cr = uint16_t((p[2] + (last ? p[2] : p[6])) / 2);
+		if (sd) AJA_SDConvert10BitYCbCrto10BitRGB(&pixel, &rgba[count+1]);  else AJA_HDConvert10BitYCbCrto10BitRGB(&pixel, &rgba[count+1]);
+	}
+}
+static void videoutilities_reference_rgb8(const std::vector<uint16_t>& ycbcr, std::vector<AJA_RGBAlphaPixel>& rgba, bool sd)
+{
+	for (size_t count = 0;  count < rgba.size();  count += 2)
+	{
+		const uint16_t* p = &ycbcr[count * 2];
+		const bool last = count + 2 >= rgba.size();
+		AJA_YCbCr10BitAlphaPixel pixel = {CCIR601_10BIT_WHITE, p[0], p[1], p[2]};
+		if (sd) AJA_SDConvert10BitYCbCrtoRGB(&pixel, &rgba[count]);  else AJA_HDConvert10BitYCbCrtoRGB(&pixel, &rgba[count]);
+		pixel.y = p[3];
+		pixel.cb = uint16_t((p[0] + (last ? p[0] : p[4])) / 2);
+		pixel.cr = uint16_t((p[2] + (last ? p[2] : p[6])) / 2);
+		if (sd) AJA_SDConvert10BitYCbCrtoRGB(&pixel, &rgba[count+1]);  else AJA_HDConvert10BitYCbCrtoRGB(&pixel, &rgba[count+1]);
+	}
+}
+TEST_SUITE("videoutilities" * doctest::description("functions in ajabase/common/videoutilities.h")) {
+
+	TEST_CASE("YCbCr to RGB matches per-pixel conversion")
+	{
+		const uint32_t widths[] = {2, 6, 8, 10, 16, 18, 22, 1920};
+		for (size_t widthNdx = 0;  widthNdx < sizeof(widths)/sizeof(widths[0]);  widthNdx++)
+			for (int sd = 0;  sd < 2;  sd++)
+			{
+				const uint32_t width = widths[widthNdx];
+				std::vector<uint16_t> ycbcr(width * 2 + 8);
+				videoutilities_random_ycbcr(ycbcr, width + uint32_t(sd));
+				std::vector<AJA_RGBAlpha10BitPixel> rgb10(width), expected10(width);
+				videoutilities_reference_rgb10(ycbcr, expected10, sd != 0);
+				AJA_ConvertLineto10BitRGB(&ycbcr[0], &rgb10[0], width, sd != 0);
+				CHECK(memcmp(&rgb10[0], &expected10[0], width * sizeof(AJA_RGBAlpha10BitPixel)) == 0);
+
+				std::vector<AJA_RGBAlpha16BitPixel> rgb16(width);
+				AJA_ConvertLineto16BitRGB(&ycbcr[0], &rgb16[0], width, sd != 0);
+				bool allOK = true;
+				for (uint32_t ndx = 0;  ndx < width;  ndx++)
+					if (rgb16[ndx].Red != expected10[ndx].Red << 6  ||  rgb16[ndx].Green != expected10[ndx].Green << 6
+						||  rgb16[ndx].Blue != expected10[ndx].Blue << 6  ||  rgb16[ndx].Alpha != expected10[ndx].Alpha)
+							allOK = false;
+				CHECK(allOK);
+
+				std::vector<AJA_RGBAlphaPixel> rgb8(width), expected8(width);
+				videoutilities_reference_rgb8(ycbcr, expected8, sd != 0);
+				AJA_ConvertLinetoRGB(&ycbcr[0], &rgb8[0], width, sd != 0);
+				CHECK(memcmp(&rgb8[0], &expected8[0], width * sizeof(AJA_RGBAlphaPixel)) == 0);
+
+				// Matrix versions differ only in alpha
+				AJA_ConvertLinetoRGB(&ycbcr[0], &rgb8[0], width, sd ? AJA_ColorMatrix_Rec601 : AJA_ColorMatrix_Rec709);
+				CHECK(rgb8[width-1].Alpha == 255);
+				rgb8[width-1].Alpha = expected8[width-1].Alpha;
+				CHECK(memcmp(&rgb8[width-1], &expected8[width-1], sizeof(AJA_RGBAlphaPixel)) == 0);
+			}
+	}
+
+	TEST_CASE("RGB to YCbCr matches per-pixel conversion")
+	{
+		const int32_t widths[] = {1, 4, 7, 1920};
+		for (size_t widthNdx = 0;  widthNdx < sizeof(widths)/sizeof(widths[0]);  widthNdx++)
+			for (int sd = 0;  sd < 2;  sd++)
+			{
+				const int32_t width = widths[widthNdx];
+				std::vector<AJA_RGBAlphaPixel> rgb((size_t(width)));
+				uint32_t seed = uint32_t(width);
+				for (int32_t ndx = 0;  ndx < width;  ndx++)
+				{
+					seed = seed * 1664525 + 1013904223;
+					memcpy(&rgb[size_t(ndx)], &seed, sizeof(seed));
+				}
+				std::vector<uint16_t> ycbcr(size_t(width) * 2 + 2, 0), expected(size_t(width) * 2 + 2, 0);
+				for (int32_t ndx = 0;  ndx < width;  ndx++)
+				{
+					AJA_YCbCr10BitPixel pixel;
+					if (sd)	AJA_SDConvertRGBAlphatoYCbCr(&rgb[size_t(ndx)], &pixel);	else AJA_HDConvertRGBAlphatoYCbCr(&rgb[size_t(ndx)], &pixel);
+					expected[size_t(ndx) * 2 + 1] = pixel.y;
+					if (!(ndx & 1))
+						{expected[size_t(ndx) * 2] = pixel.cb;  expected[size_t(ndx) * 2 + 2] = pixel.cr;}
+				}
+				AJA_ConvertLineToYCbCr422(&rgb[0], &ycbcr[0], width, 0, sd != 0);
+				CHECK(ycbcr == expected);
+			}
+	}
+
+	TEST_CASE("Rec.2020")
+	{
+		// Black, white and grey
+		uint16_t ycbcr[] = {512, 64, 512, 940, 512, 502, 512, 502};
+		AJA_RGBAlpha10BitPixel rgb[4];
+		AJA_ConvertLineto10BitRGB(ycbcr, rgb, 4, AJA_ColorMatrix_Rec2020);
+		CHECK(rgb[0].Red == 0);		CHECK(rgb[0].Green == 0);		CHECK(rgb[0].Blue == 0);
+		CHECK(rgb[1].Red == 1023);	CHECK(rgb[1].Green == 1023);	CHECK(rgb[1].Blue == 1023);
+		CHECK(abs(rgb[2].Red - 512) <= 1);	CHECK(rgb[2].Green == rgb[2].Red);	CHECK(rgb[2].Blue == rgb[2].Red);
+		CHECK(rgb[3].Alpha == 1023);
+
+		// Saturated colors survive a round trip
+		AJA_RGBAlphaPixel colors[8], result[8];
+		for (int ndx = 0;  ndx < 8;  ndx++)
+		{
+			colors[ndx].Red = (ndx & 1) ? 255 : 0;
+			colors[ndx].Green = (ndx & 2) ? 255 : 0;
+			colors[ndx].Blue = (ndx & 4) ? 255 : 0;
+			colors[ndx].Alpha = 255;
+		}
+		for (int ndx = 0;  ndx < 8;  ndx++)
+		{
+			AJA_RGBAlphaPixel pair[2] = {colors[ndx], colors[ndx]};
+			uint16_t line[4];
+			AJA_ConvertLineToYCbCr422(pair, line, 2, 0, AJA_ColorMatrix_Rec2020);
+			AJA_ConvertLinetoRGB(line, &result[ndx], 1, AJA_ColorMatrix_Rec2020);
+			CHECK(abs(int(result[ndx].Red) - int(colors[ndx].Red)) <= 2);
+			CHECK(abs(int(result[ndx].Green) - int(colors[ndx].Green)) <= 2);
+			CHECK(abs(int(result[ndx].Blue) - int(colors[ndx].Blue)) <= 2);
+		}
+		// ...and differ from Rec.709
+		AJA_RGBAlphaPixel green709;
+		uint16_t greenLine[4];
+		AJA_ConvertLineToYCbCr422(&colors[2], greenLine, 1, 0, AJA_ColorMatrix_Rec2020);
+		AJA_ConvertLinetoRGB(greenLine, &green709, 1, AJA_ColorMatrix_Rec709);
+		CHECK(memcmp(&green709, &result[2], 3) != 0);
+	}
+
+	TEST_CASE("Frames")
+	{
+		const uint32_t width = 3840,  height = 2160,  v210RowBytes = (width + 47) / 48 * 128;
+		std::vector<uint32_t> v210(v210RowBytes / 4 * height);
+		uint32_t seed = 1;
+		for (size_t ndx = 0;  ndx < v210.size();  ndx++)
+		{
+			seed = seed * 1664525 + 1013904223;
+			v210[ndx] = seed & 0x3FFFFFFF;
+		}
+		std::vector<AJA_RGBAlphaPixel> rgba(width * height);
+		const uint64_t start = AJATime::GetSystemMicroseconds();
+		CHECK(AJA_Convert10BitYCbCrFrametoRGB(&v210[0], 0, &rgba[0], 0, width, height, AJA_ColorMatrix_Rec2020));
+		MESSAGE("4K v210 to RGBA: " << (AJATime::GetSystemMicroseconds() - start) << " us");
+
+		// Same as converting each line
+		std::vector<uint16_t> ycbcr(width * 2 + 6);
+		std::vector<AJA_RGBAlphaPixel> line(width);
+		bool allOK = true;
+		for (uint32_t lineNdx = 0;  lineNdx < height;  lineNdx += 97)
+		{
+			AJA_UnPack10BitYCbCrBuffer(&v210[lineNdx * v210RowBytes / 4], &ycbcr[0], width);
+			AJA_ConvertLinetoRGB(&ycbcr[0], &line[0], width, AJA_ColorMatrix_Rec2020);
+			if (memcmp(&line[0], &rgba[lineNdx * width], width * sizeof(AJA_RGBAlphaPixel)))
+				allOK = false;
+		}
+		CHECK(allOK);
+
+		std::vector<AJA_RGBAlpha16BitPixel> rgba16(width * height);
+		CHECK(AJA_Convert10BitYCbCrFrameto16BitRGB(&v210[0], 0, &rgba16[0], 0, width, height, AJA_ColorMatrix_Rec709));
+
+		// And back again
+		std::vector<uint32_t> v210Out(v210.size());
+		CHECK(AJA_ConvertRGBFrameto10BitYCbCr(&rgba[0], 0, &v210Out[0], 0, width, height, AJA_ColorMatrix_Rec2020));
+		AJA_UnPack10BitYCbCrBuffer(&v210Out[v210RowBytes / 4], &ycbcr[0], width);
+		std::vector<uint16_t> expected(width * 2 + 2);
+		AJA_ConvertLineToYCbCr422(&rgba[width], &expected[0], int32_t(width), 0, AJA_ColorMatrix_Rec2020);
+		CHECK(std::equal(expected.begin(), expected.begin() + width * 2, ycbcr.begin()));
+
+		CHECK_FALSE(AJA_Convert10BitYCbCrFrametoRGB(NULL, 0, &rgba[0], 0, width, height, AJA_ColorMatrix_Rec709));
+		CHECK_FALSE(AJA_Convert10BitYCbCrFrametoRGB(&v210[0], 0, &rgba[0], 0, width, height, AJA_ColorMatrix_Size));
+	}
+
+} //videoutilities
+
+TEST_SUITE("wave" * doctest::description("functions in ajabase/common/wave[reader|writer].h")) {
+
+	static std::string wave_temp_path(const std::string& name)
+	{
+		std::string tempDir;
+		if (AJAFileIO::TempDirectory(tempDir) != AJA_STATUS_SUCCESS)
+			tempDir = ".";
+		aja::rstrip(tempDir, std::string(1, AJA_PATHSEP));
+		return tempDir + AJA_PATHSEP + name;
+	}
+
+	static int32_t wave_sample(uint64_t frame, uint32_t channel)
+	{
+		return int32_t((frame * 64 + channel) * 2654435761U);
+	}
+
+	TEST_CASE("AJAWavWriter write-behind & AJAWavReader")
+	{
+		const std::string path = wave_temp_path("ajabase_ut_wave.wav");
+		const uint32_t numChannels = 16, numFrames = 48000, framesPerWrite = 1601;
+		AJAWavWriterAudioFormat audioFormat(numChannels, 48000, 32);
+		AJAWavWriterVideoFormat videoFormat;
+		videoFormat.rateScale = 25;
+		videoFormat.rateDuration = 1;
+		AJAWavWriter writer(path, audioFormat, videoFormat, "01:00:00:00",
+							AJAWavWriterChunkFlag(AJAWavWriterChunkFlagBextV1 | AJAWavWriterChunkFlagRF64 | AJAWavWriterChunkFlagExtensible));
+		CHECK(writer.setWriteBehind(numChannels * 4 * numFrames));
+		REQUIRE(writer.open());
+		CHECK_FALSE(writer.setWriteBehind(0));
+
+		std::vector<int32_t> samples(size_t(numFrames) * numChannels);
+		for (uint32_t frame = 0;  frame < numFrames;  frame++)
+			for (uint32_t chan = 0;  chan < numChannels;  chan++)
+				samples[frame * numChannels + chan] = wave_sample(frame, chan);
+		for (uint32_t frame = 0;  frame < numFrames;  frame += framesPerWrite)
+		{
+			const uint32_t frames = std::min(framesPerWrite, numFrames - frame);
+			CHECK_EQ(writer.write((const char*)&samples[frame * numChannels], frames * numChannels * 4), frames * numChannels * 4);
+		}
+		CHECK(writer.flush());
+		CHECK_EQ(writer.queuedBytes(), 0);
+		CHECK_EQ(writer.droppedBytes(), 0);
+		CHECK_EQ(writer.dataBytes(), uint64_t(numFrames) * numChannels * 4);
+		writer.close();
+
+		AJAWavReader reader;
+		REQUIRE(reader.open(path));
+		CHECK(reader.isMapped());
+		CHECK_FALSE(reader.isRF64());
+		CHECK_FALSE(reader.isFloat());
+		CHECK(reader.hasBext());
+		CHECK_EQ(reader.timeReference(), 3600 * 48000);
+		CHECK_EQ(reader.audioFormat().channelCount, int(numChannels));
+		CHECK_EQ(reader.audioFormat().sampleRate, 48000);
+		CHECK_EQ(reader.audioFormat().sampleSize, 32);
+		CHECK_EQ(reader.bytesPerFrame(), numChannels * 4);
+		CHECK_EQ(reader.frameCount(), numFrames);
+
+		std::vector<int32_t> readBack(samples.size());
+		CHECK_EQ(reader.read((char*)&readBack[0], 1000), 1000);
+		CHECK_EQ(reader.read((char*)&readBack[1000 * numChannels], numFrames), numFrames - 1000);
+		CHECK_EQ(reader.read((char*)&readBack[0], 1), 0);
+		CHECK(readBack == samples);
+
+		// Channel subset, in any order
+		std::vector<uint32_t> channels;
+		channels.push_back(13);  channels.push_back(2);  channels.push_back(7);
+		CHECK(reader.seek(24000));
+		std::vector<int32_t> subset(channels.size() * 500);
+		CHECK_EQ(reader.readChannels((char*)&subset[0], 500, channels), 500);
+		CHECK_EQ(reader.position(), 24500);
+		bool allOK = true;
+		for (uint32_t frame = 0;  frame < 500;  frame++)
+			for (size_t ndx = 0;  ndx < channels.size();  ndx++)
+				if (subset[frame * channels.size() + ndx] != wave_sample(24000 + frame, channels[ndx]))
+					allOK = false;
+		CHECK(allOK);
+		channels.push_back(numChannels);
+		CHECK_EQ(reader.readChannels((char*)&subset[0], 1, channels), 0);
+		CHECK_FALSE(reader.seek(numFrames + 1));
+		reader.close();
+		CHECK_FALSE(reader.isOpen());
+
+		// A full queue drops the samples instead of blocking
+		AJAWavWriter dropper(path, AJAWavWriterAudioFormat(2, 48000, 16));
+		CHECK(dropper.setWriteBehind(1024));
+		REQUIRE(dropper.open());
+		std::vector<char> bytes(2048);
+		CHECK_EQ(dropper.write(&bytes[0], 2048), 0);
+		CHECK_EQ(dropper.droppedBytes(), 2048);
+		dropper.close();
+		CHECK(reader.open(path));
+		CHECK_EQ(reader.frameCount(), 0);
+		reader.close();
+		remove(path.c_str());
+	}
+
+	TEST_CASE("AJAWavReader RF64 & 24-bit")
+	{
+		const std::string path = wave_temp_path("ajabase_ut_wave_rf64.wav");
+		const uint8_t header[] = {	'R','F','6','4', 0xFF,0xFF,0xFF,0xFF, 'W','A','V','E',
+									'd','s','6','4', 28,0,0,0,
+									52,0,0,0,0,0,0,0,	24,0,0,0,0,0,0,0,	4,0,0,0,0,0,0,0,	0,0,0,0,
+									'f','m','t',' ', 16,0,0,0,	1,0, 2,0, 0x80,0xBB,0,0, 0x00,0x65,0x04,0, 6,0, 24,0,
+									'd','a','t','a', 0xFF,0xFF,0xFF,0xFF};
+		std::vector<uint8_t> file(header, header + sizeof(header));
+		for (uint8_t byte = 0;  byte < 24 + 6;  byte++)		// 4 frames, plus a partial 5th beyond ds64's data size
+			file.push_back(byte);
+		AJAFileIO out;
+		REQUIRE(out.Open(path, eAJACreateAlways | eAJAWriteOnly, eAJABuffered) == AJA_STATUS_SUCCESS);
+		CHECK_EQ(out.Write(&file[0], uint32_t(file.size())), file.size());
+		out.Close();
+
+		AJAWavReader reader;
+		REQUIRE(reader.open(path));
+		CHECK(reader.isRF64());
+		CHECK_FALSE(reader.hasBext());
+		CHECK_EQ(reader.audioFormat().channelCount, 2);
+		CHECK_EQ(reader.audioFormat().sampleSize, 24);
+		CHECK_EQ(reader.frameCount(), 4);
+
+		std::vector<uint32_t> right(1, 1);
+		uint8_t samples[12];
+		CHECK_EQ(reader.readChannels((char*)samples, 8, right), 4);
+		for (uint8_t ndx = 0;  ndx < 12;  ndx++)
+			CHECK_EQ(samples[ndx], (ndx / 3) * 6 + 3 + ndx % 3);
+		reader.close();
+
+		// Not a WAV file
+		file[8] = 'X';
+		REQUIRE(out.Open(path, eAJACreateAlways | eAJAWriteOnly, eAJABuffered) == AJA_STATUS_SUCCESS);
+		out.Write(&file[0], uint32_t(file.size()));
+		out.Close();
+		CHECK_FALSE(reader.open(path));
+		remove(path.c_str());
+	}
+
+} //wave
+
+#if defined(AJA_LINUX)
+#include <dirent.h>
+
+TEST_SUITE("pnp" * doctest::description("functions in ajabase/pnp/pnp.h")) {
+
+	struct PnpCounts
+	{
+		AJALock		lock;
+		int			added;
+		int			removed;
+		PnpCounts() : added(0), removed(0)	{}
+		void get(int & outAdded, int & outRemoved)	{AJAAutoLock tmp(&lock);  outAdded = added;  outRemoved = removed;}
+	};
+
+	static void pnp_callback(AJAPnpMessage inMessage, void * inRefCon)
+	{
+		PnpCounts * pCounts = reinterpret_cast<PnpCounts*>(inRefCon);
+		AJAAutoLock tmp(&pCounts->lock);
+		if (inMessage == AJA_Pnp_DeviceAdded)
+			pCounts->added++;
+		else if (inMessage == AJA_Pnp_DeviceRemoved)
+			pCounts->removed++;
+	}
+
+	static void pnp_touch(const std::string & path)
+	{
+		FILE * pFile = fopen(path.c_str(), "w");
+		if (pFile)
+			fclose(pFile);
+	}
+
+	//	Waits up to a second for the counts to reach the given values
+	static bool pnp_wait(PnpCounts & counts, int added, int removed)
+	{
+		int a(0), r(0);
+		for (int ms(0);  ms < 1000;  ms += 5)
+		{
+			counts.get(a, r);
+			if (a == added  &&  r == removed)
+				return true;
+			AJATime::Sleep(5);
+		}
+		return false;
+	}
+
+	TEST_CASE("AJAPnp device node watch")
+	{
+		std::string tempDir;
+		if (AJAFileIO::TempDirectory(tempDir) != AJA_STATUS_SUCCESS)
+			tempDir = "/tmp/";
+		std::string dirTemplate = tempDir + (tempDir.empty() || tempDir[tempDir.size()-1] != '/' ? "/" : "") + "ajapnpXXXXXX";
+		std::vector<char> dirName(dirTemplate.begin(), dirTemplate.end());
+		dirName.push_back(0);
+		REQUIRE(mkdtemp(&dirName[0]) != NULL);
+		const std::string dir(&dirName[0]);
+		pnp_touch(dir + "/ajantv20");
+
+		PnpCounts counts;
+		AJAPnp pnp;
+		CHECK(pnp.SetDeviceDirectory(dir) == AJA_STATUS_SUCCESS);
+		CHECK(pnp.SetDeviceDirectory("") == AJA_STATUS_BAD_PARAM);
+		REQUIRE(pnp.Install(pnp_callback, &counts, AJA_Pnp_PciVideoDevices) == AJA_STATUS_SUCCESS);
+		CHECK(bool(pnp.GetCallback() == pnp_callback));
+		CHECK(pnp_wait(counts, 1, 0));		//	Already attached
+
+		//	A burst is reported once it settles, and other files are ignored
+		const uint64_t startMs(AJATime::GetSystemMilliseconds());
+		pnp_touch(dir + "/ajantv21");
+		pnp_touch(dir + "/ajantv22");
+		pnp_touch(dir + "/ttyS0");
+		CHECK(pnp_wait(counts, 3, 0));
+		MESSAGE("Burst of 2 device nodes reported in " << AJATime::GetSystemMilliseconds() - startMs << " ms");
+
+		CHECK(remove((dir + "/ajantv20").c_str()) == 0);
+		CHECK(pnp_wait(counts, 3, 1));
+
+		CHECK(pnp.Uninstall() == AJA_STATUS_SUCCESS);
+		CHECK(bool(pnp.GetCallback() == NULL));
+		pnp_touch(dir + "/ajantv23");
+		AJATime::Sleep(100);
+		int added(0), removed(0);
+		counts.get(added, removed);
+		CHECK(added == 3);	//	Nothing reported after Uninstall
+
+		remove((dir + "/ajantv21").c_str());
+		remove((dir + "/ajantv22").c_str());
+		remove((dir + "/ajantv23").c_str());
+		remove((dir + "/ttyS0").c_str());
+		rmdir(dir.c_str());
+	}
+
+	//	Re-installs itself (with pnp_callback) the first time it's called
+	struct PnpReinstaller
+	{
+		AJAPnp *	pPnp;
+		PnpCounts	counts;
+		int			numReinstalls;
+		PnpReinstaller(AJAPnp & inPnp) : pPnp(&inPnp), numReinstalls(0)	{}
+	};
+
+	static void pnp_reinstall_callback(AJAPnpMessage inMessage, void * inRefCon)
+	{
+		AJA_UNUSED(inMessage);
+		PnpReinstaller * pReinstaller = reinterpret_cast<PnpReinstaller*>(inRefCon);
+		pReinstaller->numReinstalls++;
+		pReinstaller->pPnp->Install(pnp_callback, &pReinstaller->counts, AJA_Pnp_PciVideoDevices);
+	}
+
+	//	Counts the entries in a directory (other than "." and "..")
+	static size_t pnp_count_entries(const std::string & path)
+	{
+		size_t result(0);
+		DIR * pDir(opendir(path.c_str()));
+		if (!pDir)
+			return 0;
+		for (struct dirent * pEntry(readdir(pDir));  pEntry;  pEntry = readdir(pDir))
+			if (pEntry->d_name[0] != '.')
+				result++;
+		closedir(pDir);
+		return result;
+	}
+
+	TEST_CASE("AJAPnp Install from callback")
+	{
+		std::string tempDir;
+		if (AJAFileIO::TempDirectory(tempDir) != AJA_STATUS_SUCCESS)
+			tempDir = "/tmp/";
+		std::string dirTemplate = tempDir + (tempDir.empty() || tempDir[tempDir.size()-1] != '/' ? "/" : "") + "ajapnpXXXXXX";
+		std::vector<char> dirName(dirTemplate.begin(), dirTemplate.end());
+		dirName.push_back(0);
+		REQUIRE(mkdtemp(&dirName[0]) != NULL);
+		const std::string dir(&dirName[0]);
+		pnp_touch(dir + "/ajantv20");
+		pnp_touch(dir + "/ajantv21");
+
+		const size_t numFDs(pnp_count_entries("/proc/self/fd")), numThreads(pnp_count_entries("/proc/self/task"));
+		{
+			AJAPnp pnp;
+			PnpReinstaller reinstaller(pnp);
+			CHECK(pnp.SetDeviceDirectory(dir) == AJA_STATUS_SUCCESS);
+			REQUIRE(pnp.Install(pnp_reinstall_callback, &reinstaller, AJA_Pnp_PciVideoDevices) == AJA_STATUS_SUCCESS);
+			CHECK(pnp_wait(reinstaller.counts, 2, 0));	//	The new callback sees both devices once
+			CHECK(reinstaller.numReinstalls == 1);		//	The old one stopped being called
+			CHECK(bool(pnp.GetCallback() == pnp_callback));
+			CHECK(pnp_count_entries("/proc/self/task") == numThreads + 1);	//	Still just one watcher thread
+
+			//	One watcher reports each change once
+			pnp_touch(dir + "/ajantv22");
+			CHECK(pnp_wait(reinstaller.counts, 3, 0));
+			AJATime::Sleep(100);
+			int added(0), removed(0);
+			reinstaller.counts.get(added, removed);
+			CHECK(added == 3);
+		}
+		CHECK(pnp_count_entries("/proc/self/fd") == numFDs);			//	No inotify or pipe fds leaked
+		CHECK(pnp_count_entries("/proc/self/task") == numThreads);
+
+		remove((dir + "/ajantv20").c_str());
+		remove((dir + "/ajantv21").c_str());
+		remove((dir + "/ajantv22").c_str());
+		rmdir(dir.c_str());
+	}
+
+} //pnp
+#endif	//	defined(AJA_LINUX)
@@ -0,0 +1,160 @@
+/* SPDX-License-Identifier: MIT */
+/**
+	@file		ntv2accessprofiler.h
+	@brief		Declares the NTV2AccessProfiler class, used by CNTV2DriverInterface to profile device I/O.
+	@copyright	(C) 2023 AJA Video Systems, Inc.
+**/
+
+#ifndef NTV2ACCESSPROFILER_H
+#define NTV2ACCESSPROFILER_H
+
+#include "ajaexport.h"
+#include "ajatypes.h"
+#include "ntv2publicinterface.h"
+#include "ajabase/system/lock.h"
+#include "ajabase/system/systemtime.h"
+#include <vector>
+#include <iostream>
+
+#if defined(_MSC_VER)
+	#include <intrin.h>
+	#pragma intrinsic(_ReturnAddress)
+	#define	NTV2_CALLER_ADDRESS		_ReturnAddress()
+#elif defined(__GNUC__) || defined(__clang__)
+	#define	NTV2_CALLER_ADDRESS		__builtin_return_address(0)
+#else
+	#define	NTV2_CALLER_ADDRESS		AJA_NULL
+#endif
+
+
+/**
+	@brief	Identifies the kind of device access being profiled.
+**/
+typedef enum
+{
+	NTV2AccessKind_ReadRegister,	///< @brief	ReadRegister (key is the register number)
+	NTV2AccessKind_WriteRegister,	///< @brief	WriteRegister (key is the register number)
+	NTV2AccessKind_DMATransfer,		///< @brief	DmaTransfer (key is the NTV2DMAEngine)
+	NTV2AccessKind_AutoCirculate,	///< @brief	AutoCirculate (key is the AUTO_CIRC_COMMAND)
+	NTV2AccessKind_Message,			///< @brief	NTV2Message (key is the message type, e.g. NTV2_TYPE_GETREGS)
+	NTV2AccessKind_Invalid
+} NTV2AccessKind;
+
+AJAExport std::string NTV2AccessKindToString (const NTV2AccessKind inKind);
+
+
+/**
+	@brief	Aggregated statistics for one register (or DMA engine, AutoCirculate command or message type),
+			or for one call site.
+**/
+typedef struct AJAExport NTV2AccessProfileEntry
+{
+	NTV2AccessKind	fKind;			///< @brief	Kind of access
+	ULWord			fKey;			///< @brief	Register number, DMA engine, AutoCirculate command or message type (per-register entries only)
+	const void *	fCaller;		///< @brief	Return address into the calling function (per-call-site entries only)
+	std::string		fCallerName;	///< @brief	Symbol name of the calling function, if available (per-call-site entries only)
+	ULWord64		fCalls;			///< @brief	Number of calls
+	ULWord64		fTotalMicrosecs;///< @brief	Total time spent in those calls, in microseconds
+	ULWord64		fMaxMicrosecs;	///< @brief	Longest single call, in microseconds
+
+	NTV2AccessProfileEntry ();
+	inline ULWord64	AverageMicrosecs (void) const	{return fCalls ? fTotalMicrosecs / fCalls : 0;}
+	std::string		KeyName (void) const;	///< @return	The register name (via CNTV2RegisterExpert), DMA engine, etc.
+	std::ostream &	Print (std::ostream & oss) const;
+} NTV2AccessProfileEntry;
+
+typedef std::vector<NTV2AccessProfileEntry>		NTV2AccessProfileEntries;
+typedef NTV2AccessProfileEntries::const_iterator	NTV2AccessProfileEntriesConstIter;
+
+inline std::ostream & operator << (std::ostream & oss, const NTV2AccessProfileEntry & inObj)	{return inObj.Print(oss);}
+
+
+/**
+	@brief	A snapshot of an NTV2AccessProfiler, with entries sorted by descending call count.
+**/
+typedef struct AJAExport NTV2AccessProfile
+{
+	NTV2AccessProfileEntries	fByKey;			///< @brief	Per register/engine/command/message entries
+	NTV2AccessProfileEntries	fByCaller;		///< @brief	Per call site entries
+	ULWord64					fDropped;		///< @brief	Number of accesses not tallied because a table was full
+	ULWord64					fMicrosecs;		///< @brief	Duration of profiling, in microseconds
+
+	NTV2AccessProfile () : fByKey(), fByCaller(), fDropped(0), fMicrosecs(0)	{}
+	ULWord64		TotalCalls (const NTV2AccessKind inKind = NTV2AccessKind_Invalid) const;	///< @return	Total calls of the given kind (or all kinds).
+	/**
+		@brief		Prints a human-readable report.
+		@param		oss				The output stream to print to.
+		@param[in]	inMaxEntries	Optionally limits the number of entries printed per table. Zero (the default) prints all.
+		@return		The output stream.
+	**/
+	std::ostream &	Print (std::ostream & oss, const size_t inMaxEntries = 0) const;
+} NTV2AccessProfile;
+
+inline std::ostream & operator << (std::ostream & oss, const NTV2AccessProfile & inObj)	{return inObj.Print(oss);}
+
+
+/**
+	@brief	Tallies call counts and latencies of device accesses, per register (or engine, command or message type)
+			and per call site. Tallying is lock-free and allocation-free:  each is a fixed-capacity open-addressed hash
+			table whose slots are claimed and updated with atomic operations. Reset zeroes the tallies but leaves each
+			slot's key claimed, so a Record that races a Reset still lands on its own key. Reset and GetProfile are
+			serialized by a lock that Record never takes. Accesses that don't fit are counted as dropped.
+	@note	This is normally used through CNTV2DriverInterface::StartAccessProfiling, etc.
+**/
+class AJAExport NTV2AccessProfiler
+{
+	public:
+		static const size_t	kNumSlots = 4096;	///< @brief	Capacity of each table (must be a power of 2)
+
+							NTV2AccessProfiler ();
+		virtual				~NTV2AccessProfiler ()		{}
+
+		/**
+			@brief		Tallies one access. Thread-safe.
+			@param[in]	inKind			The kind of access.
+			@param[in]	inKey			The register number, DMA engine, AutoCirculate command or message type.
+			@param[in]	pInCaller		The return address into the calling function (NTV2_CALLER_ADDRESS).
+			@param[in]	inMicrosecs		How long the access took, in microseconds.
+		**/
+		virtual void		Record (const NTV2AccessKind inKind, const ULWord inKey, const void * pInCaller, const ULWord64 inMicrosecs);
+		virtual void		Reset (void);	///< @brief	Zeroes all tallies. Thread-safe.
+		virtual void		GetProfile (NTV2AccessProfile & outProfile) const;	///< @brief	Answers with a sorted snapshot of my tallies.
+
+	private:
+		struct Slot
+		{
+			volatile uint64_t	fKey;		///< @brief	Zero if unused
+			volatile uint64_t	fCalls;
+			volatile uint64_t	fTotalUs;
+			volatile uint64_t	fMaxUs;
+		};
+		bool				Tally (Slot * pTable, const uint64_t inKey, const ULWord64 inMicrosecs);
+
+	private:
+		std::vector<Slot>	mByKey;
+		std::vector<Slot>	mByCaller;
+		volatile uint64_t	mDropped;
+		uint64_t			mStartUs;
+		mutable AJALock		mLock;		///< @brief	Serializes Reset & GetProfile (never taken by Record)
+};	//	NTV2AccessProfiler
+
+
+/**
+	@brief	Times the enclosing scope, and tallies it into an NTV2AccessProfiler (if one is given) upon destruction.
+**/
+class NTV2AccessProfileScope
+{
+	public:
+		inline NTV2AccessProfileScope (NTV2AccessProfiler * pInProfiler, const NTV2AccessKind inKind, const ULWord inKey, const void * pInCaller)
+			:	mpProfiler(pInProfiler), mKind(inKind), mKey(inKey), mpCaller(pInCaller), mStartUs(pInProfiler ? AJATime::GetSystemMicroseconds() : 0)	{}
+		inline ~NTV2AccessProfileScope ()
+			{if (mpProfiler) mpProfiler->Record(mKind, mKey, mpCaller, AJATime::GetSystemMicroseconds() - mStartUs);}
+	private:
+		NTV2AccessProfiler *	mpProfiler;
+		const NTV2AccessKind	mKind;
+		const ULWord			mKey;
+		const void *			mpCaller;
+		const uint64_t			mStartUs;
+};	//	NTV2AccessProfileScope
+
+#endif	//	NTV2ACCESSPROFILER_H
@@ -0,0 +1,256 @@
+/* SPDX-License-Identifier: MIT */
+/**
+	@file		ntv2audiosignal.h
+	@brief		Declares the CNTV2AudioSignalGenerator and CNTV2AudioMeter classes.
+	@copyright	(C) 2023 AJA Video Systems, Inc.
+**/
+
+#ifndef NTV2AUDIOSIGNAL_H
+#define NTV2AUDIOSIGNAL_H
+
+#include "ajaexport.h"
+#include "ntv2publicinterface.h"
+#include <string>
+#include <vector>
+
+
+/**
+	@brief	Test signals produced by CNTV2AudioSignalGenerator.
+**/
+typedef enum
+{
+	NTV2_AUDIO_SIGNAL_SILENCE,		///< @brief	All-zero samples
+	NTV2_AUDIO_SIGNAL_TONE,			///< @brief	Sine wave of constant frequency
+	NTV2_AUDIO_SIGNAL_SWEEP,		///< @brief	Sine wave whose frequency rises logarithmically, then starts over
+	NTV2_AUDIO_SIGNAL_WHITE_NOISE,	///< @brief	Uniformly-distributed white noise
+	NTV2_AUDIO_SIGNAL_PINK_NOISE,	///< @brief	Pink (-3 dB/octave) noise
+	NTV2_AUDIO_SIGNAL_INVALID
+} NTV2AudioSignal;
+
+#define	NTV2_IS_VALID_AUDIO_SIGNAL(__s__)	((__s__) >= NTV2_AUDIO_SIGNAL_SILENCE  &&  (__s__) < NTV2_AUDIO_SIGNAL_INVALID)
+
+AJAExport std::string NTV2AudioSignalToString (const NTV2AudioSignal inSignal, const bool inCompact = false);
+
+#define	NTV2_AUDIO_METER_MIN_DB		(-200.0)	///< @brief	Level or loudness reported for silence (or when not yet measured)
+
+
+/**
+	@brief	Generates test signals in the device's audio buffer format -- interleaved, 32-bit signed (full-scale) samples --
+			with an independent signal in each channel.
+			Tones and sweeps use a 32-bit phase accumulator per channel and a linearly-interpolated sine table (instead of
+			calling sin() per sample), so they're phase-continuous across calls, and spurs are more than 130 dB down.
+			Noise comes from a per-channel xorshift generator. Samples are converted, clipped, optionally byte-swapped and
+			stored four at a time with SSE2 where available.
+	@note	I'm not thread-safe. Use one CNTV2AudioSignalGenerator per thread.
+**/
+class AJAExport CNTV2AudioSignalGenerator
+{
+	public:
+		/**
+			@brief		Constructs me. All channels start out silent.
+			@param[in]	inNumChannels	Specifies the number of interleaved channels to generate (1 thru 128). Defaults to 16.
+			@param[in]	inSampleRate	Specifies the sample rate, in samples per second. Defaults to 48000.
+		**/
+		explicit			CNTV2AudioSignalGenerator (const ULWord inNumChannels = 16,  const double inSampleRate = 48000.0);
+		virtual				~CNTV2AudioSignalGenerator ();
+
+		/**
+			@brief		Changes one channel's signal, restarting it at zero phase.
+			@param[in]	inChannel		The zero-based channel.
+			@param[in]	inSignal		The signal.
+			@param[in]	inAmplitude		The peak amplitude, as a fraction of full scale (0.0 thru 1.0). Defaults to 0.5.
+			@param[in]	inFrequency		The tone frequency, or the sweep's start frequency, in Hertz. Defaults to 1 kHz.
+			@param[in]	inEndFrequency	The sweep's end frequency, in Hertz. Defaults to 20 kHz.
+			@param[in]	inSweepSeconds	The sweep's duration, in seconds. Defaults to 10 seconds.
+			@return		True if successful;  otherwise false.
+		**/
+		virtual bool		SetChannelSignal (const ULWord inChannel,  const NTV2AudioSignal inSignal,  const double inAmplitude = 0.5,
+											const double inFrequency = 1000.0,  const double inEndFrequency = 20000.0,
+											const double inSweepSeconds = 10.0);
+
+		/**
+			@brief		Changes every channel's signal, restarting them at zero phase (same parameters as SetChannelSignal).
+			@return		True if successful;  otherwise false.
+		**/
+		virtual bool		SetSignal (const NTV2AudioSignal inSignal,  const double inAmplitude = 0.5,  const double inFrequency = 1000.0,
+										const double inEndFrequency = 20000.0,  const double inSweepSeconds = 10.0);
+
+		/**
+			@brief		Generates the next samples of every channel.
+			@param		outBuffer		Receives the interleaved samples. Must be at least 4 x inNumSamples x GetNumChannels() bytes.
+			@param[in]	inNumSamples	The number of samples (per channel) to generate.
+			@param[in]	inByteSwap		If true, byte-swaps each sample. Defaults to false.
+			@return		True if successful;  otherwise false.
+		**/
+		virtual bool		Generate (NTV2Buffer & outBuffer,  const ULWord inNumSamples,  const bool inByteSwap = false);
+
+		virtual void		Reset (void);		///< @brief	Restarts every channel at zero phase (and reseeds the noise).
+
+		inline ULWord		GetNumChannels (void) const					{return ULWord(mChannels.size());}
+		inline double		GetSampleRate (void) const					{return mSampleRate;}
+
+		/**
+			@brief		Selects SSE2 or plain C++ for converting the generated float samples to rounded, clipped (and
+						optionally byte-swapped) 32-bit samples. SSE2 is the default in builds that have it. Only that
+						final conversion differs, and it rounds the same way on both paths.
+		**/
+		inline void			SetUseSIMD (const bool inUseSIMD)			{mUseSIMD = inUseSIMD && HasSIMD();}
+		inline bool			GetUseSIMD (void) const						{return mUseSIMD;}
+		static bool			HasSIMD (void);		///< @return	True if this build has a SIMD code path.
+
+	public:
+		/**
+			@brief	One channel's generator state.
+		**/
+		typedef struct ChannelState
+		{
+			NTV2AudioSignal	fSignal;		///< @brief	Signal type
+			float			fAmplitude;		///< @brief	Peak amplitude (fraction of full scale)
+			ULWord			fPhase;			///< @brief	Phase accumulator (2^32 == one cycle)
+			ULWord			fIncrement;		///< @brief	Tone phase increment per sample
+			double			fSweepInc;		///< @brief	Sweep's current phase increment per sample
+			double			fSweepStartInc;	///< @brief	Sweep's starting phase increment
+			double			fSweepRatio;	///< @brief	Sweep's per-sample increment multiplier
+			ULWord			fSweepLength;	///< @brief	Sweep's duration, in samples
+			ULWord			fSweepPos;		///< @brief	Current sample within the sweep
+			ULWord			fNoiseState;	///< @brief	xorshift32 state
+			float			fPink[3];		///< @brief	Pink noise filter state
+		} ChannelState;
+
+	private:
+		void				GenerateChannel (ChannelState & inOutState,  float * pOut,  const ULWord inStride,  const ULWord inNumSamples);
+		void				ResetChannel (const ULWord inChannel);
+							CNTV2AudioSignalGenerator (const CNTV2AudioSignalGenerator & inObj);				//	Not copyable
+		CNTV2AudioSignalGenerator &	operator = (const CNTV2AudioSignalGenerator & inRHS);					//	Not assignable
+
+	private:
+		double						mSampleRate;
+		bool						mUseSIMD;
+		std::vector<ChannelState>	mChannels;
+		std::vector<float>			mScratch;	///< @brief	Interleaved float samples, awaiting conversion
+};	//	CNTV2AudioSignalGenerator
+
+
+/**
+	@brief	Audio levels of one channel, in dBFS (NTV2_AUDIO_METER_MIN_DB if silent).
+**/
+typedef struct NTV2AudioChannelLevels
+{
+	double	fPeak;		///< @brief	Highest sample magnitude
+	double	fRMS;		///< @brief	Root-mean-square level (a full-scale sine wave reads -3.01 dBFS)
+	double	fTruePeak;	///< @brief	Highest magnitude of the 4x-oversampled signal (ITU-R BS.1770-4 Annex 2), in dBTP
+	NTV2AudioChannelLevels () : fPeak(NTV2_AUDIO_METER_MIN_DB), fRMS(NTV2_AUDIO_METER_MIN_DB), fTruePeak(NTV2_AUDIO_METER_MIN_DB)	{}
+} NTV2AudioChannelLevels;
+
+
+/**
+	@brief	Meters the device's interleaved 32-bit audio buffers on the host: per-channel peak, RMS and true-peak levels,
+			and the program's loudness per ITU-R BS.1770-4 / EBU R128 (momentary, short-term and gated integrated).
+			Channels are processed four at a time, each in its own SIMD lane, straight from the interleaved buffer --
+			K-weighting filters, the 48-tap true-peak interpolator and the level accumulators all run in single-precision
+			float, with SSE2 where available -- so metering 16 channels takes a small fraction of one core.
+			Levels accumulate until ResetLevels is called (e.g. once per video frame); loudness until ResetLoudness is called.
+	@note	I'm not thread-safe. Use one CNTV2AudioMeter per audio system.
+**/
+class AJAExport CNTV2AudioMeter
+{
+	public:
+		/**
+			@brief		Constructs me.
+			@param[in]	inNumChannels	Specifies the number of interleaved channels (1 thru 128). Defaults to 16.
+			@param[in]	inSampleRate	Specifies the sample rate, in samples per second. Defaults to 48000.
+		**/
+		explicit			CNTV2AudioMeter (const ULWord inNumChannels = 16,  const double inSampleRate = 48000.0);
+		virtual				~CNTV2AudioMeter ();
+
+		/**
+			@brief		Changes a channel's contribution to the program loudness (e.g. 1.41 for surround channels, per BS.1770).
+			@param[in]	inChannel		The zero-based channel.
+			@param[in]	inWeight		The weight. Zero excludes the channel. All channels default to 1.0.
+			@return		True if successful;  otherwise false.
+		**/
+		virtual bool		SetChannelWeight (const ULWord inChannel,  const double inWeight);
+
+		/**
+			@brief		Meters the given samples.
+			@param[in]	inBuffer		The interleaved 32-bit samples. Must be at least 4 x inNumSamples x GetNumChannels() bytes.
+			@param[in]	inNumSamples	The number of samples (per channel) to meter.
+			@param[in]	inByteSwap		If true, byte-swaps each sample first. Defaults to false.
+			@return		True if successful;  otherwise false.
+		**/
+		virtual bool		Process (const NTV2Buffer & inBuffer,  const ULWord inNumSamples,  const bool inByteSwap = false);
+
+		/**
+			@brief		Answers with a channel's levels since the last call to ResetLevels.
+			@param[in]	inChannel		The zero-based channel.
+			@param[out]	outLevels		Receives the channel's levels.
+			@return		True if successful;  otherwise false.
+		**/
+		virtual bool		GetChannelLevels (const ULWord inChannel,  NTV2AudioChannelLevels & outLevels) const;
+		virtual void		ResetLevels (void);		///< @brief	Restarts the peak, RMS and true-peak measurements.
+
+		virtual double		GetMomentaryLoudness (void) const;	///< @return	Loudness of the last 400 ms, in LUFS.
+		virtual double		GetShortTermLoudness (void) const;	///< @return	Loudness of the last 3 seconds, in LUFS.
+		/**
+			@return		The gated loudness since the last ResetLoudness, in LUFS. The relative gate is applied at 0.1 LU
+						resolution, so memory use doesn't grow with the program's length.
+		**/
+		virtual double		GetIntegratedLoudness (void) const;
+		virtual void		ResetLoudness (void);	///< @brief	Restarts the loudness measurements.
+
+		inline ULWord		GetNumChannels (void) const					{return mNumChannels;}
+		inline double		GetSampleRate (void) const					{return mSampleRate;}
+
+		/**
+			@brief		Selects whether each group of four channels is filtered and measured in SSE2 registers, or in
+						a plain loop over the same four lanes. SSE2 is the default in builds that have it. The loop does
+						the same single-precision operations in the same order, so the levels and loudness match exactly.
+		**/
+		inline void			SetUseSIMD (const bool inUseSIMD)			{mUseSIMD = inUseSIMD && HasSIMD();}
+		inline bool			GetUseSIMD (void) const						{return mUseSIMD;}
+		static bool			HasSIMD (void);		///< @return	True if this build has a SIMD code path.
+
+	public:
+		/**
+			@brief	Meter state of four channels (one per SIMD lane).
+		**/
+		typedef struct GroupState
+		{
+			float	fPeak[4];		///< @brief	Highest magnitude
+			float	fTruePeak[4];	///< @brief	Highest oversampled magnitude
+			float	fSquares[4];	///< @brief	Sum of squares (this chunk)
+			float	fKSquares[4];	///< @brief	Sum of squares of the K-weighted signal (this chunk)
+			float	fX[2][4];		///< @brief	K-weighting shelf input history
+			float	fS[2][4];		///< @brief	K-weighting shelf output history
+			float	fY[2][4];		///< @brief	K-weighting high-pass output history
+			float	fHist[24][4];	///< @brief	True-peak interpolator input history (twice over, so taps never wrap)
+			ULWord	fHistPos;		///< @brief	Where the newest input goes in fHist
+		} GroupState;
+
+	private:
+		void				CompleteSubBlock (void);
+		static double		EnergyToLUFS (const double inEnergy);
+							CNTV2AudioMeter (const CNTV2AudioMeter & inObj);				//	Not copyable
+		CNTV2AudioMeter &	operator = (const CNTV2AudioMeter & inRHS);					//	Not assignable
+
+	private:
+		ULWord					mNumChannels;
+		double					mSampleRate;
+		bool					mUseSIMD;
+		float					mShelfB[3];			///< @brief	K-weighting shelf numerator
+		float					mShelfA[2];			///< @brief	K-weighting shelf denominator (a1, a2)
+		float					mHighPassA[2];		///< @brief	K-weighting high-pass denominator (its numerator is 1, -2, 1)
+		std::vector<GroupState>	mGroups;
+		std::vector<double>		mWeights;			///< @brief	Per-channel loudness weights
+		std::vector<double>		mSquares;			///< @brief	Per-channel sum of squares since ResetLevels
+		uint64_t				mLevelSamples;		///< @brief	Samples metered since ResetLevels
+		std::vector<double>		mSubBlockSquares;	///< @brief	Per-channel sum of K-weighted squares in the current 100 ms sub-block
+		ULWord					mSubBlockLength;	///< @brief	Samples per 100 ms sub-block
+		ULWord					mSubBlockFill;		///< @brief	Samples in the current sub-block so far
+		std::vector<double>		mSubBlockEnergy;	///< @brief	Weighted mean-square energy of the last 30 sub-blocks (ring)
+		uint64_t				mNumSubBlocks;		///< @brief	Sub-blocks completed since ResetLoudness
+		std::vector<uint64_t>	mGateCounts;		///< @brief	400 ms blocks above the absolute gate, per 0.1 LU bin
+		std::vector<double>		mGateEnergy;		///< @brief	Sum of those blocks' energy, per 0.1 LU bin
+};	//	CNTV2AudioMeter
+
+#endif	//	NTV2AUDIOSIGNAL_H
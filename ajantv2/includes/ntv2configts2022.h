@@ -83,6 +83,7 @@ public:
 	// Setup individual TS encode parts
 	bool	SetupEncodeTsTimer(const NTV2Channel channel);
 	bool	SetupEncodeTsJ2KEncoder(const NTV2Channel channel);
+	bool	EnableEncodeTsJ2KEncoder(const NTV2Channel channel);
 	bool	SetupEncodeTsMpegJ2kEncap(const NTV2Channel channel);
 	bool	SetupEncodeTsMpegPcrEncap(const NTV2Channel channel);
 	bool	SetupEncodeTsMpegAesEncap(const NTV2Channel channel);
@@ -90,6 +91,8 @@ public:
 
 	// Routines to talk to the J2K part
 	bool				J2kCanAcceptCmd(const NTV2Channel channel);
+	bool				J2kWaitCanAcceptCmd(const NTV2Channel channel);
+	bool				J2kIsIdle(const NTV2Channel channel);
 	bool				J2KGetNextT0Status(const NTV2Channel channel, uint32_t *pStatus);
 	bool				GetT0CmdStatus( const NTV2Channel channel, const uint32_t cmdId, uint32_t *pStatus );
 	void				J2kSetParam(const NTV2Channel channel, uint32_t config, uint32_t param, uint32_t value);
@@ -110,6 +113,9 @@ public:
 
 	void				SetEncoderInputEnable(const NTV2Channel channel, bool bEnable, bool bMDEnable );
 	void				SetEncoderReset(const NTV2Channel channel, bool bReset );
+	bool				WaitForEncoderReset(const NTV2Channel channel, bool bReset );
+	bool				WaitForT2Stop(const NTV2Channel channel);
+	bool				WriteTransactionTable(const NTV2Channel channel, const uint32_t part);
 	int32_t				CalculateTsGen(const NTV2Channel channel);
 
 	bool				_is2022_6;
@@ -117,6 +123,7 @@ public:
 
 	int32_t				_transactionTable[1024][2];
 	int32_t				_transactionCount;
+	uint64_t			_tsFlushStartMs;	// when the TS J2K encoder last started flushing
 
 };	//	CNTV2ConfigTs2022
 
@@ -0,0 +1,96 @@
+/* SPDX-License-Identifier: MIT */
+/**
+	@file		ntv2deinterlacer.h
+	@brief		Declares the CNTV2Deinterlacer class.
+	@copyright	(C) 2023 AJA Video Systems, Inc.
+**/
+
+#ifndef NTV2DEINTERLACER_H
+#define NTV2DEINTERLACER_H
+
+#include "ajaexport.h"
+#include "ntv2publicinterface.h"
+#include "ntv2formatdescriptor.h"
+
+class AJAWorkerPool;
+
+
+/**
+	@brief	Deinterlacing methods supported by CNTV2Deinterlacer.
+**/
+typedef enum
+{
+	NTV2_DEINTERLACE_BOB,				///< @brief	Keeps one field, and interpolates the other field's lines from the lines above and below
+	NTV2_DEINTERLACE_BLEND,				///< @brief	Mixes both fields with a (1,2,1)/4 vertical filter (see VerticalFilterLine)
+	NTV2_DEINTERLACE_MOTION_ADAPTIVE,	///< @brief	Weaves both fields where the picture is still, interpolates (like bob) where it moved since the previous frame
+	NTV2_DEINTERLACE_INVALID
+} NTV2DeinterlaceMode;
+
+#define	NTV2_IS_VALID_DEINTERLACE_MODE(__m__)	((__m__) >= NTV2_DEINTERLACE_BOB  &&  (__m__) < NTV2_DEINTERLACE_INVALID)
+
+AJAExport std::string NTV2DeinterlaceModeToString (const NTV2DeinterlaceMode inMode, const bool inCompact = false);
+
+
+/**
+	@brief	Deinterlaces whole frames in place in their packed pixel format (no unpacking to RGBAlphaPixel lines),
+			splitting each frame's lines between the threads of an AJAWorkerPool, and using SSE2 where available.
+			Supports 8-bit YCbCr (2vuy and YUY2), 8-bit RGB/RGBA (all orders) and 10-bit YCbCr (v210) and RGB frames.
+			Line parity determines field membership: NTV2_FIELD0 is the even lines (0, 2, 4...), NTV2_FIELD1 the odd lines.
+	@note	One CNTV2Deinterlacer can serve any number of inputs (e.g. the thumbnails of a multiviewer), since the
+			previous frame (for motion-adaptive mode) is supplied by the caller. Concurrent Deinterlace calls that share a
+			worker pool take turns using it.
+**/
+class AJAExport CNTV2Deinterlacer
+{
+	public:
+		/**
+			@brief		Constructs me.
+			@param[in]	pInPool		Optionally specifies the worker pool to use. Defaults to AJAWorkerPool::GetSharedPool.
+		**/
+		explicit			CNTV2Deinterlacer (AJAWorkerPool * pInPool = AJA_NULL);
+		virtual				~CNTV2Deinterlacer ()	{}
+
+		/**
+			@brief		Deinterlaces a frame.
+			@param[in]	inFrame		The interlaced frame.
+			@param		outFrame	Receives the deinterlaced frame. Must be at least as large as the raster. Can be the same
+									buffer as inFrame, except in NTV2_DEINTERLACE_BLEND mode.
+			@param[in]	inDesc		Describes the raster (lines, line pitch and pixel format) of both frames.
+			@param[in]	inMode		Specifies the deinterlacing method. Defaults to NTV2_DEINTERLACE_BOB.
+			@param[in]	inKeepField	Specifies the field whose lines are kept intact (the other field's lines are rebuilt).
+									Defaults to NTV2_FIELD0 (even lines). Ignored in NTV2_DEINTERLACE_BLEND mode.
+			@param[in]	inPrevFrame	The previous interlaced frame from the same source. Required for NTV2_DEINTERLACE_MOTION_ADAPTIVE.
+			@return		True if successful;  otherwise false.
+		**/
+		virtual bool		Deinterlace (const NTV2Buffer & inFrame,  NTV2Buffer & outFrame,  const NTV2FormatDescriptor & inDesc,
+										const NTV2DeinterlaceMode inMode = NTV2_DEINTERLACE_BOB,
+										const NTV2FieldID inKeepField = NTV2_FIELD0,
+										const NTV2Buffer & inPrevFrame = NTV2Buffer());
+
+		/**
+			@brief		Sets the motion threshold for NTV2_DEINTERLACE_MOTION_ADAPTIVE mode. A 32-bit word of pixel data
+						is considered to have moved if any of its components changed by more than this amount.
+			@param[in]	inThreshold		The threshold, in 10-bit component units (it's scaled down for 8-bit formats).
+										Defaults to 32.
+		**/
+		inline void			SetMotionThreshold (const ULWord inThreshold)	{mMotionThreshold = inThreshold;}
+		inline ULWord		GetMotionThreshold (void) const					{return mMotionThreshold;}
+
+		/**
+			@brief		Selects whether line averaging and motion detection process 16 bytes per SSE2 instruction, or
+						one 32-bit word at a time. SSE2 is the default in builds that have it. The averages are computed
+						with the same bitwise arithmetic either way, so the output doesn't change.
+		**/
+		inline void			SetUseSIMD (const bool inUseSIMD)				{mUseSIMD = inUseSIMD && HasSIMD();}
+		inline bool			GetUseSIMD (void) const							{return mUseSIMD;}
+
+		static bool			CanDeinterlace (const NTV2PixelFormat inPixelFormat);	///< @return	True if the pixel format is supported.
+		static bool			HasSIMD (void);		///< @return	True if this build has a SIMD code path.
+
+	private:
+		AJAWorkerPool *		mpPool;
+		ULWord				mMotionThreshold;
+		bool				mUseSIMD;
+};	//	CNTV2Deinterlacer
+
+#endif	//	NTV2DEINTERLACER_H
@@ -230,13 +230,16 @@ AJAExport	std::ostream &	operator << (std::ostream & inOutStr, const NTV2AudioPh
 
 /**
 	@brief	This class is used to enumerate AJA devices that are attached and known to the local host computer.
+	@note	The enumeration is cached, and the lookup functions only rescan the host when the cached list is stale,
+			i.e. after InvalidateDeviceList, AddDeviceSpec or RemoveDeviceSpec is called. A lookup also rescans if
+			the device it finds fails to open, or if it finds no device and the list is more than a second old.
 **/
 class AJAExport CNTV2DeviceScanner
 {
 //	Class Methods
 public:
 	/**
-		@brief		Rescans the host, and returns an open CNTV2Card instance for the AJA device having the given zero-based index number.
+		@brief		Returns an open CNTV2Card instance for the AJA device having the given zero-based index number.
 		@return		True if successful; otherwise false.
 		@param[in]	inDeviceIndexNumber Specifies the AJA device using a zero-based index number.
 		@param[out] outDevice			Receives the open, ready-to-use CNTV2Card instance.
@@ -244,7 +247,7 @@ public:
 	static bool									GetDeviceAtIndex (const ULWord inDeviceIndexNumber, CNTV2Card & outDevice);
 
 	/**
-		@brief		Rescans the host, and returns an open CNTV2Card instance for the first AJA device found on the host that has the given NTV2DeviceID.
+		@brief		Returns an open CNTV2Card instance for the first AJA device found on the host that has the given NTV2DeviceID.
 		@return		True if successful; otherwise false.
 		@param[in]	inDeviceID			Specifies the device identifier of interest.
 		@param[out] outDevice			Receives the open, ready-to-use CNTV2Card instance.
@@ -252,7 +255,7 @@ public:
 	static bool									GetFirstDeviceWithID (const NTV2DeviceID inDeviceID, CNTV2Card & outDevice);
 
 	/**
-		@brief		Rescans the host, and returns an open CNTV2Card instance for the first AJA device whose device identifier name contains the given substring.
+		@brief		Returns an open CNTV2Card instance for the first AJA device whose device identifier name contains the given substring.
 		@note		The name is compared case-insensitively (e.g., "iO4K" == "Io4k").
 		@return		True if successful; otherwise false.
 		@param[in]	inNameSubString		Specifies a portion of the device name to search for.
@@ -261,7 +264,7 @@ public:
 	static bool									GetFirstDeviceWithName (const std::string & inNameSubString, CNTV2Card & outDevice);
 
 	/**
-		@brief		Rescans the host, and returns an open CNTV2Card instance for the first AJA device whose serial number contains the given value.
+		@brief		Returns an open CNTV2Card instance for the first AJA device whose serial number contains the given value.
 		@note		The serial value is compared case-sensitively.
 		@return		True if successful; otherwise false.
 		@param[in]	inSerialStr			Specifies the device serial value to search for.
@@ -270,7 +273,7 @@ public:
 	static bool									GetFirstDeviceWithSerial (const std::string & inSerialStr, CNTV2Card & outDevice);	//	New in SDK 16.0
 
 	/**
-		@brief		Rescans the host, and returns an open CNTV2Card instance for the first AJA device whose serial number matches the given value.
+		@brief		Returns an open CNTV2Card instance for the first AJA device whose serial number matches the given value.
 		@return		True if successful; otherwise false.
 		@param[in]	inSerialNumber		Specifies the device serial value to search for.
 		@param[out] outDevice			Receives the open, ready-to-use CNTV2Card instance.
@@ -278,7 +281,7 @@ public:
 	static bool									GetDeviceWithSerial (const uint64_t inSerialNumber, CNTV2Card & outDevice); //	New in SDK 16.0
 
 	/**
-		@brief		Rescans the host, and returns an open CNTV2Card instance for the AJA device that matches a command line argument
+		@brief		Returns an open CNTV2Card instance for the AJA device that matches a command line argument
 					according to the following evaluation sequence:
 					-#	1 or 2 digit unsigned decimal integer:	a zero-based device index number;
 					-#	8 or 9 character alphanumeric string:	device with a matching serial number string (case-insensitive comparison);
@@ -293,6 +296,37 @@ public:
 
 	static size_t		GetNumDevices (void);	///< @deprecated	Do not use
 
+	/**
+		@brief		Marks the cached device list as stale, so that the next lookup rescans the host.
+					Call this when devices may have been attached or detached (e.g. upon a hotplug notification).
+	**/
+	static void			InvalidateDeviceList (void);
+
+	/**
+		@return		A number that changes whenever a rescan finds a different list of devices.
+	**/
+	static ULWord		GetDeviceListGeneration (void);
+
+	/**
+		@brief		Adds a software or remote device to the enumeration. These follow the local devices, in the order
+					they were added, and are only listed while they can be opened.
+		@return		True if successful; false if the spec is empty or was already added.
+		@param[in]	inURLSpec			The device's URL specification (e.g. "ntv2swdevice://localhost/?nosharedmemory").
+	**/
+	static bool			AddDeviceSpec (const std::string & inURLSpec);
+
+	/**
+		@brief		Removes a software or remote device that was added by AddDeviceSpec.
+		@return		True if successful; false if the spec wasn't added.
+		@param[in]	inURLSpec			The device's URL specification.
+	**/
+	static bool			RemoveDeviceSpec (const std::string & inURLSpec);
+
+	/**
+		@return		The URL specifications added by AddDeviceSpec.
+	**/
+	static NTV2StringList	GetDeviceSpecs (void);
+
 	/**
 		@param[in]	inDevice			The CNTV2Card instance that's open for the device of interest.
 		@return		A string containing the device name that will find the same given device using CNTV2DeviceScanner::GetFirstDeviceFromArgument.
@@ -336,6 +370,7 @@ public:
 											NTV2DeviceInfoList & outDevicesAdded,
 											NTV2DeviceInfoList & outDevicesRemoved);
 private:
+	static void		FillDeviceInfo (NTV2DeviceInfo & outDeviceInfo, CNTV2Card & inDevice, const ULWord inDeviceIndex);
 	static void		SetAudioAttributes (NTV2DeviceInfo & inDeviceInfo, CNTV2Card & inDevice);
 #if defined(VIRTUAL_DEVICES_SUPPORT)
 	static bool		GetSerialToVirtualDeviceMap(NTV2SerialToVirtualDevices & outSerialToVirtualDevMap);
@@ -15,6 +15,8 @@
 #include "ntv2publicinterface.h"
 #include "ntv2utils.h"
 #include "ntv2devicefeatures.h"
+#include "ntv2accessprofiler.h"
+#include "ajabase/system/atomic.h"
 #if defined(NTV2_WRITEREG_PROFILING)	//	Register Write Profiling
 	#include "ajabase/system/lock.h"
 #endif	//	NTV2_WRITEREG_PROFILING		Register Write Profiling
@@ -618,6 +620,28 @@ class AJAExport CNTV2DriverInterface
 		///@}
 #endif	//	NTV2_WRITEREG_PROFILING		//	Register Write Profiling
 
+		/**
+			@name	Access Profiling
+		**/
+		///@{
+		/**
+			@brief		Starts (or resumes) tallying the number and latency of my ReadRegister, WriteRegister, DmaTransfer,
+						AutoCirculate and NTV2Message calls, per register (or DMA engine, command or message type), and per
+						call site. Tallying costs next to nothing when profiling is stopped.
+			@param[in]	inReset		If true (the default), clears any prior tallies.
+			@return		True if successful;  otherwise false.
+		**/
+		AJA_VIRTUAL bool	StartAccessProfiling (const bool inReset = true);
+		AJA_VIRTUAL bool	StopAccessProfiling (void);			///< @brief	Stops tallying device accesses. Tallies are retained until the next StartAccessProfiling.
+		AJA_VIRTUAL inline bool	IsAccessProfiling (void) const	{return mAccessProfiling.IsSet();}	///< @return	True if device accesses are being tallied.
+		/**
+			@brief		Answers with a snapshot of the device access tallies, sorted by descending call count.
+			@param[out]	outProfile	Receives the tallies.
+			@return		True if successful;  otherwise false (profiling never started).
+		**/
+		AJA_VIRTUAL bool	GetAccessProfile (NTV2AccessProfile & outProfile) const;
+		///@}
+
 
 	//	PROTECTED METHODS
 	protected:
@@ -660,6 +684,7 @@ class AJAExport CNTV2DriverInterface
 		**/
 		AJA_VIRTUAL void	FinishOpen (void);
 		AJA_VIRTUAL bool	ReadFlashULWord (const ULWord inAddress, ULWord & outValue, const ULWord inRetryCount = 1000);
+		inline NTV2AccessProfiler *	AccessProfiler (void) const	{return mAccessProfiling.IsSet() ? mpAccessProfiler : AJA_NULL;}	///< @return	My profiler, if profiling;  otherwise NULL.
 
 
 	//	PRIVATE TYPES
@@ -681,6 +706,9 @@ class AJAExport CNTV2DriverInterface
 		NTV2RPCAPI *		_pRPCAPI;				///< @brief	Points to remote or software device interface; otherwise NULL for local physical device.
 		_EventHandles		mInterruptEventHandles;	///< @brief	For subscribing to each possible event, one for each interrupt type
 		_EventCounts		mEventCounts;			///< @brief	My event tallies, one for each interrupt type. Note that these
+		NTV2AccessProfiler *	mpAccessProfiler;	///< @brief	Device access tallies (created by first StartAccessProfiling)
+		AJAAtomicFlag		mAccessProfiling;		///< @brief	Set while tallying device accesses (tested by other threads)
+		mutable AJALock		mAccessProfilerLock;	///< @brief	Guards creation of mpAccessProfiler
 #if defined(NTV2_WRITEREG_PROFILING)
 		NTV2RegisterWrites	mRegWrites;				///< @brief	Stores WriteRegister data
 		mutable AJALock		mRegWritesLock;			///< @brief	Guard mutex for mRegWrites
@@ -699,4 +727,10 @@ class AJAExport CNTV2DriverInterface
 
 };	//	CNTV2DriverInterface
 
+/**
+	@brief	Tallies the enclosing device access function into the CNTV2DriverInterface's access profiler, if profiling.
+			Use it at the top of ReadRegister, WriteRegister, DmaTransfer, AutoCirculate and NTV2Message implementations.
+**/
+#define	NTV2_PROFILE_ACCESS(_kind_,_key_)	NTV2AccessProfileScope	__accessProfileScope__ (AccessProfiler(), _kind_, ULWord(_key_), NTV2_CALLER_ADDRESS)
+
 #endif	//	NTV2DRIVERINTERFACE_H
@@ -0,0 +1,213 @@
+/* SPDX-License-Identifier: MIT */
+/**
+	@file		ntv2frameshare.h
+	@brief		Declares the CNTV2FramePublisher and CNTV2FrameSubscriber classes.
+	@copyright	(C) 2023 AJA Video Systems, Inc.
+**/
+
+#ifndef NTV2FRAMESHARE_H
+#define NTV2FRAMESHARE_H
+
+#include "ajaexport.h"
+#include "ntv2publicinterface.h"
+#include <string>
+#include <vector>
+
+
+/**
+	@brief	Describes the capacity of a shared frame ring.
+**/
+typedef struct AJAExport NTV2FrameRingConfig
+{
+	ULWord	fNumSlots;		///< @brief	Number of frames the ring holds (at least 2). Readers can lag by up to fNumSlots-1 frames without dropping.
+	ULWord	fMaxReaders;	///< @brief	Maximum number of simultaneous CNTV2FrameSubscribers
+	ULWord	fVideoBytes;	///< @brief	Video capacity per frame, in bytes
+	ULWord	fAudioBytes;	///< @brief	Audio capacity per frame, in bytes (zero if none)
+	ULWord	fAncBytes;		///< @brief	Field 1 (or progressive) anc capacity per frame, in bytes (zero if none)
+	ULWord	fAncF2Bytes;	///< @brief	Field 2 anc capacity per frame, in bytes (zero if none)
+
+	explicit	NTV2FrameRingConfig (const ULWord inVideoBytes = 0,  const ULWord inAudioBytes = 0,
+									const ULWord inAncBytes = 0,  const ULWord inAncF2Bytes = 0,
+									const ULWord inNumSlots = 8,  const ULWord inMaxReaders = 16);
+	bool		IsValid (void) const;
+} NTV2FrameRingConfig;
+
+
+/**
+	@brief	Zero-copy view of one frame in a shared frame ring, as returned by CNTV2FrameSubscriber::NextFrame.
+			The pointers reference the shared ring itself, so they're only good until the publisher laps the
+			reader. Call CNTV2FrameSubscriber::IsFrameValid after using the data to confirm it wasn't overwritten.
+**/
+typedef struct AJAExport NTV2SharedFrame
+{
+	ULWord64			fSequence;		///< @brief	Publication sequence number (the first frame ever published is zero)
+	const UByte *		fVideo;			///< @brief	Video data
+	ULWord				fVideoBytes;	///< @brief	Video data size, in bytes
+	const UByte *		fAudio;			///< @brief	Audio data (NULL if none)
+	ULWord				fAudioBytes;	///< @brief	Audio data size, in bytes
+	const UByte *		fAnc;			///< @brief	Field 1 (or progressive) anc data (NULL if none)
+	ULWord				fAncBytes;		///< @brief	Field 1 anc data size, in bytes
+	const UByte *		fAncF2;			///< @brief	Field 2 anc data (NULL if none)
+	ULWord				fAncF2Bytes;	///< @brief	Field 2 anc data size, in bytes
+	const void *		fpSlot;			///< @brief	Used internally
+
+	NTV2SharedFrame ();
+} NTV2SharedFrame;
+
+
+/**
+	@brief	Statistics about one reader of a shared frame ring.
+**/
+typedef struct AJAExport NTV2FrameRingReaderStats
+{
+	ULWord		fReaderIndex;		///< @brief	The reader's slot in the ring's reader table
+	ULWord64	fProcessID;			///< @brief	The reader's process ID
+	ULWord64	fFramesRead;		///< @brief	Frames read so far
+	ULWord64	fFramesDropped;		///< @brief	Frames skipped because the reader fell behind by more than NTV2FrameRingConfig::fNumSlots-1 frames
+	ULWord64	fLag;				///< @brief	Frames published but not yet read
+
+	NTV2FrameRingReaderStats () : fReaderIndex(0), fProcessID(0), fFramesRead(0), fFramesDropped(0), fLag(0)	{}
+	std::ostream &	Print (std::ostream & oss) const;
+} NTV2FrameRingReaderStats;
+
+typedef std::vector<NTV2FrameRingReaderStats>	NTV2FrameRingReaderStatsList;
+
+inline std::ostream & operator << (std::ostream & oss, const NTV2FrameRingReaderStats & inObj)	{return inObj.Print(oss);}
+
+
+/**
+	@brief	Publishes captured frames (video, audio, anc and FRAME_STAMP) into a named host shared-memory ring
+			(see AJAMemory::AllocateShared), so that any number of CNTV2FrameSubscribers in other processes can
+			share one AutoCirculate capture. Publishing never blocks: readers that fall too far behind skip frames.
+			To avoid any copying, call AcquireSlot to point an AUTOCIRCULATE_TRANSFER's buffers directly into the
+			ring, then CNTV2Card::AutoCirculateTransfer, then PublishSlot.
+	@note	There can only be one publisher per ring, and I'm not thread-safe.
+**/
+class AJAExport CNTV2FramePublisher
+{
+	public:
+							CNTV2FramePublisher ();
+		virtual				~CNTV2FramePublisher ();	///< @brief	My destructor. Automatically calls Close.
+
+		/**
+			@brief		Creates (or re-attaches to) the named ring. If it already exists with the same configuration,
+						attached subscribers keep their place, and sequence numbering continues where it left off.
+			@param[in]	inRingName	The ring's system-wide name.
+			@param[in]	inConfig	The ring's capacity.
+			@return		True if successful;  otherwise false (e.g. another live process is publishing to it).
+		**/
+		virtual bool		Create (const std::string & inRingName, const NTV2FrameRingConfig & inConfig);
+		virtual void		Close (void);	///< @brief	Detaches from the ring.
+		inline bool			IsOpen (void) const				{return mpRing != AJA_NULL;}
+		inline const NTV2FrameRingConfig &	GetConfig (void) const	{return mConfig;}
+
+		/**
+			@brief		Points the given AUTOCIRCULATE_TRANSFER's video, audio and anc buffers at the next slot in
+						the ring, so that a subsequent CNTV2Card::AutoCirculateTransfer DMAs straight into shared memory.
+			@param		inOutXfer	The transfer object to modify.
+			@return		True if successful;  otherwise false.
+		**/
+		virtual bool		AcquireSlot (AUTOCIRCULATE_TRANSFER & inOutXfer);
+
+		/**
+			@brief		Publishes the slot obtained from the last AcquireSlot call, after the transfer has completed.
+						Audio and anc sizes and the FRAME_STAMP are taken from the transfer's status.
+			@param[in]	inXfer		The transfer object that was passed to AcquireSlot and AutoCirculateTransfer.
+			@return		True if successful;  otherwise false.
+		**/
+		virtual bool		PublishSlot (const AUTOCIRCULATE_TRANSFER & inXfer);
+
+		/**
+			@brief		Copies a completed transfer's video, audio, anc and FRAME_STAMP into the next slot and publishes it.
+			@param[in]	inXfer		A completed capture AUTOCIRCULATE_TRANSFER that uses its own buffers.
+			@return		True if successful;  otherwise false.
+		**/
+		virtual bool		Publish (const AUTOCIRCULATE_TRANSFER & inXfer);
+
+		/**
+			@brief		Copies the given data into the next slot and publishes it. Data that exceeds the ring's
+						capacity is truncated. Empty buffers publish no data of that kind.
+			@return		True if successful;  otherwise false.
+		**/
+		virtual bool		Publish (const NTV2Buffer & inVideo, const NTV2Buffer & inAudio, const NTV2Buffer & inAnc,
+									const NTV2Buffer & inAncF2, const FRAME_STAMP & inFrameStamp);
+
+		virtual ULWord64	GetPublishedCount (void) const;	///< @return	The total number of frames published to the ring.
+
+		/**
+			@brief		Answers with statistics for each attached subscriber.
+			@param[out]	outStats	Receives the statistics.
+			@return		True if successful;  otherwise false.
+		**/
+		virtual bool		GetReaderStats (NTV2FrameRingReaderStatsList & outStats) const;
+
+	private:
+		bool				Commit (const NTV2Buffer & inAudio, const NTV2Buffer & inAnc, const NTV2Buffer & inAncF2,
+									const ULWord inVideoBytes, const FRAME_STAMP & inFrameStamp);
+							CNTV2FramePublisher (const CNTV2FramePublisher & inObj);	//	Not copyable
+		CNTV2FramePublisher &	operator = (const CNTV2FramePublisher & inRHS);		//	Not assignable
+
+	private:
+		UByte *				mpRing;			///< @brief	Shared ring memory
+		NTV2FrameRingConfig	mConfig;		///< @brief	Ring capacity
+		bool				mSlotAcquired;	///< @brief	True between AcquireSlot and PublishSlot
+};	//	CNTV2FramePublisher
+
+
+/**
+	@brief	Reads frames from a named shared frame ring written by a CNTV2FramePublisher (usually in another process).
+			Each subscriber has its own lock-free cursor in the ring, so subscribers don't affect each other or the
+			publisher. Frames are accessed in place, without copying.
+	@note	I'm not thread-safe.
+**/
+class AJAExport CNTV2FrameSubscriber
+{
+	public:
+							CNTV2FrameSubscriber ();
+		virtual				~CNTV2FrameSubscriber ();	///< @brief	My destructor. Automatically calls Close.
+
+		/**
+			@brief		Attaches to the named ring, and positions me at its newest frame.
+			@param[in]	inRingName	The ring's system-wide name.
+			@return		True if successful;  otherwise false (e.g. no such ring, or all reader slots are taken).
+		**/
+		virtual bool		Open (const std::string & inRingName);
+		virtual void		Close (void);	///< @brief	Detaches from the ring, releasing my reader slot.
+		inline bool			IsOpen (void) const				{return mpRing != AJA_NULL;}
+		virtual bool		GetConfig (NTV2FrameRingConfig & outConfig) const;	///< @brief	Answers with the ring's capacity.
+
+		/**
+			@brief		Answers with the next unread frame. If I've fallen behind by more than NTV2FrameRingConfig::fNumSlots-1
+						frames, I skip ahead to the oldest frame still in the ring, and count the skipped frames as dropped.
+			@param[out]	outFrame		Receives a view of the frame.
+			@param[in]	inTimeoutMs		How long to wait for a new frame, in milliseconds. Defaults to zero (don't wait).
+			@return		True if successful;  false if no new frame became available in time.
+		**/
+		virtual bool		NextFrame (NTV2SharedFrame & outFrame, const ULWord inTimeoutMs = 0);
+
+		/**
+			@return		True if the frame's data hasn't (yet) been overwritten by the publisher;  otherwise false.
+			@param[in]	inFrame		A frame obtained from NextFrame.
+		**/
+		virtual bool		IsFrameValid (const NTV2SharedFrame & inFrame) const;
+
+		/**
+			@brief		Answers with the given frame's FRAME_STAMP, including its timecodes.
+			@param[in]	inFrame			A frame obtained from NextFrame.
+			@param[out]	outFrameStamp	Receives the FRAME_STAMP.
+			@return		True if successful;  otherwise false.
+		**/
+		virtual bool		GetFrameStamp (const NTV2SharedFrame & inFrame, FRAME_STAMP & outFrameStamp) const;
+
+		virtual bool		GetStats (NTV2FrameRingReaderStats & outStats) const;	///< @brief	Answers with my statistics.
+
+	private:
+							CNTV2FrameSubscriber (const CNTV2FrameSubscriber & inObj);	//	Not copyable
+		CNTV2FrameSubscriber &	operator = (const CNTV2FrameSubscriber & inRHS);		//	Not assignable
+
+	private:
+		UByte *				mpRing;			///< @brief	Shared ring memory
+		ULWord				mReaderIndex;	///< @brief	My slot in the ring's reader table
+};	//	CNTV2FrameSubscriber
+
+#endif	//	NTV2FRAMESHARE_H
@@ -0,0 +1,133 @@
+/* SPDX-License-Identifier: MIT */
+/**
+	@file		ntv2interruptmux.h
+	@brief		Declares the CNTV2VerticalInterruptMux class.
+	@copyright	(C) 2023 AJA Video Systems, Inc.
+**/
+
+#ifndef NTV2INTERRUPTMUX_H
+#define NTV2INTERRUPTMUX_H
+
+#include "ntv2card.h"
+#include "ajabase/system/atomic.h"
+#include "ajabase/system/event.h"
+#include "ajabase/system/lock.h"
+#include "ajabase/system/thread.h"
+#include <vector>
+
+
+/**
+	@brief	Describes one or more vertical interrupts that fired on a given input or output channel
+			since the last time they were collected from a CNTV2VerticalInterruptMux.
+**/
+typedef struct NTV2VerticalEvent
+{
+	NTV2Channel	fChannel;		///< @brief	The FrameStore/channel that fired
+	bool		fIsInput;		///< @brief	True if it's an input VBI;  false if it's an output VBI
+	ULWord		fCount;			///< @brief	Number of VBIs since last collected (normally 1 -- more means the caller fell behind)
+	ULWord64	fTotalCount;	///< @brief	Total number of VBIs seen on this channel since the multiplexer was started
+
+	explicit inline	NTV2VerticalEvent (const NTV2Channel inChannel = NTV2_CHANNEL_INVALID, const bool inIsInput = true)
+		:	fChannel(inChannel), fIsInput(inIsInput), fCount(0), fTotalCount(0)		{}
+	inline INTERRUPT_ENUMS	InterruptType (void) const	{return fIsInput ? NTV2ChannelToInputInterrupt(fChannel) : NTV2ChannelToOutputInterrupt(fChannel);}
+} NTV2VerticalEvent;
+
+typedef std::vector<NTV2VerticalEvent>			NTV2VerticalEvents;			///< @brief	An ordered sequence of NTV2VerticalEvents
+typedef NTV2VerticalEvents::const_iterator		NTV2VerticalEventsConstIter;
+
+AJAExport std::ostream & operator << (std::ostream & oss, const NTV2VerticalEvent & inObj);
+
+
+/**
+	@brief	Waits for vertical interrupts on any number of input and/or output channels of one device at once,
+			so that a single thread can service many channels. Internally, I dedicate one lightweight waiter thread
+			per channel, and funnel their wakeups into a single event (and on Linux and MacOS, a pollable file
+			descriptor) that the client can wait on.
+			-	Call CNTV2VerticalInterruptMux::Start with the input and output channels of interest.
+			-	Call CNTV2VerticalInterruptMux::WaitForAny to block until one or more of them fire, or add
+				CNTV2VerticalInterruptMux::GetFileDescriptor to an epoll/kqueue/select set and call
+				CNTV2VerticalInterruptMux::Poll when it becomes readable.
+			-	Call CNTV2VerticalInterruptMux::Stop (or destroy me) when done.
+	@note	The CNTV2Card passed to my constructor must outlive me.
+**/
+class AJAExport CNTV2VerticalInterruptMux
+{
+	public:
+		explicit						CNTV2VerticalInterruptMux (CNTV2Card & inDevice);	///< @brief	My constructor.
+		virtual							~CNTV2VerticalInterruptMux ();						///< @brief	My destructor. Automatically calls Stop.
+
+		/**
+			@brief		Subscribes to the given input and output vertical events, and starts waiting for them.
+			@param[in]	inInputChannels		Specifies the input channels of interest (may be empty).
+			@param[in]	inOutputChannels	Specifies the output channels of interest (may be empty).
+			@return		True if successful;  otherwise false.
+			@note		If I'm already started, I'm first stopped.
+		**/
+		virtual bool					Start (const NTV2ChannelSet & inInputChannels, const NTV2ChannelSet & inOutputChannels = NTV2ChannelSet());
+
+		/**
+			@brief		Stops waiting for vertical events, and unsubscribes from them.
+		**/
+		virtual void					Stop (void);
+
+		/**
+			@brief		Blocks the calling thread until one or more of my channels' vertical interrupts fire, or until the timeout expires.
+			@param[out]	outEvents		Receives the channels that fired since the last call, along with their interrupt tallies.
+			@param[in]	inTimeoutMs		Optionally specifies the maximum time to wait, in milliseconds. Defaults to 100.
+			@return		True if at least one VBI was collected;  otherwise false (timeout or not started).
+		**/
+		virtual bool					WaitForAny (NTV2VerticalEvents & outEvents, const ULWord inTimeoutMs = 100);
+
+		/**
+			@brief		Collects any VBIs that have fired since the last call, without blocking.
+			@param[out]	outEvents		Receives the channels that fired since the last call, along with their interrupt tallies.
+			@return		True if at least one VBI was collected;  otherwise false.
+		**/
+		virtual bool					Poll (NTV2VerticalEvents & outEvents);
+
+		/**
+			@return		A file descriptor that becomes readable whenever one or more VBIs are pending collection.
+						It's suitable for use with epoll, kqueue, poll or select. Call Poll (or WaitForAny) to collect
+						the pending VBIs, which also resets its readable state. Don't read from or close it.
+						Returns -1 on platforms that don't support it (e.g. Windows).
+		**/
+		virtual int						GetFileDescriptor (void) const		{return mReadFD;}
+
+		inline bool						IsRunning (void) const				{return !mWaiters.empty();}	///< @return	True if I've been started.
+		inline size_t					GetNumChannels (void) const			{return mWaiters.size();}	///< @return	The number of channels I'm waiting on.
+		inline ULWord					GetWaitTimeout (void) const			{return mWaitTimeoutMs;}	///< @return	The per-channel driver wait timeout, in milliseconds.
+		inline void						SetWaitTimeout (const ULWord inMs)	{mWaitTimeoutMs = inMs ? inMs : 1;}	///< @brief	Sets the per-channel driver wait timeout (default is 68 ms).
+
+	private:
+		struct Waiter
+		{
+			CNTV2VerticalInterruptMux *	fpMux;		///< @brief	My owner
+			NTV2VerticalEvent			fEvent;		///< @brief	Pending tally (guarded by owner's mLock)
+			AJAThread					fThread;	///< @brief	My thread
+		};
+		typedef std::vector<Waiter*>	Waiters;
+
+		static void						WaiterThreadStatic (AJAThread * pThread, void * pContext);
+		void							WaiterThread (Waiter & inWaiter);
+		void							NotifyPending (void);
+		void							ClearPending (void);
+		bool							Collect (NTV2VerticalEvents & outEvents);
+
+	private:
+										CNTV2VerticalInterruptMux (const CNTV2VerticalInterruptMux & inObj);	//	Not copyable
+		CNTV2VerticalInterruptMux &		operator = (const CNTV2VerticalInterruptMux & inRHS);					//	Not assignable
+
+	private:
+		CNTV2Card &		mDevice;		///< @brief	The device I wait on
+		Waiters			mWaiters;		///< @brief	One waiter per channel of interest
+		NTV2ChannelSet	mInputs;		///< @brief	Input channels I subscribed to
+		NTV2ChannelSet	mOutputs;		///< @brief	Output channels I subscribed to
+		mutable AJALock	mLock;			///< @brief	Guards each Waiter's fEvent
+		AJAEvent		mPendingEvent;	///< @brief	Signaled when one or more VBIs are pending collection
+		int				mReadFD;		///< @brief	Readable when VBIs are pending (eventfd on Linux, pipe on MacOS)
+		int				mWriteFD;		///< @brief	Write end (same as mReadFD on Linux)
+		ULWord			mWaitTimeoutMs;	///< @brief	Per-channel driver wait timeout
+		AJAAtomicFlag	mQuit;			///< @brief	Set to stop waiter threads
+};	//	CNTV2VerticalInterruptMux
+
+#endif	//	NTV2INTERRUPTMUX_H
@@ -177,6 +177,12 @@ class AJAExport NTV2RPCClientAPI
 {
 	public:
 		static NTV2RPCClientAPI *	CreateClient (const NTV2ConnectParams & inParams);
+		/**
+			@brief		Overrides the folder that plugins are loaded from (normally the parent of the AJA "firmware" folder).
+			@param[in]	inFolderPath	Path to the folder containing the plugin DLLs/dylibs/SOs. Empty restores the default.
+		**/
+		static void					SetPluginsFolder (const std::string & inFolderPath);
+		static std::string			GetPluginsFolder (void);	///< @return	The plugins folder set by SetPluginsFolder, or empty if the default is used.
 
 	public:
 		/**
@@ -0,0 +1,91 @@
+/* SPDX-License-Identifier: MIT */
+/**
+	@file		ntv2pixelformatconverter.h
+	@brief		Declares the CNTV2PixelFormatConverter class.
+	@copyright	(C) 2023 AJA Video Systems, Inc.
+**/
+
+#ifndef NTV2PIXELFORMATCONVERTER_H
+#define NTV2PIXELFORMATCONVERTER_H
+
+#include "ajaexport.h"
+#include "ntv2publicinterface.h"
+#include "ntv2formatdescriptor.h"
+#include "ajabase/common/videotypes.h"
+#include <string>
+
+class AJAWorkerPool;
+
+
+/**
+	@brief	Converts frames between any two supported pixel formats with a single call. The supported formats are
+			10-bit YCbCr 4:2:2 (v210), 8-bit YCbCr 4:2:2 (2vuy and YUY2), 8-bit RGB/RGBA (all orders), 10-bit RGB,
+			10-bit DPX (big and little endian), 48-bit RGB, and the planar YCbCr formats -- 8-bit 4:2:0 and 4:2:2 with
+			two (NV12/NV16) or three planes, 10-bit 4:2:0 and 4:2:2 three-plane little-endian, and 10-bit 4:2:0 and
+			4:2:2 two-plane packed.
+			Each conversion is a chain of line kernels -- a direct kernel, or a path through unpacked intermediates
+			(16-bit 4:2:2 YCbCr, or 8-, 10- or 16-bit RGBA). The cheapest chain that doesn't lose precision (or cross
+			between YCbCr and RGB when it needn't) is planned the first time a format pair is used, and the plan is
+			cached (for the life of the process) for all converters to reuse. Lines are split between the threads of
+			an AJAWorkerPool.
+			Planar rows are read and written through the NTV2FormatDescriptor's plane model (GetRowAddress etc.).
+	@note	Conversions between YCbCr and RGB use full-range RGB, and the color matrix set by SetColorMatrix.
+	@note	4:2:0 chroma is sited horizontally co-sited with the even luma samples, and vertically midway between
+			luma rows (MPEG-2/H.264 chroma location type 0). It's decimated from 4:2:2 with a (1,3,3,1)/8 vertical
+			filter, and interpolated back (3:1 from the nearer chroma row). Frames are treated as progressive.
+**/
+class AJAExport CNTV2PixelFormatConverter
+{
+	public:
+		/**
+			@brief		Constructs me.
+			@param[in]	inMatrix	Optionally specifies the YCbCr/RGB color matrix. Defaults to Rec.709.
+			@param[in]	pInPool		Optionally specifies the worker pool to use. Defaults to AJAWorkerPool::GetSharedPool.
+		**/
+		explicit			CNTV2PixelFormatConverter (const AJA_ColorMatrix inMatrix = AJA_ColorMatrix_Rec709,
+														AJAWorkerPool * pInPool = AJA_NULL);
+		virtual				~CNTV2PixelFormatConverter ();
+
+		/**
+			@brief		Converts a frame.
+			@param[in]	inFrame		The source frame.
+			@param[in]	inDesc		Describes the source raster (size, line pitch and pixel format).
+			@param		outFrame	Receives the converted frame.
+			@param[in]	inOutDesc	Describes the destination raster. Must be the same size as the source.
+			@return		True if successful;  otherwise false.
+		**/
+		virtual bool		Convert (const NTV2Buffer & inFrame,  const NTV2FormatDescriptor & inDesc,
+									NTV2Buffer & outFrame,  const NTV2FormatDescriptor & inOutDesc);
+
+		inline void			SetColorMatrix (const AJA_ColorMatrix inMatrix)		{mMatrix = inMatrix;}
+		inline AJA_ColorMatrix	GetColorMatrix (void) const						{return mMatrix;}
+
+		/**
+			@return		True if frames can be converted from the given source pixel format to the given destination format.
+		**/
+		static bool			CanConvert (const NTV2PixelFormat inSrcPixelFormat, const NTV2PixelFormat inDstPixelFormat);
+
+		/**
+			@return		A description of the kernel chain used to convert between the given pixel formats
+						(e.g. "v210 > yuv16 > rgba10 > dpx"), or an empty string if unsupported.
+		**/
+		static std::string	GetPlan (const NTV2PixelFormat inSrcPixelFormat, const NTV2PixelFormat inDstPixelFormat);
+
+		/**
+			@return		The estimated relative cost (per pixel) of converting between the given pixel formats,
+						or zero if unsupported.
+		**/
+		static ULWord		GetPlanCost (const NTV2PixelFormat inSrcPixelFormat, const NTV2PixelFormat inDstPixelFormat);
+
+		static size_t		GetNumCachedPlans (void);	///< @return	The number of format pairs planned so far.
+
+	private:
+							CNTV2PixelFormatConverter (const CNTV2PixelFormatConverter & inObj);	//	Not copyable
+		CNTV2PixelFormatConverter &	operator = (const CNTV2PixelFormatConverter & inRHS);		//	Not assignable
+
+	private:
+		AJAWorkerPool *		mpPool;
+		AJA_ColorMatrix		mMatrix;
+};	//	CNTV2PixelFormatConverter
+
+#endif	//	NTV2PIXELFORMATCONVERTER_H
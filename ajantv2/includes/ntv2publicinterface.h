@@ -7467,6 +7467,14 @@ typedef enum
 				**/
 				bool		PatchRegister (const ULWord inRegNum, const ULWord inValue);	//	New in SDK 17.0
 
+				/**
+					@brief		Records another successfully-read register value (for software devices that service GETREGS).
+					@param[in]	inRegNum	Specifies the register that was read.
+					@param[in]	inValue		Specifies its value.
+					@return		True if successful;	 otherwise false.
+				**/
+				bool		AddRegisterValue (const ULWord inRegNum, const ULWord inValue);	//	New in SDK 17.1
+
 				/**
 					@brief	Prints a human-readable representation of me to the given output stream.
 					@param	inOutStream		Specifies the output stream to use.
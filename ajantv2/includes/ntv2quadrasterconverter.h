@@ -0,0 +1,124 @@
+/* SPDX-License-Identifier: MIT */
+/**
+	@file		ntv2quadrasterconverter.h
+	@brief		Declares the CNTV2QuadRasterConverter class.
+	@copyright	(C) 2023 AJA Video Systems, Inc.
+**/
+
+#ifndef NTV2QUADRASTERCONVERTER_H
+#define NTV2QUADRASTERCONVERTER_H
+
+#include "ajaexport.h"
+#include "ntv2publicinterface.h"
+#include "ntv2formatdescriptor.h"
+#include <string>
+
+class AJAWorkerPool;
+
+
+/**
+	@brief	Ways a 4K/UHD or 8K/UHD2 raster is divided into four quarter-size sub-images (e.g. for four 3G/12G links).
+**/
+typedef enum
+{
+	NTV2_QUAD_LAYOUT_SQUARES,	///< @brief	Square division -- the top-left, top-right, bottom-left and bottom-right quadrants
+	NTV2_QUAD_LAYOUT_TSI,		///< @brief	Two-sample interleave (SMPTE ST 425-5) -- sub-images 1 & 2 hold alternate pixel pairs of
+								///<		the even lines, sub-images 3 & 4 those of the odd lines
+	NTV2_QUAD_LAYOUT_INVALID
+} NTV2QuadLayout;
+
+#define	NTV2_IS_VALID_QUAD_LAYOUT(__l__)	((__l__) >= NTV2_QUAD_LAYOUT_SQUARES  &&  (__l__) < NTV2_QUAD_LAYOUT_INVALID)
+
+AJAExport std::string NTV2QuadLayoutToString (const NTV2QuadLayout inLayout, const bool inCompact = false);
+
+
+/**
+	@brief	Reorganizes host frames between a full raster and its four sub-images, in square-division or two-sample-interleave
+			(2SI) layout, and between the two layouts, for 10-bit YCbCr 4:2:2 (v210), 8-bit YCbCr 4:2:2 (2vuy and YUY2),
+			8-bit RGB/RGBA (all orders), 10-bit RGB and DPX, and 48-bit RGB frames.
+			Each line is moved as whole halves (square division) or split into alternating pixel pairs (2SI) -- the latter
+			with SSE2 where available. v210 pairs are regrouped 12 pixels (two 16-byte groups) at a time, so v210 lines are
+			only unpacked to 16-bit components when their halves aren't whole groups (e.g. 4096 and 8192 wide).
+			Lines are split between the threads of an AJAWorkerPool.
+			Unlike ::CopyToQuadrant and ::CopyFromQuadrant, each sub-image is a separate buffer with its own natural line
+			pitch, so the 4096- and 8192-wide v210 rasters need no special offset.
+	@note	Sub-images are numbered 0 thru 3 (i.e. SMPTE's sub-images 1 thru 4, or quadrants 1 thru 4).
+**/
+class AJAExport CNTV2QuadRasterConverter
+{
+	public:
+		/**
+			@brief		Constructs me.
+			@param[in]	pInPool		Optionally specifies the worker pool to use. Defaults to AJAWorkerPool::GetSharedPool.
+		**/
+		explicit			CNTV2QuadRasterConverter (AJAWorkerPool * pInPool = AJA_NULL);
+		virtual				~CNTV2QuadRasterConverter ();
+
+		/**
+			@brief		Divides a full raster into four sub-images.
+			@param[in]	inFrame			The full raster.
+			@param[in]	inDesc			Describes the full raster (size, line pitch and pixel format).
+			@param		pOutQuads		Points to an array of four buffers that receive the sub-images. Each must be
+										at least inQuadRowBytes times half the raster height.
+			@param[in]	inLayout		Specifies the sub-images' layout.
+			@param[in]	inQuadRowBytes	Optionally specifies the sub-images' line pitch, in bytes.
+										Defaults to zero, which uses the pixel format's natural line pitch.
+			@return		True if successful;  otherwise false.
+		**/
+		virtual bool		Split (const NTV2Buffer & inFrame,  const NTV2FormatDescriptor & inDesc,  NTV2Buffer * pOutQuads,
+									const NTV2QuadLayout inLayout,  const ULWord inQuadRowBytes = 0);
+
+		/**
+			@brief		Assembles a full raster from four sub-images.
+			@param[in]	pInQuads		Points to an array of the four sub-images.
+			@param[in]	inLayout		Specifies the sub-images' layout.
+			@param		outFrame		Receives the full raster.
+			@param[in]	inDesc			Describes the full raster (size, line pitch and pixel format).
+			@param[in]	inQuadRowBytes	Optionally specifies the sub-images' line pitch, in bytes.
+										Defaults to zero, which uses the pixel format's natural line pitch.
+			@return		True if successful;  otherwise false.
+		**/
+		virtual bool		Join (const NTV2Buffer * pInQuads,  const NTV2QuadLayout inLayout,  NTV2Buffer & outFrame,
+									const NTV2FormatDescriptor & inDesc,  const ULWord inQuadRowBytes = 0);
+
+		/**
+			@brief		Converts four sub-images from one layout to the other (e.g. square division to 2SI).
+			@param[in]	pInQuads		Points to an array of the four source sub-images.
+			@param[in]	inSrcLayout		Specifies the source sub-images' layout.
+			@param		pOutQuads		Points to an array of four buffers that receive the converted sub-images.
+										They must not overlap the source sub-images.
+			@param[in]	inDstLayout		Specifies the converted sub-images' layout.
+			@param[in]	inDesc			Describes the full raster the sub-images make up (its size and pixel format).
+			@param[in]	inQuadRowBytes	Optionally specifies the sub-images' line pitch, in bytes.
+										Defaults to zero, which uses the pixel format's natural line pitch.
+			@return		True if successful;  otherwise false.
+		**/
+		virtual bool		Relayout (const NTV2Buffer * pInQuads,  const NTV2QuadLayout inSrcLayout,  NTV2Buffer * pOutQuads,
+									const NTV2QuadLayout inDstLayout,  const NTV2FormatDescriptor & inDesc,  const ULWord inQuadRowBytes = 0);
+
+		/**
+			@brief		Selects whether pixel pairs are interleaved and de-interleaved with SSE2 shuffles, or copied one
+						pair at a time. SSE2 is the default in builds that have it. Both move the same bytes.
+		**/
+		inline void			SetUseSIMD (const bool inUseSIMD)			{mUseSIMD = inUseSIMD && HasSIMD();}
+		inline bool			GetUseSIMD (void) const						{return mUseSIMD;}
+
+		static bool			CanConvert (const NTV2PixelFormat inPixelFormat);	///< @return	True if the pixel format is supported.
+		static bool			HasSIMD (void);		///< @return	True if this build has a SIMD code path.
+
+		/**
+			@return		The natural line pitch, in bytes, of a sub-image of a raster of the given width and (supported)
+						pixel format, or zero if unsupported.
+		**/
+		static ULWord		GetQuadRowBytes (const NTV2PixelFormat inPixelFormat, const ULWord inFullWidth);
+
+	private:
+							CNTV2QuadRasterConverter (const CNTV2QuadRasterConverter & inObj);	//	Not copyable
+		CNTV2QuadRasterConverter &	operator = (const CNTV2QuadRasterConverter & inRHS);		//	Not assignable
+
+	private:
+		AJAWorkerPool *		mpPool;
+		bool				mUseSIMD;
+};	//	CNTV2QuadRasterConverter
+
+#endif	//	NTV2QUADRASTERCONVERTER_H
@@ -203,6 +203,8 @@ class AJAExport CNTV2RegisterExpert
 			@return		True if successful;	 otherwise false.
 			@note		Normally, there is no need to call this function, as the RegisterExpert singleton is
 						automatically deallocated.
+			@note		Lookups don't lock, so other threads may still be using the old tables. The old singleton is
+						therefore only released at exit, and the next lookup (or Allocate) builds a new one.
 		**/
 		static bool Deallocate(void);
 
@@ -0,0 +1,133 @@
+/* SPDX-License-Identifier: MIT */
+/**
+	@file		ntv2scaler.h
+	@brief		Declares the CNTV2Scaler class.
+	@copyright	(C) 2023 AJA Video Systems, Inc.
+**/
+
+#ifndef NTV2SCALER_H
+#define NTV2SCALER_H
+
+#include "ajaexport.h"
+#include "ntv2publicinterface.h"
+#include "ntv2formatdescriptor.h"
+#include <vector>
+
+class AJAWorkerPool;
+
+
+/**
+	@brief	Filter kernels supported by CNTV2Scaler.
+**/
+typedef enum
+{
+	NTV2_SCALER_FILTER_BILINEAR,	///< @brief	Triangle (tent) filter -- 2 taps (at unity scale)
+	NTV2_SCALER_FILTER_BICUBIC,		///< @brief	Catmull-Rom cubic -- 4 taps (at unity scale)
+	NTV2_SCALER_FILTER_LANCZOS,		///< @brief	Lanczos windowed sinc -- configurable number of taps
+	NTV2_SCALER_FILTER_INVALID
+} NTV2ScalerFilter;
+
+#define	NTV2_IS_VALID_SCALER_FILTER(__f__)	((__f__) >= NTV2_SCALER_FILTER_BILINEAR  &&  (__f__) < NTV2_SCALER_FILTER_INVALID)
+
+AJAExport std::string NTV2ScalerFilterToString (const NTV2ScalerFilter inFilter, const bool inCompact = false);
+
+
+/**
+	@brief	Scales frames between arbitrary sizes (down to thumbnails, or up) with a separable polyphase filter, operating on
+			10-bit YCbCr 4:2:2 (v210), 8-bit YCbCr 4:2:2 (2vuy and YUY2), 10-bit RGB, and 8-bit RGB/RGBA (all orders) frames.
+			Each line is unpacked into 16-bit component planes, filtered horizontally, then vertically, then repacked into the
+			same pixel format. When downscaling, the filter is stretched by the scale factor, so it properly low-pass filters
+			(rather than skipping) the source pixels. 4:2:2 chroma is kept co-sited with the even luma samples.
+			Coefficient tables are computed once per geometry and reused for subsequent frames. Lines are split between the
+			threads of an AJAWorkerPool, and the filters use SSE2 where available.
+	@note	I'm not thread-safe (I keep per-geometry tables and an intermediate buffer). Use one CNTV2Scaler per thread.
+**/
+class AJAExport CNTV2Scaler
+{
+	public:
+		/**
+			@brief		Constructs me.
+			@param[in]	inFilter	Optionally specifies the filter kernel. Defaults to NTV2_SCALER_FILTER_LANCZOS.
+			@param[in]	inTaps		Optionally specifies the number of Lanczos taps (even, 2 to 16). Defaults to 6 (i.e. Lanczos-3).
+									Ignored for the other filters.
+			@param[in]	pInPool		Optionally specifies the worker pool to use. Defaults to AJAWorkerPool::GetSharedPool.
+		**/
+		explicit			CNTV2Scaler (const NTV2ScalerFilter inFilter = NTV2_SCALER_FILTER_LANCZOS,  const ULWord inTaps = 6,
+										AJAWorkerPool * pInPool = AJA_NULL);
+		virtual				~CNTV2Scaler ();
+
+		/**
+			@brief		Changes the filter kernel.
+			@param[in]	inFilter	Specifies the filter kernel.
+			@param[in]	inTaps		Specifies the number of Lanczos taps (even, 2 to 16). Defaults to 6.
+			@return		True if successful;  otherwise false.
+		**/
+		virtual bool		SetFilter (const NTV2ScalerFilter inFilter, const ULWord inTaps = 6);
+		inline NTV2ScalerFilter	GetFilter (void) const	{return mFilter;}
+		inline ULWord		GetTaps (void) const		{return mTaps;}
+
+		/**
+			@brief		Scales a frame.
+			@param[in]	inFrame			The source frame.
+			@param[in]	inDesc			Describes the source raster (size, line pitch and pixel format).
+			@param		outFrame		Receives the scaled frame, in the same pixel format.
+			@param[in]	inOutWidth		The width of the scaled frame, in pixels. Must be even for 4:2:2 formats.
+			@param[in]	inOutHeight		The height of the scaled frame, in lines.
+			@param[in]	inOutRowBytes	Optionally specifies the scaled frame's line pitch, in bytes.
+										Defaults to zero, which uses the pixel format's natural line pitch.
+			@return		True if successful;  otherwise false.
+		**/
+		virtual bool		Scale (const NTV2Buffer & inFrame,  const NTV2FormatDescriptor & inDesc,  NTV2Buffer & outFrame,
+									const ULWord inOutWidth,  const ULWord inOutHeight,  const ULWord inOutRowBytes = 0);
+
+		/**
+			@brief		Selects whether the Q14 fixed-point filter taps are accumulated eight at a time with SSE2
+						multiply-adds, or one at a time. SSE2 is the default in builds that have it. The integer sums are
+						exact, so the scaled pixels don't change.
+		**/
+		inline void			SetUseSIMD (const bool inUseSIMD)			{mUseSIMD = inUseSIMD && HasSIMD();}
+		inline bool			GetUseSIMD (void) const						{return mUseSIMD;}
+
+		static bool			CanScale (const NTV2PixelFormat inPixelFormat);	///< @return	True if the pixel format is supported.
+		static bool			HasSIMD (void);		///< @return	True if this build has a SIMD code path.
+
+		/**
+			@return		The natural line pitch, in bytes, of a raster of the given width and (supported) pixel format,
+						or zero if unsupported.
+		**/
+		static ULWord		GetRowBytes (const NTV2PixelFormat inPixelFormat, const ULWord inWidth);
+
+	public:
+		/**
+			@brief	A precomputed 1-D polyphase filter: for each output sample, the index of the first input sample
+					it depends on, and the (Q14 fixed-point) weights of that sample and the next fTaps-1 samples.
+		**/
+		typedef struct FilterTable
+		{
+			ULWord				fInSize;	///< @brief	Number of input samples
+			ULWord				fOutSize;	///< @brief	Number of output samples
+			bool				fCoSited;	///< @brief	True if sampled co-sited with even luma (4:2:2 chroma)
+			ULWord				fTaps;		///< @brief	Weights per output sample (rounded up to a multiple of 8)
+			std::vector<ULWord>	fStart;		///< @brief	First input sample index, per output sample
+			std::vector<Word>	fWeights;	///< @brief	fOutSize * fTaps weights, summing to 16384 per output sample
+			FilterTable () : fInSize(0), fOutSize(0), fCoSited(false), fTaps(0)	{}
+		} FilterTable;
+
+	private:
+		bool				PrepareTables (const ULWord inInWidth, const ULWord inInHeight, const ULWord inOutWidth, const ULWord inOutHeight, const bool in422);
+		void				BuildTable (FilterTable & outTable, const ULWord inInSize, const ULWord inOutSize, const bool inCoSited) const;
+							CNTV2Scaler (const CNTV2Scaler & inObj);				//	Not copyable
+		CNTV2Scaler &		operator = (const CNTV2Scaler & inRHS);					//	Not assignable
+
+	private:
+		AJAWorkerPool *		mpPool;
+		NTV2ScalerFilter	mFilter;
+		ULWord				mTaps;
+		bool				mUseSIMD;
+		FilterTable			mHorz;			///< @brief	Horizontal filter (luma, or all RGB components)
+		FilterTable			mHorzChroma;	///< @brief	Horizontal filter (4:2:2 chroma)
+		FilterTable			mVert;			///< @brief	Vertical filter
+		NTV2Buffer			mIntermediate;	///< @brief	Horizontally-filtered lines (input height x output width x components)
+};	//	CNTV2Scaler
+
+#endif	//	NTV2SCALER_H
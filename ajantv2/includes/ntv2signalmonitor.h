@@ -0,0 +1,195 @@
+/* SPDX-License-Identifier: MIT */
+/**
+	@file		ntv2signalmonitor.h
+	@brief		Declares the CNTV2SignalMonitor class.
+	@copyright	(C) 2023 AJA Video Systems, Inc.
+**/
+
+#ifndef NTV2SIGNALMONITOR_H
+#define NTV2SIGNALMONITOR_H
+
+#include "ntv2card.h"
+#include "ajabase/system/atomic.h"
+#include "ajabase/system/lock.h"
+#include "ajabase/system/thread.h"
+#include <vector>
+#include <map>
+
+
+/**
+	@brief	Bit flags that identify what changed between two NTV2InputSignalState snapshots.
+**/
+typedef enum
+{
+	NTV2_SIGNAL_CHANGED_NONE	= 0,
+	NTV2_SIGNAL_CHANGED_FORMAT	= BIT(0),	///< @brief	Detected video format, rate, geometry or scan changed
+	NTV2_SIGNAL_CHANGED_LOCK	= BIT(1),	///< @brief	Lock state changed
+	NTV2_SIGNAL_CHANGED_VPID	= BIT(2),	///< @brief	VPID (including HDR transfer characteristics) changed
+	NTV2_SIGNAL_CHANGED_ERRORS	= BIT(3),	///< @brief	TRS error state, CRC error tally or unlock tally changed
+	NTV2_SIGNAL_CHANGED_AUDIO	= BIT(4),	///< @brief	Detected embedded audio channel pairs changed
+	NTV2_SIGNAL_CHANGED_HDMI	= BIT(5),	///< @brief	HDMI input status changed
+	NTV2_SIGNAL_CHANGED_ALL		= 0x3F
+} NTV2SignalChangeFlags;
+
+
+/**
+	@brief	A decoded snapshot of the signal status of one SDI or HDMI input.
+**/
+typedef struct AJAExport NTV2InputSignalState
+{
+	NTV2InputSource		fInputSource;		///< @brief	The input this describes
+	NTV2VideoFormat		fVideoFormat;		///< @brief	Detected video format (same as CNTV2Card::GetInputVideoFormat)
+	NTV2FrameRate		fFrameRate;			///< @brief	Detected frame rate (SDI only)
+	NTV2FrameGeometry	fFrameGeometry;		///< @brief	Detected frame geometry (SDI only)
+	bool				fIsProgressive;		///< @brief	Progressive transport? (SDI only)
+	bool				fIs3G;				///< @brief	3Gbps? (SDI only)
+	bool				fIs3Gb;				///< @brief	3Gbps level B? (SDI only)
+	bool				fIs6G;				///< @brief	6Gbps? (SDI only)
+	bool				fIs12G;				///< @brief	12Gbps? (SDI only)
+	bool				fIsLocked;			///< @brief	Input locked?
+	bool				fVPIDValidA;		///< @brief	VPID link A valid? (SDI only)
+	bool				fVPIDValidB;		///< @brief	VPID link B valid? (SDI only)
+	ULWord				fVPIDA;				///< @brief	VPID link A (SDI only, host byte order, same as CNTV2Card::ReadSDIInVPID)
+	ULWord				fVPIDB;				///< @brief	VPID link B (SDI only, host byte order, same as CNTV2Card::ReadSDIInVPID)
+	NTV2VPIDXferChars	fXferChars;			///< @brief	HDR transfer characteristics from VPID link A (SDI only)
+	bool				fTRSError;			///< @brief	TRS error? (SDI only, requires kDeviceCanDoSDIErrorChecks)
+	ULWord				fCRCTallyA;			///< @brief	Link A CRC error tally (SDI only, requires kDeviceCanDoSDIErrorChecks)
+	ULWord				fCRCTallyB;			///< @brief	Link B CRC error tally (SDI only, requires kDeviceCanDoSDIErrorChecks)
+	ULWord				fUnlockTally;		///< @brief	Unlock tally (SDI only, requires kDeviceCanDoSDIErrorChecks)
+	ULWord				fAudioPairsMask;	///< @brief	Detected embedded audio channel pairs, one bit per NTV2AudioChannelPair (SDI only)
+	ULWord				fHDMIStatus;		///< @brief	Raw HDMI input status register value (HDMI only)
+
+	explicit	NTV2InputSignalState (const NTV2InputSource inInputSource = NTV2_INPUTSOURCE_INVALID);
+
+	/**
+		@return		The NTV2SignalChangeFlags that differ between me and the given state.
+		@param[in]	inRHS	The state to compare with.
+	**/
+	ULWord		Compare (const NTV2InputSignalState & inRHS) const;
+	inline bool	operator == (const NTV2InputSignalState & inRHS) const	{return Compare(inRHS) == NTV2_SIGNAL_CHANGED_NONE;}
+	inline bool	operator != (const NTV2InputSignalState & inRHS) const	{return !(*this == inRHS);}
+	std::ostream &	Print (std::ostream & oss) const;
+} NTV2InputSignalState;
+
+inline std::ostream & operator << (std::ostream & oss, const NTV2InputSignalState & inObj)	{return inObj.Print(oss);}
+
+typedef std::map<NTV2InputSource, NTV2InputSignalState>		NTV2InputSignalStates;				///< @brief	Maps NTV2InputSource to its NTV2InputSignalState
+typedef NTV2InputSignalStates::const_iterator				NTV2InputSignalStatesConstIter;
+
+/**
+	@brief		A client-supplied function that gets called whenever an input's signal state changes.
+	@param[in]	pInUserData		The client data pointer that was passed to CNTV2SignalMonitor::AddCallback.
+	@param[in]	inOldState		The input's previous state.
+	@param[in]	inNewState		The input's new state.
+	@param[in]	inChangeFlags	The NTV2SignalChangeFlags that identify what changed.
+	@note		This is called from the monitor's thread, so it should return quickly.
+**/
+typedef void (*NTV2SignalChangeCallback) (void * pInUserData, const NTV2InputSignalState & inOldState, const NTV2InputSignalState & inNewState, const ULWord inChangeFlags);
+
+
+/**
+	@brief	Monitors the signal status of any number of a device's SDI and HDMI inputs on a background thread.
+			Once per output VBI, I read every relevant status register in a single CNTV2Card::ReadRegisters call,
+			decode them once, and notify subscribers only when something changes. This is far less register traffic
+			than polling CNTV2Card::GetInputVideoFormat, CNTV2Card::ReadSDIInVPID, etc. for every input on every frame.
+	@note	The CNTV2Card passed to my constructor must outlive me.
+**/
+class AJAExport CNTV2SignalMonitor
+{
+	public:
+		explicit						CNTV2SignalMonitor (CNTV2Card & inDevice);	///< @brief	My constructor.
+		virtual							~CNTV2SignalMonitor ();						///< @brief	My destructor. Automatically calls Stop.
+
+		/**
+			@brief		Configures me to monitor the given inputs. Can only be called while I'm stopped.
+			@param[in]	inInputSources	Specifies the SDI and/or HDMI inputs to monitor. If empty (the default),
+										monitors all of the device's SDI and HDMI inputs.
+			@return		True if successful;  otherwise false.
+		**/
+		virtual bool					SetInputSources (const NTV2InputSourceSet & inInputSources = NTV2InputSourceSet());
+
+		/**
+			@brief		Starts my monitor thread, which calls Update once per VBI of the given output channel.
+			@param[in]	inVBIChannel	Optionally specifies the output channel whose VBI paces me. Defaults to NTV2_CHANNEL1.
+			@return		True if successful;  otherwise false.
+			@note		If SetInputSources wasn't called, all of the device's SDI and HDMI inputs are monitored.
+		**/
+		virtual bool					Start (const NTV2Channel inVBIChannel = NTV2_CHANNEL1);
+
+		/**
+			@brief		Stops my monitor thread.
+		**/
+		virtual void					Stop (void);
+
+		/**
+			@brief		Reads all monitored inputs' status registers in one batch, decodes them, and notifies
+						subscribers of any changes. My monitor thread calls this once per VBI, but clients that
+						don't want another thread can call it themselves instead of calling Start.
+			@return		True if successful;  otherwise false.
+		**/
+		virtual bool					Update (void);
+
+		/**
+			@brief		Registers a function to be called whenever a monitored input's signal state changes.
+			@param[in]	pInCallback		Specifies the function to call. Must be non-NULL.
+			@param[in]	pInUserData		Specifies an optional pointer that gets passed back to the callback.
+			@return		True if successful;  otherwise false.
+		**/
+		virtual bool					AddCallback (NTV2SignalChangeCallback pInCallback, void * pInUserData = AJA_NULL);
+
+		/**
+			@brief		Unregisters a previously-registered callback.
+			@param[in]	pInCallback		Specifies the function to unregister.
+			@param[in]	pInUserData		Specifies the user data pointer it was registered with.
+			@return		True if it was found and removed;  otherwise false.
+		**/
+		virtual bool					RemoveCallback (NTV2SignalChangeCallback pInCallback, void * pInUserData = AJA_NULL);
+
+		/**
+			@brief		Answers with the most recently decoded state of the given input.
+			@param[in]	inInputSource	Specifies the input of interest.
+			@param[out]	outState		Receives the input's state.
+			@return		True if successful;  otherwise false (e.g. not monitored, or no Update yet).
+		**/
+		virtual bool					GetState (const NTV2InputSource inInputSource, NTV2InputSignalState & outState) const;
+
+		virtual NTV2InputSignalStates	GetStates (void) const;		///< @return	The most recently decoded state of all monitored inputs.
+		virtual NTV2InputSourceSet		GetInputSources (void) const;	///< @return	The inputs I'm monitoring.
+		inline size_t					GetNumRegisters (void) const	{return mRegNums.size();}	///< @return	The number of registers I read per Update.
+		inline ULWord64					GetUpdateCount (void) const		{return mUpdateCount;}		///< @return	The number of successful Updates I've performed.
+		virtual bool					IsRunning (void) const;		///< @return	True if my monitor thread is running.
+
+	private:
+		typedef std::pair<NTV2SignalChangeCallback, void*>	Subscriber;
+		typedef std::vector<Subscriber>						Subscribers;
+
+		bool							PrepareRegisters (void);
+		void							DecodeSDI (const NTV2InputSource inSrc, const NTV2RegisterValueMap & inRegs, NTV2InputSignalState & outState) const;
+		void							DecodeHDMI (const NTV2InputSource inSrc, const NTV2RegisterValueMap & inRegs, NTV2InputSignalState & outState) const;
+		static void						MonitorThreadStatic (AJAThread * pThread, void * pContext);
+		void							MonitorThread (void);
+
+	private:
+										CNTV2SignalMonitor (const CNTV2SignalMonitor & inObj);	//	Not copyable
+		CNTV2SignalMonitor &			operator = (const CNTV2SignalMonitor & inRHS);			//	Not assignable
+
+	private:
+		CNTV2Card &				mDevice;		///< @brief	The device I monitor
+		NTV2InputSourceSet		mSources;		///< @brief	Inputs I monitor
+		NTV2RegNumSet			mRegNums;		///< @brief	Registers I read per Update
+		NTV2InputSignalStates	mStates;		///< @brief	Last decoded state per input
+		Subscribers				mSubscribers;	///< @brief	Change callbacks
+		mutable AJALock			mLock;			///< @brief	Guards mStates & mSubscribers
+		AJAThread				mThread;		///< @brief	My monitor thread
+		NTV2Channel				mVBIChannel;	///< @brief	Output channel whose VBI paces my thread
+		ULWord64				mUpdateCount;	///< @brief	Number of successful Updates
+		ULWord					mHDMIVersion;	///< @brief	Device's HDMI version
+		bool					mCanDoErrChks;	///< @brief	Device supports SDI error checks?
+		bool					mIsLHi;			///< @brief	Device is a KONA LHi? (VPID byte order & 3G detection differ)
+		std::vector<bool>		mCanDo3GIn;		///< @brief	Per-SDI-input 3G/12G input widget present?
+		std::vector<bool>		mCanDo12GIn;	///< @brief	Per-SDI-input 12G input widget present?
+		std::vector<bool>		mCanDo292In;	///< @brief	Per-SDI-input 1.5G input widget present?
+		AJAAtomicFlag			mQuit;			///< @brief	Set to stop my thread
+};	//	CNTV2SignalMonitor
+
+#endif	//	NTV2SIGNALMONITOR_H
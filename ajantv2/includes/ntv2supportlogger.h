@@ -23,6 +23,74 @@ typedef enum
 	NTV2_SupportLoggerSectionsAll			= 0xFFFFFFFF
 } NTV2SupportLoggerSections;
 
+
+/**
+	@brief	Compact SDRAM dump files (see CNTV2SupportLogger::DumpDeviceSDRAM) start with an NTV2SDRAMDumpHeader,
+			followed by each frame's encoded payload, followed by an index of NTV2SDRAMDumpFrameInfo records
+			(one per frame) that starts at NTV2SDRAMDumpHeader::fIndexOffset. All values are little-endian.
+**/
+#define	NTV2_SDRAMDUMP_MAGIC	"NTV2SDRM"
+#define	NTV2_SDRAMDUMP_VERSION	1
+
+typedef enum
+{
+	NTV2SDRAMDumpEncoding_Raw,		///< @brief	Payload is the frame, verbatim
+	NTV2SDRAMDumpEncoding_Fill,		///< @brief	No payload -- the frame is fFillValue repeated (e.g. all zeroes)
+	NTV2SDRAMDumpEncoding_RLE32,	///< @brief	Payload is 32-bit word run-length encoded
+	NTV2SDRAMDumpEncoding_Missing	///< @brief	No payload -- the frame couldn't be read from the device
+} NTV2SDRAMDumpEncoding;
+
+typedef struct NTV2SDRAMDumpHeader
+{
+	char		fMagic[8];		///< @brief	NTV2_SDRAMDUMP_MAGIC
+	uint32_t	fVersion;		///< @brief	NTV2_SDRAMDUMP_VERSION
+	uint32_t	fFrameBytes;	///< @brief	Size of each frame, in bytes
+	uint32_t	fNumFrames;		///< @brief	Number of frames
+	uint32_t	fReserved;
+	uint64_t	fIndexOffset;	///< @brief	File offset to the frame index
+} NTV2SDRAMDumpHeader;
+
+typedef struct NTV2SDRAMDumpFrameInfo
+{
+	uint64_t	fOffset;		///< @brief	File offset to the frame's payload
+	uint32_t	fEncodedBytes;	///< @brief	Size of the frame's payload, in bytes
+	uint32_t	fEncoding;		///< @brief	An NTV2SDRAMDumpEncoding
+	uint32_t	fFillValue;		///< @brief	Fill value (NTV2SDRAMDumpEncoding_Fill only)
+	uint32_t	fReserved;
+} NTV2SDRAMDumpFrameInfo;
+
+/**
+	@brief		Encodes one frame for a compact SDRAM dump. Frames that are a single repeated 32-bit value
+				(e.g. all zeroes) are elided entirely. Otherwise the frame is run-length encoded, unless that
+				wouldn't make it smaller, in which case it's stored raw.
+	@param[in]	inFrame			The frame to encode. Its size must be a multiple of 4 bytes.
+	@param		outEncoded		Receives the payload, unless it's stored raw (in which case inFrame is the payload).
+								Must be at least as large as inFrame.
+	@param[out]	outInfo			Receives the encoding, payload size and fill value (but not the file offset).
+	@return		True if successful;  otherwise false.
+**/
+AJAExport bool NTV2EncodeSDRAMDumpFrame (const NTV2Buffer & inFrame, NTV2Buffer & outEncoded, NTV2SDRAMDumpFrameInfo & outInfo);
+
+/**
+	@brief		Decodes one frame of a compact SDRAM dump.
+	@param[in]	inInfo			The frame's index record.
+	@param[in]	pInPayload		The frame's payload (may be NULL if there is none).
+	@param[out]	pOutFrame		The frame to decode into.
+	@param[in]	inFrameBytes	The frame size, in bytes (see NTV2SDRAMDumpHeader::fFrameBytes).
+	@return		True if successful;  otherwise false.
+**/
+AJAExport bool NTV2DecodeSDRAMDumpFrame (const NTV2SDRAMDumpFrameInfo & inInfo, const void * pInPayload, void * pOutFrame, const size_t inFrameBytes);
+
+/**
+	@brief	Register snapshots (see CNTV2SupportLogger::WriteRegisterSnapshot) are compact, line-oriented text:
+			a first line of NTV2_REGSNAPSHOT_MAGIC followed by NTV2_REGSNAPSHOT_VERSION, a few "Key: value" lines
+			(including "Device: <name>" and "DeviceID: <hex>"), then a "Registers: <count>" section and a
+			"VirtualRegisters: <count>" section, each with one "<decimal regNum> 0x<hex value>" line per register,
+			and a final "End" line.
+**/
+#define	NTV2_REGSNAPSHOT_MAGIC		"NTV2 Register Snapshot"
+#define	NTV2_REGSNAPSHOT_VERSION	1
+
 /**
 	@brief	Generates a standard support log (register log) for any NTV2 device attached to the host.
 			To write the log into a file, open a std::ofstream, then stream this object into it.
@@ -87,6 +155,23 @@ public:
 	**/
 	virtual void		ToString			(std::string & outString) const;
 
+	/**
+		@brief		Writes a register snapshot of my device (see NTV2_REGSNAPSHOT_MAGIC) into the given stream.
+					The device and virtual registers are each fetched with one batched read (concurrently,
+					unless the device is remote), and the snapshot is written in one go.
+		@param		outStream	Receives the snapshot.
+		@return		True if successful;  otherwise false.
+	**/
+	virtual bool		WriteRegisterSnapshot	(std::ostream & outStream) const;
+
+	/**
+		@brief		Restores my device's video, audio and routing registers from a support log or a register
+					snapshot. The file is read in a single pass, and the registers are written with a single
+					CNTV2Card::WriteRegisters call.
+		@param[in]	inLogFilePath	Path to the support log or register snapshot file.
+		@param[in]	bForceLoad		If true, loads the registers even if they came from a different kind of device.
+		@return		True if successful;  otherwise false.
+	**/
 	virtual bool		LoadFromLog			(const std::string & inLogFilePath, const bool bForceLoad);
 
 
@@ -110,9 +195,19 @@ public:
 	static std::string	InventLogFilePathAndName (CNTV2Card & inDevice,
 													std::string inPrefix = "aja_supportlog",
 													std::string inExtension = "log");	//	New in SDK 16.0
+	/**
+		@brief		Dumps the device's entire SDRAM into a file. Device reads are overlapped with file writes.
+		@param		inDevice	The device to dump.
+		@param[in]	inFilePath	Path to the file to be written.
+		@param		msgStream	Receives progress and error messages.
+		@param[in]	inCompact	If true, writes a compact dump (see NTV2SDRAMDumpHeader) instead of a raw one.
+								Defaults to false.
+		@return		True if successful;  otherwise false.
+	**/
 	static bool			DumpDeviceSDRAM (CNTV2Card & inDevice,
 										const std::string & inFilePath,
-										std::ostream & msgStream);	//	New in SDK 16.0
+										std::ostream & msgStream,
+										const bool inCompact = false);	//	New in SDK 16.0
 };	//	CNTV2SupportLogger
 
 
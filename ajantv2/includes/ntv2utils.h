@@ -395,7 +395,7 @@ AJAExport NTV2_SHOULD_BE_DEPRECATED(bool NTV2DeviceCanDoFormat (const NTV2Device
 			This is useful since AJA devices use fixed audio sample rates (typically 48KHz), and some video frame
 			rates will necessarily result in some frames having more audio samples than others.
 	@param[in]	inFrameRate			Specifies the video frame rate.
-	@param[in]	inAudioRate			Specifies the audio sample rate. Must be one of NTV2_AUDIO_48K or NTV2_AUDIO_96K.
+	@param[in]	inAudioRate			Specifies the audio sample rate (NTV2_AUDIO_48K, NTV2_AUDIO_96K or NTV2_AUDIO_192K).
 	@param[in]	inCadenceFrame		Optionally specifies a frame number for maintaining proper cadence in a frame sequence,
 									for those video frame rates that don't accommodate an even number of audio samples.
 									Defaults to zero.
@@ -406,7 +406,18 @@ AJAExport NTV2_SHOULD_BE_DEPRECATED(bool NTV2DeviceCanDoFormat (const NTV2Device
 	@see	See \ref audiosamplecount
 **/
 AJAExport ULWord				GetAudioSamplesPerFrame (const NTV2FrameRate inFrameRate, const NTV2AudioRate inAudioRate, ULWord inCadenceFrame = 0, bool inIsSMPTE372Enabled = false);
-AJAExport LWord64				GetTotalAudioSamplesFromFrameNbrZeroUpToFrameNbr (NTV2FrameRate frameRate, NTV2AudioRate audioRate, ULWord frameNbrNonInclusive);
+/**
+	@brief	Returns the total number of audio samples from frame zero up to (but not including) the given frame number.
+			This always equals the sum of ::GetAudioSamplesPerFrame over those frames, and is exact for any frame count.
+	@param[in]	frameRate				Specifies the video frame rate.
+	@param[in]	audioRate				Specifies the audio sample rate.
+	@param[in]	frameNbrNonInclusive	Specifies the ending frame number (non-inclusive).
+	@param[in]	inIsSMPTE372Enabled		Specifies that 1080p60, 1080p5994 or 1080p50 is being used (see ::GetAudioSamplesPerFrame).
+										Defaults to false.
+	@return The total number of audio samples, or zero for unknown frame or audio rates.
+	@see	See \ref audiosamplecount
+**/
+AJAExport LWord64				GetTotalAudioSamplesFromFrameNbrZeroUpToFrameNbr (NTV2FrameRate frameRate, NTV2AudioRate audioRate, ULWord frameNbrNonInclusive, bool inIsSMPTE372Enabled = false);
 
 /**
 	@brief	Returns the audio sample rate as a number of audio samples per second.
@@ -119,6 +119,7 @@ bool CNTV2LinuxDriverInterface::CloseLocalPhysical (void)
 
 bool CNTV2LinuxDriverInterface::ReadRegister (const ULWord inRegNum,  ULWord & outValue,  const ULWord inMask,	const ULWord inShift)
 {
+	NTV2_PROFILE_ACCESS(NTV2AccessKind_ReadRegister, inRegNum);
 	if (inShift >= 32)
 	{
 		LDIFAIL("Shift " << DEC(inShift) << " > 31, reg=" << DEC(inRegNum) << " msk=" << xHEX0N(inMask,8));
@@ -147,6 +148,7 @@ bool CNTV2LinuxDriverInterface::ReadRegister (const ULWord inRegNum,  ULWord & o
 
 bool CNTV2LinuxDriverInterface::WriteRegister (const ULWord inRegNum,  const ULWord inValue,  const ULWord inMask, const ULWord inShift)
 {
+	NTV2_PROFILE_ACCESS(NTV2AccessKind_WriteRegister, inRegNum);
 	if (inShift >= 32)
 	{
 		LDIFAIL("Shift " << DEC(inShift) << " > 31, reg=" << DEC(inRegNum) << " msk=" << xHEX0N(inMask,8));
@@ -598,6 +600,7 @@ bool CNTV2LinuxDriverInterface::DmaTransfer (	const NTV2DMAEngine inDMAEngine,
 												const ULWord		inByteCount,
 												const bool			inSynchronous)
 {
+	NTV2_PROFILE_ACCESS(NTV2AccessKind_DMATransfer, inDMAEngine);
 	if (IsRemote())
 		return CNTV2DriverInterface::DmaTransfer(inDMAEngine, inIsRead, inFrameNumber, pFrameBuffer,
 												inOffsetBytes, inByteCount, inSynchronous);
@@ -685,6 +688,10 @@ bool CNTV2LinuxDriverInterface::DmaTransfer (const NTV2DMAEngine	inDMAEngine,
 											const ULWord			inCardPitch,
 											const bool				inIsSynchronous)
 {
+	NTV2_PROFILE_ACCESS(NTV2AccessKind_DMATransfer, inDMAEngine);
+	if (IsRemote())
+		return CNTV2DriverInterface::DmaTransfer (inDMAEngine, inIsRead, inFrameNumber, pFrameBuffer, inOffsetBytes, inByteCount,
+													inNumSegments, inHostPitch, inCardPitch, inIsSynchronous);
 	if (!IsOpen())
 		return false;
 
@@ -770,6 +777,7 @@ bool CNTV2LinuxDriverInterface::DmaTransfer (	const NTV2DMAEngine			inDMAEngine,
 												const ULWord				inSegmentCardPitch,
 												const PCHANNEL_P2P_STRUCT & inP2PData)
 {
+	NTV2_PROFILE_ACCESS(NTV2AccessKind_DMATransfer, inDMAEngine);
 	if (!IsOpen())
 		return false;
 	if (IsRemote())
@@ -831,6 +839,7 @@ bool CNTV2LinuxDriverInterface::DmaTransfer (	const NTV2DMAEngine			inDMAEngine,
 // AutoCirculate
 bool CNTV2LinuxDriverInterface::AutoCirculate (AUTOCIRCULATE_DATA & autoCircData)
 {
+	NTV2_PROFILE_ACCESS(NTV2AccessKind_AutoCirculate, autoCircData.eCommand);
 	if (IsRemote())
 		return CNTV2DriverInterface::AutoCirculate(autoCircData);
 	if (!IsOpen())
@@ -1062,6 +1071,7 @@ bool CNTV2LinuxDriverInterface::NTV2Message (NTV2_HEADER * pInMessage)
 {
 	if (!pInMessage)
 		return false;	//	NULL message pointer
+	NTV2_PROFILE_ACCESS(NTV2AccessKind_Message, pInMessage->GetType());
 
 	if (IsRemote())
 		return CNTV2DriverInterface::NTV2Message(pInMessage);	//	Implement NTV2Message on nub
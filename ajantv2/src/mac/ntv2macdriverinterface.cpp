@@ -388,6 +388,7 @@ CNTV2MacDriverInterface::~CNTV2MacDriverInterface (void)
 //--------------------------------------------------------------------------------------------------------------------
 bool CNTV2MacDriverInterface::ReadRegister (const ULWord inRegNum, ULWord & outValue, const ULWord inMask, const ULWord inShift)
 {
+	NTV2_PROFILE_ACCESS(NTV2AccessKind_ReadRegister, inRegNum);
 	if (inShift >= 32)
 	{
 		DIFAIL("Shift " << DEC(inShift) << " > 31, reg=" << DEC(inRegNum) << " msk=" << xHEX0N(inMask,8));
@@ -429,6 +430,7 @@ bool CNTV2MacDriverInterface::ReadRegister (const ULWord inRegNum, ULWord & outV
 //--------------------------------------------------------------------------------------------------------------------
 bool CNTV2MacDriverInterface::WriteRegister (const ULWord inRegNum, const ULWord inValue, const ULWord inMask, const ULWord inShift)
 {
+	NTV2_PROFILE_ACCESS(NTV2AccessKind_WriteRegister, inRegNum);
 	if (inShift >= 32)
 	{
 		DIFAIL("Shift " << DEC(inShift) << " > 31, reg=" << DEC(inRegNum) << " msk=" << xHEX0N(inMask,8));
@@ -790,6 +792,7 @@ bool CNTV2MacDriverInterface::DmaTransfer ( const NTV2DMAEngine inDMAEngine,
 											const ULWord		inByteCount,
 											const bool			inSynchronous)
 {
+	NTV2_PROFILE_ACCESS(NTV2AccessKind_DMATransfer, inDMAEngine);
 	if (IsRemote())
 		return CNTV2DriverInterface::DmaTransfer(inDMAEngine, inIsRead, inFrameNumber, pFrameBuffer,
 												inOffsetBytes, inByteCount, inSynchronous);
@@ -838,6 +841,7 @@ bool CNTV2MacDriverInterface::DmaTransfer ( const NTV2DMAEngine inDMAEngine,
 											const ULWord inSegmentCardPitch,
 											const bool inSynchronous)
 {
+	NTV2_PROFILE_ACCESS(NTV2AccessKind_DMATransfer, inDMAEngine);
 	if (IsRemote())
 		return CNTV2DriverInterface::DmaTransfer (inDMAEngine, inIsRead, inFrameNumber, pFrameBuffer, inCardOffsetBytes, inByteCount,
 													inNumSegments, inSegmentHostPitch, inSegmentCardPitch, inSynchronous);
@@ -888,6 +892,7 @@ bool CNTV2MacDriverInterface::DmaTransfer ( const NTV2DMAEngine			inDMAEngine,
 											const ULWord				inSegmentCardPitch,
 											const PCHANNEL_P2P_STRUCT & inP2PData)
 {
+	NTV2_PROFILE_ACCESS(NTV2AccessKind_DMATransfer, inDMAEngine);
 	if (IsRemote())
 		return CNTV2DriverInterface::DmaTransfer (inDMAEngine, inDMAChannel, inIsTarget, inFrameNumber, inCardOffsetBytes, inByteCount,
 													inNumSegments, inSegmentHostPitch, inSegmentCardPitch, inP2PData);
@@ -945,6 +950,7 @@ bool CNTV2MacDriverInterface::SystemStatus ( void* dataPtr, SystemStatusCode sta
 //--------------------------------------------------------------------------------------------------------------------
 bool CNTV2MacDriverInterface::AutoCirculate (AUTOCIRCULATE_DATA & autoCircData)
 {
+	NTV2_PROFILE_ACCESS(NTV2AccessKind_AutoCirculate, autoCircData.eCommand);
 	bool success = true;
 	if (IsRemote())
 		return CNTV2DriverInterface::AutoCirculate(autoCircData);
@@ -1091,6 +1097,7 @@ bool CNTV2MacDriverInterface::NTV2Message (NTV2_HEADER * pInOutMessage)
 {
 	if (!pInOutMessage)
 		return false;
+	NTV2_PROFILE_ACCESS(NTV2AccessKind_Message, pInOutMessage->GetType());
 	if (!pInOutMessage->IsValid())
 		return false;
 	if (!pInOutMessage->GetSizeInBytes())
@@ -0,0 +1,234 @@
+/* SPDX-License-Identifier: MIT */
+/**
+	@file		ntv2accessprofiler.cpp
+	@brief		Implements the NTV2AccessProfiler class.
+	@copyright	(C) 2023 AJA Video Systems, Inc.
+**/
+
+#include "ntv2accessprofiler.h"
+#include "ntv2registerexpert.h"
+#include "ntv2utils.h"
+#include "ajabase/common/common.h"
+#include "ajabase/system/atomic.h"
+#include <algorithm>
+#include <iomanip>
+#include <sstream>
+#if defined(AJA_LINUX) || defined(AJA_MAC)
+	#include <dlfcn.h>
+	#include <cxxabi.h>
+	#include <cstdlib>
+#endif
+
+using namespace std;
+
+
+string NTV2AccessKindToString (const NTV2AccessKind inKind)
+{
+	switch (inKind)
+	{
+		case NTV2AccessKind_ReadRegister:	return "ReadRegister";
+		case NTV2AccessKind_WriteRegister:	return "WriteRegister";
+		case NTV2AccessKind_DMATransfer:	return "DMATransfer";
+		case NTV2AccessKind_AutoCirculate:	return "AutoCirculate";
+		case NTV2AccessKind_Message:		return "NTV2Message";
+		case NTV2AccessKind_Invalid:		break;
+	}
+	return "???";
+}
+
+static string CallerName (const void * pInCaller)
+{
+	if (!pInCaller)
+		return "";
+#if defined(AJA_LINUX) || defined(AJA_MAC)
+	Dl_info info;
+	if (::dladdr(pInCaller, &info)  &&  info.dli_sname)
+	{
+		int status(-1);
+		char * pDemangled (abi::__cxa_demangle(info.dli_sname, AJA_NULL, AJA_NULL, &status));
+		string result (status == 0 && pDemangled ? pDemangled : info.dli_sname);
+		::free(pDemangled);
+		return result;
+	}
+#endif	//	AJA_LINUX or AJA_MAC
+	ostringstream oss;  oss << xHEX0N(uint64_t(pInCaller),16);
+	return oss.str();
+}
+
+
+NTV2AccessProfileEntry::NTV2AccessProfileEntry ()
+	:	fKind			(NTV2AccessKind_Invalid),
+		fKey			(0),
+		fCaller			(AJA_NULL),
+		fCallerName		(),
+		fCalls			(0),
+		fTotalMicrosecs	(0),
+		fMaxMicrosecs	(0)
+{
+}
+
+string NTV2AccessProfileEntry::KeyName (void) const
+{
+	ostringstream oss;
+	switch (fKind)
+	{
+		case NTV2AccessKind_ReadRegister:
+		case NTV2AccessKind_WriteRegister:	oss << CNTV2RegisterExpert::GetDisplayName(fKey);							break;
+		case NTV2AccessKind_DMATransfer:	oss << "DMA" << DEC(fKey - NTV2_DMA1 + 1);									break;
+		case NTV2AccessKind_AutoCirculate:	oss << "cmd " << DEC(fKey);													break;
+		case NTV2AccessKind_Message:		oss << NTV2_HEADER::FourCCToString(fKey);									break;
+		case NTV2AccessKind_Invalid:		break;
+	}
+	return oss.str();
+}
+
+ostream & NTV2AccessProfileEntry::Print (ostream & oss) const
+{
+	oss << setw(13) << left << ::NTV2AccessKindToString(fKind) << " "
+		<< setw(10) << right << fCalls << " calls " << setw(10) << right << fTotalMicrosecs << "us total "
+		<< setw(7) << right << AverageMicrosecs() << "us avg " << setw(7) << right << fMaxMicrosecs << "us max  ";
+	if (fCaller)
+		oss << (fCallerName.empty() ? CallerName(fCaller) : fCallerName);
+	else
+		oss << DEC(fKey) << " " << KeyName();
+	return oss;
+}
+
+
+ULWord64 NTV2AccessProfile::TotalCalls (const NTV2AccessKind inKind) const
+{
+	ULWord64 result(0);
+	for (NTV2AccessProfileEntriesConstIter it(fByKey.begin());  it != fByKey.end();  ++it)
+		if (inKind == NTV2AccessKind_Invalid  ||  it->fKind == inKind)
+			result += it->fCalls;
+	return result;
+}
+
+ostream & NTV2AccessProfile::Print (ostream & oss, const size_t inMaxEntries) const
+{
+	oss << "Access profile over " << DEC(fMicrosecs / 1000) << "ms: " << DEC(TotalCalls()) << " calls ("
+		<< DEC(TotalCalls(NTV2AccessKind_ReadRegister)) << " reads, " << DEC(TotalCalls(NTV2AccessKind_WriteRegister)) << " writes, "
+		<< DEC(TotalCalls(NTV2AccessKind_DMATransfer)) << " DMAs, " << DEC(TotalCalls(NTV2AccessKind_AutoCirculate)) << " AutoCirculates, "
+		<< DEC(TotalCalls(NTV2AccessKind_Message)) << " messages)";
+	if (fDropped)
+		oss << ", " << DEC(fDropped) << " not tallied (table full)";
+	oss << endl << "By register/engine/command/message:" << endl;
+	for (size_t ndx(0);  ndx < fByKey.size()  &&  (!inMaxEntries || ndx < inMaxEntries);  ndx++)
+		oss << "  " << fByKey.at(ndx) << endl;
+	oss << "By call site:" << endl;
+	for (size_t ndx(0);  ndx < fByCaller.size()  &&  (!inMaxEntries || ndx < inMaxEntries);  ndx++)
+		oss << "  " << fByCaller.at(ndx) << endl;
+	return oss;
+}
+
+
+NTV2AccessProfiler::NTV2AccessProfiler ()
+	:	mByKey		(kNumSlots),
+		mByCaller	(kNumSlots),
+		mDropped	(0),
+		mStartUs	(0)
+{
+	Reset();
+}
+
+void NTV2AccessProfiler::Reset (void)
+{
+	AJAAutoLock lock(&mLock);
+	for (size_t ndx(0);  ndx < kNumSlots;  ndx++)
+	{	//	Keys stay claimed, so Records in flight still tally against the right key
+		Slot * pSlots[2] = {&mByKey[ndx], &mByCaller[ndx]};
+		for (size_t tbl(0);  tbl < 2;  tbl++)
+		{
+			AJAAtomic::Exchange(&pSlots[tbl]->fCalls, uint64_t(0));
+			AJAAtomic::Exchange(&pSlots[tbl]->fTotalUs, uint64_t(0));
+			AJAAtomic::Exchange(&pSlots[tbl]->fMaxUs, uint64_t(0));
+		}
+	}
+	AJAAtomic::Exchange(&mDropped, uint64_t(0));
+	mStartUs = AJATime::GetSystemMicroseconds();
+}
+
+bool NTV2AccessProfiler::Tally (Slot * pTable, const uint64_t inKey, const ULWord64 inMicrosecs)
+{
+	static const size_t kMaxProbes (64);
+	size_t ndx (size_t((inKey * 0x9E3779B97F4A7C15ULL) >> 32) & (kNumSlots - 1));
+	for (size_t probe(0);  probe < kMaxProbes;  probe++,  ndx = (ndx + 1) & (kNumSlots - 1))
+	{
+		Slot & slot (pTable[ndx]);
+		if (slot.fKey != inKey)
+		{
+			if (slot.fKey)
+				continue;	//	Taken by another key
+			const uint64_t prevKey (AJAAtomic::CompareAndSwap(&slot.fKey, 0, inKey));
+			if (prevKey  &&  prevKey != inKey)
+				continue;	//	Lost the race to another key
+		}
+		AJAAtomic::Increment(&slot.fCalls);
+		AJAAtomic::Add(&slot.fTotalUs, inMicrosecs);
+		for (uint64_t prevMax(slot.fMaxUs);  inMicrosecs > prevMax;  )
+		{
+			const uint64_t was (AJAAtomic::CompareAndSwap(&slot.fMaxUs, prevMax, inMicrosecs));
+			if (was == prevMax)
+				break;
+			prevMax = was;
+		}
+		return true;
+	}
+	return false;
+}
+
+//	Per-key slots are keyed by (kind+1) << 32 | key.  Per-caller slots are keyed by caller address * 8 + kind + 1.
+
+void NTV2AccessProfiler::Record (const NTV2AccessKind inKind, const ULWord inKey, const void * pInCaller, const ULWord64 inMicrosecs)
+{
+	if (!Tally(&mByKey[0], (uint64_t(inKind) + 1) << 32 | uint64_t(inKey), inMicrosecs))
+		AJAAtomic::Increment(&mDropped);
+	if (pInCaller)
+		if (!Tally(&mByCaller[0], uint64_t(reinterpret_cast<uintptr_t>(pInCaller)) * 8 + uint64_t(inKind) + 1, inMicrosecs))
+			AJAAtomic::Increment(&mDropped);
+}
+
+static bool EntryHasMoreCalls (const NTV2AccessProfileEntry & inLHS, const NTV2AccessProfileEntry & inRHS)
+{
+	return inLHS.fCalls != inRHS.fCalls  ?  inLHS.fCalls > inRHS.fCalls  :  inLHS.fTotalMicrosecs > inRHS.fTotalMicrosecs;
+}
+
+void NTV2AccessProfiler::GetProfile (NTV2AccessProfile & outProfile) const
+{
+	outProfile = NTV2AccessProfile();
+	{	AJAAutoLock lock(&mLock);	//	Copy out raw tallies & addresses...
+		for (size_t ndx(0);  ndx < kNumSlots;  ndx++)
+		{
+			const Slot & slot (mByKey.at(ndx));
+			if (!slot.fKey  ||  !slot.fCalls)
+				continue;
+			NTV2AccessProfileEntry entry;
+			entry.fKind				= NTV2AccessKind((slot.fKey >> 32) - 1);
+			entry.fKey				= ULWord(slot.fKey & 0xFFFFFFFF);
+			entry.fCalls			= slot.fCalls;
+			entry.fTotalMicrosecs	= slot.fTotalUs;
+			entry.fMaxMicrosecs		= slot.fMaxUs;
+			outProfile.fByKey.push_back(entry);
+		}
+		for (size_t ndx(0);  ndx < kNumSlots;  ndx++)
+		{
+			const Slot & slot (mByCaller.at(ndx));
+			if (!slot.fKey  ||  !slot.fCalls)
+				continue;
+			NTV2AccessProfileEntry entry;
+			entry.fKind				= NTV2AccessKind((slot.fKey - 1) & 7);
+			entry.fCaller			= reinterpret_cast<const void*>(uintptr_t((slot.fKey - 1) >> 3));
+			entry.fCalls			= slot.fCalls;
+			entry.fTotalMicrosecs	= slot.fTotalUs;
+			entry.fMaxMicrosecs		= slot.fMaxUs;
+			outProfile.fByCaller.push_back(entry);
+		}
+		outProfile.fDropped = mDropped;
+		outProfile.fMicrosecs = AJATime::GetSystemMicroseconds() - mStartUs;
+	}
+	//	...then symbolize them (dladdr & demangling are slow) without holding the lock
+	for (size_t ndx(0);  ndx < outProfile.fByCaller.size();  ndx++)
+		outProfile.fByCaller[ndx].fCallerName = CallerName(outProfile.fByCaller[ndx].fCaller);
+	std::sort(outProfile.fByKey.begin(), outProfile.fByKey.end(), EntryHasMoreCalls);
+	std::sort(outProfile.fByCaller.begin(), outProfile.fByCaller.end(), EntryHasMoreCalls);
+}
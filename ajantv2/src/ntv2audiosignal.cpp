@@ -0,0 +1,651 @@
+/* SPDX-License-Identifier: MIT */
+/**
+	@file		ntv2audiosignal.cpp
+	@brief		Implements the CNTV2AudioSignalGenerator and CNTV2AudioMeter classes.
+	@copyright	(C) 2023 AJA Video Systems, Inc.
+**/
+
+#include "ntv2audiosignal.h"
+#include "ntv2endian.h"
+#include "ntv2utils.h"
+#include "ajabase/system/debug.h"
+#include <cmath>
+#include <string.h>
+#if defined(AJA_HAS_SSE2)
+	#include <emmintrin.h>
+#endif
+
+using namespace std;
+
+#define ASFAIL(__x__)	AJA_sERROR	(AJA_DebugUnit_AudioGeneric, AJAFUNC << ": " << __x__)
+
+static const double	kPi					(3.14159265358979323846);
+static const double	kTwoTo32			(4294967296.0);
+static const ULWord	kMaxChannels		(128);
+static const ULWord	kChunkSamples		(1024);		//	Samples (per channel) processed per pass
+static const ULWord	kSineTableBits		(12);		//	4096-entry sine table
+static const ULWord	kSineTableSize		(1 << kSineTableBits);
+static const ULWord	kSineFracBits		(32 - kSineTableBits);
+static const float	kFullScale			(2147483648.0f);
+static const float	kMaxSample			(2147483520.0f);	//	Largest float below 2^31
+static const float	kPinkGain			(0.2f);
+
+
+string NTV2AudioSignalToString (const NTV2AudioSignal inSignal, const bool inCompact)
+{
+	switch (inSignal)
+	{
+		case NTV2_AUDIO_SIGNAL_SILENCE:		return inCompact ? "silence"	: "NTV2_AUDIO_SIGNAL_SILENCE";
+		case NTV2_AUDIO_SIGNAL_TONE:		return inCompact ? "tone"		: "NTV2_AUDIO_SIGNAL_TONE";
+		case NTV2_AUDIO_SIGNAL_SWEEP:		return inCompact ? "sweep"		: "NTV2_AUDIO_SIGNAL_SWEEP";
+		case NTV2_AUDIO_SIGNAL_WHITE_NOISE:	return inCompact ? "white"		: "NTV2_AUDIO_SIGNAL_WHITE_NOISE";
+		case NTV2_AUDIO_SIGNAL_PINK_NOISE:	return inCompact ? "pink"		: "NTV2_AUDIO_SIGNAL_PINK_NOISE";
+		case NTV2_AUDIO_SIGNAL_INVALID:		break;
+	}
+	return inCompact ? "???" : "NTV2_AUDIO_SIGNAL_INVALID";
+}
+
+
+/////////////////////////////////////////////////////////////////////////////////
+//	CNTV2AudioSignalGenerator
+
+//	One cycle of sine, plus the difference to the next entry (for linear interpolation)
+typedef struct SineTable
+{
+	float	fValue[kSineTableSize];
+	float	fDelta[kSineTableSize];
+	SineTable ()
+	{
+		for (ULWord ndx(0);  ndx < kSineTableSize;  ndx++)
+		{
+			const double value (::sin(2.0 * kPi * double(ndx) / double(kSineTableSize)));
+			const double next (::sin(2.0 * kPi * double(ndx + 1) / double(kSineTableSize)));
+			fValue[ndx] = float(value);
+			fDelta[ndx] = float(next - value);
+		}
+	}
+} SineTable;
+
+static const SineTable & GetSineTable (void)
+{
+	static const SineTable sTable;
+	return sTable;
+}
+
+static inline float SineAt (const SineTable & inTable, const ULWord inPhase)
+{
+	const ULWord	ndx		(inPhase >> kSineFracBits);
+	const float		frac	(float(inPhase & ((1 << kSineFracBits) - 1)) * (1.0f / float(1 << kSineFracBits)));
+	return inTable.fValue[ndx] + inTable.fDelta[ndx] * frac;
+}
+
+static inline float NextNoise (ULWord & inOutState)	//	xorshift32, scaled to [-1, 1)
+{
+	ULWord x (inOutState);
+	x ^= x << 13;	x ^= x >> 17;	x ^= x << 5;
+	inOutState = x;
+	return float(LWord(x)) * (1.0f / kFullScale);
+}
+
+//	Converts float samples (full scale == 1.0) to 32-bit samples, rounding half away from zero, clipping and
+//	optionally byte-swapping them
+static void ConvertSamples (const float * pIn, ULWord * pOut, const ULWord inCount, const bool inByteSwap, const bool inUseSIMD)
+{
+	ULWord ndx(0);
+#if defined(AJA_HAS_SSE2)
+	if (inUseSIMD)
+	{
+		const __m128	scale	(_mm_set1_ps(kFullScale));
+		const __m128	lo		(_mm_set1_ps(-kFullScale));
+		const __m128	hi		(_mm_set1_ps(kMaxSample));
+		const __m128	half	(_mm_set1_ps(0.5f));
+		const __m128	sign	(_mm_castsi128_ps(_mm_set1_epi32(int(0x80000000))));
+		const __m128i	mask2	(_mm_set1_epi32(0x00FF0000));
+		const __m128i	mask1	(_mm_set1_epi32(0x0000FF00));
+		for (;  ndx + 4 <= inCount;  ndx += 4)
+		{
+			__m128 v (_mm_mul_ps(_mm_loadu_ps(pIn + ndx), scale));
+			v = _mm_min_ps(_mm_max_ps(v, lo), hi);
+			v = _mm_add_ps(v, _mm_or_ps(_mm_and_ps(v, sign), half));
+			__m128i s (_mm_cvttps_epi32(v));
+			if (inByteSwap)
+				s = _mm_or_si128(_mm_or_si128(_mm_slli_epi32(s, 24), _mm_srli_epi32(s, 24)),
+								 _mm_or_si128(_mm_and_si128(_mm_slli_epi32(s, 8), mask2), _mm_and_si128(_mm_srli_epi32(s, 8), mask1)));
+			_mm_storeu_si128(reinterpret_cast<__m128i*>(pOut + ndx), s);
+		}
+	}
+#else
+	AJA_UNUSED(inUseSIMD);
+#endif	//	AJA_HAS_SSE2
+	for (;  ndx < inCount;  ndx++)
+	{
+		float v (pIn[ndx] * kFullScale);
+		v = v < -kFullScale ? -kFullScale : (v > kMaxSample ? kMaxSample : v);
+		v = v + (v < 0.0f ? -0.5f : 0.5f);
+		const ULWord s = ULWord(LWord(v));
+		pOut[ndx] = inByteSwap ? NTV2EndianSwap32(s) : s;
+	}
+}
+
+
+CNTV2AudioSignalGenerator::CNTV2AudioSignalGenerator (const ULWord inNumChannels, const double inSampleRate)
+	:	mSampleRate	(inSampleRate > 0.0 ? inSampleRate : 48000.0),
+		mUseSIMD	(HasSIMD())
+{
+	const ULWord numChannels (inNumChannels < 1 ? 1 : (inNumChannels > kMaxChannels ? kMaxChannels : inNumChannels));
+	mChannels.resize(numChannels);
+	for (ULWord chan(0);  chan < numChannels;  chan++)
+	{
+		mChannels[chan].fSignal = NTV2_AUDIO_SIGNAL_SILENCE;
+		mChannels[chan].fAmplitude = 0.0f;
+		mChannels[chan].fIncrement = 0;
+		mChannels[chan].fSweepStartInc = mChannels[chan].fSweepRatio = 0.0;
+		mChannels[chan].fSweepLength = 1;
+		ResetChannel(chan);
+	}
+	GetSineTable();	//	Build it now, rather than in Generate
+}
+
+CNTV2AudioSignalGenerator::~CNTV2AudioSignalGenerator ()
+{
+}
+
+bool CNTV2AudioSignalGenerator::HasSIMD (void)
+{
+#if defined(AJA_HAS_SSE2)
+	return true;
+#else
+	return false;
+#endif
+}
+
+void CNTV2AudioSignalGenerator::ResetChannel (const ULWord inChannel)
+{
+	ChannelState & state (mChannels[inChannel]);
+	state.fPhase = 0;
+	state.fSweepInc = state.fSweepStartInc;
+	state.fSweepPos = 0;
+	state.fNoiseState = 0x9E3779B9u * (inChannel + 1);	//	Different (non-zero) seed per channel
+	state.fPink[0] = state.fPink[1] = state.fPink[2] = 0.0f;
+}
+
+bool CNTV2AudioSignalGenerator::SetChannelSignal (const ULWord inChannel, const NTV2AudioSignal inSignal, const double inAmplitude,
+												const double inFrequency, const double inEndFrequency, const double inSweepSeconds)
+{
+	if (inChannel >= GetNumChannels())
+		{ASFAIL("Invalid channel " << DEC(inChannel) << " -- must be less than " << DEC(GetNumChannels()));  return false;}
+	if (!NTV2_IS_VALID_AUDIO_SIGNAL(inSignal))
+		{ASFAIL("Invalid signal " << DEC(inSignal));  return false;}
+	if (inAmplitude < 0.0  ||  inAmplitude > 1.0)
+		{ASFAIL("Amplitude " << inAmplitude << " out of range 0.0 thru 1.0");  return false;}
+	const bool periodic (inSignal == NTV2_AUDIO_SIGNAL_TONE  ||  inSignal == NTV2_AUDIO_SIGNAL_SWEEP);
+	if (periodic  &&  (inFrequency <= 0.0  ||  inFrequency >= mSampleRate / 2.0))
+		{ASFAIL("Frequency " << inFrequency << " Hz out of range for " << mSampleRate << " Hz sample rate");  return false;}
+	if (inSignal == NTV2_AUDIO_SIGNAL_SWEEP  &&  (inEndFrequency <= 0.0  ||  inEndFrequency >= mSampleRate / 2.0  ||  inSweepSeconds <= 0.0))
+		{ASFAIL("Sweep end frequency " << inEndFrequency << " Hz or duration " << inSweepSeconds << " secs out of range");  return false;}
+
+	ChannelState & state (mChannels[inChannel]);
+	state.fSignal = inSignal;
+	state.fAmplitude = float(inAmplitude);
+	state.fIncrement = periodic ? ULWord(inFrequency / mSampleRate * kTwoTo32 + 0.5) : 0;
+	state.fSweepStartInc = inFrequency / mSampleRate * kTwoTo32;
+	state.fSweepLength = ULWord(inSweepSeconds * mSampleRate + 0.5);
+	if (!state.fSweepLength)
+		state.fSweepLength = 1;
+	state.fSweepRatio = ::pow(inEndFrequency / inFrequency, 1.0 / double(state.fSweepLength));
+	ResetChannel(inChannel);
+	return true;
+}
+
+bool CNTV2AudioSignalGenerator::SetSignal (const NTV2AudioSignal inSignal, const double inAmplitude, const double inFrequency,
+											const double inEndFrequency, const double inSweepSeconds)
+{
+	for (ULWord chan(0);  chan < GetNumChannels();  chan++)
+		if (!SetChannelSignal(chan, inSignal, inAmplitude, inFrequency, inEndFrequency, inSweepSeconds))
+			return false;
+	return true;
+}
+
+void CNTV2AudioSignalGenerator::Reset (void)
+{
+	for (ULWord chan(0);  chan < GetNumChannels();  chan++)
+		ResetChannel(chan);
+}
+
+void CNTV2AudioSignalGenerator::GenerateChannel (ChannelState & inOutState, float * pOut, const ULWord inStride, const ULWord inNumSamples)
+{
+	const SineTable &	table		(GetSineTable());
+	const float			amplitude	(inOutState.fAmplitude);
+	switch (inOutState.fSignal)
+	{
+		case NTV2_AUDIO_SIGNAL_TONE:
+		{
+			ULWord phase (inOutState.fPhase);
+			const ULWord increment (inOutState.fIncrement);
+			for (ULWord ndx(0);  ndx < inNumSamples;  ndx++,  pOut += inStride,  phase += increment)
+				*pOut = SineAt(table, phase) * amplitude;
+			inOutState.fPhase = phase;
+			break;
+		}
+		case NTV2_AUDIO_SIGNAL_SWEEP:
+		{
+			ULWord phase (inOutState.fPhase),  pos (inOutState.fSweepPos);
+			double increment (inOutState.fSweepInc);
+			for (ULWord ndx(0);  ndx < inNumSamples;  ndx++,  pOut += inStride)
+			{
+				*pOut = SineAt(table, phase) * amplitude;
+				phase += ULWord(increment);
+				increment *= inOutState.fSweepRatio;
+				if (++pos >= inOutState.fSweepLength)
+					{pos = 0;  increment = inOutState.fSweepStartInc;}
+			}
+			inOutState.fPhase = phase;
+			inOutState.fSweepPos = pos;
+			inOutState.fSweepInc = increment;
+			break;
+		}
+		case NTV2_AUDIO_SIGNAL_WHITE_NOISE:
+			for (ULWord ndx(0);  ndx < inNumSamples;  ndx++,  pOut += inStride)
+				*pOut = NextNoise(inOutState.fNoiseState) * amplitude;
+			break;
+		case NTV2_AUDIO_SIGNAL_PINK_NOISE:
+		{
+			//	Paul Kellet's "economy" pink filter -- within 0.05 dB of -3 dB/octave above 9 Hz at 44.1 kHz
+			float b0 (inOutState.fPink[0]),  b1 (inOutState.fPink[1]),  b2 (inOutState.fPink[2]);
+			for (ULWord ndx(0);  ndx < inNumSamples;  ndx++,  pOut += inStride)
+			{
+				const float white (NextNoise(inOutState.fNoiseState));
+				b0 = 0.99765f * b0 + white * 0.0990460f;
+				b1 = 0.96300f * b1 + white * 0.2965164f;
+				b2 = 0.57000f * b2 + white * 1.0526913f;
+				*pOut = (b0 + b1 + b2 + white * 0.1848f) * kPinkGain * amplitude;
+			}
+			inOutState.fPink[0] = b0;  inOutState.fPink[1] = b1;  inOutState.fPink[2] = b2;
+			break;
+		}
+		case NTV2_AUDIO_SIGNAL_SILENCE:
+		case NTV2_AUDIO_SIGNAL_INVALID:
+			for (ULWord ndx(0);  ndx < inNumSamples;  ndx++,  pOut += inStride)
+				*pOut = 0.0f;
+			break;
+	}
+}
+
+bool CNTV2AudioSignalGenerator::Generate (NTV2Buffer & outBuffer, const ULWord inNumSamples, const bool inByteSwap)
+{
+	const ULWord numChannels (GetNumChannels());
+	if (outBuffer.IsNULL())
+		{ASFAIL("NULL buffer");  return false;}
+	if (outBuffer.GetByteCount() < uint64_t(inNumSamples) * numChannels * 4)
+		{ASFAIL("Buffer " << DEC(outBuffer.GetByteCount()) << " bytes smaller than " << DEC(inNumSamples) << " samples of "
+				<< DEC(numChannels) << " channels");  return false;}
+
+	mScratch.resize(kChunkSamples * numChannels);
+	ULWord * pOut (reinterpret_cast<ULWord*>(outBuffer.GetHostPointer()));
+	for (ULWord done(0);  done < inNumSamples;  )
+	{
+		const ULWord count (inNumSamples - done < kChunkSamples ? inNumSamples - done : kChunkSamples);
+		for (ULWord chan(0);  chan < numChannels;  chan++)
+			GenerateChannel(mChannels[chan], &mScratch[chan], numChannels, count);
+		ConvertSamples(&mScratch[0], pOut, count * numChannels, inByteSwap, mUseSIMD);
+		pOut += count * numChannels;
+		done += count;
+	}
+	return true;
+}
+
+
+/////////////////////////////////////////////////////////////////////////////////
+//	CNTV2AudioMeter
+
+//	ITU-R BS.1770-4 Annex 2 true-peak interpolator: 48 taps, 4 phases of 12
+static const float	kTruePeakTaps[4][12] =
+{
+	{ 0.0017089843750f,	 0.0109863281250f, -0.0196533203125f,  0.0332031250000f, -0.0594482421875f,  0.1373291015625f,
+	  0.9721679687500f, -0.1022949218750f,  0.0476074218750f, -0.0266113281250f,  0.0148925781250f, -0.0083007812500f},
+	{-0.0291748046875f,	 0.0292968750000f, -0.0517578125000f,  0.0891113281250f, -0.1665039062500f,  0.4650878906250f,
+	  0.7797851562500f, -0.2003173828125f,  0.1015625000000f, -0.0582275390625f,  0.0330810546875f, -0.0189208984375f},
+	{-0.0189208984375f,	 0.0330810546875f, -0.0582275390625f,  0.1015625000000f, -0.2003173828125f,  0.7797851562500f,
+	  0.4650878906250f, -0.1665039062500f,  0.0891113281250f, -0.0517578125000f,  0.0292968750000f, -0.0291748046875f},
+	{-0.0083007812500f,	 0.0148925781250f, -0.0266113281250f,  0.0476074218750f, -0.1022949218750f,  0.9721679687500f,
+	  0.1373291015625f, -0.0594482421875f,  0.0332031250000f, -0.0196533203125f,  0.0109863281250f,  0.0017089843750f}
+};
+
+static const ULWord	kNumShortTermBlocks	(30);		//	3 seconds of 100 ms sub-blocks
+static const double	kAbsoluteGate		(-70.0);	//	LUFS
+static const double	kRelativeGate		(-10.0);	//	LU
+static const ULWord	kNumGateBins		(800);		//	0.1 LU bins from -70 thru +10 LUFS
+
+//	Four-lane float vector operations -- SIMD, or a plain loop over the lanes. Both do the same single-precision
+//	operations in the same order, so they produce identical results.
+struct ScalarOps
+{
+	typedef struct {float f[4];} V;
+	static inline V		Load (const float * p)				{V v;  for (int n(0);  n < 4;  n++) v.f[n] = p[n];  return v;}
+	static inline void	Store (float * p, const V & v)		{for (int n(0);  n < 4;  n++) p[n] = v.f[n];}
+	static inline V		Splat (const float x)				{V v;  for (int n(0);  n < 4;  n++) v.f[n] = x;  return v;}
+	static inline V		Add (const V & a, const V & b)		{V v;  for (int n(0);  n < 4;  n++) v.f[n] = a.f[n] + b.f[n];  return v;}
+	static inline V		Sub (const V & a, const V & b)		{V v;  for (int n(0);  n < 4;  n++) v.f[n] = a.f[n] - b.f[n];  return v;}
+	static inline V		Mul (const V & a, const V & b)		{V v;  for (int n(0);  n < 4;  n++) v.f[n] = a.f[n] * b.f[n];  return v;}
+	static inline V		Max (const V & a, const V & b)		{V v;  for (int n(0);  n < 4;  n++) v.f[n] = a.f[n] > b.f[n] ? a.f[n] : b.f[n];  return v;}
+	static inline V		Abs (const V & a)					{V v;  for (int n(0);  n < 4;  n++) v.f[n] = ::fabs(a.f[n]);  return v;}
+	static inline V		LoadSamples (const ULWord * p, const bool inByteSwap)
+	{
+		V v;
+		for (int n(0);  n < 4;  n++)
+			v.f[n] = float(LWord(inByteSwap ? NTV2EndianSwap32(p[n]) : p[n])) * (1.0f / kFullScale);
+		return v;
+	}
+};
+
+#if defined(AJA_HAS_SSE2)
+struct SSE2Ops
+{
+	typedef __m128 V;
+	static inline V		Load (const float * p)				{return _mm_loadu_ps(p);}
+	static inline void	Store (float * p, const V & v)		{_mm_storeu_ps(p, v);}
+	static inline V		Splat (const float x)				{return _mm_set1_ps(x);}
+	static inline V		Add (const V & a, const V & b)		{return _mm_add_ps(a, b);}
+	static inline V		Sub (const V & a, const V & b)		{return _mm_sub_ps(a, b);}
+	static inline V		Mul (const V & a, const V & b)		{return _mm_mul_ps(a, b);}
+	static inline V		Max (const V & a, const V & b)		{return _mm_max_ps(a, b);}
+	static inline V		Abs (const V & a)					{return _mm_andnot_ps(_mm_castsi128_ps(_mm_set1_epi32(int(0x80000000))), a);}
+	static inline V		LoadSamples (const ULWord * p, const bool inByteSwap)
+	{
+		__m128i s (_mm_loadu_si128(reinterpret_cast<const __m128i*>(p)));
+		if (inByteSwap)
+			s = _mm_or_si128(_mm_or_si128(_mm_slli_epi32(s, 24), _mm_srli_epi32(s, 24)),
+							 _mm_or_si128(_mm_and_si128(_mm_slli_epi32(s, 8), _mm_set1_epi32(0x00FF0000)),
+										  _mm_and_si128(_mm_srli_epi32(s, 8), _mm_set1_epi32(0x0000FF00))));
+		return _mm_mul_ps(_mm_cvtepi32_ps(s), _mm_set1_ps(1.0f / kFullScale));
+	}
+};
+#endif	//	AJA_HAS_SSE2
+
+//	Meters inNumSamples samples of four channels (inLanes of which are real), each inStride ULWords apart
+template <class Ops>
+static void MeterGroup (CNTV2AudioMeter::GroupState & st, const ULWord * pIn, const ULWord inStride, const ULWord inLanes,
+						const ULWord inNumSamples, const bool inByteSwap, const float * pShelfB, const float * pShelfA, const float * pHighPassA)
+{
+	typedef typename Ops::V V;
+	V	taps[4][12];
+	for (int phase(0);  phase < 4;  phase++)
+		for (int tap(0);  tap < 12;  tap++)
+			taps[phase][tap] = Ops::Splat(kTruePeakTaps[phase][tap]);
+	const V	b0 (Ops::Splat(pShelfB[0])),  b1 (Ops::Splat(pShelfB[1])),  b2 (Ops::Splat(pShelfB[2]));
+	const V	a1 (Ops::Splat(pShelfA[0])),  a2 (Ops::Splat(pShelfA[1]));
+	const V	c1 (Ops::Splat(pHighPassA[0])),  c2 (Ops::Splat(pHighPassA[1])),  two (Ops::Splat(2.0f));
+	V	peak (Ops::Load(st.fPeak)),  truePeak (Ops::Load(st.fTruePeak)),  squares (Ops::Splat(0.0f)),  kSquares (Ops::Splat(0.0f));
+	V	x1 (Ops::Load(st.fX[0])),  x2 (Ops::Load(st.fX[1])),  s1 (Ops::Load(st.fS[0])),  s2 (Ops::Load(st.fS[1]));
+	V	y1 (Ops::Load(st.fY[0])),  y2 (Ops::Load(st.fY[1]));
+	ULWord	pos (st.fHistPos);
+	ULWord	partial[4] = {0, 0, 0, 0};
+
+	for (ULWord ndx(0);  ndx < inNumSamples;  ndx++,  pIn += inStride)
+	{
+		const ULWord * pSamples (pIn);
+		if (inLanes < 4)
+		{
+			for (ULWord lane(0);  lane < inLanes;  lane++)
+				partial[lane] = pIn[lane];
+			pSamples = partial;
+		}
+		const V x (Ops::LoadSamples(pSamples, inByteSwap));
+		peak = Ops::Max(peak, Ops::Abs(x));
+		squares = Ops::Add(squares, Ops::Mul(x, x));
+
+		//	K-weighting:  high-frequency shelf, then RLB high-pass (both direct form I)
+		const V s (Ops::Sub(Ops::Sub(Ops::Add(Ops::Add(Ops::Mul(b0, x), Ops::Mul(b1, x1)), Ops::Mul(b2, x2)), Ops::Mul(a1, s1)), Ops::Mul(a2, s2)));
+		const V y (Ops::Sub(Ops::Sub(Ops::Add(Ops::Sub(s, Ops::Mul(two, s1)), s2), Ops::Mul(c1, y1)), Ops::Mul(c2, y2)));
+		x2 = x1;  x1 = x;  s2 = s1;  s1 = s;  y2 = y1;  y1 = y;
+		kSquares = Ops::Add(kSquares, Ops::Mul(y, y));
+
+		//	True peak:  4x oversample with the 12-tap polyphase interpolator
+		pos = pos ? pos - 1 : 11;
+		Ops::Store(st.fHist[pos], x);
+		Ops::Store(st.fHist[pos + 12], x);
+		V hist[12];
+		for (int tap(0);  tap < 12;  tap++)
+			hist[tap] = Ops::Load(st.fHist[pos + tap]);
+		for (int phase(0);  phase < 4;  phase++)
+		{
+			V even (Ops::Mul(taps[phase][0], hist[0])),  odd (Ops::Mul(taps[phase][1], hist[1]));	//	Two chains, for latency
+			for (int tap(2);  tap < 12;  tap += 2)
+			{
+				even = Ops::Add(even, Ops::Mul(taps[phase][tap], hist[tap]));
+				odd = Ops::Add(odd, Ops::Mul(taps[phase][tap + 1], hist[tap + 1]));
+			}
+			truePeak = Ops::Max(truePeak, Ops::Abs(Ops::Add(even, odd)));
+		}
+	}
+
+	Ops::Store(st.fPeak, peak);			Ops::Store(st.fTruePeak, truePeak);
+	Ops::Store(st.fSquares, squares);	Ops::Store(st.fKSquares, kSquares);
+	Ops::Store(st.fX[0], x1);  Ops::Store(st.fX[1], x2);
+	Ops::Store(st.fS[0], s1);  Ops::Store(st.fS[1], s2);
+	Ops::Store(st.fY[0], y1);  Ops::Store(st.fY[1], y2);
+	st.fHistPos = pos;
+}
+
+
+CNTV2AudioMeter::CNTV2AudioMeter (const ULWord inNumChannels, const double inSampleRate)
+	:	mNumChannels	(inNumChannels < 1 ? 1 : (inNumChannels > kMaxChannels ? kMaxChannels : inNumChannels)),
+		mSampleRate		(inSampleRate > 0.0 ? inSampleRate : 48000.0),
+		mUseSIMD		(HasSIMD()),
+		mLevelSamples	(0),
+		mSubBlockLength	(ULWord(mSampleRate / 10.0 + 0.5)),
+		mSubBlockFill	(0),
+		mNumSubBlocks	(0)
+{
+	//	K-weighting filters for this sample rate (BS.1770-4's coefficients are for 48 kHz only)
+	double K (::tan(kPi * 1681.974450955533 / mSampleRate));
+	const double Vh (::pow(10.0, 3.999843853973347 / 20.0)),  Vb (::pow(Vh, 0.4996667741545416)),  Q (0.7071752369554196);
+	double a0 (1.0 + K / Q + K * K);
+	mShelfB[0] = float((Vh + Vb * K / Q + K * K) / a0);
+	mShelfB[1] = float(2.0 * (K * K - Vh) / a0);
+	mShelfB[2] = float((Vh - Vb * K / Q + K * K) / a0);
+	mShelfA[0] = float(2.0 * (K * K - 1.0) / a0);
+	mShelfA[1] = float((1.0 - K / Q + K * K) / a0);
+	K = ::tan(kPi * 38.13547087602444 / mSampleRate);
+	const double Qh (0.5003270373238773);
+	a0 = 1.0 + K / Qh + K * K;
+	mHighPassA[0] = float(2.0 * (K * K - 1.0) / a0);
+	mHighPassA[1] = float((1.0 - K / Qh + K * K) / a0);
+
+	mGroups.resize((mNumChannels + 3) / 4);
+	mWeights.resize(mNumChannels, 1.0);
+	mSquares.resize(mNumChannels, 0.0);
+	mSubBlockSquares.resize(mNumChannels, 0.0);
+	mSubBlockEnergy.resize(kNumShortTermBlocks, 0.0);
+	mGateCounts.resize(kNumGateBins, 0);
+	mGateEnergy.resize(kNumGateBins, 0.0);
+	for (size_t ndx(0);  ndx < mGroups.size();  ndx++)
+		::memset(&mGroups[ndx], 0, sizeof(GroupState));
+}
+
+CNTV2AudioMeter::~CNTV2AudioMeter ()
+{
+}
+
+bool CNTV2AudioMeter::HasSIMD (void)
+{
+#if defined(AJA_HAS_SSE2)
+	return true;
+#else
+	return false;
+#endif
+}
+
+bool CNTV2AudioMeter::SetChannelWeight (const ULWord inChannel, const double inWeight)
+{
+	if (inChannel >= mNumChannels)
+		{ASFAIL("Invalid channel " << DEC(inChannel) << " -- must be less than " << DEC(mNumChannels));  return false;}
+	if (inWeight < 0.0)
+		{ASFAIL("Negative weight " << inWeight);  return false;}
+	mWeights[inChannel] = inWeight;
+	return true;
+}
+
+bool CNTV2AudioMeter::Process (const NTV2Buffer & inBuffer, const ULWord inNumSamples, const bool inByteSwap)
+{
+	if (inBuffer.IsNULL())
+		{ASFAIL("NULL buffer");  return false;}
+	if (inBuffer.GetByteCount() < uint64_t(inNumSamples) * mNumChannels * 4)
+		{ASFAIL("Buffer " << DEC(inBuffer.GetByteCount()) << " bytes smaller than " << DEC(inNumSamples) << " samples of "
+				<< DEC(mNumChannels) << " channels");  return false;}
+
+#if defined(AJA_HAS_SSE2)
+	//	The filters' tails decay into denormals after a signal stops -- flush them to zero (on both paths, so they agree)
+	const unsigned int savedCSR (_mm_getcsr());
+	_mm_setcsr(savedCSR | 0x8040);	//	FTZ | DAZ
+#endif
+	const ULWord * pIn (reinterpret_cast<const ULWord*>(inBuffer.GetHostPointer()));
+	for (ULWord done(0);  done < inNumSamples;  )
+	{
+		//	Don't straddle a 100 ms sub-block, and keep the float accumulators' runs short
+		ULWord count (inNumSamples - done);
+		if (count > mSubBlockLength - mSubBlockFill)
+			count = mSubBlockLength - mSubBlockFill;
+		if (count > kChunkSamples)
+			count = kChunkSamples;
+		for (ULWord group(0);  group < ULWord(mGroups.size());  group++)
+		{
+			const ULWord	firstChan	(group * 4);
+			const ULWord	lanes		(mNumChannels - firstChan < 4 ? mNumChannels - firstChan : 4);
+			GroupState &	st			(mGroups[group]);
+#if defined(AJA_HAS_SSE2)
+			if (mUseSIMD)
+				MeterGroup<SSE2Ops>(st, pIn + firstChan, mNumChannels, lanes, count, inByteSwap, mShelfB, mShelfA, mHighPassA);
+			else
+#endif
+				MeterGroup<ScalarOps>(st, pIn + firstChan, mNumChannels, lanes, count, inByteSwap, mShelfB, mShelfA, mHighPassA);
+			for (ULWord lane(0);  lane < lanes;  lane++)
+			{
+				mSquares[firstChan + lane] += st.fSquares[lane];
+				mSubBlockSquares[firstChan + lane] += st.fKSquares[lane];
+			}
+		}
+		pIn += count * mNumChannels;
+		done += count;
+		mLevelSamples += count;
+		mSubBlockFill += count;
+		if (mSubBlockFill == mSubBlockLength)
+			CompleteSubBlock();
+	}
+#if defined(AJA_HAS_SSE2)
+	_mm_setcsr(savedCSR);
+#endif
+	return true;
+}
+
+double CNTV2AudioMeter::EnergyToLUFS (const double inEnergy)
+{
+	return inEnergy > 0.0 ? -0.691 + 10.0 * ::log10(inEnergy) : NTV2_AUDIO_METER_MIN_DB;
+}
+
+void CNTV2AudioMeter::CompleteSubBlock (void)
+{
+	double energy (0.0);
+	for (ULWord chan(0);  chan < mNumChannels;  chan++)
+	{
+		energy += mWeights[chan] * mSubBlockSquares[chan] / double(mSubBlockLength);
+		mSubBlockSquares[chan] = 0.0;
+	}
+	mSubBlockEnergy[mNumSubBlocks % kNumShortTermBlocks] = energy;
+	mNumSubBlocks++;
+	mSubBlockFill = 0;
+
+	//	Every sub-block completes another 400 ms gating block (they overlap by 75%)
+	if (mNumSubBlocks < 4)
+		return;
+	double blockEnergy (0.0);
+	for (uint64_t ndx(mNumSubBlocks - 4);  ndx < mNumSubBlocks;  ndx++)
+		blockEnergy += mSubBlockEnergy[ndx % kNumShortTermBlocks];
+	blockEnergy /= 4.0;
+	const double loudness (EnergyToLUFS(blockEnergy));
+	if (loudness <= kAbsoluteGate)
+		return;
+	ULWord bin (ULWord((loudness - kAbsoluteGate) * 10.0));
+	if (bin >= kNumGateBins)
+		bin = kNumGateBins - 1;
+	mGateCounts[bin]++;
+	mGateEnergy[bin] += blockEnergy;
+}
+
+bool CNTV2AudioMeter::GetChannelLevels (const ULWord inChannel, NTV2AudioChannelLevels & outLevels) const
+{
+	outLevels = NTV2AudioChannelLevels();
+	if (inChannel >= mNumChannels)
+		{ASFAIL("Invalid channel " << DEC(inChannel) << " -- must be less than " << DEC(mNumChannels));  return false;}
+	const GroupState &	st		(mGroups[inChannel / 4]);
+	const ULWord		lane	(inChannel % 4);
+	if (st.fPeak[lane] > 0.0f)
+		outLevels.fPeak = 20.0 * ::log10(double(st.fPeak[lane]));
+	if (st.fTruePeak[lane] > 0.0f)
+		outLevels.fTruePeak = 20.0 * ::log10(double(st.fTruePeak[lane]));
+	if (mLevelSamples  &&  mSquares[inChannel] > 0.0)
+		outLevels.fRMS = 10.0 * ::log10(mSquares[inChannel] / double(mLevelSamples));
+	return true;
+}
+
+void CNTV2AudioMeter::ResetLevels (void)
+{
+	for (size_t ndx(0);  ndx < mGroups.size();  ndx++)
+		for (int lane(0);  lane < 4;  lane++)
+			mGroups[ndx].fPeak[lane] = mGroups[ndx].fTruePeak[lane] = 0.0f;
+	for (ULWord chan(0);  chan < mNumChannels;  chan++)
+		mSquares[chan] = 0.0;
+	mLevelSamples = 0;
+}
+
+double CNTV2AudioMeter::GetMomentaryLoudness (void) const
+{
+	if (mNumSubBlocks < 4)
+		return NTV2_AUDIO_METER_MIN_DB;
+	double energy (0.0);
+	for (uint64_t ndx(mNumSubBlocks - 4);  ndx < mNumSubBlocks;  ndx++)
+		energy += mSubBlockEnergy[ndx % kNumShortTermBlocks];
+	return EnergyToLUFS(energy / 4.0);
+}
+
+double CNTV2AudioMeter::GetShortTermLoudness (void) const
+{
+	if (mNumSubBlocks < kNumShortTermBlocks)
+		return NTV2_AUDIO_METER_MIN_DB;
+	double energy (0.0);
+	for (ULWord ndx(0);  ndx < kNumShortTermBlocks;  ndx++)
+		energy += mSubBlockEnergy[ndx];
+	return EnergyToLUFS(energy / double(kNumShortTermBlocks));
+}
+
+double CNTV2AudioMeter::GetIntegratedLoudness (void) const
+{
+	//	Blocks above the absolute gate set the relative gate...
+	uint64_t count (0);
+	double energy (0.0);
+	for (ULWord bin(0);  bin < kNumGateBins;  bin++)
+		{count += mGateCounts[bin];  energy += mGateEnergy[bin];}
+	if (!count)
+		return NTV2_AUDIO_METER_MIN_DB;
+	const double relativeGate (EnergyToLUFS(energy / double(count)) + kRelativeGate);
+
+	//	...and blocks above the relative gate set the loudness
+	count = 0;
+	energy = 0.0;
+	for (ULWord bin(0);  bin < kNumGateBins;  bin++)
+		if (kAbsoluteGate + (double(bin) + 0.5) / 10.0 > relativeGate)
+			{count += mGateCounts[bin];  energy += mGateEnergy[bin];}
+	return count ? EnergyToLUFS(energy / double(count)) : NTV2_AUDIO_METER_MIN_DB;
+}
+
+void CNTV2AudioMeter::ResetLoudness (void)
+{
+	for (ULWord chan(0);  chan < mNumChannels;  chan++)
+		mSubBlockSquares[chan] = 0.0;
+	for (ULWord ndx(0);  ndx < kNumShortTermBlocks;  ndx++)
+		mSubBlockEnergy[ndx] = 0.0;
+	for (ULWord bin(0);  bin < kNumGateBins;  bin++)
+		{mGateCounts[bin] = 0;  mGateEnergy[bin] = 0.0;}
+	mSubBlockFill = 0;
+	mNumSubBlocks = 0;
+}
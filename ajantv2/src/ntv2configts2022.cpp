@@ -25,7 +25,17 @@
 
 using namespace std;
 
-CNTV2ConfigTs2022::CNTV2ConfigTs2022(CNTV2Card & device) : CNTV2MBController(device)
+//	Encoder (re)configuration handshakes are polled at this interval, each bounded by its own timeout...
+static const int32_t	kPollIntervalUs		(100);
+static const uint32_t	kT2StopTimeoutMs	(1000);		//	T2 tier must stop within this time
+static const uint32_t	kT2StopDefaultMs	(50);		//	Frame counter must hold still this long if the running format is unknown
+static const uint32_t	kResetAssertMs		(400);		//	Encoder reset is held at least this long (there's no reset-done status to poll)
+static const uint32_t	kResetSettleMs		(200);		//	J2K core FIFO status isn't trusted until this long after reset is released
+static const uint32_t	kResetTimeoutMs		(600);		//	...after which the reset must read back, and the J2K core go idle, within this time
+static const uint32_t	kTsFlushHoldMs		(60);		//	TS J2K encoder stays in flush at least this long
+static const uint32_t	kJ2kCmdTimeoutMs	(100);		//	J2K command FIFO must accept (and answer) a command within this time
+
+CNTV2ConfigTs2022::CNTV2ConfigTs2022(CNTV2Card & device) : CNTV2MBController(device), _transactionCount(0), _tsFlushStartMs(0)
 {
 	uint32_t features	 = GetFeatures();
 
@@ -35,8 +45,6 @@ CNTV2ConfigTs2022::CNTV2ConfigTs2022(CNTV2Card & device) : CNTV2MBController(dev
 
 bool CNTV2ConfigTs2022::SetupJ2KEncoder(const NTV2Channel channel, const j2kEncoderConfig &config)
 {
-#define WAIT_RESET_MS	800
-
 	kipdprintf("CNTV2ConfigTs2022::SetupJ2KEncoder channel = %d\n", channel);
 
 	// Check for a proper channnel (we only configure NTV2_CHANNEL1 and NTV2_CHANNEL2)
@@ -59,70 +67,62 @@ bool CNTV2ConfigTs2022::SetupJ2KEncoder(const NTV2Channel channel, const j2kEnco
 		return false;
 	}
 
-	// Set T2 to mode stop
+	// Set T2 to mode stop, and wait until it has stopped
 	J2kSetMode(channel, 2, MODE_STOP);
-
-	// Now wait until T2 has stopped
-	uint32_t lastFrameCount = J2kGetFrameCounter(channel, 2);
-	uint32_t currentFrameCount = 0;
-	uint32_t tries = 20;
-
-	while (tries)
+	if (!WaitForT2Stop(channel))
 	{
-		// Wait
-		AJATime::Sleep(50);
-
-		currentFrameCount = J2kGetFrameCounter(channel, 2);
-		// See if t2 is still running
-		if (lastFrameCount != currentFrameCount)
-		{
-			// Yep wait some more
-			lastFrameCount = currentFrameCount;
-			tries--;
-		}
-		else
-		{
-			// Nope end the wait
-			tries = 0;
-		}
+		kipdprintf("CNTV2ConfigTs2022::SetupJ2KEncoder T2 still running after %u ms\n", kT2StopTimeoutMs);
+		mIpErrorCode = NTV2IpErrNotReady;
+		return false;
 	}
 
 	// Disable encoder inputs
 	SetEncoderInputEnable( channel, false, false );
 
-	// Assert reset
+	// Pulse reset for at least the minimum time, then wait for the J2K core to come back up idle
 	SetEncoderReset( channel, true );
-
-	// Wait
-	AJATime::Sleep(WAIT_RESET_MS/2);
-
-	// De-assert reset
+	AJATime::Sleep(kResetAssertMs);
+	if (!WaitForEncoderReset(channel, true))
+	{
+		mIpErrorCode = NTV2IpErrNotReady;
+		return false;
+	}
 	SetEncoderReset( channel, false );
+	AJATime::Sleep(kResetSettleMs);
+	if (!WaitForEncoderReset(channel, false))
+	{
+		mIpErrorCode = NTV2IpErrNotReady;
+		return false;
+	}
 
-	// Wait
-	AJATime::Sleep(WAIT_RESET_MS);
-
-	// Now proceed to configure the device	   
-	WriteJ2KConfigReg(channel, kRegSarekEncodeVideoFormat1, (uint32_t) config.videoFormat);
-	WriteJ2KConfigReg(channel, kRegSarekEncodeUllMode1, config.ullMode);
-	WriteJ2KConfigReg(channel, kRegSarekEncodeBitDepth1, config.bitDepth);
-	WriteJ2KConfigReg(channel, kRegSarekEncodeChromaSubSamp1, (uint32_t) config.chromaSubsamp);
-	WriteJ2KConfigReg(channel, kRegSarekEncodeMbps1, config.mbps);
-	WriteJ2KConfigReg(channel, kRegSarekEncodeStreamType1, (uint32_t) config.streamType);
-	WriteJ2KConfigReg(channel, kRegSarekEncodeAudioChannels1, (uint32_t) config.audioChannels);
-	WriteJ2KConfigReg(channel, kRegSarekEncodeProgramPid1, config.pmtPid);
-	WriteJ2KConfigReg(channel, kRegSarekEncodeVideoPid1, config.videoPid);
-	WriteJ2KConfigReg(channel, kRegSarekEncodePcrPid1, config.pcrPid);
-	WriteJ2KConfigReg(channel, kRegSarekEncodeAudio1Pid1, config.audio1Pid);
-
-	// setup the TS
+	// Now proceed to configure the device
+	const uint32_t configBase = SAREK_REGS2 + ((kRegSarekEncodeAudio1Pid1-kRegSarekEncodeVideoFormat1+1) * channel);
+	NTV2RegisterWrites configRegs;
+	configRegs.push_back(NTV2RegInfo(configBase + kRegSarekEncodeVideoFormat1,		(uint32_t) config.videoFormat));
+	configRegs.push_back(NTV2RegInfo(configBase + kRegSarekEncodeUllMode1,			config.ullMode));
+	configRegs.push_back(NTV2RegInfo(configBase + kRegSarekEncodeBitDepth1,			config.bitDepth));
+	configRegs.push_back(NTV2RegInfo(configBase + kRegSarekEncodeChromaSubSamp1,	(uint32_t) config.chromaSubsamp));
+	configRegs.push_back(NTV2RegInfo(configBase + kRegSarekEncodeMbps1,				config.mbps));
+	configRegs.push_back(NTV2RegInfo(configBase + kRegSarekEncodeStreamType1,		(uint32_t) config.streamType));
+	configRegs.push_back(NTV2RegInfo(configBase + kRegSarekEncodeAudioChannels1,	(uint32_t) config.audioChannels));
+	configRegs.push_back(NTV2RegInfo(configBase + kRegSarekEncodeProgramPid1,		config.pmtPid));
+	configRegs.push_back(NTV2RegInfo(configBase + kRegSarekEncodeVideoPid1,			config.videoPid));
+	configRegs.push_back(NTV2RegInfo(configBase + kRegSarekEncodePcrPid1,			config.pcrPid));
+	configRegs.push_back(NTV2RegInfo(configBase + kRegSarekEncodeAudio1Pid1,		config.audio1Pid));
+	mDevice.WriteRegisters(configRegs);
+
+	// setup the TS (this leaves the TS J2K encoder flushing)
 	if (!SetupTsForEncode(channel))
 		return false;
 
-	// setup the J2K encoder
+	// setup the J2K encoder while the TS flushes
 	if (!SetupJ2KForEncode(channel))
 		return false;
 
+	// now let the TS J2K encoder go
+	if (!EnableEncodeTsJ2KEncoder(channel))
+		return false;
+
 	// Need to set 20 or 24 bit audio in NTV2 audio control reg.  For now we are doing this on
 	// a global basis and setting all audio engines to the same value.
 	J2KStreamType		streamType;
@@ -155,17 +155,25 @@ bool CNTV2ConfigTs2022::ReadbackJ2KEncoder(const NTV2Channel channel, j2kEncoder
 {
 	if ((channel == NTV2_CHANNEL1) || (channel == NTV2_CHANNEL2))
 	{
-		ReadJ2KConfigReg(channel, kRegSarekEncodeVideoFormat1, (uint32_t*) &config.videoFormat);
-		ReadJ2KConfigReg(channel, kRegSarekEncodeUllMode1, &config.ullMode);
-		ReadJ2KConfigReg(channel, kRegSarekEncodeBitDepth1, &config.bitDepth);
-		ReadJ2KConfigReg(channel, kRegSarekEncodeChromaSubSamp1, (uint32_t *) &config.chromaSubsamp);
-		ReadJ2KConfigReg(channel, kRegSarekEncodeMbps1, &config.mbps);
-		ReadJ2KConfigReg(channel, kRegSarekEncodeStreamType1, (uint32_t *) &config.streamType);
-		ReadJ2KConfigReg(channel, kRegSarekEncodeAudioChannels1, (uint32_t *) &config.audioChannels);
-		ReadJ2KConfigReg(channel, kRegSarekEncodeProgramPid1, &config.pmtPid);
-		ReadJ2KConfigReg(channel, kRegSarekEncodeVideoPid1, &config.videoPid);
-		ReadJ2KConfigReg(channel, kRegSarekEncodePcrPid1, &config.pcrPid);
-		ReadJ2KConfigReg(channel, kRegSarekEncodeAudio1Pid1, &config.audio1Pid);
+		// The config registers are contiguous -- read them all at once
+		const uint32_t configBase = SAREK_REGS2 + ((kRegSarekEncodeAudio1Pid1-kRegSarekEncodeVideoFormat1+1) * channel);
+		NTV2RegisterReads configRegs;
+		for (uint32_t reg = kRegSarekEncodeVideoFormat1; reg <= kRegSarekEncodeAudio1Pid1; reg++)
+			configRegs.push_back(NTV2RegInfo(configBase + reg));
+		if (!mDevice.ReadRegisters(configRegs))
+			return false;
+
+		config.videoFormat		= NTV2VideoFormat(configRegs[kRegSarekEncodeVideoFormat1 - ENCODER_BLOCK_BASE].registerValue);
+		config.ullMode			= configRegs[kRegSarekEncodeUllMode1 - ENCODER_BLOCK_BASE].registerValue;
+		config.bitDepth			= configRegs[kRegSarekEncodeBitDepth1 - ENCODER_BLOCK_BASE].registerValue;
+		config.chromaSubsamp	= J2KChromaSubSampling(configRegs[kRegSarekEncodeChromaSubSamp1 - ENCODER_BLOCK_BASE].registerValue);
+		config.mbps				= configRegs[kRegSarekEncodeMbps1 - ENCODER_BLOCK_BASE].registerValue;
+		config.streamType		= J2KStreamType(configRegs[kRegSarekEncodeStreamType1 - ENCODER_BLOCK_BASE].registerValue);
+		config.audioChannels	= configRegs[kRegSarekEncodeAudioChannels1 - ENCODER_BLOCK_BASE].registerValue;
+		config.pmtPid			= configRegs[kRegSarekEncodeProgramPid1 - ENCODER_BLOCK_BASE].registerValue;
+		config.videoPid			= configRegs[kRegSarekEncodeVideoPid1 - ENCODER_BLOCK_BASE].registerValue;
+		config.pcrPid			= configRegs[kRegSarekEncodePcrPid1 - ENCODER_BLOCK_BASE].registerValue;
+		config.audio1Pid		= configRegs[kRegSarekEncodeAudio1Pid1 - ENCODER_BLOCK_BASE].registerValue;
 		return true;
 	}
 	else
@@ -363,14 +371,17 @@ bool CNTV2ConfigTs2022::SetupJ2KForEncode(const NTV2Channel channel)
 
 bool CNTV2ConfigTs2022::SetupJ2KDecoder(const j2kDecoderConfig &config)
 {
-	mDevice.WriteRegister(SAREK_IPX_J2K_DECODER_1 + kRegJ2kPrpMainCsr, 0x10);	// prp mode play
-	mDevice.WriteRegister(SAREK_IPX_J2K_DECODER_1 + kRegJ2kPopMainCsr, 0x12);	// pop mode play once
+	NTV2RegisterWrites regs;
+	regs.push_back(NTV2RegInfo(SAREK_IPX_J2K_DECODER_1 + kRegJ2kPrpMainCsr, 0x10));	// prp mode play
+	regs.push_back(NTV2RegInfo(SAREK_IPX_J2K_DECODER_1 + kRegJ2kPopMainCsr, 0x12));	// pop mode play once
 
-	mDevice.WriteRegister(SAREK_REGS2 + kRegSarekModeSelect,	 uint32_t(config.selectionMode));
-	mDevice.WriteRegister(SAREK_REGS2 + kRegSarekProgNumSelect,	 config.programNumber);
-	mDevice.WriteRegister(SAREK_REGS2 + kRegSarekProgPIDSelect,	 config.programPID);
-	mDevice.WriteRegister(SAREK_REGS2 + kRegSarekAudioNumSelect, config.audioNumber);
+	regs.push_back(NTV2RegInfo(SAREK_REGS2 + kRegSarekModeSelect,		uint32_t(config.selectionMode)));
+	regs.push_back(NTV2RegInfo(SAREK_REGS2 + kRegSarekProgNumSelect,	config.programNumber));
+	regs.push_back(NTV2RegInfo(SAREK_REGS2 + kRegSarekProgPIDSelect,	config.programPID));
+	regs.push_back(NTV2RegInfo(SAREK_REGS2 + kRegSarekAudioNumSelect,	config.audioNumber));
+	mDevice.WriteRegisters(regs);
 
+	// Bumping the sequence number tells the microblaze to pick up the new selection
 	uint32_t seqNum;
 	mDevice.ReadRegister( SAREK_REGS2 + kRegSarekHostSeqNum, seqNum);
 	mDevice.WriteRegister(SAREK_REGS2 + kRegSarekHostSeqNum, ++seqNum);
@@ -380,40 +391,69 @@ bool CNTV2ConfigTs2022::SetupJ2KDecoder(const j2kDecoderConfig &config)
 
 bool CNTV2ConfigTs2022::ReadbackJ2KDecoder(j2kDecoderConfig &config)
 {
-	mDevice.ReadRegister(SAREK_REGS2 + kRegSarekModeSelect,		(uint32_t&)config.selectionMode);
-	mDevice.ReadRegister(SAREK_REGS2 + kRegSarekProgNumSelect,	config.programNumber);
-	mDevice.ReadRegister(SAREK_REGS2 + kRegSarekProgPIDSelect,	config.programPID);
-	mDevice.ReadRegister(SAREK_REGS2 + kRegSarekAudioNumSelect, config.audioNumber);
+	NTV2RegisterReads regs;
+	regs.push_back(NTV2RegInfo(SAREK_REGS2 + kRegSarekModeSelect));
+	regs.push_back(NTV2RegInfo(SAREK_REGS2 + kRegSarekProgNumSelect));
+	regs.push_back(NTV2RegInfo(SAREK_REGS2 + kRegSarekProgPIDSelect));
+	regs.push_back(NTV2RegInfo(SAREK_REGS2 + kRegSarekAudioNumSelect));
+	if (!mDevice.ReadRegisters(regs))
+		return false;
+
+	config.selectionMode	= j2kDecoderConfig::eProgSelMode_t(regs[0].registerValue);
+	config.programNumber	= regs[1].registerValue;
+	config.programPID		= regs[2].registerValue;
+	config.audioNumber		= regs[3].registerValue;
 
 	return true;
 }
 
 bool CNTV2ConfigTs2022::GetJ2KDecoderStatus(j2kDecoderStatus &status)
 {
+	// The PGM number, PGM PID and audio PID tables each hold this many entries
+	static const uint32_t kMaxTableEntries = kRegSarekPGMPIDs - kRegSarekPGMNums;
+
 	status.init();
 
-	mDevice.ReadRegister(SAREK_REGS2 + kRegSarekNumPGMs,   status.numAvailablePrograms);
-	mDevice.ReadRegister(SAREK_REGS2 + kRegSarekNumAudios, status.numAvailableAudios);
-	for (uint32_t i=0; i < status.numAvailablePrograms; i++)
+	NTV2RegisterReads regs;
+	regs.push_back(NTV2RegInfo(SAREK_REGS2 + kRegSarekNumPGMs));
+	regs.push_back(NTV2RegInfo(SAREK_REGS2 + kRegSarekNumAudios));
+	if (!mDevice.ReadRegisters(regs))
+		return false;
+	status.numAvailablePrograms = regs[0].registerValue;
+	status.numAvailableAudios = regs[1].registerValue;
+	const uint32_t numPrograms = (status.numAvailablePrograms < kMaxTableEntries) ? status.numAvailablePrograms : kMaxTableEntries;
+	const uint32_t numAudios = (status.numAvailableAudios < kMaxTableEntries) ? status.numAvailableAudios : kMaxTableEntries;
+
+	// Then fetch all the table entries in one go
+	regs.clear();
+	for (uint32_t i=0; i < numPrograms; i++)
 	{
-		uint32_t val;
-		mDevice.ReadRegister(SAREK_REGS2 + kRegSarekPGMNums + i, val);
-		status.availableProgramNumbers.push_back(val);
-		mDevice.ReadRegister(SAREK_REGS2 + kRegSarekPGMPIDs + i, val);
-		status.availableProgramPIDs.push_back(val);
+		regs.push_back(NTV2RegInfo(SAREK_REGS2 + kRegSarekPGMNums + i));
+		regs.push_back(NTV2RegInfo(SAREK_REGS2 + kRegSarekPGMPIDs + i));
 	}
-	for (uint32_t i=0; i < status.numAvailableAudios; i++)
+	for (uint32_t i=0; i < numAudios; i++)
+		regs.push_back(NTV2RegInfo(SAREK_REGS2 + kRegSarekAudioPIDs + i));
+	if (!mDevice.ReadRegisters(regs))
+		return false;
+
+	for (uint32_t i=0; i < numPrograms; i++)
 	{
-		uint32_t val;
-		mDevice.ReadRegister(SAREK_REGS2 + kRegSarekAudioPIDs + i, val);
-		status.availableAudioPIDs.push_back(val);
+		status.availableProgramNumbers.push_back(regs[2*i].registerValue);
+		status.availableProgramPIDs.push_back(regs[2*i+1].registerValue);
 	}
+	for (uint32_t i=0; i < numAudios; i++)
+		status.availableAudioPIDs.push_back(regs[2*numPrograms + i].registerValue);
 
 	return true;
 }
 
 bool CNTV2ConfigTs2022::SetupTsForEncode(const NTV2Channel channel)
 {
+	// start flushing the TS J2K encoder first, so that its hold time overlaps the rest of the setup
+	// (EnableEncodeTsJ2KEncoder finishes the job once the J2K encoder has been set up)
+	if (!SetupEncodeTsJ2KEncoder(channel))
+		return false;
+
 	// program TS timer
 	if (!SetupEncodeTsTimer(channel))
 		return false;
@@ -434,10 +474,6 @@ bool CNTV2ConfigTs2022::SetupTsForEncode(const NTV2Channel channel)
 	if (!SetupEncodeTsAesEncap(channel))
 		return false;
 
-	// finally setup TS for the encoder
-	if (!SetupEncodeTsJ2KEncoder(channel))
-		return false;
-
 	return true;
 }
 
@@ -496,9 +532,22 @@ bool CNTV2ConfigTs2022::SetupEncodeTsJ2KEncoder(const NTV2Channel channel)
 
 	mDevice.WriteRegister(addr + (0x800*ENCODE_TS_J2K_ENCODER) + kRegTsJ2kEncoderFlushTimeout, (0x0));
 	mDevice.WriteRegister(addr + (0x800*ENCODE_TS_J2K_ENCODER) + kRegTsJ2kEncoderHostEn, (0x6));
+	_tsFlushStartMs = AJATime::GetSystemMilliseconds();
+
+	return true;
+}
 
-	// Wait 60 ms
-	AJATime::Sleep(60);
+
+bool CNTV2ConfigTs2022::EnableEncodeTsJ2KEncoder(const NTV2Channel channel)
+{
+	uint32_t addr = GetIpxTsAddr(channel);
+
+	kipdprintf("CNTV2ConfigTs2022::EnableEncodeTsJ2KEncoder\n");
+
+	// The flush has no completion status -- only wait out whatever is left of its hold time
+	const uint64_t elapsedMs = AJATime::GetSystemMilliseconds() - _tsFlushStartMs;
+	if (elapsedMs < kTsFlushHoldMs)
+		AJATime::Sleep(int32_t(kTsFlushHoldMs - elapsedMs));
 
 	mDevice.WriteRegister(addr + (0x800*ENCODE_TS_J2K_ENCODER) + kRegTsJ2kEncoderHostEn, (0x1));
 
@@ -508,58 +557,34 @@ bool CNTV2ConfigTs2022::SetupEncodeTsJ2KEncoder(const NTV2Channel channel)
 
 bool CNTV2ConfigTs2022::SetupEncodeTsMpegJ2kEncap(const NTV2Channel channel)
 {
-	uint32_t addr = GetIpxTsAddr(channel);
-
 	kipdprintf("CNTV2ConfigTs2022::SetupEncodeTsMpegJ2kEncap\n");
 
 	GenerateTableForMpegJ2kEncap(channel);
 
 	// Program Transaction Table
-	for (int32_t index=0; index < _transactionCount; index++)
-	{
-		mDevice.WriteRegister(addr + (0x800*ENCODE_TS_MPEG_J2K_ENCAP) + (_transactionTable[index][0]), _transactionTable[index][1]);
-		//printf("SetupEncodeTsMpegJ2kEncap - addr=%08x, val=%08x\n",
-		//		 addr + (0x800*ENCODE_TS_MPEG_J2K_ENCAP) + (_transactionTable[index][0]),  _transactionTable[index][1]);
-	}
-	return true;
+	return WriteTransactionTable(channel, ENCODE_TS_MPEG_J2K_ENCAP);
 }
 
 
 bool CNTV2ConfigTs2022::SetupEncodeTsMpegPcrEncap(const NTV2Channel channel)
 {
-	uint32_t addr = GetIpxTsAddr(channel);
-
 	kipdprintf("CNTV2ConfigTs2022::SetupEncodeTsMpegPcrEncap\n");
 
 	GenerateTableForMpegPcrEncap(channel);
 
 	// Program Transaction Table
-	for (int32_t index=0; index < _transactionCount; index++)
-	{
-		mDevice.WriteRegister(addr + (0x800*ENCODE_TS_MPEG_PCR_ENCAP) + (_transactionTable[index][0]), _transactionTable[index][1]);
-		//printf("SetupEncodeTsMpegPcrEncap - addr=%08x, val=%08x\n",
-		//		 addr + (0x800*ENCODE_TS_MPEG_PCR_ENCAP) + (_transactionTable[index][0]),  _transactionTable[index][1]);
-	}
-	return true;
+	return WriteTransactionTable(channel, ENCODE_TS_MPEG_PCR_ENCAP);
 }
 
 
 bool CNTV2ConfigTs2022::SetupEncodeTsMpegAesEncap(const NTV2Channel channel)
 {
-	uint32_t addr = GetIpxTsAddr(channel);
-
 	kipdprintf("CNTV2ConfigTs2022::SetupEncodeTsMpegAesEncap\n");
 
 	GenerateTableForMpegAesEncap(channel);
 
 	// Program Transaction Table
-	for (int32_t index=0; index < _transactionCount; index++)
-	{
-		mDevice.WriteRegister(addr + (0x800*ENCODE_TS_MPEG_AES_ENCAP) + (_transactionTable[index][0]), _transactionTable[index][1]);
-		//printf("SetupEncodeTsMpegAesEncap - addr=%08x, val=%08x\n",
-		//		 addr + (0x800*ENCODE_TS_MPEG_AES_ENCAP) + (_transactionTable[index][0]),  _transactionTable[index][1]);
-	}
-	return true;
+	return WriteTransactionTable(channel, ENCODE_TS_MPEG_AES_ENCAP);
 }
 
 
@@ -595,6 +620,18 @@ bool CNTV2ConfigTs2022::SetupEncodeTsAesEncap(const NTV2Channel channel)
 }
 
 
+bool CNTV2ConfigTs2022::WriteTransactionTable(const NTV2Channel channel, const uint32_t part)
+{
+	uint32_t addr = GetIpxTsAddr(channel) + (0x800*part);
+
+	NTV2RegisterWrites regs;
+	regs.reserve(size_t(_transactionCount));
+	for (int32_t index=0; index < _transactionCount; index++)
+		regs.push_back(NTV2RegInfo(addr + (_transactionTable[index][0]), ULWord(_transactionTable[index][1])));
+	return mDevice.WriteRegisters(regs);
+}
+
+
 uint32_t CNTV2ConfigTs2022::GetFeatures()
 {
 	uint32_t val;
@@ -627,6 +664,32 @@ bool CNTV2ConfigTs2022::J2kCanAcceptCmd(const NTV2Channel channel)
 		return true;
 }
 
+bool CNTV2ConfigTs2022::J2kWaitCanAcceptCmd(const NTV2Channel channel)
+{
+	const uint64_t deadline = AJATime::GetSystemMilliseconds() + kJ2kCmdTimeoutMs;
+	while (!J2kCanAcceptCmd(channel))
+	{
+		if (AJATime::GetSystemMilliseconds() > deadline)
+			return false;
+		AJATime::SleepInMicroseconds(kPollIntervalUs);
+	}
+	return true;
+}
+
+bool CNTV2ConfigTs2022::J2kIsIdle(const NTV2Channel channel)
+{
+	uint32_t val;
+	uint32_t addr = GetIpxJ2KAddr(channel);
+
+	if (!mDevice.ReadRegister(addr + kRegJ2kT0FIFOCsr, val))
+		return false;
+	if (val == 0xFFFFFFFF)
+		return false;	// Not responding
+
+	// Idle once the CF command FIFO full bit is clear and the SE status FIFO empty bit is set
+	return !(val & BIT(6))  &&  (val & BIT(11));
+}
+
 bool CNTV2ConfigTs2022::J2KGetNextT0Status(const NTV2Channel channel, uint32_t *pStatus)
 {
 	uint32_t val;
@@ -655,19 +718,24 @@ bool CNTV2ConfigTs2022::GetT0CmdStatus( const NTV2Channel channel, const uint32_
 	uint32_t val;
 	static const int MAX_STATUSES_TO_WAIT = 16;
 	int count = 0;
-	while( J2KGetNextT0Status(channel, &val) )
+	const uint64_t deadline = AJATime::GetSystemMilliseconds() + kJ2kCmdTimeoutMs;
+	while (count < MAX_STATUSES_TO_WAIT)
 	{
+		if (!J2KGetNextT0Status(channel, &val))
+		{
+			// Nothing in the status FIFO yet -- give the command a little longer to complete
+			if (AJATime::GetSystemMilliseconds() > deadline)
+				return false;
+			AJATime::SleepInMicroseconds(kPollIntervalUs);
+			continue;
+		}
+
 		if ( ((val >> 16)& 0xff) == cmdId )
 		{
 			*pStatus = val;
 			return true;
 		}
-		else
-		{
-			count++;
-			if (count == MAX_STATUSES_TO_WAIT)
-				return false;
-		}
+		count++;
 	}
 	return false;
 }
@@ -713,6 +781,64 @@ uint32_t CNTV2ConfigTs2022::J2kGetFrameCounter(const NTV2Channel channel, uint32
 }
 
 
+bool CNTV2ConfigTs2022::WaitForT2Stop(const NTV2Channel channel)
+{
+	// T2 has stopped once its frame counter holds still for longer than a frame of the format it was running
+	NTV2VideoFormat videoFormat = NTV2_FORMAT_UNKNOWN;
+	ReadJ2KConfigReg(channel, kRegSarekEncodeVideoFormat1, (uint32_t*) &videoFormat);
+	uint32_t quietMs = kT2StopDefaultMs;
+	if (NTV2_IS_VALID_VIDEO_FORMAT(videoFormat))
+	{
+		const NTV2FrameRate frameRate = GetNTV2FrameRateFromVideoFormat(videoFormat);
+		if (NTV2_IS_VALID_NTV2FrameRate(frameRate))
+			quietMs = uint32_t(GetFrameTime(frameRate) * 1000.0) + 2;
+	}
+
+	const uint64_t startMs = AJATime::GetSystemMilliseconds();
+	uint64_t lastChangeMs = startMs;
+	uint32_t lastFrameCount = J2kGetFrameCounter(channel, 2);
+	for (uint64_t nowMs = startMs;	nowMs - startMs < kT2StopTimeoutMs;	 nowMs = AJATime::GetSystemMilliseconds())
+	{
+		const uint32_t currentFrameCount = J2kGetFrameCounter(channel, 2);
+		if (currentFrameCount != lastFrameCount)
+		{
+			// Still running
+			lastFrameCount = currentFrameCount;
+			lastChangeMs = nowMs;
+		}
+		else if (nowMs - lastChangeMs > quietMs)
+			return true;
+		AJATime::SleepInMicroseconds(kPollIntervalUs * 10);
+	}
+	return false;
+}
+
+
+bool CNTV2ConfigTs2022::WaitForEncoderReset(const NTV2Channel channel, bool bReset)
+{
+#ifdef COCHRANE
+	const uint32_t resetReg = 0x20000;
+	const uint32_t resetBit = BIT(12);
+#else
+	const uint32_t resetReg = SAREK_REGS + kRegSarekControl;
+	const uint32_t resetBit = (channel == NTV2_CHANNEL2)?ENCODER_2_RESET:ENCODER_1_RESET;
+#endif
+	const uint64_t deadline = AJATime::GetSystemMilliseconds() + kResetTimeoutMs;
+	for (;;)
+	{
+		uint32_t val = 0;
+		mDevice.ReadRegister( resetReg, val);
+		// The reset must have reached the control register, and on the way out, the J2K core must be back up.
+		// (Callers hold the reset, and let it settle, for the minimum time first -- the FIFO status can read idle during reset.)
+		if (bool(val & resetBit) == bReset	&&	(bReset || J2kIsIdle(channel)))
+			return true;
+		if (AJATime::GetSystemMilliseconds() > deadline)
+			return false;
+		AJATime::SleepInMicroseconds(kPollIntervalUs);
+	}
+}
+
+
 void CNTV2ConfigTs2022::J2kSetParam (const NTV2Channel channel, uint32_t config, uint32_t param, uint32_t value)
 {
 	uint32_t val;
@@ -720,9 +846,10 @@ void CNTV2ConfigTs2022::J2kSetParam (const NTV2Channel channel, uint32_t config,
 
 	//printf("J2kSetParam - ch=%d config=0x%08x param=0x%08x value=0x%08x\n", channel, config, param, value);
 
-	while(!J2kCanAcceptCmd(channel))
+	if (!J2kWaitCanAcceptCmd(channel))
 	{
-		 printf("J2kSetParam - command fifo full\n");
+		printf("J2kSetParam - command fifo full\n");
+		return;
 	}
 
 	// we use param as cmd id
@@ -730,9 +857,10 @@ void CNTV2ConfigTs2022::J2kSetParam (const NTV2Channel channel, uint32_t config,
 	mDevice.WriteRegister(addr + kRegJ2kT0CmdFIFO, val);
 	//printf("J2kSetParam - wrote 0x%08x to CMD FIFO\n", val);
 
-	while(!J2kCanAcceptCmd(channel))
+	if (!J2kWaitCanAcceptCmd(channel))
 	{
-		 printf("J2kSetParam - command fifo full\n");
+		printf("J2kSetParam - command fifo full\n");
+		return;
 	}
 
 	val = 0x7f000000 + (param<<16) + value;
@@ -0,0 +1,272 @@
+/* SPDX-License-Identifier: MIT */
+/**
+	@file		ntv2deinterlacer.cpp
+	@brief		Implements the CNTV2Deinterlacer class.
+	@copyright	(C) 2023 AJA Video Systems, Inc.
+**/
+
+#include "ntv2deinterlacer.h"
+#include "ntv2utils.h"
+#include "ajabase/system/debug.h"
+#include "ajabase/system/workerpool.h"
+#include <string.h>
+#if defined(AJA_HAS_SSE2)
+	#include <emmintrin.h>
+#endif
+
+using namespace std;
+
+#define DIFAIL(__x__)	AJA_sERROR	(AJA_DebugUnit_VideoGeneric, AJAFUNC << ": " << __x__)
+
+
+string NTV2DeinterlaceModeToString (const NTV2DeinterlaceMode inMode, const bool inCompact)
+{
+	switch (inMode)
+	{
+		case NTV2_DEINTERLACE_BOB:				return inCompact ? "bob"	: "NTV2_DEINTERLACE_BOB";
+		case NTV2_DEINTERLACE_BLEND:			return inCompact ? "blend"	: "NTV2_DEINTERLACE_BLEND";
+		case NTV2_DEINTERLACE_MOTION_ADAPTIVE:	return inCompact ? "motion"	: "NTV2_DEINTERLACE_MOTION_ADAPTIVE";
+		case NTV2_DEINTERLACE_INVALID:			break;
+	}
+	return inCompact ? "???" : "NTV2_DEINTERLACE_INVALID";
+}
+
+
+/*
+	All supported formats pack their components into 32-bit words without straddling them: either four 8-bit
+	components, or three 10-bit components (plus 2 spare bits). So every operation works on whole words:
+	-	Averaging uses the rounding-up SWAR average (a|b) - ((a^b) & ~lsbs) >> 1, where "lsbs" are the least
+		significant bits of each component (masked so they don't shift into the component below).
+	-	Motion detection compares each component, and marks the whole word as moving if any component moved.
+*/
+
+static const ULWord	kAvgMask8	(0xFEFEFEFE);	//	Everything but each byte's LSB
+static const ULWord	kAvgMask10	(0xBFEFFBFE);	//	Everything but the LSB of the components at bits 0, 10, 20 & 30
+
+typedef struct DeinterlaceJob
+{
+	const UByte *		pIn;
+	UByte *				pOut;
+	const UByte *		pPrev;
+	ULWord				rowBytes;
+	ULWord				numLines;
+	NTV2DeinterlaceMode	mode;
+	ULWord				keepParity;		//	Line parity of the kept field
+	ULWord				avgMask;
+	bool				is10Bit;
+	ULWord				threshold;		//	In the format's own component units
+	bool				useSIMD;
+} DeinterlaceJob;
+
+
+static inline ULWord AvgWord (const ULWord inA, const ULWord inB, const ULWord inMask)
+{
+	return (inA | inB) - (((inA ^ inB) & inMask) >> 1);
+}
+
+static inline bool WordMoved (const ULWord inA, const ULWord inB, const bool in10Bit, const ULWord inThreshold)
+{
+	const ULWord	fieldMask	(in10Bit ? 0x3FF : 0xFF);
+	const ULWord	numFields	(in10Bit ? 3 : 4);
+	const ULWord	fieldBits	(in10Bit ? 10 : 8);
+	for (ULWord field(0);  field < numFields;  field++)
+	{
+		const LWord a (LWord((inA >> (field * fieldBits)) & fieldMask)),  b (LWord((inB >> (field * fieldBits)) & fieldMask));
+		if (ULWord(a > b ? a - b : b - a) > inThreshold)
+			return true;
+	}
+	return false;
+}
+
+//	pOut = avg(pA, pB)
+static void AverageLine (const ULWord * pA, const ULWord * pB, ULWord * pOut, const ULWord inNumWords, const DeinterlaceJob & inJob)
+{
+	ULWord ndx(0);
+#if defined(AJA_HAS_SSE2)
+	if (inJob.useSIMD)
+	{
+		const __m128i mask (_mm_set1_epi32(int(inJob.avgMask)));
+		for (;  ndx + 4 <= inNumWords;  ndx += 4)
+		{
+			const __m128i a (_mm_loadu_si128(reinterpret_cast<const __m128i*>(pA + ndx)));
+			const __m128i b (_mm_loadu_si128(reinterpret_cast<const __m128i*>(pB + ndx)));
+			_mm_storeu_si128(reinterpret_cast<__m128i*>(pOut + ndx),
+							_mm_sub_epi32(_mm_or_si128(a, b), _mm_srli_epi32(_mm_and_si128(_mm_xor_si128(a, b), mask), 1)));
+		}
+	}
+#endif	//	AJA_HAS_SSE2
+	for (;  ndx < inNumWords;  ndx++)
+		pOut[ndx] = AvgWord(pA[ndx], pB[ndx], inJob.avgMask);
+}
+
+//	pOut = avg(avg(pAbove, pBelow), pMid)
+static void BlendLine (const ULWord * pAbove, const ULWord * pMid, const ULWord * pBelow, ULWord * pOut, const ULWord inNumWords, const DeinterlaceJob & inJob)
+{
+	ULWord ndx(0);
+#if defined(AJA_HAS_SSE2)
+	if (inJob.useSIMD)
+	{
+		const __m128i mask (_mm_set1_epi32(int(inJob.avgMask)));
+		for (;  ndx + 4 <= inNumWords;  ndx += 4)
+		{
+			const __m128i a (_mm_loadu_si128(reinterpret_cast<const __m128i*>(pAbove + ndx)));
+			const __m128i b (_mm_loadu_si128(reinterpret_cast<const __m128i*>(pBelow + ndx)));
+			const __m128i m (_mm_loadu_si128(reinterpret_cast<const __m128i*>(pMid + ndx)));
+			const __m128i ab (_mm_sub_epi32(_mm_or_si128(a, b), _mm_srli_epi32(_mm_and_si128(_mm_xor_si128(a, b), mask), 1)));
+			_mm_storeu_si128(reinterpret_cast<__m128i*>(pOut + ndx),
+							_mm_sub_epi32(_mm_or_si128(ab, m), _mm_srli_epi32(_mm_and_si128(_mm_xor_si128(ab, m), mask), 1)));
+		}
+	}
+#endif	//	AJA_HAS_SSE2
+	for (;  ndx < inNumWords;  ndx++)
+		pOut[ndx] = AvgWord(AvgWord(pAbove[ndx], pBelow[ndx], inJob.avgMask), pMid[ndx], inJob.avgMask);
+}
+
+//	pOut = moved(pCur, pPrev) ? avg(pAbove, pBelow) : pCur
+static void MotionAdaptiveLine (const ULWord * pAbove, const ULWord * pBelow, const ULWord * pCur, const ULWord * pPrev,
+								ULWord * pOut, const ULWord inNumWords, const DeinterlaceJob & inJob)
+{
+	ULWord ndx(0);
+#if defined(AJA_HAS_SSE2)
+	if (inJob.useSIMD)
+	{
+		const __m128i mask (_mm_set1_epi32(int(inJob.avgMask)));
+		const __m128i zero (_mm_setzero_si128());
+		const __m128i thresh8 (_mm_set1_epi8(char(inJob.threshold > 0xFF ? 0xFF : inJob.threshold)));
+		const __m128i thresh10 (_mm_set1_epi32(int(inJob.threshold)));
+		const __m128i mask10 (_mm_set1_epi32(0x3FF));
+		for (;  ndx + 4 <= inNumWords;  ndx += 4)
+		{
+			const __m128i a (_mm_loadu_si128(reinterpret_cast<const __m128i*>(pAbove + ndx)));
+			const __m128i b (_mm_loadu_si128(reinterpret_cast<const __m128i*>(pBelow + ndx)));
+			const __m128i cur (_mm_loadu_si128(reinterpret_cast<const __m128i*>(pCur + ndx)));
+			const __m128i prev (_mm_loadu_si128(reinterpret_cast<const __m128i*>(pPrev + ndx)));
+			const __m128i spatial (_mm_sub_epi32(_mm_or_si128(a, b), _mm_srli_epi32(_mm_and_si128(_mm_xor_si128(a, b), mask), 1)));
+			__m128i moved;
+			if (inJob.is10Bit)
+			{
+				const __m128i d0 (_mm_sub_epi32(_mm_and_si128(cur, mask10), _mm_and_si128(prev, mask10)));
+				const __m128i d1 (_mm_sub_epi32(_mm_and_si128(_mm_srli_epi32(cur, 10), mask10), _mm_and_si128(_mm_srli_epi32(prev, 10), mask10)));
+				const __m128i d2 (_mm_sub_epi32(_mm_and_si128(_mm_srli_epi32(cur, 20), mask10), _mm_and_si128(_mm_srli_epi32(prev, 20), mask10)));
+				const __m128i s0 (_mm_srai_epi32(d0, 31)),  s1 (_mm_srai_epi32(d1, 31)),  s2 (_mm_srai_epi32(d2, 31));
+				moved = _mm_or_si128(_mm_or_si128(_mm_cmpgt_epi32(_mm_sub_epi32(_mm_xor_si128(d0, s0), s0), thresh10),
+												_mm_cmpgt_epi32(_mm_sub_epi32(_mm_xor_si128(d1, s1), s1), thresh10)),
+									_mm_cmpgt_epi32(_mm_sub_epi32(_mm_xor_si128(d2, s2), s2), thresh10));
+			}
+			else
+			{
+				const __m128i absDiff (_mm_or_si128(_mm_subs_epu8(cur, prev), _mm_subs_epu8(prev, cur)));
+				const __m128i still (_mm_cmpeq_epi32(_mm_subs_epu8(absDiff, thresh8), zero));
+				moved = _mm_andnot_si128(still, _mm_cmpeq_epi32(zero, zero));
+			}
+			_mm_storeu_si128(reinterpret_cast<__m128i*>(pOut + ndx), _mm_or_si128(_mm_and_si128(moved, spatial), _mm_andnot_si128(moved, cur)));
+		}
+	}
+#endif	//	AJA_HAS_SSE2
+	for (;  ndx < inNumWords;  ndx++)
+		pOut[ndx] = WordMoved(pCur[ndx], pPrev[ndx], inJob.is10Bit, inJob.threshold)  ?  AvgWord(pAbove[ndx], pBelow[ndx], inJob.avgMask)  :  pCur[ndx];
+}
+
+
+static void DeinterlaceLines (void * pContext, uint32_t inFirstLine, uint32_t inEndLine)
+{
+	const DeinterlaceJob &	job			(*reinterpret_cast<const DeinterlaceJob*>(pContext));
+	const ULWord			numWords	(job.rowBytes / sizeof(ULWord));
+	for (ULWord line(inFirstLine);  line < inEndLine;  line++)
+	{
+		//	Neighbors at the top and bottom edges are mirrored
+		const ULWord	above	(line > 0 ? line - 1 : line + 1);
+		const ULWord	below	(line + 1 < job.numLines ? line + 1 : line - 1);
+		const ULWord *	pAbove	(reinterpret_cast<const ULWord*>(job.pIn + above * job.rowBytes));
+		const ULWord *	pBelow	(reinterpret_cast<const ULWord*>(job.pIn + below * job.rowBytes));
+		const ULWord *	pCur	(reinterpret_cast<const ULWord*>(job.pIn + line * job.rowBytes));
+		ULWord *		pOut	(reinterpret_cast<ULWord*>(job.pOut + line * job.rowBytes));
+		if (job.numLines < 2  ||  (job.mode != NTV2_DEINTERLACE_BLEND  &&  (line & 1) == job.keepParity))
+		{
+			if (pOut != pCur)
+				::memcpy(pOut, pCur, job.rowBytes);
+		}
+		else if (job.mode == NTV2_DEINTERLACE_BLEND)
+			BlendLine(pAbove, pCur, pBelow, pOut, numWords, job);
+		else if (job.mode == NTV2_DEINTERLACE_BOB)
+			AverageLine(pAbove, pBelow, pOut, numWords, job);
+		else
+			MotionAdaptiveLine(pAbove, pBelow, pCur, reinterpret_cast<const ULWord*>(job.pPrev + line * job.rowBytes), pOut, numWords, job);
+	}
+}
+
+
+CNTV2Deinterlacer::CNTV2Deinterlacer (AJAWorkerPool * pInPool)
+	:	mpPool				(pInPool ? pInPool : &AJAWorkerPool::GetSharedPool()),
+		mMotionThreshold	(32),
+		mUseSIMD			(HasSIMD())
+{
+}
+
+bool CNTV2Deinterlacer::HasSIMD (void)
+{
+#if defined(AJA_HAS_SSE2)
+	return true;
+#else
+	return false;
+#endif
+}
+
+bool CNTV2Deinterlacer::CanDeinterlace (const NTV2PixelFormat inPixelFormat)
+{
+	switch (inPixelFormat)
+	{
+		case NTV2_FBF_8BIT_YCBCR:
+		case NTV2_FBF_8BIT_YCBCR_YUY2:
+		case NTV2_FBF_ARGB:
+		case NTV2_FBF_RGBA:
+		case NTV2_FBF_ABGR:
+		case NTV2_FBF_24BIT_RGB:
+		case NTV2_FBF_24BIT_BGR:
+		case NTV2_FBF_10BIT_YCBCR:
+		case NTV2_FBF_10BIT_RGB:		return true;
+		default:						break;
+	}
+	return false;
+}
+
+bool CNTV2Deinterlacer::Deinterlace (const NTV2Buffer & inFrame,  NTV2Buffer & outFrame,  const NTV2FormatDescriptor & inDesc,
+									const NTV2DeinterlaceMode inMode,  const NTV2FieldID inKeepField,  const NTV2Buffer & inPrevFrame)
+{
+	if (!inDesc.IsValid()  ||  inDesc.IsPlanar())
+		{DIFAIL("Invalid or planar format descriptor");  return false;}
+	if (!CanDeinterlace(inDesc.GetPixelFormat()))
+		{DIFAIL("Unsupported pixel format " << ::NTV2FrameBufferFormatToString(inDesc.GetPixelFormat()));  return false;}
+	if (!NTV2_IS_VALID_DEINTERLACE_MODE(inMode)  ||  !NTV2_IS_VALID_FIELD(inKeepField))
+		{DIFAIL("Invalid mode " << DEC(inMode) << " or field " << DEC(inKeepField));  return false;}
+
+	DeinterlaceJob job;
+	job.rowBytes	= inDesc.GetBytesPerRow();
+	job.numLines	= inDesc.GetRasterHeight();
+	if (job.rowBytes % sizeof(ULWord))
+		{DIFAIL("Line pitch " << DEC(job.rowBytes) << " isn't a multiple of 4 bytes");  return false;}
+	const ULWord rasterBytes (job.rowBytes * job.numLines);
+	if (inFrame.GetByteCount() < rasterBytes  ||  outFrame.GetByteCount() < rasterBytes)
+		{DIFAIL("Frame buffers " << DEC(inFrame.GetByteCount()) << ", " << DEC(outFrame.GetByteCount()) << " smaller than " << DEC(rasterBytes) << "-byte raster");  return false;}
+	if (inMode == NTV2_DEINTERLACE_BLEND  &&  inFrame.GetHostPointer() == outFrame.GetHostPointer())
+		{DIFAIL("Blend mode can't deinterlace in place");  return false;}
+	if (inMode == NTV2_DEINTERLACE_MOTION_ADAPTIVE  &&  inPrevFrame.GetByteCount() < rasterBytes)
+		{DIFAIL("Motion-adaptive mode requires the previous frame");  return false;}
+
+	job.pIn			= inFrame;
+	job.pOut		= outFrame;
+	job.pPrev		= inPrevFrame;
+	job.mode		= inMode;
+	job.keepParity	= inKeepField == NTV2_FIELD0 ? 0 : 1;
+	job.is10Bit		= inDesc.GetPixelFormat() == NTV2_FBF_10BIT_YCBCR  ||  inDesc.GetPixelFormat() == NTV2_FBF_10BIT_RGB;
+	job.avgMask		= job.is10Bit ? kAvgMask10 : kAvgMask8;
+	job.threshold	= job.is10Bit ? mMotionThreshold : mMotionThreshold >> 2;
+	job.useSIMD		= mUseSIMD;
+
+	//	Bands of at least 16 lines, so that workers don't thrash over shared cache lines
+	const ULWord numThreads (mpPool->GetNumThreads() + 1);
+	ULWord linesPerBand ((job.numLines + numThreads - 1) / numThreads);
+	if (linesPerBand < 16)
+		linesPerBand = 16;
+	return AJA_SUCCESS(mpPool->ParallelFor(job.numLines, DeinterlaceLines, &job, linesPerBand));
+}
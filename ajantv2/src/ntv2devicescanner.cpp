@@ -10,6 +10,7 @@
 #include "ntv2utils.h"
 #include "ajabase/common/common.h"
 #include "ajabase/system/lock.h"
+#include "ajabase/system/systemtime.h"
 #include <sstream>
 
 using namespace std;
@@ -93,20 +94,123 @@ bool CNTV2DeviceScanner::IsLegalSerialNumber (const string & inStr)
 	return aja::is_alpha_numeric(inStr);
 }
 
-static NTV2DeviceInfoList	sDevInfoList;
-static AJALock				sDevInfoListLock;
+//	The device enumeration is cached. Lookups only rescan the host when the cached list is stale, i.e. when it has
+//	never been scanned, InvalidateDeviceList was called (e.g. upon a hotplug notification), or a device spec was
+//	added or removed. Rescans don't hold sDevInfoListLock while devices are being opened, so lookups on other
+//	threads aren't held up, and concurrent lookups that find the list stale share a single rescan.
+typedef struct NTV2ScannedDevice
+{
+	string	urlSpec;	//	URL spec of a software/remote device (empty for local devices)
+	string	serialStr;	//	CNTV2Card::GetSerialNumberString, read when the device was scanned
+} NTV2ScannedDevice;
+typedef vector<NTV2ScannedDevice>	NTV2ScannedDeviceList;
+
+static NTV2DeviceInfoList		sDevInfoList;		//	Cached enumeration
+static NTV2ScannedDeviceList	sScannedDevList;	//	Parallels sDevInfoList
+static NTV2StringList			sDevSpecs;			//	Software/remote devices to enumerate after the local devices
+static AJALock					sDevInfoListLock;	//	Guards the above and the counters below
+static AJALock					sDevScanLock;		//	Serializes rescans
+static uint32_t					sStaleCount(1);		//	Bumped by InvalidateDeviceList
+static uint32_t					sScannedCount(0);	//	The sStaleCount value the cached list reflects
+static uint32_t					sListGeneration(0);	//	Bumped whenever a rescan finds a different list
+static uint64_t					sLastScanMS(0);		//	When the list was last scanned
+static const uint64_t			kMissRescanMS(1000);//	A lookup that finds no match rescans if the list is older than this
+
+static uint32_t GetStaleCount (void)
+{
+	AJAAutoLock tmpLock(&sDevInfoListLock);
+	return sStaleCount;
+}
+
+static bool IsDeviceListCurrent (void)
+{
+	AJAAutoLock tmpLock(&sDevInfoListLock);
+	return sScannedCount == sStaleCount;
+}
+
+static void PublishDeviceList (const uint32_t inStaleCount, NTV2DeviceInfoList & inOutInfoList, NTV2ScannedDeviceList & inOutScannedList)
+{
+	AJAAutoLock tmpLock(&sDevInfoListLock);
+	bool changed (inOutInfoList.size() != sDevInfoList.size());
+	for (size_t ndx(0);  !changed  &&  ndx < inOutInfoList.size();  ndx++)
+		changed = inOutInfoList.at(ndx).deviceID != sDevInfoList.at(ndx).deviceID
+				||  inOutInfoList.at(ndx).deviceSerialNumber != sDevInfoList.at(ndx).deviceSerialNumber
+				||  inOutInfoList.at(ndx).deviceIdentifier != sDevInfoList.at(ndx).deviceIdentifier
+				||  inOutScannedList.at(ndx).urlSpec != sScannedDevList.at(ndx).urlSpec;
+	sDevInfoList.swap(inOutInfoList);
+	sScannedDevList.swap(inOutScannedList);
+	sScannedCount = inStaleCount;
+	sLastScanMS = AJATime::GetSystemMilliseconds();
+	if (changed)
+		sListGeneration++;
+}
+
+static void UpdateDeviceList (void);
 
 size_t CNTV2DeviceScanner::GetNumDevices (void)
 {
+	UpdateDeviceList();
 	AJAAutoLock tmpLock(&sDevInfoListLock);
 	return sDevInfoList.size();
 }
 
+void CNTV2DeviceScanner::InvalidateDeviceList (void)
+{
+	AJAAutoLock tmpLock(&sDevInfoListLock);
+	sStaleCount++;
+}
+
+ULWord CNTV2DeviceScanner::GetDeviceListGeneration (void)
+{
+	UpdateDeviceList();
+	AJAAutoLock tmpLock(&sDevInfoListLock);
+	return ULWord(sListGeneration);
+}
+
+bool CNTV2DeviceScanner::AddDeviceSpec (const string & inURLSpec)
+{
+	if (inURLSpec.empty())
+		return false;
+	AJAAutoLock tmpLock(&sDevInfoListLock);
+	if (std::find(sDevSpecs.begin(), sDevSpecs.end(), inURLSpec) != sDevSpecs.end())
+		return false;	//	Already added
+	sDevSpecs.push_back(inURLSpec);
+	sStaleCount++;
+	return true;
+}
+
+bool CNTV2DeviceScanner::RemoveDeviceSpec (const string & inURLSpec)
+{
+	AJAAutoLock tmpLock(&sDevInfoListLock);
+	NTV2StringListIter iter (std::find(sDevSpecs.begin(), sDevSpecs.end(), inURLSpec));
+	if (iter == sDevSpecs.end())
+		return false;	//	Not found
+	sDevSpecs.erase(iter);
+	sStaleCount++;
+	return true;
+}
+
+NTV2StringList CNTV2DeviceScanner::GetDeviceSpecs (void)
+{
+	AJAAutoLock tmpLock(&sDevInfoListLock);
+	return sDevSpecs;
+}
+
 #if defined(NTV2_DEPRECATE_17_1)
+	static void FillDeviceInfo (NTV2DeviceInfo & outInfo, CNTV2Card & inDevice, const ULWord inIndex)
+	{
+		(void) inIndex;
+		outInfo.deviceID = inDevice.GetDeviceID();
+		outInfo.deviceSerialNumber = inDevice.GetSerialNumber();
+		outInfo.deviceIdentifier = inDevice.GetDisplayName();
+	}
+
 	void ScanHardware (void)
 	{
-		AJAAutoLock tmpLock(&sDevInfoListLock);
-		sDevInfoList.clear();
+		AJAAutoLock scanLock(&sDevScanLock);
+		const uint32_t staleCount(GetStaleCount());	//	Invalidations from here on will need another rescan
+		NTV2DeviceInfoList infoList;
+		NTV2ScannedDeviceList scannedList;
 		UWord ndx(0);
 		do
 		{
@@ -114,12 +218,31 @@ size_t CNTV2DeviceScanner::GetNumDevices (void)
 			if (!tmpDev.IsOpen())
 				break;
 			NTV2DeviceInfo info;
-			info.deviceID = tmpDev.GetDeviceID();
-			info.deviceSerialNumber = tmpDev.GetSerialNumber();
-			info.deviceIdentifier = tmpDev.GetDisplayName();
-			sDevInfoList.push_back(info);
+			NTV2ScannedDevice scanned;
+			FillDeviceInfo(info, tmpDev, ndx);
+			if (!tmpDev.GetSerialNumberString(scanned.serialStr))
+				scanned.serialStr.clear();
+			infoList.push_back(info);
+			scannedList.push_back(scanned);
 			ndx++;
 		} while (ndx < 16);
+
+		const NTV2StringList specs(CNTV2DeviceScanner::GetDeviceSpecs());
+		for (NTV2StringListConstIter it(specs.begin());  it != specs.end();  ++it)
+		{
+			CNTV2Card tmpDev;
+			if (!tmpDev.Open(*it))
+				continue;
+			NTV2DeviceInfo info;
+			NTV2ScannedDevice scanned;
+			FillDeviceInfo(info, tmpDev, ULWord(infoList.size()));
+			scanned.urlSpec = *it;
+			if (!tmpDev.GetSerialNumberString(scanned.serialStr))
+				scanned.serialStr.clear();
+			infoList.push_back(info);
+			scannedList.push_back(scanned);
+		}
+		PublishDeviceList(staleCount, infoList, scannedList);
 	}
 #else	//	!defined(NTV2_DEPRECATE_17_1)
 CNTV2DeviceScanner::CNTV2DeviceScanner (const bool inScanNow)
@@ -137,89 +260,118 @@ CNTV2DeviceScanner::CNTV2DeviceScanner (const bool inScanNow)
 		}
 	#endif	//	!defined(NTV2_DEPRECATE_16_3)
 
-NTV2DeviceInfoList	GetDeviceInfoList (void)
+NTV2DeviceInfoList CNTV2DeviceScanner::GetDeviceInfoList (void)
 {
+	UpdateDeviceList();
 	AJAAutoLock tmpLock(&sDevInfoListLock);
 	return sDevInfoList;
 }
 
 
+void CNTV2DeviceScanner::FillDeviceInfo (NTV2DeviceInfo & info, CNTV2Card & tmpDev, const ULWord inIndex)
+{
+	const NTV2DeviceID	deviceID (tmpDev.GetDeviceID());
+	ostringstream		oss;
+	info.deviceIndex		= inIndex;
+	info.deviceID			= deviceID;
+	info.deviceSerialNumber	= tmpDev.GetSerialNumber();
+
+	oss << ::NTV2DeviceIDToString (deviceID, tmpDev.IsSupported(kDeviceHasMicrophoneInput)) << " - " << inIndex;
+
+	const ULWordSet wgtIDs (tmpDev.GetSupportedItems(kNTV2EnumsID_WidgetID));
+	info.deviceIdentifier		= oss.str();
+	info.numVidInputs			= tmpDev.GetNumSupported(kDeviceGetNumVideoInputs);
+	info.numVidOutputs			= tmpDev.GetNumSupported(kDeviceGetNumVideoOutputs);
+	info.numAnlgVidOutputs		= tmpDev.GetNumSupported(kDeviceGetNumAnalogVideoOutputs);
+	info.numAnlgVidInputs		= tmpDev.GetNumSupported(kDeviceGetNumAnalogVideoInputs);
+	info.numHDMIVidOutputs		= tmpDev.GetNumSupported(kDeviceGetNumHDMIVideoOutputs);
+	info.numHDMIVidInputs		= tmpDev.GetNumSupported(kDeviceGetNumHDMIVideoInputs);
+	info.numInputConverters		= tmpDev.GetNumSupported(kDeviceGetNumInputConverters);
+	info.numOutputConverters	= tmpDev.GetNumSupported(kDeviceGetNumOutputConverters);
+	info.numUpConverters		= tmpDev.GetNumSupported(kDeviceGetNumUpConverters);
+	info.numDownConverters		= tmpDev.GetNumSupported(kDeviceGetNumDownConverters);
+	info.downConverterDelay		= tmpDev.GetNumSupported(kDeviceGetDownConverterDelay);
+	info.dvcproHDSupport		= tmpDev.IsSupported(kDeviceCanDoDVCProHD);
+	info.qrezSupport			= tmpDev.IsSupported(kDeviceCanDoQREZ);
+	info.hdvSupport				= tmpDev.IsSupported(kDeviceCanDoHDV);
+	info.quarterExpandSupport	= tmpDev.IsSupported(kDeviceCanDoQuarterExpand);
+	info.colorCorrectionSupport	= tmpDev.IsSupported(kDeviceCanDoColorCorrection);
+	info.programmableCSCSupport	= tmpDev.IsSupported(kDeviceCanDoProgrammableCSC);
+	info.rgbAlphaOutputSupport	= tmpDev.IsSupported(kDeviceCanDoRGBPlusAlphaOut);
+	info.breakoutBoxSupport		= tmpDev.IsSupported(kDeviceCanDoBreakoutBox);
+	info.vidProcSupport			= tmpDev.IsSupported(kDeviceCanDoVideoProcessing);
+	info.dualLinkSupport		= tmpDev.IsSupported(kDeviceCanDoDualLink);
+	info.numDMAEngines			= UWord(tmpDev.GetNumSupported(kDeviceGetNumDMAEngines));
+	info.pingLED				= tmpDev.GetNumSupported(kDeviceGetPingLED);
+	info.has2KSupport			= tmpDev.IsSupported(kDeviceCanDo2KVideo);
+	info.has4KSupport			= tmpDev.IsSupported(kDeviceCanDo4KVideo);
+	info.has8KSupport			= tmpDev.IsSupported(kDeviceCanDo8KVideo);
+	info.has3GLevelConversion   = tmpDev.IsSupported(kDeviceCanDo3GLevelConversion);
+	info.isoConvertSupport		= tmpDev.IsSupported(kDeviceCanDoIsoConvert);
+	info.rateConvertSupport		= tmpDev.IsSupported(kDeviceCanDoRateConvert);
+	info.proResSupport			= tmpDev.IsSupported(kDeviceCanDoProRes);
+	info.sdi3GSupport			= wgtIDs.find(NTV2_Wgt3GSDIOut1) != wgtIDs.end();
+	info.sdi12GSupport			= tmpDev.IsSupported(kDeviceCanDo12GSDI);
+	info.ipSupport				= tmpDev.IsSupported(kDeviceCanDoIP);
+	info.biDirectionalSDI		= tmpDev.IsSupported(kDeviceHasBiDirectionalSDI);
+	info.ltcInSupport			= tmpDev.GetNumSupported(kDeviceGetNumLTCInputs) > 0;
+	info.ltcOutSupport			= tmpDev.GetNumSupported(kDeviceGetNumLTCOutputs) > 0;
+	info.ltcInOnRefPort			= tmpDev.IsSupported(kDeviceCanDoLTCInOnRefPort);
+	info.stereoOutSupport		= tmpDev.IsSupported(kDeviceCanDoStereoOut);
+	info.stereoInSupport		= tmpDev.IsSupported(kDeviceCanDoStereoIn);
+	info.multiFormat			= tmpDev.IsSupported(kDeviceCanDoMultiFormat);
+	info.numSerialPorts			= tmpDev.GetNumSupported(kDeviceGetNumSerialPorts);
+	info.procAmpSupport			= false;
+	SetAudioAttributes(info, tmpDev);
+}	//	FillDeviceInfo
+
+
 void CNTV2DeviceScanner::ScanHardware (void)
 {
-	AJAAutoLock tmpLock(&sDevInfoListLock);
-	sDevInfoList.clear();
+	AJAAutoLock scanLock(&sDevScanLock);
+	const uint32_t staleCount(GetStaleCount());	//	Invalidations from here on will need another rescan
+	NTV2DeviceInfoList infoList;
+	NTV2ScannedDeviceList scannedList;
 
 	for (UWord boardNum(0);   ;   boardNum++)
 	{
 		CNTV2Card tmpDev(boardNum);
 		if (!tmpDev.IsOpen())
 			break;
-		const NTV2DeviceID	deviceID (tmpDev.GetDeviceID());
-
-		if (deviceID != DEVICE_ID_NOTFOUND)
+		if (tmpDev.GetDeviceID() != DEVICE_ID_NOTFOUND)
 		{
-			ostringstream	oss;
-			NTV2DeviceInfo	info;
-			info.deviceIndex		= boardNum;
-			info.deviceID			= deviceID;
-			info.deviceSerialNumber	= tmpDev.GetSerialNumber();
-
-			oss << ::NTV2DeviceIDToString (deviceID, tmpDev.IsSupported(kDeviceHasMicrophoneInput)) << " - " << boardNum;
-
-			const ULWordSet wgtIDs (tmpDev.GetSupportedItems(kNTV2EnumsID_WidgetID));
-			info.deviceIdentifier		= oss.str();
-			info.numVidInputs			= tmpDev.GetNumSupported(kDeviceGetNumVideoInputs);
-			info.numVidOutputs			= tmpDev.GetNumSupported(kDeviceGetNumVideoOutputs);
-			info.numAnlgVidOutputs		= tmpDev.GetNumSupported(kDeviceGetNumAnalogVideoOutputs);
-			info.numAnlgVidInputs		= tmpDev.GetNumSupported(kDeviceGetNumAnalogVideoInputs);
-			info.numHDMIVidOutputs		= tmpDev.GetNumSupported(kDeviceGetNumHDMIVideoOutputs);
-			info.numHDMIVidInputs		= tmpDev.GetNumSupported(kDeviceGetNumHDMIVideoInputs);
-			info.numInputConverters		= tmpDev.GetNumSupported(kDeviceGetNumInputConverters);
-			info.numOutputConverters	= tmpDev.GetNumSupported(kDeviceGetNumOutputConverters);
-			info.numUpConverters		= tmpDev.GetNumSupported(kDeviceGetNumUpConverters);
-			info.numDownConverters		= tmpDev.GetNumSupported(kDeviceGetNumDownConverters);
-			info.downConverterDelay		= tmpDev.GetNumSupported(kDeviceGetDownConverterDelay);
-			info.dvcproHDSupport		= tmpDev.IsSupported(kDeviceCanDoDVCProHD);
-			info.qrezSupport			= tmpDev.IsSupported(kDeviceCanDoQREZ);
-			info.hdvSupport				= tmpDev.IsSupported(kDeviceCanDoHDV);
-			info.quarterExpandSupport	= tmpDev.IsSupported(kDeviceCanDoQuarterExpand);
-			info.colorCorrectionSupport	= tmpDev.IsSupported(kDeviceCanDoColorCorrection);
-			info.programmableCSCSupport	= tmpDev.IsSupported(kDeviceCanDoProgrammableCSC);
-			info.rgbAlphaOutputSupport	= tmpDev.IsSupported(kDeviceCanDoRGBPlusAlphaOut);
-			info.breakoutBoxSupport		= tmpDev.IsSupported(kDeviceCanDoBreakoutBox);
-			info.vidProcSupport			= tmpDev.IsSupported(kDeviceCanDoVideoProcessing);
-			info.dualLinkSupport		= tmpDev.IsSupported(kDeviceCanDoDualLink);
-			info.numDMAEngines			= UWord(tmpDev.GetNumSupported(kDeviceGetNumDMAEngines));
-			info.pingLED				= tmpDev.GetNumSupported(kDeviceGetPingLED);
-			info.has2KSupport			= tmpDev.IsSupported(kDeviceCanDo2KVideo);
-			info.has4KSupport			= tmpDev.IsSupported(kDeviceCanDo4KVideo);
-			info.has8KSupport			= tmpDev.IsSupported(kDeviceCanDo8KVideo);
-			info.has3GLevelConversion   = tmpDev.IsSupported(kDeviceCanDo3GLevelConversion);
-			info.isoConvertSupport		= tmpDev.IsSupported(kDeviceCanDoIsoConvert);
-			info.rateConvertSupport		= tmpDev.IsSupported(kDeviceCanDoRateConvert);
-			info.proResSupport			= tmpDev.IsSupported(kDeviceCanDoProRes);
-			info.sdi3GSupport			= wgtIDs.find(NTV2_Wgt3GSDIOut1) != wgtIDs.end();
-			info.sdi12GSupport			= tmpDev.IsSupported(kDeviceCanDo12GSDI);
-			info.ipSupport				= tmpDev.IsSupported(kDeviceCanDoIP);
-			info.biDirectionalSDI		= tmpDev.IsSupported(kDeviceHasBiDirectionalSDI);
-			info.ltcInSupport			= tmpDev.GetNumSupported(kDeviceGetNumLTCInputs) > 0;
-			info.ltcOutSupport			= tmpDev.GetNumSupported(kDeviceGetNumLTCOutputs) > 0;
-			info.ltcInOnRefPort			= tmpDev.IsSupported(kDeviceCanDoLTCInOnRefPort);
-			info.stereoOutSupport		= tmpDev.IsSupported(kDeviceCanDoStereoOut);
-			info.stereoInSupport		= tmpDev.IsSupported(kDeviceCanDoStereoIn);
-			info.multiFormat			= tmpDev.IsSupported(kDeviceCanDoMultiFormat);
-			info.numSerialPorts			= tmpDev.GetNumSupported(kDeviceGetNumSerialPorts);
-			info.procAmpSupport			= false;
-			SetAudioAttributes(info, tmpDev);
-			sDevInfoList.push_back(info);
+			NTV2DeviceInfo		info;
+			NTV2ScannedDevice	scanned;
+			FillDeviceInfo(info, tmpDev, boardNum);
+			if (!tmpDev.GetSerialNumberString(scanned.serialStr))
+				scanned.serialStr.clear();
+			infoList.push_back(info);
+			scannedList.push_back(scanned);
 		}
 		tmpDev.Close();
 	}	//	boardNum loop
 
+	//	Software/remote devices follow the local ones...
+	const NTV2StringList specs(GetDeviceSpecs());
+	for (NTV2StringListConstIter it(specs.begin());  it != specs.end();  ++it)
+	{
+		CNTV2Card tmpDev;
+		if (!tmpDev.Open(*it))
+			continue;	//	Not available right now
+		NTV2DeviceInfo		info;
+		NTV2ScannedDevice	scanned;
+		FillDeviceInfo(info, tmpDev, ULWord(infoList.size()));
+		scanned.urlSpec = *it;
+		if (!tmpDev.GetSerialNumberString(scanned.serialStr))
+			scanned.serialStr.clear();
+		infoList.push_back(info);
+		scannedList.push_back(scanned);
+	}
+
 #if defined(VIRTUAL_DEVICES_SUPPORT)
 	NTV2SerialToVirtualDevices vdMap;
 	GetSerialToVirtualDeviceMap(vdMap);
-	NTV2DeviceInfoList hwList = GetDeviceInfoList();
+	const NTV2DeviceInfoList hwList(infoList);
 	int vdIndex = 100;
 	for (auto hwInfo : hwList)
 	{
@@ -234,19 +386,23 @@ void CNTV2DeviceScanner::ScanHardware (void)
 				hwInfo.isVirtualDevice = true;
 				hwInfo.virtualDeviceID = vdev.vdID;
 				hwInfo.virtualDeviceName =  vdev.vdName;
-				GetDeviceInfoList().push_back(hwInfo);
+				infoList.push_back(hwInfo);
+				scannedList.push_back(NTV2ScannedDevice());
 			}
 		}
 	}
 #endif	//	defined(VIRTUAL_DEVICES_SUPPORT)
+	PublishDeviceList(staleCount, infoList, scannedList);
 }	//	ScanHardware
 
 bool CNTV2DeviceScanner::DeviceIDPresent (const NTV2DeviceID inDeviceID, const bool inRescan)
 {
-	AJAAutoLock tmpLock(&sDevInfoListLock);
 	if (inRescan)
 		ScanHardware();
+	else
+		UpdateDeviceList();
 
+	AJAAutoLock tmpLock(&sDevInfoListLock);
 	for (NTV2DeviceInfoListConstIter iter(sDevInfoList.begin());  iter != sDevInfoList.end();  ++iter)
 		if (iter->deviceID == inDeviceID)
 			return true;	//	Found!
@@ -257,10 +413,12 @@ bool CNTV2DeviceScanner::DeviceIDPresent (const NTV2DeviceID inDeviceID, const b
 
 bool CNTV2DeviceScanner::GetDeviceInfo (const ULWord inDeviceIndexNumber, NTV2DeviceInfo & outDeviceInfo, const bool inRescan)
 {
-	AJAAutoLock tmpLock(&sDevInfoListLock);
 	if (inRescan)
 		ScanHardware();
+	else
+		UpdateDeviceList();
 
+	AJAAutoLock tmpLock(&sDevInfoListLock);
 	if (inDeviceIndexNumber < sDevInfoList.size())
 	{
 		outDeviceInfo = sDevInfoList[inDeviceIndexNumber];
@@ -271,14 +429,97 @@ bool CNTV2DeviceScanner::GetDeviceInfo (const ULWord inDeviceIndexNumber, NTV2De
 }	//	GetDeviceInfo
 #endif	//	!defined(NTV2_DEPRECATE_17_1)
 
+static void UpdateDeviceList (void)
+{
+	if (IsDeviceListCurrent())
+		return;
+	AJAAutoLock scanLock(&sDevScanLock);
+	if (IsDeviceListCurrent())
+		return;	//	Another thread rescanned while this one waited
+#if defined(NTV2_DEPRECATE_17_1)
+	ScanHardware();
+#else	//	!defined(NTV2_DEPRECATE_17_1)
+	CNTV2DeviceScanner::ScanHardware();
+#endif	//	!defined(NTV2_DEPRECATE_17_1)
+}
+
+typedef bool (*NTV2DeviceMatcher) (const NTV2DeviceInfo & inInfo, const NTV2ScannedDevice & inScanned, const size_t inNdx, const void * pInContext);
+
+static bool MatchDeviceIndex (const NTV2DeviceInfo & inInfo, const NTV2ScannedDevice & inScanned, const size_t inNdx, const void * pInContext)
+{	(void) inInfo;  (void) inScanned;
+	return inNdx == size_t(*reinterpret_cast<const ULWord*>(pInContext));
+}
+
+static bool MatchDeviceID (const NTV2DeviceInfo & inInfo, const NTV2ScannedDevice & inScanned, const size_t inNdx, const void * pInContext)
+{	(void) inScanned;  (void) inNdx;
+	return inInfo.deviceID == *reinterpret_cast<const NTV2DeviceID*>(pInContext);
+}
+
+static bool MatchDeviceName (const NTV2DeviceInfo & inInfo, const NTV2ScannedDevice & inScanned, const size_t inNdx, const void * pInContext)
+{	(void) inScanned;  (void) inNdx;
+	string deviceName(inInfo.deviceIdentifier);  aja::lower(deviceName);
+	return deviceName.find(*reinterpret_cast<const string*>(pInContext)) != string::npos;
+}
+
+static bool MatchSerialString (const NTV2DeviceInfo & inInfo, const NTV2ScannedDevice & inScanned, const size_t inNdx, const void * pInContext)
+{	(void) inInfo;  (void) inNdx;
+	if (inScanned.serialStr.empty())
+		return false;
+	string serNumStr(inScanned.serialStr);  aja::lower(serNumStr);
+	return serNumStr.find(*reinterpret_cast<const string*>(pInContext)) != string::npos;
+}
+
+static bool MatchSerialNumber (const NTV2DeviceInfo & inInfo, const NTV2ScannedDevice & inScanned, const size_t inNdx, const void * pInContext)
+{	(void) inScanned;  (void) inNdx;
+	return inInfo.deviceSerialNumber == *reinterpret_cast<const uint64_t*>(pInContext);
+}
+
+//	Opens the first device in the cached list that matches. If none match and the list is more than kMissRescanMS old,
+//	or the matching device fails to open (it's gone since the list was scanned), or what opened isn't the device that
+//	was scanned (e.g. a hot-plug reassigned its index), rescans and tries once more.
+static bool OpenFirstMatchingDevice (NTV2DeviceMatcher inMatcher, const void * pInContext, CNTV2Card & outDevice)
+{
+	for (int attempt(0);  attempt < 2;  attempt++)
+	{
+		UpdateDeviceList();
+		bool found(false), old(false);
+		UWord index(0);
+		string urlSpec;
+		NTV2DeviceID deviceID(DEVICE_ID_INVALID);
+		uint64_t serialNum(0);
+		{
+			AJAAutoLock tmpLock(&sDevInfoListLock);
+			for (size_t ndx(0);  ndx < sDevInfoList.size()  &&  !found;  ndx++)
+				if ((*inMatcher)(sDevInfoList.at(ndx), sScannedDevList.at(ndx), ndx, pInContext))
+				{
+					found = true;
+					index = UWord(ndx);
+					urlSpec = sScannedDevList.at(ndx).urlSpec;
+					deviceID = sDevInfoList.at(ndx).deviceID;
+					serialNum = sDevInfoList.at(ndx).deviceSerialNumber;
+				}
+			old = AJATime::GetSystemMilliseconds() - sLastScanMS >= kMissRescanMS;
+		}
+		if (found)
+		{
+			if (urlSpec.empty() ? outDevice.Open(index) : outDevice.Open(urlSpec))
+			{
+				if (outDevice.GetDeviceID() == deviceID  &&  outDevice.GetSerialNumber() == serialNum)
+					return true;
+				outDevice.Close();	//	Stale cache entry -- not the device that was scanned
+			}
+		}
+		else if (!old)
+			break;	//	Not in a recently scanned list
+		CNTV2DeviceScanner::InvalidateDeviceList();
+	}
+	return false;
+}
+
 bool CNTV2DeviceScanner::GetDeviceAtIndex (const ULWord inDeviceIndexNumber, CNTV2Card & outDevice)
 {
 	outDevice.Close();
-	AJAAutoLock tmpLock(&sDevInfoListLock);
-	ScanHardware();
-	return size_t(inDeviceIndexNumber) < sDevInfoList.size()
-				? outDevice.Open(UWord(inDeviceIndexNumber))
-				: false;
+	return OpenFirstMatchingDevice(MatchDeviceIndex, &inDeviceIndexNumber, outDevice);
 
 }	//	GetDeviceAtIndex
 
@@ -286,12 +527,7 @@ bool CNTV2DeviceScanner::GetDeviceAtIndex (const ULWord inDeviceIndexNumber, CNT
 bool CNTV2DeviceScanner::GetFirstDeviceWithID (const NTV2DeviceID inDeviceID, CNTV2Card & outDevice)
 {
 	outDevice.Close();
-	AJAAutoLock tmpLock(&sDevInfoListLock);
-	ScanHardware();
-	for (size_t ndx(0);  ndx < sDevInfoList.size();  ndx++)
-		if (sDevInfoList.at(ndx).deviceID == inDeviceID)
-			return outDevice.Open(UWord(ndx));	//	Found!
-	return false;	//	Not found
+	return OpenFirstMatchingDevice(MatchDeviceID, &inDeviceID, outDevice);
 
 }	//	GetFirstDeviceWithID
 
@@ -306,24 +542,13 @@ bool CNTV2DeviceScanner::GetFirstDeviceWithName (const string & inNameSubString,
 		return false;
 	}
 
-	AJAAutoLock tmpLock(&sDevInfoListLock);
-	ScanHardware();
 	string	nameSubString(inNameSubString);  aja::lower(nameSubString);
-	for (size_t ndx(0);  ndx < sDevInfoList.size();  ndx++)
-	{
-		string deviceName(sDevInfoList.at(ndx).deviceIdentifier);  aja::lower(deviceName);
-		if (deviceName.find(nameSubString) != string::npos)
-			return outDevice.Open(UWord(ndx));	//	Found!
-	}
+	if (OpenFirstMatchingDevice(MatchDeviceName, &nameSubString, outDevice))
+		return true;	//	Found!
 	if (nameSubString == "io4kplus")
 	{	//	Io4K+ == DNXIV...
 		nameSubString = "avid dnxiv";
-		for (size_t ndx(0);  ndx < sDevInfoList.size();  ndx++)
-		{
-			string deviceName(sDevInfoList.at(ndx).deviceIdentifier);  aja::lower(deviceName);
-			if (deviceName.find(nameSubString) != string::npos)
-				return outDevice.Open(UWord(ndx));	//	Found!
-		}
+		return OpenFirstMatchingDevice(MatchDeviceName, &nameSubString, outDevice);
 	}
 	return false;	//	Not found
 
@@ -333,33 +558,15 @@ bool CNTV2DeviceScanner::GetFirstDeviceWithName (const string & inNameSubString,
 bool CNTV2DeviceScanner::GetFirstDeviceWithSerial (const string & inSerialStr, CNTV2Card & outDevice)
 {
 	outDevice.Close();
-	AJAAutoLock tmpLock(&sDevInfoListLock);
-	ScanHardware();
 	string searchSerialStr(inSerialStr);  aja::lower(searchSerialStr);
-	for (size_t ndx(0);  ndx < sDevInfoList.size();  ndx++)
-	{
-		CNTV2Card dev(UWord(ndx+0));
-		string serNumStr;
-		if (dev.GetSerialNumberString(serNumStr))
-		{
-			aja::lower(serNumStr);
-			if (serNumStr.find(searchSerialStr) != string::npos)
-				return outDevice.Open(UWord(ndx));
-		}
-	}
-	return false;
+	return OpenFirstMatchingDevice(MatchSerialString, &searchSerialStr, outDevice);
 }
 
 
 bool CNTV2DeviceScanner::GetDeviceWithSerial (const uint64_t inSerialNumber, CNTV2Card & outDevice)
 {
 	outDevice.Close();
-	AJAAutoLock tmpLock(&sDevInfoListLock);
-	ScanHardware();
-	for (size_t ndx(0);  ndx < sDevInfoList.size();  ndx++)
-		if (sDevInfoList.at(ndx).deviceSerialNumber == inSerialNumber)
-			return outDevice.Open(UWord(ndx));
-	return false;
+	return OpenFirstMatchingDevice(MatchSerialNumber, &inSerialNumber, outDevice);
 }
 
 
@@ -370,28 +577,32 @@ bool CNTV2DeviceScanner::GetFirstDeviceFromArgument (const string & inArgument,
 		return false;
 
 	//	Special case:  'LIST' or '?'  ---  print an enumeration of available devices to stdout, then bail
-	AJAAutoLock tmpLock(&sDevInfoListLock);
-	ScanHardware();
+	UpdateDeviceList();
+	NTV2DeviceInfoList devInfoList;
+	{
+		AJAAutoLock tmpLock(&sDevInfoListLock);
+		devInfoList = sDevInfoList;
+	}
 	string upperArg(inArgument);  aja::upper(upperArg);
 	if (upperArg == "LIST" || upperArg == "?")
 	{
-		if (sDevInfoList.empty())
+		if (devInfoList.empty())
 			cout << "No devices detected" << endl;
 		else
-			cout << DEC(sDevInfoList.size()) << " available " << (sDevInfoList.size() == 1 ? "device:" : "devices:") << endl;
-		for (size_t ndx(0);  ndx < sDevInfoList.size();  ndx++)
+			cout << DEC(devInfoList.size()) << " available " << (devInfoList.size() == 1 ? "device:" : "devices:") << endl;
+		for (size_t ndx(0);  ndx < devInfoList.size();  ndx++)
 		{
-			cout << DECN(ndx,2) << " | " << setw(8) << ::NTV2DeviceIDToString(sDevInfoList.at(ndx).deviceID);
-			const string serNum(CNTV2Card::SerialNum64ToString(sDevInfoList.at(ndx).deviceSerialNumber));
+			cout << DECN(ndx,2) << " | " << setw(8) << ::NTV2DeviceIDToString(devInfoList.at(ndx).deviceID);
+			const string serNum(CNTV2Card::SerialNum64ToString(devInfoList.at(ndx).deviceSerialNumber));
 			if (!serNum.empty())
-				cout << " | " << setw(9) << serNum << " | " << HEX0N(sDevInfoList.at(ndx).deviceSerialNumber,8);
+				cout << " | " << setw(9) << serNum << " | " << HEX0N(devInfoList.at(ndx).deviceSerialNumber,8);
 			cout << endl;
 		}
 #if defined(VIRTUAL_DEVICES_SUPPORT)
-		if (iter != sDevInfoList.end())
+		if (iter != devInfoList.end())
 		{
 			cout << "*** Virtual Devices ***" << endl;
-			while (iter != sDevInfoList.end())
+			while (iter != devInfoList.end())
 			{
 				const string serNum(CNTV2Card::SerialNum64ToString(iter->deviceSerialNumber));
 				cout << DECN(iter->deviceIndex,2) << " | " << setw(15) << iter->virtualDeviceName;// NTV2DeviceIDToString(iter->deviceID);
@@ -413,7 +624,7 @@ bool CNTV2DeviceScanner::GetFirstDeviceFromArgument (const string & inArgument,
 	string cp2ConfigPath;
 	GetCP2ConfigPath(cp2ConfigPath);  
 	std::ifstream cfgJsonfile(cp2ConfigPath);  //VDTODO, error handling
-	for (NTV2DeviceInfoListConstIter iter(sDevInfoList.begin());  iter != sDevInfoList.end();  ++iter)
+	for (NTV2DeviceInfoListConstIter iter(devInfoList.begin());  iter != devInfoList.end();  ++iter)
 	{
 		if (iter->isVirtualDevice)
 		{
@@ -80,6 +80,9 @@ CNTV2DriverInterface::CNTV2DriverInterface ()
 		_pRPCAPI						(AJA_NULL),
 		mInterruptEventHandles			(),
 		mEventCounts					(),
+		mpAccessProfiler				(AJA_NULL),
+		mAccessProfiling				(false),
+		mAccessProfilerLock				(),
 #if defined(NTV2_WRITEREG_PROFILING)
 		mRegWrites						(),
 		mRegWritesLock					(),
@@ -114,6 +117,9 @@ CNTV2DriverInterface::~CNTV2DriverInterface ()
 	if (_pRPCAPI)
 		delete _pRPCAPI;
 	_pRPCAPI = AJA_NULL;
+	mAccessProfiling.Clear();
+	delete mpAccessProfiler;
+	mpAccessProfiler = AJA_NULL;
 	DIDBGX(DEC(gConstructCount) << " constructed, " << DEC(gDestructCount) << " destroyed");
 }	//	destructor
 
@@ -1334,6 +1340,42 @@ bool CNTV2DriverInterface::IsMBSystemReady (void)
 	}
 #endif	//	NTV2_WRITEREG_PROFILING
 
+bool CNTV2DriverInterface::StartAccessProfiling (const bool inReset)
+{
+	AJAAutoLock autoLock(&mAccessProfilerLock);	//	In case two threads start profiling at once
+	if (!mpAccessProfiler)
+		mpAccessProfiler = new NTV2AccessProfiler;
+	else if (inReset)
+		mpAccessProfiler->Reset();	//	Safe even while other threads are still recording
+	mAccessProfiling.Set();
+	DIDBG("Started");
+	return true;
+}
+
+bool CNTV2DriverInterface::StopAccessProfiling (void)
+{
+	AJAAutoLock autoLock(&mAccessProfilerLock);
+	if (!mAccessProfiling.IsSet())
+		return false;	//	Not profiling
+	mAccessProfiling.Clear();
+	if (AJADebug::IsActive(AJA_DebugUnit_DriverInterface))
+	{	NTV2AccessProfile profile;
+		mpAccessProfiler->GetProfile(profile);
+		ostringstream oss;  profile.Print(oss, 20);
+		DIINFO(oss.str());
+	}
+	return true;
+}
+
+bool CNTV2DriverInterface::GetAccessProfile (NTV2AccessProfile & outProfile) const
+{
+	AJAAutoLock autoLock(&mAccessProfilerLock);
+	if (!mpAccessProfiler)
+		return false;	//	Never started
+	mpAccessProfiler->GetProfile(outProfile);
+	return true;
+}
+
 
 ULWordSet CNTV2DriverInterface::GetSupportedItems (const NTV2EnumsID inEnumsID)
 {
@@ -0,0 +1,506 @@
+/* SPDX-License-Identifier: MIT */
+/**
+	@file		ntv2frameshare.cpp
+	@brief		Implements the CNTV2FramePublisher and CNTV2FrameSubscriber classes.
+	@copyright	(C) 2023 AJA Video Systems, Inc.
+**/
+
+#include "ntv2frameshare.h"
+#include "ntv2utils.h"
+#include "ajabase/system/atomic.h"
+#include "ajabase/system/debug.h"
+#include "ajabase/system/memory.h"
+#include "ajabase/system/process.h"
+#include "ajabase/system/systemtime.h"
+#include <algorithm>
+
+using namespace std;
+
+#define INSTP(_p_)			xHEX0N(uint64_t(_p_),16)
+#define	FSFAIL(__x__)		AJA_sERROR  (AJA_DebugUnit_DriverInterface, INSTP(this) << "::" << AJAFUNC << ": " << __x__)
+#define	FSWARN(__x__)		AJA_sWARNING(AJA_DebugUnit_DriverInterface, INSTP(this) << "::" << AJAFUNC << ": " << __x__)
+#define	FSNOTE(__x__)		AJA_sNOTICE (AJA_DebugUnit_DriverInterface, INSTP(this) << "::" << AJAFUNC << ": " << __x__)
+#define	FSINFO(__x__)		AJA_sINFO   (AJA_DebugUnit_DriverInterface, INSTP(this) << "::" << AJAFUNC << ": " << __x__)
+#define	FSDBG(__x__)		AJA_sDEBUG  (AJA_DebugUnit_DriverInterface, INSTP(this) << "::" << AJAFUNC << ": " << __x__)
+
+
+/*****************************************************************************************************************************
+	SHARED RING LAYOUT:
+	[RingHeader][ReaderEntry x fMaxReaders]...[Slot 0][Slot 1]...[Slot fNumSlots-1]
+	Each slot (page-aligned):	[SlotHeader][video][audio][anc F1][anc F2]	(each part page-aligned)
+
+	There's one writer (the publisher). Frame N goes into slot N % fNumSlots. The publisher stores N into the slot's
+	fWriting before touching its data, stores N into fSeq when done, then bumps fWriteSeq to N+1. A reader that finds
+	fSeq == fWriting == N has frame N, and it stays good for as long as fWriting remains N (a seqlock).
+	Each reader owns one ReaderEntry, which only it writes, and which the publisher reads for statistics.
+*****************************************************************************************************************************/
+
+static const uint32_t	kRingMagic		(NTV2_FOURCC('N','F','R','G'));
+static const uint32_t	kRingVersion	(1);
+static const uint64_t	kNoFrame		(~0ULL);
+
+typedef struct RingHeader
+{
+	uint32_t			fMagic;			//	kRingMagic
+	uint32_t			fVersion;		//	kRingVersion
+	uint32_t			fNumSlots;
+	uint32_t			fMaxReaders;
+	uint32_t			fVideoBytes;
+	uint32_t			fAudioBytes;
+	uint32_t			fAncBytes;
+	uint32_t			fAncF2Bytes;
+	uint64_t			fTotalBytes;	//	Size of entire ring
+	uint64_t			fSlotBytes;		//	Size of each slot
+	uint64_t			fSlotsOffset;	//	Offset to slot 0
+	volatile uint64_t	fWriteSeq;		//	Sequence number of the next frame to be published
+	volatile uint64_t	fPublisherPID;	//	Zero if no publisher
+} RingHeader;
+
+typedef struct ReaderEntry
+{
+	volatile uint64_t	fPID;			//	Zero if unused
+	volatile uint64_t	fCursor;		//	Sequence number of the next frame to read
+	volatile uint64_t	fFramesRead;
+	volatile uint64_t	fFramesDropped;
+} ReaderEntry;
+
+typedef struct SlotHeader
+{
+	volatile uint64_t	fWriting;		//	Sequence number last written (or being written) into this slot
+	volatile uint64_t	fSeq;			//	Sequence number of the completed frame in this slot
+	uint32_t			fVideoBytes;
+	uint32_t			fAudioBytes;
+	uint32_t			fAncBytes;
+	uint32_t			fAncF2Bytes;
+	FRAME_STAMP_STRUCT	fFrameStamp;
+	UByte				fTimeCodes[NTV2_MAX_NUM_TIMECODE_INDEXES * sizeof(NTV2_RP188)];	//	NTV2_RP188s, in NTV2TCIndex order
+} SlotHeader;
+
+static inline uint64_t	PageRound (const uint64_t inBytes)		{return (inBytes + AJA_PAGE_SIZE - 1) / AJA_PAGE_SIZE * AJA_PAGE_SIZE;}
+static inline uint64_t	AtomicLoad (volatile uint64_t * pValue)	{return AJAAtomic::Add(pValue, 0);}	//	Full barrier
+static inline void		AtomicStore (volatile uint64_t * pValue, const uint64_t inValue)	{AJAAtomic::Exchange(pValue, inValue);}
+
+static inline RingHeader *	Header (UByte * pRing)		{return reinterpret_cast<RingHeader*>(pRing);}
+static inline ReaderEntry *	Reader (UByte * pRing, const ULWord inNdx)
+{
+	return reinterpret_cast<ReaderEntry*>(pRing + sizeof(RingHeader)) + inNdx;
+}
+static inline SlotHeader *	Slot (UByte * pRing, const uint64_t inSeq)
+{
+	const RingHeader & hdr (*Header(pRing));
+	return reinterpret_cast<SlotHeader*>(pRing + hdr.fSlotsOffset + (inSeq % hdr.fNumSlots) * hdr.fSlotBytes);
+}
+static inline uint64_t	VideoOffset (void)						{return PageRound(sizeof(SlotHeader));}
+static inline uint64_t	AudioOffset (const RingHeader & inHdr)	{return VideoOffset() + PageRound(inHdr.fVideoBytes);}
+static inline uint64_t	AncOffset (const RingHeader & inHdr)	{return AudioOffset(inHdr) + PageRound(inHdr.fAudioBytes);}
+static inline uint64_t	AncF2Offset (const RingHeader & inHdr)	{return AncOffset(inHdr) + PageRound(inHdr.fAncBytes);}
+static inline UByte *	SlotData (SlotHeader * pSlot, const uint64_t inOffset)	{return reinterpret_cast<UByte*>(pSlot) + inOffset;}
+
+static bool HeaderMatches (const RingHeader & inHdr, const NTV2FrameRingConfig & inConfig)
+{
+	return inHdr.fMagic == kRingMagic  &&  inHdr.fVersion == kRingVersion
+		&&  inHdr.fNumSlots == inConfig.fNumSlots  &&  inHdr.fMaxReaders == inConfig.fMaxReaders
+		&&  inHdr.fVideoBytes == inConfig.fVideoBytes  &&  inHdr.fAudioBytes == inConfig.fAudioBytes
+		&&  inHdr.fAncBytes == inConfig.fAncBytes  &&  inHdr.fAncF2Bytes == inConfig.fAncF2Bytes;
+}
+
+static void RingConfig (const RingHeader & inHdr, NTV2FrameRingConfig & outConfig)
+{
+	outConfig = NTV2FrameRingConfig(inHdr.fVideoBytes, inHdr.fAudioBytes, inHdr.fAncBytes, inHdr.fAncF2Bytes, inHdr.fNumSlots, inHdr.fMaxReaders);
+}
+
+static void ReaderStats (UByte * pRing, const ULWord inNdx, NTV2FrameRingReaderStats & outStats)
+{
+	ReaderEntry & reader (*Reader(pRing, inNdx));
+	const uint64_t writeSeq (AtomicLoad(&Header(pRing)->fWriteSeq)),  cursor (AtomicLoad(&reader.fCursor));
+	outStats.fReaderIndex	= inNdx;
+	outStats.fProcessID		= reader.fPID;
+	outStats.fFramesRead	= reader.fFramesRead;
+	outStats.fFramesDropped	= reader.fFramesDropped;
+	outStats.fLag			= writeSeq > cursor ? writeSeq - cursor : 0;
+}
+
+
+NTV2FrameRingConfig::NTV2FrameRingConfig (const ULWord inVideoBytes, const ULWord inAudioBytes, const ULWord inAncBytes,
+											const ULWord inAncF2Bytes, const ULWord inNumSlots, const ULWord inMaxReaders)
+	:	fNumSlots	(inNumSlots),
+		fMaxReaders	(inMaxReaders),
+		fVideoBytes	(inVideoBytes),
+		fAudioBytes	(inAudioBytes),
+		fAncBytes	(inAncBytes),
+		fAncF2Bytes	(inAncF2Bytes)
+{
+}
+
+bool NTV2FrameRingConfig::IsValid (void) const
+{
+	return fNumSlots >= 2  &&  fMaxReaders  &&  fVideoBytes;
+}
+
+
+NTV2SharedFrame::NTV2SharedFrame ()
+	:	fSequence	(kNoFrame),
+		fVideo		(AJA_NULL),
+		fVideoBytes	(0),
+		fAudio		(AJA_NULL),
+		fAudioBytes	(0),
+		fAnc		(AJA_NULL),
+		fAncBytes	(0),
+		fAncF2		(AJA_NULL),
+		fAncF2Bytes	(0),
+		fpSlot		(AJA_NULL)
+{
+}
+
+
+ostream & NTV2FrameRingReaderStats::Print (ostream & oss) const
+{
+	oss << "reader " << DEC(fReaderIndex) << " pid " << DEC(fProcessID) << ": " << DEC(fFramesRead) << " read, "
+		<< DEC(fFramesDropped) << " dropped, " << DEC(fLag) << " behind";
+	return oss;
+}
+
+
+CNTV2FramePublisher::CNTV2FramePublisher ()
+	:	mpRing			(AJA_NULL),
+		mConfig			(),
+		mSlotAcquired	(false)
+{
+}
+
+CNTV2FramePublisher::~CNTV2FramePublisher ()
+{
+	Close();
+}
+
+bool CNTV2FramePublisher::Create (const string & inRingName, const NTV2FrameRingConfig & inConfig)
+{
+	Close();
+	if (!inConfig.IsValid())
+		{FSFAIL("Invalid config for '" << inRingName << "'");  return false;}
+
+	const uint64_t slotBytes (PageRound(sizeof(SlotHeader)) + PageRound(inConfig.fVideoBytes)
+								+ PageRound(inConfig.fAudioBytes) + PageRound(inConfig.fAncBytes) + PageRound(inConfig.fAncF2Bytes));
+	const uint64_t slotsOffset (PageRound(sizeof(RingHeader) + inConfig.fMaxReaders * sizeof(ReaderEntry)));
+	const uint64_t totalBytes (slotsOffset + slotBytes * inConfig.fNumSlots);
+	size_t sizeInBytes = size_t(totalBytes);
+	UByte * pRing (reinterpret_cast<UByte*>(AJAMemory::AllocateShared(&sizeInBytes, inRingName.c_str())));
+	if (!pRing)
+		{FSFAIL("AJAMemory::AllocateShared failed for " << DEC(totalBytes) << "-byte ring '" << inRingName << "'");  return false;}
+	if (sizeInBytes < totalBytes)
+	{
+		FSFAIL("Ring '" << inRingName << "' exists, but is only " << DEC(sizeInBytes) << " bytes -- need " << DEC(totalBytes));
+		AJAMemory::FreeShared(pRing);
+		return false;
+	}
+
+	RingHeader & hdr (*Header(pRing));
+	const uint64_t myPID (AJAProcess::GetPid()),  otherPID (hdr.fPublisherPID);
+	if (hdr.fMagic == kRingMagic  &&  otherPID  &&  otherPID != myPID  &&  AJAProcess::IsValid(otherPID))
+	{
+		FSFAIL("Ring '" << inRingName << "' already has a publisher, pid " << DEC(otherPID));
+		AJAMemory::FreeShared(pRing);
+		return false;
+	}
+	if (!HeaderMatches(hdr, inConfig)  ||  hdr.fTotalBytes != totalBytes)
+	{	//	New ring, or its shape changed -- start over
+		::memset(pRing, 0, size_t(slotsOffset));
+		hdr.fNumSlots		= inConfig.fNumSlots;
+		hdr.fMaxReaders		= inConfig.fMaxReaders;
+		hdr.fVideoBytes		= inConfig.fVideoBytes;
+		hdr.fAudioBytes		= inConfig.fAudioBytes;
+		hdr.fAncBytes		= inConfig.fAncBytes;
+		hdr.fAncF2Bytes		= inConfig.fAncF2Bytes;
+		hdr.fTotalBytes		= totalBytes;
+		hdr.fSlotBytes		= slotBytes;
+		hdr.fSlotsOffset	= slotsOffset;
+		for (ULWord ndx(0);  ndx < inConfig.fNumSlots;  ndx++)
+		{
+			SlotHeader & slot (*reinterpret_cast<SlotHeader*>(pRing + slotsOffset + ndx * slotBytes));
+			::memset(&slot, 0, sizeof(slot));
+			slot.fWriting = slot.fSeq = kNoFrame;
+		}
+		hdr.fVersion = kRingVersion;
+		AtomicStore(&hdr.fWriteSeq, 0);
+		AJAAtomic::Exchange(&hdr.fMagic, kRingMagic);	//	Now readers can attach
+		FSINFO("Created " << DEC(totalBytes/1024/1024) << "MB ring '" << inRingName << "' with " << DEC(inConfig.fNumSlots) << " slots");
+	}
+	else
+		FSINFO("Re-attached to ring '" << inRingName << "' at frame " << DEC(hdr.fWriteSeq));
+	AtomicStore(&hdr.fPublisherPID, myPID);
+	mpRing = pRing;
+	mConfig = inConfig;
+	return true;
+}
+
+void CNTV2FramePublisher::Close (void)
+{
+	if (!mpRing)
+		return;
+	AtomicStore(&Header(mpRing)->fPublisherPID, 0);
+	AJAMemory::FreeShared(mpRing);
+	mpRing = AJA_NULL;
+	mSlotAcquired = false;
+}
+
+bool CNTV2FramePublisher::AcquireSlot (AUTOCIRCULATE_TRANSFER & inOutXfer)
+{
+	if (!mpRing)
+		return false;
+	RingHeader & hdr (*Header(mpRing));
+	const uint64_t seq (hdr.fWriteSeq);
+	SlotHeader * pSlot (Slot(mpRing, seq));
+	AtomicStore(&pSlot->fWriting, seq);	//	Invalidates readers of the slot's previous frame
+	if (!inOutXfer.SetVideoBuffer(reinterpret_cast<ULWord*>(SlotData(pSlot, VideoOffset())), hdr.fVideoBytes))
+		return false;
+	if (!inOutXfer.SetAudioBuffer(hdr.fAudioBytes ? reinterpret_cast<ULWord*>(SlotData(pSlot, AudioOffset(hdr))) : AJA_NULL, hdr.fAudioBytes))
+		return false;
+	if (!inOutXfer.SetAncBuffers(hdr.fAncBytes ? reinterpret_cast<ULWord*>(SlotData(pSlot, AncOffset(hdr))) : AJA_NULL, hdr.fAncBytes,
+								hdr.fAncF2Bytes ? reinterpret_cast<ULWord*>(SlotData(pSlot, AncF2Offset(hdr))) : AJA_NULL, hdr.fAncF2Bytes))
+		return false;
+	mSlotAcquired = true;
+	return true;
+}
+
+bool CNTV2FramePublisher::PublishSlot (const AUTOCIRCULATE_TRANSFER & inXfer)
+{
+	if (!mpRing  ||  !mSlotAcquired)
+		{FSFAIL("No slot acquired");  return false;}
+	const AUTOCIRCULATE_TRANSFER_STATUS & status (inXfer.GetTransferStatus());
+	NTV2Buffer audio, anc, ancF2;	//	These reference the slot, so Commit won't copy them
+	audio.Set(inXfer.acAudioBuffer.GetHostPointer(), status.GetCapturedAudioByteCount());
+	anc.Set(inXfer.acANCBuffer.GetHostPointer(), status.GetCapturedAncByteCount(false));
+	ancF2.Set(inXfer.acANCField2Buffer.GetHostPointer(), status.GetCapturedAncByteCount(true));
+	mSlotAcquired = false;
+	return Commit(audio, anc, ancF2, inXfer.acVideoBuffer.GetByteCount(), status.GetFrameStamp());
+}
+
+bool CNTV2FramePublisher::Publish (const AUTOCIRCULATE_TRANSFER & inXfer)
+{
+	const AUTOCIRCULATE_TRANSFER_STATUS & status (inXfer.GetTransferStatus());
+	NTV2Buffer audio, anc, ancF2;
+	audio.Set(inXfer.acAudioBuffer.GetHostPointer(), std::min(status.GetCapturedAudioByteCount(), inXfer.acAudioBuffer.GetByteCount()));
+	anc.Set(inXfer.acANCBuffer.GetHostPointer(), std::min(status.GetCapturedAncByteCount(false), inXfer.acANCBuffer.GetByteCount()));
+	ancF2.Set(inXfer.acANCField2Buffer.GetHostPointer(), std::min(status.GetCapturedAncByteCount(true), inXfer.acANCField2Buffer.GetByteCount()));
+	return Publish(inXfer.acVideoBuffer, audio, anc, ancF2, status.GetFrameStamp());
+}
+
+bool CNTV2FramePublisher::Publish (const NTV2Buffer & inVideo, const NTV2Buffer & inAudio, const NTV2Buffer & inAnc,
+									const NTV2Buffer & inAncF2, const FRAME_STAMP & inFrameStamp)
+{
+	if (!mpRing)
+		return false;
+	if (mSlotAcquired)
+		{FSFAIL("AcquireSlot called without PublishSlot");  return false;}
+	RingHeader & hdr (*Header(mpRing));
+	const uint64_t seq (hdr.fWriteSeq);
+	SlotHeader * pSlot (Slot(mpRing, seq));
+	AtomicStore(&pSlot->fWriting, seq);	//	Invalidates readers of the slot's previous frame
+	const ULWord videoBytes (std::min(inVideo.GetByteCount(), hdr.fVideoBytes));
+	if (videoBytes)
+		::memcpy(SlotData(pSlot, VideoOffset()), inVideo.GetHostPointer(), videoBytes);
+	return Commit(inAudio, inAnc, inAncF2, videoBytes, inFrameStamp);
+}
+
+bool CNTV2FramePublisher::Commit (const NTV2Buffer & inAudio, const NTV2Buffer & inAnc, const NTV2Buffer & inAncF2,
+									const ULWord inVideoBytes, const FRAME_STAMP & inFrameStamp)
+{
+	RingHeader & hdr (*Header(mpRing));
+	const uint64_t seq (hdr.fWriteSeq);
+	SlotHeader * pSlot (Slot(mpRing, seq));
+	const NTV2Buffer * pBuffers[3]	= {&inAudio,			&inAnc,				&inAncF2};
+	const uint64_t offsets[3]		= {AudioOffset(hdr),	AncOffset(hdr),		AncF2Offset(hdr)};
+	const uint32_t capacities[3]	= {hdr.fAudioBytes,		hdr.fAncBytes,		hdr.fAncF2Bytes};
+	uint32_t * pByteCounts[3]		= {&pSlot->fAudioBytes,	&pSlot->fAncBytes,	&pSlot->fAncF2Bytes};
+	for (size_t ndx(0);  ndx < 3;  ndx++)
+	{
+		const ULWord bytes (std::min(pBuffers[ndx]->GetByteCount(), capacities[ndx]));
+		UByte * pDst (SlotData(pSlot, offsets[ndx]));
+		if (bytes  &&  pBuffers[ndx]->GetHostPointer() != pDst)
+			::memcpy(pDst, pBuffers[ndx]->GetHostPointer(), bytes);
+		*pByteCounts[ndx] = bytes;
+	}
+	pSlot->fVideoBytes = inVideoBytes;
+	inFrameStamp.CopyTo(pSlot->fFrameStamp);
+	::memset(pSlot->fTimeCodes, 0xFF, sizeof(pSlot->fTimeCodes));	//	Invalid timecodes
+	if (inFrameStamp.acTimeCodes)
+		::memcpy(pSlot->fTimeCodes, inFrameStamp.acTimeCodes.GetHostPointer(),
+				std::min(size_t(inFrameStamp.acTimeCodes.GetByteCount()), sizeof(pSlot->fTimeCodes)));
+	AtomicStore(&pSlot->fSeq, seq);
+	AtomicStore(&hdr.fWriteSeq, seq + 1);	//	Publish
+	return true;
+}
+
+ULWord64 CNTV2FramePublisher::GetPublishedCount (void) const
+{
+	return mpRing ? AtomicLoad(&Header(mpRing)->fWriteSeq) : 0;
+}
+
+bool CNTV2FramePublisher::GetReaderStats (NTV2FrameRingReaderStatsList & outStats) const
+{
+	outStats.clear();
+	if (!mpRing)
+		return false;
+	for (ULWord ndx(0);  ndx < mConfig.fMaxReaders;  ndx++)
+		if (Reader(mpRing, ndx)->fPID)
+		{
+			NTV2FrameRingReaderStats stats;
+			ReaderStats(mpRing, ndx, stats);
+			outStats.push_back(stats);
+		}
+	return true;
+}
+
+
+CNTV2FrameSubscriber::CNTV2FrameSubscriber ()
+	:	mpRing			(AJA_NULL),
+		mReaderIndex	(0)
+{
+}
+
+CNTV2FrameSubscriber::~CNTV2FrameSubscriber ()
+{
+	Close();
+}
+
+bool CNTV2FrameSubscriber::Open (const string & inRingName)
+{
+	Close();
+	//	Map just the header first, to learn the ring's size...
+	size_t sizeInBytes (AJA_PAGE_SIZE);
+	UByte * pRing (reinterpret_cast<UByte*>(AJAMemory::AllocateShared(&sizeInBytes, inRingName.c_str())));
+	if (!pRing)
+		{FSFAIL("AJAMemory::AllocateShared failed for ring '" << inRingName << "'");  return false;}
+	if (*reinterpret_cast<volatile uint32_t*>(&Header(pRing)->fMagic) != kRingMagic)
+		{FSWARN("Ring '" << inRingName << "' not yet created");  AJAMemory::FreeShared(pRing);  return false;}
+	const uint64_t totalBytes (Header(pRing)->fTotalBytes);
+	if (sizeInBytes < totalBytes)
+	{	//	...then map all of it
+		AJAMemory::FreeShared(pRing);
+		sizeInBytes = size_t(totalBytes);
+		pRing = reinterpret_cast<UByte*>(AJAMemory::AllocateShared(&sizeInBytes, inRingName.c_str()));
+		if (!pRing)
+			{FSFAIL("AJAMemory::AllocateShared failed for " << DEC(totalBytes) << "-byte ring '" << inRingName << "'");  return false;}
+		if (sizeInBytes < totalBytes)
+			{FSFAIL("Ring '" << inRingName << "' is " << DEC(sizeInBytes) << " bytes, expected " << DEC(totalBytes));  AJAMemory::FreeShared(pRing);  return false;}
+	}
+
+	//	Claim a free reader entry (or one abandoned by a process that's gone)...
+	RingHeader & hdr (*Header(pRing));
+	const uint64_t myPID (AJAProcess::GetPid());
+	for (ULWord ndx(0);  ndx < hdr.fMaxReaders;  ndx++)
+	{
+		ReaderEntry & reader (*Reader(pRing, ndx));
+		const uint64_t pid (reader.fPID);
+		if (pid  &&  AJAProcess::IsValid(pid))
+			continue;	//	In use
+		if (AJAAtomic::CompareAndSwap(&reader.fPID, pid, myPID) != pid)
+			continue;	//	Lost race
+		AtomicStore(&reader.fFramesRead, 0);
+		AtomicStore(&reader.fFramesDropped, 0);
+		AtomicStore(&reader.fCursor, AtomicLoad(&hdr.fWriteSeq));	//	Start with the next frame published
+		mpRing = pRing;
+		mReaderIndex = ndx;
+		FSINFO("Attached to ring '" << inRingName << "' as reader " << DEC(ndx) << " at frame " << DEC(reader.fCursor));
+		return true;
+	}
+	FSFAIL("Ring '" << inRingName << "' has no free reader slots (max " << DEC(hdr.fMaxReaders) << ")");
+	AJAMemory::FreeShared(pRing);
+	return false;
+}
+
+void CNTV2FrameSubscriber::Close (void)
+{
+	if (!mpRing)
+		return;
+	AtomicStore(&Reader(mpRing, mReaderIndex)->fPID, 0);
+	AJAMemory::FreeShared(mpRing);
+	mpRing = AJA_NULL;
+	mReaderIndex = 0;
+}
+
+bool CNTV2FrameSubscriber::GetConfig (NTV2FrameRingConfig & outConfig) const
+{
+	if (!mpRing)
+		return false;
+	RingConfig(*Header(mpRing), outConfig);
+	return true;
+}
+
+bool CNTV2FrameSubscriber::NextFrame (NTV2SharedFrame & outFrame, const ULWord inTimeoutMs)
+{
+	outFrame = NTV2SharedFrame();
+	if (!mpRing)
+		return false;
+	RingHeader & hdr (*Header(mpRing));
+	ReaderEntry & reader (*Reader(mpRing, mReaderIndex));
+	const uint64_t deadline (AJATime::GetSystemMilliseconds() + inTimeoutMs);
+	do
+	{
+		const uint64_t writeSeq (AtomicLoad(&hdr.fWriteSeq));
+		uint64_t cursor (reader.fCursor);
+		if (cursor < writeSeq)
+		{	//	The slot for writeSeq may be getting written now, so the oldest usable frame is writeSeq - (fNumSlots-1)
+			const uint64_t oldest (writeSeq >= hdr.fNumSlots ? writeSeq - hdr.fNumSlots + 1 : 0);
+			if (cursor < oldest)
+			{
+				AJAAtomic::Add(&reader.fFramesDropped, oldest - cursor);
+				cursor = oldest;
+			}
+			SlotHeader * pSlot (Slot(mpRing, cursor));
+			if (AtomicLoad(&pSlot->fSeq) != cursor  ||  AtomicLoad(&pSlot->fWriting) != cursor)
+			{	//	Lapped while looking -- skip ahead
+				AtomicStore(&reader.fCursor, cursor);
+				continue;
+			}
+			outFrame.fSequence		= cursor;
+			outFrame.fVideo			= SlotData(pSlot, VideoOffset());
+			outFrame.fVideoBytes	= pSlot->fVideoBytes;
+			outFrame.fAudio			= pSlot->fAudioBytes ? SlotData(pSlot, AudioOffset(hdr)) : AJA_NULL;
+			outFrame.fAudioBytes	= pSlot->fAudioBytes;
+			outFrame.fAnc			= pSlot->fAncBytes ? SlotData(pSlot, AncOffset(hdr)) : AJA_NULL;
+			outFrame.fAncBytes		= pSlot->fAncBytes;
+			outFrame.fAncF2			= pSlot->fAncF2Bytes ? SlotData(pSlot, AncF2Offset(hdr)) : AJA_NULL;
+			outFrame.fAncF2Bytes	= pSlot->fAncF2Bytes;
+			outFrame.fpSlot			= pSlot;
+			AtomicStore(&reader.fCursor, cursor + 1);
+			AJAAtomic::Increment(&reader.fFramesRead);
+			return true;
+		}
+		if (!inTimeoutMs)
+			break;
+		AJATime::SleepInMicroseconds(250);
+	} while (AJATime::GetSystemMilliseconds() < deadline);
+	return false;
+}
+
+bool CNTV2FrameSubscriber::IsFrameValid (const NTV2SharedFrame & inFrame) const
+{
+	if (!mpRing  ||  !inFrame.fpSlot)
+		return false;
+	SlotHeader * pSlot (reinterpret_cast<SlotHeader*>(const_cast<void*>(inFrame.fpSlot)));
+	return AtomicLoad(&pSlot->fWriting) == inFrame.fSequence;
+}
+
+bool CNTV2FrameSubscriber::GetFrameStamp (const NTV2SharedFrame & inFrame, FRAME_STAMP & outFrameStamp) const
+{
+	if (!IsFrameValid(inFrame))
+		return false;
+	const SlotHeader * pSlot (reinterpret_cast<const SlotHeader*>(inFrame.fpSlot));
+	if (!outFrameStamp.SetFrom(pSlot->fFrameStamp))
+		return false;
+	if (outFrameStamp.acTimeCodes.GetByteCount() < sizeof(pSlot->fTimeCodes))
+		if (!outFrameStamp.acTimeCodes.Allocate(sizeof(pSlot->fTimeCodes)))
+			return false;
+	::memcpy(outFrameStamp.acTimeCodes.GetHostPointer(), pSlot->fTimeCodes, sizeof(pSlot->fTimeCodes));
+	return IsFrameValid(inFrame);	//	Still good?
+}
+
+bool CNTV2FrameSubscriber::GetStats (NTV2FrameRingReaderStats & outStats) const
+{
+	outStats = NTV2FrameRingReaderStats();
+	if (!mpRing)
+		return false;
+	ReaderStats(mpRing, mReaderIndex, outStats);
+	return true;
+}
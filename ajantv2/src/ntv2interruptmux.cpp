@@ -0,0 +1,250 @@
+/* SPDX-License-Identifier: MIT */
+/**
+	@file		ntv2interruptmux.cpp
+	@brief		Implements the CNTV2VerticalInterruptMux class.
+	@copyright	(C) 2023 AJA Video Systems, Inc.
+**/
+
+#include "ntv2interruptmux.h"
+#include "ntv2utils.h"
+#include "ntv2debug.h"
+#include "ajabase/system/debug.h"
+#include "ajabase/system/systemtime.h"
+#if defined(AJA_LINUX)
+	#include <sys/eventfd.h>
+	#include <unistd.h>
+	#include <fcntl.h>
+#elif defined(AJA_MAC)
+	#include <unistd.h>
+	#include <fcntl.h>
+#endif
+
+using namespace std;
+
+#define INSTP(_p_)			xHEX0N(uint64_t(_p_),16)
+#define	VIMFAIL(__x__)		AJA_sERROR  (AJA_DebugUnit_DriverInterface, INSTP(this) << "::" << AJAFUNC << ": " << __x__)
+#define	VIMWARN(__x__)		AJA_sWARNING(AJA_DebugUnit_DriverInterface, INSTP(this) << "::" << AJAFUNC << ": " << __x__)
+#define	VIMINFO(__x__)		AJA_sINFO   (AJA_DebugUnit_DriverInterface, INSTP(this) << "::" << AJAFUNC << ": " << __x__)
+#define	VIMDBG(__x__)		AJA_sDEBUG  (AJA_DebugUnit_DriverInterface, INSTP(this) << "::" << AJAFUNC << ": " << __x__)
+
+
+ostream & operator << (ostream & oss, const NTV2VerticalEvent & inObj)
+{
+	oss << (inObj.fIsInput ? "In" : "Out") << DEC(inObj.fChannel+1) << ":" << DEC(inObj.fCount) << "/" << DEC(inObj.fTotalCount);
+	return oss;
+}
+
+
+CNTV2VerticalInterruptMux::CNTV2VerticalInterruptMux (CNTV2Card & inDevice)
+	:	mDevice			(inDevice),
+		mWaiters		(),
+		mInputs			(),
+		mOutputs		(),
+		mLock			(),
+		mPendingEvent	(true),	//	manual reset
+		mReadFD			(-1),
+		mWriteFD		(-1),
+		mWaitTimeoutMs	(68),
+		mQuit			(false)
+{
+#if defined(AJA_LINUX)
+	mReadFD = mWriteFD = ::eventfd(0, EFD_NONBLOCK | EFD_CLOEXEC);
+	if (mReadFD < 0)
+		VIMWARN("eventfd failed -- GetFileDescriptor will return -1");
+#elif defined(AJA_MAC)
+	int fds[2] = {-1, -1};
+	if (::pipe(fds) == 0)
+	{
+		for (int ndx(0);  ndx < 2;  ndx++)
+		{
+			::fcntl(fds[ndx], F_SETFL, ::fcntl(fds[ndx], F_GETFL) | O_NONBLOCK);
+			::fcntl(fds[ndx], F_SETFD, FD_CLOEXEC);
+		}
+		mReadFD = fds[0];  mWriteFD = fds[1];
+	}
+	else VIMWARN("pipe failed -- GetFileDescriptor will return -1");
+#endif
+}
+
+
+CNTV2VerticalInterruptMux::~CNTV2VerticalInterruptMux ()
+{
+	Stop();
+#if defined(AJA_LINUX) || defined(AJA_MAC)
+	if (mWriteFD >= 0  &&  mWriteFD != mReadFD)
+		::close(mWriteFD);
+	if (mReadFD >= 0)
+		::close(mReadFD);
+#endif
+	mReadFD = mWriteFD = -1;
+}
+
+
+bool CNTV2VerticalInterruptMux::Start (const NTV2ChannelSet & inInputChannels, const NTV2ChannelSet & inOutputChannels)
+{
+	Stop();
+	if (!mDevice.IsOpen())
+		{VIMFAIL("Device not open");  return false;}
+	if (inInputChannels.empty()  &&  inOutputChannels.empty())
+		{VIMFAIL("No channels specified");  return false;}
+	for (NTV2ChannelSetConstIter it(inInputChannels.begin());  it != inInputChannels.end();  ++it)
+		if (!NTV2_IS_VALID_CHANNEL(*it))
+			{VIMFAIL("Bad input channel " << DEC(*it));  return false;}
+	for (NTV2ChannelSetConstIter it(inOutputChannels.begin());  it != inOutputChannels.end();  ++it)
+		if (!NTV2_IS_VALID_CHANNEL(*it))
+			{VIMFAIL("Bad output channel " << DEC(*it));  return false;}
+
+	if (!mDevice.SubscribeInputVerticalEvent(inInputChannels))
+		VIMWARN("SubscribeInputVerticalEvent failed for " << ::NTV2ChannelSetToStr(inInputChannels));
+	if (!mDevice.SubscribeOutputVerticalEvent(inOutputChannels))
+		VIMWARN("SubscribeOutputVerticalEvent failed for " << ::NTV2ChannelSetToStr(inOutputChannels));
+	mInputs = inInputChannels;
+	mOutputs = inOutputChannels;
+	mQuit.Clear();
+
+	for (int pass(0);  pass < 2;  pass++)
+	{
+		const NTV2ChannelSet & channels (pass ? inOutputChannels : inInputChannels);
+		for (NTV2ChannelSetConstIter it(channels.begin());  it != channels.end();  ++it)
+		{
+			Waiter * pWaiter (new Waiter);
+			pWaiter->fpMux = this;
+			pWaiter->fEvent = NTV2VerticalEvent(*it, pass == 0);
+			mWaiters.push_back(pWaiter);
+		}
+	}
+	for (Waiters::iterator it(mWaiters.begin());  it != mWaiters.end();  ++it)
+	{
+		Waiter & waiter(**it);
+		waiter.fThread.Attach(WaiterThreadStatic, &waiter);
+		waiter.fThread.SetPriority(AJA_ThreadPriority_High);
+		if (AJA_FAILURE(waiter.fThread.Start()))
+			{VIMFAIL("Failed to start waiter thread for " << waiter.fEvent);  Stop();  return false;}
+	}
+	VIMINFO("Started for " << DEC(mWaiters.size()) << " channel(s): inputs " << ::NTV2ChannelSetToStr(mInputs)
+			<< ", outputs " << ::NTV2ChannelSetToStr(mOutputs));
+	return true;
+}
+
+
+void CNTV2VerticalInterruptMux::Stop (void)
+{
+	if (mWaiters.empty())
+		return;
+	mQuit.Set();
+	for (Waiters::iterator it(mWaiters.begin());  it != mWaiters.end();  ++it)
+		(*it)->fThread.Stop();
+	for (Waiters::iterator it(mWaiters.begin());  it != mWaiters.end();  ++it)
+		delete *it;
+	mWaiters.clear();
+	if (!mInputs.empty())
+		mDevice.UnsubscribeInputVerticalEvent(mInputs);
+	if (!mOutputs.empty())
+		mDevice.UnsubscribeOutputVerticalEvent(mOutputs);
+	mInputs.clear();  mOutputs.clear();
+	AJAAutoLock lock(&mLock);
+	ClearPending();
+	VIMDBG("Stopped");
+}
+
+
+bool CNTV2VerticalInterruptMux::WaitForAny (NTV2VerticalEvents & outEvents, const ULWord inTimeoutMs)
+{
+	if (Collect(outEvents))
+		return true;
+	if (!IsRunning())
+		return false;
+	mPendingEvent.WaitForSignal(inTimeoutMs);
+	return Collect(outEvents);
+}
+
+
+bool CNTV2VerticalInterruptMux::Poll (NTV2VerticalEvents & outEvents)
+{
+	return Collect(outEvents);
+}
+
+
+bool CNTV2VerticalInterruptMux::Collect (NTV2VerticalEvents & outEvents)
+{
+	outEvents.clear();
+	AJAAutoLock lock(&mLock);
+	for (Waiters::iterator it(mWaiters.begin());  it != mWaiters.end();  ++it)
+	{
+		NTV2VerticalEvent & pending((*it)->fEvent);
+		if (!pending.fCount)
+			continue;
+		outEvents.push_back(pending);
+		pending.fCount = 0;
+	}
+	ClearPending();
+	return !outEvents.empty();
+}
+
+
+void CNTV2VerticalInterruptMux::NotifyPending (void)
+{	//	Caller must hold mLock
+	mPendingEvent.Signal();
+#if defined(AJA_LINUX)
+	if (mWriteFD >= 0)
+	{	const uint64_t one(1);
+		if (::write(mWriteFD, &one, sizeof(one)) != ssize_t(sizeof(one)))
+			{}	//	Counter saturated -- still readable, so nothing lost
+	}
+#elif defined(AJA_MAC)
+	if (mWriteFD >= 0)
+	{	const char one(1);
+		if (::write(mWriteFD, &one, 1) != 1)
+			{}	//	Pipe full -- still readable, so nothing lost
+	}
+#endif
+}
+
+
+void CNTV2VerticalInterruptMux::ClearPending (void)
+{	//	Caller must hold mLock
+	mPendingEvent.Clear();
+#if defined(AJA_LINUX)
+	if (mReadFD >= 0)
+	{	uint64_t value(0);
+		if (::read(mReadFD, &value, sizeof(value)) < 0)
+			{}	//	EAGAIN -- wasn't readable
+	}
+#elif defined(AJA_MAC)
+	if (mReadFD >= 0)
+	{	char buf[256];
+		while (::read(mReadFD, buf, sizeof(buf)) > 0)
+			;
+	}
+#endif
+}
+
+
+void CNTV2VerticalInterruptMux::WaiterThreadStatic (AJAThread * pThread, void * pContext)	//	static
+{	(void) pThread;
+	Waiter * pWaiter (reinterpret_cast<Waiter*>(pContext));
+	if (pWaiter  &&  pWaiter->fpMux)
+		pWaiter->fpMux->WaiterThread(*pWaiter);
+}
+
+
+void CNTV2VerticalInterruptMux::WaiterThread (Waiter & inWaiter)
+{
+	const INTERRUPT_ENUMS intType (inWaiter.fEvent.InterruptType());
+	VIMDBG("Waiter for " << ::NTV2InterruptEnumString(intType) << " started");
+	while (!mQuit.IsSet()  &&  !inWaiter.fThread.Terminate())
+	{
+		const uint64_t startMs (AJATime::GetSystemMilliseconds());
+		if (!mDevice.WaitForInterrupt(intType, mWaitTimeoutMs))
+		{	//	Timed out, or failed -- don't spin if the driver fails immediately
+			if (AJATime::GetSystemMilliseconds() - startMs < 1)
+				AJATime::Sleep(1);
+			continue;
+		}
+		AJAAutoLock lock(&mLock);
+		inWaiter.fEvent.fCount++;
+		inWaiter.fEvent.fTotalCount++;
+		NotifyPending();
+	}
+	VIMDBG("Waiter for " << ::NTV2InterruptEnumString(intType) << " stopped");
+}
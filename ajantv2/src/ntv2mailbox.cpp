@@ -41,7 +41,7 @@
 #endif
 
 
-CNTV2MailBox::CNTV2MailBox(CNTV2Card & device) : mDevice( device )
+CNTV2MailBox::CNTV2MailBox(CNTV2Card & device) : mDevice( device ), mIpErrorCode(NTV2IpErrNone)
 {
 
 	bOffset = SAREK_MAILBOX;
@@ -11,7 +11,9 @@
 #include "ntv2version.h"
 #include "ajabase/system/debug.h"
 #include "ajabase/common/common.h"
+#include "ajabase/system/file_io.h"
 #include "ajabase/system/info.h"
+#include "ajabase/system/lock.h"
 #include "ajabase/system/systemtime.h"
 #include <iomanip>
 #if defined(AJAMac)
@@ -990,6 +992,24 @@ bool NTV2RPCClientAPI::NTV2CloseRemote (void)
 }
 
 
+static string	sPluginsFolder;		//	Overrides the default plugins folder if non-empty
+static AJALock	sPluginsFolderLock;
+
+void NTV2RPCClientAPI::SetPluginsFolder (const string & inFolderPath)	//	CLASS METHOD
+{
+	AJAAutoLock tmpLock(&sPluginsFolderLock);
+	sPluginsFolder = inFolderPath;
+	if (!sPluginsFolder.empty()  &&  sPluginsFolder.at(sPluginsFolder.length()-1) != AJA_PATHSEP)
+		sPluginsFolder += AJA_PATHSEP;
+}
+
+string NTV2RPCClientAPI::GetPluginsFolder (void)	//	CLASS METHOD
+{
+	AJAAutoLock tmpLock(&sPluginsFolderLock);
+	return sPluginsFolder;
+}
+
+
 //	Loads NTV2 plugin, and returns address of given function
 static uint64_t * GetNTV2PluginFunction (const NTV2ConnectParams & inParams, const string & inFuncName)
 {
@@ -1001,16 +1021,21 @@ static uint64_t * GetNTV2PluginFunction (const NTV2ConnectParams & inParams, con
 		{NBCFAIL("Scheme '" << inParams.valueForKey(kConnectParamScheme) << "' results in empty plugin name");  return AJA_NULL;}	//	No "host"
 	scheme.erase(0,4);	//	Remainder of scheme yields DLL/dylib/so name...
 
-	//	Look for plugins in the "AJA" folder (usually parent folder of our "firmware" folder)...
-	string pluginName(scheme), pluginPath, dllsFolder, errStr;
-	AJASystemInfo sysInfo (AJA_SystemInfoMemoryUnit_Megabytes, AJA_SystemInfoSection_Path);
-	if (AJA_FAILURE(sysInfo.GetValue(AJA_SystemInfoTag_Path_Firmware, pluginPath)))
-		{NBCFAIL("AJA_SystemInfoTag_Path_Firmware failed");  return AJA_NULL;}	//	Can't get firmware folder
-	NBCDBG("AJA firmware path is '" << pluginPath << "', seeking '" << pluginName << DLL_EXTENSION "'");
-	//	Lop off trailing "Firmware/"...
-	if (pluginPath.find(FIRMWARE_FOLDER) == string::npos)
-		{NBSFAIL("'" << pluginPath << "' doesn't end with '" << FIRMWARE_FOLDER << "'");  return AJA_NULL;}
-	pluginPath.erase(pluginPath.find(FIRMWARE_FOLDER), 9);	//	Lop off trailing "Firmware/"
+	//	Look for plugins in the folder given to SetPluginsFolder, if any, else in the "AJA" folder
+	//	(usually parent folder of our "firmware" folder)...
+	string pluginName(scheme), pluginPath(NTV2RPCClientAPI::GetPluginsFolder()), dllsFolder, errStr;
+	if (pluginPath.empty())
+	{
+		AJASystemInfo sysInfo (AJA_SystemInfoMemoryUnit_Megabytes, AJA_SystemInfoSection_Path);
+		if (AJA_FAILURE(sysInfo.GetValue(AJA_SystemInfoTag_Path_Firmware, pluginPath)))
+			{NBCFAIL("AJA_SystemInfoTag_Path_Firmware failed");  return AJA_NULL;}	//	Can't get firmware folder
+		NBCDBG("AJA firmware path is '" << pluginPath << "', seeking '" << pluginName << DLL_EXTENSION "'");
+		//	Lop off trailing "Firmware/"...
+		if (pluginPath.find(FIRMWARE_FOLDER) == string::npos)
+			{NBSFAIL("'" << pluginPath << "' doesn't end with '" << FIRMWARE_FOLDER << "'");  return AJA_NULL;}
+		pluginPath.erase(pluginPath.find(FIRMWARE_FOLDER), 9);	//	Lop off trailing "Firmware/"
+	}
+	else NBCDBG("Plugins folder is '" << pluginPath << "', seeking '" << pluginName << DLL_EXTENSION "'");
 	dllsFolder = pluginPath;
 	dllsFolder.erase(dllsFolder.length()-1,1);	//	Lop off trailing slash or backslash
 	pluginPath += pluginName + DLL_EXTENSION;	//	Append plugin name + extension...
@@ -0,0 +1,1045 @@
+/* SPDX-License-Identifier: MIT */
+/**
+	@file		ntv2pixelformatconverter.cpp
+	@brief		Implements the CNTV2PixelFormatConverter class.
+	@copyright	(C) 2023 AJA Video Systems, Inc.
+**/
+
+#include "ntv2pixelformatconverter.h"
+#include "ntv2endian.h"
+#include "ntv2transcode.h"
+#include "ntv2utils.h"
+#include "ajabase/common/videoutilities.h"
+#include "ajabase/system/debug.h"
+#include "ajabase/system/lock.h"
+#include "ajabase/system/workerpool.h"
+#include <map>
+#include <vector>
+#include <string.h>
+#if defined(AJA_HAS_SSE2)
+	#include <emmintrin.h>
+#endif
+
+using namespace std;
+
+#define PFCFAIL(__x__)	AJA_sERROR	(AJA_DebugUnit_VideoGeneric, AJAFUNC << ": " << __x__)
+
+
+//	Nodes of the conversion graph:  the supported pixel formats, followed by the unpacked intermediates
+typedef enum
+{
+	kNode_v210,		//	NTV2_FBF_10BIT_YCBCR
+	kNode_2vuy,		//	NTV2_FBF_8BIT_YCBCR
+	kNode_yuy2,		//	NTV2_FBF_8BIT_YCBCR_YUY2
+	kNode_argb,		//	NTV2_FBF_ARGB -- B,G,R,A bytes, same as AJA_RGBAlphaPixel, so it's also the 8-bit RGBA intermediate
+	kNode_rgba,		//	NTV2_FBF_RGBA -- A,R,G,B bytes
+	kNode_abgr,		//	NTV2_FBF_ABGR -- R,G,B,A bytes
+	kNode_rgb24,	//	NTV2_FBF_24BIT_RGB
+	kNode_bgr24,	//	NTV2_FBF_24BIT_BGR
+	kNode_rgb10,	//	NTV2_FBF_10BIT_RGB
+	kNode_dpx,		//	NTV2_FBF_10BIT_DPX
+	kNode_dpxle,	//	NTV2_FBF_10BIT_DPX_LE
+	kNode_rgb48,	//	NTV2_FBF_48BIT_RGB
+	kNode_yuv16,	//	Unpacked 10-bit YCbCr 4:2:2 -- Cb,Y,Cr,Y UWords
+	kNode_rgba10,	//	AJA_RGBAlpha10BitPixel
+	kNode_rgba16,	//	AJA_RGBAlpha16BitPixel
+	kNode_Count
+} ConvNode;
+
+typedef struct NodeInfo
+{
+	const char *	fName;
+	NTV2PixelFormat	fPixelFormat;	//	NTV2_FBF_INVALID for intermediates
+	ULWord			fBits;			//	Bits per component
+	bool			fIsYCbCr;
+} NodeInfo;
+
+static const NodeInfo sNodes[kNode_Count] =
+{
+	{"v210",	NTV2_FBF_10BIT_YCBCR,		10,	true},
+	{"2vuy",	NTV2_FBF_8BIT_YCBCR,		8,	true},
+	{"yuy2",	NTV2_FBF_8BIT_YCBCR_YUY2,	8,	true},
+	{"argb",	NTV2_FBF_ARGB,				8,	false},
+	{"rgba",	NTV2_FBF_RGBA,				8,	false},
+	{"abgr",	NTV2_FBF_ABGR,				8,	false},
+	{"rgb24",	NTV2_FBF_24BIT_RGB,			8,	false},
+	{"bgr24",	NTV2_FBF_24BIT_BGR,			8,	false},
+	{"rgb10",	NTV2_FBF_10BIT_RGB,			10,	false},
+	{"dpx",		NTV2_FBF_10BIT_DPX,			10,	false},
+	{"dpxle",	NTV2_FBF_10BIT_DPX_LE,		10,	false},
+	{"rgb48",	NTV2_FBF_48BIT_RGB,			16,	false},
+	{"yuv16",	NTV2_FBF_INVALID,			10,	true},
+	{"rgba10",	NTV2_FBF_INVALID,			10,	false},
+	{"rgba16",	NTV2_FBF_INVALID,			16,	false}
+};
+
+static const ULWord	kMaxBytesPerPixel	(8);	//	Largest pixel of any node (rgba16)
+static const ULWord	kMaxPlanSteps		(6);
+
+static ConvNode NodeForPixelFormat (const NTV2PixelFormat inPF)
+{
+	for (int node(0);  node < kNode_Count;  node++)
+		if (sNodes[node].fPixelFormat == inPF  &&  inPF != NTV2_FBF_INVALID)
+			return ConvNode(node);
+	return kNode_Count;
+}
+
+//	Number of bytes in a line of the given node (v210 rounded up to a whole 6-pixel group)
+static ULWord LineBytes (const ConvNode inNode, const ULWord inNumPixels)
+{
+	switch (inNode)
+	{
+		case kNode_v210:	return (inNumPixels + 5) / 6 * 16;
+		case kNode_2vuy:
+		case kNode_yuy2:	return inNumPixels * 2;
+		case kNode_rgb24:
+		case kNode_bgr24:	return inNumPixels * 3;
+		case kNode_rgb48:	return inNumPixels * 6;
+		case kNode_yuv16:	return inNumPixels * 4;
+		case kNode_rgba10:
+		case kNode_rgba16:	return inNumPixels * 8;
+		default:			return inNumPixels * 4;
+	}
+}
+
+
+//	Line kernels
+typedef void (*LineKernelFunc) (const void * pInLine, void * pOutLine, const ULWord inNumPixels, const AJA_ColorMatrix inMatrix);
+
+static void v210ToYUV16 (const void * pIn, void * pOut, const ULWord inNumPixels, const AJA_ColorMatrix)
+{
+	::UnpackLine_10BitYUVto16BitYUV(reinterpret_cast<const ULWord*>(pIn), reinterpret_cast<UWord*>(pOut), inNumPixels);
+}
+
+static void YUV16Tov210 (const void * pIn, void * pOut, const ULWord inNumPixels, const AJA_ColorMatrix)
+{
+	::PackLine_16BitYUVto10BitYUV(reinterpret_cast<const UWord*>(pIn), reinterpret_cast<ULWord*>(pOut), inNumPixels);
+}
+
+static void TwoVuyToYUV16 (const void * pIn, void * pOut, const ULWord inNumPixels, const AJA_ColorMatrix)
+{
+	const UByte *	pSrc (reinterpret_cast<const UByte*>(pIn));
+	UWord *			pDst (reinterpret_cast<UWord*>(pOut));
+	for (ULWord ndx(0);  ndx < inNumPixels * 2;  ndx++)
+		pDst[ndx] = UWord(pSrc[ndx] << 2);
+}
+
+static void YUV16To2vuy (const void * pIn, void * pOut, const ULWord inNumPixels, const AJA_ColorMatrix)
+{
+	::ConvertLineTo8BitYCbCr(reinterpret_cast<const uint16_t*>(pIn), reinterpret_cast<uint8_t*>(pOut), inNumPixels);
+}
+
+static void Yuy2ToYUV16 (const void * pIn, void * pOut, const ULWord inNumPixels, const AJA_ColorMatrix)
+{
+	const UByte *	pSrc (reinterpret_cast<const UByte*>(pIn));	//	Y0 Cb Y1 Cr
+	UWord *			pDst (reinterpret_cast<UWord*>(pOut));		//	Cb Y0 Cr Y1
+	for (ULWord ndx(0);  ndx < inNumPixels * 2;  ndx += 2)
+	{
+		pDst[ndx + 0] = UWord(pSrc[ndx + 1] << 2);
+		pDst[ndx + 1] = UWord(pSrc[ndx + 0] << 2);
+	}
+}
+
+static void YUV16ToYuy2 (const void * pIn, void * pOut, const ULWord inNumPixels, const AJA_ColorMatrix)
+{
+	const UWord *	pSrc (reinterpret_cast<const UWord*>(pIn));
+	UByte *			pDst (reinterpret_cast<UByte*>(pOut));
+	for (ULWord ndx(0);  ndx < inNumPixels * 2;  ndx += 2)
+	{
+		pDst[ndx + 0] = UByte(pSrc[ndx + 1] >> 2);
+		pDst[ndx + 1] = UByte(pSrc[ndx + 0] >> 2);
+	}
+}
+
+static void TwoVuyTov210 (const void * pIn, void * pOut, const ULWord inNumPixels, const AJA_ColorMatrix)
+{
+	::ConvertLine_2vuy_to_v210(reinterpret_cast<const UByte*>(pIn), reinterpret_cast<ULWord*>(pOut), inNumPixels);
+}
+
+static void v210To2vuy (const void * pIn, void * pOut, const ULWord inNumPixels, const AJA_ColorMatrix)
+{
+	::ConvertLine_v210_to_2vuy(reinterpret_cast<const ULWord*>(pIn), reinterpret_cast<UByte*>(pOut), inNumPixels);
+}
+
+static void SwapYCbCr8 (const void * pIn, void * pOut, const ULWord inNumPixels, const AJA_ColorMatrix)	//	2vuy <=> yuy2
+{
+	::ConvertLine_2vuy_to_yuy2(reinterpret_cast<const UByte*>(pIn), reinterpret_cast<UWord*>(pOut), inNumPixels);
+}
+
+static void YUV16ToARGB (const void * pIn, void * pOut, const ULWord inNumPixels, const AJA_ColorMatrix inMatrix)
+{
+	::AJA_ConvertLinetoRGB(const_cast<uint16_t*>(reinterpret_cast<const uint16_t*>(pIn)), reinterpret_cast<AJA_RGBAlphaPixel*>(pOut), inNumPixels, inMatrix);
+}
+
+static void ARGBToYUV16 (const void * pIn, void * pOut, const ULWord inNumPixels, const AJA_ColorMatrix inMatrix)
+{
+	::AJA_ConvertLineToYCbCr422(const_cast<AJA_RGBAlphaPixel*>(reinterpret_cast<const AJA_RGBAlphaPixel*>(pIn)), reinterpret_cast<uint16_t*>(pOut),
+								int32_t(inNumPixels), 0, inMatrix);
+}
+
+static void YUV16ToRGBA10 (const void * pIn, void * pOut, const ULWord inNumPixels, const AJA_ColorMatrix inMatrix)
+{
+	::AJA_ConvertLineto10BitRGB(const_cast<uint16_t*>(reinterpret_cast<const uint16_t*>(pIn)), reinterpret_cast<AJA_RGBAlpha10BitPixel*>(pOut), inNumPixels, inMatrix);
+}
+
+static void RGBA10ToYUV16 (const void * pIn, void * pOut, const ULWord inNumPixels, const AJA_ColorMatrix inMatrix)
+{
+	::AJA_ConvertRGBAlpha10LineToYCbCr422(const_cast<AJA_RGBAlpha10BitPixel*>(reinterpret_cast<const AJA_RGBAlpha10BitPixel*>(pIn)),
+										reinterpret_cast<uint16_t*>(pOut), int32_t(inNumPixels), 0, inMatrix);
+}
+
+static void YUV16ToRGBA16 (const void * pIn, void * pOut, const ULWord inNumPixels, const AJA_ColorMatrix inMatrix)
+{
+	::AJA_ConvertLineto16BitRGB(const_cast<uint16_t*>(reinterpret_cast<const uint16_t*>(pIn)), reinterpret_cast<AJA_RGBAlpha16BitPixel*>(pOut), inNumPixels, inMatrix);
+}
+
+//	Reorders the bytes of 4-byte pixels:  BN is the input byte that holds output byte N
+template <int B0, int B1, int B2, int B3> static void Swizzle32 (const void * pIn, void * pOut, const ULWord inNumPixels, const AJA_ColorMatrix)
+{
+	const UByte *	pSrc (reinterpret_cast<const UByte*>(pIn));
+	UByte *			pDst (reinterpret_cast<UByte*>(pOut));
+	for (ULWord ndx(0);  ndx < inNumPixels;  ndx++,  pSrc += 4,  pDst += 4)
+	{
+		const UByte b0(pSrc[B0]), b1(pSrc[B1]), b2(pSrc[B2]), b3(pSrc[B3]);
+		pDst[0] = b0;	pDst[1] = b1;	pDst[2] = b2;	pDst[3] = b3;
+	}
+}
+
+//	B,G,R,A => 3 bytes per pixel, in the given order
+template <int B0, int B1, int B2> static void ARGBTo24 (const void * pIn, void * pOut, const ULWord inNumPixels, const AJA_ColorMatrix)
+{
+	const UByte *	pSrc (reinterpret_cast<const UByte*>(pIn));
+	UByte *			pDst (reinterpret_cast<UByte*>(pOut));
+	for (ULWord ndx(0);  ndx < inNumPixels;  ndx++,  pSrc += 4,  pDst += 3)
+		{pDst[0] = pSrc[B0];	pDst[1] = pSrc[B1];		pDst[2] = pSrc[B2];}
+}
+
+//	3 bytes per pixel => B,G,R,A, with opaque alpha. BN is the input byte that holds output byte N.
+template <int B0, int B1, int B2> static void ARGBFrom24 (const void * pIn, void * pOut, const ULWord inNumPixels, const AJA_ColorMatrix)
+{
+	const UByte *	pSrc (reinterpret_cast<const UByte*>(pIn));
+	UByte *			pDst (reinterpret_cast<UByte*>(pOut));
+	for (ULWord ndx(0);  ndx < inNumPixels;  ndx++,  pSrc += 3,  pDst += 4)
+		{pDst[0] = pSrc[B0];	pDst[1] = pSrc[B1];		pDst[2] = pSrc[B2];		pDst[3] = 0xFF;}
+}
+
+//	Full-range depth changes replicate the high-order bits into the new low-order bits, so white stays white
+static void ARGBToRGBA10 (const void * pIn, void * pOut, const ULWord inNumPixels, const AJA_ColorMatrix)
+{
+	const UByte *	pSrc (reinterpret_cast<const UByte*>(pIn));
+	UWord *			pDst (reinterpret_cast<UWord*>(pOut));
+	for (ULWord ndx(0);  ndx < inNumPixels * 4;  ndx++)
+		pDst[ndx] = UWord(pSrc[ndx] << 2 | pSrc[ndx] >> 6);
+}
+
+static void RGBA10ToARGB (const void * pIn, void * pOut, const ULWord inNumPixels, const AJA_ColorMatrix)
+{
+	const UWord *	pSrc (reinterpret_cast<const UWord*>(pIn));
+	UByte *			pDst (reinterpret_cast<UByte*>(pOut));
+	for (ULWord ndx(0);  ndx < inNumPixels * 4;  ndx++)
+		pDst[ndx] = UByte(pSrc[ndx] >> 2);
+}
+
+static void RGBA10ToRGBA16 (const void * pIn, void * pOut, const ULWord inNumPixels, const AJA_ColorMatrix)
+{
+	const UWord *	pSrc (reinterpret_cast<const UWord*>(pIn));
+	UWord *			pDst (reinterpret_cast<UWord*>(pOut));
+	for (ULWord ndx(0);  ndx < inNumPixels * 4;  ndx++)
+		pDst[ndx] = UWord(pSrc[ndx] << 6 | pSrc[ndx] >> 4);
+}
+
+static void RGBA16ToRGBA10 (const void * pIn, void * pOut, const ULWord inNumPixels, const AJA_ColorMatrix)
+{
+	const UWord *	pSrc (reinterpret_cast<const UWord*>(pIn));
+	UWord *			pDst (reinterpret_cast<UWord*>(pOut));
+	for (ULWord ndx(0);  ndx < inNumPixels * 4;  ndx++)
+		pDst[ndx] = UWord(pSrc[ndx] >> 6);
+}
+
+static void RGBA10ToRGB10 (const void * pIn, void * pOut, const ULWord inNumPixels, const AJA_ColorMatrix)
+{
+	const AJA_RGBAlpha10BitPixel *	pSrc (reinterpret_cast<const AJA_RGBAlpha10BitPixel*>(pIn));
+	ULWord *						pDst (reinterpret_cast<ULWord*>(pOut));
+	for (ULWord ndx(0);  ndx < inNumPixels;  ndx++)
+		pDst[ndx] = ULWord(pSrc[ndx].Blue) << 20  |  ULWord(pSrc[ndx].Green) << 10  |  ULWord(pSrc[ndx].Red);
+}
+
+static void RGB10ToRGBA10 (const void * pIn, void * pOut, const ULWord inNumPixels, const AJA_ColorMatrix)
+{
+	const ULWord *				pSrc (reinterpret_cast<const ULWord*>(pIn));
+	AJA_RGBAlpha10BitPixel *	pDst (reinterpret_cast<AJA_RGBAlpha10BitPixel*>(pOut));
+	for (ULWord ndx(0);  ndx < inNumPixels;  ndx++)
+	{
+		pDst[ndx].Red	= UWord(pSrc[ndx] & 0x3FF);
+		pDst[ndx].Green	= UWord((pSrc[ndx] >> 10) & 0x3FF);
+		pDst[ndx].Blue	= UWord((pSrc[ndx] >> 20) & 0x3FF);
+		pDst[ndx].Alpha	= MAX_RGB_10BIT;
+	}
+}
+
+template <bool BigEndian> static void RGBA10ToDPX (const void * pIn, void * pOut, const ULWord inNumPixels, const AJA_ColorMatrix)
+{
+	const AJA_RGBAlpha10BitPixel *	pSrc (reinterpret_cast<const AJA_RGBAlpha10BitPixel*>(pIn));
+	ULWord *						pDst (reinterpret_cast<ULWord*>(pOut));
+	for (ULWord ndx(0);  ndx < inNumPixels;  ndx++)
+	{
+		const ULWord value (ULWord(pSrc[ndx].Red) << 22  |  ULWord(pSrc[ndx].Green) << 12  |  ULWord(pSrc[ndx].Blue) << 2);
+		pDst[ndx] = BigEndian ? NTV2EndianSwap32HtoB(value) : NTV2EndianSwap32HtoL(value);
+	}
+}
+
+template <bool BigEndian> static void DPXToRGBA10 (const void * pIn, void * pOut, const ULWord inNumPixels, const AJA_ColorMatrix)
+{
+	const ULWord *				pSrc (reinterpret_cast<const ULWord*>(pIn));
+	AJA_RGBAlpha10BitPixel *	pDst (reinterpret_cast<AJA_RGBAlpha10BitPixel*>(pOut));
+	for (ULWord ndx(0);  ndx < inNumPixels;  ndx++)
+	{
+		const ULWord value (BigEndian ? NTV2EndianSwap32BtoH(pSrc[ndx]) : NTV2EndianSwap32LtoH(pSrc[ndx]));
+		pDst[ndx].Red	= UWord((value >> 22) & 0x3FF);
+		pDst[ndx].Green	= UWord((value >> 12) & 0x3FF);
+		pDst[ndx].Blue	= UWord((value >> 2) & 0x3FF);
+		pDst[ndx].Alpha	= MAX_RGB_10BIT;
+	}
+}
+
+static void RGBA16ToRGB48 (const void * pIn, void * pOut, const ULWord inNumPixels, const AJA_ColorMatrix)
+{
+	::AJA_Convert16BitARGBTo16BitRGB(const_cast<AJA_RGBAlpha16BitPixel*>(reinterpret_cast<const AJA_RGBAlpha16BitPixel*>(pIn)),
+									reinterpret_cast<uint16_t*>(pOut), inNumPixels);
+}
+
+static void RGB48ToRGBA16 (const void * pIn, void * pOut, const ULWord inNumPixels, const AJA_ColorMatrix)
+{
+	const UWord *				pSrc (reinterpret_cast<const UWord*>(pIn));
+	AJA_RGBAlpha16BitPixel *	pDst (reinterpret_cast<AJA_RGBAlpha16BitPixel*>(pOut));
+	for (ULWord ndx(0);  ndx < inNumPixels;  ndx++,  pSrc += 3)
+	{
+		pDst[ndx].Red	= pSrc[0];
+		pDst[ndx].Green	= pSrc[1];
+		pDst[ndx].Blue	= pSrc[2];
+		pDst[ndx].Alpha	= MAX_RGB_16BIT;
+	}
+}
+
+
+//	The edges of the conversion graph
+typedef struct LineKernel
+{
+	ConvNode		fFrom;
+	ConvNode		fTo;
+	LineKernelFunc	fFunc;
+	ULWord			fCost;		//	Relative cost per pixel
+	ULWord			fPixels;	//	Pixels are processed in groups of this many (so lines are padded to a multiple of it)
+
+	ULWord	PaddedWidth (const ULWord inWidth) const	{return (inWidth + fPixels - 1) / fPixels * fPixels;}
+} LineKernel;
+
+static const LineKernel sKernels[] =
+{
+	{kNode_v210,	kNode_yuv16,	v210ToYUV16,				2,	6},
+	{kNode_yuv16,	kNode_v210,		YUV16Tov210,				2,	6},
+	{kNode_2vuy,	kNode_yuv16,	TwoVuyToYUV16,				1,	2},
+	{kNode_yuv16,	kNode_2vuy,		YUV16To2vuy,				1,	2},
+	{kNode_yuy2,	kNode_yuv16,	Yuy2ToYUV16,				1,	2},
+	{kNode_yuv16,	kNode_yuy2,		YUV16ToYuy2,				1,	2},
+	{kNode_2vuy,	kNode_v210,		TwoVuyTov210,				2,	6},
+	{kNode_v210,	kNode_2vuy,		v210To2vuy,					2,	6},
+	{kNode_2vuy,	kNode_yuy2,		SwapYCbCr8,					1,	2},
+	{kNode_yuy2,	kNode_2vuy,		SwapYCbCr8,					1,	2},
+	{kNode_yuv16,	kNode_argb,		YUV16ToARGB,				6,	2},
+	{kNode_argb,	kNode_yuv16,	ARGBToYUV16,				6,	2},
+	{kNode_yuv16,	kNode_rgba10,	YUV16ToRGBA10,				6,	2},
+	{kNode_rgba10,	kNode_yuv16,	RGBA10ToYUV16,				6,	2},
+	{kNode_yuv16,	kNode_rgba16,	YUV16ToRGBA16,				6,	2},
+	{kNode_argb,	kNode_rgba,		Swizzle32<3,2,1,0>,			1,	1},
+	{kNode_rgba,	kNode_argb,		Swizzle32<3,2,1,0>,			1,	1},
+	{kNode_argb,	kNode_abgr,		Swizzle32<2,1,0,3>,			1,	1},
+	{kNode_abgr,	kNode_argb,		Swizzle32<2,1,0,3>,			1,	1},
+	{kNode_argb,	kNode_rgb24,	ARGBTo24<2,1,0>,			1,	1},
+	{kNode_rgb24,	kNode_argb,		ARGBFrom24<2,1,0>,			1,	1},
+	{kNode_argb,	kNode_bgr24,	ARGBTo24<0,1,2>,			1,	1},
+	{kNode_bgr24,	kNode_argb,		ARGBFrom24<0,1,2>,			1,	1},
+	{kNode_argb,	kNode_rgba10,	ARGBToRGBA10,				1,	1},
+	{kNode_rgba10,	kNode_argb,		RGBA10ToARGB,				1,	1},
+	{kNode_rgba10,	kNode_rgba16,	RGBA10ToRGBA16,				1,	1},
+	{kNode_rgba16,	kNode_rgba10,	RGBA16ToRGBA10,				1,	1},
+	{kNode_rgba10,	kNode_rgb10,	RGBA10ToRGB10,				1,	1},
+	{kNode_rgb10,	kNode_rgba10,	RGB10ToRGBA10,				1,	1},
+	{kNode_rgba10,	kNode_dpx,		RGBA10ToDPX<true>,			1,	1},
+	{kNode_dpx,		kNode_rgba10,	DPXToRGBA10<true>,			1,	1},
+	{kNode_rgba10,	kNode_dpxle,	RGBA10ToDPX<false>,			1,	1},
+	{kNode_dpxle,	kNode_rgba10,	DPXToRGBA10<false>,			1,	1},
+	{kNode_rgba16,	kNode_rgb48,	RGBA16ToRGB48,				1,	1},
+	{kNode_rgb48,	kNode_rgba16,	RGB48ToRGBA16,				1,	1}
+};
+static const size_t kNumKernels (sizeof(sKernels) / sizeof(sKernels[0]));
+
+
+//	Planar YCbCr formats. They're converted through lines of unpacked 10-bit 4:2:2 components (the yuv16 node, split
+//	into separate Y, Cb and Cr lines), rather than through the line kernel graph, as a 4:2:0 chroma row spans two lines.
+typedef enum
+{
+	kPack_8Bit,			//	One byte per sample
+	kPack_16BitLE,		//	10 significant bits in a little-endian 16-bit word per sample
+	kPack_10BitPacked	//	Four samples per five bytes, the first sample in the least significant bits
+} PlanarPacking;
+
+typedef struct PlanarInfo
+{
+	NTV2PixelFormat	fPixelFormat;
+	const char *	fName;
+	bool			f420;		//	True if the chroma planes have half as many rows as the luma plane
+	ULWord			fNumPlanes;	//	2 (Y, then interleaved Cb/Cr) or 3 (Y, Cb, Cr)
+	PlanarPacking	fPacking;
+	ULWord			fBits;
+} PlanarInfo;
+
+static const PlanarInfo sPlanarFormats[] =
+{
+	{NTV2_FBF_8BIT_YCBCR_420PL2,		"420pl2",		true,	2,	kPack_8Bit,			8},		//	NV12
+	{NTV2_FBF_8BIT_YCBCR_422PL2,		"422pl2",		false,	2,	kPack_8Bit,			8},		//	NV16
+	{NTV2_FBF_8BIT_YCBCR_420PL3,		"420pl3",		true,	3,	kPack_8Bit,			8},		//	I420
+	{NTV2_FBF_8BIT_YCBCR_422PL3,		"422pl3",		false,	3,	kPack_8Bit,			8},
+	{NTV2_FBF_10BIT_YCBCR_420PL3_LE,	"420pl3le10",	true,	3,	kPack_16BitLE,		10},
+	{NTV2_FBF_10BIT_YCBCR_422PL3_LE,	"422pl3le10",	false,	3,	kPack_16BitLE,		10},
+	{NTV2_FBF_10BIT_YCBCR_420PL2,		"420pl2p10",	true,	2,	kPack_10BitPacked,	10},
+	{NTV2_FBF_10BIT_YCBCR_422PL2,		"422pl2p10",	false,	2,	kPack_10BitPacked,	10}
+};
+
+static const PlanarInfo * PlanarInfoForPixelFormat (const NTV2PixelFormat inPF)
+{
+	for (size_t ndx(0);  ndx < sizeof(sPlanarFormats) / sizeof(sPlanarFormats[0]);  ndx++)
+		if (sPlanarFormats[ndx].fPixelFormat == inPF)
+			return &sPlanarFormats[ndx];
+	return AJA_NULL;
+}
+
+//	Packs 10-bit samples into a plane's row
+static void PackSamples (const UWord * pIn, void * pOut, const ULWord inNumSamples, const PlanarPacking inPacking)
+{
+	ULWord ndx(0);
+	switch (inPacking)
+	{
+		case kPack_8Bit:
+		{
+			UByte * pDst (reinterpret_cast<UByte*>(pOut));
+#if defined(AJA_HAS_SSE2)
+			const __m128i two (_mm_set1_epi16(2));
+			for ( ;  ndx + 16 <= inNumSamples;  ndx += 16)
+			{
+				const __m128i lo (_mm_srli_epi16(_mm_add_epi16(_mm_loadu_si128(reinterpret_cast<const __m128i*>(pIn + ndx)), two), 2));
+				const __m128i hi (_mm_srli_epi16(_mm_add_epi16(_mm_loadu_si128(reinterpret_cast<const __m128i*>(pIn + ndx + 8)), two), 2));
+				_mm_storeu_si128(reinterpret_cast<__m128i*>(pDst + ndx), _mm_packus_epi16(lo, hi));
+			}
+#endif
+			for ( ;  ndx < inNumSamples;  ndx++)
+				pDst[ndx] = UByte(pIn[ndx] > 1021 ? 255 : (pIn[ndx] + 2) >> 2);
+			break;
+		}
+		case kPack_16BitLE:
+		{
+			UWord * pDst (reinterpret_cast<UWord*>(pOut));
+			for ( ;  ndx < inNumSamples;  ndx++)
+				pDst[ndx] = NTV2EndianSwap16HtoL(pIn[ndx]);
+			break;
+		}
+		case kPack_10BitPacked:
+		{
+			UByte * pDst (reinterpret_cast<UByte*>(pOut));
+			for ( ;  ndx + 4 <= inNumSamples;  ndx += 4,  pDst += 5)
+			{
+				const uint64_t bits (uint64_t(pIn[ndx]) | uint64_t(pIn[ndx+1]) << 10 | uint64_t(pIn[ndx+2]) << 20 | uint64_t(pIn[ndx+3]) << 30);
+				pDst[0] = UByte(bits);	pDst[1] = UByte(bits >> 8);		pDst[2] = UByte(bits >> 16);	pDst[3] = UByte(bits >> 24);	pDst[4] = UByte(bits >> 32);
+			}
+			uint64_t bits (0);
+			for (ULWord tail(0);  ndx + tail < inNumSamples;  tail++)
+				bits |= uint64_t(pIn[ndx + tail]) << (10 * tail);
+			for (ULWord byte(0);  byte < ((inNumSamples - ndx) * 10 + 7) / 8;  byte++)
+				pDst[byte] = UByte(bits >> (8 * byte));
+			break;
+		}
+	}
+}
+
+//	Unpacks a plane's row into 10-bit samples
+static void UnpackSamples (const void * pIn, UWord * pOut, const ULWord inNumSamples, const PlanarPacking inPacking)
+{
+	ULWord ndx(0);
+	switch (inPacking)
+	{
+		case kPack_8Bit:
+		{
+			const UByte * pSrc (reinterpret_cast<const UByte*>(pIn));
+#if defined(AJA_HAS_SSE2)
+			const __m128i zero (_mm_setzero_si128());
+			for ( ;  ndx + 16 <= inNumSamples;  ndx += 16)
+			{
+				const __m128i bytes (_mm_loadu_si128(reinterpret_cast<const __m128i*>(pSrc + ndx)));
+				_mm_storeu_si128(reinterpret_cast<__m128i*>(pOut + ndx), _mm_slli_epi16(_mm_unpacklo_epi8(bytes, zero), 2));
+				_mm_storeu_si128(reinterpret_cast<__m128i*>(pOut + ndx + 8), _mm_slli_epi16(_mm_unpackhi_epi8(bytes, zero), 2));
+			}
+#endif
+			for ( ;  ndx < inNumSamples;  ndx++)
+				pOut[ndx] = UWord(pSrc[ndx] << 2);
+			break;
+		}
+		case kPack_16BitLE:
+		{
+			const UWord * pSrc (reinterpret_cast<const UWord*>(pIn));
+			for ( ;  ndx < inNumSamples;  ndx++)
+				pOut[ndx] = UWord(NTV2EndianSwap16LtoH(pSrc[ndx]) & 0x3FF);
+			break;
+		}
+		case kPack_10BitPacked:
+		{
+			const UByte * pSrc (reinterpret_cast<const UByte*>(pIn));
+			for ( ;  ndx + 4 <= inNumSamples;  ndx += 4,  pSrc += 5)
+			{
+				const uint64_t bits (uint64_t(pSrc[0]) | uint64_t(pSrc[1]) << 8 | uint64_t(pSrc[2]) << 16 | uint64_t(pSrc[3]) << 24 | uint64_t(pSrc[4]) << 32);
+				pOut[ndx] = UWord(bits & 0x3FF);			pOut[ndx+1] = UWord((bits >> 10) & 0x3FF);
+				pOut[ndx+2] = UWord((bits >> 20) & 0x3FF);	pOut[ndx+3] = UWord((bits >> 30) & 0x3FF);
+			}
+			uint64_t bits (0);
+			for (ULWord byte(0);  byte < ((inNumSamples - ndx) * 10 + 7) / 8;  byte++)
+				bits |= uint64_t(pSrc[byte]) << (8 * byte);
+			for (ULWord tail(0);  ndx + tail < inNumSamples;  tail++)
+				pOut[ndx + tail] = UWord((bits >> (10 * tail)) & 0x3FF);
+			break;
+		}
+	}
+}
+
+//	A line of unpacked 10-bit 4:2:2 components
+typedef struct ComponentLine
+{
+	vector<UWord>	fY, fCb, fCr;
+	void Allocate (const ULWord inWidth)	{fY.assign(inWidth + 16, 0);  fCb.assign(inWidth / 2 + 16, 0);  fCr.assign(inWidth / 2 + 16, 0);}
+} ComponentLine;
+
+//	Cb Y Cr Y... => Y, Cb, Cr
+static void SplitYUV16 (const UWord * pIn, ComponentLine & outLine, const ULWord inWidth)
+{
+	UWord *	pY (&outLine.fY[0]);
+	UWord *	pCb (&outLine.fCb[0]);
+	UWord *	pCr (&outLine.fCr[0]);
+	ULWord	pixel (0);
+#if defined(AJA_HAS_SSE2)
+	const __m128i lowWords (_mm_set1_epi32(0xFFFF));
+	for ( ;  pixel + 8 <= inWidth;  pixel += 8)
+	{
+		const __m128i a (_mm_loadu_si128(reinterpret_cast<const __m128i*>(pIn + pixel * 2)));		//	Cb0 Y0 Cr0 Y1 Cb1 Y2 Cr1 Y3
+		const __m128i b (_mm_loadu_si128(reinterpret_cast<const __m128i*>(pIn + pixel * 2 + 8)));
+		_mm_storeu_si128(reinterpret_cast<__m128i*>(pY + pixel), _mm_packs_epi32(_mm_srli_epi32(a, 16), _mm_srli_epi32(b, 16)));
+		const __m128i c (_mm_packs_epi32(_mm_and_si128(a, lowWords), _mm_and_si128(b, lowWords)));			//	Cb0 Cr0 Cb1 Cr1 ...
+		const __m128i cb (_mm_packs_epi32(_mm_and_si128(c, lowWords), _mm_setzero_si128()));
+		const __m128i cr (_mm_packs_epi32(_mm_srli_epi32(c, 16), _mm_setzero_si128()));
+		_mm_storel_epi64(reinterpret_cast<__m128i*>(pCb + pixel / 2), cb);
+		_mm_storel_epi64(reinterpret_cast<__m128i*>(pCr + pixel / 2), cr);
+	}
+#endif
+	for ( ;  pixel < inWidth;  pixel += 2)
+	{
+		pCb[pixel / 2] = pIn[pixel * 2 + 0];	pY[pixel] = pIn[pixel * 2 + 1];
+		pCr[pixel / 2] = pIn[pixel * 2 + 2];	pY[pixel + 1] = pIn[pixel * 2 + 3];
+	}
+}
+
+//	Y, Cb, Cr => Cb Y Cr Y...
+static void MergeYUV16 (const ComponentLine & inLine, UWord * pOut, const ULWord inWidth)
+{
+	const UWord *	pY (&inLine.fY[0]);
+	const UWord *	pCb (&inLine.fCb[0]);
+	const UWord *	pCr (&inLine.fCr[0]);
+	ULWord			pixel (0);
+#if defined(AJA_HAS_SSE2)
+	for ( ;  pixel + 8 <= inWidth;  pixel += 8)
+	{
+		const __m128i y (_mm_loadu_si128(reinterpret_cast<const __m128i*>(pY + pixel)));
+		const __m128i c (_mm_unpacklo_epi16(_mm_loadl_epi64(reinterpret_cast<const __m128i*>(pCb + pixel / 2)),
+											_mm_loadl_epi64(reinterpret_cast<const __m128i*>(pCr + pixel / 2))));	//	Cb0 Cr0 Cb1 Cr1 ...
+		_mm_storeu_si128(reinterpret_cast<__m128i*>(pOut + pixel * 2), _mm_unpacklo_epi16(c, y));
+		_mm_storeu_si128(reinterpret_cast<__m128i*>(pOut + pixel * 2 + 8), _mm_unpackhi_epi16(c, y));
+	}
+#endif
+	for ( ;  pixel < inWidth;  pixel += 2)
+	{
+		pOut[pixel * 2 + 0] = pCb[pixel / 2];	pOut[pixel * 2 + 1] = pY[pixel];
+		pOut[pixel * 2 + 2] = pCr[pixel / 2];	pOut[pixel * 2 + 3] = pY[pixel + 1];
+	}
+}
+
+//	4:2:0 chroma is sited between lines (MPEG-2/H.264/HEVC chroma location type 0), so a chroma row is the
+//	(1,3,3,1)/8 filtered chroma of lines 2r-1 through 2r+2...
+static void DownsampleChroma (const UWord * pA, const UWord * pB, const UWord * pC, const UWord * pD, UWord * pOut, const ULWord inNumSamples)
+{
+	ULWord ndx(0);
+#if defined(AJA_HAS_SSE2)
+	const __m128i four (_mm_set1_epi16(4));
+	for ( ;  ndx + 8 <= inNumSamples;  ndx += 8)
+	{
+		const __m128i bc (_mm_add_epi16(_mm_loadu_si128(reinterpret_cast<const __m128i*>(pB + ndx)), _mm_loadu_si128(reinterpret_cast<const __m128i*>(pC + ndx))));
+		const __m128i ad (_mm_add_epi16(_mm_loadu_si128(reinterpret_cast<const __m128i*>(pA + ndx)), _mm_loadu_si128(reinterpret_cast<const __m128i*>(pD + ndx))));
+		const __m128i sum (_mm_add_epi16(_mm_add_epi16(ad, four), _mm_add_epi16(bc, _mm_add_epi16(bc, bc))));
+		_mm_storeu_si128(reinterpret_cast<__m128i*>(pOut + ndx), _mm_srli_epi16(sum, 3));
+	}
+#endif
+	for ( ;  ndx < inNumSamples;  ndx++)
+		pOut[ndx] = UWord((pA[ndx] + 3 * (pB[ndx] + pC[ndx]) + pD[ndx] + 4) >> 3);
+}
+
+//	...and a line's chroma is interpolated 3/4 from the nearer chroma row, and 1/4 from the farther one
+static void UpsampleChroma (const UWord * pNear, const UWord * pFar, UWord * pOut, const ULWord inNumSamples)
+{
+	ULWord ndx(0);
+#if defined(AJA_HAS_SSE2)
+	const __m128i two (_mm_set1_epi16(2));
+	for ( ;  ndx + 8 <= inNumSamples;  ndx += 8)
+	{
+		const __m128i n (_mm_loadu_si128(reinterpret_cast<const __m128i*>(pNear + ndx)));
+		const __m128i sum (_mm_add_epi16(_mm_add_epi16(n, _mm_add_epi16(n, n)), _mm_add_epi16(_mm_loadu_si128(reinterpret_cast<const __m128i*>(pFar + ndx)), two)));
+		_mm_storeu_si128(reinterpret_cast<__m128i*>(pOut + ndx), _mm_srli_epi16(sum, 2));
+	}
+#endif
+	for ( ;  ndx < inNumSamples;  ndx++)
+		pOut[ndx] = UWord((3 * pNear[ndx] + pFar[ndx] + 2) >> 2);
+}
+
+
+//	A chain of kernels that converts one pixel format into another
+typedef struct ConversionPlan
+{
+	vector<const LineKernel*>	fSteps;			//	For planar conversions, the steps to or from yuv16
+	bool						fValid;
+	ULWord						fCost;
+	string						fDescription;
+	const PlanarInfo *			fpSrcPlanar;	//	Non-NULL if the source is planar
+	const PlanarInfo *			fpDstPlanar;	//	Non-NULL if the destination is planar
+	ConversionPlan() : fValid(false), fCost(0), fpSrcPlanar(AJA_NULL), fpDstPlanar(AJA_NULL)	{}
+} ConversionPlan;
+
+//	How good a chain is -- compared in order of importance
+typedef struct PlanScore
+{
+	ULWord	fLostBits;		//	Bits of precision lost below the lesser of the source & destination
+	ULWord	fCrossings;		//	YCbCr <=> RGB conversions
+	ULWord	fCost;
+	bool operator < (const PlanScore & inRHS) const
+	{
+		if (fLostBits != inRHS.fLostBits)
+			return fLostBits < inRHS.fLostBits;
+		if (fCrossings != inRHS.fCrossings)
+			return fCrossings < inRHS.fCrossings;
+		return fCost < inRHS.fCost;
+	}
+} PlanScore;
+
+//	Depth-first search of the simple paths from the current node to the destination (the graph is tiny)
+static void SearchPlans (const ConvNode inNode, const ConvNode inDst, const ULWord inTargetBits, vector<const LineKernel*> & inOutPath,
+						bool * pInOutVisited, bool & outFound, PlanScore & inOutBestScore, vector<const LineKernel*> & outBestPath)
+{
+	if (inNode == inDst)
+	{
+		PlanScore score = {0, 0, 0};
+		for (size_t ndx(0);  ndx < inOutPath.size();  ndx++)
+		{
+			const LineKernel & kernel (*inOutPath.at(ndx));
+			const ULWord bits (sNodes[kernel.fTo].fBits);
+			if (bits < inTargetBits  &&  inTargetBits - bits > score.fLostBits)
+				score.fLostBits = inTargetBits - bits;
+			if (sNodes[kernel.fFrom].fIsYCbCr != sNodes[kernel.fTo].fIsYCbCr)
+				score.fCrossings++;
+			score.fCost += kernel.fCost;
+		}
+		if (!outFound  ||  score < inOutBestScore)
+			{outFound = true;  inOutBestScore = score;  outBestPath = inOutPath;}
+		return;
+	}
+	if (inOutPath.size() >= kMaxPlanSteps)
+		return;
+	pInOutVisited[inNode] = true;
+	for (size_t ndx(0);  ndx < kNumKernels;  ndx++)
+	{
+		const LineKernel & kernel (sKernels[ndx]);
+		if (kernel.fFrom != inNode  ||  pInOutVisited[kernel.fTo])
+			continue;
+		//	Only intermediates can be passed through -- never another pixel format
+		if (kernel.fTo != inDst  &&  sNodes[kernel.fTo].fPixelFormat != NTV2_FBF_INVALID  &&  kernel.fTo != kNode_argb)
+			continue;
+		inOutPath.push_back(&kernel);
+		SearchPlans(kernel.fTo, inDst, inTargetBits, inOutPath, pInOutVisited, outFound, inOutBestScore, outBestPath);
+		inOutPath.pop_back();
+	}
+	pInOutVisited[inNode] = false;
+}
+
+//	Appends the best chain of kernels between two nodes to the plan
+static bool AddSteps (ConversionPlan & inOutPlan, const ConvNode inSrc, const ConvNode inDst, const ULWord inTargetBits)
+{
+	vector<const LineKernel*>	path,  bestPath;
+	bool						visited[kNode_Count] = {false};
+	bool						found (false);
+	PlanScore					bestScore = {0, 0, 0};
+	SearchPlans(inSrc, inDst, inTargetBits, path, visited, found, bestScore, bestPath);
+	for (size_t ndx(0);  ndx < bestPath.size();  ndx++)
+	{
+		inOutPlan.fSteps.push_back(bestPath.at(ndx));
+		inOutPlan.fCost += bestPath.at(ndx)->fCost;
+		inOutPlan.fDescription += string(" > ") + sNodes[bestPath.at(ndx)->fTo].fName;
+	}
+	return found;
+}
+
+static ConversionPlan BuildPlan (const NTV2PixelFormat inSrcPF, const NTV2PixelFormat inDstPF)
+{
+	ConversionPlan plan;
+	const ConvNode src (NodeForPixelFormat(inSrcPF)),  dst (NodeForPixelFormat(inDstPF));
+	plan.fpSrcPlanar = PlanarInfoForPixelFormat(inSrcPF);
+	plan.fpDstPlanar = PlanarInfoForPixelFormat(inDstPF);
+	if ((src == kNode_Count && !plan.fpSrcPlanar)  ||  (dst == kNode_Count && !plan.fpDstPlanar))
+		return plan;
+	plan.fDescription = plan.fpSrcPlanar ? plan.fpSrcPlanar->fName : sNodes[src].fName;
+	if (inSrcPF == inDstPF)
+	{
+		plan.fValid = true;
+		plan.fCost = 1;
+		plan.fpSrcPlanar = plan.fpDstPlanar = AJA_NULL;	//	Just a copy
+		plan.fDescription += string(" > ") + plan.fDescription;
+		return plan;
+	}
+
+	const ULWord srcBits (plan.fpSrcPlanar ? plan.fpSrcPlanar->fBits : sNodes[src].fBits);
+	const ULWord dstBits (plan.fpDstPlanar ? plan.fpDstPlanar->fBits : sNodes[dst].fBits);
+	const ULWord targetBits (srcBits < dstBits ? srcBits : dstBits);
+	if (plan.fpSrcPlanar  ||  plan.fpDstPlanar)
+	{
+		//	Planar rows are (un)packed to/from yuv16 lines, plus the cost of filtering any 4:2:0 chroma
+		if (plan.fpSrcPlanar)
+			{plan.fCost += plan.fpSrcPlanar->f420 ? 4 : 2;  plan.fDescription += string(" > ") + sNodes[kNode_yuv16].fName;}
+		else if (!AddSteps(plan, src, kNode_yuv16, targetBits))
+			return plan;
+		if (plan.fpDstPlanar)
+			{plan.fCost += plan.fpDstPlanar->f420 ? 4 : 2;  plan.fDescription += string(" > ") + plan.fpDstPlanar->fName;}
+		else if (!AddSteps(plan, kNode_yuv16, dst, targetBits))
+			return plan;
+		plan.fValid = true;
+		return plan;
+	}
+	plan.fValid = AddSteps(plan, src, dst, targetBits);
+	return plan;
+}
+
+
+//	Plans are built on first use, and never change or go away after that
+typedef map<ULWord, ConversionPlan>	ConversionPlanMap;
+static AJALock				gPlanCacheLock;
+static ConversionPlanMap	gPlanCache;
+
+static const ConversionPlan & GetConversionPlan (const NTV2PixelFormat inSrcPF, const NTV2PixelFormat inDstPF)
+{
+	const ULWord key (ULWord(inSrcPF) << 16 | ULWord(inDstPF));
+	AJAAutoLock locker(&gPlanCacheLock);
+	ConversionPlanMap::const_iterator it (gPlanCache.find(key));
+	if (it == gPlanCache.end())
+		it = gPlanCache.insert(ConversionPlanMap::value_type(key, BuildPlan(inSrcPF, inDstPF))).first;
+	return it->second;
+}
+
+
+typedef struct ConvertJob
+{
+	const ConversionPlan *			fpPlan;
+	AJA_ColorMatrix					fMatrix;
+	ConvNode						fSrcNode;
+	ConvNode						fDstNode;
+	const NTV2FormatDescriptor *	fpSrcDesc;
+	const NTV2FormatDescriptor *	fpDstDesc;
+	const UByte *					fpIn;
+	ULWord							fInRowBytes;
+	ULWord							fInBytes;		//	Size of source buffer
+	UByte *							fpOut;
+	ULWord							fOutRowBytes;
+	ULWord							fWidth;
+	ULWord							fHeight;
+} ConvertJob;
+
+//	Per-thread buffers
+typedef struct ConvertWork
+{
+	vector<ULWord>	fScratch[4];		//	0 & 1 for kernel steps, 2 for a copy of the source's last line, 3 for the destination line
+	ComponentLine	fLines[4];			//	Source lines, for 4:2:0 chroma filtering
+	LWord			fLineIndex[4];		//	Which line is in each of fLines, or -1
+	ComponentLine	fChromaRows[3];		//	Source 4:2:0 chroma rows (in fCb & fCr)
+	LWord			fChromaIndex[3];	//	Which row is in each of fChromaRows, or -1
+	vector<UWord>	fSamples;			//	A line of yuv16, or a plane row of samples
+
+	explicit ConvertWork (const ULWord inWidth)
+	{
+		const ULWord scratchWords ((inWidth + 47) / 48 * 48 * kMaxBytesPerPixel / 4);
+		for (ULWord ndx(0);  ndx < 4;  ndx++)
+			{fScratch[ndx].assign(scratchWords, 0);  fLines[ndx].Allocate(inWidth);  fLineIndex[ndx] = -1;}
+		for (ULWord ndx(0);  ndx < 3;  ndx++)
+			{fChromaRows[ndx].Allocate(inWidth);  fChromaIndex[ndx] = -1;}
+		fSamples.assign(scratchWords * 2, 0);
+	}
+} ConvertWork;
+
+//	Runs a chain of kernels on a line. The last writes to pLastOut (if non-NULL), the others to scratch.
+static const void * RunSteps (const vector<const LineKernel*> & inSteps, const void * pIn, void * pLastOut, const ULWord inWidth,
+								const AJA_ColorMatrix inMatrix, ConvertWork & inWork)
+{
+	const void * pStepIn (pIn);
+	for (size_t step(0);  step < inSteps.size();  step++)
+	{
+		const LineKernel &	kernel		(*inSteps.at(step));
+		void *				pStepOut	(step + 1 == inSteps.size() && pLastOut ? pLastOut : reinterpret_cast<void*>(&inWork.fScratch[step & 1][0]));
+		kernel.fFunc(pStepIn, pStepOut, kernel.PaddedWidth(inWidth), inMatrix);
+		pStepIn = pStepOut;
+	}
+	return pStepIn;
+}
+
+//	Each kernel gets the line width rounded up to its pixel group size -- no wider, as some look at neighboring
+//	pixels. So they may read past the end of the source buffer on its last line, in which case a copy is used.
+static const UByte * GetPackedSourceLine (const ConvertJob & inJob, const ULWord inLine, ConvertWork & inWork)
+{
+	const UByte *	pInLine		(inJob.fpIn + size_t(inLine) * inJob.fInRowBytes);
+	const size_t	readBytes	(inJob.fpPlan->fSteps.empty() ? 0 : LineBytes(inJob.fSrcNode, inJob.fpPlan->fSteps.front()->PaddedWidth(inJob.fWidth)));
+	if (size_t(inLine) * inJob.fInRowBytes + readBytes > inJob.fInBytes)
+	{
+		::memcpy(&inWork.fScratch[2][0], pInLine, inJob.fInBytes - size_t(inLine) * inJob.fInRowBytes);
+		pInLine = reinterpret_cast<const UByte*>(&inWork.fScratch[2][0]);
+	}
+	return pInLine;
+}
+
+//	They may also write past the end of a line, which would step on the next line (owned by another thread)
+//	unless the line pitch has room for it;  otherwise the last step writes to scratch, which is then copied.
+static void PutPackedDestLine (const ConvertJob & inJob, const ULWord inLine, const void * pInLine, ConvertWork & inWork)
+{
+	const vector<const LineKernel*> &	steps		(inJob.fpPlan->fSteps);
+	UByte *								pOutLine	(inJob.fpOut + size_t(inLine) * inJob.fOutRowBytes);
+	if (steps.empty())
+		{::memcpy(pOutLine, pInLine, LineBytes(inJob.fDstNode, inJob.fWidth));  return;}
+	if (LineBytes(inJob.fDstNode, steps.back()->PaddedWidth(inJob.fWidth)) <= inJob.fOutRowBytes)
+		RunSteps(steps, pInLine, pOutLine, inJob.fWidth, inJob.fMatrix, inWork);
+	else
+		::memcpy(pOutLine, RunSteps(steps, pInLine, &inWork.fScratch[3][0], inJob.fWidth, inJob.fMatrix, inWork), LineBytes(inJob.fDstNode, inJob.fWidth));
+}
+
+//	Converts lines [inBegin, inEnd) between packed formats
+static void ConvertLines (void * pContext, uint32_t inBegin, uint32_t inEnd)
+{
+	const ConvertJob &	job		(*reinterpret_cast<const ConvertJob*>(pContext));
+	ConvertWork			work	(job.fWidth);
+	for (ULWord line(inBegin);  line < inEnd;  line++)
+		PutPackedDestLine(job, line, job.fpPlan->fSteps.empty() ? job.fpIn + size_t(line) * job.fInRowBytes : GetPackedSourceLine(job, line, work), work);
+}
+
+//	Reads a row of a planar source's chroma plane(s) into separate Cb & Cr sample rows
+static void ReadChromaRow (const ConvertJob & inJob, const ULWord inRow, ComponentLine & outRow, ConvertWork & inWork)
+{
+	const PlanarInfo &	planar	(*inJob.fpPlan->fpSrcPlanar);
+	const ULWord		samples	(inJob.fWidth / 2);
+	if (planar.fNumPlanes == 3)
+	{
+		UnpackSamples(inJob.fpSrcDesc->GetRowAddress(inJob.fpIn, inRow, 1), &outRow.fCb[0], samples, planar.fPacking);
+		UnpackSamples(inJob.fpSrcDesc->GetRowAddress(inJob.fpIn, inRow, 2), &outRow.fCr[0], samples, planar.fPacking);
+		return;
+	}
+	UWord * pCbCr (&inWork.fSamples[0]);
+	UnpackSamples(inJob.fpSrcDesc->GetRowAddress(inJob.fpIn, inRow, 1), pCbCr, samples * 2, planar.fPacking);
+	for (ULWord ndx(0);  ndx < samples;  ndx++)
+		{outRow.fCb[ndx] = pCbCr[2 * ndx];  outRow.fCr[ndx] = pCbCr[2 * ndx + 1];}
+}
+
+//	Writes Cb & Cr sample rows to a row of a planar destination's chroma plane(s)
+static void WriteChromaRow (const ConvertJob & inJob, const ULWord inRow, const UWord * pInCb, const UWord * pInCr, ConvertWork & inWork)
+{
+	const PlanarInfo &	planar	(*inJob.fpPlan->fpDstPlanar);
+	const ULWord		samples	(inJob.fWidth / 2);
+	if (planar.fNumPlanes == 3)
+	{
+		PackSamples(pInCb, inJob.fpDstDesc->GetWriteableRowAddress(inJob.fpOut, inRow, 1), samples, planar.fPacking);
+		PackSamples(pInCr, inJob.fpDstDesc->GetWriteableRowAddress(inJob.fpOut, inRow, 2), samples, planar.fPacking);
+		return;
+	}
+	UWord * pCbCr (&inWork.fSamples[0]);
+	for (ULWord ndx(0);  ndx < samples;  ndx++)
+		{pCbCr[2 * ndx] = pInCb[ndx];  pCbCr[2 * ndx + 1] = pInCr[ndx];}
+	PackSamples(pCbCr, inJob.fpDstDesc->GetWriteableRowAddress(inJob.fpOut, inRow, 1), samples * 2, planar.fPacking);
+}
+
+//	Gets a source line's components
+static void GetSourceLine (const ConvertJob & inJob, const ULWord inLine, ComponentLine & outLine, ConvertWork & inWork)
+{
+	const PlanarInfo * pPlanar (inJob.fpPlan->fpSrcPlanar);
+	if (!pPlanar)
+	{
+		const void * pYUV16 (RunSteps(inJob.fpPlan->fSteps, GetPackedSourceLine(inJob, inLine, inWork), &inWork.fSamples[0], inJob.fWidth, inJob.fMatrix, inWork));
+		SplitYUV16(reinterpret_cast<const UWord*>(pYUV16), outLine, inJob.fWidth);
+		return;
+	}
+	UnpackSamples(inJob.fpSrcDesc->GetRowAddress(inJob.fpIn, inLine, 0), &outLine.fY[0], inJob.fWidth, pPlanar->fPacking);
+	if (!pPlanar->f420)
+		{ReadChromaRow(inJob, inLine, outLine, inWork);  return;}
+
+	const LWord lastRow (LWord(inJob.fHeight / 2) - 1),  nearRow (LWord(inLine / 2));
+	LWord farRow (inLine & 1 ? nearRow + 1 : nearRow - 1);
+	farRow = farRow < 0 ? 0 : (farRow > lastRow ? lastRow : farRow);
+	const LWord rows[2] = {nearRow, farRow};
+	for (ULWord ndx(0);  ndx < 2;  ndx++)
+		if (inWork.fChromaIndex[rows[ndx] % 3] != rows[ndx])
+		{
+			ReadChromaRow(inJob, ULWord(rows[ndx]), inWork.fChromaRows[rows[ndx] % 3], inWork);
+			inWork.fChromaIndex[rows[ndx] % 3] = rows[ndx];
+		}
+	const ComponentLine & nearChroma (inWork.fChromaRows[nearRow % 3]),  & farChroma (inWork.fChromaRows[farRow % 3]);
+	UpsampleChroma(&nearChroma.fCb[0], &farChroma.fCb[0], &outLine.fCb[0], inJob.fWidth / 2);
+	UpsampleChroma(&nearChroma.fCr[0], &farChroma.fCr[0], &outLine.fCr[0], inJob.fWidth / 2);
+}
+
+//	Gets a source line's components, reusing the last few lines fetched. Lines off the top or bottom are replicas of the edge line.
+static const ComponentLine & GetCachedSourceLine (const ConvertJob & inJob, LWord inLine, ConvertWork & inWork)
+{
+	inLine = inLine < 0 ? 0 : (inLine >= LWord(inJob.fHeight) ? LWord(inJob.fHeight) - 1 : inLine);
+	const ULWord slot (ULWord(inLine) & 3);
+	if (inWork.fLineIndex[slot] != inLine)
+		{GetSourceLine(inJob, ULWord(inLine), inWork.fLines[slot], inWork);  inWork.fLineIndex[slot] = inLine;}
+	return inWork.fLines[slot];
+}
+
+//	Converts items [inBegin, inEnd) to or from a planar format -- the items are chroma rows for a 4:2:0 destination, otherwise lines
+static void ConvertPlanarLines (void * pContext, uint32_t inBegin, uint32_t inEnd)
+{
+	const ConvertJob &	job			(*reinterpret_cast<const ConvertJob*>(pContext));
+	const PlanarInfo *	pDstPlanar	(job.fpPlan->fpDstPlanar);
+	ConvertWork			work		(job.fWidth);
+	ComponentLine &		line		(work.fLines[0]);
+	for (ULWord item(inBegin);  item < inEnd;  item++)
+		if (!pDstPlanar)
+		{
+			GetSourceLine(job, item, line, work);
+			MergeYUV16(line, &work.fSamples[0], job.fWidth);
+			PutPackedDestLine(job, item, &work.fSamples[0], work);
+		}
+		else if (!pDstPlanar->f420)
+		{
+			GetSourceLine(job, item, line, work);
+			PackSamples(&line.fY[0], job.fpDstDesc->GetWriteableRowAddress(job.fpOut, item, 0), job.fWidth, pDstPlanar->fPacking);
+			WriteChromaRow(job, item, &line.fCb[0], &line.fCr[0], work);
+		}
+		else if (job.fpPlan->fpSrcPlanar  &&  job.fpPlan->fpSrcPlanar->f420)
+		{
+			//	4:2:0 to 4:2:0 -- the chroma rows are already sited, so just repack them
+			const PlanarInfo & srcPlanar (*job.fpPlan->fpSrcPlanar);
+			for (ULWord row(item * 2);  row < item * 2 + 2;  row++)
+			{
+				UnpackSamples(job.fpSrcDesc->GetRowAddress(job.fpIn, row, 0), &line.fY[0], job.fWidth, srcPlanar.fPacking);
+				PackSamples(&line.fY[0], job.fpDstDesc->GetWriteableRowAddress(job.fpOut, row, 0), job.fWidth, pDstPlanar->fPacking);
+			}
+			ReadChromaRow(job, item, line, work);
+			WriteChromaRow(job, item, &line.fCb[0], &line.fCr[0], work);
+		}
+		else
+		{
+			const LWord			first	(LWord(item) * 2);
+			const ComponentLine &	l0	(GetCachedSourceLine(job, first - 1, work));
+			const ComponentLine &	l1	(GetCachedSourceLine(job, first, work));
+			const ComponentLine &	l2	(GetCachedSourceLine(job, first + 1, work));
+			const ComponentLine &	l3	(GetCachedSourceLine(job, first + 2, work));
+			PackSamples(&l1.fY[0], job.fpDstDesc->GetWriteableRowAddress(job.fpOut, ULWord(first), 0), job.fWidth, pDstPlanar->fPacking);
+			PackSamples(&l2.fY[0], job.fpDstDesc->GetWriteableRowAddress(job.fpOut, ULWord(first + 1), 0), job.fWidth, pDstPlanar->fPacking);
+			ComponentLine & chroma (work.fChromaRows[0]);
+			DownsampleChroma(&l0.fCb[0], &l1.fCb[0], &l2.fCb[0], &l3.fCb[0], &chroma.fCb[0], job.fWidth / 2);
+			DownsampleChroma(&l0.fCr[0], &l1.fCr[0], &l2.fCr[0], &l3.fCr[0], &chroma.fCr[0], job.fWidth / 2);
+			WriteChromaRow(job, item, &chroma.fCb[0], &chroma.fCr[0], work);
+		}
+}
+
+
+CNTV2PixelFormatConverter::CNTV2PixelFormatConverter (const AJA_ColorMatrix inMatrix, AJAWorkerPool * pInPool)
+	:	mpPool	(pInPool ? pInPool : &AJAWorkerPool::GetSharedPool()),
+		mMatrix	(inMatrix)
+{
+}
+
+CNTV2PixelFormatConverter::~CNTV2PixelFormatConverter ()
+{
+}
+
+bool CNTV2PixelFormatConverter::Convert (const NTV2Buffer & inFrame,  const NTV2FormatDescriptor & inDesc,
+										NTV2Buffer & outFrame,  const NTV2FormatDescriptor & inOutDesc)
+{
+	const NTV2PixelFormat	srcPF	(inDesc.GetPixelFormat());
+	const NTV2PixelFormat	dstPF	(inOutDesc.GetPixelFormat());
+	const ULWord			width	(inDesc.GetRasterWidth());
+	const ULWord			height	(inDesc.GetRasterHeight());
+	if (!inDesc.IsValid()  ||  !inOutDesc.IsValid())
+		{PFCFAIL("Invalid format descriptor");  return false;}
+	if (mMatrix >= AJA_ColorMatrix_Size)
+		{PFCFAIL("Invalid color matrix " << DEC(mMatrix));  return false;}
+	const ConversionPlan & plan (GetConversionPlan(srcPF, dstPF));
+	if (!plan.fValid)
+		{PFCFAIL("Can't convert " << ::NTV2FrameBufferFormatToString(srcPF) << " to " << ::NTV2FrameBufferFormatToString(dstPF));  return false;}
+	if (inOutDesc.GetRasterWidth() != width  ||  inOutDesc.GetRasterHeight() != height  ||  !width  ||  !height)
+		{PFCFAIL("Raster " << DEC(width) << "x" << DEC(height) << " doesn't match destination " << DEC(inOutDesc.GetRasterWidth()) << "x" << DEC(inOutDesc.GetRasterHeight()));  return false;}
+	const ConvNode srcNode (NodeForPixelFormat(srcPF)),  dstNode (NodeForPixelFormat(dstPF));
+	const bool srcPlanar (inDesc.IsPlanar()),  dstPlanar (inOutDesc.IsPlanar());
+	if ((width & 1)  &&  (srcPlanar  ||  dstPlanar  ||  sNodes[srcNode].fIsYCbCr  ||  sNodes[dstNode].fIsYCbCr))	//	Planar formats are all YCbCr
+		{PFCFAIL("Odd raster width " << DEC(width) << " for 4:2:2 pixel format");  return false;}
+	if ((height & 1)  &&  ((plan.fpSrcPlanar && plan.fpSrcPlanar->f420)  ||  (plan.fpDstPlanar && plan.fpDstPlanar->f420)))
+		{PFCFAIL("Odd raster height " << DEC(height) << " for 4:2:0 pixel format");  return false;}
+	if ((!srcPlanar && inDesc.GetBytesPerRow() < LineBytes(srcNode, width))  ||  (!dstPlanar && inOutDesc.GetBytesPerRow() < LineBytes(dstNode, width)))
+		{PFCFAIL("Line pitch too small for " << DEC(width) << "-pixel line");  return false;}
+	const ULWord srcBytes (srcPlanar ? inDesc.GetTotalBytes() : inDesc.GetBytesPerRow() * height);
+	const ULWord dstBytes (dstPlanar ? inOutDesc.GetTotalBytes() : inOutDesc.GetBytesPerRow() * height);
+	if (inFrame.GetByteCount() < srcBytes)
+		{PFCFAIL("Source buffer " << DEC(inFrame.GetByteCount()) << " bytes smaller than raster " << DEC(srcBytes));  return false;}
+	if (outFrame.GetByteCount() < dstBytes)
+		{PFCFAIL("Destination buffer " << DEC(outFrame.GetByteCount()) << " bytes smaller than raster " << DEC(dstBytes));  return false;}
+	if (srcPF == dstPF  &&  srcPlanar)
+		return outFrame.CopyFrom(inFrame, 0, 0, srcBytes);
+
+	ConvertJob job;
+	job.fpPlan		= &plan;
+	job.fMatrix		= mMatrix;
+	job.fSrcNode	= srcNode;
+	job.fDstNode	= dstNode;
+	job.fpSrcDesc	= &inDesc;
+	job.fpDstDesc	= &inOutDesc;
+	job.fpIn		= inFrame;
+	job.fInRowBytes	= inDesc.GetBytesPerRow();
+	job.fInBytes	= inFrame.GetByteCount();
+	job.fpOut		= outFrame;
+	job.fOutRowBytes= inOutDesc.GetBytesPerRow();
+	job.fWidth		= width;
+	job.fHeight		= height;
+	if (!plan.fpSrcPlanar  &&  !plan.fpDstPlanar)
+		return AJA_SUCCESS(mpPool->ParallelFor(height, ConvertLines, &job));
+	//	Bands of 4:2:0 chroma rows share their edge source lines with the neighboring bands, so keep them big
+	const ULWord numItems (plan.fpDstPlanar && plan.fpDstPlanar->f420 ? height / 2 : height);
+	return AJA_SUCCESS(mpPool->ParallelFor(numItems, ConvertPlanarLines, &job));
+}
+
+bool CNTV2PixelFormatConverter::CanConvert (const NTV2PixelFormat inSrcPixelFormat, const NTV2PixelFormat inDstPixelFormat)
+{
+	return GetConversionPlan(inSrcPixelFormat, inDstPixelFormat).fValid;
+}
+
+string CNTV2PixelFormatConverter::GetPlan (const NTV2PixelFormat inSrcPixelFormat, const NTV2PixelFormat inDstPixelFormat)
+{
+	const ConversionPlan & plan (GetConversionPlan(inSrcPixelFormat, inDstPixelFormat));
+	return plan.fValid ? plan.fDescription : string();
+}
+
+ULWord CNTV2PixelFormatConverter::GetPlanCost (const NTV2PixelFormat inSrcPixelFormat, const NTV2PixelFormat inDstPixelFormat)
+{
+	const ConversionPlan & plan (GetConversionPlan(inSrcPixelFormat, inDstPixelFormat));
+	return plan.fValid ? plan.fCost : 0;
+}
+
+size_t CNTV2PixelFormatConverter::GetNumCachedPlans (void)
+{
+	AJAAutoLock locker(&gPlanCacheLock);
+	return gPlanCache.size();
+}
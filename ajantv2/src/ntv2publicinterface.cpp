@@ -3093,6 +3093,25 @@ bool NTV2GetRegisters::PatchRegister (const ULWord inRegNum, const ULWord inValu
 }
 
 
+bool NTV2GetRegisters::AddRegisterValue (const ULWord inRegNum, const ULWord inValue)
+{
+	if (!mOutGoodRegisters)
+		return false;		//	Empty/null 'mOutGoodRegisters' array!
+	if (!mOutValues)
+		return false;		//	Empty/null 'mOutValues' array!
+	if (mOutNumRegisters >= mInNumRegisters)
+		return false;		//	Can't have read more registers than were requested
+	if (mOutGoodRegisters.GetByteCount() / sizeof(ULWord) <= mOutNumRegisters  ||  mOutValues.GetByteCount() / sizeof(ULWord) <= mOutNumRegisters)
+		return false;		//	Sanity check failed:  arrays too small
+	ULWord *	pRegArray	(mOutGoodRegisters);
+	ULWord *	pValArray	(mOutValues);
+	pRegArray[mOutNumRegisters] = inRegNum;
+	pValArray[mOutNumRegisters] = inValue;
+	mOutNumRegisters++;
+	return true;
+}
+
+
 bool NTV2GetRegisters::GetRegisterValues (NTV2RegisterValueMap & outValues) const
 {
 	NTV2_ASSERT_STRUCT_VALID;
@@ -0,0 +1,471 @@
+/* SPDX-License-Identifier: MIT */
+/**
+	@file		ntv2quadrasterconverter.cpp
+	@brief		Implements the CNTV2QuadRasterConverter class.
+	@copyright	(C) 2023 AJA Video Systems, Inc.
+**/
+
+#include "ntv2quadrasterconverter.h"
+#include "ntv2utils.h"
+#include "ajabase/system/debug.h"
+#include "ajabase/system/workerpool.h"
+#include <vector>
+#include <string.h>
+#if defined(AJA_HAS_SSE2)
+	#include <emmintrin.h>
+#endif
+
+using namespace std;
+
+#define QRFAIL(__x__)	AJA_sERROR	(AJA_DebugUnit_VideoGeneric, AJAFUNC << ": " << __x__)
+
+
+string NTV2QuadLayoutToString (const NTV2QuadLayout inLayout, const bool inCompact)
+{
+	switch (inLayout)
+	{
+		case NTV2_QUAD_LAYOUT_SQUARES:	return inCompact ? "squares"	: "NTV2_QUAD_LAYOUT_SQUARES";
+		case NTV2_QUAD_LAYOUT_TSI:		return inCompact ? "2SI"		: "NTV2_QUAD_LAYOUT_TSI";
+		case NTV2_QUAD_LAYOUT_INVALID:	break;
+	}
+	return inCompact ? "???" : "NTV2_QUAD_LAYOUT_INVALID";
+}
+
+
+//	The supported pixel formats
+typedef struct QuadFormat
+{
+	NTV2PixelFormat	fPixelFormat;
+	ULWord			fBytesPerPixel;		//	Zero for v210, which packs 6 pixels into 16 bytes
+} QuadFormat;
+
+static const QuadFormat sQuadFormats[] =
+{
+	{NTV2_FBF_10BIT_YCBCR,		0},
+	{NTV2_FBF_8BIT_YCBCR,		2},
+	{NTV2_FBF_8BIT_YCBCR_YUY2,	2},
+	{NTV2_FBF_ARGB,				4},
+	{NTV2_FBF_RGBA,				4},
+	{NTV2_FBF_ABGR,				4},
+	{NTV2_FBF_10BIT_RGB,		4},
+	{NTV2_FBF_10BIT_DPX,		4},
+	{NTV2_FBF_10BIT_DPX_LE,		4},
+	{NTV2_FBF_24BIT_RGB,		3},
+	{NTV2_FBF_24BIT_BGR,		3},
+	{NTV2_FBF_48BIT_RGB,		6}
+};
+
+static const ULWord	kYUV16BytesPerPixel	(4);	//	Unpacked v210:  Cb,Y or Cr,Y 16-bit components
+
+static const QuadFormat * QuadFormatForPixelFormat (const NTV2PixelFormat inPF)
+{
+	for (size_t ndx(0);  ndx < sizeof(sQuadFormats) / sizeof(sQuadFormats[0]);  ndx++)
+		if (sQuadFormats[ndx].fPixelFormat == inPF)
+			return &sQuadFormats[ndx];
+	return AJA_NULL;
+}
+
+static ULWord RowBytes (const QuadFormat & inFormat, const ULWord inWidth)
+{
+	return inFormat.fBytesPerPixel ? inWidth * inFormat.fBytesPerPixel : (inWidth + 47) / 48 * 128;
+}
+
+
+//	2SI rows take alternate pixel pairs of a line. These split a run of pairs into its even and odd pairs...
+template <ULWord N> static void DeinterleavePairs (const UByte * pIn, UByte * pOutEven, UByte * pOutOdd, const ULWord inNumPairs)
+{
+	for (ULWord pair(0);  pair < inNumPairs;  pair++,  pIn += 2 * N)
+	{
+		::memcpy(pOutEven + pair * N, pIn, N);
+		::memcpy(pOutOdd + pair * N, pIn + N, N);
+	}
+}
+
+//	...and merge them back
+template <ULWord N> static void InterleavePairs (const UByte * pInEven, const UByte * pInOdd, UByte * pOut, const ULWord inNumPairs)
+{
+	for (ULWord pair(0);  pair < inNumPairs;  pair++,  pOut += 2 * N)
+	{
+		::memcpy(pOut, pInEven + pair * N, N);
+		::memcpy(pOut + N, pInOdd + pair * N, N);
+	}
+}
+
+#if defined(AJA_HAS_SSE2)
+	//	The SSE2 versions handle 4-byte (8-bit 4:2:2) and 8-byte (4-byte pixel, or unpacked v210) pairs, and return
+	//	the number of pairs done, leaving any remainder to the scalar versions
+	static ULWord DeinterleavePairsSSE2 (const UByte * pIn, UByte * pOutEven, UByte * pOutOdd, const ULWord inNumPairs, const ULWord inPairBytes)
+	{
+		ULWord pair(0);
+		if (inPairBytes == 8)
+			for ( ;  pair + 2 <= inNumPairs;  pair += 2)
+			{
+				const __m128i a (_mm_loadu_si128(reinterpret_cast<const __m128i*>(pIn + pair * 16)));		//	E0 O0
+				const __m128i b (_mm_loadu_si128(reinterpret_cast<const __m128i*>(pIn + pair * 16 + 16)));	//	E1 O1
+				_mm_storeu_si128(reinterpret_cast<__m128i*>(pOutEven + pair * 8), _mm_unpacklo_epi64(a, b));
+				_mm_storeu_si128(reinterpret_cast<__m128i*>(pOutOdd + pair * 8), _mm_unpackhi_epi64(a, b));
+			}
+		else if (inPairBytes == 4)
+			for ( ;  pair + 4 <= inNumPairs;  pair += 4)
+			{
+				const __m128i a (_mm_shuffle_epi32(_mm_loadu_si128(reinterpret_cast<const __m128i*>(pIn + pair * 8)), _MM_SHUFFLE(3,1,2,0)));		//	E0 E1 O0 O1
+				const __m128i b (_mm_shuffle_epi32(_mm_loadu_si128(reinterpret_cast<const __m128i*>(pIn + pair * 8 + 16)), _MM_SHUFFLE(3,1,2,0)));	//	E2 E3 O2 O3
+				_mm_storeu_si128(reinterpret_cast<__m128i*>(pOutEven + pair * 4), _mm_unpacklo_epi64(a, b));
+				_mm_storeu_si128(reinterpret_cast<__m128i*>(pOutOdd + pair * 4), _mm_unpackhi_epi64(a, b));
+			}
+		return pair;
+	}
+
+	static ULWord InterleavePairsSSE2 (const UByte * pInEven, const UByte * pInOdd, UByte * pOut, const ULWord inNumPairs, const ULWord inPairBytes)
+	{
+		ULWord pair(0);
+		if (inPairBytes == 8)
+			for ( ;  pair + 2 <= inNumPairs;  pair += 2)
+			{
+				const __m128i e (_mm_loadu_si128(reinterpret_cast<const __m128i*>(pInEven + pair * 8)));
+				const __m128i o (_mm_loadu_si128(reinterpret_cast<const __m128i*>(pInOdd + pair * 8)));
+				_mm_storeu_si128(reinterpret_cast<__m128i*>(pOut + pair * 16), _mm_unpacklo_epi64(e, o));
+				_mm_storeu_si128(reinterpret_cast<__m128i*>(pOut + pair * 16 + 16), _mm_unpackhi_epi64(e, o));
+			}
+		else if (inPairBytes == 4)
+			for ( ;  pair + 4 <= inNumPairs;  pair += 4)
+			{
+				const __m128i e (_mm_loadu_si128(reinterpret_cast<const __m128i*>(pInEven + pair * 4)));
+				const __m128i o (_mm_loadu_si128(reinterpret_cast<const __m128i*>(pInOdd + pair * 4)));
+				_mm_storeu_si128(reinterpret_cast<__m128i*>(pOut + pair * 8), _mm_unpacklo_epi32(e, o));
+				_mm_storeu_si128(reinterpret_cast<__m128i*>(pOut + pair * 8 + 16), _mm_unpackhi_epi32(e, o));
+			}
+		return pair;
+	}
+#endif	//	AJA_HAS_SSE2
+
+static void Deinterleave (const UByte * pIn, UByte * pOutEven, UByte * pOutOdd, const ULWord inNumPairs, const ULWord inPairBytes, const bool inUseSIMD)
+{
+	ULWord done(0);
+#if defined(AJA_HAS_SSE2)
+	if (inUseSIMD)
+		done = DeinterleavePairsSSE2(pIn, pOutEven, pOutOdd, inNumPairs, inPairBytes);
+#else
+	(void) inUseSIMD;
+#endif
+	pIn += 2 * done * inPairBytes;  pOutEven += done * inPairBytes;  pOutOdd += done * inPairBytes;
+	switch (inPairBytes)
+	{
+		case 4:		DeinterleavePairs<4>(pIn, pOutEven, pOutOdd, inNumPairs - done);	break;
+		case 6:		DeinterleavePairs<6>(pIn, pOutEven, pOutOdd, inNumPairs - done);	break;
+		case 8:		DeinterleavePairs<8>(pIn, pOutEven, pOutOdd, inNumPairs - done);	break;
+		case 12:	DeinterleavePairs<12>(pIn, pOutEven, pOutOdd, inNumPairs - done);	break;
+		default:	NTV2_ASSERT(false);	break;
+	}
+}
+
+static void Interleave (const UByte * pInEven, const UByte * pInOdd, UByte * pOut, const ULWord inNumPairs, const ULWord inPairBytes, const bool inUseSIMD)
+{
+	ULWord done(0);
+#if defined(AJA_HAS_SSE2)
+	if (inUseSIMD)
+		done = InterleavePairsSSE2(pInEven, pInOdd, pOut, inNumPairs, inPairBytes);
+#else
+	(void) inUseSIMD;
+#endif
+	pInEven += done * inPairBytes;  pInOdd += done * inPairBytes;  pOut += 2 * done * inPairBytes;
+	switch (inPairBytes)
+	{
+		case 4:		InterleavePairs<4>(pInEven, pInOdd, pOut, inNumPairs - done);	break;
+		case 6:		InterleavePairs<6>(pInEven, pInOdd, pOut, inNumPairs - done);	break;
+		case 8:		InterleavePairs<8>(pInEven, pInOdd, pOut, inNumPairs - done);	break;
+		case 12:	InterleavePairs<12>(pInEven, pInOdd, pOut, inNumPairs - done);	break;
+		default:	NTV2_ASSERT(false);	break;
+	}
+}
+
+
+//	v210 packs 3 pairs into each 16-byte group, so 12 pixels of a line give a whole group to each 2SI row:
+//		line	s0 s1 s2 | s3 s4 s5 | s6 s7 s8 | s9 s10 s11 || t0 t1 t2 | t3 t4 t5 | t6 t7 t8 | t9 t10 t11
+//		even	s0 s1 s2 | s3 s8 s9 | s10 s11 t4 | t5 t6 t7
+//		odd		s4 s5 s6 | s7 t0 t1 | t2 t3 t8 | t9 t10 t11
+#define	V210_SAMPLE(__w__,__n__)	(((__w__) >> (10 * (__n__))) & 0x3FF)
+
+static void DeinterleaveV210 (const ULWord * pIn, ULWord * pOutEven, ULWord * pOutOdd, const ULWord inNumGroups)
+{
+	for (ULWord group(0);  group < inNumGroups;  group++,  pIn += 8,  pOutEven += 4,  pOutOdd += 4)
+	{
+		const ULWord	s0 (pIn[0]),  s3 (pIn[1]),  s6 (pIn[2]),  s9 (pIn[3]),  t0 (pIn[4]),  t3 (pIn[5]),  t6 (pIn[6]),  t9 (pIn[7]);
+		pOutEven[0]	= s0 & 0x3FFFFFFF;
+		pOutEven[1]	= V210_SAMPLE(s3,0) | V210_SAMPLE(s6,2) << 10 | V210_SAMPLE(s9,0) << 20;
+		pOutEven[2]	= ((s9 >> 10) & 0xFFFFF) | V210_SAMPLE(t3,1) << 20;
+		pOutEven[3]	= V210_SAMPLE(t3,2) | (t6 & 0xFFFFF) << 10;
+		pOutOdd[0]	= ((s3 >> 10) & 0xFFFFF) | V210_SAMPLE(s6,0) << 20;
+		pOutOdd[1]	= V210_SAMPLE(s6,1) | (t0 & 0xFFFFF) << 10;
+		pOutOdd[2]	= V210_SAMPLE(t0,2) | V210_SAMPLE(t3,0) << 10 | V210_SAMPLE(t6,2) << 20;
+		pOutOdd[3]	= t9 & 0x3FFFFFFF;
+	}
+}
+
+static void InterleaveV210 (const ULWord * pInEven, const ULWord * pInOdd, ULWord * pOut, const ULWord inNumGroups)
+{
+	for (ULWord group(0);  group < inNumGroups;  group++,  pInEven += 4,  pInOdd += 4,  pOut += 8)
+	{
+		const ULWord	e0 (pInEven[0]),  e1 (pInEven[1]),  e2 (pInEven[2]),  e3 (pInEven[3]);
+		const ULWord	o0 (pInOdd[0]),  o1 (pInOdd[1]),  o2 (pInOdd[2]),  o3 (pInOdd[3]);
+		pOut[0]	= e0 & 0x3FFFFFFF;
+		pOut[1]	= V210_SAMPLE(e1,0) | (o0 & 0xFFFFF) << 10;
+		pOut[2]	= V210_SAMPLE(o0,2) | V210_SAMPLE(o1,0) << 10 | V210_SAMPLE(e1,1) << 20;
+		pOut[3]	= V210_SAMPLE(e1,2) | (e2 & 0xFFFFF) << 10;
+		pOut[4]	= ((o1 >> 10) & 0xFFFFF) | V210_SAMPLE(o2,0) << 20;
+		pOut[5]	= V210_SAMPLE(o2,1) | V210_SAMPLE(e2,2) << 10 | V210_SAMPLE(e3,0) << 20;
+		pOut[6]	= ((e3 >> 10) & 0xFFFFF) | V210_SAMPLE(o2,2) << 20;
+		pOut[7]	= o3 & 0x3FFFFFFF;
+	}
+}
+
+
+typedef enum
+{
+	kLayout_Full,		//	One buffer
+	kLayout_Squares,	//	Four buffers, NTV2_QUAD_LAYOUT_SQUARES
+	kLayout_TSI			//	Four buffers, NTV2_QUAD_LAYOUT_TSI
+} RasterLayout;
+
+//	One side (source or destination) of a conversion
+typedef struct RasterSide
+{
+	RasterLayout	fLayout;
+	UByte *			fpBase[4];		//	Full raster in [0], or the sub-images
+	ULWord			fRowBytes;
+} RasterSide;
+
+//	Finds the two rows that hold a line of the full raster:  its left & right halves (full raster or square division),
+//	or the rows that take its even & odd pixel pairs (2SI)
+static void GetLineRows (const RasterSide & inSide, const ULWord inLine, const ULWord inHalfHeight, const ULWord inHalfBytes, UByte ** pOutRows)
+{
+	ULWord quad(0),  row(inLine);
+	switch (inSide.fLayout)
+	{
+		case kLayout_Full:
+			pOutRows[0] = inSide.fpBase[0] + size_t(inLine) * inSide.fRowBytes;
+			pOutRows[1] = pOutRows[0] + inHalfBytes;
+			return;
+		case kLayout_Squares:	quad = inLine < inHalfHeight ? 0 : 2;	row = inLine % inHalfHeight;	break;
+		case kLayout_TSI:		quad = inLine & 1 ? 2 : 0;				row = inLine / 2;				break;
+	}
+	pOutRows[0] = inSide.fpBase[quad] + size_t(row) * inSide.fRowBytes;
+	pOutRows[1] = inSide.fpBase[quad + 1] + size_t(row) * inSide.fRowBytes;
+}
+
+//	Moves a line of the full raster between rows found by GetLineRows
+static void MoveLine (UByte * const * pInRows, const RasterLayout inSrcLayout, UByte * const * pOutRows, const RasterLayout inDstLayout,
+						const ULWord inHalfWidth, const ULWord inHalfBytes, const ULWord inBytesPerPixel, const bool inUseSIMD)
+{
+	const bool srcTSI (inSrcLayout == kLayout_TSI),  dstTSI (inDstLayout == kLayout_TSI);
+	if (srcTSI == dstTSI)
+	{
+		::memcpy(pOutRows[0], pInRows[0], inHalfBytes);
+		::memcpy(pOutRows[1], pInRows[1], inHalfBytes);
+		return;
+	}
+	//	Each half of the line holds a quarter of the line's pairs, and gives half of them to each 2SI row
+	const ULWord pairBytes (2 * inBytesPerPixel),  numPairs (inHalfWidth / 4),  offset (numPairs * pairBytes);
+	if (!inBytesPerPixel)	//	v210, in whole groups
+	{
+		const ULWord numGroups (inHalfWidth / 12),  groupOffset (numGroups * 4);
+		for (ULWord half(0);  half < 2;  half++)
+			if (dstTSI)
+				DeinterleaveV210(reinterpret_cast<const ULWord*>(pInRows[half]), reinterpret_cast<ULWord*>(pOutRows[0]) + half * groupOffset,
+								reinterpret_cast<ULWord*>(pOutRows[1]) + half * groupOffset, numGroups);
+			else
+				InterleaveV210(reinterpret_cast<const ULWord*>(pInRows[0]) + half * groupOffset, reinterpret_cast<const ULWord*>(pInRows[1]) + half * groupOffset,
+								reinterpret_cast<ULWord*>(pOutRows[half]), numGroups);
+		return;
+	}
+	for (ULWord half(0);  half < 2;  half++)
+		if (dstTSI)
+			Deinterleave(pInRows[half], pOutRows[0] + half * offset, pOutRows[1] + half * offset, numPairs, pairBytes, inUseSIMD);
+		else
+			Interleave(pInRows[0] + half * offset, pInRows[1] + half * offset, pOutRows[half], numPairs, pairBytes, inUseSIMD);
+}
+
+
+typedef struct QuadJob
+{
+	RasterSide	fSrc;
+	RasterSide	fDst;
+	ULWord		fWidth;			//	Full raster width
+	ULWord		fHeight;		//	Full raster height
+	ULWord		fBytesPerPixel;	//	Zero for v210
+	ULWord		fHalfBytes;		//	Bytes in half a line (of whole v210 groups, if v210)
+	bool		fUnpack;		//	True if v210 lines must go through 16-bit components
+	bool		fUseSIMD;
+} QuadJob;
+
+//	Moves full raster lines [2 x inBegin, 2 x inEnd)
+static void MoveLines (void * pContext, uint32_t inBegin, uint32_t inEnd)
+{
+	const QuadJob &	job			(*reinterpret_cast<const QuadJob*>(pContext));
+	const ULWord	halfWidth	(job.fWidth / 2),  halfHeight (job.fHeight / 2);
+	UByte *			pSrcRows[2];
+	UByte *			pDstRows[2];
+	if (!job.fUnpack)
+	{
+		for (ULWord line(inBegin * 2);  line < inEnd * 2;  line++)
+		{
+			GetLineRows(job.fSrc, line, halfHeight, job.fHalfBytes, pSrcRows);
+			GetLineRows(job.fDst, line, halfHeight, job.fHalfBytes, pDstRows);
+			MoveLine(pSrcRows, job.fSrc.fLayout, pDstRows, job.fDst.fLayout, halfWidth, job.fHalfBytes, job.fBytesPerPixel, job.fUseSIMD);
+		}
+		return;
+	}
+
+	//	v210 lines are unpacked into (and packed from) two contiguous halves, padded for the partial 6-pixel group at the end
+	vector<UWord>	srcLine	((job.fWidth + 48) * 2),  dstLine (srcLine.size());
+	UByte *			pUnpackedSrc[2] = {reinterpret_cast<UByte*>(&srcLine[0]),  reinterpret_cast<UByte*>(&srcLine[halfWidth * 2])};
+	UByte *			pUnpackedDst[2] = {reinterpret_cast<UByte*>(&dstLine[0]),  reinterpret_cast<UByte*>(&dstLine[halfWidth * 2])};
+	for (ULWord line(inBegin * 2);  line < inEnd * 2;  line++)
+	{
+		GetLineRows(job.fSrc, line, halfHeight, 0, pSrcRows);
+		if (job.fSrc.fLayout == kLayout_Full)
+			::UnpackLine_10BitYUVto16BitYUV(reinterpret_cast<const ULWord*>(pSrcRows[0]), &srcLine[0], job.fWidth);
+		else
+			for (ULWord half(0);  half < 2;  half++)		//	The first half's partial group spills into the second's start, which is then overwritten
+				::UnpackLine_10BitYUVto16BitYUV(reinterpret_cast<const ULWord*>(pSrcRows[half]), &srcLine[half * halfWidth * 2], halfWidth);
+
+		MoveLine(pUnpackedSrc, job.fSrc.fLayout, pUnpackedDst, job.fDst.fLayout, halfWidth, halfWidth * kYUV16BytesPerPixel, kYUV16BytesPerPixel, job.fUseSIMD);
+
+		GetLineRows(job.fDst, line, halfHeight, 0, pDstRows);
+		if (job.fDst.fLayout == kLayout_Full)
+			::PackLine_16BitYUVto10BitYUV(&dstLine[0], reinterpret_cast<ULWord*>(pDstRows[0]), job.fWidth);
+		else
+			for (ULWord half(0);  half < 2;  half++)
+				::PackLine_16BitYUVto10BitYUV(&dstLine[half * halfWidth * 2], reinterpret_cast<ULWord*>(pDstRows[half]), halfWidth);
+	}
+}
+
+//	Checks the raster & sub-image geometry, and fills in the rest of the job
+static bool PrepareJob (QuadJob & inOutJob, const NTV2FormatDescriptor & inDesc, const ULWord inFullRowBytes, const NTV2Buffer * pInFull,
+						const NTV2Buffer * pInQuads, const NTV2Buffer * pOutQuads, const ULWord inQuadRowBytes)
+{
+	const QuadFormat *	pFormat	(QuadFormatForPixelFormat(inDesc.GetPixelFormat()));
+	const ULWord		width	(inDesc.GetRasterWidth()),  height (inDesc.GetRasterHeight());
+	const bool			tsi		(inOutJob.fSrc.fLayout == kLayout_TSI  ||  inOutJob.fDst.fLayout == kLayout_TSI);
+	if (!inDesc.IsValid())
+		{QRFAIL("Invalid format descriptor");  return false;}
+	if (!pFormat  ||  inDesc.IsPlanar())
+		{QRFAIL("Unsupported pixel format " << ::NTV2FrameBufferFormatToString(inDesc.GetPixelFormat()));  return false;}
+	if (!width  ||  !height  ||  (width & 3)  ||  (height & 1)  ||  (tsi && (width & 7)))
+		{QRFAIL("Raster " << DEC(width) << "x" << DEC(height) << " can't be divided into " << (tsi ? "2SI" : "square") << " sub-images");  return false;}
+	const ULWord quadRowBytes (inQuadRowBytes ? inQuadRowBytes : RowBytes(*pFormat, width / 2));
+	if (quadRowBytes < RowBytes(*pFormat, width / 2)  ||  (pInFull && inFullRowBytes < RowBytes(*pFormat, width)))
+		{QRFAIL("Line pitch too small for " << DEC(width) << "-pixel raster");  return false;}
+	if (pInFull  &&  pInFull->GetByteCount() < inFullRowBytes * height)
+		{QRFAIL("Raster buffer " << DEC(pInFull->GetByteCount()) << " bytes smaller than raster " << DEC(inFullRowBytes * height));  return false;}
+	const NTV2Buffer * quadArrays[2] = {pInQuads, pOutQuads};
+	for (ULWord array(0);  array < 2;  array++)
+		for (ULWord quad(0);  quadArrays[array]  &&  quad < 4;  quad++)
+			if (quadArrays[array][quad].IsNULL()  ||  quadArrays[array][quad].GetByteCount() < quadRowBytes * (height / 2))
+				{QRFAIL("Sub-image " << DEC(quad) << " buffer " << DEC(quadArrays[array][quad].GetByteCount()) << " bytes smaller than sub-image " << DEC(quadRowBytes * (height / 2)));  return false;}
+
+	const bool full (inOutJob.fSrc.fLayout == kLayout_Full  ||  inOutJob.fDst.fLayout == kLayout_Full);
+	inOutJob.fWidth			= width;
+	inOutJob.fHeight		= height;
+	inOutJob.fBytesPerPixel	= pFormat->fBytesPerPixel;
+	inOutJob.fHalfBytes		= pFormat->fBytesPerPixel ? width / 2 * pFormat->fBytesPerPixel : (width / 2 + 5) / 6 * 16;
+	inOutJob.fUnpack		= false;
+	if (!pFormat->fBytesPerPixel  &&  full  &&  (width / 2) % 6)
+		inOutJob.fUnpack = true;	//	The full raster's right half starts mid-group
+	if (!pFormat->fBytesPerPixel  &&  (inOutJob.fSrc.fLayout == kLayout_TSI) != (inOutJob.fDst.fLayout == kLayout_TSI)  &&  (width / 2) % 12)
+		inOutJob.fUnpack = true;	//	Half lines aren't whole pairs of groups
+	if (inOutJob.fSrc.fLayout != kLayout_Full)
+		inOutJob.fSrc.fRowBytes = quadRowBytes;
+	if (inOutJob.fDst.fLayout != kLayout_Full)
+		inOutJob.fDst.fRowBytes = quadRowBytes;
+	return true;
+}
+
+static void SetQuads (RasterSide & outSide, const NTV2QuadLayout inLayout, const NTV2Buffer * pInQuads)
+{
+	outSide.fLayout = inLayout == NTV2_QUAD_LAYOUT_TSI ? kLayout_TSI : kLayout_Squares;
+	for (ULWord quad(0);  quad < 4;  quad++)
+		outSide.fpBase[quad] = reinterpret_cast<UByte*>(pInQuads[quad].GetHostPointer());
+	outSide.fRowBytes = 0;
+}
+
+static void SetFull (RasterSide & outSide, const NTV2Buffer & inFrame, const ULWord inRowBytes)
+{
+	outSide.fLayout = kLayout_Full;
+	outSide.fpBase[0] = reinterpret_cast<UByte*>(inFrame.GetHostPointer());
+	outSide.fpBase[1] = outSide.fpBase[2] = outSide.fpBase[3] = AJA_NULL;
+	outSide.fRowBytes = inRowBytes;
+}
+
+
+CNTV2QuadRasterConverter::CNTV2QuadRasterConverter (AJAWorkerPool * pInPool)
+	:	mpPool		(pInPool ? pInPool : &AJAWorkerPool::GetSharedPool()),
+		mUseSIMD	(HasSIMD())
+{
+}
+
+CNTV2QuadRasterConverter::~CNTV2QuadRasterConverter ()
+{
+}
+
+bool CNTV2QuadRasterConverter::Split (const NTV2Buffer & inFrame,  const NTV2FormatDescriptor & inDesc,  NTV2Buffer * pOutQuads,
+										const NTV2QuadLayout inLayout,  const ULWord inQuadRowBytes)
+{
+	if (!pOutQuads  ||  !NTV2_IS_VALID_QUAD_LAYOUT(inLayout))
+		{QRFAIL("NULL sub-image array or invalid layout " << DEC(inLayout));  return false;}
+	QuadJob job;
+	SetFull(job.fSrc, inFrame, inDesc.GetBytesPerRow());
+	SetQuads(job.fDst, inLayout, pOutQuads);
+	job.fUseSIMD = mUseSIMD;
+	if (!PrepareJob(job, inDesc, inDesc.GetBytesPerRow(), &inFrame, AJA_NULL, pOutQuads, inQuadRowBytes))
+		return false;
+	return AJA_SUCCESS(mpPool->ParallelFor(job.fHeight / 2, MoveLines, &job));
+}
+
+bool CNTV2QuadRasterConverter::Join (const NTV2Buffer * pInQuads,  const NTV2QuadLayout inLayout,  NTV2Buffer & outFrame,
+										const NTV2FormatDescriptor & inDesc,  const ULWord inQuadRowBytes)
+{
+	if (!pInQuads  ||  !NTV2_IS_VALID_QUAD_LAYOUT(inLayout))
+		{QRFAIL("NULL sub-image array or invalid layout " << DEC(inLayout));  return false;}
+	QuadJob job;
+	SetQuads(job.fSrc, inLayout, pInQuads);
+	SetFull(job.fDst, outFrame, inDesc.GetBytesPerRow());
+	job.fUseSIMD = mUseSIMD;
+	if (!PrepareJob(job, inDesc, inDesc.GetBytesPerRow(), &outFrame, pInQuads, AJA_NULL, inQuadRowBytes))
+		return false;
+	return AJA_SUCCESS(mpPool->ParallelFor(job.fHeight / 2, MoveLines, &job));
+}
+
+bool CNTV2QuadRasterConverter::Relayout (const NTV2Buffer * pInQuads,  const NTV2QuadLayout inSrcLayout,  NTV2Buffer * pOutQuads,
+										const NTV2QuadLayout inDstLayout,  const NTV2FormatDescriptor & inDesc,  const ULWord inQuadRowBytes)
+{
+	if (!pInQuads  ||  !pOutQuads  ||  !NTV2_IS_VALID_QUAD_LAYOUT(inSrcLayout)  ||  !NTV2_IS_VALID_QUAD_LAYOUT(inDstLayout))
+		{QRFAIL("NULL sub-image array or invalid layout " << DEC(inSrcLayout) << "/" << DEC(inDstLayout));  return false;}
+	QuadJob job;
+	SetQuads(job.fSrc, inSrcLayout, pInQuads);
+	SetQuads(job.fDst, inDstLayout, pOutQuads);
+	job.fUseSIMD = mUseSIMD;
+	if (!PrepareJob(job, inDesc, 0, AJA_NULL, pInQuads, pOutQuads, inQuadRowBytes))
+		return false;
+	return AJA_SUCCESS(mpPool->ParallelFor(job.fHeight / 2, MoveLines, &job));
+}
+
+bool CNTV2QuadRasterConverter::CanConvert (const NTV2PixelFormat inPixelFormat)
+{
+	return QuadFormatForPixelFormat(inPixelFormat) != AJA_NULL;
+}
+
+bool CNTV2QuadRasterConverter::HasSIMD (void)
+{
+#if defined(AJA_HAS_SSE2)
+	return true;
+#else
+	return false;
+#endif
+}
+
+ULWord CNTV2QuadRasterConverter::GetQuadRowBytes (const NTV2PixelFormat inPixelFormat, const ULWord inFullWidth)
+{
+	const QuadFormat * pFormat (QuadFormatForPixelFormat(inPixelFormat));
+	return pFormat ? RowBytes(*pFormat, inFullWidth / 2) : 0;
+}
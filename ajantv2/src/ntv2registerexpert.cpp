@@ -14,6 +14,7 @@
 #include "ntv2signalrouter.h"
 #include "ajabase/common/common.h"
 #include "ajabase/system/lock.h"
+#include "ajabase/system/atomic.h"
 #include "ajabase/common/ajarefptr.h"
 #include "ajabase/system/debug.h"
 #include <algorithm>
@@ -48,6 +49,18 @@ static const string gChlClasses[]	=	{	kRegClass_Channel1, kRegClass_Channel2, kR
 static const string sSpace(" ");
 static const string sNull;
 
+//	Cheap decimal formatting for synthesizing the thousands of register names at startup (ostringstream is too slow)
+static string DecStr (const ULWord inNum, const size_t inMinWidth = 0)
+{
+	char	buf[16];
+	size_t	pos (sizeof(buf));
+	ULWord	num (inNum);
+	do	{buf[--pos] = char('0' + num % 10);  num /= 10;}	while (num);
+	while (sizeof(buf) - pos < inMinWidth  &&  pos)
+		buf[--pos] = '0';
+	return string(buf + pos, sizeof(buf) - pos);
+}
+
 typedef enum
 {
 	regNTV4FS_FIRST,
@@ -128,7 +141,6 @@ public:
 private:
 	RegisterExpert()
 	{
-		AJAAutoLock lock(&mGuardMutex);
 		AJAAtomic::Increment(&gInstanceTally);
 		AJAAtomic::Increment(&gLivingInstances);
 		//	Name "Classic" registers using NTV2RegisterNameString...
@@ -154,6 +166,7 @@ private:
 		SetupCMWRegs();			//	Clock Monitor Out
 		SetupNTV4FrameStoreRegs();	//	NTV4 FrameStores
 		SetupVRegs();			//	Virtuals
+		BuildLookupTables();	//	Immutable from here on
 		REiNOTE(DEC(gLivingInstances) << " extant, " << DEC(gInstanceTally) << " total");
 		if (LOGGING_MAPPINGS)
 		{
@@ -191,40 +204,33 @@ private:
 	void DefineRegName(const uint32_t regNumber, const string & regName)
 	{
 		if (!regName.empty())
-		{
-			AJAAutoLock lock(&mGuardMutex);
-			if (mRegNumToStringMap.find(regNumber) == mRegNumToStringMap.end())
+			if (mRegNumToStringMap.insert(RegNumToStringPair(regNumber, regName)).second)
 			{
-				mRegNumToStringMap.insert (RegNumToStringPair(regNumber, regName));
 				string lowerCaseRegName(regName);
 				mStringToRegNumMMap.insert (StringToRegNumPair(aja::lower(lowerCaseRegName), regNumber));
 			}
-		}
 	}
 	inline void DefineRegDecoder(const uint32_t inRegNum, const Decoder & dec)
 	{
-		AJAAutoLock lock(&mGuardMutex);
 		mRegNumToDecoderMap.insert (RegNumToDecoderPair(inRegNum, &dec));
 	}
 	inline void DefineRegClass (const uint32_t inRegNum, const string & className)
 	{
 		if (!className.empty())
 		{
-			AJAAutoLock lock(&mGuardMutex);
 			mRegClassToRegNumMMap.insert(StringToRegNumPair(className, inRegNum));
 		}
 	}
 	void DefineRegReadWrite(const uint32_t inRegNum, const int rdWrt)
 	{
-		AJAAutoLock lock(&mGuardMutex);
 		if (rdWrt == READONLY)
 		{
-			NTV2_ASSERT (!IsRegisterWriteOnly(inRegNum));
+			NTV2_ASSERT (!IsRegInClassMMap(inRegNum, kRegClass_WriteOnly));
 			DefineRegClass (inRegNum, kRegClass_ReadOnly);
 		}
 		if (rdWrt == WRITEONLY)
 		{
-			NTV2_ASSERT (!IsRegisterReadOnly(inRegNum));
+			NTV2_ASSERT (!IsRegInClassMMap(inRegNum, kRegClass_ReadOnly));
 			DefineRegClass (inRegNum, kRegClass_WriteOnly);
 		}
 	}
@@ -255,7 +261,6 @@ private:
 
 	void SetupBasicRegs(void)
 	{
-		AJAAutoLock lock(&mGuardMutex);
 		DefineRegister (kRegGlobalControl,		"", mDecodeGlobalControlReg,	READWRITE,	kRegClass_NULL,		kRegClass_Channel1, kRegClass_NULL);
 		DefineRegister (kRegGlobalControl2,		"", mDecodeGlobalControl2,		READWRITE,	kRegClass_NULL,		kRegClass_Channel1, kRegClass_NULL);
 		DefineRegister (kRegGlobalControl3,		"", mDecodeGlobalControl3,		READWRITE,	kRegClass_NULL,		kRegClass_Channel1, kRegClass_NULL);
@@ -362,7 +367,6 @@ private:
 	}
 	void SetupBOBRegs(void)
 	{
-		AJAAutoLock lock(&mGuardMutex);
 		DefineRegister (kRegBOBStatus,				"kRegBOBStatus",				mDecodeBOBStatus,					READWRITE,	kRegClass_NULL,		kRegClass_NULL,		kRegClass_NULL);
 		DefineRegister (kRegBOBGPIInData,			"kRegBOBGPIInData",				mDecodeBOBGPIIn,					READWRITE,	kRegClass_NULL,		kRegClass_NULL,		kRegClass_NULL);
 		DefineRegister (kRegBOBGPIInterruptControl,	"kRegBOBGPIInterruptControl",	mDecodeBOBGPIInInterruptControl,	READWRITE,	kRegClass_NULL,		kRegClass_NULL,		kRegClass_NULL);
@@ -371,7 +375,6 @@ private:
 	}
 	void SetupLEDRegs(void)
 	{
-		AJAAutoLock lock(&mGuardMutex);
 		DefineRegister (kRegLEDReserved0,		"kRegLEDReserved0",			mDefaultRegDecoder,		READWRITE,		kRegClass_NULL,		kRegClass_NULL,		kRegClass_NULL);
 		DefineRegister (kRegLEDClockDivide,		"kRegLEDClockDivide",		mDefaultRegDecoder,		READWRITE,		kRegClass_NULL,		kRegClass_NULL,		kRegClass_NULL);
 		DefineRegister (kRegLEDReserved2,		"kRegLEDReserved2",			mDefaultRegDecoder,		READWRITE,		kRegClass_NULL,		kRegClass_NULL,		kRegClass_NULL);
@@ -383,7 +386,6 @@ private:
 	}
 	void SetupCMWRegs(void)
 	{
-		AJAAutoLock lock(&mGuardMutex);
 		DefineRegister (kRegCMWControl,		"kRegCMWControl",		mDefaultRegDecoder,		READWRITE,		kRegClass_NULL,		kRegClass_NULL,		kRegClass_NULL);
 		DefineRegister (kRegCMW1485Out,		"kRegCMW1485Out",		mDefaultRegDecoder,		READWRITE,		kRegClass_NULL,		kRegClass_NULL,		kRegClass_NULL);
 		DefineRegister (kRegCMW14835Out,	"kRegCMW14835Out",		mDefaultRegDecoder,		READWRITE,		kRegClass_NULL,		kRegClass_NULL,		kRegClass_NULL);
@@ -393,7 +395,6 @@ private:
 	}
 	void SetupVPIDRegs(void)
 	{
-		AJAAutoLock lock(&mGuardMutex);
 		DefineRegister (kRegSDIIn1VPIDA,		"", mVPIDInpRegDecoder,			READONLY,	kRegClass_VPID,		kRegClass_Input,	kRegClass_Channel1);
 		DefineRegister (kRegSDIIn1VPIDB,		"", mVPIDInpRegDecoder,			READONLY,	kRegClass_VPID,		kRegClass_Input,	kRegClass_Channel1);
 		DefineRegister (kRegSDIOut1VPIDA,		"", mVPIDOutRegDecoder,			READWRITE,	kRegClass_VPID,		kRegClass_Output,	kRegClass_Channel1);
@@ -429,7 +430,6 @@ private:
 	}
 	void SetupTimecodeRegs(void)
 	{
-		AJAAutoLock lock(&mGuardMutex);
 		DefineRegister	(kRegRP188InOut1DBB,			"", mRP188InOutDBBRegDecoder,	READWRITE,	kRegClass_Timecode, kRegClass_Channel1, kRegClass_NULL);
 		DefineRegister	(kRegRP188InOut1Bits0_31,		"", mDefaultRegDecoder,			READWRITE,	kRegClass_Timecode, kRegClass_Channel1, kRegClass_NULL);
 		DefineRegister	(kRegRP188InOut1Bits32_63,		"", mDefaultRegDecoder,			READWRITE,	kRegClass_Timecode, kRegClass_Channel1, kRegClass_NULL);
@@ -495,7 +495,6 @@ private:
 	
 	void SetupAudioRegs(void)
 	{
-		AJAAutoLock lock(&mGuardMutex);
 		DefineRegister (kRegAud1Control,		"", mDecodeAudControlReg,		READWRITE,	kRegClass_Audio,	kRegClass_Channel1, kRegClass_NULL);
 		DefineRegister (kRegAud2Control,		"", mDecodeAudControlReg,		READWRITE,	kRegClass_Audio,	kRegClass_Channel2, kRegClass_NULL);
 		DefineRegister (kRegAud3Control,		"", mDecodeAudControlReg,		READWRITE,	kRegClass_Audio,	kRegClass_Channel3, kRegClass_NULL);
@@ -581,7 +580,6 @@ private:
 
 	void SetupMRRegs(void)
 	{
-		AJAAutoLock lock(&mGuardMutex);
 		DefineRegister	(kRegMRQ1Control,		"kRegMRQ1Control",	mDefaultRegDecoder,	READWRITE,	kRegClass_NULL,	kRegClass_NULL, kRegClass_NULL);
 		DefineRegister	(kRegMRQ2Control,		"kRegMRQ2Control",	mDefaultRegDecoder,	READWRITE,	kRegClass_NULL,	kRegClass_NULL, kRegClass_NULL);
 		DefineRegister	(kRegMRQ3Control,		"kRegMRQ3Control",	mDefaultRegDecoder,	READWRITE,	kRegClass_NULL,	kRegClass_NULL, kRegClass_NULL);
@@ -592,7 +590,6 @@ private:
 
 	void SetupDMARegs(void)
 	{
-		AJAAutoLock lock(&mGuardMutex);
 		DefineRegister	(kRegDMA1HostAddr,		"", mDefaultRegDecoder,			READWRITE,	kRegClass_DMA,	kRegClass_NULL, kRegClass_NULL);
 		DefineRegister	(kRegDMA1HostAddrHigh,	"", mDefaultRegDecoder,			READWRITE,	kRegClass_DMA,	kRegClass_NULL, kRegClass_NULL);
 		DefineRegister	(kRegDMA1LocalAddr,		"", mDefaultRegDecoder,			READWRITE,	kRegClass_DMA,	kRegClass_NULL, kRegClass_NULL);
@@ -623,7 +620,6 @@ private:
 	
 	void SetupXptSelect(void)
 	{
-		AJAAutoLock lock(&mGuardMutex);
 		//				RegNum					0-7								8-15							16-23							24-31
 		DefineXptReg	(kRegXptSelectGroup1,	NTV2_XptLUT1Input,				NTV2_XptCSC1VidInput,			NTV2_XptConversionModInput,		NTV2_XptCompressionModInput);
 		DefineXptReg	(kRegXptSelectGroup2,	NTV2_XptFrameBuffer1Input,		NTV2_XptFrameSync1Input,		NTV2_XptFrameSync2Input,		NTV2_XptDualLinkOut1Input);
@@ -671,7 +667,7 @@ private:
 
 		//	Expose the CanConnect ROM registers:
 		for (ULWord regNum(kRegFirstValidXptROMRegister);  regNum < ULWord(kRegInvalidValidXptROMRegister);	 regNum++)
-		{	ostringstream regName;	//	used to synthesize reg name
+		{	string regName;	//	used to synthesize reg name
 			const ULWord rawInputXpt	((regNum - ULWord(kRegFirstValidXptROMRegister)) / 4UL + ULWord(NTV2_FIRST_INPUT_CROSSPOINT));
 			const ULWord ndx			((regNum - ULWord(kRegFirstValidXptROMRegister)) % 4UL);
 			const NTV2InputXptID inputXpt	(NTV2InputXptID(rawInputXpt+0));
@@ -679,13 +675,13 @@ private:
 			{
 				string inputXptEnumName (::NTV2InputCrosspointIDToString(inputXpt,false));	//	e.g. "NTV2_XptFrameBuffer1Input"
 				if (inputXptEnumName.empty())
-					regName << "kRegXptValid" << DEC0N(rawInputXpt,3) << "N" << DEC(ndx);
+					regName = "kRegXptValid" + DecStr(rawInputXpt,3) + "N" + DecStr(ndx);
 				else
-					regName << "kRegXptValid" << aja::replace(inputXptEnumName, "NTV2_Xpt", "") << DEC(ndx);
+					regName = "kRegXptValid" + aja::replace(inputXptEnumName, "NTV2_Xpt", "") + DecStr(ndx);
 			}
 			else
-				regName << "kRegXptValue" << HEX0N(regNum,4);
-			DefineRegister (regNum, regName.str(),	mDecodeXptValidReg, READONLY,	kRegClass_XptROM, kRegClass_NULL, kRegClass_NULL);
+				{ostringstream oss;  oss << "kRegXptValue" << HEX0N(regNum,4);  regName = oss.str();}
+			DefineRegister (regNum, regName,	mDecodeXptValidReg, READONLY,	kRegClass_XptROM, kRegClass_NULL, kRegClass_NULL);
 		}
 	}	//	SetupXptSelect
 	
@@ -715,7 +711,6 @@ private:
 		NTV2_ASSERT(size_t(regAncExt_LAST) == sizeof(AncExtRegNames)/sizeof(AncExtRegNames[0]));
 		NTV2_ASSERT(size_t(regAncIns_LAST) == sizeof(AncInsRegNames)/sizeof(string));
 
-		AJAAutoLock lock(&mGuardMutex);
 		for (ULWord offsetNdx (0);	offsetNdx < 8;	offsetNdx++)
 		{
 			for (ULWord reg(regAncExtControl);	reg < regAncExt_LAST;  reg++)
@@ -800,7 +795,6 @@ private:
 		NTV2_ASSERT(size_t(regAuxExt_LAST) == sizeof(AuxExtRegNames)/sizeof(AuxExtRegNames[0]));
 		//NTV2_ASSERT(size_t(regAncIns_LAST) == sizeof(AncInsRegNames)/sizeof(string));
 
-		AJAAutoLock lock(&mGuardMutex);
 		for (ULWord offsetNdx (0);	offsetNdx < 4;	offsetNdx++)
 		{
 			for (ULWord reg(regAuxExtControl);	reg < regAuxExt_LAST;  reg++)
@@ -860,7 +854,6 @@ private:
 
 	void SetupHDMIRegs(void)
 	{
-		AJAAutoLock lock(&mGuardMutex);
 		DefineRegister (kRegHDMIOutControl,							"", mDecodeHDMIOutputControl,	READWRITE,	kRegClass_HDMI,		kRegClass_Output,	kRegClass_Channel1);
 		DefineRegister (kRegHDMIInputStatus,						"", mDecodeHDMIInputStatus,		READWRITE,	kRegClass_HDMI,		kRegClass_Input,	kRegClass_Channel1);
 		DefineRegister (kRegHDMIInputControl,						"", mDecodeHDMIInputControl,	READWRITE,	kRegClass_HDMI,		kRegClass_Input,	kRegClass_Channel1);
@@ -1018,7 +1011,6 @@ private:
 		static const string suffixes [] =	{"Status",	"CRCErrorCount",	"FrameCountLow",	"FrameCountHigh",	"FrameRefCountLow", "FrameRefCountHigh"};
 		static const int	perms []	=	{READWRITE, READWRITE,			READWRITE,			READWRITE,			READONLY,			READONLY};
 
-		AJAAutoLock lock(&mGuardMutex);
 		for (ULWord chan (0);  chan < 8;  chan++)
 			for (UWord ndx(0);	ndx < 6;  ndx++)
 			{
@@ -1039,18 +1031,15 @@ private:
 
 	void SetupLUTRegs (void)
 	{
-		AJAAutoLock lock(&mGuardMutex);
 	}
 
 	void SetupCSCRegs(void)
 	{
 		static const string sChan[8] = {kRegClass_Channel1, kRegClass_Channel2, kRegClass_Channel3, kRegClass_Channel4, kRegClass_Channel5, kRegClass_Channel6, kRegClass_Channel7, kRegClass_Channel8};
 
-		AJAAutoLock lock(&mGuardMutex);
 		for (unsigned num(0);  num < 8;	 num++)
 		{
-			ostringstream ossRegName;  ossRegName << "kRegEnhancedCSC" << (num+1);
-			const string & chanClass (sChan[num]);					const string rootName	 (ossRegName.str());
+			const string & chanClass (sChan[num]);					const string rootName	 ("kRegEnhancedCSC" + DecStr(num+1));
 			const string modeName	 (rootName + "Mode");			const string inOff01Name (rootName + "InOffset0_1");			const string inOff2Name	 (rootName + "InOffset2");
 			const string coeffA0Name (rootName + "CoeffA0");		const string coeffA1Name (rootName + "CoeffA1");				const string coeffA2Name (rootName + "CoeffA2");
 			const string coeffB0Name (rootName + "CoeffB0");		const string coeffB1Name (rootName + "CoeffB1");				const string coeffB2Name (rootName + "CoeffB2");
@@ -1103,18 +1092,16 @@ private:
 		const ULWord REDreg(kColorCorrectionLUTOffset_Red/4), GRNreg(kColorCorrectionLUTOffset_Green/4), BLUreg(kColorCorrectionLUTOffset_Blue/4);
 		for (ULWord ndx(0);	 ndx < 512;	 ndx++)
 		{
-			ostringstream regNameR, regNameG, regNameB;
-			regNameR << "kRegLUTRed" << DEC0N(ndx,3);  regNameG << "kRegLUTGreen" << DEC0N(ndx,3);	regNameB << "kRegLUTBlue" << DEC0N(ndx,3);
-			DefineRegister (REDreg + ndx, regNameR.str(), mLUTDecoder,	READWRITE,	kRegClass_LUT,	kRegClass_NULL, kRegClass_NULL);
-			DefineRegister (GRNreg + ndx, regNameG.str(), mLUTDecoder,	READWRITE,	kRegClass_LUT,	kRegClass_NULL, kRegClass_NULL);
-			DefineRegister (BLUreg + ndx, regNameB.str(), mLUTDecoder,	READWRITE,	kRegClass_LUT,	kRegClass_NULL, kRegClass_NULL);
+			const string ndxStr (DecStr(ndx,3));
+			DefineRegister (REDreg + ndx, "kRegLUTRed" + ndxStr,	mLUTDecoder,	READWRITE,	kRegClass_LUT,	kRegClass_NULL, kRegClass_NULL);
+			DefineRegister (GRNreg + ndx, "kRegLUTGreen" + ndxStr,	mLUTDecoder,	READWRITE,	kRegClass_LUT,	kRegClass_NULL, kRegClass_NULL);
+			DefineRegister (BLUreg + ndx, "kRegLUTBlue" + ndxStr,	mLUTDecoder,	READWRITE,	kRegClass_LUT,	kRegClass_NULL, kRegClass_NULL);
 		}
 #endif
 	}	//	SetupCSCRegs
 
 	void SetupMixerKeyerRegs(void)
 	{
-		AJAAutoLock lock(&mGuardMutex);
 		//	VidProc/Mixer/Keyer
 		DefineRegister	(kRegVidProc1Control,	"", mVidProcControlRegDecoder,	READWRITE,	kRegClass_Mixer,	kRegClass_Channel1, kRegClass_Channel2);
 		DefineRegister	(kRegVidProc2Control,	"", mVidProcControlRegDecoder,	READWRITE,	kRegClass_Mixer,	kRegClass_Channel3, kRegClass_Channel4);
@@ -1137,7 +1124,7 @@ private:
 		{
 			for (ULWord regNdx(0);  regNdx < ULWord(regNTV4FS_LAST);  regNdx++)
 			{
-				ostringstream regName;  regName << "kRegNTV4FS" << DEC(fsNdx+1) << "_";
+				string regName ("kRegNTV4FS" + DecStr(fsNdx+1) + "_");
 				const ULWord registerNumber (kNTV4FrameStoreFirstRegNum  +  fsNdx * kNumNTV4FrameStoreRegisters  +  regNdx);
 				switch (NTV4FrameStoreRegs(regNdx))
 				{
@@ -1164,16 +1151,16 @@ private:
 					case regNTV4FS_RasterOffsetBlue:
 					case regNTV4FS_RasterOffsetRed:
 					case regNTV4FS_RasterOffsetAlpha:
-						regName << sNTV4FrameStoreRegNames[regNdx];
-						DefineRegister(registerNumber, regName.str(), mDecodeNTV4FSReg, READWRITE, kRegClass_NTV4FrameStore, gChlClasses[fsNdx], kRegClass_NULL);
+						regName += sNTV4FrameStoreRegNames[regNdx];
+						DefineRegister(registerNumber, regName, mDecodeNTV4FSReg, READWRITE, kRegClass_NTV4FrameStore, gChlClasses[fsNdx], kRegClass_NULL);
 						break;
 					case regNTV4FS_InputSourceSelect:
-						regName << "InputSourceSelect";
-						DefineRegister(registerNumber, regName.str(), mDecodeNTV4FSReg, READWRITE, kRegClass_NTV4FrameStore, gChlClasses[fsNdx], kRegClass_NULL);
+						regName += "InputSourceSelect";
+						DefineRegister(registerNumber, regName, mDecodeNTV4FSReg, READWRITE, kRegClass_NTV4FrameStore, gChlClasses[fsNdx], kRegClass_NULL);
 						break;
 					default:
-						regName << DEC(regNdx);
-						DefineRegister(registerNumber, regName.str(), mDefaultRegDecoder, READWRITE, kRegClass_NTV4FrameStore, gChlClasses[fsNdx], kRegClass_NULL);
+						regName += DecStr(regNdx);
+						DefineRegister(registerNumber, regName, mDefaultRegDecoder, READWRITE, kRegClass_NTV4FrameStore, gChlClasses[fsNdx], kRegClass_NULL);
 						break;
 				}
 			}	//	for each FrameStore register
@@ -1182,7 +1169,6 @@ private:
 
 	void SetupVRegs(void)
 	{
-		AJAAutoLock lock(&mGuardMutex);
 		DEF_REG	(kVRegDriverVersion, mDriverVersionDecoder,	READWRITE,	kRegClass_Virtual,	kRegClass_NULL, kRegClass_NULL);
 		DEF_REGNAME	(kVRegRelativeVideoPlaybackDelay);
 		DEF_REGNAME	(kVRegAudioRecordPinDelay);
@@ -1704,11 +1690,10 @@ private:
 
 		for (ULWord ndx(1);  ndx < 1024;  ndx++)	//	<== Start at 1, kVRegDriverVersion already done
 		{
-			ostringstream oss;	oss << "VIRTUALREG_START+" << ndx;
-			const string	regName (oss.str());
 			const ULWord	regNum	(VIRTUALREG_START + ndx);
 			if (mRegNumToStringMap.find(regNum) == mRegNumToStringMap.end())
 			{
+				const string	regName ("VIRTUALREG_START+" + DecStr(ndx));
 				mRegNumToStringMap.insert (RegNumToStringPair(regNum, regName));
 				mStringToRegNumMMap.insert (StringToRegNumPair(ToLower(regName), regNum));
 			}
@@ -1744,12 +1729,109 @@ public:
 		return oss;
 	}
 
+private:
+	typedef struct RegInfo
+	{
+		uint32_t		fRegNum;
+		const string *	fName;		//	Points into mRegNumToStringMap, or NULL if unnamed
+		const Decoder *	fDecoder;	//	NULL if no decoder
+		uint64_t		fClasses;	//	Bit N set if in class mClassNames[N] (first 64 classes only)
+	} RegInfo;
+	typedef vector<RegInfo>		RegInfos;
+	struct RegInfoLess	{bool operator () (const RegInfo & inInfo, const uint32_t inRegNum) const	{return inInfo.fRegNum < inRegNum;}};
+	static const uint32_t		kDirectIndexLimit = 0x10000;	//	Register numbers below this are looked up directly
+
+	//	Build-phase only -- used while the tables are still being populated
+	bool	IsRegInClassMMap (const uint32_t inRegNum, const string & inClassName) const
+	{
+		for (RegClassToRegNumConstIter	it(mRegClassToRegNumMMap.find(inClassName));  it != mRegClassToRegNumMMap.end() && it->first == inClassName;  ++it)
+			if (it->second == inRegNum)
+				return true;
+		return false;
+	}
+
+	/**
+		Called once at the end of construction. Flattens the build-phase maps into the immutable lookup tables
+		that the read-only accessors use. Once this returns, nothing changes, so no locking is needed to read.
+	**/
+	void BuildLookupTables (void)
+	{
+		//	Classes, sorted by name (mRegClassToRegNumMMap is already sorted)...
+		for (RegClassToRegNumConstIter it(mRegClassToRegNumMMap.begin());  it != mRegClassToRegNumMMap.end();  ++it)
+		{
+			if (mClassNames.empty()  ||  mClassNames.back() != it->first)
+			{
+				mClassNames.push_back(it->first);
+				mClassRegs.push_back(NTV2RegNumSet());
+				mAllRegClasses.insert(mAllRegClasses.end(), it->first);
+			}
+			mClassRegs.back().insert(it->second);
+		}
+		NTV2_ASSERT(mClassNames.size() <= 64);	//	More than this will still work, just a little slower
+
+		//	One RegInfo per register that has a name, decoder or class, sorted by register number...
+		vector<uint32_t>	allRegNums;
+		allRegNums.reserve(mRegNumToStringMap.size() + mRegNumToDecoderMap.size());
+		for (RegNumToStringMap::const_iterator it(mRegNumToStringMap.begin());	it != mRegNumToStringMap.end();  ++it)
+			allRegNums.push_back(it->first);
+		for (RegNumToDecoderMap::const_iterator it(mRegNumToDecoderMap.begin());  it != mRegNumToDecoderMap.end();  ++it)
+			allRegNums.push_back(it->first);
+		for (size_t ndx(0);  ndx < mClassRegs.size();  ndx++)
+			allRegNums.insert(allRegNums.end(), mClassRegs[ndx].begin(), mClassRegs[ndx].end());
+		std::sort(allRegNums.begin(), allRegNums.end());
+		allRegNums.erase(std::unique(allRegNums.begin(), allRegNums.end()), allRegNums.end());
+		mRegInfos.resize(allRegNums.size());
+		RegNumToStringMap::const_iterator	nameIter(mRegNumToStringMap.begin());
+		RegNumToDecoderMap::const_iterator	decIter(mRegNumToDecoderMap.begin());
+		for (size_t ndx(0);  ndx < allRegNums.size();  ndx++)
+		{	//	All three are sorted, so just walk the maps along with allRegNums...
+			RegInfo &	info (mRegInfos[ndx]);
+			info.fRegNum = allRegNums[ndx];
+			info.fName = AJA_NULL;
+			info.fDecoder = AJA_NULL;
+			info.fClasses = 0;
+			if (nameIter != mRegNumToStringMap.end()  &&  nameIter->first == info.fRegNum)
+				info.fName = &(nameIter++)->second;
+			if (decIter != mRegNumToDecoderMap.end()  &&  decIter->first == info.fRegNum)
+				info.fDecoder = (decIter++)->second;
+		}
+
+		//	Direct index for the (dense) low register numbers...
+		uint32_t	maxDirect(0);
+		for (size_t ndx(0);  ndx < mRegInfos.size()  &&  mRegInfos[ndx].fRegNum < kDirectIndexLimit;  ndx++)
+			maxDirect = mRegInfos[ndx].fRegNum + 1;
+		mRegInfoIndex.assign(maxDirect, 0);
+		for (size_t ndx(0);  ndx < mRegInfos.size()  &&  mRegInfos[ndx].fRegNum < maxDirect;  ndx++)
+			mRegInfoIndex[mRegInfos[ndx].fRegNum] = uint32_t(ndx + 1);
+
+		//	Class membership bits...
+		for (size_t classNdx(0);  classNdx < mClassRegs.size() && classNdx < 64;  classNdx++)
+			for (NTV2RegNumSetConstIter it(mClassRegs[classNdx].begin());  it != mClassRegs[classNdx].end();  ++it)
+				const_cast<RegInfo*>(FindRegInfo(*it))->fClasses |= uint64_t(1) << classNdx;
+	}	//	BuildLookupTables
+
+	//	Returns the RegInfo for the given register, or NULL if the register is unknown
+	const RegInfo *	FindRegInfo (const uint32_t inRegNum) const
+	{
+		if (inRegNum < mRegInfoIndex.size())
+			return mRegInfoIndex[inRegNum] ? &mRegInfos[mRegInfoIndex[inRegNum] - 1] : AJA_NULL;
+		RegInfos::const_iterator it (std::lower_bound(mRegInfos.begin(), mRegInfos.end(), inRegNum, RegInfoLess()));
+		return it != mRegInfos.end()  &&  it->fRegNum == inRegNum  ?  &(*it)  :  AJA_NULL;
+	}
+
+	//	Returns the index of the given class into mClassNames, or -1 if there's no such class
+	int		FindClassIndex (const string & inClassName) const
+	{
+		vector<string>::const_iterator it (std::lower_bound(mClassNames.begin(), mClassNames.end(), inClassName));
+		return it != mClassNames.end()  &&  *it == inClassName  ?  int(it - mClassNames.begin())  :  -1;
+	}
+
+public:
 	string RegNameToString (const uint32_t inRegNum) const
 	{
-		AJAAutoLock lock(&mGuardMutex);
-		RegNumToStringMap::const_iterator	iter	(mRegNumToStringMap.find (inRegNum));
-		if (iter != mRegNumToStringMap.end())
-			return iter->second;
+		const RegInfo * pInfo (FindRegInfo(inRegNum));
+		if (pInfo  &&  pInfo->fName)
+			return *pInfo->fName;
 
 		ostringstream	oss;	oss << "Reg ";
 		if (inRegNum <= kRegNumRegisters)
@@ -1760,67 +1842,53 @@ public:
 			oss << xHEX0N(inRegNum,8);
 		return oss.str();
 	}
-	
+
 	string RegValueToString (const uint32_t inRegNum, const uint32_t inRegValue, const NTV2DeviceID inDeviceID) const
 	{
-		AJAAutoLock lock(&mGuardMutex);
-		RegNumToDecoderMap::const_iterator iter(mRegNumToDecoderMap.find(inRegNum));
-		ostringstream oss;
-		if (iter != mRegNumToDecoderMap.end()  &&  iter->second)
-		{
-			const Decoder * pDecoder (iter->second);
-			oss << (*pDecoder)(inRegNum, inRegValue, inDeviceID);
-		}
-		return oss.str();
+		const RegInfo * pInfo (FindRegInfo(inRegNum));
+		if (pInfo  &&  pInfo->fDecoder)
+			return (*pInfo->fDecoder)(inRegNum, inRegValue, inDeviceID);
+		return string();
 	}
-	
+
 	bool	IsRegInClass (const uint32_t inRegNum, const string & inClassName) const
 	{
-		AJAAutoLock lock(&mGuardMutex);
-		for (RegClassToRegNumConstIter	it(mRegClassToRegNumMMap.find(inClassName));  it != mRegClassToRegNumMMap.end() && it->first == inClassName;  ++it)
-			if (it->second == inRegNum)
-				return true;
-		return false;
+		const int classNdx (FindClassIndex(inClassName));
+		if (classNdx < 0)
+			return false;
+		if (classNdx >= 64)
+			return mClassRegs[size_t(classNdx)].find(inRegNum) != mClassRegs[size_t(classNdx)].end();
+		const RegInfo * pInfo (FindRegInfo(inRegNum));
+		return pInfo  &&  (pInfo->fClasses & (uint64_t(1) << classNdx));
 	}
-	
+
 	inline bool		IsRegisterWriteOnly (const uint32_t inRegNum) const		{return IsRegInClass (inRegNum, kRegClass_WriteOnly);}
 	inline bool		IsRegisterReadOnly (const uint32_t inRegNum) const		{return IsRegInClass (inRegNum, kRegClass_ReadOnly);}
 
-	NTV2StringSet	GetAllRegisterClasses (void) const
-	{
-		AJAAutoLock lock(&mGuardMutex);
-		if (mAllRegClasses.empty())
-			for (RegClassToRegNumConstIter it(mRegClassToRegNumMMap.begin());  it != mRegClassToRegNumMMap.end();  ++it)
-				if (mAllRegClasses.find(it->first) == mAllRegClasses.end())
-					mAllRegClasses.insert(it->first);
-		return mAllRegClasses;
-	}
+	inline NTV2StringSet	GetAllRegisterClasses (void) const	{return mAllRegClasses;}
 
 	NTV2StringSet	GetRegisterClasses (const uint32_t inRegNum, const bool inRemovePrefix) const
 	{
-		AJAAutoLock lock(&mGuardMutex);
 		NTV2StringSet	result;
-		NTV2StringSet	allClasses	(GetAllRegisterClasses());
-		for (NTV2StringSetConstIter it(allClasses.begin());  it != allClasses.end();  ++it)
-			if (IsRegInClass (inRegNum, *it))
-			{
-				string str(*it);
-				if (inRemovePrefix)
-					str.erase(0, 10);	//	Remove "kRegClass_" prefix
-				if (result.find(str) == result.end())
-					result.insert(str);
-			}
+		const RegInfo * pInfo (FindRegInfo(inRegNum));
+		for (size_t ndx(0);  ndx < mClassNames.size();  ndx++)
+		{
+			const bool inClass (ndx < 64  ?  pInfo && (pInfo->fClasses & (uint64_t(1) << ndx))
+											:  mClassRegs[ndx].find(inRegNum) != mClassRegs[ndx].end());
+			if (!inClass)
+				continue;
+			string str(mClassNames[ndx]);
+			if (inRemovePrefix)
+				str.erase(0, 10);	//	Remove "kRegClass_" prefix
+			result.insert(str);
+		}
 		return result;
 	}
 
 	NTV2RegNumSet	GetRegistersForClass (const string & inClassName) const
 	{
-		AJAAutoLock lock(&mGuardMutex);
-		NTV2RegNumSet	result;
-		for (RegClassToRegNumConstIter it(mRegClassToRegNumMMap.find(inClassName));  it != mRegClassToRegNumMMap.end() && it->first == inClassName;  ++it)
-			if (result.find(it->second) == result.end())
-				result.insert(it->second);
-		return result;
+		const int classNdx (FindClassIndex(inClassName));
+		return classNdx < 0  ?  NTV2RegNumSet()  :  mClassRegs[size_t(classNdx)];
 	}
 
 	NTV2RegNumSet	GetRegistersForDevice (const NTV2DeviceID inDeviceID, const int inOtherRegsToInclude) const
@@ -1829,9 +1897,7 @@ public:
 		const uint32_t		maxRegNum	(::NTV2DeviceGetMaxRegisterNumber(inDeviceID));
 
 		for (uint32_t regNum (0);  regNum <= maxRegNum;	 regNum++)
-			result.insert(regNum);
-
-		AJAAutoLock lock(&mGuardMutex);
+			result.insert(result.end(), regNum);
 
 		if (::NTV2DeviceCanDoCustomAnc(inDeviceID))
 		{
@@ -2007,7 +2073,6 @@ public:
 		string			nameStr(inName);
 		const size_t	nameStrLen(aja::lower(nameStr).length());
 		StringToRegNumConstIter it;
-		AJAAutoLock lock(&mGuardMutex);
 		if (inMatchStyle == EXACTMATCH)
 		{
 			it = mStringToRegNumMMap.find(nameStr);
@@ -2038,7 +2103,6 @@ public:
 
 	bool		GetXptRegNumAndMaskIndex (const NTV2InputCrosspointID inInputXpt, uint32_t & outXptRegNum, uint32_t & outMaskIndex) const
 	{
-		AJAAutoLock lock(&mGuardMutex);
 		outXptRegNum = 0xFFFFFFFF;
 		outMaskIndex = 0xFFFFFFFF;
 		InputXpt2XptRegNumMaskIndexMapConstIter iter	(mInputXpt2XptRegNumMaskIndexMap.find (inInputXpt));
@@ -2051,7 +2115,6 @@ public:
 
 	NTV2InputCrosspointID	GetInputCrosspointID (const uint32_t inXptRegNum, const uint32_t inMaskIndex) const
 	{
-		AJAAutoLock lock(&mGuardMutex);
 		const XptRegNumAndMaskIndex				key		(inXptRegNum, inMaskIndex);
 		XptRegNumMaskIndex2InputXptMapConstIter iter	(mXptRegNumMaskIndex2InputXptMap.find (key));
 		if (iter != mXptRegNumMaskIndex2InputXptMap.end())
@@ -2061,7 +2124,6 @@ public:
 
 	ostream &	Print (ostream & inOutStream) const
 	{
-		AJAAutoLock lock(&mGuardMutex);
 		static const string		sLineBreak	(96, '=');
 		static const uint32_t	sMasks[4]	=	{0x000000FF, 0x0000FF00, 0x00FF0000, 0xFF000000};
 		
@@ -4554,13 +4616,16 @@ private:
 	typedef InputXpt2XptRegNumMaskIndexMap::const_iterator		InputXpt2XptRegNumMaskIndexMapConstIter;
 	typedef XptRegNumMaskIndex2InputXptMap::const_iterator		XptRegNumMaskIndex2InputXptMapConstIter;
 
-private:	//	INSTANCE DATA
-	mutable AJALock			mGuardMutex;
+private:	//	INSTANCE DATA	--	Built by the constructor, then never modified, so reads need no locking
 	RegNumToStringMap		mRegNumToStringMap;
 	RegNumToDecoderMap		mRegNumToDecoderMap;
 	RegClassToRegNumMMap	mRegClassToRegNumMMap;
 	StringToRegNumMMap		mStringToRegNumMMap;
-	mutable NTV2StringSet	mAllRegClasses; //	Mutable -- caches results from 'const' method GetAllRegisterClasses
+	NTV2StringSet			mAllRegClasses;
+	RegInfos				mRegInfos;		//	Sorted by register number
+	vector<uint32_t>		mRegInfoIndex;	//	Register number => 1 + index into mRegInfos (or 0), for regNums < kDirectIndexLimit
+	vector<string>			mClassNames;	//	Sorted class names
+	vector<NTV2RegNumSet>	mClassRegs;		//	Registers in each class (parallels mClassNames)
 	InputXpt2XptRegNumMaskIndexMap		mInputXpt2XptRegNumMaskIndexMap;
 	XptRegNumMaskIndex2InputXptMap		mXptRegNumMaskIndex2InputXptMap;
 	
@@ -4569,13 +4634,24 @@ private:	//	INSTANCE DATA
 
 static RegisterExpertPtr	gpRegExpert;		//	Points to Register Expert Singleton
 static AJALock				gRegExpertGuardMutex;
+static void * volatile		gpRegExpertTables (AJA_NULL);	//	Lock-free reader access to the published singleton
+//	Readers hold no reference, so a deallocated singleton can't be freed while the process runs. It's kept here instead,
+//	and reused by the next allocation, so there's never more than one retired singleton (freed at exit).
+static vector<RegisterExpertPtr>	gRetiredRegExperts;
 
 
 RegisterExpertPtr RegisterExpert::GetInstance(const bool inCreateIfNecessary)
 {
 	AJAAutoLock		locker(&gRegExpertGuardMutex);
 	if (!gpRegExpert  &&  inCreateIfNecessary)
-		gpRegExpert = new RegisterExpert;
+	{
+		if (gRetiredRegExperts.empty())
+			gpRegExpert = new RegisterExpert;
+		else
+			{gpRegExpert = gRetiredRegExperts.back();  gRetiredRegExperts.pop_back();}	//	Its tables never change
+		//	Full barrier:  tables are visible to other threads before the pointer is
+		AJAAtomic::CompareAndSwap(&gpRegExpertTables, AJA_NULL, gpRegExpert.get());
+	}
 	return gpRegExpert;
 }
 
@@ -4584,10 +4660,23 @@ bool RegisterExpert::DisposeInstance(void)
 	AJAAutoLock		locker(&gRegExpertGuardMutex);
 	if (!gpRegExpert)
 		return false;
+	AJAAtomic::Exchange(&gpRegExpertTables, AJA_NULL);
+	gRetiredRegExperts.push_back(gpRegExpert);
 	gpRegExpert = AJA_NULL;
 	return true;
 }
 
+//	Fast path for the read-only accessors:  no lock, no reference counting once the singleton exists...
+static inline const RegisterExpert * RegExpert (void)
+{
+	//	Full-barrier read (a no-op swap), so the tables are seen no older than the pointer
+	const RegisterExpert * pRegExpert (reinterpret_cast<const RegisterExpert*>(AJAAtomic::CompareAndSwap(&gpRegExpertTables, AJA_NULL, AJA_NULL)));
+	if (pRegExpert)
+		return pRegExpert;
+	AJAAutoLock locker(&gRegExpertGuardMutex);	//	AJARefPtr's reference count isn't atomic
+	return RegisterExpert::GetInstance(true).get();
+}
+
 bool CNTV2RegisterExpert::Allocate(void)
 {
 	AJAAutoLock lock(&gRegExpertGuardMutex);
@@ -4611,8 +4700,7 @@ bool CNTV2RegisterExpert::Deallocate(void)
 
 string CNTV2RegisterExpert::GetDisplayName (const uint32_t inRegNum)
 {
-	AJAAutoLock locker(&gRegExpertGuardMutex);
-	RegisterExpertPtr pRegExpert(RegisterExpert::GetInstance());
+	const RegisterExpert * pRegExpert (RegExpert());
 	if (pRegExpert)
 		return pRegExpert->RegNameToString(inRegNum);
 
@@ -4628,70 +4716,60 @@ string CNTV2RegisterExpert::GetDisplayName (const uint32_t inRegNum)
 
 string CNTV2RegisterExpert::GetDisplayValue (const uint32_t inRegNum, const uint32_t inRegValue, const NTV2DeviceID inDeviceID)
 {
-	AJAAutoLock locker(&gRegExpertGuardMutex);
-	RegisterExpertPtr pRegExpert(RegisterExpert::GetInstance());
+	const RegisterExpert * pRegExpert (RegExpert());
 	return pRegExpert ? pRegExpert->RegValueToString(inRegNum, inRegValue, inDeviceID) : string();
 }
 
 bool CNTV2RegisterExpert::IsRegisterInClass (const uint32_t inRegNum, const string & inClassName)
 {
-	AJAAutoLock locker(&gRegExpertGuardMutex);
-	RegisterExpertPtr pRegExpert(RegisterExpert::GetInstance());
+	const RegisterExpert * pRegExpert (RegExpert());
 	return pRegExpert ? pRegExpert->IsRegInClass(inRegNum, inClassName) : false;
 }
 
 NTV2StringSet CNTV2RegisterExpert::GetAllRegisterClasses (void)
 {
-	AJAAutoLock locker(&gRegExpertGuardMutex);
-	RegisterExpertPtr pRegExpert(RegisterExpert::GetInstance());
+	const RegisterExpert * pRegExpert (RegExpert());
 	return pRegExpert ? pRegExpert->GetAllRegisterClasses() : NTV2StringSet();
 }
 
 NTV2StringSet CNTV2RegisterExpert::GetRegisterClasses (const uint32_t inRegNum, const bool inRemovePrefix)
 {
-	AJAAutoLock locker(&gRegExpertGuardMutex);
-	RegisterExpertPtr pRegExpert(RegisterExpert::GetInstance());
+	const RegisterExpert * pRegExpert (RegExpert());
 	return pRegExpert ? pRegExpert->GetRegisterClasses(inRegNum, inRemovePrefix) : NTV2StringSet();
 }
 
 NTV2RegNumSet CNTV2RegisterExpert::GetRegistersForClass (const string & inClassName)
 {
-	AJAAutoLock locker(&gRegExpertGuardMutex);
-	RegisterExpertPtr pRegExpert(RegisterExpert::GetInstance());
+	const RegisterExpert * pRegExpert (RegExpert());
 	return pRegExpert ? pRegExpert->GetRegistersForClass(inClassName) : NTV2RegNumSet();
 }
 
 NTV2RegNumSet CNTV2RegisterExpert::GetRegistersForChannel (const NTV2Channel inChannel)
 {
-	AJAAutoLock locker(&gRegExpertGuardMutex);
-	RegisterExpertPtr pRegExpert(RegisterExpert::GetInstance());
+	const RegisterExpert * pRegExpert (RegExpert());
 	return NTV2_IS_VALID_CHANNEL(inChannel)	 ?	(pRegExpert ? pRegExpert->GetRegistersForClass(gChlClasses[inChannel]):NTV2RegNumSet())	 :	NTV2RegNumSet();
 }
 
 NTV2RegNumSet CNTV2RegisterExpert::GetRegistersForDevice (const NTV2DeviceID inDeviceID, const int inOtherRegsToInclude)
 {
-	AJAAutoLock locker(&gRegExpertGuardMutex);
-	RegisterExpertPtr pRegExpert(RegisterExpert::GetInstance());
+	const RegisterExpert * pRegExpert (RegExpert());
 	return pRegExpert ? pRegExpert->GetRegistersForDevice(inDeviceID, inOtherRegsToInclude) : NTV2RegNumSet();
 }
 
 NTV2RegNumSet CNTV2RegisterExpert::GetRegistersWithName (const string & inName, const int inSearchStyle)
 {
-	AJAAutoLock locker(&gRegExpertGuardMutex);
-	RegisterExpertPtr pRegExpert(RegisterExpert::GetInstance());
+	const RegisterExpert * pRegExpert (RegExpert());
 	return pRegExpert ? pRegExpert->GetRegistersWithName(inName, inSearchStyle) : NTV2RegNumSet();
 }
 
 NTV2InputCrosspointID CNTV2RegisterExpert::GetInputCrosspointID (const uint32_t inXptRegNum, const uint32_t inMaskIndex)
 {
-	AJAAutoLock locker(&gRegExpertGuardMutex);
-	RegisterExpertPtr pRegExpert(RegisterExpert::GetInstance());
+	const RegisterExpert * pRegExpert (RegExpert());
 	return pRegExpert ? pRegExpert->GetInputCrosspointID(inXptRegNum, inMaskIndex) : NTV2_INPUT_CROSSPOINT_INVALID;
 }
 
 bool CNTV2RegisterExpert::GetCrosspointSelectGroupRegisterInfo (const NTV2InputCrosspointID inInputXpt, uint32_t & outXptRegNum, uint32_t & outMaskIndex)
 {
-	AJAAutoLock locker(&gRegExpertGuardMutex);
-	RegisterExpertPtr pRegExpert(RegisterExpert::GetInstance());
+	const RegisterExpert * pRegExpert (RegExpert());
 	return pRegExpert ? pRegExpert->GetXptRegNumAndMaskIndex(inInputXpt, outXptRegNum, outMaskIndex) : false;
 }
@@ -0,0 +1,511 @@
+/* SPDX-License-Identifier: MIT */
+/**
+	@file		ntv2scaler.cpp
+	@brief		Implements the CNTV2Scaler class.
+	@copyright	(C) 2023 AJA Video Systems, Inc.
+**/
+
+#include "ntv2scaler.h"
+#include "ntv2utils.h"
+#include "ajabase/system/debug.h"
+#include "ajabase/system/workerpool.h"
+#include <cmath>
+#include <string.h>
+#if defined(AJA_HAS_SSE2)
+	#include <emmintrin.h>
+#endif
+
+using namespace std;
+
+#define SCFAIL(__x__)	AJA_sERROR	(AJA_DebugUnit_VideoGeneric, AJAFUNC << ": " << __x__)
+
+static const double	kPi			(3.14159265358979323846);
+static const LWord	kWeightOne	(1 << 14);	//	Weights are Q14 fixed-point
+static const ULWord	kMaxPlanes	(4);
+
+
+string NTV2ScalerFilterToString (const NTV2ScalerFilter inFilter, const bool inCompact)
+{
+	switch (inFilter)
+	{
+		case NTV2_SCALER_FILTER_BILINEAR:	return inCompact ? "bilinear"	: "NTV2_SCALER_FILTER_BILINEAR";
+		case NTV2_SCALER_FILTER_BICUBIC:	return inCompact ? "bicubic"	: "NTV2_SCALER_FILTER_BICUBIC";
+		case NTV2_SCALER_FILTER_LANCZOS:	return inCompact ? "lanczos"	: "NTV2_SCALER_FILTER_LANCZOS";
+		case NTV2_SCALER_FILTER_INVALID:	break;
+	}
+	return inCompact ? "???" : "NTV2_SCALER_FILTER_INVALID";
+}
+
+
+//	How a pixel format's lines are split into component planes
+typedef struct PlaneLayout
+{
+	ULWord	fNumPlanes;					//	Number of component planes
+	bool	f422;						//	True if planes 1 & 2 are half-width chroma
+	UWord	fMaxValue;					//	Maximum component value
+	ULWord	fWidth[kMaxPlanes];			//	Width of each plane, in samples
+	ULWord	fOffset[kMaxPlanes];		//	Offset of each plane in a line of planes, in samples
+	ULWord	fStride;					//	Size of a line of planes, in samples
+
+	PlaneLayout (const NTV2PixelFormat inPF, const ULWord inWidth, const ULWord inPadding)
+		:	fNumPlanes(0), f422(false), fMaxValue(255), fStride(0)
+	{
+		switch (inPF)
+		{
+			case NTV2_FBF_10BIT_YCBCR:		fNumPlanes = 3;	f422 = true;	fMaxValue = 1023;	break;
+			case NTV2_FBF_8BIT_YCBCR:
+			case NTV2_FBF_8BIT_YCBCR_YUY2:	fNumPlanes = 3;	f422 = true;						break;
+			case NTV2_FBF_10BIT_RGB:		fNumPlanes = 3;					fMaxValue = 1023;	break;
+			case NTV2_FBF_ARGB:
+			case NTV2_FBF_RGBA:
+			case NTV2_FBF_ABGR:				fNumPlanes = 4;										break;
+			case NTV2_FBF_24BIT_RGB:
+			case NTV2_FBF_24BIT_BGR:		fNumPlanes = 3;										break;
+			default:																			break;
+		}
+		for (ULWord plane(0);  plane < fNumPlanes;  plane++)
+		{
+			fWidth[plane] = (f422 && plane) ? inWidth / 2 : inWidth;
+			fOffset[plane] = fStride;
+			fStride += (fWidth[plane] + inPadding + 7) / 8 * 8;
+		}
+	}
+} PlaneLayout;
+
+
+//	Unpacks a line into component planes
+static void UnpackLine (const NTV2PixelFormat inPF, const UByte * pInLine, const ULWord inWidth, const PlaneLayout & inLayout, Word * pOutPlanes, UWord * pScratch)
+{
+	Word *	pP0 (pOutPlanes + inLayout.fOffset[0]);
+	Word *	pP1 (pOutPlanes + inLayout.fOffset[1]);
+	Word *	pP2 (pOutPlanes + inLayout.fOffset[2]);
+	switch (inPF)
+	{
+		case NTV2_FBF_10BIT_YCBCR:
+			::UnpackLine_10BitYUVto16BitYUV(reinterpret_cast<const ULWord*>(pInLine), pScratch, inWidth);
+			for (ULWord ndx(0);  ndx < inWidth / 2;  ndx++)
+			{
+				pP1[ndx] = Word(pScratch[4*ndx+0]);		pP0[2*ndx+0] = Word(pScratch[4*ndx+1]);
+				pP2[ndx] = Word(pScratch[4*ndx+2]);		pP0[2*ndx+1] = Word(pScratch[4*ndx+3]);
+			}
+			break;
+		case NTV2_FBF_8BIT_YCBCR:	//	Cb Y0 Cr Y1
+			for (ULWord ndx(0);  ndx < inWidth / 2;  ndx++)
+			{
+				pP1[ndx] = pInLine[4*ndx+0];	pP0[2*ndx+0] = pInLine[4*ndx+1];
+				pP2[ndx] = pInLine[4*ndx+2];	pP0[2*ndx+1] = pInLine[4*ndx+3];
+			}
+			break;
+		case NTV2_FBF_8BIT_YCBCR_YUY2:	//	Y0 Cb Y1 Cr
+			for (ULWord ndx(0);  ndx < inWidth / 2;  ndx++)
+			{
+				pP0[2*ndx+0] = pInLine[4*ndx+0];	pP1[ndx] = pInLine[4*ndx+1];
+				pP0[2*ndx+1] = pInLine[4*ndx+2];	pP2[ndx] = pInLine[4*ndx+3];
+			}
+			break;
+		case NTV2_FBF_10BIT_RGB:
+		{
+			const ULWord * pWords (reinterpret_cast<const ULWord*>(pInLine));
+			for (ULWord ndx(0);  ndx < inWidth;  ndx++)
+			{
+				pP0[ndx] = Word(pWords[ndx] & 0x3FF);
+				pP1[ndx] = Word((pWords[ndx] >> 10) & 0x3FF);
+				pP2[ndx] = Word((pWords[ndx] >> 20) & 0x3FF);
+			}
+			break;
+		}
+		default:	//	8-bit RGB:  one plane per byte of each pixel
+		{
+			const ULWord bytesPerPixel (inLayout.fNumPlanes);
+			for (ULWord plane(0);  plane < bytesPerPixel;  plane++)
+			{
+				Word * pPlane (pOutPlanes + inLayout.fOffset[plane]);
+				for (ULWord ndx(0);  ndx < inWidth;  ndx++)
+					pPlane[ndx] = pInLine[ndx * bytesPerPixel + plane];
+			}
+			break;
+		}
+	}
+}
+
+
+//	Packs component planes into a line
+static void PackLine (const NTV2PixelFormat inPF, const Word * pInPlanes, const ULWord inWidth, const PlaneLayout & inLayout, UByte * pOutLine, UWord * pScratch)
+{
+	const Word *	pP0 (pInPlanes + inLayout.fOffset[0]);
+	const Word *	pP1 (pInPlanes + inLayout.fOffset[1]);
+	const Word *	pP2 (pInPlanes + inLayout.fOffset[2]);
+	switch (inPF)
+	{
+		case NTV2_FBF_10BIT_YCBCR:
+		{
+			const ULWord paddedWidth ((inWidth + 5) / 6 * 6);	//	PackLine_16BitYUVto10BitYUV packs 6 pixels at a time
+			for (ULWord ndx(0);  ndx < paddedWidth / 2;  ndx++)
+				if (ndx < inWidth / 2)
+				{
+					pScratch[4*ndx+0] = UWord(pP1[ndx]);	pScratch[4*ndx+1] = UWord(pP0[2*ndx+0]);
+					pScratch[4*ndx+2] = UWord(pP2[ndx]);	pScratch[4*ndx+3] = UWord(pP0[2*ndx+1]);
+				}
+				else
+				{
+					pScratch[4*ndx+0] = pScratch[4*ndx+2] = 0x200;	//	Pad with black
+					pScratch[4*ndx+1] = pScratch[4*ndx+3] = 0x040;
+				}
+			::PackLine_16BitYUVto10BitYUV(pScratch, reinterpret_cast<ULWord*>(pOutLine), paddedWidth);
+			break;
+		}
+		case NTV2_FBF_8BIT_YCBCR:
+			for (ULWord ndx(0);  ndx < inWidth / 2;  ndx++)
+			{
+				pOutLine[4*ndx+0] = UByte(pP1[ndx]);	pOutLine[4*ndx+1] = UByte(pP0[2*ndx+0]);
+				pOutLine[4*ndx+2] = UByte(pP2[ndx]);	pOutLine[4*ndx+3] = UByte(pP0[2*ndx+1]);
+			}
+			break;
+		case NTV2_FBF_8BIT_YCBCR_YUY2:
+			for (ULWord ndx(0);  ndx < inWidth / 2;  ndx++)
+			{
+				pOutLine[4*ndx+0] = UByte(pP0[2*ndx+0]);	pOutLine[4*ndx+1] = UByte(pP1[ndx]);
+				pOutLine[4*ndx+2] = UByte(pP0[2*ndx+1]);	pOutLine[4*ndx+3] = UByte(pP2[ndx]);
+			}
+			break;
+		case NTV2_FBF_10BIT_RGB:
+		{
+			ULWord * pWords (reinterpret_cast<ULWord*>(pOutLine));
+			for (ULWord ndx(0);  ndx < inWidth;  ndx++)
+				pWords[ndx] = ULWord(pP2[ndx]) << 20  |  ULWord(pP1[ndx]) << 10  |  ULWord(pP0[ndx]);
+			break;
+		}
+		default:
+		{
+			const ULWord bytesPerPixel (inLayout.fNumPlanes);
+			for (ULWord plane(0);  plane < bytesPerPixel;  plane++)
+			{
+				const Word * pPlane (pInPlanes + inLayout.fOffset[plane]);
+				for (ULWord ndx(0);  ndx < inWidth;  ndx++)
+					pOutLine[ndx * bytesPerPixel + plane] = UByte(pPlane[ndx]);
+			}
+			break;
+		}
+	}
+}
+
+
+static inline Word SaturateWord (const LWord inValue)
+{
+	return Word(inValue < -32768 ? -32768 : (inValue > 32767 ? 32767 : inValue));
+}
+
+//	Filters one plane horizontally
+static void FilterHorizontal (const Word * pIn, Word * pOut, const CNTV2Scaler::FilterTable & inTable, const bool inUseSIMD)
+{
+	const ULWord	taps	(inTable.fTaps);
+	const Word *	pWeights(&inTable.fWeights[0]);
+#if defined(AJA_HAS_SSE2)
+	if (inUseSIMD)
+	{
+		for (ULWord outNdx(0);  outNdx < inTable.fOutSize;  outNdx++,  pWeights += taps)
+		{
+			const Word *	pSrc	(pIn + inTable.fStart[outNdx]);
+			__m128i			acc		(_mm_setzero_si128());
+			for (ULWord tap(0);  tap < taps;  tap += 8)
+				acc = _mm_add_epi32(acc, _mm_madd_epi16(_mm_loadu_si128(reinterpret_cast<const __m128i*>(pSrc + tap)),
+														_mm_loadu_si128(reinterpret_cast<const __m128i*>(pWeights + tap))));
+			acc = _mm_add_epi32(acc, _mm_shuffle_epi32(acc, _MM_SHUFFLE(1,0,3,2)));
+			acc = _mm_add_epi32(acc, _mm_shuffle_epi32(acc, _MM_SHUFFLE(2,3,0,1)));
+			pOut[outNdx] = SaturateWord((_mm_cvtsi128_si32(acc) + kWeightOne / 2) >> 14);
+		}
+		return;
+	}
+#endif	//	AJA_HAS_SSE2
+	for (ULWord outNdx(0);  outNdx < inTable.fOutSize;  outNdx++,  pWeights += taps)
+	{
+		const Word *	pSrc	(pIn + inTable.fStart[outNdx]);
+		LWord			acc		(0);
+		for (ULWord tap(0);  tap < taps;  tap++)
+			acc += LWord(pSrc[tap]) * LWord(pWeights[tap]);
+		pOut[outNdx] = SaturateWord((acc + kWeightOne / 2) >> 14);
+	}
+}
+
+//	Filters a line of planes vertically:  pOut[x] = sum(pRows[k][x] * pWeights[k]), clamped to [0, inMaxValue]
+static void FilterVertical (const Word * const * pRows, const Word * pWeights, const ULWord inNumRows, Word * pOut,
+							const ULWord inNumSamples, const UWord inMaxValue, const bool inUseSIMD)
+{
+	ULWord ndx(0);
+#if defined(AJA_HAS_SSE2)
+	if (inUseSIMD)
+	{
+		const __m128i	zero		(_mm_setzero_si128());
+		const __m128i	maxValue	(_mm_set1_epi16(short(inMaxValue)));
+		const __m128i	rounding	(_mm_set1_epi32(kWeightOne / 2));
+		for (;  ndx + 8 <= inNumSamples;  ndx += 8)
+		{
+			__m128i accLo (rounding),  accHi (rounding);
+			for (ULWord row(0);  row < inNumRows;  row += 2)
+			{
+				const bool		havePair	(row + 1 < inNumRows);
+				const __m128i	a			(_mm_loadu_si128(reinterpret_cast<const __m128i*>(pRows[row] + ndx)));
+				const __m128i	b			(havePair ? _mm_loadu_si128(reinterpret_cast<const __m128i*>(pRows[row+1] + ndx)) : zero);
+				const __m128i	weights		(_mm_set1_epi32(int(ULWord(UWord(pWeights[row])) | (havePair ? ULWord(UWord(pWeights[row+1])) << 16 : 0))));
+				accLo = _mm_add_epi32(accLo, _mm_madd_epi16(_mm_unpacklo_epi16(a, b), weights));
+				accHi = _mm_add_epi32(accHi, _mm_madd_epi16(_mm_unpackhi_epi16(a, b), weights));
+			}
+			const __m128i result (_mm_packs_epi32(_mm_srai_epi32(accLo, 14), _mm_srai_epi32(accHi, 14)));
+			_mm_storeu_si128(reinterpret_cast<__m128i*>(pOut + ndx), _mm_min_epi16(_mm_max_epi16(result, zero), maxValue));
+		}
+	}
+#endif	//	AJA_HAS_SSE2
+	for (;  ndx < inNumSamples;  ndx++)
+	{
+		LWord acc (kWeightOne / 2);
+		for (ULWord row(0);  row < inNumRows;  row++)
+			acc += LWord(pRows[row][ndx]) * LWord(pWeights[row]);
+		const LWord value (SaturateWord(acc >> 14));
+		pOut[ndx] = Word(value < 0 ? 0 : (value > inMaxValue ? inMaxValue : value));
+	}
+}
+
+
+typedef struct ScaleJob
+{
+	NTV2PixelFormat						fPixelFormat;
+	const UByte *						fpIn;
+	ULWord								fInRowBytes;
+	ULWord								fInWidth;
+	UByte *								fpOut;
+	ULWord								fOutRowBytes;
+	ULWord								fOutWidth;
+	Word *								fpIntermediate;
+	const CNTV2Scaler::FilterTable *	fpHorz;
+	const CNTV2Scaler::FilterTable *	fpHorzChroma;
+	const CNTV2Scaler::FilterTable *	fpVert;
+	bool								fUseSIMD;
+} ScaleJob;
+
+//	Unpacks and horizontally filters input lines [inFirst, inEnd) into the intermediate buffer
+static void HorizontalPass (void * pContext, uint32_t inFirst, uint32_t inEnd)
+{
+	const ScaleJob &	job			(*reinterpret_cast<const ScaleJob*>(pContext));
+	const ULWord		padding		(job.fpHorz->fTaps > job.fpHorzChroma->fTaps ? job.fpHorz->fTaps : job.fpHorzChroma->fTaps);
+	const PlaneLayout	inLayout	(job.fPixelFormat, job.fInWidth, padding);
+	const PlaneLayout	outLayout	(job.fPixelFormat, job.fOutWidth, 0);
+	vector<Word>		planes		(inLayout.fStride, 0);	//	Zero padding past each plane's end
+	vector<UWord>		scratch		(job.fInWidth * 2 + 16, 0);
+	for (ULWord line(inFirst);  line < inEnd;  line++)
+	{
+		UnpackLine(job.fPixelFormat, job.fpIn + line * job.fInRowBytes, job.fInWidth, inLayout, &planes[0], &scratch[0]);
+		Word * pOutPlanes (job.fpIntermediate + line * outLayout.fStride);
+		for (ULWord plane(0);  plane < inLayout.fNumPlanes;  plane++)
+			FilterHorizontal(&planes[inLayout.fOffset[plane]], pOutPlanes + outLayout.fOffset[plane],
+							(inLayout.f422 && plane) ? *job.fpHorzChroma : *job.fpHorz, job.fUseSIMD);
+	}
+}
+
+//	Vertically filters and packs output lines [inFirst, inEnd)
+static void VerticalPass (void * pContext, uint32_t inFirst, uint32_t inEnd)
+{
+	const ScaleJob &	job			(*reinterpret_cast<const ScaleJob*>(pContext));
+	const PlaneLayout	outLayout	(job.fPixelFormat, job.fOutWidth, 0);
+	const ULWord		taps		(job.fpVert->fTaps);
+	vector<Word>		planes		(outLayout.fStride, 0);
+	vector<UWord>		scratch		((job.fOutWidth + 6) * 2 + 16, 0);
+	vector<const Word*>	rows		(taps, AJA_NULL);
+	for (ULWord line(inFirst);  line < inEnd;  line++)
+	{
+		//	Skip the zero weights that pad the table
+		const Word *	pWeights	(&job.fpVert->fWeights[line * taps]);
+		ULWord			numRows		(taps);
+		while (numRows > 1  &&  !pWeights[numRows - 1])
+			numRows--;
+		for (ULWord row(0);  row < numRows;  row++)
+			rows[row] = job.fpIntermediate + (job.fpVert->fStart[line] + row) * outLayout.fStride;
+		FilterVertical(&rows[0], pWeights, numRows, &planes[0], outLayout.fStride, outLayout.fMaxValue, job.fUseSIMD);
+		PackLine(job.fPixelFormat, &planes[0], job.fOutWidth, outLayout, job.fpOut + line * job.fOutRowBytes, &scratch[0]);
+	}
+}
+
+
+CNTV2Scaler::CNTV2Scaler (const NTV2ScalerFilter inFilter,  const ULWord inTaps,  AJAWorkerPool * pInPool)
+	:	mpPool		(pInPool ? pInPool : &AJAWorkerPool::GetSharedPool()),
+		mFilter		(NTV2_SCALER_FILTER_LANCZOS),
+		mTaps		(6),
+		mUseSIMD	(HasSIMD())
+{
+	SetFilter(inFilter, inTaps);
+}
+
+CNTV2Scaler::~CNTV2Scaler ()
+{
+}
+
+bool CNTV2Scaler::HasSIMD (void)
+{
+#if defined(AJA_HAS_SSE2)
+	return true;
+#else
+	return false;
+#endif
+}
+
+bool CNTV2Scaler::CanScale (const NTV2PixelFormat inPixelFormat)
+{
+	return GetRowBytes(inPixelFormat, 2) != 0;
+}
+
+ULWord CNTV2Scaler::GetRowBytes (const NTV2PixelFormat inPixelFormat, const ULWord inWidth)
+{
+	switch (inPixelFormat)
+	{
+		case NTV2_FBF_10BIT_YCBCR:		return (inWidth + 47) / 48 * 128;
+		case NTV2_FBF_8BIT_YCBCR:
+		case NTV2_FBF_8BIT_YCBCR_YUY2:	return inWidth * 2;
+		case NTV2_FBF_10BIT_RGB:
+		case NTV2_FBF_ARGB:
+		case NTV2_FBF_RGBA:
+		case NTV2_FBF_ABGR:				return inWidth * 4;
+		case NTV2_FBF_24BIT_RGB:
+		case NTV2_FBF_24BIT_BGR:		return inWidth * 3;
+		default:						break;
+	}
+	return 0;
+}
+
+bool CNTV2Scaler::SetFilter (const NTV2ScalerFilter inFilter, const ULWord inTaps)
+{
+	if (!NTV2_IS_VALID_SCALER_FILTER(inFilter))
+		{SCFAIL("Invalid filter " << DEC(inFilter));  return false;}
+	if (inFilter == NTV2_SCALER_FILTER_LANCZOS  &&  (inTaps < 2  ||  inTaps > 16  ||  inTaps & 1))
+		{SCFAIL("Invalid Lanczos tap count " << DEC(inTaps) << " -- must be even, 2 thru 16");  return false;}
+	mFilter = inFilter;
+	mTaps = inFilter == NTV2_SCALER_FILTER_BILINEAR ? 2 : (inFilter == NTV2_SCALER_FILTER_BICUBIC ? 4 : inTaps);
+	mHorz = mHorzChroma = mVert = FilterTable();	//	Force tables to be rebuilt
+	return true;
+}
+
+void CNTV2Scaler::BuildTable (FilterTable & outTable, const ULWord inInSize, const ULWord inOutSize, const bool inCoSited) const
+{
+	const double	scale		(double(inInSize) / double(inOutSize));
+	const double	stretch		(scale > 1.0 ? scale : 1.0);	//	Widen the filter when downscaling
+	const double	radius		(double(mTaps) / 2.0 * stretch);
+	ULWord			support		(ULWord(std::ceil(2.0 * radius)) + 1);
+	if (support > inInSize)
+		support = inInSize;
+
+	outTable.fInSize	= inInSize;
+	outTable.fOutSize	= inOutSize;
+	outTable.fCoSited	= inCoSited;
+	outTable.fTaps		= (support + 7) / 8 * 8;
+	outTable.fStart.assign(inOutSize, 0);
+	outTable.fWeights.assign(size_t(inOutSize) * outTable.fTaps, 0);
+
+	vector<double> weights (support, 0.0);
+	for (ULWord outNdx(0);  outNdx < inOutSize;  outNdx++)
+	{
+		//	Input position of this output sample's center
+		const double center (inCoSited	?	((2.0 * outNdx + 0.5) * scale - 0.5) / 2.0
+										:	(outNdx + 0.5) * scale - 0.5);
+		const LWord first (LWord(std::ceil(center - radius)));
+		LWord start (first);
+		if (start > LWord(inInSize - support))
+			start = LWord(inInSize - support);
+		if (start < 0)
+			start = 0;
+		std::fill(weights.begin(), weights.end(), 0.0);
+		double total (0.0);
+		for (LWord pos(first);  pos <= LWord(std::floor(center + radius));  pos++)
+		{
+			const double x (std::fabs(double(pos) - center) / stretch);
+			double w (0.0);
+			switch (mFilter)
+			{
+				case NTV2_SCALER_FILTER_BILINEAR:
+					w = x < 1.0 ? 1.0 - x : 0.0;
+					break;
+				case NTV2_SCALER_FILTER_BICUBIC:	//	Catmull-Rom
+					w = x < 1.0 ? (1.5 * x - 2.5) * x * x + 1.0 : (x < 2.0 ? ((-0.5 * x + 2.5) * x - 4.0) * x + 2.0 : 0.0);
+					break;
+				default:
+				{
+					const double a (double(mTaps) / 2.0);
+					w = x < 1e-9 ? 1.0 : (x < a ? a * std::sin(kPi * x) * std::sin(kPi * x / a) / (kPi * kPi * x * x) : 0.0);
+					break;
+				}
+			}
+			//	Samples off the edge are replicas of the edge sample
+			LWord ndx (pos < 0 ? 0 : (pos >= LWord(inInSize) ? LWord(inInSize) - 1 : pos));
+			ndx -= start;
+			if (ndx < 0  ||  ndx >= LWord(support))
+				continue;
+			weights[size_t(ndx)] += w;
+			total += w;
+		}
+
+		//	Quantize to Q14, putting any rounding error on the largest weight, so they sum to exactly 1.0
+		Word *	pWeights	(&outTable.fWeights[size_t(outNdx) * outTable.fTaps]);
+		LWord	sum			(0);
+		ULWord	largest		(0);
+		for (ULWord tap(0);  tap < support;  tap++)
+		{
+			pWeights[tap] = Word(std::floor((total != 0.0 ? weights[tap] / total : (tap ? 0.0 : 1.0)) * kWeightOne + 0.5));
+			sum += pWeights[tap];
+			if (pWeights[tap] > pWeights[largest])
+				largest = tap;
+		}
+		pWeights[largest] = Word(pWeights[largest] + kWeightOne - sum);
+		outTable.fStart[outNdx] = ULWord(start);
+	}
+}
+
+bool CNTV2Scaler::PrepareTables (const ULWord inInWidth, const ULWord inInHeight, const ULWord inOutWidth, const ULWord inOutHeight, const bool in422)
+{
+	if (mHorz.fInSize != inInWidth  ||  mHorz.fOutSize != inOutWidth)
+		BuildTable(mHorz, inInWidth, inOutWidth, false);
+	if (in422  &&  (mHorzChroma.fInSize != inInWidth / 2  ||  mHorzChroma.fOutSize != inOutWidth / 2))
+		BuildTable(mHorzChroma, inInWidth / 2, inOutWidth / 2, true);
+	if (mVert.fInSize != inInHeight  ||  mVert.fOutSize != inOutHeight)
+		BuildTable(mVert, inInHeight, inOutHeight, false);
+	return true;
+}
+
+bool CNTV2Scaler::Scale (const NTV2Buffer & inFrame,  const NTV2FormatDescriptor & inDesc,  NTV2Buffer & outFrame,
+						const ULWord inOutWidth,  const ULWord inOutHeight,  const ULWord inOutRowBytes)
+{
+	const NTV2PixelFormat	pf			(inDesc.GetPixelFormat());
+	const ULWord			inWidth		(inDesc.GetRasterWidth());
+	const ULWord			inHeight	(inDesc.GetRasterHeight());
+	const ULWord			outRowBytes	(inOutRowBytes ? inOutRowBytes : GetRowBytes(pf, inOutWidth));
+	if (!inDesc.IsValid()  ||  !CanScale(pf))
+		{SCFAIL("Invalid format descriptor or unsupported pixel format " << ::NTV2FrameBufferFormatToString(pf));  return false;}
+	const PlaneLayout		outLayout	(pf, inOutWidth, 0);
+	if (!inOutWidth  ||  !inOutHeight  ||  (outLayout.f422  &&  ((inOutWidth | inWidth) & 1)))
+		{SCFAIL("Invalid size " << DEC(inWidth) << "x" << DEC(inHeight) << " => " << DEC(inOutWidth) << "x" << DEC(inOutHeight));  return false;}
+	if (outRowBytes < GetRowBytes(pf, inOutWidth))
+		{SCFAIL("Line pitch " << DEC(outRowBytes) << " too small for " << DEC(inOutWidth) << "-pixel line");  return false;}
+	if (inFrame.GetByteCount() < inDesc.GetBytesPerRow() * inHeight)
+		{SCFAIL("Source buffer " << DEC(inFrame.GetByteCount()) << " bytes smaller than raster " << DEC(inDesc.GetBytesPerRow() * inHeight));  return false;}
+	if (outFrame.GetByteCount() < outRowBytes * inOutHeight)
+		{SCFAIL("Destination buffer " << DEC(outFrame.GetByteCount()) << " bytes smaller than " << DEC(outRowBytes * inOutHeight));  return false;}
+
+	PrepareTables(inWidth, inHeight, inOutWidth, inOutHeight, outLayout.f422);
+	const ULWord intermediateBytes (inHeight * outLayout.fStride * ULWord(sizeof(Word)));
+	if (mIntermediate.GetByteCount() < intermediateBytes)
+		if (!mIntermediate.Allocate(intermediateBytes, /*pageAligned*/true))
+			{SCFAIL("Can't allocate " << DEC(intermediateBytes) << "-byte intermediate buffer");  return false;}
+
+	ScaleJob job;
+	job.fPixelFormat	= pf;
+	job.fpIn			= inFrame;
+	job.fInRowBytes		= inDesc.GetBytesPerRow();
+	job.fInWidth		= inWidth;
+	job.fpOut			= outFrame;
+	job.fOutRowBytes	= outRowBytes;
+	job.fOutWidth		= inOutWidth;
+	job.fpIntermediate	= mIntermediate;
+	job.fpHorz			= &mHorz;
+	job.fpHorzChroma	= outLayout.f422 ? &mHorzChroma : &mHorz;
+	job.fpVert			= &mVert;
+	job.fUseSIMD		= mUseSIMD;
+	if (AJA_FAILURE(mpPool->ParallelFor(inHeight, HorizontalPass, &job)))
+		return false;
+	return AJA_SUCCESS(mpPool->ParallelFor(inOutHeight, VerticalPass, &job));
+}
@@ -0,0 +1,521 @@
+/* SPDX-License-Identifier: MIT */
+/**
+	@file		ntv2signalmonitor.cpp
+	@brief		Implements the CNTV2SignalMonitor class.
+	@copyright	(C) 2023 AJA Video Systems, Inc.
+**/
+
+#include "ntv2signalmonitor.h"
+#include "ntv2signalrouter.h"
+#include "ntv2endian.h"
+#include "ntv2utils.h"
+#include "ntv2vpid.h"
+#include "ajabase/system/debug.h"
+#include "ajabase/system/systemtime.h"
+#include <algorithm>
+#include <iomanip>
+
+using namespace std;
+
+#define INSTP(_p_)			xHEX0N(uint64_t(_p_),16)
+#define	SMFAIL(__x__)		AJA_sERROR  (AJA_DebugUnit_DriverInterface, INSTP(this) << "::" << AJAFUNC << ": " << __x__)
+#define	SMWARN(__x__)		AJA_sWARNING(AJA_DebugUnit_DriverInterface, INSTP(this) << "::" << AJAFUNC << ": " << __x__)
+#define	SMNOTE(__x__)		AJA_sNOTICE (AJA_DebugUnit_DriverInterface, INSTP(this) << "::" << AJAFUNC << ": " << __x__)
+#define	SMINFO(__x__)		AJA_sINFO   (AJA_DebugUnit_DriverInterface, INSTP(this) << "::" << AJAFUNC << ": " << __x__)
+#define	SMDBG(__x__)		AJA_sDEBUG  (AJA_DebugUnit_DriverInterface, INSTP(this) << "::" << AJAFUNC << ": " << __x__)
+
+
+//	These static tables mirror the ones in ntv2register.cpp, ntv2regvpid.cpp and ntv2audio.cpp.
+//	CAUTION:	These are predicated on NTV2Channel being ordinal (NTV2_CHANNEL1==0, NTV2_CHANNEL2==1, etc.)
+static const ULWord gSDIInStatusRegNum []		= { kRegInputStatus,			kRegInputStatus,			kRegInputStatus2,			kRegInputStatus2,
+													kRegInput56Status,			kRegInput56Status,			kRegInput78Status,			kRegInput78Status,			0};
+static const ULWord gSDIIn3GStatusRegNum []		= { kRegSDIInput3GStatus,		kRegSDIInput3GStatus,		kRegSDIInput3GStatus2,		kRegSDIInput3GStatus2,
+													kRegSDI5678Input3GStatus,	kRegSDI5678Input3GStatus,	kRegSDI5678Input3GStatus,	kRegSDI5678Input3GStatus,	0};
+static const ULWord gSDIInVPIDARegNum []		= { kRegSDIIn1VPIDA,			kRegSDIIn2VPIDA,			kRegSDIIn3VPIDA,			kRegSDIIn4VPIDA,
+													kRegSDIIn5VPIDA,			kRegSDIIn6VPIDA,			kRegSDIIn7VPIDA,			kRegSDIIn8VPIDA,			0};
+static const ULWord gSDIInVPIDBRegNum []		= { kRegSDIIn1VPIDB,			kRegSDIIn2VPIDB,			kRegSDIIn3VPIDB,			kRegSDIIn4VPIDB,
+													kRegSDIIn5VPIDB,			kRegSDIIn6VPIDB,			kRegSDIIn7VPIDB,			kRegSDIIn8VPIDB,			0};
+static const ULWord gRXSDIStatusRegNum []		= { kRegRXSDI1Status,			kRegRXSDI2Status,			kRegRXSDI3Status,			kRegRXSDI4Status,
+													kRegRXSDI5Status,			kRegRXSDI6Status,			kRegRXSDI7Status,			kRegRXSDI8Status,			0};
+static const ULWord gRXSDICRCErrorRegNum []		= { kRegRXSDI1CRCErrorCount,	kRegRXSDI2CRCErrorCount,	kRegRXSDI3CRCErrorCount,	kRegRXSDI4CRCErrorCount,
+													kRegRXSDI5CRCErrorCount,	kRegRXSDI6CRCErrorCount,	kRegRXSDI7CRCErrorCount,	kRegRXSDI8CRCErrorCount,	0};
+static const ULWord gAudioDetectRegNum []		= { kRegAud1Detect,				kRegAud1Detect,				kRegAudDetect2,				kRegAudDetect2,
+													kRegAudioDetect5678,		kRegAudioDetect5678,		kRegAudioDetect5678,		kRegAudioDetect5678,		0};
+static const unsigned gAudioDetectGroup []		= { 0,							1,							0,							1,
+													0,							1,							2,							3,							0};
+static const ULWord gSDIIn3GModeMask []			= { kRegMaskSDIIn3GbpsMode,		kRegMaskSDIIn23GbpsMode,	kRegMaskSDIIn33GbpsMode,	kRegMaskSDIIn43GbpsMode,
+													kRegMaskSDIIn53GbpsMode,	kRegMaskSDIIn63GbpsMode,	kRegMaskSDIIn73GbpsMode,	kRegMaskSDIIn83GbpsMode,	0};
+static const ULWord gSDIIn3GbModeMask []		= { kRegMaskSDIIn3GbpsSMPTELevelBMode,	kRegMaskSDIIn23GbpsSMPTELevelBMode, kRegMaskSDIIn33GbpsSMPTELevelBMode, kRegMaskSDIIn43GbpsSMPTELevelBMode,
+													kRegMaskSDIIn53GbpsSMPTELevelBMode, kRegMaskSDIIn63GbpsSMPTELevelBMode, kRegMaskSDIIn73GbpsSMPTELevelBMode, kRegMaskSDIIn83GbpsSMPTELevelBMode, 0};
+static const ULWord gSDIIn6GModeMask []			= { kRegMaskSDIIn16GbpsMode,	kRegMaskSDIIn26GbpsMode,	kRegMaskSDIIn36GbpsMode,	kRegMaskSDIIn46GbpsMode,
+													kRegMaskSDIIn56GbpsMode,	kRegMaskSDIIn66GbpsMode,	kRegMaskSDIIn76GbpsMode,	kRegMaskSDIIn86GbpsMode,	0};
+static const ULWord gSDIIn12GModeMask []		= { kRegMaskSDIIn112GbpsMode,	kRegMaskSDIIn212GbpsMode,	kRegMaskSDIIn312GbpsMode,	kRegMaskSDIIn412GbpsMode,
+													kRegMaskSDIIn512GbpsMode,	kRegMaskSDIIn612GbpsMode,	kRegMaskSDIIn712GbpsMode,	ULWord(kRegMaskSDIIn812GbpsMode),	0};
+static const ULWord gSDIInVPIDAValidMask []		= { kRegMaskSDIInVPIDLinkAValid,	kRegMaskSDIIn2VPIDLinkAValid,	kRegMaskSDIIn3VPIDLinkAValid,	kRegMaskSDIIn4VPIDLinkAValid,
+													kRegMaskSDIIn5VPIDLinkAValid,	kRegMaskSDIIn6VPIDLinkAValid,	kRegMaskSDIIn7VPIDLinkAValid,	kRegMaskSDIIn8VPIDLinkAValid,	0};
+static const ULWord gSDIInVPIDBValidMask []		= { kRegMaskSDIInVPIDLinkBValid,	kRegMaskSDIIn2VPIDLinkBValid,	kRegMaskSDIIn3VPIDLinkBValid,	kRegMaskSDIIn4VPIDLinkBValid,
+													kRegMaskSDIIn5VPIDLinkBValid,	kRegMaskSDIIn6VPIDLinkBValid,	kRegMaskSDIIn7VPIDLinkBValid,	kRegMaskSDIIn8VPIDLinkBValid,	0};
+
+static const ULWord gHDMIInStatusRegNum []		= { kRegHDMIInputStatus1,		kRegHDMIInputStatus2,		kRegHDMIInputStatus3,		kRegHDMIInputStatus4,		0};
+
+static inline ULWord HDMIInputStatusRegNum (const NTV2Channel inChannel, const ULWord inNumHDMIInputs)
+{	//	Same as CNTV2Card::GetHDMIInputStatusRegNum
+	if (inChannel >= NTV2Channel(inNumHDMIInputs))
+		return 0;
+	return inNumHDMIInputs == 1 ? ULWord(kRegHDMIInputStatus) : gHDMIInStatusRegNum[inChannel];
+}
+
+static inline ULWord RegValue (const NTV2RegisterValueMap & inRegs, const ULWord inRegNum)
+{
+	NTV2RegValueMapConstIter it(inRegs.find(inRegNum));
+	return it != inRegs.end() ? it->second : 0;
+}
+
+static inline ULWord RegField (const ULWord inValue, const ULWord inMask)
+{
+	if (!inMask)
+		return 0;
+	ULWord shift(0);
+	while (!(inMask & BIT(shift)))
+		shift++;
+	return (inValue & inMask) >> shift;
+}
+
+
+NTV2InputSignalState::NTV2InputSignalState (const NTV2InputSource inInputSource)
+	:	fInputSource	(inInputSource),
+		fVideoFormat	(NTV2_FORMAT_UNKNOWN),
+		fFrameRate		(NTV2_FRAMERATE_UNKNOWN),
+		fFrameGeometry	(NTV2_FG_INVALID),
+		fIsProgressive	(false),
+		fIs3G			(false),
+		fIs3Gb			(false),
+		fIs6G			(false),
+		fIs12G			(false),
+		fIsLocked		(false),
+		fVPIDValidA		(false),
+		fVPIDValidB		(false),
+		fVPIDA			(0),
+		fVPIDB			(0),
+		fXferChars		(NTV2_VPID_TC_Unspecified),
+		fTRSError		(false),
+		fCRCTallyA		(0),
+		fCRCTallyB		(0),
+		fUnlockTally	(0),
+		fAudioPairsMask	(0),
+		fHDMIStatus		(0)
+{
+}
+
+ULWord NTV2InputSignalState::Compare (const NTV2InputSignalState & inRHS) const
+{
+	ULWord result(NTV2_SIGNAL_CHANGED_NONE);
+	if (fVideoFormat != inRHS.fVideoFormat  ||  fFrameRate != inRHS.fFrameRate  ||  fFrameGeometry != inRHS.fFrameGeometry
+		||  fIsProgressive != inRHS.fIsProgressive  ||  fIs3G != inRHS.fIs3G  ||  fIs3Gb != inRHS.fIs3Gb
+		||  fIs6G != inRHS.fIs6G  ||  fIs12G != inRHS.fIs12G)
+			result |= NTV2_SIGNAL_CHANGED_FORMAT;
+	if (fIsLocked != inRHS.fIsLocked)
+		result |= NTV2_SIGNAL_CHANGED_LOCK;
+	if (fVPIDValidA != inRHS.fVPIDValidA  ||  fVPIDValidB != inRHS.fVPIDValidB  ||  fVPIDA != inRHS.fVPIDA
+		||  fVPIDB != inRHS.fVPIDB  ||  fXferChars != inRHS.fXferChars)
+			result |= NTV2_SIGNAL_CHANGED_VPID;
+	if (fTRSError != inRHS.fTRSError  ||  fCRCTallyA != inRHS.fCRCTallyA  ||  fCRCTallyB != inRHS.fCRCTallyB
+		||  fUnlockTally != inRHS.fUnlockTally)
+			result |= NTV2_SIGNAL_CHANGED_ERRORS;
+	if (fAudioPairsMask != inRHS.fAudioPairsMask)
+		result |= NTV2_SIGNAL_CHANGED_AUDIO;
+	if (fHDMIStatus != inRHS.fHDMIStatus)
+		result |= NTV2_SIGNAL_CHANGED_HDMI;
+	return result;
+}
+
+ostream & NTV2InputSignalState::Print (ostream & oss) const
+{
+	oss << ::NTV2InputSourceToString(fInputSource, true) << ": " << (fIsLocked ? "locked" : "unlocked")
+		<< " '" << ::NTV2VideoFormatToString(fVideoFormat, true) << "'";
+	if (NTV2_INPUT_SOURCE_IS_SDI(fInputSource))
+	{
+		oss << (fIs12G ? " 12G" : (fIs6G ? " 6G" : (fIs3G ? (fIs3Gb ? " 3Gb" : " 3Ga") : "")));
+		if (fVPIDValidA)
+			oss << " VPIDA=" << xHEX0N(fVPIDA,8);
+		if (fVPIDValidB)
+			oss << " VPIDB=" << xHEX0N(fVPIDB,8);
+		if (fTRSError)
+			oss << " TRSErr";
+		oss << " CRC=" << DEC(fCRCTallyA) << "/" << DEC(fCRCTallyB) << " unlocks=" << DEC(fUnlockTally)
+			<< " audPairs=" << xHEX0N(fAudioPairsMask,4);
+	}
+	else if (NTV2_INPUT_SOURCE_IS_HDMI(fInputSource))
+		oss << " status=" << xHEX0N(fHDMIStatus,8);
+	return oss;
+}
+
+
+CNTV2SignalMonitor::CNTV2SignalMonitor (CNTV2Card & inDevice)
+	:	mDevice			(inDevice),
+		mSources		(),
+		mRegNums		(),
+		mStates			(),
+		mSubscribers	(),
+		mLock			(),
+		mThread			(),
+		mVBIChannel		(NTV2_CHANNEL1),
+		mUpdateCount	(0),
+		mHDMIVersion	(0),
+		mCanDoErrChks	(false),
+		mIsLHi			(false),
+		mCanDo3GIn		(),
+		mCanDo12GIn		(),
+		mCanDo292In		(),
+		mQuit			(false)
+{
+}
+
+CNTV2SignalMonitor::~CNTV2SignalMonitor ()
+{
+	Stop();
+}
+
+bool CNTV2SignalMonitor::SetInputSources (const NTV2InputSourceSet & inInputSources)
+{
+	if (IsRunning())
+		{SMFAIL("Can't change inputs while running");  return false;}
+	if (!mDevice.IsOpen())
+		{SMFAIL("Device not open");  return false;}
+	NTV2InputSourceSet sources(inInputSources);
+	if (sources.empty())
+	{	NTV2InputSourceSet hdmiSources;
+		::NTV2DeviceGetSupportedInputSources(mDevice.GetDeviceID(), sources, NTV2_IOKINDS_SDI);
+		::NTV2DeviceGetSupportedInputSources(mDevice.GetDeviceID(), hdmiSources, NTV2_IOKINDS_HDMI);
+		sources += hdmiSources;
+	}
+	for (NTV2InputSourceSetConstIter it(sources.begin());  it != sources.end();  ++it)
+		if (!NTV2_INPUT_SOURCE_IS_SDI(*it)  &&  !NTV2_INPUT_SOURCE_IS_HDMI(*it))
+			{SMFAIL("'" << ::NTV2InputSourceToString(*it) << "' not SDI or HDMI");  return false;}
+	AJAAutoLock lock(&mLock);
+	mSources = sources;
+	mStates.clear();
+	mRegNums.clear();
+	return PrepareRegisters();
+}
+
+bool CNTV2SignalMonitor::PrepareRegisters (void)
+{	//	Caller must hold mLock
+	const ULWordSet wgtIDs (mDevice.GetSupportedItems(kNTV2EnumsID_WidgetID));
+	mHDMIVersion = mDevice.GetNumSupported(kDeviceGetHDMIVersion);
+	mCanDoErrChks = mDevice.IsSupported(kDeviceCanDoSDIErrorChecks);
+	mIsLHi = mDevice.GetDeviceID() == DEVICE_ID_KONALHI  ||  mDevice.GetDeviceID() == DEVICE_ID_KONALHIDVI;
+	mCanDo3GIn.assign(NTV2_MAX_NUM_CHANNELS, false);
+	mCanDo12GIn.assign(NTV2_MAX_NUM_CHANNELS, false);
+	mCanDo292In.assign(NTV2_MAX_NUM_CHANNELS, false);
+	mRegNums.clear();
+
+	for (NTV2InputSourceSetConstIter it(mSources.begin());  it != mSources.end();  ++it)
+	{
+		const NTV2Channel ch (::NTV2InputSourceToChannel(*it));
+		if (!NTV2_IS_VALID_CHANNEL(ch))
+			continue;
+		if (NTV2_INPUT_SOURCE_IS_SDI(*it))
+		{
+			mCanDo292In[ch] = wgtIDs.find(CNTV2SignalRouter::WidgetIDFromTypeAndChannel(NTV2WidgetType_SDIIn, ch)) != wgtIDs.end();
+			mCanDo3GIn[ch] = wgtIDs.find(CNTV2SignalRouter::WidgetIDFromTypeAndChannel(NTV2WidgetType_SDIIn3G, ch)) != wgtIDs.end();
+			mCanDo12GIn[ch] = wgtIDs.find(CNTV2SignalRouter::WidgetIDFromTypeAndChannel(NTV2WidgetType_SDIIn12G, ch)) != wgtIDs.end();
+			mRegNums.insert(gSDIInStatusRegNum[ch]);
+			mRegNums.insert(gSDIIn3GStatusRegNum[ch]);
+			mRegNums.insert(gSDIInVPIDARegNum[ch]);
+			mRegNums.insert(gSDIInVPIDBRegNum[ch]);
+			mRegNums.insert(gAudioDetectRegNum[ch]);
+			if (mCanDoErrChks)
+			{
+				mRegNums.insert(gRXSDIStatusRegNum[ch]);
+				mRegNums.insert(gRXSDICRCErrorRegNum[ch]);
+			}
+			if (mIsLHi)
+				mRegNums.insert(gSDIIn3GStatusRegNum[NTV2_CHANNEL1]);
+		}
+		else if (NTV2_INPUT_SOURCE_IS_HDMI(*it))
+		{
+			const ULWord regNum (HDMIInputStatusRegNum(ch, mDevice.GetNumSupported(kDeviceGetNumHDMIVideoInputs)));
+			if (regNum)
+				mRegNums.insert(regNum);
+			else
+				SMWARN("No HDMI status register for '" << ::NTV2InputSourceToString(*it) << "'");
+		}
+	}
+	SMDBG(DEC(mSources.size()) << " input(s) " << mSources << " need " << DEC(mRegNums.size()) << " register(s)");
+	return true;
+}
+
+bool CNTV2SignalMonitor::Start (const NTV2Channel inVBIChannel)
+{
+	if (IsRunning())
+		return true;	//	Already running
+	if (!NTV2_IS_VALID_CHANNEL(inVBIChannel))
+		{SMFAIL("Bad VBI channel " << DEC(inVBIChannel));  return false;}
+	if (mSources.empty()  &&  !SetInputSources())
+		return false;
+	if (mSources.empty())
+		{SMFAIL("No inputs to monitor");  return false;}
+	mVBIChannel = inVBIChannel;
+	mQuit.Clear();
+	if (!mDevice.SubscribeOutputVerticalEvent(mVBIChannel))
+		SMWARN("SubscribeOutputVerticalEvent failed for Ch" << DEC(mVBIChannel+1));
+	mThread.Attach(MonitorThreadStatic, this);
+	mThread.SetPriority(AJA_ThreadPriority_High);
+	if (AJA_FAILURE(mThread.Start()))
+		{SMFAIL("Failed to start monitor thread");  return false;}
+	SMINFO("Started, monitoring " << mSources << " using " << DEC(mRegNums.size()) << " register(s) per VBI");
+	return true;
+}
+
+void CNTV2SignalMonitor::Stop (void)
+{
+	if (!IsRunning())
+		return;
+	mQuit.Set();
+	mThread.Stop();
+	mDevice.UnsubscribeOutputVerticalEvent(mVBIChannel);
+	SMINFO("Stopped after " << DEC(mUpdateCount) << " update(s)");
+}
+
+bool CNTV2SignalMonitor::IsRunning (void) const
+{
+	return const_cast<AJAThread&>(mThread).Active();
+}
+
+bool CNTV2SignalMonitor::Update (void)
+{
+	NTV2RegisterReads regReads;
+	{
+		AJAAutoLock lock(&mLock);
+		if (mSources.empty())
+			return false;	//	Nothing to monitor -- SetInputSources not called
+		regReads.reserve(mRegNums.size());
+		for (NTV2RegNumSetConstIter it(mRegNums.begin());  it != mRegNums.end();  ++it)
+			regReads.push_back(NTV2RegInfo(*it));
+	}
+
+	//	One batched read for all inputs...
+	if (!mDevice.ReadRegisters(regReads))
+		{SMWARN("ReadRegisters failed for " << DEC(regReads.size()) << " register(s)");  return false;}
+	NTV2RegisterValueMap regValues;
+	for (NTV2RegisterReadsConstIter it(regReads.begin());  it != regReads.end();  ++it)
+		regValues[it->registerNumber] = it->registerValue;
+
+	//	Decode, compare, and remember...
+	typedef struct {NTV2InputSignalState fOld, fNew;  ULWord fFlags;}	Change;
+	vector<Change> changes;
+	Subscribers subscribers;
+	{
+		AJAAutoLock lock(&mLock);
+		for (NTV2InputSourceSetConstIter it(mSources.begin());  it != mSources.end();  ++it)
+		{
+			NTV2InputSignalState newState(*it);
+			if (NTV2_INPUT_SOURCE_IS_SDI(*it))
+				DecodeSDI(*it, regValues, newState);
+			else
+				DecodeHDMI(*it, regValues, newState);
+			NTV2InputSignalStates::iterator pOld(mStates.find(*it));
+			const NTV2InputSignalState oldState (pOld != mStates.end() ? pOld->second : NTV2InputSignalState(*it));
+			const ULWord changeFlags (newState.Compare(oldState));
+			if (changeFlags)
+			{
+				Change chg;  chg.fOld = oldState;  chg.fNew = newState;  chg.fFlags = changeFlags;
+				changes.push_back(chg);
+				SMDBG(newState << " changed " << xHEX0N(changeFlags,2));
+			}
+			mStates[*it] = newState;
+		}
+		mUpdateCount++;
+		if (!changes.empty())
+			subscribers = mSubscribers;
+	}
+
+	//	Notify subscribers outside of my lock so they can call back into me...
+	for (size_t chgNdx(0);  chgNdx < changes.size();  chgNdx++)
+		for (size_t subNdx(0);  subNdx < subscribers.size();  subNdx++)
+			(*subscribers[subNdx].first)(subscribers[subNdx].second, changes[chgNdx].fOld, changes[chgNdx].fNew, changes[chgNdx].fFlags);
+	return true;
+}	//	Update
+
+void CNTV2SignalMonitor::DecodeSDI (const NTV2InputSource inSrc, const NTV2RegisterValueMap & inRegs, NTV2InputSignalState & outState) const
+{	//	Mirrors CNTV2Card::GetSDIInputVideoFormat, but using register values that were read in one batch
+	const NTV2Channel	ch			(::NTV2InputSourceToChannel(inSrc));
+	const bool			isOdd		(ch & 1);
+	const ULWord		statusVal	(RegValue(inRegs, gSDIInStatusRegNum[ch]));
+	const ULWord		status3GVal	(RegValue(inRegs, gSDIIn3GStatusRegNum[ch]));
+
+	//	Rate, geometry & scan...
+	const ULWord rateLo (RegField(statusVal, isOdd ? kRegMaskInput2FrameRate : kRegMaskInput1FrameRate));
+	const ULWord rateHi (RegField(statusVal, isOdd ? kRegMaskInput2FrameRateHigh : kRegMaskInput1FrameRateHigh));
+	const NTV2FrameRate rate (NTV2FrameRate(((rateHi << 3) & BIT_3) | rateLo));
+	outState.fFrameRate = NTV2_IS_VALID_NTV2FrameRate(rate) ? rate : NTV2_FRAMERATE_UNKNOWN;
+	if (outState.fFrameRate != NTV2_FRAMERATE_UNKNOWN)
+	{
+		const ULWord geoLo (RegField(statusVal, isOdd ? kRegMaskInput2Geometry : kRegMaskInput1Geometry));
+		const ULWord geoHi (RegField(statusVal, isOdd ? ULWord(kRegMaskInput2GeometryHigh) : kRegMaskInput1GeometryHigh));
+		const NTV2FrameGeometry geometry (NTV2FrameGeometry(((geoHi << 3) & BIT_3) | geoLo));
+		outState.fFrameGeometry = NTV2_IS_VALID_NTV2FrameGeometry(geometry) ? geometry : NTV2_FG_INVALID;
+		outState.fIsProgressive = RegField(statusVal, isOdd ? kRegMaskInput2Progressive : kRegMaskInput1Progressive) ? true : false;
+	}
+	outState.fIs3G = (status3GVal & gSDIIn3GModeMask[ch]) ? true : false;
+	outState.fIs3Gb = (status3GVal & gSDIIn3GbModeMask[ch]) ? true : false;
+	outState.fIs6G = (status3GVal & gSDIIn6GModeMask[ch]) ? true : false;
+	outState.fIs12G = (status3GVal & gSDIIn12GModeMask[ch]) ? true : false;
+
+	//	VPID...
+	outState.fVPIDValidA = (status3GVal & gSDIInVPIDAValidMask[ch]) ? true : false;
+	outState.fVPIDValidB = outState.fVPIDValidA  &&  (status3GVal & gSDIInVPIDBValidMask[ch]);
+	if (outState.fVPIDValidA)
+	{
+		const ULWord vpidA (RegValue(inRegs, gSDIInVPIDARegNum[ch]));
+		const ULWord vpidB (outState.fVPIDValidB ? RegValue(inRegs, gSDIInVPIDBRegNum[ch]) : 0);
+		outState.fVPIDA = mIsLHi ? vpidA : NTV2EndianSwap32(vpidA);
+		outState.fVPIDB = mIsLHi ? vpidB : NTV2EndianSwap32(vpidB);
+	}
+	const CNTV2VPID inputVPID (outState.fVPIDA);
+	const bool isValidVPID (outState.fVPIDValidA  &&  inputVPID.IsValid());
+	if (isValidVPID)
+		outState.fXferChars = inputVPID.GetTransferCharacteristics();
+
+	//	Video format...
+	if (outState.fFrameRate != NTV2_FRAMERATE_UNKNOWN)
+	{
+		const UByte geometry (UByte(outState.fFrameGeometry == NTV2_FG_INVALID ? 0 : outState.fFrameGeometry));
+		const bool isProgressivePic (isValidVPID ? inputVPID.GetProgressivePicture() : false);
+		const bool isProgressiveTrans (isValidVPID ? inputVPID.GetProgressiveTransport() : outState.fIsProgressive);
+		if (mCanDo3GIn[ch] || mCanDo12GIn[ch])
+		{
+			NTV2VideoFormat format (isValidVPID ? inputVPID.GetVideoFormat()
+												: CNTV2Card::GetNTV2VideoFormat(outState.fFrameRate, geometry, isProgressiveTrans, outState.fIs3G, isProgressivePic));
+			if (isValidVPID  &&  format == NTV2_FORMAT_UNKNOWN)	//	Something might be incorrect in VPID
+				format = CNTV2Card::GetNTV2VideoFormat(outState.fFrameRate, geometry, outState.fIsProgressive, outState.fIs3G, false);
+			if (mCanDo12GIn[ch]  &&  format != NTV2_FORMAT_UNKNOWN  &&  !isValidVPID)
+			{
+				if (outState.fIs6G || outState.fIs12G)
+					format = ::GetQuadSizedVideoFormat(format, !mDevice.IsSupported(kDeviceCanDo12gRouting));
+				if (inputVPID.IsStandardMultiLink4320())
+					format = ::GetQuadSizedVideoFormat(format, true);
+			}
+			outState.fVideoFormat = format;
+		}
+		else if (mCanDo292In[ch])
+		{
+			bool is3G (false);
+			if (mIsLHi)
+				is3G = (RegValue(inRegs, gSDIIn3GStatusRegNum[NTV2_CHANNEL1]) & gSDIIn3GModeMask[NTV2_CHANNEL1]) ? true : false;
+			outState.fVideoFormat = CNTV2Card::GetNTV2VideoFormat(outState.fFrameRate, geometry, isProgressiveTrans, is3G, isProgressivePic);
+		}
+	}
+	else
+		outState.fFrameGeometry = NTV2_FG_INVALID;
+
+	//	Lock & errors...
+	if (mCanDoErrChks)
+	{
+		const ULWord rxStatus (RegValue(inRegs, gRXSDIStatusRegNum[ch]));
+		const ULWord crcCounts (RegValue(inRegs, gRXSDICRCErrorRegNum[ch]));
+		outState.fIsLocked = (rxStatus & kRegMaskSDIInLocked) ? true : false;
+		outState.fTRSError = (rxStatus & kRegMaskSDIInTRSError) ? true : false;
+		outState.fUnlockTally = (rxStatus & kRegMaskSDIInUnlockCount) >> kRegShiftSDIInUnlockCount;
+		outState.fCRCTallyA = (crcCounts & kRegMaskSDIInCRCErrorCountA) >> kRegShiftSDIInCRCErrorCountA;
+		outState.fCRCTallyB = (crcCounts & kRegMaskSDIInCRCErrorCountB) >> kRegShiftSDIInCRCErrorCountB;
+	}
+	else
+		outState.fIsLocked = outState.fFrameRate != NTV2_FRAMERATE_UNKNOWN;
+
+	//	Embedded audio presence (same as CNTV2Card::GetDetectedAudioChannelPairs)...
+	const ULWord detectBits (RegValue(inRegs, gAudioDetectRegNum[ch]));
+	outState.fAudioPairsMask = (detectBits >> (gAudioDetectGroup[ch] * 8)) & 0xFF;
+}	//	DecodeSDI
+
+void CNTV2SignalMonitor::DecodeHDMI (const NTV2InputSource inSrc, const NTV2RegisterValueMap & inRegs, NTV2InputSignalState & outState) const
+{	//	Mirrors CNTV2Card::GetHDMIInputVideoFormat, but using register values that were read in one batch
+	const NTV2Channel ch (::NTV2InputSourceToChannel(inSrc));
+	const ULWord regNum (HDMIInputStatusRegNum(ch, mDevice.GetNumSupported(kDeviceGetNumHDMIVideoInputs)));
+	if (!regNum)
+		return;
+	const ULWord status (RegValue(inRegs, regNum));
+	outState.fHDMIStatus = status;
+	outState.fIsLocked = (status & kRegMaskInputStatusLock) ? true : false;
+	if (!outState.fIsLocked)
+		return;
+	const NTV2FrameRate rate (NTV2FrameRate((status & kRegMaskInputStatusFPS) >> kRegShiftInputStatusFPS));
+	outState.fFrameRate = NTV2_IS_VALID_NTV2FrameRate(rate) ? rate : NTV2_FRAMERATE_UNKNOWN;
+	if (mHDMIVersion == 1)
+	{
+		const NTV2Standard standard (NTV2Standard((status & kRegMaskInputStatusStd) >> kRegShiftInputStatusStd));
+		if (standard == 0x5)	//	NTV2_STANDARD_2K (2048x1556psf) in HDMI is really SXGA!!
+			outState.fVideoFormat = NTV2_FORMAT_1080p_6000_A;
+		else
+			outState.fVideoFormat = CNTV2Card::GetNTV2VideoFormat(rate, standard, false, 0, false);
+	}
+	else if (mHDMIVersion > 1)
+	{
+		const NTV2Standard standard (NTV2Standard((status & kRegMaskHDMIInV2VideoStd) >> kRegShiftHDMIInV2VideoStd));
+		const UByte geometry (UByte(standard == NTV2_STANDARD_2Kx1080i || standard == NTV2_STANDARD_2Kx1080p ? 8 : 0));
+		outState.fVideoFormat = CNTV2Card::GetNTV2VideoFormat(rate, standard, false, geometry, false, mHDMIVersion != 5);
+	}
+}	//	DecodeHDMI
+
+bool CNTV2SignalMonitor::AddCallback (NTV2SignalChangeCallback pInCallback, void * pInUserData)
+{
+	if (!pInCallback)
+		return false;
+	AJAAutoLock lock(&mLock);
+	const Subscriber sub(pInCallback, pInUserData);
+	if (find(mSubscribers.begin(), mSubscribers.end(), sub) == mSubscribers.end())
+		mSubscribers.push_back(sub);
+	return true;
+}
+
+bool CNTV2SignalMonitor::RemoveCallback (NTV2SignalChangeCallback pInCallback, void * pInUserData)
+{
+	AJAAutoLock lock(&mLock);
+	Subscribers::iterator it (find(mSubscribers.begin(), mSubscribers.end(), Subscriber(pInCallback, pInUserData)));
+	if (it == mSubscribers.end())
+		return false;
+	mSubscribers.erase(it);
+	return true;
+}
+
+bool CNTV2SignalMonitor::GetState (const NTV2InputSource inInputSource, NTV2InputSignalState & outState) const
+{
+	AJAAutoLock lock(&mLock);
+	NTV2InputSignalStatesConstIter it(mStates.find(inInputSource));
+	if (it == mStates.end())
+		return false;
+	outState = it->second;
+	return true;
+}
+
+NTV2InputSignalStates CNTV2SignalMonitor::GetStates (void) const
+{
+	AJAAutoLock lock(&mLock);
+	return mStates;
+}
+
+NTV2InputSourceSet CNTV2SignalMonitor::GetInputSources (void) const
+{
+	AJAAutoLock lock(&mLock);
+	return mSources;
+}
+
+void CNTV2SignalMonitor::MonitorThreadStatic (AJAThread * pThread, void * pContext)	//	static
+{	(void) pThread;
+	CNTV2SignalMonitor * pMonitor (reinterpret_cast<CNTV2SignalMonitor*>(pContext));
+	if (pMonitor)
+		pMonitor->MonitorThread();
+}
+
+void CNTV2SignalMonitor::MonitorThread (void)
+{
+	const INTERRUPT_ENUMS intType (::NTV2ChannelToOutputInterrupt(mVBIChannel));
+	while (!mQuit.IsSet()  &&  !mThread.Terminate())
+	{
+		if (!mDevice.WaitForInterrupt(intType, 100))
+			AJATime::Sleep(16);	//	No VBIs? Poll at roughly 60Hz
+		if (!mQuit.IsSet())
+			Update();
+	}
+}
@@ -14,7 +14,12 @@
 #include "ajabase/common/common.h"
 #include "ajabase/persistence/persistence.h"
 #include "ajabase/system/info.h"
+#include "ajabase/system/event.h"
+#include "ajabase/system/lock.h"
+#include "ajabase/system/thread.h"
+#include "ajabase/system/workerpool.h"
 #include <algorithm>
+#include <deque>
 #include <sstream>
 #include <vector>
 #include <iterator>
@@ -583,19 +588,26 @@ void CNTV2SupportLogger::FetchInfoLog (ostringstream & oss) const
 }	//	FetchInfoLog
 
 
+static NTV2RegNumSet getDeviceRegisters (CNTV2Card & device, const NTV2DeviceID inDeviceID)
+{
+	NTV2RegNumSet	deviceRegs	(CNTV2RegisterExpert::GetRegistersForDevice (inDeviceID));
+
+	//	Dang, GetRegistersForDevice doesn't/can't read kRegCanDoRegister, so add the CanConnectROM regs here...
+	if (device.IsSupported(kDeviceHasXptConnectROM))
+		for (ULWord regNum(kRegFirstValidXptROMRegister);  regNum < ULWord(kRegInvalidValidXptROMRegister);	 regNum++)
+			deviceRegs.insert(regNum);
+	return deviceRegs;
+}
+
+
 void CNTV2SupportLogger::FetchRegisterLog (ostringstream & oss) const
 {
 	NTV2RegisterReads	regs;
 	const NTV2DeviceID	deviceID	(mDevice.GetDeviceID());
-	NTV2RegNumSet		deviceRegs	(CNTV2RegisterExpert::GetRegistersForDevice (deviceID));
+	const NTV2RegNumSet deviceRegs	(getDeviceRegisters (mDevice, deviceID));
 	const NTV2RegNumSet virtualRegs (CNTV2RegisterExpert::GetRegistersForClass (kRegClass_Virtual));
 	static const string sDashes		(96, '-');
 
-	//	Dang, GetRegistersForDevice doesn't/can't read kRegCanDoRegister, so add the CanConnectROM regs here...
-	if (mDevice.IsSupported(kDeviceHasXptConnectROM))
-		for (ULWord regNum(kRegFirstValidXptROMRegister);  regNum < ULWord(kRegInvalidValidXptROMRegister);	 regNum++)
-			deviceRegs.insert(regNum);
-
 	oss << endl << deviceRegs.size() << " Device Registers " << sDashes << endl << endl;
 	regs = ::FromRegNumSet (deviceRegs);
 	if (!mDevice.ReadRegisters (regs))
@@ -1002,83 +1014,158 @@ const registerToLoadString registerToLoadStrings[] =
 	Enum2Str(kRegXptSelectGroup35)
 };
 
+//	Appends "<decimal regNum> 0x<hex value>\n" -- much faster than an ostringstream for many thousands of registers
+static void appendSnapshotLine (string & outText, const ULWord inRegNum, const ULWord inValue)
+{
+	static const char sHexDigits[] = "0123456789ABCDEF";
+	char	buffer[32];
+	char *	pEnd (buffer + sizeof(buffer));
+	char *	p (pEnd);
+	*--p = '\n';
+	for (int nibble(0);  nibble < 8;  nibble++)
+		*--p = sHexDigits[(inValue >> (4 * nibble)) & 0xF];
+	*--p = 'x';  *--p = '0';  *--p = ' ';
+	ULWord regNum (inRegNum);
+	do {*--p = char('0' + regNum % 10);  regNum /= 10;} while (regNum);
+	outText.append(p, size_t(pEnd - p));
+}
+
+//	One section of a register snapshot, read & formatted by fetchSnapshotSections (possibly on a worker thread)...
+typedef struct RegSnapshotSection
+{
+	string			fName;
+	NTV2RegNumSet	fRegNums;
+	string			fText;
+	bool			fReadOK;
+} RegSnapshotSection;
+
+typedef struct RegSnapshotJob
+{
+	CNTV2Card *				fpDevice;
+	RegSnapshotSection *	fpSections;
+} RegSnapshotJob;
+
+static void fetchSnapshotSections (void * pContext, uint32_t begin, uint32_t end)
+{
+	const RegSnapshotJob & job (*reinterpret_cast<const RegSnapshotJob*>(pContext));
+	for (uint32_t ndx(begin);  ndx < end;  ndx++)
+	{
+		RegSnapshotSection & section (job.fpSections[ndx]);
+		NTV2RegisterReads regs (::FromRegNumSet(section.fRegNums));
+		section.fReadOK = job.fpDevice->ReadRegisters(regs);
+		ostringstream oss;  oss << section.fName << ": " << regs.size() << endl;
+		section.fText = oss.str();
+		section.fText.reserve(section.fText.size() + regs.size() * 20);
+		for (NTV2RegisterReadsConstIter it(regs.begin());  it != regs.end();  ++it)
+			appendSnapshotLine(section.fText, it->registerNumber, it->registerValue);
+	}
+}
+
+bool CNTV2SupportLogger::WriteRegisterSnapshot (ostream & outStream) const
+{
+	if (!mDevice.IsOpen())
+		return false;
+
+	const NTV2DeviceID	deviceID (mDevice.GetDeviceID());
+	RegSnapshotSection	sections[2];
+	sections[0].fName = "Registers";
+	sections[0].fRegNums = getDeviceRegisters(mDevice, deviceID);
+	sections[1].fName = "VirtualRegisters";
+	sections[1].fRegNums = CNTV2RegisterExpert::GetRegistersForClass(kRegClass_Virtual);
+	sections[0].fReadOK = sections[1].fReadOK = false;
+
+	//	Fetch the sections concurrently -- unless the device is remote (its transport would serialize them anyway)...
+	RegSnapshotJob job;
+	job.fpDevice = &mDevice;
+	job.fpSections = sections;
+	if (mDevice.IsRemote()  ||  AJA_FAILURE(AJAWorkerPool::GetSharedPool().ParallelFor(2, fetchSnapshotSections, &job, 1)))
+		fetchSnapshotSections(&job, 0, 2);
+
+	string serialNumber;
+	mDevice.GetSerialNumberString(serialNumber);
+	vector<char> dateBufferUTC(128, 0);
+	time_t now = time(AJA_NULL);
+	struct tm *utcTimeinfo = gmtime(&now);
+	if (utcTimeinfo)
+		::strftime(&dateBufferUTC[0], dateBufferUTC.size(), "%Y-%m-%dT%H:%M:%SZ", utcTimeinfo);
+
+	ostringstream oss;
+	oss << NTV2_REGSNAPSHOT_MAGIC << " " << NTV2_REGSNAPSHOT_VERSION << endl
+		<< "Device: " << ::NTV2DeviceIDToString(deviceID) << endl
+		<< "DeviceID: " << xHEX0N(ULWord(deviceID),8) << endl
+		<< "Serial: " << serialNumber << endl
+		<< "Generated: " << &dateBufferUTC[0] << endl
+		<< "SDK: " << ::NTV2GetVersionString(true) << endl;
+	string snapshot (oss.str());
+	snapshot.reserve(snapshot.size() + sections[0].fText.size() + sections[1].fText.size() + 8);
+	snapshot.append(sections[0].fText);
+	snapshot.append(sections[1].fText);
+	snapshot.append("End\n");
+	outStream.write(snapshot.data(), streamsize(snapshot.size()));
+	return sections[0].fReadOK  &&	sections[1].fReadOK  &&	 outStream.good();
+}
+
 bool CNTV2SupportLogger::LoadFromLog (const string & inLogFilePath, const bool bForceLoad)
 {
-	ifstream fileInput;
-	fileInput.open(inLogFilePath.c_str());
-	string lineContents;
-	int i = 0, numLines = 0;
-	int size = sizeof(registerToLoadStrings)/sizeof(registerToLoadString);
-	string searchString;
-	bool isCompatible = false;
-
-	while(getline(fileInput, lineContents))
-		numLines++;
-	if(size > numLines)
+	ifstream fileInput (inLogFilePath.c_str());
+	if (!fileInput)
 		return false;
-	fileInput.clear();
-	fileInput.seekg(0, ios::beg);
-	while(getline(fileInput, lineContents) && i < size && !bForceLoad)
+
+	//	One pass over the file collects every register value it has, whether it's a snapshot or a support log...
+	const string			deviceLine	(string("Device: ") + ::NTV2DeviceIDToString(mDevice.GetDeviceID()));
+	bool					isCompatible(bForceLoad), isSnapshot(false), haveRegNum(false);
+	ULWord					regNum(0);
+	NTV2RegisterValueMap	logValues;
+	string					lineContents;
+	for (size_t lineNum(0);  getline(fileInput, lineContents);	lineNum++)
 	{
-		searchString = "Device: ";
-		searchString.append(NTV2DeviceIDToString(mDevice.GetDeviceID()));
-		if (lineContents.find(searchString, 0) != string::npos)
+		if (!isCompatible  &&  lineContents.find(deviceLine) != string::npos)
 		{
 			cout << NTV2DeviceIDToString(mDevice.GetDeviceID()) << " is compatible with the log." << endl;
 			isCompatible = true;
-			break;
 		}
-		else
+		if (lineNum == 0)
+			isSnapshot = lineContents.compare(0, ::strlen(NTV2_REGSNAPSHOT_MAGIC), NTV2_REGSNAPSHOT_MAGIC) == 0;
+		else if (isSnapshot)
+		{	//	"<regNum> 0x<value>"
+			if (lineContents.empty()  ||  !::isdigit(lineContents[0]))
+				continue;
+			char * pEnd (AJA_NULL);
+			regNum = ULWord(::strtoul(lineContents.c_str(), &pEnd, 10));
+			logValues[regNum] = ULWord(::strtoul(pEnd, AJA_NULL, 16));
+		}
+		else if (lineContents.compare(0, 17, "Register Number: ") == 0)
 		{
-			continue;
+			regNum = ULWord(::strtoul(lineContents.c_str() + 17, AJA_NULL, 10));
+			haveRegNum = true;
+		}
+		else if (haveRegNum  &&  lineContents.compare(0, 16, "Register Value: ") == 0)
+		{	//	"Register Value: <decimal> : 0x<hex>"
+			logValues[regNum] = ULWord(::strtoul(lineContents.c_str() + 16, AJA_NULL, 10));
+			haveRegNum = false;
 		}
 	}
 
-	if(!isCompatible)
+	if (!isCompatible)
 		return false;
+	if (logValues.empty())
+	{
+		cout << "The format of the log file is not compatible with this option." << endl;
+		return false;
+	}
 
-	while(i < size)
+	//	...then the registers we restore are written in one batch
+	NTV2RegisterWrites	regWrites;
+	const size_t		numLoadRegs (sizeof(registerToLoadStrings) / sizeof(registerToLoadString));
+	for (size_t ndx(0);  ndx < numLoadRegs;	ndx++)
 	{
-		getline(fileInput, lineContents);
-		if(fileInput.eof())
-		{
-			//Did not find the register reset stream to begin
-			fileInput.clear();
-			fileInput.seekg(0, ios::beg);
-			i++;
+		NTV2RegValueMapConstIter it (logValues.find(ULWord(registerToLoadStrings[ndx].registerNum)));
+		if (it == logValues.end())
 			continue;
-		}
-		searchString = "Register Name: ";
-		searchString.append(registerToLoadStrings[i].registerStr);
-		if (lineContents.find(searchString, 0) != string::npos)
-		{
-			getline(fileInput, lineContents);
-			getline(fileInput, lineContents);
-			searchString = "Register Value: ";
-			size_t start = lineContents.find(searchString);
-			if(start != string::npos)
-			{
-				size_t end = lineContents.find(" : ");
-				stringstream registerValueString(lineContents.substr(start + searchString.length(), end));
-				uint32_t registerValue = 0;
-				registerValueString >> registerValue;
-				cout << "Writing register: " << registerToLoadStrings[i].registerStr << " " << registerValue << endl;
-				mDevice.WriteRegister(registerToLoadStrings[i].registerNum, registerValue);
-			}
-			else
-			{
-				cout << "The format of the log file is not compatible with this option." << endl;
-				return false;
-			}
-		}
-		else
-		{
-			continue;
-		}
-		i++;
+		cout << "Writing register: " << registerToLoadStrings[ndx].registerStr << " " << it->second << endl;
+		regWrites.push_back(NTV2RegInfo(it->first, it->second));
 	}
-
-	return true;
+	return mDevice.WriteRegisters(regWrites);
 }
 
 string CNTV2SupportLogger::InventLogFilePathAndName (CNTV2Card & inDevice, const string inPrefix, const string inExtension)
@@ -1096,7 +1183,313 @@ string CNTV2SupportLogger::InventLogFilePathAndName (CNTV2Card & inDevice, const
 	return oss.str();
 }
 
-bool CNTV2SupportLogger::DumpDeviceSDRAM (CNTV2Card & inDevice, const string & inFilePath, ostream & msgStrm)
+bool NTV2EncodeSDRAMDumpFrame (const NTV2Buffer & inFrame, NTV2Buffer & outEncoded, NTV2SDRAMDumpFrameInfo & outInfo)
+{
+	static const size_t	kMinRunWords(4);	//	Shorter runs stay in the surrounding literal
+	outInfo.fEncoding = NTV2SDRAMDumpEncoding_Raw;
+	outInfo.fEncodedBytes = outInfo.fFillValue = outInfo.fReserved = 0;
+	if (inFrame.IsNULL()  ||  inFrame.GetByteCount() % sizeof(ULWord))
+		return false;
+	if (outEncoded.GetByteCount() < inFrame.GetByteCount())
+		return false;
+	const ULWord *	pSrc (inFrame);
+	ULWord *		pDst (outEncoded);
+	const size_t	numWords (inFrame.GetByteCount() / sizeof(ULWord));
+	outInfo.fEncodedBytes = inFrame.GetByteCount();
+
+	//	Constant frame?
+	size_t ndx(1);
+	while (ndx < numWords  &&  pSrc[ndx] == pSrc[0])
+		ndx++;
+	if (ndx == numWords)
+	{
+		outInfo.fEncoding = NTV2SDRAMDumpEncoding_Fill;
+		outInfo.fFillValue = pSrc[0];
+		outInfo.fEncodedBytes = 0;
+		return true;
+	}
+
+	//	Run-length encode, giving up as soon as it's no smaller than raw...
+	//	Each token is a header word, followed by either one word repeated (header bit 31 set) or a literal span.
+	const size_t maxOutWords (numWords - 1);
+	size_t outNdx(0), litStart(0);
+	ndx = 0;
+	while (ndx <= numWords)
+	{
+		size_t runEnd(ndx + 1);
+		if (ndx < numWords)
+		{
+			while (runEnd < numWords  &&  pSrc[runEnd] == pSrc[ndx])
+				runEnd++;
+			if (runEnd - ndx < kMinRunWords)
+				{ndx = runEnd;  continue;}
+		}
+		else
+			ndx = numWords;	//	Flush trailing literal
+		if (ndx > litStart)
+		{
+			const size_t litWords (ndx - litStart);
+			if (outNdx + 1 + litWords > maxOutWords)
+				return true;	//	Store raw
+			pDst[outNdx++] = ULWord(litWords);
+			::memcpy(pDst + outNdx, pSrc + litStart, litWords * sizeof(ULWord));
+			outNdx += litWords;
+		}
+		if (ndx == numWords)
+			break;
+		if (outNdx + 2 > maxOutWords)
+			return true;	//	Store raw
+		pDst[outNdx++] = 0x80000000 | ULWord(runEnd - ndx);
+		pDst[outNdx++] = pSrc[ndx];
+		ndx = litStart = runEnd;
+	}
+	outInfo.fEncoding = NTV2SDRAMDumpEncoding_RLE32;
+	outInfo.fEncodedBytes = ULWord(outNdx * sizeof(ULWord));
+	return true;
+}
+
+bool NTV2DecodeSDRAMDumpFrame (const NTV2SDRAMDumpFrameInfo & inInfo, const void * pInPayload, void * pOutFrame, const size_t inFrameBytes)
+{
+	if (!pOutFrame  ||  inFrameBytes % sizeof(ULWord))
+		return false;
+	ULWord *		pDst (reinterpret_cast<ULWord*>(pOutFrame));
+	const ULWord *	pSrc (reinterpret_cast<const ULWord*>(pInPayload));
+	const size_t	numWords (inFrameBytes / sizeof(ULWord)),  srcWords (inInfo.fEncodedBytes / sizeof(ULWord));
+	switch (inInfo.fEncoding)
+	{
+		case NTV2SDRAMDumpEncoding_Raw:
+			if (!pSrc  ||  inInfo.fEncodedBytes != inFrameBytes)
+				return false;
+			::memcpy(pDst, pSrc, inFrameBytes);
+			return true;
+
+		case NTV2SDRAMDumpEncoding_Fill:
+			if (inInfo.fFillValue)
+				std::fill(pDst, pDst + numWords, inInfo.fFillValue);
+			else
+				::memset(pDst, 0, inFrameBytes);
+			return true;
+
+		case NTV2SDRAMDumpEncoding_Missing:
+			::memset(pDst, 0, inFrameBytes);
+			return true;
+
+		case NTV2SDRAMDumpEncoding_RLE32:
+		{
+			if (!pSrc)
+				return false;
+			size_t srcNdx(0), dstNdx(0);
+			while (srcNdx < srcWords)
+			{
+				const ULWord hdr (pSrc[srcNdx++]);
+				const size_t count (hdr & 0x7FFFFFFF);
+				if (dstNdx + count > numWords)
+					return false;	//	Overrun
+				if (hdr & 0x80000000)
+				{
+					if (srcNdx >= srcWords)
+						return false;	//	Truncated
+					std::fill(pDst + dstNdx, pDst + dstNdx + count, pSrc[srcNdx++]);
+				}
+				else
+				{
+					if (srcNdx + count > srcWords)
+						return false;	//	Truncated
+					::memcpy(pDst + dstNdx, pSrc + srcNdx, count * sizeof(ULWord));
+					srcNdx += count;
+				}
+				dstNdx += count;
+			}
+			return dstNdx == numWords;
+		}
+	}
+	return false;
+}
+
+
+//	Overlaps device DMA reads (on the calling thread) with frame encoding and file writes (on a writer thread)...
+class SDRAMDumpWriter
+{
+	public:
+		static const size_t	kNumBuffers = 3;
+
+		SDRAMDumpWriter (ofstream & inOFS, const ULWord inFrameBytes, const ULWord inNumFrames, const bool inCompact)
+			:	mOFS			(inOFS),
+				mFrameBytes		(inFrameBytes),
+				mCompact		(inCompact),
+				mDone			(false),
+				mFilledEvent	(false),
+				mFreedEvent		(false),
+				mEncoded		(),
+				mIndex			(inCompact ? inNumFrames : 0),
+				mElided			(0),
+				mBytesWritten	(0)
+		{
+			for (size_t ndx(0);  ndx < kNumBuffers;  ndx++)
+				if (mBuffers[ndx].Allocate(inFrameBytes, true))
+					mFree.push_back(ndx);
+			if (mCompact)
+				mEncoded.Allocate(inFrameBytes);
+			for (size_t ndx(0);  ndx < mIndex.size();  ndx++)
+			{
+				NTV2SDRAMDumpFrameInfo & info (mIndex.at(ndx));
+				info.fOffset = info.fEncodedBytes = info.fFillValue = info.fReserved = 0;
+				info.fEncoding = NTV2SDRAMDumpEncoding_Missing;
+			}
+		}
+
+		bool Start (void)
+		{
+			if (mFree.size() != kNumBuffers  ||  (mCompact && !mEncoded))
+				return false;
+			if (mCompact  &&  !WriteHeader(0))
+				return false;
+			if (AJA_FAILURE(mThread.Attach(WriterThread, this)))
+				return false;
+			return AJA_SUCCESS(mThread.Start());
+		}
+
+		//	Blocks until a buffer is free, then answers with it
+		size_t	AcquireBuffer (void)
+		{
+			while (true)
+			{
+				{	AJAAutoLock tmp(&mLock);
+					if (!mFree.empty())
+					{	const size_t result(mFree.front());
+						mFree.pop_front();
+						return result;
+					}
+				}
+				mFreedEvent.WaitForSignal(20);
+			}
+		}
+		inline NTV2Buffer &	Buffer (const size_t inBufferNdx)	{return mBuffers[inBufferNdx];}
+
+		void	ReleaseBuffer (const size_t inBufferNdx)	//	Return it unused
+		{
+			AJAAutoLock tmp(&mLock);
+			mFree.push_back(inBufferNdx);
+		}
+
+		void	SubmitBuffer (const size_t inBufferNdx, const ULWord inFrameNdx)	//	Queue it for writing
+		{
+			{	AJAAutoLock tmp(&mLock);
+				mFilled.push_back(std::make_pair(inBufferNdx, inFrameNdx));
+			}
+			mFilledEvent.Signal();
+		}
+
+		//	Drains the queue, stops the writer thread, then (if compact) writes the index & final header
+		bool	Finish (void)
+		{
+			{	AJAAutoLock tmp(&mLock);
+				mDone = true;
+			}
+			mFilledEvent.Signal();
+			mThread.Stop();
+			if (!mCompact)
+				return mOFS.good();
+			const uint64_t indexOffset (uint64_t(mOFS.tellp()));
+			if (!mIndex.empty())
+				mOFS.write(reinterpret_cast<const char*>(&mIndex[0]), streamsize(mIndex.size() * sizeof(NTV2SDRAMDumpFrameInfo)));
+			mOFS.seekp(0, ios::beg);
+			return WriteHeader(indexOffset);
+		}
+
+		inline const NTV2ULWordVector &	GoodFrames (void) const		{return mGoodFrames;}
+		inline const NTV2ULWordVector &	BadWrites (void) const		{return mBadWrites;}
+		inline ULWord64					ElidedFrames (void) const	{return mElided;}
+		inline ULWord64					BytesWritten (void) const	{return mBytesWritten;}
+
+	private:
+		bool	WriteHeader (const uint64_t inIndexOffset)
+		{
+			NTV2SDRAMDumpHeader hdr;
+			::memset(&hdr, 0, sizeof(hdr));
+			::memcpy(hdr.fMagic, NTV2_SDRAMDUMP_MAGIC, sizeof(hdr.fMagic));
+			hdr.fVersion = NTV2_SDRAMDUMP_VERSION;
+			hdr.fFrameBytes = mFrameBytes;
+			hdr.fNumFrames = ULWord(mIndex.size());
+			hdr.fIndexOffset = inIndexOffset;
+			return mOFS.write(reinterpret_cast<const char*>(&hdr), sizeof(hdr)).good();
+		}
+
+		bool	WriteFrame (const NTV2Buffer & inFrame, const ULWord inFrameNdx)
+		{
+			if (!mCompact)
+			{
+				mBytesWritten += inFrame.GetByteCount();
+				return mOFS.write(inFrame, streamsize(inFrame.GetByteCount())).good();
+			}
+			if (inFrameNdx >= mIndex.size())
+				return false;
+			NTV2SDRAMDumpFrameInfo & info (mIndex.at(inFrameNdx));
+			if (!::NTV2EncodeSDRAMDumpFrame(inFrame, mEncoded, info))
+				return false;
+			info.fOffset = uint64_t(mOFS.tellp());
+			if (!info.fEncodedBytes)
+				{mElided++;  return true;}
+			const NTV2Buffer & payload (info.fEncoding == NTV2SDRAMDumpEncoding_Raw ? inFrame : mEncoded);
+			mBytesWritten += info.fEncodedBytes;
+			if (mOFS.write(payload, streamsize(info.fEncodedBytes)).good())
+				return true;
+			info.fEncoding = NTV2SDRAMDumpEncoding_Missing;
+			info.fEncodedBytes = 0;
+			return false;
+		}
+
+		static void	WriterThread (AJAThread * pThread, void * pContext)
+		{	(void) pThread;
+			SDRAMDumpWriter * pWriter (reinterpret_cast<SDRAMDumpWriter*>(pContext));
+			if (pWriter)
+				pWriter->WriterLoop();
+		}
+
+		void	WriterLoop (void)
+		{
+			while (true)
+			{
+				std::pair<size_t,ULWord> job;
+				{	AJAAutoLock tmp(&mLock);
+					if (mFilled.empty()  &&  mDone)
+						break;
+					if (!mFilled.empty())
+						{job = mFilled.front();  mFilled.pop_front();}
+					else
+						job.first = kNumBuffers;
+				}
+				if (job.first >= kNumBuffers)
+					{mFilledEvent.WaitForSignal(20);  continue;}
+				if (WriteFrame(mBuffers[job.first], job.second))
+					mGoodFrames.push_back(job.second);
+				else
+					mBadWrites.push_back(job.second);
+				ReleaseBuffer(job.first);
+				mFreedEvent.Signal();
+			}
+		}
+
+	private:
+		ofstream &									mOFS;
+		const ULWord								mFrameBytes;
+		const bool									mCompact;
+		AJAThread									mThread;
+		AJALock										mLock;			//	Guards mFree, mFilled & mDone
+		bool										mDone;
+		AJAEvent									mFilledEvent;
+		AJAEvent									mFreedEvent;
+		NTV2Buffer									mBuffers[kNumBuffers];
+		std::deque<size_t>							mFree;
+		std::deque<std::pair<size_t,ULWord> >		mFilled;
+		NTV2Buffer									mEncoded;		//	Writer thread only
+		std::vector<NTV2SDRAMDumpFrameInfo>			mIndex;			//	Writer thread only
+		NTV2ULWordVector							mGoodFrames, mBadWrites;
+		ULWord64									mElided, mBytesWritten;
+};	//	SDRAMDumpWriter
+
+
+bool CNTV2SupportLogger::DumpDeviceSDRAM (CNTV2Card & inDevice, const string & inFilePath, ostream & msgStrm, const bool inCompact)
 {
 	if (!inDevice.IsOpen())
 		return false;
@@ -1106,31 +1499,40 @@ bool CNTV2SupportLogger::DumpDeviceSDRAM (CNTV2Card & inDevice, const string & i
 	const ULWord maxBytes(::NTV2DeviceGetActiveMemorySize(inDevice.GetDeviceID()));
 	inDevice.GetFrameBufferSize(NTV2_CHANNEL1, frmsz);
 	const ULWord byteCount(::NTV2FramesizeToByteCount(frmsz)), megs(byteCount/1024/1024), numFrames(maxBytes / byteCount);
-	NTV2Buffer buffer(byteCount);
-	NTV2ULWordVector goodFrames, badDMAs, badWrites;
+	NTV2ULWordVector badDMAs;
 	ofstream ofs(inFilePath.c_str(), ofstream::out | ofstream::binary);
 	if (!ofs)
 		{msgStrm << "## ERROR: Unable to open '" << inFilePath << "' for writing" << endl;	return false;}
+	SDRAMDumpWriter writer(ofs, byteCount, numFrames, inCompact);
+	if (!writer.Start())
+		{msgStrm << "## ERROR: Unable to start writing '" << inFilePath << "'" << endl;	return false;}
 
 	for (ULWord frameNdx(0);  frameNdx < numFrames;	 frameNdx++)
 	{
-		if (!inDevice.DMAReadFrame(frameNdx, buffer, byteCount, NTV2_CHANNEL1))
-			{badDMAs.push_back(frameNdx);  continue;}
-		if (!ofs.write(buffer, streamsize(buffer.GetByteCount())).good())
-			{badWrites.push_back(frameNdx);	 continue;}
-		goodFrames.push_back(frameNdx);
+		const size_t bufferNdx (writer.AcquireBuffer());
+		//	Address SDRAM by byte offset -- DMAReadFrame would stride by the channel's quad/quad-quad frame size
+		if (!inDevice.DMARead(0, writer.Buffer(bufferNdx), frameNdx * byteCount, byteCount))
+			{badDMAs.push_back(frameNdx);  writer.ReleaseBuffer(bufferNdx);  continue;}
+		writer.SubmitBuffer(bufferNdx, frameNdx);	//	Written while the next frame is read
 	}	//	for each frame
+	const bool finished (writer.Finish());
+
 	if (!badDMAs.empty())
 	{
 		msgStrm << "## ERROR: DMARead failed for " << DEC(badDMAs.size()) << " " << DEC(megs) << "MB frame(s): ";
 		::NTV2PrintULWordVector(badDMAs, msgStrm); msgStrm << endl;
 	}
-	if (!badWrites.empty())
+	if (!writer.BadWrites().empty())
 	{
-		msgStrm << "## ERROR: Write failures for " << DEC(badWrites.size()) << " " << DEC(megs) << "MB frame(s): ";
-		::NTV2PrintULWordVector(badWrites, msgStrm); msgStrm << endl;
+		msgStrm << "## ERROR: Write failures for " << DEC(writer.BadWrites().size()) << " " << DEC(megs) << "MB frame(s): ";
+		::NTV2PrintULWordVector(writer.BadWrites(), msgStrm); msgStrm << endl;
 	}
-	msgStrm << "## NOTE: " << DEC(goodFrames.size()) << " x " << DEC(megs) << "MB frames from device '"
-						<< CNTV2DeviceScanner::GetDeviceRefName(inDevice) << "' written to '" << inFilePath << "'" << endl;
-	return true;
+	if (!finished)
+		msgStrm << "## ERROR: Unable to finish writing '" << inFilePath << "'" << endl;
+	msgStrm << "## NOTE: " << DEC(writer.GoodFrames().size()) << " x " << DEC(megs) << "MB frames from device '"
+						<< CNTV2DeviceScanner::GetDeviceRefName(inDevice) << "' written to '" << inFilePath << "'";
+	if (inCompact)
+		msgStrm << " as " << DEC(writer.BytesWritten()/1024/1024) << "MB (" << DEC(writer.ElidedFrames()) << " constant frame(s) elided)";
+	msgStrm << endl;
+	return finished;
 }
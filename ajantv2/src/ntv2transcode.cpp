@@ -7,6 +7,7 @@
 
 #include "ntv2transcode.h"
 #include "ntv2endian.h"
+#include "ajabase/common/videoutilities.h"
 
 using namespace std;
 
@@ -352,6 +353,12 @@ void ConvertLinetoRGB(UWord * ycbcrBuffer,
 					  bool fUseSMPTERange,
 					  bool fAlphaFromLuma)
 {
+	if (!fUseSMPTERange  &&  !fAlphaFromLuma)
+	{	//	Same matrices, done by the (SIMD) ajabase line converter
+		AJA_ConvertLinetoRGB(ycbcrBuffer, reinterpret_cast<AJA_RGBAlphaPixel*>(rgbaBuffer), numPixels,
+							fUseSDMatrix ? AJA_ColorMatrix_Rec601 : AJA_ColorMatrix_Rec709, 0);
+		return;
+	}
 	YCbCr10BitAlphaPixel ycbcrPixel = {0,0,0,0};
 	UWord Cb1,Y1,Cr1,Cb2,Y2,Cr2;
 
@@ -478,6 +485,12 @@ void ConvertLineto10BitRGB(UWord * ycbcrBuffer,
 					  bool fUseSDMatrix,
 					  bool fUseSMPTERange)
 {
+	if (!fUseSMPTERange)
+	{	//	Same matrices, done by the (SIMD) ajabase line converter
+		AJA_ConvertLineto10BitRGB(ycbcrBuffer, reinterpret_cast<AJA_RGBAlpha10BitPixel*>(rgbaBuffer), numPixels,
+								fUseSDMatrix ? AJA_ColorMatrix_Rec601 : AJA_ColorMatrix_Rec709, 0);
+		return;
+	}
 	YCbCr10BitAlphaPixel ycbcrPixel = {0,0,0,0};
 	UWord Cb1,Y1,Cr1,Cb2,Y2,Cr2;
 
@@ -853,6 +866,12 @@ void ConvertLineto16BitRGB(UWord * ycbcrBuffer,
 					  bool fUseSDMatrix,
 					  bool fUseSMPTERange)
 {
+	if (!fUseSMPTERange)
+	{	//	Same matrices, done by the (SIMD) ajabase line converter
+		AJA_ConvertLineto16BitRGB(ycbcrBuffer, reinterpret_cast<AJA_RGBAlpha16BitPixel*>(rgbaBuffer), numPixels,
+								fUseSDMatrix ? AJA_ColorMatrix_Rec601 : AJA_ColorMatrix_Rec709, 0);
+		return;
+	}
 	YCbCr10BitAlphaPixel ycbcrPixel = {0,0,0,0};
 	UWord Cb1,Y1,Cr1,Cb2,Y2,Cr2;
 
@@ -2781,16 +2781,35 @@ ULWord GetVideoWriteSize (const NTV2VideoFormat inVideoFormat, const NTV2FrameBu
 }
 
 
-// For a given framerate and audiorate, returns how many audio samples there
-// will be in a frame's time. cadenceFrame is only used for 5994 or 2997 @ 48k.
-// smpte372Enabled indicates that you are doing 1080p60,1080p5994 or 1080p50
-// in this mode the boards framerate might be NTV2_FRAMERATE_3000, but since
-// 2 links are coming out, the video rate is actually NTV2_FRAMERATE_6000
-ULWord GetAudioSamplesPerFrame (const NTV2FrameRate inFrameRate, const NTV2AudioRate inAudioRate, ULWord inCadenceFrame, const bool inIsSMPTE372Enabled)
+// Audio cadence arithmetic:
+// A frame at rate num/den lasts sampleRate*den/num audio samples, which is fractional for the 1000/1001 rates
+// (e.g. 1601.6 at 29.97/48K), but always a whole number over any 5 consecutive frames. The running sample count
+// through frame N is computed exactly as floor((N * sampleRate * den + phase) / num), so it never drifts from the
+// audio clock, and the count for any one frame is the difference of two consecutive running counts.
+// The phase (in fifths of a frame) picks where in the 5-frame group the extra samples fall, and is chosen to
+// reproduce the cadences this SDK has always used. (The old 96K/14.98 and 192K/29.97 tables ran more than a sample
+// ahead of the audio clock, so those two now distribute the same totals slightly differently within the group.)
+static ULWord AudioCadencePhaseFifths (const NTV2FrameRate inFrameRate, const NTV2AudioRate inAudioRate)
+{
+	switch (inFrameRate)
+	{
+		case NTV2_FRAMERATE_11988:	return inAudioRate == NTV2_AUDIO_96K ? 4 : 2;
+		case NTV2_FRAMERATE_5994:	return inAudioRate == NTV2_AUDIO_48K ? 0 : (inAudioRate == NTV2_AUDIO_96K ? 2 : 4);
+		case NTV2_FRAMERATE_2997:	return inAudioRate == NTV2_AUDIO_48K ? 2 : 4;
+		case NTV2_FRAMERATE_1498:	return 4;
+		default:					break;
+	}
+	return 0;	//	Whole number of samples per frame -- phase doesn't matter
+}
+
+// Computes the running audio sample count from frame zero up to (but not including) the given frame.
+// Returns false for unknown (or unsupported) frame or audio rates.
+static bool AudioSamplesUpToFrame (const NTV2FrameRate inFrameRate, const NTV2AudioRate inAudioRate, const ULWord64 inFrameNum,
+									const bool inIsSMPTE372Enabled, ULWord64 & outNumSamples)
 {
 	NTV2FrameRate	frameRate(inFrameRate);
-	ULWord			audioSamplesPerFrame(0);
-	inCadenceFrame %= 5;
+	ULWord			fpsNumer(0), fpsDenom(0);
+	outNumSamples = 0;
 
 	if (inIsSMPTE372Enabled)
 	{
@@ -2803,401 +2822,59 @@ ULWord GetAudioSamplesPerFrame (const NTV2FrameRate inFrameRate, const NTV2Audio
 			case NTV2_FRAMERATE_2500:	frameRate = NTV2_FRAMERATE_5000;	break;
 			case NTV2_FRAMERATE_2400:	frameRate = NTV2_FRAMERATE_4800;	break;
 			case NTV2_FRAMERATE_2398:	frameRate = NTV2_FRAMERATE_4795;	break;
-		default:
-			break;
+			default:					break;
 		}
 	}
-
-	if (inAudioRate == NTV2_AUDIO_48K)
-	{
-		switch (frameRate)
-		{
-			case NTV2_FRAMERATE_12000:
-				audioSamplesPerFrame = 400;
-				break;
-			case NTV2_FRAMERATE_11988:
-				switch (inCadenceFrame)
-				{
-					case 0:
-					case 2:
-					case 4: audioSamplesPerFrame = 400; break;
-	
-					case 1:
-					case 3: audioSamplesPerFrame = 401; break;
-				}
-				break;
-			case NTV2_FRAMERATE_6000:
-				audioSamplesPerFrame = 800;
-				break;
-			case NTV2_FRAMERATE_5994:
-				switch (inCadenceFrame)
-				{
-				case 0: audioSamplesPerFrame = 800; break;
-	
-				case 1:
-				case 2:
-				case 3:
-				case 4: audioSamplesPerFrame = 801; break;
-				}
-				break;
-			case NTV2_FRAMERATE_5000:	audioSamplesPerFrame = 1920/2;	break;
-			case NTV2_FRAMERATE_4800:	audioSamplesPerFrame = 1000;	break;
-			case NTV2_FRAMERATE_4795:	audioSamplesPerFrame = 1001;	break;
-			case NTV2_FRAMERATE_3000:	audioSamplesPerFrame = 1600;	break;
-			case NTV2_FRAMERATE_2997:
-				// depends on cadenceFrame;
-				switch (inCadenceFrame)
-				{
-					case 0:
-					case 2:
-					case 4: audioSamplesPerFrame = 1602;	break;
-	
-					case 1:
-					case 3: audioSamplesPerFrame = 1601;	break;
-				}
-				break;
-			case NTV2_FRAMERATE_2500:	audioSamplesPerFrame = 1920;	break;
-			case NTV2_FRAMERATE_2400:	audioSamplesPerFrame = 2000;	break;
-			case NTV2_FRAMERATE_2398:	audioSamplesPerFrame = 2002;	break;
-			case NTV2_FRAMERATE_1500:	audioSamplesPerFrame = 3200;	break;
-			case NTV2_FRAMERATE_1498:
-				// depends on cadenceFrame;
-				switch (inCadenceFrame)
-				{
-					case 0: audioSamplesPerFrame = 3204;	break;
-	
-					case 1:
-					case 2:
-					case 3:
-					case 4: audioSamplesPerFrame = 3203;	break;
-				}
-				break;
-	#if !defined(NTV2_DEPRECATE_16_0)
-			case NTV2_FRAMERATE_1900:	// Not supported yet
-			case NTV2_FRAMERATE_1898:	// Not supported yet
-			case NTV2_FRAMERATE_1800:	// Not supported yet
-			case NTV2_FRAMERATE_1798:	// Not supported yet
-	#endif	//!defined(NTV2_DEPRECATE_16_0)
-			case NTV2_FRAMERATE_UNKNOWN:
-			case NTV2_NUM_FRAMERATES:
-				audioSamplesPerFrame = 0;
-				break;
-			}
-	}
-	else if (inAudioRate == NTV2_AUDIO_96K)
-	{
-		switch (frameRate)
-		{
-			case NTV2_FRAMERATE_12000:
-				audioSamplesPerFrame = 800;
-				break;
-			case NTV2_FRAMERATE_11988:
-				switch (inCadenceFrame)
-				{
-					case 0:
-					case 1:
-					case 2:
-					case 3: audioSamplesPerFrame = 801; break;	//	Fixed in SDK 16.2, was incorrect (901) before 16.2
-	
-					case 4: audioSamplesPerFrame = 800; break;
-				}
-				break;
-			case NTV2_FRAMERATE_6000:	audioSamplesPerFrame = 800*2;	break;
-			case NTV2_FRAMERATE_5994:
-				switch (inCadenceFrame)
-				{
-					case 0:
-					case 2:
-					case 4: audioSamplesPerFrame = 1602;	break;
-	
-					case 1:
-					case 3: audioSamplesPerFrame = 1601;	break;
-				}
-				break;
-			case NTV2_FRAMERATE_5000:	audioSamplesPerFrame = 1920;	break;
-			case NTV2_FRAMERATE_4800:	audioSamplesPerFrame = 2000;	break;
-			case NTV2_FRAMERATE_4795:	audioSamplesPerFrame = 2002;	break;
-			case NTV2_FRAMERATE_3000:	audioSamplesPerFrame = 1600*2;	break;
-			case NTV2_FRAMERATE_2997:
-				// depends on cadenceFrame;
-				switch (inCadenceFrame)
-				{
-					case 0: audioSamplesPerFrame = 3204;	break;
-	
-					case 1:
-					case 2:
-					case 3:
-					case 4: audioSamplesPerFrame = 3203;	break;
-				}
-				break;
-			case NTV2_FRAMERATE_2500:	audioSamplesPerFrame = 1920*2;	break;
-			case NTV2_FRAMERATE_2400:	audioSamplesPerFrame = 2000*2;	break;
-			case NTV2_FRAMERATE_2398:	audioSamplesPerFrame = 2002*2;	break;
-			case NTV2_FRAMERATE_1500:	audioSamplesPerFrame = 3200*2;	break;
-			case NTV2_FRAMERATE_1498:
-				// depends on cadenceFrame;
-				switch (inCadenceFrame)
-				{
-					case 0: audioSamplesPerFrame = 3204*2;	break;
-	
-					case 1:
-					case 2:
-					case 3:
-					case 4: audioSamplesPerFrame = 3203*2;	break;
-				}
-				break;
-	#if !defined(NTV2_DEPRECATE_16_0)
-			case NTV2_FRAMERATE_1900:	// Not supported yet
-			case NTV2_FRAMERATE_1898:	// Not supported yet
-			case NTV2_FRAMERATE_1800:	// Not supported yet
-			case NTV2_FRAMERATE_1798:	// Not supported yet
-	#endif	//!defined(NTV2_DEPRECATE_16_0)
-			case NTV2_FRAMERATE_UNKNOWN:
-			case NTV2_NUM_FRAMERATES:
-				audioSamplesPerFrame = 0*2; //haha
-				break;
-			}
-	}
-	else if (inAudioRate == NTV2_AUDIO_192K)
+	if (!NTV2_IS_VALID_AUDIO_RATE(inAudioRate))
+		return false;
+	switch (frameRate)
 	{
-		switch (frameRate)
-		{
-			case NTV2_FRAMERATE_12000:
-				audioSamplesPerFrame = 1600;
-				break;
-			case NTV2_FRAMERATE_11988:
-				switch (inCadenceFrame)
-				{
-					case 0:
-					case 2:
-					case 4: audioSamplesPerFrame = 1602;	break;
-	
-					case 1:
-					case 3: audioSamplesPerFrame = 1601;	break;
-				}
-				break;
-			case NTV2_FRAMERATE_6000:
-				audioSamplesPerFrame = 3200;
-				break;
-			case NTV2_FRAMERATE_5994:
-				switch (inCadenceFrame)
-				{
-					case 0: audioSamplesPerFrame = 3204;	break;
-
-					case 1:
-					case 2:
-					case 3:
-					case 4: audioSamplesPerFrame = 3203;	break;
-				}
-				break;
-			case NTV2_FRAMERATE_5000:	audioSamplesPerFrame = 3840;	break;
-			case NTV2_FRAMERATE_4800:	audioSamplesPerFrame = 4000;	break;
-			case NTV2_FRAMERATE_4795:	audioSamplesPerFrame = 4004;	break;
-			case NTV2_FRAMERATE_3000:	audioSamplesPerFrame = 6400;	break;
-			case NTV2_FRAMERATE_2997:
-				// depends on cadenceFrame;
-				switch (inCadenceFrame)
-				{
-					case 0:
-					case 1: audioSamplesPerFrame = 6407;	break;
-	
-					case 2:
-					case 3:
-					case 4: audioSamplesPerFrame = 6406;	break;
-				}
-				break;
-			case NTV2_FRAMERATE_2500:	audioSamplesPerFrame = 7680;	break;
-			case NTV2_FRAMERATE_2400:	audioSamplesPerFrame = 8000;	break;
-			case NTV2_FRAMERATE_2398:	audioSamplesPerFrame = 8008;	break;
-			case NTV2_FRAMERATE_1500:	audioSamplesPerFrame = 12800;	break;
-			case NTV2_FRAMERATE_1498:
-				// depends on cadenceFrame;
-				switch (inCadenceFrame)
-				{
-					case 0:
-					case 1:
-					case 2:
-					case 3: audioSamplesPerFrame = 12813;	break;
-	
-					case 4: audioSamplesPerFrame = 12812;	break;
-				}
-				break;
 #if !defined(NTV2_DEPRECATE_16_0)
-			case NTV2_FRAMERATE_1900:	// Not supported yet
-			case NTV2_FRAMERATE_1898:	// Not supported yet
-			case NTV2_FRAMERATE_1800:	// Not supported yet
-			case NTV2_FRAMERATE_1798:	// Not supported yet
+		case NTV2_FRAMERATE_1900:	// Not supported yet
+		case NTV2_FRAMERATE_1898:	// Not supported yet
+		case NTV2_FRAMERATE_1800:	// Not supported yet
+		case NTV2_FRAMERATE_1798:	// Not supported yet
+			return false;
 #endif	//!defined(NTV2_DEPRECATE_16_0)
-			case NTV2_FRAMERATE_UNKNOWN:
-			case NTV2_NUM_FRAMERATES:
-				audioSamplesPerFrame = 0*2; //haha
-				break;
-		}
+		default:
+			if (!::GetFramesPerSecond(frameRate, fpsNumer, fpsDenom))
+				return false;
+			break;
 	}
 
-	return audioSamplesPerFrame;
+	const ULWord64	samplesPerSec	(ULWord64(::GetAudioSamplesPerSecond(inAudioRate)));
+	const ULWord64	phase			(ULWord64(fpsNumer) * AudioCadencePhaseFifths(frameRate, inAudioRate) / 5);
+	outNumSamples = (inFrameNum * samplesPerSec * fpsDenom + phase) / fpsNumer;
+	return true;
 }
 
 
-// For a given framerate and audiorate and ending frame number (non-inclusive), returns the total number of audio samples over
-// the range of video frames starting at frame number zero up to and not including the passed in frame number, inFrameNumNonInclusive.
-// Utilizes cadence patterns in function immediately above,	 GetAudioSamplesPerFrame().
-// No smpte372Enabled support
-LWord64 GetTotalAudioSamplesFromFrameNbrZeroUpToFrameNbr (const NTV2FrameRate inFrameRate, const NTV2AudioRate inAudioRate, const ULWord inFrameNumNonInclusive)
+// For a given framerate and audiorate, returns how many audio samples there
+// will be in a frame's time. cadenceFrame is only used for the 1000/1001 rates.
+// smpte372Enabled indicates that you are doing 1080p60,1080p5994 or 1080p50
+// in this mode the boards framerate might be NTV2_FRAMERATE_3000, but since
+// 2 links are coming out, the video rate is actually NTV2_FRAMERATE_6000
+ULWord GetAudioSamplesPerFrame (const NTV2FrameRate inFrameRate, const NTV2AudioRate inAudioRate, ULWord inCadenceFrame, const bool inIsSMPTE372Enabled)
 {
-	LWord64 numTotalAudioSamples;
-	LWord64 numAudioSamplesFromWholeGroups;
-
-	ULWord numWholeGroupsOfFive;
-	ULWord numAudioSamplesFromRemainder;
-	ULWord remainder;
-
-	numWholeGroupsOfFive = inFrameNumNonInclusive / 5;
-	remainder = inFrameNumNonInclusive % 5;
-
-	numTotalAudioSamples = 0;
-	numAudioSamplesFromWholeGroups = 0;
-	numAudioSamplesFromRemainder = 0;
+	ULWord64	samplesBefore(0), samplesThrough(0);
+	inCadenceFrame %= 5;
+	if (!AudioSamplesUpToFrame(inFrameRate, inAudioRate, inCadenceFrame, inIsSMPTE372Enabled, samplesBefore))
+		return 0;
+	if (!AudioSamplesUpToFrame(inFrameRate, inAudioRate, inCadenceFrame + 1, inIsSMPTE372Enabled, samplesThrough))
+		return 0;
+	return ULWord(samplesThrough - samplesBefore);
+}
 
-	if (inAudioRate == NTV2_AUDIO_48K)
-	{
-		switch (inFrameRate)
-		{
-		case NTV2_FRAMERATE_12000:
-			numTotalAudioSamples = 400 * inFrameNumNonInclusive;
-			break;
-		case NTV2_FRAMERATE_11988:
-			numAudioSamplesFromWholeGroups = ((2*401) + (3*400)) * numWholeGroupsOfFive;
-			numAudioSamplesFromRemainder = (remainder == 0) ? 0 : ((400 * remainder) + remainder/2);
-			numTotalAudioSamples = numAudioSamplesFromWholeGroups + numAudioSamplesFromRemainder;
-			break;
-		case NTV2_FRAMERATE_6000:
-			numTotalAudioSamples = 800 * inFrameNumNonInclusive;
-			break;
-		case NTV2_FRAMERATE_5994:
-			// depends on cadenceFrame;
-			numAudioSamplesFromWholeGroups = ((1*800) + (4*801)) * numWholeGroupsOfFive;
-			numAudioSamplesFromRemainder = (remainder == 0) ? 0 : ((801 * remainder) - 1);
-			numTotalAudioSamples = numAudioSamplesFromWholeGroups + numAudioSamplesFromRemainder;
-			break;
-		case NTV2_FRAMERATE_5000:
-			numTotalAudioSamples = 1920/2 * inFrameNumNonInclusive;
-			break;
-		case NTV2_FRAMERATE_4800:
-			numTotalAudioSamples = 1000 * inFrameNumNonInclusive;
-			break;
-		case NTV2_FRAMERATE_4795:
-			numTotalAudioSamples = 1001 * inFrameNumNonInclusive;
-			break;
-		case NTV2_FRAMERATE_3000:
-			numTotalAudioSamples = 1600 * inFrameNumNonInclusive;
-			break;
-		case NTV2_FRAMERATE_2997:
-			// depends on cadenceFrame;
-			numAudioSamplesFromWholeGroups = ((3*1602) + (2*1601)) * numWholeGroupsOfFive;
-			numAudioSamplesFromRemainder = (remainder == 0) ? 0 : ((1602 * remainder) - remainder/2);
-			numTotalAudioSamples = numAudioSamplesFromWholeGroups + numAudioSamplesFromRemainder;
-			break;
-		case NTV2_FRAMERATE_2500:
-			numTotalAudioSamples = 1920 * inFrameNumNonInclusive;
-			break;
-		case NTV2_FRAMERATE_2400:
-			numTotalAudioSamples = 2000 * inFrameNumNonInclusive;
-			break;
-		case NTV2_FRAMERATE_2398:
-			numTotalAudioSamples = 2002 * inFrameNumNonInclusive;
-			break;
-		case NTV2_FRAMERATE_1500:
-			numTotalAudioSamples = 3200 * inFrameNumNonInclusive;
-			break;
-		case NTV2_FRAMERATE_1498:
-			// depends on cadenceFrame;
-			numAudioSamplesFromWholeGroups = ((1*3204) + (4*3203)) * numWholeGroupsOfFive;
-			numAudioSamplesFromRemainder = (remainder == 0) ? 0 : ((3203 * remainder) + 1);
-			numTotalAudioSamples = numAudioSamplesFromWholeGroups + numAudioSamplesFromRemainder;
-			break;
-#if !defined(NTV2_DEPRECATE_16_0)
-		case NTV2_FRAMERATE_1900:	// Not supported yet
-		case NTV2_FRAMERATE_1898:	// Not supported yet
-		case NTV2_FRAMERATE_1800:	// Not supported yet
-		case NTV2_FRAMERATE_1798:	// Not supported yet
-#endif	//!defined(NTV2_DEPRECATE_16_0)
-		case NTV2_FRAMERATE_UNKNOWN:
-		case NTV2_NUM_FRAMERATES:
-			numTotalAudioSamples = 0;
-			break;
-		}
-	}
-	else if (inAudioRate == NTV2_AUDIO_96K)
-	{
-		switch (inFrameRate)
-		{
-		case NTV2_FRAMERATE_12000:
-			numTotalAudioSamples = 800 * inFrameNumNonInclusive;
-			break;
-		case NTV2_FRAMERATE_11988:
-			numAudioSamplesFromWholeGroups = ((4*801) + (1*800)) * numWholeGroupsOfFive;
-			numAudioSamplesFromRemainder = (remainder == 0) ? 0 : (801 * remainder);
-			numTotalAudioSamples = numAudioSamplesFromWholeGroups + numAudioSamplesFromRemainder;
-			break;
-		case NTV2_FRAMERATE_6000:
-			numTotalAudioSamples = (800*2) * inFrameNumNonInclusive;
-			break;
-		case NTV2_FRAMERATE_5994:
-			numAudioSamplesFromWholeGroups = ((3*1602) + (2*1601)) * numWholeGroupsOfFive;
-			numAudioSamplesFromRemainder = (remainder == 0) ? 0 : ((1602 * remainder) - remainder/2);
-			numTotalAudioSamples = numAudioSamplesFromWholeGroups + numAudioSamplesFromRemainder;
-			break;
-		case NTV2_FRAMERATE_5000:
-			numTotalAudioSamples = 1920 * inFrameNumNonInclusive;
-			break;
-		case NTV2_FRAMERATE_4800:
-			numTotalAudioSamples = 2000 * inFrameNumNonInclusive;
-			break;
-		case NTV2_FRAMERATE_4795:
-			numTotalAudioSamples = 2002 * inFrameNumNonInclusive;
-			break;
-		case NTV2_FRAMERATE_3000:
-			numTotalAudioSamples = (1600*2) * inFrameNumNonInclusive;
-			break;
-		case NTV2_FRAMERATE_2997:
-			// depends on cadenceFrame;
-			numAudioSamplesFromWholeGroups = ((1*3204) + (4*3203)) * numWholeGroupsOfFive;
-			numAudioSamplesFromRemainder = (remainder == 0) ? 0 : ((3203 * remainder) + 1);
-			numTotalAudioSamples = numAudioSamplesFromWholeGroups + numAudioSamplesFromRemainder;
-			break;
-		case NTV2_FRAMERATE_2500:
-			numTotalAudioSamples = (1920*2) * inFrameNumNonInclusive;
-			break;
-		case NTV2_FRAMERATE_2400:
-			numTotalAudioSamples = (2000*2) * inFrameNumNonInclusive;
-			break;
-		case NTV2_FRAMERATE_2398:
-			numTotalAudioSamples = (2002*2) * inFrameNumNonInclusive;
-			break;
-		case NTV2_FRAMERATE_1500:
-			numTotalAudioSamples = (3200*2) * inFrameNumNonInclusive;
-			break;
-		case NTV2_FRAMERATE_1498:
-			// depends on cadenceFrame;
-			numAudioSamplesFromWholeGroups = ((1*3204*2) + (4*3203*2)) * numWholeGroupsOfFive;
-			numAudioSamplesFromRemainder = (remainder == 0) ? 0 : (((3203*2) * remainder) + 2);
-			numTotalAudioSamples = numAudioSamplesFromWholeGroups + numAudioSamplesFromRemainder;
-			break;
-#if !defined(NTV2_DEPRECATE_16_0)
-		case NTV2_FRAMERATE_1900:	// Not supported yet
-		case NTV2_FRAMERATE_1898:	// Not supported yet
-		case NTV2_FRAMERATE_1800:	// Not supported yet
-		case NTV2_FRAMERATE_1798:	// Not supported yet
-#endif	//!defined(NTV2_DEPRECATE_16_0)
-		case NTV2_FRAMERATE_UNKNOWN:
-		case NTV2_NUM_FRAMERATES:
-			numTotalAudioSamples = 0*2; //haha
-			break;
-		}
-	}
 
-	return numTotalAudioSamples;
+// For a given framerate and audiorate and ending frame number (non-inclusive), returns the total number of audio samples over
+// the range of video frames starting at frame number zero up to and not including the passed in frame number, inFrameNumNonInclusive.
+// Always equals the sum of GetAudioSamplesPerFrame() over those frames.
+LWord64 GetTotalAudioSamplesFromFrameNbrZeroUpToFrameNbr (const NTV2FrameRate inFrameRate, const NTV2AudioRate inAudioRate, const ULWord inFrameNumNonInclusive, const bool inIsSMPTE372Enabled)
+{
+	ULWord64	numTotalAudioSamples(0);
+	if (!AudioSamplesUpToFrame(inFrameRate, inAudioRate, inFrameNumNonInclusive, inIsSMPTE372Enabled, numTotalAudioSamples))
+		return 0;
+	return LWord64(numTotalAudioSamples);
 }
 
 double GetAudioSamplesPerSecond (const NTV2AudioRate inAudioRate)
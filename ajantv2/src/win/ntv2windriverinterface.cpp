@@ -298,6 +298,7 @@ bool CNTV2WinDriverInterface::CloseLocalPhysical (void)
 
 bool CNTV2WinDriverInterface::ReadRegister (const ULWord inRegNum,	ULWord & outValue,	const ULWord inMask,  const ULWord inShift)
 {
+	NTV2_PROFILE_ACCESS(NTV2AccessKind_ReadRegister, inRegNum);
 	if (inShift >= 32)
 	{
 		WDIFAIL("Shift " << DEC(inShift) << " > 31, reg=" << DEC(inRegNum) << " msk=" << xHEX0N(inMask,8));
@@ -337,6 +338,7 @@ bool CNTV2WinDriverInterface::ReadRegister (const ULWord inRegNum,	ULWord & outV
 
 bool CNTV2WinDriverInterface::WriteRegister (const ULWord inRegNum,	 const ULWord inValue,	const ULWord inMask, const ULWord inShift)
 {
+	NTV2_PROFILE_ACCESS(NTV2AccessKind_WriteRegister, inRegNum);
 	if (inShift >= 32)
 	{
 		WDIFAIL("Shift " << DEC(inShift) << " > 31, reg=" << DEC(inRegNum) << " msk=" << xHEX0N(inMask,8));
@@ -837,6 +839,7 @@ bool CNTV2WinDriverInterface::DmaTransfer ( const NTV2DMAEngine inDMAEngine,
 											const ULWord		inByteCount,
 											const bool			inSynchronous)
 {
+	NTV2_PROFILE_ACCESS(NTV2AccessKind_DMATransfer, inDMAEngine);
 	if (IsRemote())
 		return false;
 	if (!IsOpen())
@@ -880,6 +883,7 @@ bool CNTV2WinDriverInterface::DmaTransfer ( const NTV2DMAEngine inDMAEngine,
 											const ULWord		inCardPitch,
 											const bool			inSynchronous)
 {
+	NTV2_PROFILE_ACCESS(NTV2AccessKind_DMATransfer, inDMAEngine);
 	if (IsRemote())
 		return false;
 	if (!IsOpen())
@@ -925,6 +929,7 @@ bool CNTV2WinDriverInterface::DmaTransfer ( const NTV2DMAEngine			inDMAEngine,
 											const ULWord				inCardPitch,
 											const PCHANNEL_P2P_STRUCT & inP2PData)
 {
+	NTV2_PROFILE_ACCESS(NTV2AccessKind_DMATransfer, inDMAEngine);
 	if (IsRemote())
 		return false;
 	if (!IsOpen())
@@ -1008,6 +1013,7 @@ bool CNTV2WinDriverInterface::DmaTransfer ( const NTV2DMAEngine			inDMAEngine,
 // AutoCirculate
 bool CNTV2WinDriverInterface::AutoCirculate (AUTOCIRCULATE_DATA &autoCircData)
 {
+	NTV2_PROFILE_ACCESS(NTV2AccessKind_AutoCirculate, autoCircData.eCommand);
 	if (IsRemote())
 		return CNTV2DriverInterface::AutoCirculate(autoCircData);
 	bool bRes(true);
@@ -1348,6 +1354,7 @@ bool CNTV2WinDriverInterface::NTV2Message (NTV2_HEADER * pInMessage)
 {
 	if (!pInMessage)
 		{WDIFAIL("Failed: NULL pointer"); return false;}
+	NTV2_PROFILE_ACCESS(NTV2AccessKind_Message, pInMessage->GetType());
 	DWORD dwBytesReturned(0);
 	AJADebug::StatTimerStart(AJA_DebugStat_NTV2Message);
 	const bool ok = DeviceIoControl(_hDevice, IOCTL_AJANTV2_MESSAGE, pInMessage, pInMessage->GetSizeInBytes (), pInMessage, pInMessage->GetSizeInBytes(), &dwBytesReturned, NULL);
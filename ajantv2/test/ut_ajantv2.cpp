@@ -12,21 +12,41 @@
 #define DOCTEST_THREAD_LOCAL
 #include "doctest.h"
 #include "ntv2bitfile.h"
+#include "ntv2audiosignal.h"
 #include "ntv2card.h"
+#include "ntv2configts2022.h"
 #include "ntv2debug.h"
+#include "ntv2deinterlacer.h"
+#include "ntv2devicescanner.h"
+#include "ntv2devicetrace.h"
 #include "ntv2endian.h"
+#include "ntv2frameshare.h"
+#include "ntv2interruptmux.h"
+#include "ntv2pixelformatconverter.h"
+#include "ntv2quadrasterconverter.h"
+#include "ntv2signalmonitor.h"
 #include "ntv2signalrouter.h"
+#include "ntv2supportlogger.h"
 #include "ntv2routingexpert.h"
+#include "ntv2registerexpert.h"
+#include "ntv2resample.h"
+#include "ntv2rp188.h"
+#include "ntv2scaler.h"
 #include "ntv2transcode.h"
 #include "ntv2utils.h"
 #include "ntv2vpid.h"
 #include "ntv2version.h"
 #include "ntv2testpatterngen.h"
 #include "ajabase/system/debug.h"
+#include "ajabase/system/file_io.h"
 #include "ajabase/common/common.h"
+#include "ajabase/system/systemtime.h"
+#include "ajabase/system/workerpool.h"
+#include <fstream>
 #include <vector>
 #include <algorithm>
 #include <iomanip>
+#include <cmath>
 #include <iterator>    //      For std::inserter
 
 using namespace std;
@@ -39,6 +59,47 @@ static bool gVerboseOutput = false;
 #define	LOGINFO(__x__)	AJA_sREPORT(AJA_DebugUnit_Testing, AJA_DebugSeverity_Info,		AJAFUNC << ":  " << __x__)
 #define	LOGDBG(__x__)	AJA_sREPORT(AJA_DebugUnit_Testing, AJA_DebugSeverity_Debug,		AJAFUNC << ":  " << __x__)
 
+//	Returns the path of a file with the given name in the temp directory
+static std::string tempPath (const std::string & inName)
+{
+	std::string tempDir;
+	if (AJAFileIO::TempDirectory(tempDir) != AJA_STATUS_SUCCESS)
+		tempDir = ".";
+	aja::rstrip(tempDir, std::string(1, AJA_PATHSEP));
+	return tempDir + AJA_PATHSEP + inName;
+}
+
+//	Points the plugin loader at the swdevice & virtualdev plugins that CMake copies next to this test,
+//	and returns true if an swdevice can be opened
+static bool swDeviceAvailable (void)
+{
+#if defined(UT_AJANTV2_PLUGINS_DIR)
+	NTV2RPCClientAPI::SetPluginsFolder(UT_AJANTV2_PLUGINS_DIR);
+#endif
+	CNTV2Card card;
+	return card.Open("ntv2swdevice://localhost/?nosharedmemory");
+}
+
+//	Writes an swdevice support log that sets the given registers
+static void writeSupportLog (const std::string & inPath, const NTV2RegisterWrites & inRegs)
+{
+	std::ofstream ofs(inPath.c_str());
+	for (size_t ndx(0);  ndx < inRegs.size();  ndx++)
+		ofs << "Register Number: " << inRegs.at(ndx).registerNumber << std::endl
+			<< "Register Value: " << inRegs.at(ndx).registerValue << " : " << xHEX0N(inRegs.at(ndx).registerValue,8) << std::endl;
+}
+
+//	Returns an swdevice URL that loads its registers from the given support log
+static std::string swDeviceSpec (const std::string & inSupportLogPath, const std::string & inParams = std::string())
+{
+	std::string spec("ntv2swdevice://localhost/?nosharedmemory");
+	if (!inSupportLogPath.empty())
+		spec += "&supportlog=" + ::PercentEncode("file://" + inSupportLogPath);
+	if (!inParams.empty())
+		spec += "&" + inParams;
+	return spec;
+}
+
 #if 0
 template
 void filename_marker() {} //this is used to easily just around in a GUI with a symbols list
@@ -751,6 +812,114 @@ TEST_SUITE("ntv2devicescanner" * doctest::description("ntv2 device scanner funct
 		CHECK(geom_set.count(NTV2_FG_4x4096x2160) == 0);
 	}
 
+	TEST_CASE("CNTV2DeviceScanner device specs")
+	{
+		const string spec("ntv2nosuchplugin://localhost/");
+		const size_t numDevices(CNTV2DeviceScanner::GetNumDevices());
+		const ULWord generation(CNTV2DeviceScanner::GetDeviceListGeneration());
+		CHECK(CNTV2DeviceScanner::AddDeviceSpec(spec));
+		CHECK_FALSE(CNTV2DeviceScanner::AddDeviceSpec(spec));		//	Already added
+		CHECK_FALSE(CNTV2DeviceScanner::AddDeviceSpec(string()));
+		CHECK(CNTV2DeviceScanner::GetDeviceSpecs().size() == 1);
+		CHECK(CNTV2DeviceScanner::GetNumDevices() == numDevices);	//	Can't be opened, so isn't listed
+		CHECK(CNTV2DeviceScanner::GetDeviceListGeneration() == generation);
+		CHECK(CNTV2DeviceScanner::RemoveDeviceSpec(spec));
+		CHECK_FALSE(CNTV2DeviceScanner::RemoveDeviceSpec(spec));
+		CHECK(CNTV2DeviceScanner::GetDeviceSpecs().empty());
+
+		CNTV2Card card;
+		CHECK_FALSE(CNTV2DeviceScanner::GetDeviceAtIndex(ULWord(numDevices), card));
+		CHECK_FALSE(CNTV2DeviceScanner::GetDeviceWithSerial(0x0123456789ABCDEFULL, card));
+		CHECK_FALSE(card.IsOpen());
+	}
+
+	TEST_CASE("CNTV2DeviceScanner lookup speed")
+	{
+		if (!swDeviceAvailable())
+			{MESSAGE("swdevice plugin not found -- skipped");  return;}
+		const string swSpec(swDeviceSpec(""));
+		CNTV2Card card;
+
+		static const size_t kNumDevices[] = {1, 8, 64};
+		for (size_t test(0);  test < sizeof(kNumDevices) / sizeof(kNumDevices[0]);  test++)
+		{
+			NTV2StringList specs;
+			for (size_t ndx(0);  ndx < kNumDevices[test];  ndx++)
+			{
+				ostringstream oss;  oss << swSpec << "&instance=" << ndx;
+				specs.push_back(oss.str());
+				CHECK(CNTV2DeviceScanner::AddDeviceSpec(specs.back()));
+			}
+			const ULWord lastNdx (ULWord(CNTV2DeviceScanner::GetNumDevices() - 1));
+			REQUIRE(CNTV2DeviceScanner::GetDeviceAtIndex(lastNdx, card));
+			const uint64_t serialNum(card.GetSerialNumber());
+			card.Close();
+
+			const int kLookups(20);
+			uint64_t startUS(AJATime::GetSystemMicroseconds());
+			for (int lookup(0);  lookup < kLookups;  lookup++)
+			{
+				CNTV2DeviceScanner::InvalidateDeviceList();		//	What every lookup used to cost
+				CHECK(CNTV2DeviceScanner::GetDeviceWithSerial(serialNum, card));
+			}
+			const uint64_t rescanUS((AJATime::GetSystemMicroseconds() - startUS) / kLookups);
+			startUS = AJATime::GetSystemMicroseconds();
+			for (int lookup(0);  lookup < kLookups;  lookup++)
+				CHECK(CNTV2DeviceScanner::GetDeviceWithSerial(serialNum, card));
+			const uint64_t cachedUS((AJATime::GetSystemMicroseconds() - startUS) / kLookups);
+			MESSAGE(kNumDevices[test] << " device(s): " << rescanUS << " us per lookup with rescan, " << cachedUS << " us cached");
+
+			for (size_t ndx(0);  ndx < specs.size();  ndx++)
+				CHECK(CNTV2DeviceScanner::RemoveDeviceSpec(specs.at(ndx)));
+		}
+		card.Close();
+	}
+
+	TEST_CASE("CNTV2DeviceScanner stale cache")
+	{
+		if (!swDeviceAvailable())
+			{MESSAGE("swdevice plugin not found -- skipped");  return;}
+		//	An swdevice reloads its board ID & serial number from its support log on every open,
+		//	so rewriting the log between scan and lookup looks just like a hot-plugged board
+		const string logPath (tempPath("ut_ajantv2_stalecache.log"));
+		NTV2RegisterWrites regs;
+		regs.push_back(NTV2RegInfo(kRegBoardID, DEVICE_ID_KONA4));
+		regs.push_back(NTV2RegInfo(kRegReserved54, 0x31313131));
+		regs.push_back(NTV2RegInfo(kRegReserved55, 0x31315331));
+		writeSupportLog(logPath, regs);
+		const string spec (swDeviceSpec(logPath));
+		CNTV2DeviceScanner::InvalidateDeviceList();
+		REQUIRE(CNTV2DeviceScanner::AddDeviceSpec(spec));
+		const ULWord index (ULWord(CNTV2DeviceScanner::GetNumDevices() - 1));
+		CNTV2Card card;
+		REQUIRE(CNTV2DeviceScanner::GetDeviceAtIndex(index, card));
+		const uint64_t oldSerial (card.GetSerialNumber());
+		CHECK_EQ(card.GetDeviceID(), DEVICE_ID_KONA4);
+		card.Close();
+
+		//	Different serial number, same index:  the cached entry mustn't open the new board...
+		regs.at(2).registerValue = 0x32315331;
+		writeSupportLog(logPath, regs);
+		CHECK_FALSE(CNTV2DeviceScanner::GetDeviceWithSerial(oldSerial, card));
+		CHECK_FALSE(card.IsOpen());
+		REQUIRE(CNTV2DeviceScanner::GetDeviceAtIndex(index, card));
+		const uint64_t newSerial (card.GetSerialNumber());
+		CHECK(newSerial != oldSerial);
+		CHECK(CNTV2DeviceScanner::GetDeviceWithSerial(newSerial, card));
+		card.Close();
+
+		//	Different board, same serial number...
+		regs.at(0).registerValue = DEVICE_ID_KONA1;
+		writeSupportLog(logPath, regs);
+		CHECK_FALSE(CNTV2DeviceScanner::GetFirstDeviceWithID(DEVICE_ID_KONA4, card));
+		CHECK(CNTV2DeviceScanner::GetFirstDeviceWithID(DEVICE_ID_KONA1, card));
+		CHECK_EQ(card.GetDeviceID(), DEVICE_ID_KONA1);
+		card.Close();
+
+		CHECK(CNTV2DeviceScanner::RemoveDeviceSpec(spec));
+		::remove(logPath.c_str());
+	}
+
 } // ntv2devicescanner
 
 void ntv2vpid_marker() {}
@@ -3277,3 +3446,2411 @@ TEST_SUITE("AutoCirculate" * doctest::description("AutoCirculate tests"))
 		CHECK_FALSE(fRange.valid());
 	}	//	TEST_CASE("NTV2ACFrameRange")
 }	//	TEST_SUITE("AutoCirculate")
+
+
+//	A pretend device whose registers live in a map. Batched register reads & writes are done in memory, one register
+//	at a time, so nothing ever reaches the driver. The suites' fakes derive from this...
+class FakeRegisterDevice : public CNTV2Card
+{
+	public:
+		explicit FakeRegisterDevice (const NTV2DeviceID inDeviceID = DEVICE_ID_NOTFOUND)
+			:	mRegs(), mNumBatchReads(0), mNumBatchWrites(0)
+		{
+			_boardOpened = true;
+			if (inDeviceID != DEVICE_ID_NOTFOUND)
+				{_boardID = inDeviceID;  mRegs[kRegBoardID] = ULWord(inDeviceID);}
+		}
+		virtual ~FakeRegisterDevice ()		{_boardOpened = false;}
+		virtual bool ReadRegister (const ULWord inRegNum, ULWord & outValue, const ULWord inMask = 0xFFFFFFFF, const ULWord inShift = 0)
+		{
+			outValue = (mRegs[inRegNum] & inMask) >> inShift;
+			return true;
+		}
+		virtual bool WriteRegister (const ULWord inRegNum, const ULWord inValue, const ULWord inMask = 0xFFFFFFFF, const ULWord inShift = 0)
+		{
+			ULWord & reg (mRegs[inRegNum]);
+			reg = (reg & ~inMask) | ((inValue << inShift) & inMask);
+			return true;
+		}
+		virtual bool ReadRegisters (NTV2RegisterReads & inOutValues)
+		{
+			mNumBatchReads++;
+			bool result(true);
+			for (NTV2RegisterReadsIter it(inOutValues.begin());  it != inOutValues.end();  ++it)
+				if (!ReadRegister(it->registerNumber, it->registerValue))
+					result = false;
+			return result;
+		}
+		virtual bool WriteRegisters (const NTV2RegisterWrites & inRegWrites)
+		{
+			mNumBatchWrites++;
+			bool result(true);
+			for (NTV2RegisterWritesConstIter it(inRegWrites.begin());  it != inRegWrites.end();  ++it)
+				if (!WriteRegister(it->registerNumber, it->registerValue, it->registerMask, it->registerShift))
+					result = false;
+			return result;
+		}
+
+		NTV2RegisterValueMap	mRegs;
+		ULWord					mNumBatchReads;
+		ULWord					mNumBatchWrites;
+};	//	FakeRegisterDevice
+
+
+void interruptmuxmarker() {}
+TEST_SUITE("InterruptMux" * doctest::description("CNTV2VerticalInterruptMux tests"))
+{
+	//	A pretend device whose input VBIs fire every few milliseconds, and whose output VBIs never fire
+	class FakeVBIDevice : public FakeRegisterDevice
+	{
+		public:
+			virtual bool ConfigureSubscription (const bool bSubscribe, const INTERRUPT_ENUMS inInterruptType, PULWord & outSubcriptionHdl)
+			{	(void) bSubscribe;  (void) inInterruptType;  outSubcriptionHdl = AJA_NULL;
+				return true;
+			}
+			virtual bool WaitForInterrupt (const INTERRUPT_ENUMS eInterrupt, const ULWord timeOutMs = 68)
+			{
+				if (NTV2_IS_INPUT_INTERRUPT(eInterrupt))
+					{AJATime::Sleep(5);  return true;}
+				AJATime::Sleep(int32_t(timeOutMs));
+				return false;
+			}
+	};
+
+	TEST_CASE("WaitForAny")
+	{
+		FakeVBIDevice device;
+		CNTV2VerticalInterruptMux mux(device);
+		NTV2VerticalEvents events;
+		CHECK_FALSE(mux.IsRunning());
+		CHECK_FALSE(mux.WaitForAny(events, 10));		//	Not started
+		CHECK_FALSE(mux.Start(NTV2ChannelSet()));		//	No channels
+		NTV2ChannelSet badChannels;  badChannels.insert(NTV2_CHANNEL_INVALID);
+		CHECK_FALSE(mux.Start(badChannels));
+
+		NTV2ChannelSet inputs, outputs;
+		inputs.insert(NTV2_CHANNEL1);  inputs.insert(NTV2_CHANNEL3);
+		outputs.insert(NTV2_CHANNEL2);
+		mux.SetWaitTimeout(10);
+		CHECK(mux.Start(inputs, outputs));
+		CHECK(mux.IsRunning());
+		CHECK_EQ(mux.GetNumChannels(), 3);
+	#if defined(AJA_LINUX) || defined(AJA_MAC)
+		CHECK(mux.GetFileDescriptor() >= 0);
+	#endif
+
+		ULWord64 totalIn1(0), totalIn3(0);
+		for (int loop(0);  loop < 10;  loop++)
+		{
+			CHECK(mux.WaitForAny(events, 1000));
+			CHECK_FALSE(events.empty());
+			for (NTV2VerticalEventsConstIter it(events.begin());  it != events.end();  ++it)
+			{
+				CHECK(it->fIsInput);		//	Output VBIs never fire
+				CHECK(it->fCount > 0);
+				if (it->fChannel == NTV2_CHANNEL1)
+					totalIn1 = it->fTotalCount;
+				else if (it->fChannel == NTV2_CHANNEL3)
+					totalIn3 = it->fTotalCount;
+				else
+					CHECK(false);
+			}
+		}
+		CHECK(totalIn1 + totalIn3 >= 10);
+
+		AJATime::Sleep(30);
+		CHECK(mux.Poll(events));		//	Should have accumulated some
+		mux.Stop();
+		CHECK_FALSE(mux.IsRunning());
+		CHECK_FALSE(mux.Poll(events));
+		CHECK(events.empty());
+	}	//	TEST_CASE("WaitForAny")
+}	//	TEST_SUITE("InterruptMux")
+
+
+void signalmonitormarker() {}
+TEST_SUITE("SignalMonitor" * doctest::description("CNTV2SignalMonitor tests"))
+{
+	static void OnSignalChange (void * pUserData, const NTV2InputSignalState & inOld, const NTV2InputSignalState & inNew, const ULWord inFlags)
+	{
+		CHECK_EQ(inOld.fInputSource, inNew.fInputSource);
+		CHECK_EQ(inNew.Compare(inOld), inFlags);
+		reinterpret_cast<vector<ULWord>*>(pUserData)->push_back(inFlags);
+	}
+
+	TEST_CASE("Update")
+	{
+		FakeRegisterDevice device(DEVICE_ID_KONA4);
+		CNTV2SignalMonitor monitor(device);
+		CHECK_FALSE(monitor.Update());		//	No inputs yet
+		NTV2InputSourceSet inputs;
+		inputs.insert(NTV2_INPUTSOURCE_SDI1);  inputs.insert(NTV2_INPUTSOURCE_SDI2);
+		CHECK(monitor.SetInputSources(inputs));
+		CHECK(monitor.GetNumRegisters() > 0);
+		vector<ULWord> changes;
+		CHECK_FALSE(monitor.AddCallback(AJA_NULL));
+		CHECK(monitor.AddCallback(OnSignalChange, &changes));
+
+		//	No signal -- no change
+		CHECK(monitor.Update());
+		CHECK_EQ(device.mNumBatchReads, 1);
+		CHECK(changes.empty());
+
+		//	SDI1 gets 1080p30 without VPID
+		device.mRegs[kRegInputStatus] = ULWord(NTV2_FRAMERATE_3000) | kRegMaskInput1Progressive;
+		CHECK(monitor.Update());
+		CHECK_EQ(device.mNumBatchReads, 2);		//	Just one batched read per update
+		REQUIRE_EQ(changes.size(), 1);
+		CHECK((changes.back() & NTV2_SIGNAL_CHANGED_FORMAT));
+		NTV2InputSignalState state;
+		CHECK(monitor.GetState(NTV2_INPUTSOURCE_SDI1, state));
+		CHECK_EQ(state.fFrameRate, NTV2_FRAMERATE_3000);
+		CHECK(state.fIsProgressive);
+		CHECK(state.fIsLocked);
+		CHECK_EQ(state.fVideoFormat, device.GetSDIInputVideoFormat(NTV2_CHANNEL1));
+
+		//	Nothing changed -- no notification
+		CHECK(monitor.Update());
+		CHECK_EQ(changes.size(), 1);
+
+		//	SDI1 gets a VPID
+		ULWord vpid(0);
+		CHECK(CNTV2VPID::SetVPIDData(vpid, NTV2_FORMAT_1080p_3000, false, false, false, false, VPIDChannel_1, true, false, false, NTV2_VPID_TC_HLG));
+		device.mRegs[kRegSDIInput3GStatus] = kRegMaskSDIInVPIDLinkAValid;
+		device.mRegs[kRegSDIIn1VPIDA] = NTV2EndianSwap32(vpid);
+		CHECK(monitor.Update());
+		REQUIRE_EQ(changes.size(), 2);
+		CHECK((changes.back() & NTV2_SIGNAL_CHANGED_VPID));
+		CHECK(monitor.GetState(NTV2_INPUTSOURCE_SDI1, state));
+		CHECK(state.fVPIDValidA);
+		CHECK_EQ(state.fVPIDA, vpid);
+		CHECK_EQ(state.fXferChars, NTV2_VPID_TC_HLG);
+		CHECK_EQ(state.fVideoFormat, device.GetSDIInputVideoFormat(NTV2_CHANNEL1));
+
+		//	SDI2 gets embedded audio on channels 1-4
+		device.mRegs[kRegAud1Detect] = BIT(8) | BIT(9);
+		CHECK(monitor.Update());
+		REQUIRE_EQ(changes.size(), 3);
+		CHECK_EQ(changes.back(), ULWord(NTV2_SIGNAL_CHANGED_AUDIO));
+		CHECK(monitor.GetState(NTV2_INPUTSOURCE_SDI2, state));
+		CHECK_EQ(state.fAudioPairsMask, 3);
+		NTV2AudioChannelPairs pairs;
+		CHECK(device.GetDetectedAudioChannelPairs(NTV2_AUDIOSYSTEM_2, pairs));
+		CHECK_EQ(pairs.size(), 2);
+
+		//	Unsubscribed -- no more notifications
+		CHECK(monitor.RemoveCallback(OnSignalChange, &changes));
+		CHECK_FALSE(monitor.RemoveCallback(OnSignalChange, &changes));
+		device.mRegs[kRegInputStatus] = 0;
+		CHECK(monitor.Update());
+		CHECK_EQ(changes.size(), 3);
+		CHECK_EQ(monitor.GetUpdateCount(), 6);
+		CHECK_FALSE(monitor.GetState(NTV2_INPUTSOURCE_SDI3, state));
+	}	//	TEST_CASE("Update")
+}	//	TEST_SUITE("SignalMonitor")
+
+
+TEST_SUITE("AccessProfiler" * doctest::description("NTV2AccessProfiler & CNTV2DriverInterface access profiling tests"))
+{
+	//	A pretend device that profiles its register accesses the way the platform driver interfaces do
+	class FakeProfiledDevice : public FakeRegisterDevice
+	{
+		public:
+			virtual bool ReadRegister (const ULWord inRegNum, ULWord & outValue, const ULWord inMask = 0xFFFFFFFF, const ULWord inShift = 0)
+			{	NTV2_PROFILE_ACCESS(NTV2AccessKind_ReadRegister, inRegNum);
+				return FakeRegisterDevice::ReadRegister(inRegNum, outValue, inMask, inShift);
+			}
+			virtual bool WriteRegister (const ULWord inRegNum, const ULWord inValue, const ULWord inMask = 0xFFFFFFFF, const ULWord inShift = 0)
+			{	NTV2_PROFILE_ACCESS(NTV2AccessKind_WriteRegister, inRegNum);
+				return FakeRegisterDevice::WriteRegister(inRegNum, inValue, inMask, inShift);
+			}
+	};
+
+	static int	gFakeCallSite(0);	//	Stands in for a caller's return address
+
+	static void ProfilerThread (AJAThread * pThread, void * pContext)
+	{	(void) pThread;
+		NTV2AccessProfiler * pProfiler (reinterpret_cast<NTV2AccessProfiler*>(pContext));
+		for (ULWord ndx(0);  ndx < 10000;  ndx++)
+			pProfiler->Record(NTV2AccessKind_ReadRegister, ndx % 10, &gFakeCallSite, ndx % 3);
+	}
+
+	TEST_CASE("Record")
+	{
+		NTV2AccessProfiler profiler;
+		AJAThread threads[4];
+		for (size_t ndx(0);  ndx < 4;  ndx++)
+			{threads[ndx].Attach(ProfilerThread, &profiler);  CHECK(AJA_SUCCESS(threads[ndx].Start()));}
+		for (size_t ndx(0);  ndx < 4;  ndx++)
+			while (threads[ndx].Active())
+				AJATime::Sleep(1);
+		NTV2AccessProfile profile;
+		profiler.GetProfile(profile);
+		CHECK_EQ(profile.fDropped, 0);
+		REQUIRE_EQ(profile.fByKey.size(), 10);
+		REQUIRE_EQ(profile.fByCaller.size(), 1);
+		CHECK_EQ(profile.TotalCalls(), 40000);
+		CHECK_EQ(profile.TotalCalls(NTV2AccessKind_WriteRegister), 0);
+		for (NTV2AccessProfileEntriesConstIter it(profile.fByKey.begin());  it != profile.fByKey.end();  ++it)
+		{
+			CHECK_EQ(it->fKind, NTV2AccessKind_ReadRegister);
+			CHECK_EQ(it->fCalls, 4000);
+			CHECK_EQ(it->fMaxMicrosecs, 2);
+		}
+		CHECK_EQ(profile.fByCaller.front().fCalls, 40000);
+		CHECK_EQ(profile.fByCaller.front().fCaller, static_cast<const void*>(&gFakeCallSite));
+		profiler.Reset();
+		profiler.GetProfile(profile);
+		CHECK(profile.fByKey.empty());
+	}	//	TEST_CASE("Record")
+
+	static void OneMicrosecThread (AJAThread * pThread, void * pContext)
+	{	(void) pThread;
+		NTV2AccessProfiler * pProfiler (reinterpret_cast<NTV2AccessProfiler*>(pContext));
+		for (ULWord ndx(0);  ndx < 20000;  ndx++)
+			pProfiler->Record(NTV2AccessKind_WriteRegister, ndx % 10, &gFakeCallSite, 1);
+	}
+
+	TEST_CASE("Reset while recording")
+	{
+		NTV2AccessProfiler profiler;
+		AJAThread threads[4];
+		for (size_t ndx(0);  ndx < 4;  ndx++)
+			{threads[ndx].Attach(OneMicrosecThread, &profiler);  CHECK(AJA_SUCCESS(threads[ndx].Start()));}
+		for (size_t ndx(0);  ndx < 4;  ndx++)
+			while (threads[ndx].Active())
+				profiler.Reset();
+		//	Record doesn't lock, so a Reset can split one in-flight Record per thread, but never misattributes one
+		NTV2AccessProfile profile;
+		profiler.GetProfile(profile);
+		for (NTV2AccessProfileEntriesConstIter it(profile.fByKey.begin());  it != profile.fByKey.end();  ++it)
+		{
+			CHECK_EQ(it->fKind, NTV2AccessKind_WriteRegister);
+			CHECK(it->fKey < 10);
+			CHECK(it->fTotalMicrosecs <= it->fCalls + 4);
+			CHECK(it->fCalls <= it->fTotalMicrosecs + 4);
+			CHECK(it->fMaxMicrosecs <= 1);
+		}
+		for (NTV2AccessProfileEntriesConstIter it(profile.fByCaller.begin());  it != profile.fByCaller.end();  ++it)
+			CHECK_EQ(it->fCaller, static_cast<const void*>(&gFakeCallSite));
+
+		//	Once quiet, a Reset starts over exactly
+		profiler.Reset();
+		for (ULWord ndx(0);  ndx < 100;  ndx++)
+			profiler.Record(NTV2AccessKind_WriteRegister, 3, &gFakeCallSite, 2);
+		profiler.GetProfile(profile);
+		REQUIRE_EQ(profile.fByKey.size(), 1);
+		CHECK_EQ(profile.fByKey.front().fCalls, 100);
+		CHECK_EQ(profile.fByKey.front().fTotalMicrosecs, 200);
+		CHECK_EQ(profile.fByKey.front().fMaxMicrosecs, 2);
+	}	//	TEST_CASE("Reset while recording")
+
+	TEST_CASE("DriverInterface")
+	{
+		FakeProfiledDevice device;
+		NTV2AccessProfile profile;
+		CHECK_FALSE(device.IsAccessProfiling());
+		CHECK_FALSE(device.GetAccessProfile(profile));		//	Never started
+		ULWord value(0);
+		device.WriteRegister(kRegGlobalControl, 0x12345678);
+		CHECK(device.StartAccessProfiling());
+		CHECK(device.IsAccessProfiling());
+		for (int loop(0);  loop < 5;  loop++)
+			device.ReadRegister(kRegGlobalControl, value);
+		device.ReadRegister(kRegCh1Control, value);
+		device.WriteRegister(kRegCh1Control, 1, BIT(0), 0);
+		CHECK(device.StopAccessProfiling());
+		CHECK_FALSE(device.StopAccessProfiling());			//	Already stopped
+		device.ReadRegister(kRegGlobalControl, value);		//	Not tallied
+		CHECK(device.GetAccessProfile(profile));
+		CHECK_EQ(profile.TotalCalls(), 7);
+		CHECK_EQ(profile.TotalCalls(NTV2AccessKind_ReadRegister), 6);
+		REQUIRE_EQ(profile.fByKey.size(), 3);
+		CHECK_EQ(profile.fByKey.front().fKey, ULWord(kRegGlobalControl));
+		CHECK_EQ(profile.fByKey.front().fCalls, 5);
+		CHECK_EQ(profile.fByKey.front().KeyName(), CNTV2RegisterExpert::GetDisplayName(kRegGlobalControl));
+		CHECK_FALSE(profile.fByCaller.empty());
+		ostringstream oss;
+		profile.Print(oss);
+		CHECK(oss.str().find("6 reads, 1 writes") != string::npos);
+		CHECK(device.StartAccessProfiling());				//	Resets tallies
+		CHECK(device.GetAccessProfile(profile));
+		CHECK_EQ(profile.TotalCalls(), 0);
+		device.ReadRegister(kRegGlobalControl, value);
+		CHECK(device.StartAccessProfiling());				//	Resets tallies even while profiling
+		CHECK(device.GetAccessProfile(profile));
+		CHECK_EQ(profile.TotalCalls(), 0);
+	}	//	TEST_CASE("DriverInterface")
+}	//	TEST_SUITE("AccessProfiler")
+
+
+TEST_SUITE("SDRAMDump" * doctest::description("Compact SDRAM dump frame encoding"))
+{
+	static void RoundTrip (const NTV2Buffer & inFrame, const NTV2SDRAMDumpEncoding inExpected)
+	{
+		NTV2Buffer encoded(inFrame.GetByteCount()), decoded(inFrame.GetByteCount());
+		NTV2SDRAMDumpFrameInfo info;
+		REQUIRE(NTV2EncodeSDRAMDumpFrame(inFrame, encoded, info));
+		CHECK_EQ(info.fEncoding, ULWord(inExpected));
+		const NTV2Buffer & payload (inExpected == NTV2SDRAMDumpEncoding_Raw ? inFrame : encoded);
+		decoded.Fill(UByte(0xA5));
+		CHECK(NTV2DecodeSDRAMDumpFrame(info, info.fEncodedBytes ? payload.GetHostPointer() : AJA_NULL, decoded, decoded.GetByteCount()));
+		CHECK(decoded.IsContentEqual(inFrame));
+	}
+
+	TEST_CASE("EncodeDecode")
+	{
+		const ULWord frameBytes (64 * 1024);
+		NTV2Buffer frame(frameBytes);
+		ULWord * pWords (frame);
+		const size_t numWords (frameBytes / sizeof(ULWord));
+
+		frame.Fill(ULWord(0));								//	All zeroes:  elided
+		RoundTrip(frame, NTV2SDRAMDumpEncoding_Fill);
+		frame.Fill(ULWord(0x10801080));						//	Constant:  elided
+		RoundTrip(frame, NTV2SDRAMDumpEncoding_Fill);
+		for (size_t ndx(0);  ndx < numWords;  ndx += 997)	//	Mostly constant:  run-length encoded
+			pWords[ndx] = ULWord(ndx);
+		pWords[numWords - 1] = 0xFFFFFFFF;
+		pWords[numWords - 2] = 0xEEEEEEEE;
+		RoundTrip(frame, NTV2SDRAMDumpEncoding_RLE32);
+		for (size_t ndx(0);  ndx < numWords;  ndx++)		//	Incompressible:  stored raw
+			pWords[ndx] = ULWord(ndx * 2654435761U);
+		RoundTrip(frame, NTV2SDRAMDumpEncoding_Raw);
+
+		NTV2SDRAMDumpFrameInfo info;						//	Missing:  zeroes
+		info.fOffset = info.fEncodedBytes = info.fFillValue = info.fReserved = 0;
+		info.fEncoding = NTV2SDRAMDumpEncoding_Missing;
+		CHECK(NTV2DecodeSDRAMDumpFrame(info, AJA_NULL, frame, frameBytes));
+		CHECK_EQ(pWords[numWords / 2], 0);
+		NTV2Buffer tooSmall(frameBytes / 2);
+		CHECK_FALSE(NTV2EncodeSDRAMDumpFrame(frame, tooSmall, info));
+	}	//	TEST_CASE("EncodeDecode")
+}	//	TEST_SUITE("SDRAMDump")
+
+
+TEST_SUITE("FrameShare" * doctest::description("Shared-memory frame ring publisher & subscribers"))
+{
+	static const string	kRingName	("ut_ajantv2_framering");
+
+	static void PublishFrame (CNTV2FramePublisher & inPublisher, const ULWord inValue)
+	{
+		NTV2Buffer video(64 * 1024), audio(4096), anc(256), noAnc;
+		video.Fill(inValue);  audio.Fill(~inValue);  anc.Fill(UByte(inValue));
+		FRAME_STAMP stamp;
+		stamp.acFrameTime = LWord64(inValue) * 1000;
+		stamp.acTimeCodes.Allocate(NTV2_MAX_NUM_TIMECODE_INDEXES * sizeof(NTV2_RP188));
+		stamp.SetInputTimecode(NTV2_TCINDEX_SDI1, NTV2_RP188(0, inValue, 0));
+		REQUIRE(inPublisher.Publish(video, audio, anc, noAnc, stamp));
+	}
+
+	TEST_CASE("PublishSubscribe")
+	{
+		CNTV2FramePublisher publisher;
+		CNTV2FrameSubscriber sub1, sub2;
+		NTV2SharedFrame frame;
+		CHECK_FALSE(publisher.Create(kRingName, NTV2FrameRingConfig()));	//	No video capacity
+		REQUIRE(publisher.Create(kRingName, NTV2FrameRingConfig(64 * 1024, 4096, 256, 0, 4, 2)));
+		const ULWord64 firstSeq (publisher.GetPublishedCount());
+		REQUIRE(sub1.Open(kRingName));
+		REQUIRE(sub2.Open(kRingName));
+		CNTV2FrameSubscriber sub3;
+		CHECK_FALSE(sub3.Open(kRingName));			//	Only 2 readers allowed
+		CHECK_FALSE(sub1.NextFrame(frame));			//	Nothing published yet
+
+		PublishFrame(publisher, 1);
+		PublishFrame(publisher, 2);
+		REQUIRE(sub1.NextFrame(frame));
+		CHECK_EQ(frame.fSequence, firstSeq);
+		REQUIRE(frame.fVideo);
+		CHECK_EQ(frame.fVideoBytes, 64 * 1024);
+		CHECK_EQ(reinterpret_cast<const ULWord*>(frame.fVideo)[100], 1);
+		CHECK_EQ(frame.fAudioBytes, 4096);
+		CHECK_EQ(reinterpret_cast<const ULWord*>(frame.fAudio)[0], ~ULWord(1));
+		CHECK_EQ(frame.fAncBytes, 256);
+		CHECK_EQ(frame.fAncF2, (const UByte*)AJA_NULL);
+		FRAME_STAMP stamp;
+		REQUIRE(sub1.GetFrameStamp(frame, stamp));
+		CHECK_EQ(stamp.acFrameTime, 1000);
+		NTV2_RP188 tc;
+		CHECK(stamp.GetInputTimeCode(tc, NTV2_TCINDEX_SDI1));
+		CHECK_EQ(tc.fLo, 1);
+		CHECK(sub1.IsFrameValid(frame));
+		REQUIRE(sub1.NextFrame(frame));
+		CHECK_EQ(frame.fSequence, firstSeq + 1);
+		CHECK_FALSE(sub1.NextFrame(frame, 5));		//	Times out
+
+		//	sub2 hasn't read anything. Lap it: 4 slots, so only the newest 3 frames are readable...
+		for (ULWord value(3);  value <= 8;  value++)
+			PublishFrame(publisher, value);
+		NTV2FrameRingReaderStatsList stats;
+		REQUIRE(publisher.GetReaderStats(stats));
+		REQUIRE_EQ(stats.size(), 2);
+		CHECK_EQ(stats.at(0).fFramesRead, 2);
+		CHECK_EQ(stats.at(0).fLag, 6);
+		CHECK_EQ(stats.at(1).fLag, 8);
+		REQUIRE(sub2.NextFrame(frame));
+		CHECK_EQ(frame.fSequence, firstSeq + 5);
+		CHECK_EQ(reinterpret_cast<const ULWord*>(frame.fVideo)[0], 6);
+		NTV2FrameRingReaderStats myStats;
+		REQUIRE(sub2.GetStats(myStats));
+		CHECK_EQ(myStats.fFramesDropped, 5);
+		CHECK_EQ(myStats.fFramesRead, 1);
+		CHECK_EQ(myStats.fLag, 2);
+		CHECK(sub2.IsFrameValid(frame));
+		PublishFrame(publisher, 9);
+		PublishFrame(publisher, 10);
+		CHECK_FALSE(sub2.IsFrameValid(frame));		//	Frame 6's slot was reused by frame 10
+
+		//	Zero-copy publishing...
+		AUTOCIRCULATE_TRANSFER xfer;
+		REQUIRE(publisher.AcquireSlot(xfer));
+		::memset(xfer.acVideoBuffer.GetHostPointer(), 0x42, xfer.acVideoBuffer.GetByteCount());
+		REQUIRE(publisher.PublishSlot(xfer));
+		CHECK_FALSE(publisher.PublishSlot(xfer));	//	Not acquired
+		while (sub2.NextFrame(frame))
+			if (frame.fSequence == publisher.GetPublishedCount() - 1)
+				break;
+		CHECK_EQ(frame.fSequence, publisher.GetPublishedCount() - 1);
+		CHECK_EQ(frame.fVideo[1000], 0x42);
+		CHECK_EQ(frame.fAudioBytes, 0);				//	Nothing "captured"
+
+		sub2.Close();
+		REQUIRE(sub3.Open(kRingName));				//	Reader slot freed
+		REQUIRE(publisher.GetReaderStats(stats));
+		CHECK_EQ(stats.size(), 2);
+	}	//	TEST_CASE("PublishSubscribe")
+}	//	TEST_SUITE("FrameShare")
+
+//	Steps a seeded linear congruential generator, for repeatable pseudo-random test data
+static inline ULWord NextRandom (ULWord & inOutSeed)
+{
+	inOutSeed = inOutSeed * 1664525 + 1013904223;
+	return inOutSeed;
+}
+
+//	Fills a buffer with repeatable pseudo-random words (by default keeping v210/RGB10 pad bits clear)
+static void FillRandom (NTV2Buffer & outBuffer, ULWord inSeed, const ULWord inMask = 0x3FFFFFFF)
+{
+	ULWord * pWords (outBuffer);
+	for (ULWord ndx(0);  ndx < outBuffer.GetByteCount() / 4;  ndx++)
+		pWords[ndx] = NextRandom(inSeed) & inMask;
+}
+
+//	Runs inProcess (which writes its result into the given buffer) with inProcessor's SIMD path disabled, then
+//	enabled, and checks that both paths produce the same bytes
+template <typename Processor, typename Process>
+static void CheckSIMDMatchesScalar (Processor & inProcessor, const ULWord inOutputBytes, Process inProcess)
+{
+	NTV2Buffer outScalar(inOutputBytes),  outSIMD(inOutputBytes);
+	inProcessor.SetUseSIMD(false);
+	CHECK(inProcess(outScalar));
+	inProcessor.SetUseSIMD(true);
+	CHECK(inProcess(outSIMD));
+	CHECK(outSIMD.IsContentEqual(outScalar));
+}
+
+TEST_SUITE("Deinterlacer" * doctest::description("CNTV2Deinterlacer"))
+{
+	TEST_CASE("SIMDMatchesScalar")
+	{
+		const NTV2PixelFormat pfs[] = {NTV2_FBF_8BIT_YCBCR, NTV2_FBF_10BIT_YCBCR, NTV2_FBF_ARGB, NTV2_FBF_10BIT_RGB};
+		AJAWorkerPool pool(3);
+		CNTV2Deinterlacer deinterlacer(&pool);
+		for (size_t pfNdx(0);  pfNdx < sizeof(pfs)/sizeof(pfs[0]);  pfNdx++)
+		{
+			const NTV2FormatDescriptor fd (NTV2_STANDARD_1080, pfs[pfNdx]);
+			REQUIRE(fd.IsValid());
+			NTV2Buffer cur(fd.GetTotalBytes()), prev(fd.GetTotalBytes());
+			FillRandom(cur, 1);
+			prev = cur;
+			//	Change every other word of the previous frame, some beyond the motion threshold, some not
+			ULWord * pPrev (prev);
+			for (ULWord ndx(0);  ndx < prev.GetByteCount() / 4;  ndx += 2)
+				pPrev[ndx] ^= (ndx & 2) ? 0x00000001 : 0x00000180;
+			for (int mode(NTV2_DEINTERLACE_BOB);  mode < NTV2_DEINTERLACE_INVALID;  mode++)
+				for (int field(NTV2_FIELD0);  field <= NTV2_FIELD1;  field++)
+					CheckSIMDMatchesScalar(deinterlacer, fd.GetTotalBytes(), [&](NTV2Buffer & out)
+						{return deinterlacer.Deinterlace(cur, out, fd, NTV2DeinterlaceMode(mode), NTV2FieldID(field), prev);});
+		}
+	}
+
+	TEST_CASE("Modes")
+	{
+		CNTV2Deinterlacer deinterlacer;
+		const NTV2FormatDescriptor fd (NTV2_STANDARD_1080, NTV2_FBF_10BIT_YCBCR);
+		const ULWord wordsPerLine (fd.GetBytesPerRow() / 4),  numLines (fd.GetRasterHeight());
+		NTV2Buffer frame(fd.GetTotalBytes()), prev(fd.GetTotalBytes()), out(fd.GetTotalBytes());
+
+		//	Even lines are all 200, odd lines all 100 (in all three components)
+		const ULWord even (200 | 200 << 10 | 200 << 20),  odd (100 | 100 << 10 | 100 << 20),  mid (150 | 150 << 10 | 150 << 20);
+		for (ULWord line(0);  line < numLines;  line++)
+			for (ULWord ndx(0);  ndx < wordsPerLine;  ndx++)
+				frame.U32(int(line * wordsPerLine + ndx)) = (line & 1) ? odd : even;
+
+		//	Bob keeping field 0 leaves only even lines' values
+		CHECK(deinterlacer.Deinterlace(frame, out, fd, NTV2_DEINTERLACE_BOB, NTV2_FIELD0));
+		CHECK(out.U32(0) == even);
+		CHECK(out.U32(int(wordsPerLine)) == even);
+		CHECK(out.U32(int(numLines * wordsPerLine - 1)) == even);
+		//	...keeping field 1 leaves only odd lines' values
+		CHECK(deinterlacer.Deinterlace(frame, out, fd, NTV2_DEINTERLACE_BOB, NTV2_FIELD1));
+		CHECK(out.U32(0) == odd);
+		CHECK(out.U32(int(wordsPerLine)) == odd);
+
+		//	Blend mixes them: (1,2,1)/4 makes every line the same
+		CHECK(deinterlacer.Deinterlace(frame, out, fd, NTV2_DEINTERLACE_BLEND));
+		CHECK(out.U32(int(2 * wordsPerLine)) == mid);
+		CHECK(out.U32(int(3 * wordsPerLine)) == mid);
+		NTV2Buffer sameBuffer(frame.GetHostPointer(), frame.GetByteCount());
+		CHECK_FALSE(deinterlacer.Deinterlace(frame, sameBuffer, fd, NTV2_DEINTERLACE_BLEND));	//	Can't blend in place
+
+		//	Motion-adaptive weaves a still picture...
+		CHECK_FALSE(deinterlacer.Deinterlace(frame, out, fd, NTV2_DEINTERLACE_MOTION_ADAPTIVE));	//	Needs previous frame
+		prev = frame;
+		CHECK(deinterlacer.Deinterlace(frame, out, fd, NTV2_DEINTERLACE_MOTION_ADAPTIVE, NTV2_FIELD0, prev));
+		CHECK(out.IsContentEqual(frame));
+		//	...and interpolates where it moved
+		prev.U32(int(wordsPerLine + 5)) = 0;
+		CHECK(deinterlacer.Deinterlace(frame, out, fd, NTV2_DEINTERLACE_MOTION_ADAPTIVE, NTV2_FIELD0, prev));
+		CHECK(out.U32(int(wordsPerLine + 4)) == odd);
+		CHECK(out.U32(int(wordsPerLine + 5)) == even);
+
+		//	In place
+		CHECK(deinterlacer.Deinterlace(frame, frame, fd, NTV2_DEINTERLACE_BOB, NTV2_FIELD0));
+		CHECK(frame.U32(int(wordsPerLine)) == even);
+
+		//	Unsupported
+		CHECK_FALSE(CNTV2Deinterlacer::CanDeinterlace(NTV2_FBF_10BIT_DPX));
+		CHECK_FALSE(deinterlacer.Deinterlace(frame, out, NTV2FormatDescriptor(NTV2_STANDARD_1080, NTV2_FBF_10BIT_DPX)));
+		CHECK_FALSE(deinterlacer.Deinterlace(frame, out, NTV2FormatDescriptor(NTV2_STANDARD_1080, NTV2_FBF_8BIT_YCBCR_420PL3)));
+	}
+
+}	//	TEST_SUITE("Deinterlacer")
+
+
+TEST_SUITE("Scaler" * doctest::description("CNTV2Scaler"))
+{
+	//	Fills a 10-bit RGB raster with the same value in all 3 components, as a function of the pixel's column
+	static void FillColumns (NTV2Buffer & outBuffer, const NTV2FormatDescriptor & inFD, const vector<UWord> & inColumnValues)
+	{
+		for (ULWord line(0);  line < inFD.GetRasterHeight();  line++)
+			for (ULWord x(0);  x < inFD.GetRasterWidth();  x++)
+			{
+				const ULWord v (inColumnValues.at(x));
+				outBuffer.U32(int(line * inFD.GetRasterWidth() + x)) = v << 20 | v << 10 | v;
+			}
+	}
+
+	TEST_CASE("SIMDMatchesScalar")
+	{
+		const NTV2PixelFormat pfs[] = {NTV2_FBF_10BIT_YCBCR, NTV2_FBF_8BIT_YCBCR, NTV2_FBF_8BIT_YCBCR_YUY2, NTV2_FBF_10BIT_RGB, NTV2_FBF_ABGR, NTV2_FBF_24BIT_RGB};
+		const ULWord sizes[][2] = {{480, 270}, {1280, 720}, {2560, 1440}, {318, 2}};
+		AJAWorkerPool pool(3);
+		CNTV2Scaler scaler(NTV2_SCALER_FILTER_LANCZOS, 6, &pool);
+		for (size_t pfNdx(0);  pfNdx < sizeof(pfs)/sizeof(pfs[0]);  pfNdx++)
+		{
+			const NTV2FormatDescriptor fd (NTV2_STANDARD_1080, pfs[pfNdx]);
+			REQUIRE(fd.IsValid());
+			NTV2Buffer frame(fd.GetTotalBytes());
+			FillRandom(frame, ULWord(pfNdx + 1));
+			for (size_t sizeNdx(0);  sizeNdx < sizeof(sizes)/sizeof(sizes[0]);  sizeNdx++)
+			{
+				const ULWord outW (sizes[sizeNdx][0]),  outH (sizes[sizeNdx][1]);
+				const ULWord outBytes (CNTV2Scaler::GetRowBytes(pfs[pfNdx], outW) * outH);
+				for (int filter(NTV2_SCALER_FILTER_BILINEAR);  filter < NTV2_SCALER_FILTER_INVALID;  filter++)
+				{
+					CHECK(scaler.SetFilter(NTV2ScalerFilter(filter)));
+					CheckSIMDMatchesScalar(scaler, outBytes, [&](NTV2Buffer & out) {return scaler.Scale(frame, fd, out, outW, outH);});
+				}
+			}
+		}
+	}
+
+	TEST_CASE("Quality")
+	{
+		const NTV2FormatDescriptor fd (NTV2_STANDARD_1080, NTV2_FBF_10BIT_RGB);
+		const ULWord inW (fd.GetRasterWidth()),  outW (inW / 4),  outH (fd.GetRasterHeight() / 4);
+		NTV2Buffer frame(fd.GetTotalBytes()),  out(outW * outH * 4);
+		vector<UWord> columns(inW);
+		CNTV2Scaler scaler;
+
+		//	A smooth sinusoid must survive a 4:1 downscale intact...
+		const double kPi (3.14159265358979323846),  period (240.0);
+		for (ULWord x(0);  x < inW;  x++)
+			columns[x] = UWord(512.0 + 400.0 * std::sin(2.0 * kPi * x / period) + 0.5);
+		FillColumns(frame, fd, columns);
+		REQUIRE(scaler.Scale(frame, fd, out, outW, outH));
+		double sumSqErr (0.0);
+		for (ULWord x(0);  x < outW;  x++)
+		{
+			const double expected (512.0 + 400.0 * std::sin(2.0 * kPi * ((x + 0.5) * 4.0 - 0.5) / period)),
+						err (double(out.U32(int(outH / 2 * outW + x)) & 0x3FF) - expected);
+			sumSqErr += err * err;
+		}
+		const double psnr (10.0 * std::log10(1023.0 * 1023.0 / (sumSqErr / outW + 1e-9)));
+		MESSAGE("Lanczos-3 4:1 downscale of smooth sinusoid: PSNR " << psnr << " dB");
+		CHECK(psnr > 45.0);
+
+		//	...while detail finer than the output can represent must be filtered out, not aliased.
+		//	The legacy (unfiltered cubic interpolation) ReSampleLine turns alternating columns into a flat
+		//	black or white line, depending on phase.
+		for (ULWord x(0);  x < inW;  x++)
+			columns[x] = (x & 1) ? 1000 : 24;
+		FillColumns(frame, fd, columns);
+		REQUIRE(scaler.Scale(frame, fd, out, outW, outH));
+		vector<Word> legacyIn(inW + 4), legacyOut(outW);
+		for (ULWord x(0);  x < inW;  x++)
+			legacyIn[x + 1] = Word(columns[x]);
+		::ReSampleLine(&legacyIn[1], &legacyOut[0], 0, UWord(inW), LWord(inW), LWord(outW));
+		ULWord maxErr (0),  maxLegacyErr (0);
+		for (ULWord x(2);  x < outW - 2;  x++)
+		{
+			const LWord v (LWord(out.U32(int(outH / 2 * outW + x)) & 0x3FF));
+			maxErr = std::max(maxErr, ULWord(std::abs(v - 512)));
+			maxLegacyErr = std::max(maxLegacyErr, ULWord(std::abs(LWord(legacyOut[x]) - 512)));
+		}
+		MESSAGE("Max deviation from mean of 4:1 downscaled 1-pixel stripes: " << maxErr << " (legacy ReSampleLine: " << maxLegacyErr << ")");
+		CHECK(maxErr < 16);
+		CHECK(maxLegacyErr > 400);
+
+		//	Same size with a bilinear filter is an identity
+		CHECK(scaler.SetFilter(NTV2_SCALER_FILTER_BILINEAR));
+		NTV2Buffer same(fd.GetTotalBytes());
+		CHECK(scaler.Scale(frame, fd, same, fd.GetRasterWidth(), fd.GetRasterHeight()));
+		CHECK(same.IsContentEqual(frame));
+	}
+
+	TEST_CASE("Speed")
+	{
+		const NTV2FormatDescriptor fd (NTV2_STANDARD_1080, NTV2_FBF_10BIT_YCBCR);
+		NTV2Buffer frame(fd.GetTotalBytes()),  out(CNTV2Scaler::GetRowBytes(NTV2_FBF_10BIT_YCBCR, 1280) * 720);
+		FillRandom(frame, 7);
+		CNTV2Scaler scaler;
+		for (int simd(0);  simd < 2;  simd++)
+		{
+			scaler.SetUseSIMD(simd != 0);
+			CHECK(scaler.Scale(frame, fd, out, 1280, 720));	//	Builds the tables
+			const uint64_t start (AJATime::GetSystemMicroseconds());
+			for (int n(0);  n < 3;  n++)
+				CHECK(scaler.Scale(frame, fd, out, 1280, 720));
+			MESSAGE("1080 v210 => 720 Lanczos-3 " << string(scaler.GetUseSIMD() ? "SIMD" : "scalar") << ": "
+					<< (AJATime::GetSystemMicroseconds() - start) / 3 << " us/frame");
+		}
+	}
+
+	TEST_CASE("Invalid")
+	{
+		CNTV2Scaler scaler;
+		const NTV2FormatDescriptor fd (NTV2_STANDARD_1080, NTV2_FBF_10BIT_YCBCR);
+		NTV2Buffer frame(fd.GetTotalBytes()),  out(fd.GetTotalBytes());
+		CHECK_FALSE(scaler.SetFilter(NTV2_SCALER_FILTER_INVALID));
+		CHECK_FALSE(scaler.SetFilter(NTV2_SCALER_FILTER_LANCZOS, 5));
+		CHECK(scaler.GetFilter() == NTV2_SCALER_FILTER_LANCZOS);
+		CHECK(scaler.GetTaps() == 6);
+		CHECK_FALSE(scaler.Scale(frame, fd, out, 641, 360));	//	Odd 4:2:2 width
+		CHECK_FALSE(scaler.Scale(frame, fd, out, 0, 360));
+		CHECK_FALSE(scaler.Scale(frame, fd, out, 3840, 2160));	//	Destination too small
+		CHECK_FALSE(scaler.Scale(frame, fd, out, 640, 360, 100));	//	Line pitch too small
+		CHECK_FALSE(CNTV2Scaler::CanScale(NTV2_FBF_10BIT_DPX));
+		CHECK_FALSE(scaler.Scale(frame, NTV2FormatDescriptor(NTV2_STANDARD_1080, NTV2_FBF_10BIT_DPX), out, 640, 360));
+		CHECK(scaler.Scale(frame, fd, out, 640, 360));
+	}
+
+}	//	TEST_SUITE("Scaler")
+
+
+TEST_SUITE("PixelFormatConverter" * doctest::description("CNTV2PixelFormatConverter"))
+{
+	static const NTV2PixelFormat sPFCFormats[] = {NTV2_FBF_10BIT_YCBCR, NTV2_FBF_8BIT_YCBCR, NTV2_FBF_8BIT_YCBCR_YUY2, NTV2_FBF_ARGB,
+													NTV2_FBF_RGBA, NTV2_FBF_ABGR, NTV2_FBF_24BIT_RGB, NTV2_FBF_24BIT_BGR, NTV2_FBF_10BIT_RGB,
+													NTV2_FBF_10BIT_DPX, NTV2_FBF_10BIT_DPX_LE, NTV2_FBF_48BIT_RGB};
+	static const size_t sNumPFCFormats (sizeof(sPFCFormats) / sizeof(sPFCFormats[0]));
+	static const NTV2PixelFormat sPFCPlanarFormats[] = {NTV2_FBF_8BIT_YCBCR_420PL2, NTV2_FBF_8BIT_YCBCR_422PL2, NTV2_FBF_8BIT_YCBCR_420PL3,
+													NTV2_FBF_8BIT_YCBCR_422PL3, NTV2_FBF_10BIT_YCBCR_420PL3_LE, NTV2_FBF_10BIT_YCBCR_422PL3_LE,
+													NTV2_FBF_10BIT_YCBCR_420PL2, NTV2_FBF_10BIT_YCBCR_422PL2};
+	static const size_t sNumPFCPlanarFormats (sizeof(sPFCPlanarFormats) / sizeof(sPFCPlanarFormats[0]));
+
+	//	Fills a v210 raster with in-gamut YCbCr values
+	static void FillYCbCr (NTV2Buffer & outBuffer, const NTV2FormatDescriptor & inFD)
+	{
+		vector<UWord> line (inFD.GetRasterWidth() * 2 + 12);
+		for (ULWord y(0);  y < inFD.GetRasterHeight();  y++)
+		{
+			for (ULWord x(0);  x < inFD.GetRasterWidth();  x += 2)
+			{
+				line[x * 2 + 0] = UWord(480 + (x + y) % 64);		//	Cb
+				line[x * 2 + 1] = UWord(300 + (x * 3 + y) % 400);	//	Y
+				line[x * 2 + 2] = UWord(480 + (x + 2 * y) % 64);	//	Cr
+				line[x * 2 + 3] = UWord(300 + (x * 3 + y + 1) % 400);
+			}
+			::PackLine_16BitYUVto10BitYUV(&line[0], reinterpret_cast<ULWord*>(outBuffer.GetHostAddress(y * inFD.GetBytesPerRow())), inFD.GetRasterWidth());
+		}
+	}
+
+	static bool Convert (CNTV2PixelFormatConverter & inConverter, const NTV2Buffer & inFrame, const NTV2Standard inStandard,
+						const NTV2PixelFormat inSrcPF, NTV2Buffer & outFrame, const NTV2PixelFormat inDstPF)
+	{
+		const NTV2FormatDescriptor dstFD (inStandard, inDstPF);
+		if (outFrame.GetByteCount() != dstFD.GetTotalBytes())
+			outFrame.Allocate(dstFD.GetTotalBytes());
+		outFrame.Fill(ULWord(0));
+		return inConverter.Convert(inFrame, NTV2FormatDescriptor(inStandard, inSrcPF), outFrame, dstFD);
+	}
+
+	TEST_CASE("Plans")
+	{
+		CHECK(CNTV2PixelFormatConverter::GetPlan(NTV2_FBF_10BIT_YCBCR, NTV2_FBF_10BIT_DPX) == "v210 > yuv16 > rgba10 > dpx");
+		CHECK(CNTV2PixelFormatConverter::GetPlan(NTV2_FBF_10BIT_YCBCR, NTV2_FBF_8BIT_YCBCR) == "v210 > 2vuy");
+		CHECK(CNTV2PixelFormatConverter::GetPlan(NTV2_FBF_8BIT_YCBCR_YUY2, NTV2_FBF_10BIT_YCBCR) == "yuy2 > yuv16 > v210");
+		CHECK(CNTV2PixelFormatConverter::GetPlan(NTV2_FBF_10BIT_YCBCR, NTV2_FBF_48BIT_RGB) == "v210 > yuv16 > rgba16 > rgb48");
+		CHECK(CNTV2PixelFormatConverter::GetPlan(NTV2_FBF_48BIT_RGB, NTV2_FBF_8BIT_YCBCR) == "rgb48 > rgba16 > rgba10 > yuv16 > 2vuy");
+		CHECK(CNTV2PixelFormatConverter::GetPlan(NTV2_FBF_RGBA, NTV2_FBF_10BIT_DPX_LE) == "rgba > argb > rgba10 > dpxle");	//	Stays RGB
+		CHECK(CNTV2PixelFormatConverter::GetPlan(NTV2_FBF_ABGR, NTV2_FBF_ABGR) == "abgr > abgr");
+		CHECK_FALSE(CNTV2PixelFormatConverter::CanConvert(NTV2_FBF_10BIT_YCBCR, NTV2_FBF_10BIT_RGB_PACKED));
+		CHECK(CNTV2PixelFormatConverter::GetPlan(NTV2_FBF_10BIT_RGB_PACKED, NTV2_FBF_ARGB).empty());
+		CHECK(CNTV2PixelFormatConverter::GetPlanCost(NTV2_FBF_10BIT_YCBCR, NTV2_FBF_10BIT_RGB_PACKED) == 0);
+		for (size_t src(0);  src < sNumPFCFormats;  src++)
+			for (size_t dst(0);  dst < sNumPFCFormats;  dst++)
+			{
+				CHECK(CNTV2PixelFormatConverter::CanConvert(sPFCFormats[src], sPFCFormats[dst]));
+				CHECK(CNTV2PixelFormatConverter::GetPlanCost(sPFCFormats[src], sPFCFormats[dst]) > 0);
+			}
+		const size_t numPlans (CNTV2PixelFormatConverter::GetNumCachedPlans());
+		CHECK(numPlans >= sNumPFCFormats * sNumPFCFormats);
+		CHECK(CNTV2PixelFormatConverter::CanConvert(NTV2_FBF_10BIT_DPX, NTV2_FBF_ARGB));
+		CHECK(CNTV2PixelFormatConverter::GetNumCachedPlans() == numPlans);	//	Planned once
+	}
+
+	TEST_CASE("PlanarPlans")
+	{
+		CHECK(CNTV2PixelFormatConverter::GetPlan(NTV2_FBF_10BIT_YCBCR, NTV2_FBF_8BIT_YCBCR_420PL2) == "v210 > yuv16 > 420pl2");
+		CHECK(CNTV2PixelFormatConverter::GetPlan(NTV2_FBF_8BIT_YCBCR, NTV2_FBF_10BIT_YCBCR_422PL3_LE) == "2vuy > yuv16 > 422pl3le10");
+		CHECK(CNTV2PixelFormatConverter::GetPlan(NTV2_FBF_10BIT_YCBCR_420PL2, NTV2_FBF_10BIT_DPX) == "420pl2p10 > yuv16 > rgba10 > dpx");
+		CHECK(CNTV2PixelFormatConverter::GetPlan(NTV2_FBF_8BIT_YCBCR_420PL3, NTV2_FBF_8BIT_YCBCR_420PL2) == "420pl3 > yuv16 > 420pl2");
+		CHECK(CNTV2PixelFormatConverter::GetPlan(NTV2_FBF_8BIT_YCBCR_422PL3, NTV2_FBF_8BIT_YCBCR_422PL3) == "422pl3 > 422pl3");
+		CHECK(CNTV2PixelFormatConverter::GetPlanCost(NTV2_FBF_10BIT_YCBCR, NTV2_FBF_8BIT_YCBCR_420PL2)
+				> CNTV2PixelFormatConverter::GetPlanCost(NTV2_FBF_10BIT_YCBCR, NTV2_FBF_8BIT_YCBCR_422PL2));	//	Chroma filtering
+		for (size_t planar(0);  planar < sNumPFCPlanarFormats;  planar++)
+		{
+			for (size_t packed(0);  packed < sNumPFCFormats;  packed++)
+			{
+				CHECK(CNTV2PixelFormatConverter::CanConvert(sPFCFormats[packed], sPFCPlanarFormats[planar]));
+				CHECK(CNTV2PixelFormatConverter::CanConvert(sPFCPlanarFormats[planar], sPFCFormats[packed]));
+			}
+			for (size_t other(0);  other < sNumPFCPlanarFormats;  other++)
+				CHECK(CNTV2PixelFormatConverter::CanConvert(sPFCPlanarFormats[planar], sPFCPlanarFormats[other]));
+		}
+	}
+
+	TEST_CASE("RoundTrips")
+	{
+		CNTV2PixelFormatConverter converter;
+		const NTV2Standard standards[] = {NTV2_STANDARD_720, NTV2_STANDARD_525};	//	1280 & 720 pixels wide
+		for (size_t stdNdx(0);  stdNdx < sizeof(standards)/sizeof(standards[0]);  stdNdx++)
+		{
+			const NTV2Standard std (standards[stdNdx]);
+			NTV2Buffer src, mid, back;
+
+			//	10-bit RGB survives a trip through the other 10- and 16-bit RGB formats intact
+			const NTV2PixelFormat rgb10Formats[] = {NTV2_FBF_10BIT_DPX, NTV2_FBF_10BIT_DPX_LE, NTV2_FBF_48BIT_RGB};
+			src.Allocate(NTV2FormatDescriptor(std, NTV2_FBF_10BIT_RGB).GetTotalBytes());
+			FillRandom(src, 11, 0x3FFFFFFF);
+			for (size_t ndx(0);  ndx < sizeof(rgb10Formats)/sizeof(rgb10Formats[0]);  ndx++)
+			{
+				CHECK(Convert(converter, src, std, NTV2_FBF_10BIT_RGB, mid, rgb10Formats[ndx]));
+				CHECK(Convert(converter, mid, std, rgb10Formats[ndx], back, NTV2_FBF_10BIT_RGB));
+				CHECK(back.IsContentEqual(src));
+			}
+
+			//	...as does 8-bit RGBA through the other 8-bit RGBA orders
+			const NTV2PixelFormat rgba8Formats[] = {NTV2_FBF_RGBA, NTV2_FBF_ABGR};
+			src.Allocate(NTV2FormatDescriptor(std, NTV2_FBF_ARGB).GetTotalBytes());
+			FillRandom(src, 13, 0xFFFFFFFF);
+			for (size_t ndx(0);  ndx < sizeof(rgba8Formats)/sizeof(rgba8Formats[0]);  ndx++)
+			{
+				CHECK(Convert(converter, src, std, NTV2_FBF_ARGB, mid, rgba8Formats[ndx]));
+				CHECK(Convert(converter, mid, std, rgba8Formats[ndx], back, NTV2_FBF_ARGB));
+				CHECK(back.IsContentEqual(src));
+			}
+
+			//	...and 8-bit YCbCr through v210 and YUY2
+			const NTV2PixelFormat ycbcr8Formats[] = {NTV2_FBF_10BIT_YCBCR, NTV2_FBF_8BIT_YCBCR_YUY2};
+			src.Allocate(NTV2FormatDescriptor(std, NTV2_FBF_8BIT_YCBCR).GetTotalBytes());
+			FillRandom(src, 17, 0xFFFFFFFF);
+			for (size_t ndx(0);  ndx < sizeof(ycbcr8Formats)/sizeof(ycbcr8Formats[0]);  ndx++)
+			{
+				CHECK(Convert(converter, src, std, NTV2_FBF_8BIT_YCBCR, mid, ycbcr8Formats[ndx]));
+				CHECK(Convert(converter, mid, std, ycbcr8Formats[ndx], back, NTV2_FBF_8BIT_YCBCR));
+				CHECK(back.IsContentEqual(src));
+			}
+
+			//	In-gamut v210 through 10- or 16-bit RGB comes back within a code value or two
+			const NTV2FormatDescriptor v210FD (std, NTV2_FBF_10BIT_YCBCR);
+			const NTV2PixelFormat rgbFormats[] = {NTV2_FBF_10BIT_DPX, NTV2_FBF_48BIT_RGB, NTV2_FBF_10BIT_RGB};
+			src.Allocate(v210FD.GetTotalBytes());
+			FillYCbCr(src, v210FD);
+			for (size_t ndx(0);  ndx < sizeof(rgbFormats)/sizeof(rgbFormats[0]);  ndx++)
+			{
+				CHECK(Convert(converter, src, std, NTV2_FBF_10BIT_YCBCR, mid, rgbFormats[ndx]));
+				CHECK(Convert(converter, mid, std, rgbFormats[ndx], back, NTV2_FBF_10BIT_YCBCR));
+				vector<UWord> expected (v210FD.GetRasterWidth() * 2 + 12),  actual (expected.size());
+				LWord maxErr (0);
+				for (ULWord y(0);  y < v210FD.GetRasterHeight();  y++)
+				{
+					::UnpackLine_10BitYUVto16BitYUV(reinterpret_cast<const ULWord*>(src.GetHostAddress(y * v210FD.GetBytesPerRow())), &expected[0], v210FD.GetRasterWidth());
+					::UnpackLine_10BitYUVto16BitYUV(reinterpret_cast<const ULWord*>(back.GetHostAddress(y * v210FD.GetBytesPerRow())), &actual[0], v210FD.GetRasterWidth());
+					for (ULWord x(0);  x < v210FD.GetRasterWidth() * 2;  x++)
+						maxErr = std::max(maxErr, LWord(std::abs(LWord(expected[x]) - LWord(actual[x]))));
+				}
+				MESSAGE(::NTV2StandardToString(std, true) << " v210 => " << ::NTV2FrameBufferFormatToString(rgbFormats[ndx], true) << " => v210 max error " << maxErr);
+				CHECK(maxErr <= 3);
+			}
+		}
+	}
+
+	TEST_CASE("AllPairs")
+	{
+		//	Every pair converts, and the worker threads produce exactly what a single thread does
+		AJAWorkerPool pool(3),  noThreads(0);
+		CNTV2PixelFormatConverter converter(AJA_ColorMatrix_Rec709, &pool),  singleThreaded(AJA_ColorMatrix_Rec709, &noThreads);
+		const NTV2Standard std (NTV2_STANDARD_720);
+		vector<NTV2PixelFormat> formats (sPFCFormats, sPFCFormats + sNumPFCFormats);
+		formats.insert(formats.end(), sPFCPlanarFormats, sPFCPlanarFormats + sNumPFCPlanarFormats);
+		for (size_t src(0);  src < formats.size();  src++)
+		{
+			NTV2Buffer frame(NTV2FormatDescriptor(std, formats.at(src)).GetTotalBytes()),  out, outSingle;
+			FillRandom(frame, ULWord(src + 1), 0x3FFFFFFF);
+			for (size_t dst(0);  dst < formats.size();  dst++)
+			{
+				CHECK(Convert(converter, frame, std, formats.at(src), out, formats.at(dst)));
+				CHECK(Convert(singleThreaded, frame, std, formats.at(src), outSingle, formats.at(dst)));
+				CHECK(out.IsContentEqual(outSingle));
+			}
+		}
+	}
+
+	TEST_CASE("Planar")
+	{
+		CNTV2PixelFormatConverter converter;
+		const NTV2Standard std (NTV2_STANDARD_720);
+		const NTV2FormatDescriptor v210FD (std, NTV2_FBF_10BIT_YCBCR),  twoVuyFD (std, NTV2_FBF_8BIT_YCBCR);
+		NTV2Buffer src, mid, back, other;
+
+		//	4:2:2 planes hold exactly what the packed formats do
+		src.Allocate(twoVuyFD.GetTotalBytes());
+		FillRandom(src, 19, 0xFFFFFFFF);
+		const NTV2PixelFormat planar8[] = {NTV2_FBF_8BIT_YCBCR_422PL2, NTV2_FBF_8BIT_YCBCR_422PL3, NTV2_FBF_10BIT_YCBCR_422PL3_LE, NTV2_FBF_10BIT_YCBCR_422PL2};
+		for (size_t ndx(0);  ndx < sizeof(planar8)/sizeof(planar8[0]);  ndx++)
+		{
+			CHECK(Convert(converter, src, std, NTV2_FBF_8BIT_YCBCR, mid, planar8[ndx]));
+			CHECK(Convert(converter, mid, std, planar8[ndx], back, NTV2_FBF_8BIT_YCBCR));
+			CHECK(back.IsContentEqual(src));
+		}
+		src.Allocate(v210FD.GetTotalBytes());
+		src.Fill(ULWord(0));		//	v210 lines are padded
+		FillYCbCr(src, v210FD);
+		const NTV2PixelFormat planar10[] = {NTV2_FBF_10BIT_YCBCR_422PL3_LE, NTV2_FBF_10BIT_YCBCR_422PL2};
+		for (size_t ndx(0);  ndx < sizeof(planar10)/sizeof(planar10[0]);  ndx++)
+		{
+			CHECK(Convert(converter, src, std, NTV2_FBF_10BIT_YCBCR, mid, planar10[ndx]));
+			CHECK(Convert(converter, mid, std, planar10[ndx], back, NTV2_FBF_10BIT_YCBCR));
+			CHECK(back.IsContentEqual(src));
+		}
+
+		//	4:2:0 planes are repacked between formats without refiltering
+		CHECK(Convert(converter, src, std, NTV2_FBF_10BIT_YCBCR, mid, NTV2_FBF_10BIT_YCBCR_420PL3_LE));
+		CHECK(Convert(converter, mid, std, NTV2_FBF_10BIT_YCBCR_420PL3_LE, other, NTV2_FBF_10BIT_YCBCR_420PL2));
+		CHECK(Convert(converter, other, std, NTV2_FBF_10BIT_YCBCR_420PL2, back, NTV2_FBF_10BIT_YCBCR_420PL3_LE));
+		CHECK(back.IsContentEqual(mid));
+		CHECK(Convert(converter, src, std, NTV2_FBF_10BIT_YCBCR, back, NTV2_FBF_10BIT_YCBCR_420PL2));
+		CHECK(back.IsContentEqual(other));
+
+		//	Luma, and chroma that doesn't change vertically, survive 4:2:0 intact
+		vector<UWord> line (v210FD.GetRasterWidth() * 2 + 12),  actual (line.size());
+		for (ULWord y(0);  y < v210FD.GetRasterHeight();  y++)
+		{
+			for (ULWord x(0);  x < v210FD.GetRasterWidth() * 2;  x += 2)
+				{line[x] = UWord(64 + x % 896);  line[x + 1] = UWord(64 + (x * 7 + y * 13) % 877);}
+			::PackLine_16BitYUVto10BitYUV(&line[0], reinterpret_cast<ULWord*>(src.GetHostAddress(y * v210FD.GetBytesPerRow())), v210FD.GetRasterWidth());
+		}
+		const NTV2PixelFormat planar420[] = {NTV2_FBF_10BIT_YCBCR_420PL3_LE, NTV2_FBF_10BIT_YCBCR_420PL2};
+		for (size_t ndx(0);  ndx < sizeof(planar420)/sizeof(planar420[0]);  ndx++)
+		{
+			CHECK(Convert(converter, src, std, NTV2_FBF_10BIT_YCBCR, mid, planar420[ndx]));
+			CHECK(Convert(converter, mid, std, planar420[ndx], back, NTV2_FBF_10BIT_YCBCR));
+			CHECK(back.IsContentEqual(src));
+		}
+
+		//	Chroma rows are sited midway between lines 2r and 2r+1, so a linear vertical ramp is decimated and interpolated exactly.
+		//	The ramp goes up over the top half of the raster, and back down over the bottom half.
+		const ULWord height (v210FD.GetRasterHeight());
+		for (ULWord y(0);  y < height;  y++)
+		{
+			const ULWord ramp (2 * std::min(y, height - 1 - y));
+			for (ULWord x(0);  x < v210FD.GetRasterWidth() * 2;  x += 4)
+				{line[x] = UWord(64 + ramp);  line[x + 1] = line[x + 3] = 512;  line[x + 2] = UWord(1000 - ramp);}
+			::PackLine_16BitYUVto10BitYUV(&line[0], reinterpret_cast<ULWord*>(src.GetHostAddress(y * v210FD.GetBytesPerRow())), v210FD.GetRasterWidth());
+		}
+		const NTV2FormatDescriptor planarFD (std, NTV2_FBF_10BIT_YCBCR_420PL3_LE);
+		CHECK(Convert(converter, src, std, NTV2_FBF_10BIT_YCBCR, mid, NTV2_FBF_10BIT_YCBCR_420PL3_LE));
+		for (ULWord row(1);  row * 2 + 2 < height / 2;  row++)	//	Top half
+		{
+			const UWord * pCb (reinterpret_cast<const UWord*>(planarFD.GetRowAddress(mid, row, 1)));
+			const UWord * pCr (reinterpret_cast<const UWord*>(planarFD.GetRowAddress(mid, row, 2)));
+			CHECK(pCb[0] == 64 + 4 * row + 1);
+			CHECK(pCr[planarFD.GetRasterWidth() / 2 - 1] == 1000 - 4 * row - 1);
+		}
+		CHECK(Convert(converter, mid, std, NTV2_FBF_10BIT_YCBCR_420PL3_LE, back, NTV2_FBF_10BIT_YCBCR));
+		LWord maxErr (0);
+		for (ULWord y(1);  y + 1 < height;  y++)
+		{
+			const ULWord ramp (2 * std::min(y, height - 1 - y));
+			if (y > height / 2 - 4  &&  y < height / 2 + 4)
+				continue;	//	Skip the peak
+			::UnpackLine_10BitYUVto16BitYUV(reinterpret_cast<const ULWord*>(back.GetHostAddress(y * v210FD.GetBytesPerRow())), &actual[0], v210FD.GetRasterWidth());
+			for (ULWord x(0);  x < v210FD.GetRasterWidth() * 2;  x += 4)
+			{
+				maxErr = std::max(maxErr, LWord(std::abs(LWord(actual[x]) - LWord(64 + ramp))));
+				maxErr = std::max(maxErr, LWord(std::abs(LWord(actual[x + 2]) - LWord(1000 - ramp))));
+			}
+		}
+		CHECK(maxErr == 0);
+	}
+
+	TEST_CASE("Speed")
+	{
+		const NTV2FormatDescriptor fd (NTV2_STANDARD_1080, NTV2_FBF_10BIT_YCBCR);
+		NTV2Buffer frame(fd.GetTotalBytes()),  out;
+		FillYCbCr(frame, fd);
+		CNTV2PixelFormatConverter converter;
+		const NTV2PixelFormat dsts[] = {NTV2_FBF_ARGB, NTV2_FBF_10BIT_DPX, NTV2_FBF_8BIT_YCBCR, NTV2_FBF_8BIT_YCBCR_420PL2, NTV2_FBF_10BIT_YCBCR_420PL3_LE};
+		for (size_t ndx(0);  ndx < sizeof(dsts)/sizeof(dsts[0]);  ndx++)
+		{
+			CHECK(Convert(converter, frame, NTV2_STANDARD_1080, NTV2_FBF_10BIT_YCBCR, out, dsts[ndx]));
+			const uint64_t start (AJATime::GetSystemMicroseconds());
+			for (int n(0);  n < 3;  n++)
+				CHECK(converter.Convert(frame, fd, out, NTV2FormatDescriptor(NTV2_STANDARD_1080, dsts[ndx])));
+			MESSAGE("1080 " << CNTV2PixelFormatConverter::GetPlan(NTV2_FBF_10BIT_YCBCR, dsts[ndx]) << ": "
+					<< (AJATime::GetSystemMicroseconds() - start) / 3 << " us/frame");
+		}
+	}
+
+	TEST_CASE("Invalid")
+	{
+		CNTV2PixelFormatConverter converter;
+		const NTV2FormatDescriptor fd (NTV2_STANDARD_1080, NTV2_FBF_10BIT_YCBCR);
+		NTV2Buffer frame(fd.GetTotalBytes()),  out(fd.GetTotalBytes() * 2);
+		CHECK_FALSE(converter.Convert(frame, fd, out, NTV2FormatDescriptor(NTV2_STANDARD_720, NTV2_FBF_ARGB)));	//	Size mismatch
+		CHECK_FALSE(converter.Convert(frame, fd, out, NTV2FormatDescriptor(NTV2_STANDARD_1080, NTV2_FBF_10BIT_RGB_PACKED)));
+		NTV2Buffer small(fd.GetTotalBytes() / 2);
+		CHECK_FALSE(converter.Convert(frame, fd, small, NTV2FormatDescriptor(NTV2_STANDARD_1080, NTV2_FBF_ARGB)));	//	Destination too small
+		CHECK_FALSE(converter.Convert(small, fd, out, NTV2FormatDescriptor(NTV2_STANDARD_1080, NTV2_FBF_ARGB)));	//	Source too small
+		CHECK(converter.GetColorMatrix() == AJA_ColorMatrix_Rec709);
+		converter.SetColorMatrix(AJA_ColorMatrix_Rec601);
+		CHECK(converter.Convert(frame, fd, out, NTV2FormatDescriptor(NTV2_STANDARD_1080, NTV2_FBF_ARGB)));
+	}
+
+}	//	TEST_SUITE("PixelFormatConverter")
+
+
+TEST_SUITE("QuadRasterConverter" * doctest::description("CNTV2QuadRasterConverter"))
+{
+	static const NTV2PixelFormat sQRCFormats[] = {NTV2_FBF_10BIT_YCBCR, NTV2_FBF_8BIT_YCBCR, NTV2_FBF_ARGB, NTV2_FBF_24BIT_RGB,
+													NTV2_FBF_10BIT_DPX, NTV2_FBF_48BIT_RGB};
+	static const size_t sNumQRCFormats (sizeof(sQRCFormats) / sizeof(sQRCFormats[0]));
+
+	//	Fills a raster's active pixels with random values, and its line padding with zeroes
+	static void FillRaster (NTV2Buffer & outBuffer, const NTV2PixelFormat inPF, const ULWord inWidth, const ULWord inHeight, const ULWord inRowBytes, ULWord inSeed)
+	{
+		outBuffer.Allocate(inRowBytes * inHeight);
+		outBuffer.Fill(ULWord(0));
+		vector<UWord> line ((inWidth + 6) * 2, 0);
+		for (ULWord y(0);  y < inHeight;  y++)
+		{
+			UByte * pRow (reinterpret_cast<UByte*>(outBuffer.GetHostAddress(y * inRowBytes)));
+			if (inPF == NTV2_FBF_10BIT_YCBCR)
+			{
+				for (ULWord ndx(0);  ndx < inWidth * 2;  ndx++)
+					line[ndx] = UWord(NextRandom(inSeed) >> 22);
+				::PackLine_16BitYUVto10BitYUV(&line[0], reinterpret_cast<ULWord*>(pRow), inWidth);
+				continue;
+			}
+			for (ULWord ndx(0);  ndx < inWidth * CNTV2QuadRasterConverter::GetQuadRowBytes(inPF, 4) / 2;  ndx++)
+				pRow[ndx] = UByte(NextRandom(inSeed) >> 24);
+		}
+	}
+
+	TEST_CASE("RowBytes")
+	{
+		for (size_t ndx(0);  ndx < sNumQRCFormats;  ndx++)
+		{
+			CHECK(CNTV2QuadRasterConverter::CanConvert(sQRCFormats[ndx]));
+			CHECK(CNTV2QuadRasterConverter::GetQuadRowBytes(sQRCFormats[ndx], 3840) == NTV2FormatDescriptor(NTV2_STANDARD_1080p, sQRCFormats[ndx]).GetBytesPerRow());
+			CHECK(CNTV2QuadRasterConverter::GetQuadRowBytes(sQRCFormats[ndx], 7680) == NTV2FormatDescriptor(NTV2_STANDARD_3840x2160p, sQRCFormats[ndx]).GetBytesPerRow());
+		}
+		CHECK_FALSE(CNTV2QuadRasterConverter::CanConvert(NTV2_FBF_8BIT_YCBCR_420PL3));
+		CHECK(CNTV2QuadRasterConverter::GetQuadRowBytes(NTV2_FBF_8BIT_YCBCR_420PL3, 3840) == 0);
+		CHECK(::NTV2QuadLayoutToString(NTV2_QUAD_LAYOUT_TSI, true) == "2SI");
+	}
+
+	TEST_CASE("Layouts")
+	{
+		//	Each pixel holds its own coordinates, so where it lands can be checked
+		const ULWord width (3840),  height (2160);
+		const NTV2FormatDescriptor fd (NTV2_STANDARD_3840x2160p, NTV2_FBF_ARGB);
+		NTV2Buffer frame(fd.GetTotalBytes()),  quads[4];
+		for (ULWord y(0);  y < height;  y++)
+			for (ULWord x(0);  x < width;  x++)
+				reinterpret_cast<ULWord*>(frame.GetHostAddress(y * fd.GetBytesPerRow()))[x] = y << 16 | x;
+		for (ULWord quad(0);  quad < 4;  quad++)
+			quads[quad].Allocate(width / 2 * 4 * height / 2);
+		CNTV2QuadRasterConverter converter;
+		REQUIRE(converter.Split(frame, fd, quads, NTV2_QUAD_LAYOUT_SQUARES));
+		for (ULWord quad(0);  quad < 4;  quad++)
+		{
+			const ULWord * pQuad (quads[quad]);
+			CHECK(pQuad[0] == ((quad & 2 ? height / 2 : 0) << 16 | (quad & 1 ? width / 2 : 0)));
+			CHECK(pQuad[width / 2 * height / 2 - 1] == ((quad & 2 ? height - 1 : height / 2 - 1) << 16 | (quad & 1 ? width - 1 : width / 2 - 1)));
+		}
+		REQUIRE(converter.Split(frame, fd, quads, NTV2_QUAD_LAYOUT_TSI));
+		ULWord mismatches (0);
+		for (ULWord quad(0);  quad < 4;  quad++)
+			for (ULWord row(0);  row < height / 2;  row++)
+				for (ULWord col(0);  col < width / 2;  col++)
+				{
+					//	Sub-images 0 & 1 take the even & odd pairs of the even lines, 2 & 3 those of the odd lines
+					const ULWord x ((col / 2) * 4 + (quad & 1) * 2 + (col & 1)),  y (row * 2 + (quad >> 1));
+					if (reinterpret_cast<const ULWord*>(quads[quad].GetHostAddress(row * width / 2 * 4))[col] != (y << 16 | x))
+						mismatches++;
+				}
+		CHECK(mismatches == 0);
+
+		//	v210 pairs straddle 16-byte groups, so compare the unpacked components
+		const NTV2FormatDescriptor v210FD (NTV2_STANDARD_3840x2160p, NTV2_FBF_10BIT_YCBCR);
+		const ULWord quadRowBytes (CNTV2QuadRasterConverter::GetQuadRowBytes(NTV2_FBF_10BIT_YCBCR, width));
+		FillRaster(frame, NTV2_FBF_10BIT_YCBCR, width, height, v210FD.GetBytesPerRow(), 5);
+		for (ULWord quad(0);  quad < 4;  quad++)
+			quads[quad].Allocate(quadRowBytes * height / 2);
+		REQUIRE(converter.Split(frame, v210FD, quads, NTV2_QUAD_LAYOUT_TSI));
+		vector<UWord> line ((width + 6) * 2),  quadLine ((width / 2 + 6) * 2);
+		mismatches = 0;
+		for (ULWord quad(0);  quad < 4;  quad++)
+			for (ULWord row(0);  row < height / 2;  row += 97)
+			{
+				::UnpackLine_10BitYUVto16BitYUV(reinterpret_cast<const ULWord*>(frame.GetHostAddress((row * 2 + (quad >> 1)) * v210FD.GetBytesPerRow())), &line[0], width);
+				::UnpackLine_10BitYUVto16BitYUV(reinterpret_cast<const ULWord*>(quads[quad].GetHostAddress(row * quadRowBytes)), &quadLine[0], width / 2);
+				for (ULWord col(0);  col < width / 2;  col++)
+				{
+					const ULWord x ((col / 2) * 4 + (quad & 1) * 2 + (col & 1));
+					if (quadLine[col * 2] != line[x * 2]  ||  quadLine[col * 2 + 1] != line[x * 2 + 1])
+						mismatches++;
+				}
+			}
+		CHECK(mismatches == 0);
+	}
+
+	TEST_CASE("RoundTrips")
+	{
+		AJAWorkerPool pool(3);
+		CNTV2QuadRasterConverter converter(&pool),  scalar(&pool);
+		scalar.SetUseSIMD(false);
+		const NTV2Standard standards[] = {NTV2_STANDARD_3840x2160p, NTV2_STANDARD_4096x2160p};	//	4096 v210 halves aren't whole 6-pixel groups
+		for (size_t stdNdx(0);  stdNdx < sizeof(standards)/sizeof(standards[0]);  stdNdx++)
+			for (size_t pfNdx(0);  pfNdx < sNumQRCFormats;  pfNdx++)
+			{
+				const NTV2FormatDescriptor fd (standards[stdNdx], sQRCFormats[pfNdx]);
+				const ULWord quadRowBytes (CNTV2QuadRasterConverter::GetQuadRowBytes(fd.GetPixelFormat(), fd.GetRasterWidth()));
+				NTV2Buffer frame, back(fd.GetTotalBytes()),  squares[4],  tsi[4],  tsiScalar[4],  squaresBack[4];
+				FillRaster(frame, fd.GetPixelFormat(), fd.GetRasterWidth(), fd.GetRasterHeight(), fd.GetBytesPerRow(), ULWord(pfNdx + 7));
+				for (ULWord quad(0);  quad < 4;  quad++)
+				{
+					squares[quad].Allocate(quadRowBytes * fd.GetRasterHeight() / 2);	tsi[quad].Allocate(squares[quad].GetByteCount());
+					tsiScalar[quad].Allocate(squares[quad].GetByteCount());				squaresBack[quad].Allocate(squares[quad].GetByteCount());
+				}
+				INFO(::NTV2StandardToString(standards[stdNdx], true) << " " << ::NTV2FrameBufferFormatToString(fd.GetPixelFormat(), true));
+				CHECK(converter.Split(frame, fd, squares, NTV2_QUAD_LAYOUT_SQUARES));
+				CHECK(converter.Join(squares, NTV2_QUAD_LAYOUT_SQUARES, back, fd));
+				CHECK(back.IsContentEqual(frame));
+				CHECK(converter.Split(frame, fd, tsi, NTV2_QUAD_LAYOUT_TSI));
+				CHECK(scalar.Split(frame, fd, tsiScalar, NTV2_QUAD_LAYOUT_TSI));
+				back.Fill(ULWord(0));
+				CHECK(converter.Join(tsi, NTV2_QUAD_LAYOUT_TSI, back, fd));
+				CHECK(back.IsContentEqual(frame));
+				CHECK(converter.Relayout(tsi, NTV2_QUAD_LAYOUT_TSI, squaresBack, NTV2_QUAD_LAYOUT_SQUARES, fd));
+				for (ULWord quad(0);  quad < 4;  quad++)
+				{
+					CHECK(tsi[quad].IsContentEqual(tsiScalar[quad]));
+					CHECK(squaresBack[quad].IsContentEqual(squares[quad]));
+				}
+				CHECK(scalar.Relayout(squares, NTV2_QUAD_LAYOUT_SQUARES, tsiScalar, NTV2_QUAD_LAYOUT_TSI, fd));
+				for (ULWord quad(0);  quad < 4;  quad++)
+					CHECK(tsiScalar[quad].IsContentEqual(tsi[quad]));
+			}
+	}
+
+	TEST_CASE("Speed")
+	{
+		//	8K60 needs each frame reorganized in under 16.7 msec
+		CNTV2QuadRasterConverter converter;
+		const NTV2PixelFormat formats[] = {NTV2_FBF_10BIT_YCBCR, NTV2_FBF_8BIT_YCBCR, NTV2_FBF_ARGB};
+		for (size_t ndx(0);  ndx < sizeof(formats)/sizeof(formats[0]);  ndx++)
+		{
+			const NTV2FormatDescriptor fd (NTV2_STANDARD_7680, formats[ndx]);
+			NTV2Buffer frame(fd.GetTotalBytes()),  quads[4];
+			const ULWord quadBytes (CNTV2QuadRasterConverter::GetQuadRowBytes(formats[ndx], fd.GetRasterWidth()) * fd.GetRasterHeight() / 2);
+			for (ULWord quad(0);  quad < 4;  quad++)
+				quads[quad].Allocate(quadBytes);
+			const NTV2QuadLayout layouts[] = {NTV2_QUAD_LAYOUT_SQUARES, NTV2_QUAD_LAYOUT_TSI};
+			for (size_t layout(0);  layout < 2;  layout++)
+			{
+				CHECK(converter.Split(frame, fd, quads, layouts[layout]));	//	Touch the pages
+				uint64_t start (AJATime::GetSystemMicroseconds());
+				for (int n(0);  n < 3;  n++)
+					CHECK(converter.Split(frame, fd, quads, layouts[layout]));
+				const uint64_t splitUsecs ((AJATime::GetSystemMicroseconds() - start) / 3);
+				start = AJATime::GetSystemMicroseconds();
+				for (int n(0);  n < 3;  n++)
+					CHECK(converter.Join(quads, layouts[layout], frame, fd));
+				const uint64_t joinUsecs ((AJATime::GetSystemMicroseconds() - start) / 3);
+				MESSAGE("8K " << ::NTV2FrameBufferFormatToString(formats[ndx], true) << " " << ::NTV2QuadLayoutToString(layouts[layout], true)
+						<< ": split " << splitUsecs << " us/frame, join " << joinUsecs << " us/frame");
+			}
+		}
+	}
+
+	TEST_CASE("Invalid")
+	{
+		CNTV2QuadRasterConverter converter;
+		const NTV2FormatDescriptor fd (NTV2_STANDARD_1080p, NTV2_FBF_8BIT_YCBCR);
+		NTV2Buffer frame(fd.GetTotalBytes()),  quads[4],  small[4];
+		for (ULWord quad(0);  quad < 4;  quad++)
+			{quads[quad].Allocate(fd.GetTotalBytes() / 4);  small[quad].Allocate(fd.GetTotalBytes() / 8);}
+		CHECK_FALSE(converter.Split(frame, fd, AJA_NULL, NTV2_QUAD_LAYOUT_TSI));
+		CHECK_FALSE(converter.Split(frame, fd, quads, NTV2_QUAD_LAYOUT_INVALID));
+		CHECK_FALSE(converter.Split(frame, fd, small, NTV2_QUAD_LAYOUT_SQUARES));		//	Sub-images too small
+		CHECK_FALSE(converter.Split(frame, fd, quads, NTV2_QUAD_LAYOUT_SQUARES, 100));	//	Line pitch too small
+		CHECK_FALSE(converter.Split(frame, NTV2FormatDescriptor(NTV2_STANDARD_1080p, NTV2_FBF_8BIT_YCBCR_420PL2), quads, NTV2_QUAD_LAYOUT_SQUARES));
+		CHECK_FALSE(converter.Relayout(quads, NTV2_QUAD_LAYOUT_SQUARES, small, NTV2_QUAD_LAYOUT_TSI, fd));
+		NTV2Buffer smallFrame(fd.GetTotalBytes() / 2);
+		CHECK_FALSE(converter.Join(quads, NTV2_QUAD_LAYOUT_TSI, smallFrame, fd));
+		CHECK(converter.Split(frame, fd, quads, NTV2_QUAD_LAYOUT_TSI));
+	}
+
+}	//	TEST_SUITE("QuadRasterConverter")
+
+
+TEST_SUITE("RegisterExpert" * doctest::description("CNTV2RegisterExpert lookup tables")) {
+
+	static const ULWord	kRegExpertLookups	(200000);
+
+	static void RegExpertLookupThread (AJAThread * pThread, void * pContext)
+	{	(void) pThread;
+		ULWord & failures (*reinterpret_cast<ULWord*>(pContext));
+		for (ULWord ndx(0);  ndx < kRegExpertLookups;  ndx++)
+		{
+			const ULWord regNum (kRegCh1Control + ndx % 8);
+			if (!CNTV2RegisterExpert::IsRegisterInClass(regNum, kRegClass_NULL)  &&  CNTV2RegisterExpert::GetDisplayName(regNum).empty())
+				failures++;
+			if (!CNTV2RegisterExpert::IsRegisterInClass(kRegCh1Control, kRegClass_Channel1))
+				failures++;
+		}
+	}
+
+	TEST_CASE("Lookups")
+	{
+		CHECK(CNTV2RegisterExpert::Allocate());
+		CHECK(CNTV2RegisterExpert::IsAllocated());
+		CHECK_EQ(CNTV2RegisterExpert::GetDisplayName(kRegGlobalControl), "kRegGlobalControl");
+		CHECK_EQ(CNTV2RegisterExpert::GetDisplayName(0x000F423F), "Reg 0x000F423F");
+		CHECK_FALSE(CNTV2RegisterExpert::GetDisplayValue(kRegGlobalControl, 0x00000001).empty());
+		CHECK(CNTV2RegisterExpert::GetDisplayValue(0x000F423F, 0x12345678).empty());
+		CHECK(CNTV2RegisterExpert::IsReadOnly(kRegBoardID));
+		CHECK_FALSE(CNTV2RegisterExpert::IsWriteOnly(kRegBoardID));
+		CHECK_FALSE(CNTV2RegisterExpert::IsRegisterInClass(kRegBoardID, "kRegClass_Bogus"));
+		CHECK_FALSE(CNTV2RegisterExpert::IsRegisterInClass(0x000F423F, kRegClass_Audio));
+		CHECK(CNTV2RegisterExpert::GetRegistersForClass("kRegClass_Bogus").empty());
+		CHECK(CNTV2RegisterExpert::GetRegisterClasses(0x000F423F).empty());
+		CHECK_EQ(CNTV2RegisterExpert::GetRegistersWithName("kRegGlobalControl").size(), 1);
+		CHECK_EQ(*CNTV2RegisterExpert::GetRegistersWithName("kRegGlobalControl").begin(), ULWord(kRegGlobalControl));
+
+		//	Every class's registers must agree with IsRegisterInClass and GetRegisterClasses...
+		const NTV2StringSet	classes	(CNTV2RegisterExpert::GetAllRegisterClasses());
+		CHECK(classes.size() > 20);
+		size_t	numMemberships (0);
+		for (NTV2StringSetConstIter it(classes.begin());  it != classes.end();  ++it)
+		{
+			const NTV2RegNumSet	regs (CNTV2RegisterExpert::GetRegistersForClass(*it));
+			CHECK_FALSE(regs.empty());
+			for (NTV2RegNumSetConstIter regIt(regs.begin());  regIt != regs.end();  ++regIt)
+			{
+				CHECK(CNTV2RegisterExpert::IsRegisterInClass(*regIt, *it));
+				const NTV2StringSet	regClasses (CNTV2RegisterExpert::GetRegisterClasses(*regIt));
+				CHECK(regClasses.find(*it) != regClasses.end());
+				CHECK(CNTV2RegisterExpert::GetRegisterClasses(*regIt, true).find(it->substr(10)) != CNTV2RegisterExpert::GetRegisterClasses(*regIt, true).end());
+				numMemberships++;
+			}
+		}
+		size_t	numMembershipsByReg (0);
+		for (ULWord regNum(0);  regNum < 0x10000;  regNum++)
+			numMembershipsByReg += CNTV2RegisterExpert::GetRegisterClasses(regNum).size();
+		CHECK_EQ(numMembershipsByReg + CNTV2RegisterExpert::GetRegisterClasses(kRegPWMFanStatus).size(), numMemberships);
+	}	//	TEST_CASE("Lookups")
+
+	TEST_CASE("Speed")
+	{
+		//	Reallocation (reuses the retired singleton's tables)...
+		CNTV2RegisterExpert::Deallocate();
+		CHECK_FALSE(CNTV2RegisterExpert::IsAllocated());
+		uint64_t	startUs	(AJATime::GetSystemMicroseconds());
+		CHECK(CNTV2RegisterExpert::Allocate());
+		const uint64_t	startupUs	(AJATime::GetSystemMicroseconds() - startUs);
+
+		//	Decode a full register dump...
+		const NTV2RegNumSet	regs (CNTV2RegisterExpert::GetRegistersForDevice(DEVICE_ID_KONA5_8K));
+		startUs = AJATime::GetSystemMicroseconds();
+		size_t	numChars (0);
+		for (NTV2RegNumSetConstIter it(regs.begin());  it != regs.end();  ++it)
+			numChars += CNTV2RegisterExpert::GetDisplayName(*it).length()
+						+ CNTV2RegisterExpert::GetDisplayValue(*it, 0x01234567, DEVICE_ID_KONA5_8K).length()
+						+ CNTV2RegisterExpert::GetRegisterClasses(*it).size();
+		const uint64_t	dumpUs	(AJATime::GetSystemMicroseconds() - startUs);
+		CHECK(numChars > 0);
+
+		//	Look up names and classes from 4 threads at once...
+		ULWord		failures[4]	=	{0, 0, 0, 0};
+		AJAThread	threads[4];
+		startUs = AJATime::GetSystemMicroseconds();
+		for (size_t ndx(0);  ndx < 4;  ndx++)
+			{threads[ndx].Attach(RegExpertLookupThread, &failures[ndx]);  CHECK(AJA_SUCCESS(threads[ndx].Start()));}
+		for (size_t ndx(0);  ndx < 4;  ndx++)
+			while (threads[ndx].Active())
+				AJATime::Sleep(1);
+		const uint64_t	threadsUs	(AJATime::GetSystemMicroseconds() - startUs);
+		for (size_t ndx(0);  ndx < 4;  ndx++)
+			CHECK_EQ(failures[ndx], 0);
+		MESSAGE("RegisterExpert reallocation " << startupUs << "us, " << regs.size() << "-reg dump decode " << dumpUs << "us, "
+				<< 4 * 3 * kRegExpertLookups << " lookups on 4 threads " << threadsUs << "us");
+	}	//	TEST_CASE("Speed")
+
+}	//	TEST_SUITE("RegisterExpert")
+
+
+TEST_SUITE("AudioSignal" * doctest::description("CNTV2AudioSignalGenerator & CNTV2AudioMeter"))
+{
+	static const double	kAudioPi	(3.14159265358979323846);
+
+	TEST_CASE("Generator")
+	{
+		const ULWord numSamples (4800);
+		CNTV2AudioSignalGenerator gen (3);
+		CHECK(gen.SetChannelSignal(0, NTV2_AUDIO_SIGNAL_TONE, 0.5, 1000.0));
+		CHECK(gen.SetChannelSignal(1, NTV2_AUDIO_SIGNAL_TONE, 1.0, 997.0));
+		CHECK(gen.SetChannelSignal(2, NTV2_AUDIO_SIGNAL_WHITE_NOISE, 0.25));
+		NTV2Buffer buffer (numSamples * 3 * 4);
+		CHECK(gen.Generate(buffer, numSamples));
+
+		//	Tones match sin() to within 2 ppm of full scale (mostly the phase accumulator's 11 uHz frequency resolution),
+		//	and noise stays within its amplitude
+		const LWord * pSamples (buffer);
+		double maxError (0.0);
+		bool noiseOK (true);
+		for (ULWord ndx(0);  ndx < numSamples;  ndx++)
+		{
+			const double ref0 (0.5 * ::sin(2.0 * kAudioPi * 1000.0 * ndx / 48000.0) * 2147483648.0);
+			const double ref1 (::sin(2.0 * kAudioPi * 997.0 * ndx / 48000.0) * 2147483648.0);
+			maxError = std::max(maxError, std::fabs(pSamples[ndx * 3] - ref0));
+			maxError = std::max(maxError, std::fabs(pSamples[ndx * 3 + 1] - std::min(ref1, 2147483520.0)));
+			if (std::abs(double(pSamples[ndx * 3 + 2])) > 0.25 * 2147483648.0)
+				noiseOK = false;
+		}
+		CHECK(maxError < 4295.0);
+		CHECK(noiseOK);
+
+		//	Phase-continuous across calls, and SIMD matches scalar
+		gen.Reset();
+		NTV2Buffer firstHalf (numSamples / 2 * 3 * 4),  secondHalf (numSamples / 2 * 3 * 4),  both (buffer.GetByteCount());
+		gen.SetUseSIMD(false);
+		CHECK(gen.Generate(firstHalf, numSamples / 2));
+		gen.SetUseSIMD(CNTV2AudioSignalGenerator::HasSIMD());
+		CHECK(gen.Generate(secondHalf, numSamples / 2));
+		both.CopyFrom(firstHalf, 0, 0, firstHalf.GetByteCount());
+		both.CopyFrom(secondHalf, 0, firstHalf.GetByteCount(), secondHalf.GetByteCount());
+		CHECK(both.IsContentEqual(buffer));
+
+		//	Byte-swapped
+		gen.Reset();
+		CHECK(gen.Generate(both, numSamples, true));
+		const ULWord * pSwapped (both);
+		CHECK_EQ(pSwapped[300], NTV2EndianSwap32(ULWord(pSamples[300])));
+
+		//	Sweep starts at its start frequency, and pink noise is bounded
+		CNTV2AudioSignalGenerator sweep (2);
+		CHECK(sweep.SetChannelSignal(0, NTV2_AUDIO_SIGNAL_SWEEP, 1.0, 100.0, 10000.0, 1.0));
+		CHECK(sweep.SetChannelSignal(1, NTV2_AUDIO_SIGNAL_PINK_NOISE, 1.0));
+		NTV2Buffer sweepBuffer (48000 * 2 * 4);
+		CHECK(sweep.Generate(sweepBuffer, 48000));
+		const LWord * pSweep (sweepBuffer);
+		ULWord firstCrossings (0),  lastCrossings (0);
+		for (ULWord ndx(1);  ndx < 480;  ndx++)
+			if ((pSweep[ndx * 2] < 0) != (pSweep[ndx * 2 - 2] < 0))
+				firstCrossings++;
+		for (ULWord ndx(48000 - 479);  ndx < 48000;  ndx++)
+			if ((pSweep[ndx * 2] < 0) != (pSweep[ndx * 2 - 2] < 0))
+				lastCrossings++;
+		CHECK(firstCrossings >= 1);
+		CHECK(firstCrossings <= 3);			//	~100 Hz over 10 ms
+		CHECK(lastCrossings >= 180);		//	~10 kHz over 10 ms
+		CHECK(lastCrossings <= 200);
+		CHECK(std::abs(double(pSweep[1001])) > 0.0);
+
+		CHECK_FALSE(gen.SetChannelSignal(3, NTV2_AUDIO_SIGNAL_TONE));
+		CHECK_FALSE(gen.SetChannelSignal(0, NTV2_AUDIO_SIGNAL_TONE, 1.5));
+		CHECK_FALSE(gen.SetChannelSignal(0, NTV2_AUDIO_SIGNAL_TONE, 0.5, 24000.0));
+		CHECK_FALSE(gen.SetChannelSignal(0, NTV2_AUDIO_SIGNAL_INVALID));
+		CHECK_FALSE(gen.Generate(firstHalf, numSamples));	//	Too small
+		CHECK_EQ(NTV2AudioSignalToString(NTV2_AUDIO_SIGNAL_PINK_NOISE, true), "pink");
+	}
+
+	TEST_CASE("Meter")
+	{
+		//	EBU Tech 3341 test 1:  stereo 1 kHz sine at -23 dBFS reads -23.0 LUFS (+/- 0.1)
+		const ULWord numChannels (16),  numSamples (48000 * 10);
+		CNTV2AudioSignalGenerator gen (numChannels);
+		CHECK(gen.SetChannelSignal(0, NTV2_AUDIO_SIGNAL_TONE, ::pow(10.0, -23.0 / 20.0), 1000.0));
+		CHECK(gen.SetChannelSignal(1, NTV2_AUDIO_SIGNAL_TONE, ::pow(10.0, -23.0 / 20.0), 1000.0));
+		CHECK(gen.SetChannelSignal(5, NTV2_AUDIO_SIGNAL_TONE, 1.0, 997.0));
+		NTV2Buffer buffer (numSamples * numChannels * 4);
+		CHECK(gen.Generate(buffer, numSamples));
+
+		CNTV2AudioMeter meter (numChannels);
+		for (ULWord chan(2);  chan < numChannels;  chan++)
+			CHECK(meter.SetChannelWeight(chan, 0.0));		//	Program is channels 1 & 2
+		CHECK_EQ(meter.GetMomentaryLoudness(), NTV2_AUDIO_METER_MIN_DB);
+		const ULWord frameSamples (1601);					//	Odd-sized chunks, as from 29.97 fps
+		for (ULWord done(0);  done < numSamples;  done += frameSamples)
+		{
+			const ULWord count (std::min(frameSamples, numSamples - done));
+			NTV2Buffer chunk (reinterpret_cast<ULWord*>(buffer.GetHostPointer()) + done * numChannels, count * numChannels * 4);
+			CHECK(meter.Process(chunk, count));
+		}
+		CHECK(std::fabs(meter.GetIntegratedLoudness() + 23.0) < 0.1);
+		CHECK(std::fabs(meter.GetMomentaryLoudness() + 23.0) < 0.1);
+		CHECK(std::fabs(meter.GetShortTermLoudness() + 23.0) < 0.1);
+
+		NTV2AudioChannelLevels levels;
+		CHECK(meter.GetChannelLevels(0, levels));
+		CHECK(std::fabs(levels.fPeak + 23.0) < 0.01);
+		CHECK(std::fabs(levels.fRMS + 23.0 + 3.01) < 0.01);
+		CHECK(std::fabs(levels.fTruePeak + 23.0) < 0.1);
+		CHECK(meter.GetChannelLevels(5, levels));
+		CHECK(std::fabs(levels.fPeak) < 0.01);
+		CHECK(meter.GetChannelLevels(7, levels));
+		CHECK_EQ(levels.fPeak, NTV2_AUDIO_METER_MIN_DB);
+		CHECK_EQ(levels.fRMS, NTV2_AUDIO_METER_MIN_DB);
+		meter.ResetLevels();
+		CHECK(meter.GetChannelLevels(0, levels));
+		CHECK_EQ(levels.fPeak, NTV2_AUDIO_METER_MIN_DB);
+
+		//	Only one channel of the pair:  3 LU quieter
+		meter.ResetLoudness();
+		CHECK(meter.SetChannelWeight(1, 0.0));
+		CHECK(meter.Process(buffer, 48000 * 3));
+		CHECK(std::fabs(meter.GetIntegratedLoudness() + 26.01) < 0.1);
+
+		//	Sine at fs/4, 45 degrees out of phase:  samples peak 3 dB below the true peak
+		const ULWord quarterSamples (4800);
+		NTV2Buffer quarter (quarterSamples * 4);
+		LWord * pQuarter (quarter);
+		for (ULWord ndx(0);  ndx < quarterSamples;  ndx++)
+			pQuarter[ndx] = LWord(0.5 * ::sin(kAudioPi / 2.0 * ndx + kAudioPi / 4.0) * 2147483648.0);
+		CNTV2AudioMeter mono (1);
+		CHECK(mono.Process(quarter, quarterSamples));
+		CHECK(mono.GetChannelLevels(0, levels));
+		CHECK(std::fabs(levels.fPeak + 6.02 + 3.01) < 0.05);
+		CHECK(levels.fTruePeak > levels.fPeak + 2.5);
+		CHECK(std::fabs(levels.fTruePeak + 6.02) < 0.6);
+
+		//	SIMD and scalar agree exactly, and byte-swapping works
+		NTV2Buffer swapped (buffer.GetByteCount() / 10);
+		const ULWord * pIn (buffer);
+		ULWord * pSwapped (swapped);
+		for (ULWord ndx(0);  ndx < ULWord(swapped.GetByteCount() / 4);  ndx++)
+			pSwapped[ndx] = NTV2EndianSwap32(pIn[ndx]);
+		CNTV2AudioMeter simd (numChannels),  scalar (numChannels - 1);
+		scalar.SetUseSIMD(false);
+		CHECK(simd.Process(swapped, numSamples / 10, true));
+		NTV2Buffer oddChannels (numSamples / 10 * (numChannels - 1) * 4);
+		ULWord * pOdd (oddChannels);
+		for (ULWord ndx(0);  ndx < numSamples / 10;  ndx++)
+			for (ULWord chan(0);  chan < numChannels - 1;  chan++)
+				pOdd[ndx * (numChannels - 1) + chan] = pIn[ndx * numChannels + chan];
+		CHECK(scalar.Process(oddChannels, numSamples / 10));
+		bool allSame (true);
+		for (ULWord chan(0);  chan < numChannels - 1;  chan++)
+		{
+			NTV2AudioChannelLevels a, b;
+			CHECK(simd.GetChannelLevels(chan, a));
+			CHECK(scalar.GetChannelLevels(chan, b));
+			if (a.fPeak != b.fPeak  ||  a.fTruePeak != b.fTruePeak  ||  std::fabs(a.fRMS - b.fRMS) > 1e-9)
+				allSame = false;
+		}
+		CHECK(allSame);
+		CHECK_EQ(simd.GetMomentaryLoudness(), scalar.GetMomentaryLoudness());
+
+		CHECK_FALSE(meter.SetChannelWeight(numChannels, 1.0));
+		CHECK_FALSE(meter.GetChannelLevels(numChannels, levels));
+		CHECK_FALSE(meter.Process(quarter, quarterSamples));	//	Too small for 16 channels
+	}
+
+	TEST_CASE("Speed")
+	{
+		//	One second of 16 channels for each of 8 audio systems
+		const ULWord numChannels (16),  numSamples (48000),  numSystems (8);
+		CNTV2AudioSignalGenerator gen (numChannels);
+		CHECK(gen.SetSignal(NTV2_AUDIO_SIGNAL_TONE, 0.5, 440.0));
+		NTV2Buffer buffer (numSamples * numChannels * 4);
+		uint64_t start (AJATime::GetSystemMicroseconds());
+		for (ULWord sys(0);  sys < numSystems;  sys++)
+			CHECK(gen.Generate(buffer, numSamples));
+		MESSAGE("Generate 8 x 16 channels x 1 sec tone: " << (AJATime::GetSystemMicroseconds() - start) / 1000 << " ms");
+		for (int simd(0);  simd < 2;  simd++)
+		{
+			CNTV2AudioMeter meter (numChannels);
+			meter.SetUseSIMD(simd != 0);
+			start = AJATime::GetSystemMicroseconds();
+			for (ULWord sys(0);  sys < numSystems;  sys++)
+				CHECK(meter.Process(buffer, numSamples));
+			MESSAGE("Meter 8 x 16 channels x 1 sec " << string(meter.GetUseSIMD() ? "SIMD" : "scalar") << ": "
+					<< (AJATime::GetSystemMicroseconds() - start) / 1000 << " ms");
+		}
+	}
+
+}	//	TEST_SUITE("AudioSignal")
+
+
+TEST_SUITE("ConfigTs2022" * doctest::description("CNTV2ConfigTs2022 J2K encoder & decoder setup"))
+{
+	//	Stands in for a Kona IP J2K board:  models the J2K T0 command/status FIFOs, the T2 frame counter,
+	//	and the encoder reset, and records every register write...
+	class FakeSarekDevice : public FakeRegisterDevice
+	{
+		public:
+			FakeSarekDevice () : mBusyReads(0), mT2Stuck(false)	{}
+			virtual bool ReadRegister (const ULWord inRegNum, ULWord & outValue, const ULWord inMask = 0xFFFFFFFF, const ULWord inShift = 0)
+			{
+				ULWord val (mRegs[inRegNum]);
+				if (inRegNum == SAREK_J2K_ENCODER_1 + kRegJ2kT0FIFOCsr)
+				{
+					if (mRegs[SAREK_REGS + kRegSarekControl] & ENCODER_1_RESET)
+						val = BIT(6);								//	In reset:  command FIFO full
+					else if (mBusyReads)
+						{val = 0;  mBusyReads--;}					//	Coming out of reset
+					else
+						val = mStatusFIFO.empty() ? BIT(11) : 0;	//	SE (status FIFO empty)
+				}
+				else if (inRegNum == SAREK_J2K_ENCODER_1 + kRegJ2kT0StatusFIFO  &&  !mStatusFIFO.empty())
+					{val = mStatusFIFO.front();  mStatusFIFO.erase(mStatusFIFO.begin());}
+				else if (inRegNum == SAREK_J2K_ENCODER_1 + kRegJ2kT2Framecount
+						&&  (mT2Stuck  ||  mRegs[SAREK_J2K_ENCODER_1 + kRegJ2kT2MainCsr] != MODE_STOP))
+					val = ++mRegs[inRegNum];						//	T2 running
+				outValue = (val & inMask) >> inShift;
+				return true;
+			}
+			virtual bool WriteRegister (const ULWord inRegNum, const ULWord inValue, const ULWord inMask = 0xFFFFFFFF, const ULWord inShift = 0)
+			{
+				ULWord & reg (mRegs[inRegNum]);
+				const bool wasInReset (reg & ENCODER_1_RESET);
+				reg = (reg & ~inMask) | ((inValue << inShift) & inMask);
+				mWrites.push_back(NTV2RegInfo(inRegNum, reg));
+				if (inRegNum == SAREK_REGS + kRegSarekControl  &&  wasInReset  &&  !(reg & ENCODER_1_RESET))
+					mBusyReads = 5;
+				if (inRegNum == SAREK_J2K_ENCODER_1 + kRegJ2kT0CmdFIFO  &&  (inValue >> 24) == 0x7F)
+					mStatusFIFO.push_back(0xF0000000 | (inValue & 0x00FF0000));	//	SetParam done
+				return true;
+			}
+			size_t FindWrite (const ULWord inRegNum, const ULWord inValue, const ULWord inMask = 0xFFFFFFFF, const size_t inStartNdx = 0) const
+			{
+				for (size_t ndx(inStartNdx);  ndx < mWrites.size();  ndx++)
+					if (mWrites[ndx].registerNumber == inRegNum  &&  (mWrites[ndx].registerValue & inMask) == inValue)
+						return ndx;
+				return mWrites.size();
+			}
+			size_t CountWrites (const ULWord inRegNum) const
+			{
+				size_t result(0);
+				for (size_t ndx(0);  ndx < mWrites.size();  ndx++)
+					if (mWrites[ndx].registerNumber == inRegNum)
+						result++;
+				return result;
+			}
+
+			NTV2RegisterWrites		mWrites;
+			ULWordSequence			mStatusFIFO;
+			ULWord					mBusyReads;
+			bool					mT2Stuck;		//	T2 ignores MODE_STOP
+	};
+
+	TEST_CASE("SetupJ2KEncoder")
+	{
+		FakeSarekDevice device;
+		device.mRegs[SAREK_REGS2 + kRegSarekEncodeVideoFormat1] = NTV2_FORMAT_1080i_5994;	//	Previously running format
+		CNTV2ConfigTs2022 config(device);
+
+		j2kEncoderConfig encCfg;
+		encCfg.videoFormat		= NTV2_FORMAT_1080i_5994;
+		encCfg.ullMode			= 0;
+		encCfg.bitDepth			= 10;
+		encCfg.chromaSubsamp	= kJ2KChromaSubSamp_422_Standard;
+		encCfg.mbps				= 200;
+		encCfg.streamType		= kJ2KStreamTypeStandard;
+		encCfg.audioChannels	= 2;
+		encCfg.pmtPid			= 0x100;
+		encCfg.videoPid			= 0x101;
+		encCfg.pcrPid			= 0x102;
+		encCfg.audio1Pid		= 0x103;
+
+		//	It used to sleep for at least 50 + 400 + 800 + 60 ms -- now T2 only has to go quiet for a frame, and the
+		//	J2K core is polled for idle once the reset has been held 400 ms and settled 200 ms, then the TS flush
+		const uint64_t startMs (AJATime::GetSystemMilliseconds());
+		CHECK(config.SetupJ2KEncoder(NTV2_CHANNEL1, encCfg));
+		const uint64_t elapsedMs (AJATime::GetSystemMilliseconds() - startMs);
+		MESSAGE("SetupJ2KEncoder took " << elapsedMs << " ms");
+		CHECK(elapsedMs >= 400 + 200 + 60);
+		CHECK(elapsedMs < 1200);
+		CHECK_EQ(config.getLastErrorCode(), NTV2IpErrNone);
+
+		//	Register sequence:  stop T2, pulse reset, configure, flush TS, program the J2K params, enable TS, record, enable input
+		const ULWord ctrlReg (SAREK_REGS + kRegSarekControl), hostEnReg (SAREK_TS_ENCODER_1 + 0x800*ENCODE_TS_J2K_ENCODER + kRegTsJ2kEncoderHostEn);
+		const size_t n (device.mWrites.size());
+		const size_t stopNdx		(device.FindWrite(SAREK_J2K_ENCODER_1 + kRegJ2kT2MainCsr, MODE_STOP));
+		const size_t resetOnNdx		(device.FindWrite(ctrlReg, ENCODER_1_RESET, ENCODER_1_RESET, stopNdx));
+		const size_t resetOffNdx	(device.FindWrite(ctrlReg, 0, ENCODER_1_RESET, resetOnNdx));
+		const size_t formatNdx		(device.FindWrite(SAREK_REGS2 + kRegSarekEncodeVideoFormat1, NTV2_FORMAT_1080i_5994, 0xFFFFFFFF, resetOffNdx));
+		const size_t flushNdx		(device.FindWrite(hostEnReg, 0x6, 0xFFFFFFFF, formatNdx));
+		const size_t cmdNdx			(device.FindWrite(SAREK_J2K_ENCODER_1 + kRegJ2kT0CmdFIFO, 0x70000000, 0xFF000000, flushNdx));
+		const size_t hostEnNdx		(device.FindWrite(hostEnReg, 0x1, 0xFFFFFFFF, cmdNdx));
+		const size_t recordNdx		(device.FindWrite(SAREK_J2K_ENCODER_1 + kRegJ2kT2MainCsr, MODE_RECORD, 0xFFFFFFFF, hostEnNdx));
+		const size_t enableNdx		(device.FindWrite(ctrlReg, ENCODER_1_ENABLE, ENCODER_1_ENABLE, recordNdx));
+		CHECK(stopNdx < n);
+		CHECK(resetOnNdx < n);
+		CHECK(resetOffNdx < n);
+		CHECK(formatNdx < n);
+		CHECK(flushNdx < n);
+		CHECK(cmdNdx < n);
+		CHECK(hostEnNdx < n);
+		CHECK(recordNdx < n);
+		CHECK(enableNdx < n);
+		CHECK_EQ(device.FindWrite(ctrlReg, ENCODER_1_ENABLE, ENCODER_1_ENABLE, stopNdx), enableNdx);	//	Input stays off until the end
+
+		//	Every J2K parameter went through the command FIFO (2 words each) and got its status
+		CHECK_EQ(device.CountWrites(SAREK_J2K_ENCODER_1 + kRegJ2kT0CmdFIFO), 2 * (3*22 + 3*7*4));
+		CHECK(device.mStatusFIFO.empty());
+
+		//	The config registers and the 3 transaction tables were each written in one batch
+		CHECK(device.mNumBatchWrites >= 4);
+		CHECK_EQ(device.mRegs[SAREK_TS_ENCODER_1 + 0x800*ENCODE_TS_MPEG_J2K_ENCAP + HOST_EN], 1);
+		CHECK_EQ(device.mRegs[SAREK_TS_ENCODER_1 + 0x800*ENCODE_TS_MPEG_PCR_ENCAP + HOST_EN], 1);
+		CHECK_EQ(device.mRegs[SAREK_TS_ENCODER_1 + 0x800*ENCODE_TS_MPEG_AES_ENCAP + HOST_EN], 1);
+
+		//	Readback is one batched read
+		const ULWord batchReads (device.mNumBatchReads);
+		j2kEncoderConfig readback;
+		CHECK(config.ReadbackJ2KEncoder(NTV2_CHANNEL1, readback));
+		CHECK_EQ(device.mNumBatchReads, batchReads + 1);
+		CHECK(readback == encCfg);
+		CHECK_FALSE(config.ReadbackJ2KEncoder(NTV2_CHANNEL3, readback));
+		CHECK_EQ(config.getLastErrorCode(), NTV2IpErrInvalidChannel);
+	}
+
+	TEST_CASE("SetupJ2KEncoder bad params")
+	{
+		//	Bad parameters are rejected before the encoder gets touched
+		FakeSarekDevice device;
+		CNTV2ConfigTs2022 config(device);
+		j2kEncoderConfig encCfg;
+		encCfg.videoFormat = NTV2_FORMAT_1080i_5994;
+		CHECK_FALSE(config.SetupJ2KEncoder(NTV2_CHANNEL3, encCfg));
+		CHECK_EQ(config.getLastErrorCode(), NTV2IpErrInvalidChannel);
+		encCfg.bitDepth = 12;
+		CHECK_FALSE(config.SetupJ2KEncoder(NTV2_CHANNEL1, encCfg));
+		CHECK_EQ(config.getLastErrorCode(), NTV2IpErrInvalidBitdepth);
+		CHECK(device.mWrites.empty());
+	}
+
+	TEST_CASE("SetupJ2KEncoder T2 won't stop")
+	{
+		//	If T2 never stops, the encoder isn't reset or reconfigured
+		FakeSarekDevice device;
+		device.mT2Stuck = true;
+		CNTV2ConfigTs2022 config(device);
+		j2kEncoderConfig encCfg;
+		encCfg.videoFormat = NTV2_FORMAT_1080i_5994;
+		encCfg.bitDepth = 10;
+		CHECK_FALSE(config.SetupJ2KEncoder(NTV2_CHANNEL1, encCfg));
+		CHECK_EQ(config.getLastErrorCode(), NTV2IpErrNotReady);
+		CHECK_EQ(device.FindWrite(SAREK_REGS + kRegSarekControl, ENCODER_1_RESET, ENCODER_1_RESET), device.mWrites.size());
+	}
+
+	TEST_CASE("GetJ2KDecoderStatus")
+	{
+		FakeSarekDevice device;
+		CNTV2ConfigTs2022 config(device);
+		device.mRegs[SAREK_REGS2 + kRegSarekNumPGMs] = 3;
+		device.mRegs[SAREK_REGS2 + kRegSarekNumAudios] = 2;
+		for (ULWord ndx(0);  ndx < 3;  ndx++)
+		{
+			device.mRegs[SAREK_REGS2 + kRegSarekPGMNums + ndx] = 10 + ndx;
+			device.mRegs[SAREK_REGS2 + kRegSarekPGMPIDs + ndx] = 0x100 + ndx;
+		}
+		device.mRegs[SAREK_REGS2 + kRegSarekAudioPIDs + 0] = 0x200;
+		device.mRegs[SAREK_REGS2 + kRegSarekAudioPIDs + 1] = 0x201;
+
+		j2kDecoderStatus status;
+		CHECK(config.GetJ2KDecoderStatus(status));
+		CHECK_EQ(device.mNumBatchReads, 2);		//	Counts, then all the tables
+		CHECK_EQ(status.numAvailablePrograms, 3);
+		CHECK_EQ(status.numAvailableAudios, 2);
+		REQUIRE_EQ(status.availableProgramNumbers.size(), 3);
+		REQUIRE_EQ(status.availableProgramPIDs.size(), 3);
+		REQUIRE_EQ(status.availableAudioPIDs.size(), 2);
+		CHECK_EQ(status.availableProgramNumbers[2], 12);
+		CHECK_EQ(status.availableProgramPIDs[1], 0x101);
+		CHECK_EQ(status.availableAudioPIDs[1], 0x201);
+
+		//	Bogus counts don't run past the end of the tables
+		device.mRegs[SAREK_REGS2 + kRegSarekNumPGMs] = 1000;
+		CHECK(config.GetJ2KDecoderStatus(status));
+		CHECK_EQ(status.availableProgramNumbers.size(), 16);
+
+		//	Decoder selection round-trips
+		j2kDecoderConfig decCfg, decReadback;
+		decCfg.selectionMode = j2kDecoderConfig::eProgSel_SpecificProgPID;
+		decCfg.programPID = 0x101;
+		decCfg.audioNumber = 1;
+		CHECK(config.SetupJ2KDecoder(decCfg));
+		CHECK_EQ(device.mRegs[SAREK_REGS2 + kRegSarekHostSeqNum], 1);
+		CHECK(config.ReadbackJ2KDecoder(decReadback));
+		CHECK(decReadback == decCfg);
+	}
+
+}	//	TEST_SUITE("ConfigTs2022")
+
+
+TEST_SUITE("SupportLogger" * doctest::description("CNTV2SupportLogger register snapshots & LoadFromLog"))
+{
+	TEST_CASE("Register snapshot round trip")
+	{
+		FakeRegisterDevice source(DEVICE_ID_KONA4);
+		source.mRegs[kRegGlobalControl] = 0x00010203;
+		source.mRegs[kRegCh1Control] = 0xDEADBEEF;
+		source.mRegs[kRegXptSelectGroup1] = 0x01020304;
+		source.mRegs[kRegStatus] = 0x00000055;				//	Not one of the registers that get restored
+		CNTV2SupportLogger logger(source);
+
+		const uint64_t startUs (AJATime::GetSystemMicroseconds());
+		std::ostringstream oss;
+		REQUIRE(logger.WriteRegisterSnapshot(oss));
+		MESSAGE("Snapshot of " << ::NTV2DeviceIDToString(DEVICE_ID_KONA4) << " took " << (AJATime::GetSystemMicroseconds() - startUs) << " us, "
+				<< oss.str().size() << " bytes");
+		NTV2StringList lines;
+		aja::split(oss.str(), '\n', lines);
+		REQUIRE(lines.size() > 8);
+		CHECK_EQ(lines.front(), std::string(NTV2_REGSNAPSHOT_MAGIC " 1"));
+		CHECK_EQ(lines.at(1), std::string("Device: ") + ::NTV2DeviceIDToString(DEVICE_ID_KONA4));
+		CHECK(std::find(lines.begin(), lines.end(), "1 0xDEADBEEF") != lines.end());
+		CHECK(std::find(lines.begin(), lines.end(), "0 0x00010203") != lines.end());
+		size_t numRegSections(0);
+		for (size_t ndx(0);  ndx < lines.size();  ndx++)
+			if (lines.at(ndx).find("Registers: ") != std::string::npos)
+				numRegSections++;
+		CHECK_EQ(numRegSections, 2);
+		CHECK(std::find(lines.begin(), lines.end(), "End") != lines.end());
+
+		const std::string path (tempPath("ut_ajantv2_snapshot.regs"));
+		{	std::ofstream ofs(path.c_str());
+			ofs << oss.str();
+		}
+		FakeRegisterDevice target(DEVICE_ID_KONA4);
+		CNTV2SupportLogger targetLogger(target);
+		CHECK(targetLogger.LoadFromLog(path, false));
+		CHECK_EQ(target.mNumBatchWrites, 1);
+		CHECK_EQ(target.mRegs[kRegGlobalControl], 0x00010203);
+		CHECK_EQ(target.mRegs[kRegCh1Control], 0xDEADBEEF);
+		CHECK_EQ(target.mRegs[kRegXptSelectGroup1], 0x01020304);
+		CHECK_EQ(target.mRegs[kRegStatus], 0);
+
+		//	Wrong kind of device:  refused unless forced
+		FakeRegisterDevice other(DEVICE_ID_KONA1);
+		CNTV2SupportLogger otherLogger(other);
+		CHECK_FALSE(otherLogger.LoadFromLog(path, false));
+		CHECK_EQ(other.mNumBatchWrites, 0);
+		CHECK(otherLogger.LoadFromLog(path, true));
+		CHECK_EQ(other.mRegs[kRegCh1Control], 0xDEADBEEF);
+		::remove(path.c_str());
+	}
+
+	TEST_CASE("LoadFromLog support log")
+	{
+		//	Same layout as FetchRegisterLog:  "kRegCh1ControlExtended" mustn't be mistaken for "kRegCh1Control"
+		std::ostringstream log;
+		log << "Begin NTV2 Support Log" << std::endl
+			<< "Device: " << ::NTV2DeviceIDToString(DEVICE_ID_KONA4) << std::endl;
+		const ULWord regNums[] = {kRegCh1ControlExtended, kRegCh1Control, kRegGlobalControl, kRegStatus};
+		const ULWord values[] = {7, 1234567, 42, 99};
+		for (size_t ndx(0);  ndx < 4;  ndx++)
+			log << std::endl
+				<< "Register Name: " << CNTV2RegisterExpert::GetDisplayName(regNums[ndx]) << std::endl
+				<< "Register Number: " << regNums[ndx] << std::endl
+				<< "Register Value: " << values[ndx] << " : " << xHEX0N(values[ndx],8) << std::endl
+				<< "Some decoded field: whatever" << std::endl;
+		log << std::endl << "VReg Name: kVRegAudioInputMapSelect" << std::endl << "VReg Number: 10000" << std::endl
+			<< "VReg Value: 5 : 0x00000005" << std::endl << "End NTV2 Support Log";
+
+		const std::string path (tempPath("ut_ajantv2_supportlog.log"));
+		{	std::ofstream ofs(path.c_str());
+			ofs << log.str();
+		}
+		FakeRegisterDevice target(DEVICE_ID_KONA4);
+		CNTV2SupportLogger logger(target);
+		CHECK(logger.LoadFromLog(path, false));
+		CHECK_EQ(target.mNumBatchWrites, 1);
+		CHECK_EQ(target.mRegs[kRegCh1Control], 1234567);
+		CHECK_EQ(target.mRegs[kRegCh1ControlExtended], 7);
+		CHECK_EQ(target.mRegs[kRegGlobalControl], 42);
+		CHECK_EQ(target.mRegs[kRegStatus], 0);
+		CHECK_FALSE(logger.LoadFromLog(tempPath("ut_ajantv2_no_such.log"), true));
+		::remove(path.c_str());
+	}
+
+}	//	TEST_SUITE("SupportLogger")
+
+
+TEST_SUITE("AudioCadence" * doctest::description("GetAudioSamplesPerFrame & GetTotalAudioSamplesFromFrameNbrZeroUpToFrameNbr"))
+{
+	TEST_CASE("Legacy 1000/1001 cadences")
+	{
+		struct LegacyCadence {NTV2AudioRate audioRate;  NTV2FrameRate frameRate;  ULWord samples[5];};
+		static const LegacyCadence sLegacy[] = {
+			{NTV2_AUDIO_48K,	NTV2_FRAMERATE_11988,	{400, 401, 400, 401, 400}},
+			{NTV2_AUDIO_48K,	NTV2_FRAMERATE_5994,	{800, 801, 801, 801, 801}},
+			{NTV2_AUDIO_48K,	NTV2_FRAMERATE_2997,	{1602, 1601, 1602, 1601, 1602}},
+			{NTV2_AUDIO_48K,	NTV2_FRAMERATE_1498,	{3204, 3203, 3203, 3203, 3203}},
+			{NTV2_AUDIO_96K,	NTV2_FRAMERATE_11988,	{801, 801, 801, 801, 800}},
+			{NTV2_AUDIO_96K,	NTV2_FRAMERATE_5994,	{1602, 1601, 1602, 1601, 1602}},
+			{NTV2_AUDIO_96K,	NTV2_FRAMERATE_2997,	{3204, 3203, 3203, 3203, 3203}},
+			{NTV2_AUDIO_192K,	NTV2_FRAMERATE_11988,	{1602, 1601, 1602, 1601, 1602}},
+			{NTV2_AUDIO_192K,	NTV2_FRAMERATE_5994,	{3204, 3203, 3203, 3203, 3203}},
+			{NTV2_AUDIO_192K,	NTV2_FRAMERATE_1498,	{12813, 12813, 12813, 12813, 12812}}};
+		for (size_t ndx(0);  ndx < sizeof(sLegacy) / sizeof(sLegacy[0]);  ndx++)
+		{
+			const LegacyCadence & lc (sLegacy[ndx]);
+			LWord64 total(0);
+			for (ULWord frame(0);  frame < 15;  frame++)
+			{
+				CHECK_EQ(::GetAudioSamplesPerFrame(lc.frameRate, lc.audioRate, frame), lc.samples[frame % 5]);
+				CHECK_EQ(::GetTotalAudioSamplesFromFrameNbrZeroUpToFrameNbr(lc.frameRate, lc.audioRate, frame), total);
+				total += lc.samples[frame % 5];
+			}
+		}
+		//	SMPTE 372 runs at twice the device frame rate
+		CHECK_EQ(::GetAudioSamplesPerFrame(NTV2_FRAMERATE_2997, NTV2_AUDIO_48K, 0, true), 800);
+		CHECK_EQ(::GetAudioSamplesPerFrame(NTV2_FRAMERATE_2997, NTV2_AUDIO_48K, 1, true), 801);
+		CHECK_EQ(::GetAudioSamplesPerFrame(NTV2_FRAMERATE_2500, NTV2_AUDIO_48K, 0, true), 960);
+		CHECK_EQ(::GetAudioSamplesPerFrame(NTV2_FRAMERATE_1500, NTV2_AUDIO_48K, 0, true), 3200);
+		CHECK_EQ(::GetTotalAudioSamplesFromFrameNbrZeroUpToFrameNbr(NTV2_FRAMERATE_2997, NTV2_AUDIO_48K, 5, true), 4004);
+		//	Unknown rates
+		CHECK_EQ(::GetAudioSamplesPerFrame(NTV2_FRAMERATE_UNKNOWN, NTV2_AUDIO_48K), 0);
+		CHECK_EQ(::GetAudioSamplesPerFrame(NTV2_FRAMERATE_2997, NTV2_AUDIO_RATE_INVALID), 0);
+		CHECK_EQ(::GetTotalAudioSamplesFromFrameNbrZeroUpToFrameNbr(NTV2_FRAMERATE_UNKNOWN, NTV2_AUDIO_48K, 100), 0);
+	}
+
+	TEST_CASE("Exact over long sequences")
+	{
+		static const NTV2AudioRate sAudioRates[] = {NTV2_AUDIO_48K, NTV2_AUDIO_96K, NTV2_AUDIO_192K};
+		for (size_t ar(0);  ar < 3;  ar++)
+			for (NTV2FrameRate fr(NTV2_FRAMERATE_FIRST);  fr < NTV2_NUM_FRAMERATES;  fr = NTV2FrameRate(fr+1))
+			{
+				ULWord num(0), den(0);
+				if (!::GetFramesPerSecond(fr, num, den)  ||  !::GetAudioSamplesPerFrame(fr, sAudioRates[ar]))
+					continue;	//	Deprecated rates aren't supported
+				const ULWord64 samplesPerSec (ULWord64(::GetAudioSamplesPerSecond(sAudioRates[ar])));
+				LWord64 total(0);
+				for (ULWord frame(0);  frame < 100000;  frame++)
+					total += ::GetAudioSamplesPerFrame(fr, sAudioRates[ar], frame);
+				CHECK_EQ(::GetTotalAudioSamplesFromFrameNbrZeroUpToFrameNbr(fr, sAudioRates[ar], 100000), total);
+				//	Never more than one sample away from the audio clock, even after 2^32-1 frames
+				static const ULWord sFrameNums[] = {1, 2, 3, 4, 100000, 0xFFFFFFFF};
+				for (size_t ndx(0);  ndx < 6;  ndx++)
+				{
+					const ULWord64 exactTimesNum (ULWord64(sFrameNums[ndx]) * samplesPerSec * den);
+					const ULWord64 actualTimesNum (ULWord64(::GetTotalAudioSamplesFromFrameNbrZeroUpToFrameNbr(fr, sAudioRates[ar], sFrameNums[ndx])) * num);
+					CHECK(actualTimesNum + num > exactTimesNum);
+					CHECK(actualTimesNum < exactTimesNum + num);
+				}
+			}
+	}
+
+}	//	TEST_SUITE("AudioCadence")
+
+
+void devicetracemarker() {}
+TEST_SUITE("DeviceTrace" * doctest::description("NTV2DeviceTraceWriter & NTV2DeviceTraceReader (deviceproxy plugin)"))
+{
+	TEST_CASE("Record and replay round trip")
+	{
+		const std::string path (tempPath("ut_devicetrace.trc"));
+		NTV2TraceDMAArgs dmaArgs;
+		::memset(&dmaArgs, 0, sizeof(dmaArgs));
+		dmaArgs.fByteCount = 0x1000;
+		{
+			NTV2DeviceTraceWriter writer;
+			REQUIRE(writer.Open(path, DEVICE_ID_KONA4));
+			writer.RecordReadRegister(10, true, kRegCh1Control, 0x12345678);
+			writer.RecordReadRegister(20, true, kRegCh1Control, 0x9ABCDEF0);
+			writer.RecordWriteRegister(30, true, kRegCh2Control, 0x5, 0xF0, 4);
+			writer.RecordDMATransfer(40, true, 3, dmaArgs);
+			writer.RecordWaitForInterrupt(50, false, eOutput1, 50);
+			writer.RecordWaitForInterrupt(3000000, true, eOutput1, 50);		//	3 seconds later
+			CHECK_EQ(writer.GetRecordCount(), 6);
+			writer.Close();
+		}
+
+		NTV2DeviceTraceReader reader;
+		REQUIRE(reader.Load(path));
+		reader.SetSpeed(2.0);	//	Replay the 3-second gap in 1.5 seconds
+		CHECK_EQ(reader.GetDeviceID(), DEVICE_ID_KONA4);
+		CHECK_EQ(reader.GetRecordCount(), 6);
+
+		//	Register reads are served in recorded order, with the caller's mask & shift, and the last one sticks
+		ULWord value(0);
+		CHECK(reader.ReadRegister(kRegCh1Control, value, 0xFFFFFFFF, 0));
+		CHECK_EQ(value, 0x12345678);
+		CHECK(reader.ReadRegister(kRegCh1Control, value, 0xFF00, 8));
+		CHECK_EQ(value, 0xDE);
+		CHECK(reader.ReadRegister(kRegCh1Control, value, 0xFFFFFFFF, 0));
+		CHECK_EQ(value, 0x9ABCDEF0);
+		CHECK_FALSE(reader.ReadRegister(kRegGlobalControl, value, 0xFFFFFFFF, 0));	//	Never recorded nor written
+		CHECK(reader.WriteRegister(kRegCh2Control, 0x5, 0xF0, 4));
+		CHECK(reader.ReadRegister(kRegCh2Control, value, 0xFFFFFFFF, 0));
+		CHECK_EQ(value, 0x50);
+		CHECK(reader.DMATransfer(3));
+		CHECK_FALSE(reader.DMATransfer(4));												//	Not in the trace
+
+		//	Interrupt waits return their recorded results, paced to the recorded timeline (even across gaps over a second)
+		CHECK_FALSE(reader.WaitForInterrupt(eOutput1, 50));
+		const uint64_t startMs (AJATime::GetSystemMilliseconds());
+		CHECK(reader.WaitForInterrupt(eOutput1, 50));
+		const uint64_t elapsedMs (AJATime::GetSystemMilliseconds() - startMs);
+		MESSAGE("3-second gap replayed at 2x took " << elapsedMs << " ms");
+		CHECK(elapsedMs >= 1400);
+		CHECK(elapsedMs < 2500);
+		std::ostringstream stats;
+		reader.PrintStats(stats);
+		MESSAGE(stats.str());
+		unsigned numServed(0), numMissed(0), pacedMs(0);
+		CHECK_EQ(::sscanf(stats.str().c_str(), "%u call(s) served, %u miss(es), %ums paced", &numServed, &numMissed, &pacedMs), 3);
+		CHECK(pacedMs <= elapsedMs + 1);		//	Only the time actually slept counts
+		::remove(path.c_str());
+	}
+
+}	//	TEST_SUITE("DeviceTrace")
+
+
+void swdevicemarker() {}
+
+//	Plays a ramp (1, 2, 3...) out of audio system 1 for (at least) inNumVBIs while capturing it on the same
+//	audio system through swdevice's 'input1=loop:1' source, and returns what was captured, plus the number of
+//	32-bit words one 1080p50 frame's worth of samples occupies (the chunk size the loopback delivers in).
+static bool loopbackAudio (CNTV2Card & inCard, const ULWord inFlushVBIs, const ULWord inNumVBIs,
+							std::vector<ULWord> & outCapture, ULWord & outChunkWords)
+{
+	ULWord numChannels(0), playOffset(0), lastIn(0);
+	if (!inCard.GetNumberAudioChannels(numChannels, NTV2_AUDIOSYSTEM_1)
+		|| !inCard.GetAudioMemoryOffset(0, playOffset, NTV2_AUDIOSYSTEM_1, false))
+		return false;
+	outChunkWords = 960 * numChannels;	//	48kHz @ 50fps
+
+	//	Hold playout & capture in reset until the delay line is full of silence...
+	inCard.StopAudioOutput(NTV2_AUDIOSYSTEM_1);
+	inCard.StopAudioInput(NTV2_AUDIOSYSTEM_1);
+	inCard.SetAudioOutputPause(NTV2_AUDIOSYSTEM_1, false);
+	for (ULWord vbi(0);  vbi < inFlushVBIs;  vbi++)
+		inCard.WaitForInputVerticalInterrupt(NTV2_CHANNEL1);
+	NTV2Buffer ramp(0x400000);
+	ULWord * pRamp (reinterpret_cast<ULWord*>(ramp.GetHostPointer()));
+	for (ULWord ndx(0);  ndx < ramp.GetByteCount() / sizeof(ULWord);  ndx++)
+		pRamp[ndx] = ndx + 1;
+	if (!inCard.DMAWrite(0, pRamp, playOffset, ramp.GetByteCount()))
+		return false;
+
+	//	Start both at once, so the capture is exactly the playout, delayed...
+	if (!inCard.WriteRegister(kRegAud1Control, 0, kRegMaskResetAudioInput | kRegMaskResetAudioOutput))
+		return false;
+	for (ULWord vbi(0);  vbi < inNumVBIs;  vbi++)
+		inCard.WaitForInputVerticalInterrupt(NTV2_CHANNEL1);
+	if (!inCard.ReadAudioLastIn(lastIn, NTV2_AUDIOSYSTEM_1))
+		return false;
+	outCapture.assign(lastIn / sizeof(ULWord), 0);
+	return !outCapture.empty()
+		&&	inCard.DMARead(0, &outCapture[0], playOffset + 0x400000, lastIn);
+}
+
+//	Reads inByteCount bytes at the given offset of the given file into pOutBuffer
+static bool readFileAt (std::ifstream & inFile, const uint64_t inOffset, void * pOutBuffer, const size_t inByteCount)
+{
+	inFile.clear();
+	return inFile.seekg(std::streamoff(inOffset), std::ios::beg).read(reinterpret_cast<char*>(pOutBuffer), std::streamsize(inByteCount)).good();
+}
+
+TEST_SUITE("SWDevice" * doctest::description("swdevice plugin signal sources & loopback"))
+{
+	TEST_CASE("Input signal source")
+	{
+		if (!swDeviceAvailable())
+			{MESSAGE("swdevice plugin not found -- skipped");  return;}
+		CNTV2Card card;
+		REQUIRE(card.Open(swDeviceSpec("", "input1=" + ::PercentEncode("format:1080p50a,tone:1000,tc"))));
+		REQUIRE(card.SetFrameBufferFormat(NTV2_CHANNEL1, NTV2_FBF_10BIT_YCBCR));
+		card.StartAudioInput(NTV2_AUDIOSYSTEM_1);
+		for (int vbi(0);  vbi < 3;  vbi++)
+			CHECK(card.WaitForInputVerticalInterrupt(NTV2_CHANNEL1));
+
+		//	Input status & VPID describe the source's format...
+		CHECK_EQ(card.GetInputVideoFormat(NTV2_INPUTSOURCE_SDI1, true), NTV2_FORMAT_1080p_5000_A);
+		ULWord vpidA(0), vpidB(0);
+		CHECK(card.ReadSDIInVPID(NTV2_CHANNEL1, vpidA, vpidB));
+		CHECK_EQ(CNTV2VPID(vpidA).GetVideoFormat(), NTV2_FORMAT_1080p_5000_A);
+
+		//	Timecode & audio advance with each VBI...
+		NTV2_RP188 rp188;
+		ULWord tcFrame1(0), tcFrame2(0), lastIn1(0), lastIn2(0);
+		REQUIRE(card.GetRP188Data(NTV2_CHANNEL1, rp188));
+		CHECK(CRP188(rp188, kTCFormat50fps).GetFrameCount(tcFrame1));
+		CHECK(card.ReadAudioLastIn(lastIn1, NTV2_AUDIOSYSTEM_1));
+		for (int vbi(0);  vbi < 3;  vbi++)
+			CHECK(card.WaitForInputVerticalInterrupt(NTV2_CHANNEL1));
+		REQUIRE(card.GetRP188Data(NTV2_CHANNEL1, rp188));
+		CHECK(CRP188(rp188, kTCFormat50fps).GetFrameCount(tcFrame2));
+		CHECK(card.ReadAudioLastIn(lastIn2, NTV2_AUDIOSYSTEM_1));
+		CHECK(tcFrame2 >= tcFrame1 + 3);
+		CHECK(lastIn2 != lastIn1);
+
+		//	The input frame holds the default test pattern...
+		const NTV2FormatDescriptor fd (NTV2_FORMAT_1080p_5000_A, NTV2_FBF_10BIT_YCBCR);
+		NTV2Buffer expected(fd.GetTotalRasterBytes()), frame(fd.GetTotalRasterBytes());
+		NTV2TestPatternGen tpg;
+		REQUIRE(tpg.DrawTestPattern(NTV2_TestPatt_ColorBars100, fd, expected));
+		ULWord inFrame(0);
+		CHECK(card.GetInputFrame(NTV2_CHANNEL1, inFrame));
+		REQUIRE(card.DMARead(inFrame, reinterpret_cast<ULWord*>(frame.GetHostPointer()), 0, frame.GetByteCount()));
+		CHECK(frame.IsContentEqual(expected));
+		card.Close();
+	}
+
+	TEST_CASE("DMA frame number & card offset")
+	{
+		if (!swDeviceAvailable())
+			{MESSAGE("swdevice plugin not found -- skipped");  return;}
+		CNTV2Card card;
+		REQUIRE(card.Open(swDeviceSpec("")));
+		const ULWord kFrameBytes(0x800000), kSegBytes(0x800), kNumSegs(4), kCardPitch(0x1000);
+		NTV2Buffer src(kSegBytes * kNumSegs), dst(kSegBytes * kNumSegs);
+		FillRandom(src, 42);
+
+		//	Unsegmented:  frame 2 + 0x1000 is the same memory as frame 0 + 16MB + 0x1000...
+		REQUIRE(card.DMAWrite(2, reinterpret_cast<const ULWord*>(src.GetHostPointer()), 0x1000, src.GetByteCount()));
+		CHECK(card.DMARead(0, reinterpret_cast<ULWord*>(dst.GetHostPointer()), 2 * kFrameBytes + 0x1000, dst.GetByteCount()));
+		CHECK(dst.IsContentEqual(src));
+
+		//	Segmented:  both the frame number and the card offset count, for writes and reads...
+		FillRandom(src, 43);
+		REQUIRE(card.DMAWriteSegments(3, reinterpret_cast<const ULWord*>(src.GetHostPointer()), 0x200, src.GetByteCount(), kNumSegs, kSegBytes, kCardPitch));
+		for (ULWord seg(0);  seg < kNumSegs;  seg++)
+			CHECK(card.DMARead(0, reinterpret_cast<ULWord*>(dst.GetHostAddress(seg * kSegBytes)), 3 * kFrameBytes + 0x200 + seg * kCardPitch, kSegBytes));
+		CHECK(dst.IsContentEqual(src));
+		dst.Fill(ULWord(0));
+		CHECK(card.DMAReadSegments(3, reinterpret_cast<ULWord*>(dst.GetHostPointer()), 0x200, src.GetByteCount(), kNumSegs, kSegBytes, kCardPitch));
+		CHECK(dst.IsContentEqual(src));
+		card.Close();
+	}
+
+	TEST_CASE("Loopback video")
+	{
+		if (!swDeviceAvailable())
+			{MESSAGE("swdevice plugin not found -- skipped");  return;}
+		CNTV2Card card;
+		REQUIRE(card.Open(swDeviceSpec("", "input1=" + ::PercentEncode("loop:1,delay:2,format:1080p50a"))));
+		REQUIRE(card.SetFrameBufferFormat(NTV2_CHANNEL1, NTV2_FBF_10BIT_YCBCR));
+		const NTV2FormatDescriptor fd (NTV2_FORMAT_1080p_5000_A, NTV2_FBF_10BIT_YCBCR);
+		NTV2Buffer played(fd.GetTotalRasterBytes()), captured(fd.GetTotalRasterBytes());
+		FillRandom(played, 5);
+		ULWord outFrame(0), inFrame(0);
+		CHECK(card.GetOutputFrame(NTV2_CHANNEL1, outFrame));
+		CHECK(card.GetInputFrame(NTV2_CHANNEL1, inFrame));
+		REQUIRE(outFrame != inFrame);
+		REQUIRE(card.DMAWrite(outFrame, reinterpret_cast<const ULWord*>(played.GetHostPointer()), 0, played.GetByteCount()));
+		for (int vbi(0);  vbi < 2 + 2;  vbi++)	//	Delay + margin
+			CHECK(card.WaitForInputVerticalInterrupt(NTV2_CHANNEL1));
+		REQUIRE(card.DMARead(inFrame, reinterpret_cast<ULWord*>(captured.GetHostPointer()), 0, captured.GetByteCount()));
+		CHECK(captured.IsContentEqual(played));
+		card.Close();
+	}
+
+	TEST_CASE("Loopback bit errors")
+	{
+		if (!swDeviceAvailable())
+			{MESSAGE("swdevice plugin not found -- skipped");  return;}
+		CNTV2Card card;
+		REQUIRE(card.Open(swDeviceSpec("", "input1=" + ::PercentEncode("loop:1,delay:1,ber:0.000001,seed:11,format:1080p50a"))));
+		REQUIRE(card.SetFrameBufferFormat(NTV2_CHANNEL1, NTV2_FBF_10BIT_YCBCR));
+		const NTV2FormatDescriptor fd (NTV2_FORMAT_1080p_5000_A, NTV2_FBF_10BIT_YCBCR);
+		NTV2Buffer played(fd.GetTotalRasterBytes()), captured(fd.GetTotalRasterBytes());
+		FillRandom(played, 9);
+		ULWord outFrame(0), inFrame(0);
+		CHECK(card.GetOutputFrame(NTV2_CHANNEL1, outFrame));
+		CHECK(card.GetInputFrame(NTV2_CHANNEL1, inFrame));
+		REQUIRE(card.DMAWrite(outFrame, reinterpret_cast<const ULWord*>(played.GetHostPointer()), 0, played.GetByteCount()));
+		for (int vbi(0);  vbi < 1 + 2;  vbi++)
+			CHECK(card.WaitForInputVerticalInterrupt(NTV2_CHANNEL1));
+		REQUIRE(card.DMARead(inFrame, reinterpret_cast<ULWord*>(captured.GetHostPointer()), 0, captured.GetByteCount()));
+
+		//	Each delivered frame is a fresh copy with BER * bits (~44.2 here) bits flipped...
+		const UByte * pPlayed (reinterpret_cast<const UByte*>(played.GetHostPointer()));
+		const UByte * pCaptured (reinterpret_cast<const UByte*>(captured.GetHostPointer()));
+		ULWord numBitErrors(0);
+		for (ULWord ndx(0);  ndx < played.GetByteCount();  ndx++)
+			for (UByte diff(pPlayed[ndx] ^ pCaptured[ndx]);  diff;  diff &= UByte(diff - 1))
+				numBitErrors++;
+		MESSAGE(numBitErrors << " bit error(s) in " << played.GetByteCount() * 8 << " bits");
+		CHECK(numBitErrors >= 42);	//	(a bit flipped twice cancels out)
+		CHECK(numBitErrors <= 45);
+		card.Close();
+	}
+
+	TEST_CASE("Loopback audio delay")
+	{
+		if (!swDeviceAvailable())
+			{MESSAGE("swdevice plugin not found -- skipped");  return;}
+		const ULWord kDelay(3);
+		CNTV2Card card;
+		REQUIRE(card.Open(swDeviceSpec("", "input1=" + ::PercentEncode("loop:1,delay:3,format:1080p50a"))));
+		std::vector<ULWord> capture;
+		ULWord chunkWords(0);
+		REQUIRE(loopbackAudio(card, kDelay + 2, 12, capture, chunkWords));
+		REQUIRE(capture.size() > (kDelay + 1) * chunkWords);
+		CHECK_EQ(capture.size() % chunkWords, 0);
+
+		//	Exactly 'delay' frames of silence, then the ramp, uninterrupted...
+		ULWord firstBad(ULWord(capture.size()));
+		for (ULWord ndx(0);  ndx < capture.size()  &&  firstBad == capture.size();  ndx++)
+			if (capture[ndx] != (ndx < kDelay * chunkWords ? 0 : ndx - kDelay * chunkWords + 1))
+				firstBad = ndx;
+		CHECK_EQ(firstBad, capture.size());
+		card.Close();
+	}
+
+	TEST_CASE("Loopback audio drops")
+	{
+		if (!swDeviceAvailable())
+			{MESSAGE("swdevice plugin not found -- skipped");  return;}
+		const ULWord kDelay(1);
+		CNTV2Card card;
+		REQUIRE(card.Open(swDeviceSpec("", "input1=" + ::PercentEncode("loop:1,delay:1,drop:30,seed:7,format:1080p50a"))));
+		std::vector<ULWord> capture;
+		ULWord chunkWords(0);
+		REQUIRE(loopbackAudio(card, kDelay + 2, 40, capture, chunkWords));
+		const ULWord numChunks (ULWord(capture.size()) / chunkWords);
+		REQUIRE(numChunks > 30);
+
+		//	A dropped frame is silence in its place -- the playout clock keeps running...
+		ULWord numDropped(0), numBad(0);
+		for (ULWord chunk(kDelay);  chunk < numChunks;  chunk++)
+		{
+			const ULWord * pChunk (&capture[chunk * chunkWords]);
+			const bool dropped (pChunk[0] == 0);
+			for (ULWord ndx(0);  ndx < chunkWords;  ndx++)
+				if (pChunk[ndx] != (dropped ? 0 : (chunk - kDelay) * chunkWords + ndx + 1))
+					{numBad++;  break;}
+			if (dropped)
+				numDropped++;
+		}
+		MESSAGE(numDropped << " of " << numChunks - kDelay << " frame(s) dropped");
+		CHECK_EQ(numBad, 0);
+		CHECK(numDropped >= 2);		//	30% of 30+ frames
+		CHECK(numDropped <= 25);
+		card.Close();
+	}
+
+	TEST_CASE("Loopback jitter keeps frames in order")
+	{
+		if (!swDeviceAvailable())
+			{MESSAGE("swdevice plugin not found -- skipped");  return;}
+		CNTV2Card card;
+		REQUIRE(card.Open(swDeviceSpec("", "input1=" + ::PercentEncode("loop:1,delay:1,jitter:4,seed:3,format:1080p50a"))));
+		std::vector<ULWord> capture;
+		ULWord chunkWords(0);
+		REQUIRE(loopbackAudio(card, 1 + 4 + 2, 40, capture, chunkWords));
+		const ULWord numChunks (ULWord(capture.size()) / chunkWords);
+		REQUIRE(numChunks > 30);
+
+		//	Each frame arrives whole, at most once, and in order -- late ones repeat (silence), overtaken ones are lost...
+		ULWord numBad(0), numLate(0), numLost(0), nextFrame(0);
+		for (ULWord chunk(0);  chunk < numChunks;  chunk++)
+		{
+			const ULWord * pChunk (&capture[chunk * chunkWords]);
+			if (pChunk[0] == 0)
+				{numLate += nextFrame ? 1 : 0;  continue;}	//	(the delay line starts out full of silence)
+			const ULWord frame ((pChunk[0] - 1) / chunkWords);
+			if ((pChunk[0] - 1) % chunkWords  ||  frame < nextFrame)
+				{numBad++;  continue;}
+			numLost += nextFrame ? frame - nextFrame : 0;
+			nextFrame = frame + 1;
+			for (ULWord ndx(1);  ndx < chunkWords;  ndx++)
+				if (pChunk[ndx] != pChunk[0] + ndx)
+					{numBad++;  break;}
+		}
+		MESSAGE(numLate << " late, " << numLost << " lost of " << numChunks << " frame(s)");
+		CHECK_EQ(numBad, 0);
+		CHECK(nextFrame > 0);
+		CHECK(numLate + numLost > 0);	//	Jitter did something
+		card.Close();
+	}
+
+	TEST_CASE("SDRAM dump & lazy load")
+	{
+		if (!swDeviceAvailable())
+			{MESSAGE("swdevice plugin not found -- skipped");  return;}
+		CNTV2Card card;
+		REQUIRE(card.Open(swDeviceSpec("")));
+		NTV2Framesize frmsz(NTV2_FRAMESIZE_INVALID);
+		REQUIRE(card.GetFrameBufferSize(NTV2_CHANNEL1, frmsz));
+		const ULWord frameBytes (::NTV2FramesizeToByteCount(frmsz)),  numFrames (::NTV2DeviceGetActiveMemorySize(card.GetDeviceID()) / frameBytes);
+		REQUIRE_EQ(frameBytes, 0x800000);	//	swdevice DMA assumes 8MB frames
+		REQUIRE(numFrames > 4);
+		card.Close();
+
+		for (int compact(0);  compact < 2;  compact++)
+		{
+			const std::string path (tempPath(compact ? "ut_ajantv2_sdram.compact" : "ut_ajantv2_sdram.raw"));
+			NTV2Buffer frames[3], readBack(frameBytes), part(0x10000), fill(0x10000);
+			fill.Fill(ULWord(0x10801080));
+
+			//	Frames 1 & 3 are incompressible, frame 2 is constant...
+			REQUIRE(card.Open(swDeviceSpec("")));
+			for (ULWord ndx(0);  ndx < 3;  ndx++)
+			{
+				REQUIRE(frames[ndx].Allocate(frameBytes));
+				if (ndx == 1)
+					frames[ndx].Fill(ULWord(0x10801080));
+				else
+					FillRandom(frames[ndx], ULWord(55 + 2 * compact + ndx), 0xFFFFFFFF);
+				REQUIRE(card.DMAWrite(ndx + 1, reinterpret_cast<const ULWord*>(frames[ndx].GetHostPointer()), 0, frameBytes));
+			}
+			std::ostringstream msgs;
+			CHECK(CNTV2SupportLogger::DumpDeviceSDRAM(card, path, msgs, compact != 0));
+			MESSAGE(msgs.str());
+
+			//	Check what the writer thread wrote...
+			std::ifstream ifs(path.c_str(), std::ios::in | std::ios::binary | std::ios::ate);
+			REQUIRE(ifs.good());
+			const uint64_t fileBytes (uint64_t(ifs.tellg()));
+			if (!compact)
+			{
+				CHECK_EQ(fileBytes, uint64_t(numFrames) * frameBytes);
+				for (ULWord ndx(0);  ndx < 3;  ndx++)
+				{
+					CHECK(readFileAt(ifs, uint64_t(ndx + 1) * frameBytes, readBack.GetHostPointer(), frameBytes));
+					CHECK(readBack.IsContentEqual(frames[ndx]));
+				}
+			}
+			else
+			{
+				NTV2SDRAMDumpHeader hdr;
+				std::vector<NTV2SDRAMDumpFrameInfo> index(numFrames);
+				REQUIRE(readFileAt(ifs, 0, &hdr, sizeof(hdr)));
+				CHECK_EQ(::memcmp(hdr.fMagic, NTV2_SDRAMDUMP_MAGIC, sizeof(hdr.fMagic)), 0);
+				CHECK_EQ(hdr.fVersion, NTV2_SDRAMDUMP_VERSION);
+				CHECK_EQ(hdr.fFrameBytes, frameBytes);
+				REQUIRE_EQ(hdr.fNumFrames, numFrames);
+				REQUIRE(readFileAt(ifs, hdr.fIndexOffset, &index[0], numFrames * sizeof(NTV2SDRAMDumpFrameInfo)));
+				CHECK(fileBytes < uint64_t(numFrames) * frameBytes);
+				CHECK_EQ(index[2].fEncoding, ULWord(NTV2SDRAMDumpEncoding_Fill));
+				CHECK_EQ(index[2].fFillValue, 0x10801080);
+				CHECK_EQ(index[1].fEncoding, ULWord(NTV2SDRAMDumpEncoding_Raw));
+				for (ULWord ndx(0);  ndx < 3;  ndx++)
+				{
+					const NTV2SDRAMDumpFrameInfo & info (index[ndx + 1]);
+					NTV2Buffer payload(info.fEncodedBytes);
+					if (info.fEncodedBytes)
+						CHECK(readFileAt(ifs, info.fOffset, payload.GetHostPointer(), info.fEncodedBytes));
+					readBack.Fill(ULWord(0));
+					CHECK(NTV2DecodeSDRAMDumpFrame(info, payload.GetHostPointer(), readBack, frameBytes));
+					CHECK(readBack.IsContentEqual(frames[ndx]));
+				}
+			}
+			ifs.close();
+
+			//	Scribble over the frames, so only loading the dump can bring them back...
+			readBack.Fill(ULWord(0xDEADBEEF));
+			for (ULWord ndx(0);  ndx < 3;  ndx++)
+				REQUIRE(card.DMAWrite(ndx + 1, reinterpret_cast<const ULWord*>(readBack.GetHostPointer()), 0, frameBytes));
+			card.Close();
+
+			//	Private memory maps the dump, and loads each part the first time a DMA touches it...
+			REQUIRE(card.Open(swDeviceSpec("", "sdram=" + ::PercentEncode("file://" + path))));
+			CHECK(card.DMARead(1, reinterpret_cast<ULWord*>(readBack.GetHostPointer()), 0, frameBytes));
+			CHECK(readBack.IsContentEqual(frames[0]));
+			CHECK(card.DMAReadSegments(2, reinterpret_cast<ULWord*>(part.GetHostPointer()), 0x200, part.GetByteCount(), 4, part.GetByteCount() / 4, 0x100000));
+			CHECK(part.IsContentEqual(fill));
+			CHECK(card.DMARead(0, reinterpret_cast<ULWord*>(part.GetHostPointer()), 3 * frameBytes + 0x1000, part.GetByteCount()));	//	Card offset into frame 3
+			CHECK_EQ(::memcmp(part.GetHostPointer(), frames[2].GetHostAddress(0x1000), part.GetByteCount()), 0);
+
+			//	Touch everything, so the whole dump is loaded (and unmapped) before the next test...
+			for (ULWord frm(0);  frm < numFrames;  frm++)
+				CHECK(card.DMARead(frm, reinterpret_cast<ULWord*>(readBack.GetHostPointer()), 0, frameBytes));
+			card.Close();
+			CHECK_EQ(::remove(path.c_str()), 0);
+		}
+	}
+
+}	//	TEST_SUITE("SWDevice")
+
+
+//	Writes a Control Panel 2 config that maps virtual device "vd1" (FrameStore1, SDIIn1 & SDIOut1)
+//	onto FrameStore3, SDIIn3 & SDIOut3 of the device with the given "serial" (here, an swdevice URL)
+static void writeCP2Config (const std::string & inPath, const std::string & inDeviceSerial)
+{
+	const NTV2WidgetID wgts[][2] = {	{NTV2_WgtFrameBuffer3, NTV2_WgtFrameBuffer1},
+										{NTV2_Wgt3GSDIIn3, NTV2_Wgt3GSDIIn1},
+										{NTV2_Wgt3GSDIOut3, NTV2_Wgt3GSDIOut1}	};
+	std::ofstream ofs(inPath.c_str());
+	ofs << "{\"v2\": {\"deviceConfigList\": [{\"serial\": \"" << inDeviceSerial << "\", \"virtualDevices\": "
+		<< "[{\"id\": \"vd1\", \"name\": \"UTVDev\", \"mappedWidgets\": [";
+	for (size_t ndx(0);  ndx < sizeof(wgts) / sizeof(wgts[0]);  ndx++)
+		ofs << (ndx ? ", " : "") << "{\"deviceWidgetId\": " << int(wgts[ndx][0]) << ", \"virtualWidgetId\": " << int(wgts[ndx][1]) << "}";
+	ofs << "]}]}]}}" << std::endl;
+}
+
+//	Returns a virtualdev URL for "vd1" in the given CP2 config, on top of the given device
+static std::string virtualDevSpec (const std::string & inCP2ConfigPath, const std::string & inDeviceSpec)
+{
+	return "ntv2virtualdev://localhost/?cp2configpath=" + ::PercentEncode(inCP2ConfigPath)
+			+ "&devicesn=" + ::PercentEncode(inDeviceSpec) + "&vdid=vd1";
+}
+
+void virtualdevmarker() {}
+TEST_SUITE("VirtualDev" * doctest::description("virtualdev plugin register translation, on top of swdevice"))
+{
+	static const ULWord kAncExtBaseReg(4096), kAncInsBaseReg(4608), kAncRegsPerChannel(64);	//	Anc extractor/inserter 1's 1st register
+
+	TEST_CASE("Register translation")
+	{
+		if (!swDeviceAvailable())
+			{MESSAGE("swdevice plugin not found -- skipped");  return;}
+		const std::string cfgPath (tempPath("ut_ajantv2_cp2config.json")), swSpec (swDeviceSpec(""));
+		writeCP2Config(cfgPath, swSpec);
+		CNTV2Card card, vdev;
+		REQUIRE(card.Open(swSpec));
+		REQUIRE(vdev.Open(virtualDevSpec(cfgPath, swSpec)));
+		CHECK_EQ(vdev.GetDeviceID(), card.GetDeviceID());
+
+		//	Remapped for reads & writes:  VDev AudioSystem1 is the card's AudioSystem3...
+		CHECK(card.WriteRegister(kRegAud1Control, 0));
+		CHECK(vdev.WriteRegister(kRegAud1Control, 1, kRegMaskNumChannels, kRegShiftNumChannels));
+		ULWord value(0);
+		CHECK(card.ReadRegister(kRegAud3Control, value, kRegMaskNumChannels, kRegShiftNumChannels));
+		CHECK_EQ(value, 1);
+		CHECK(card.ReadRegister(kRegAud1Control, value));
+		CHECK_EQ(value, 0);
+		CHECK(vdev.ReadRegister(kRegAud1Control, value, kRegMaskNumChannels, kRegShiftNumChannels));
+		CHECK_EQ(value, 1);
+
+		//	Remapped for reads only:  VDev Ch1 output frame is the card's Ch3 output frame...
+		CHECK(card.WriteRegister(kRegCh1OutputFrame, 2));
+		CHECK(card.WriteRegister(kRegCh3OutputFrame, 7));
+		CHECK(vdev.ReadRegister(kRegCh1OutputFrame, value));
+		CHECK_EQ(value, 7);
+
+		//	Anc extractor 1 is the card's extractor 3, anc inserter 1 is the card's inserter 4 (SDIOut3)...
+		CHECK(card.WriteRegister(kAncExtBaseReg + regAncExtField1StartAddress, 0));
+		CHECK(vdev.WriteRegister(kAncExtBaseReg + regAncExtField1StartAddress, 0x1234));
+		CHECK(card.ReadRegister(kAncExtBaseReg + 2 * kAncRegsPerChannel + regAncExtField1StartAddress, value));
+		CHECK_EQ(value, 0x1234);
+		CHECK(card.ReadRegister(kAncExtBaseReg + regAncExtField1StartAddress, value));
+		CHECK_EQ(value, 0);
+		CHECK(vdev.WriteRegister(kAncInsBaseReg + regAncInsField1StartAddr, 0x5678));
+		CHECK(card.ReadRegister(kAncInsBaseReg + 3 * kAncRegsPerChannel + regAncInsField1StartAddr, value));
+		CHECK_EQ(value, 0x5678);
+
+		//	Xpt select registers:  both the input and the output xpt are translated...
+		CHECK(card.Connect(NTV2_XptFrameBuffer1Input, NTV2_XptBlack));
+		CHECK(vdev.Connect(NTV2_XptFrameBuffer1Input, NTV2_XptSDIIn1));
+		NTV2OutputXptID oxpt(NTV2_XptBlack);
+		CHECK(card.GetConnectedOutput(NTV2_XptFrameBuffer3Input, oxpt));
+		CHECK_EQ(oxpt, NTV2_XptSDIIn3);
+		CHECK(card.GetConnectedOutput(NTV2_XptFrameBuffer1Input, oxpt));
+		CHECK_EQ(oxpt, NTV2_XptBlack);
+		CHECK(vdev.GetConnectedOutput(NTV2_XptFrameBuffer1Input, oxpt));
+		CHECK_EQ(oxpt, NTV2_XptSDIIn1);
+
+		//	Everything else passes through...
+		CHECK(vdev.WriteRegister(kRegCh4OutputFrame, 9));
+		CHECK(card.ReadRegister(kRegCh4OutputFrame, value));
+		CHECK_EQ(value, 9);
+		vdev.Close();
+		card.Close();
+		::remove(cfgPath.c_str());
+	}
+
+	TEST_CASE("Batch register reads")
+	{
+		if (!swDeviceAvailable())
+			{MESSAGE("swdevice plugin not found -- skipped");  return;}
+		const std::string cfgPath (tempPath("ut_ajantv2_cp2config.json")), swSpec (swDeviceSpec(""));
+		writeCP2Config(cfgPath, swSpec);
+		CNTV2Card card, vdev;
+		REQUIRE(card.Open(swSpec));
+		REQUIRE(vdev.Open(virtualDevSpec(cfgPath, swSpec)));
+		CHECK(card.WriteRegister(kRegCh1OutputFrame, 3));
+		CHECK(card.WriteRegister(kRegCh3OutputFrame, 11));
+		CHECK(card.WriteRegister(kRegCh4OutputFrame, 12));
+		CHECK(card.WriteRegister(kRegAud3Control, 0x00A00000));
+		CHECK(vdev.Connect(NTV2_XptFrameBuffer1Input, NTV2_XptSDIIn1));
+		ULWord xptReg(0), xptNdx(0);
+		REQUIRE(CNTV2RegisterExpert::GetCrosspointSelectGroupRegisterInfo(NTV2_XptFrameBuffer1Input, xptReg, xptNdx));
+
+		//	Pass-thru, remapped, xpt select & special registers in one GETREGS...
+		NTV2RegNumSet regNums;
+		regNums << kRegCh4OutputFrame << kRegCh1OutputFrame << kRegAud1Control << xptReg << kRegBoardID << kRegGlobalControl;
+		NTV2GetRegisters getRegs(regNums);
+		REQUIRE(vdev.NTV2Message(getRegs));
+		NTV2RegisterValueMap batch;
+		REQUIRE(getRegs.GetRegisterValues(batch));
+		CHECK_EQ(batch.size(), regNums.size());
+		CHECK_EQ(batch[kRegCh4OutputFrame], 12);
+		CHECK_EQ(batch[kRegCh1OutputFrame], 11);
+		CHECK_EQ(batch[kRegAud1Control], 0x00A00000);
+		CHECK_EQ(batch[kRegBoardID], ULWord(card.GetDeviceID()));
+
+		//	...and each matches what a one-at-a-time read returns...
+		for (NTV2RegNumSetConstIter it(regNums.begin());  it != regNums.end();  ++it)
+		{
+			ULWord value(0);
+			CHECK(vdev.ReadRegister(*it, value));
+			CHECK_MESSAGE(batch[*it] == value, "reg " << *it << ": batch " << xHEX0N(batch[*it],8) << " != " << xHEX0N(value,8));
+		}
+
+		//	CNTV2Card::ReadRegisters uses the same path...
+		NTV2RegisterReads regReads;
+		regReads.push_back(NTV2RegInfo(kRegCh1OutputFrame));
+		regReads.push_back(NTV2RegInfo(kRegCh4OutputFrame));
+		CHECK(vdev.ReadRegisters(regReads));
+		CHECK_EQ(regReads.at(0).registerValue, 11);
+		CHECK_EQ(regReads.at(1).registerValue, 12);
+		vdev.Close();
+		card.Close();
+		::remove(cfgPath.c_str());
+	}
+
+}	//	TEST_SUITE("VirtualDev")
@@ -4,6 +4,7 @@
 	@copyright	(C) 2022-2023 AJA Video Systems, Inc.	Proprietary and confidential information.
 **/
 #include "ntv2card.h"
+#include "ntv2devicetrace.h"
 #include "ntv2devicescanner.h"
 #include "ntv2nubaccess.h"
 #include "ntv2publicinterface.h"
@@ -47,6 +48,12 @@ using namespace std;
 		------------------		----------	-------------------	---------------------------------------------------------------------------
 		devspec=spec			No			"0"					Device specifier that identifies the underlying device to connect to.
 		devid=spec				No			N/A					Specifies the device ID to behave as.
+		record=path				No			N/A					Records every call made to the underlying device into a trace file at 'path'.
+		replay=path				No			N/A					Replays a trace file previously made with 'record=path', without any
+																underlying device. Register reads, AutoCirculate status & transfer results,
+																and interrupt waits are served from the trace, in recorded order, and paced
+																to the recorded timeline. Ignores 'devspec'.
+		speed=factor			No			1.0					Replay speed factor (e.g. 2.0 replays twice as fast). Only used with 'replay'.
 
 	EXAMPLE USAGE:
 		To use this "device" in the NTV2Player demo on MacOS as a proxy to a real NTV2Card instance for the first Corvid88 board found on
@@ -60,6 +67,10 @@ using namespace std;
 			PARM				VALUE
 			devspec				corvid88
 			devid				corvid44
+
+		To record a session with the first Corvid88, then replay it later on a host without any AJA hardware:
+			./bin/ntv2player  --device 'ntv2deviceproxy://localhost/?devspec=corvid88&record=/tmp/corvid88.trace'
+			./bin/ntv2player  --device 'ntv2deviceproxy://localhost/?replay=/tmp/corvid88.trace'
 *****************************************************************************************************************************************************/
 
 class NTV2DeviceProxy : public NTV2RPCAPI
@@ -70,7 +81,7 @@ class NTV2DeviceProxy : public NTV2RPCAPI
 		virtual						~NTV2DeviceProxy ();
 		virtual string				Name						(void) const;
 		virtual string				Description					(void) const;
-		virtual inline bool			IsConnected					(void) const	{return mCard.IsOpen();}
+		virtual inline bool			IsConnected					(void) const	{return isReplaying() || mCard.IsOpen();}
 		virtual bool				NTV2Connect					(void);
 		virtual	bool				NTV2Disconnect				(void);
 		virtual bool				NTV2GetBoolParamRemote		(const ULWord inParamID,  ULWord & outValue);
@@ -90,6 +101,8 @@ class NTV2DeviceProxy : public NTV2RPCAPI
 		virtual inline bool			hasParam					(const string & inKey) const	{return mConnectParams.hasKey(inKey);}
 		virtual inline NTV2DeviceID	simulatedDeviceID			(void) const					{return mSimDeviceID;}
 		virtual inline bool			isSimulatedDevice			(void) const					{return simulatedDeviceID() != DEVICE_ID_INVALID;}
+		virtual inline bool			isRecording					(void) const					{return mRecorder.IsOpen();}
+		virtual inline bool			isReplaying					(void) const					{return mReplayer.IsLoaded();}
 
 	//	Protected & Private Instance Methods
 	protected:
@@ -107,6 +120,9 @@ class NTV2DeviceProxy : public NTV2RPCAPI
 		NTV2DeviceID		mSimDeviceID;		///< @brief	Simulated device ID (DEVICE_ID_INVALID uses real device ID)
 		mutable CNTV2Card	mCard;				///< @brief	My CNTV2Card object
 		NameToIDs			mKnownDevs;			///< @brief	Known device name to device ID map
+		NTV2DeviceTraceWriter	mRecorder;		///< @brief	Records calls to mCard (if 'record' specified)
+		NTV2DeviceTraceReader	mReplayer;		///< @brief	Replays a recorded trace instead of mCard (if 'replay' specified)
+		string				mReplayPath;		///< @brief	Path of trace being replayed
 };	//	NTV2DeviceProxy
 
 extern "C"
@@ -211,7 +227,8 @@ bool NTV2DeviceProxy::NTV2Connect (void)
 		NBWARN(Name() << " SDK version " << xHEX0N(mSDKVersion,8) << " doesn't match host SDK version " << xHEX0N(mHostSDKVersion,8));
 
 	//	Check config params:
-	string devSpec, devID;
+	string devSpec, devID, recordPath, replayPath;
+	double speed(1.0);
 	const NTV2StringSet keys(mConnectParams.keys());
 	NTV2StringList skippedParams;
 	for (NTV2StringSetConstIter it(keys.begin());  it != keys.end();  ++it)
@@ -243,6 +260,26 @@ bool NTV2DeviceProxy::NTV2Connect (void)
 				{NBFAIL("'" << Name() << "' parameter '" << value << "' invalid, no such device or ID"); return false;}
 			NBINFO("'" << Name() << "' parameter '" << value << "' specified");
 		}
+		else if (key == "record")
+		{
+			if (value.empty())
+				{NBFAIL(Name() << " 'Record' parameter value missing or empty");  return false;}
+			recordPath = value;
+			NBINFO(Name() << " 'Record' parameter value '" << recordPath << "' specified");
+		}
+		else if (key == "replay")
+		{
+			if (value.empty())
+				{NBFAIL(Name() << " 'Replay' parameter value missing or empty");  return false;}
+			replayPath = value;
+			NBINFO(Name() << " 'Replay' parameter value '" << replayPath << "' specified");
+		}
+		else if (key == "speed")
+		{
+			istringstream iss(value);
+			if (!(iss >> speed)  ||  speed <= 0.0)
+				{NBFAIL(Name() << " 'Speed' parameter value '" << value << "' invalid");  return false;}
+		}
 		else if (key == "help")
 		{
 			ostringstream oss;
@@ -250,7 +287,10 @@ bool NTV2DeviceProxy::NTV2Connect (void)
 				<< "CONFIG PARAMS:" << endl
 				<< "Name            Reqd    Default     Desc" << endl
 				<< "devspec=spec    No      '0'         'spec' identifies the underlying device to connect to." << endl
-				<< "devid=id        No      N/A         'id' overrides the NTV2DeviceID of the underlying device.";
+				<< "devid=id        No      N/A         'id' overrides the NTV2DeviceID of the underlying device." << endl
+				<< "record=path     No      N/A         Records all calls made to the underlying device into trace file 'path'." << endl
+				<< "replay=path     No      N/A         Replays trace file 'path' instead of using an underlying device." << endl
+				<< "speed=factor    No      1.0         Replay speed factor.";
 			NBINFO(oss.str());
 			cerr << oss.str() << endl;
 			return false;
@@ -262,24 +302,47 @@ bool NTV2DeviceProxy::NTV2Connect (void)
 	if (!skippedParams.empty())
 		NBWARN("Skipped unrecognized parameter(s): " << skippedParams);
 
+	if (!replayPath.empty())
+	{	//	Replay a trace -- no underlying device...
+		if (!recordPath.empty())
+			{NBFAIL("'record' and 'replay' are mutually exclusive");  return false;}
+		mReplayer.SetSpeed(speed);
+		if (!mReplayer.Load(replayPath))
+			return false;
+		mReplayPath = replayPath;
+		NBINFO(Description() << " ready");
+		return true;
+	}
+
 	//	Open the devSpec...
 	if (devSpec.empty())
 		devSpec = "0";
 	if (CNTV2DeviceScanner::GetFirstDeviceFromArgument(devSpec, mCard))
 		NBINFO(Description() << " ready");
+	if (mCard.IsOpen()  &&  !recordPath.empty())
+		if (!mRecorder.Open(recordPath, isSimulatedDevice() ? simulatedDeviceID() : mCard.GetDeviceID()))
+			return false;
 	return mCard.IsOpen();
 }
 
 bool NTV2DeviceProxy::NTV2Disconnect (void)
 {
-	NBINFO("");
+	if (isReplaying())
+	{	ostringstream oss;  mReplayer.PrintStats(oss);
+		NBINFO("Replay of '" << mReplayPath << "': " << oss.str());
+	}
+	else
+		NBINFO("");
+	mRecorder.Close();
 	return true;
 }
 
 string NTV2DeviceProxy::Name (void) const
 {
 	ostringstream oss;
-	if (isSimulatedDevice())
+	if (isReplaying())
+		oss << "'" << ::NTV2DeviceIDToString(isSimulatedDevice() ? simulatedDeviceID() : mReplayer.GetDeviceID()) << "' replay of '" << mReplayPath << "'";
+	else if (isSimulatedDevice())
 		oss << "'" << ::NTV2DeviceIDToString(simulatedDeviceID()) << "' proxy to '" << mCard.GetDisplayName() << "'";
 	else
 		oss << "Proxy to '" << mCard.GetDisplayName() << "'";
@@ -290,7 +353,9 @@ string NTV2DeviceProxy::Description (void) const
 {
 	ostringstream oss;
 	oss << Name();
-	if (mCard.GetSerialNumber())
+	if (isRecording())
+		oss << " recording";
+	if (mCard.IsOpen()  &&  mCard.GetSerialNumber())
 		if (!::SerialNum64ToString(mCard.GetSerialNumber()).empty())
 			oss << " serial '" << ::SerialNum64ToString(mCard.GetSerialNumber()) << "'";
 	return oss.str();
@@ -324,7 +389,20 @@ bool NTV2DeviceProxy::NTV2GetSupportedRemote (const ULWord inEnumsID, ULWordSet
 
 bool NTV2DeviceProxy::NTV2ReadRegisterRemote (const ULWord inRegNum, ULWord & outRegValue, const ULWord inRegMask, const ULWord inRegShift)
 {
-	bool ok (mCard.ReadRegister(inRegNum, outRegValue, inRegMask, inRegShift));
+	bool ok (false);
+	if (isReplaying())
+		ok = mReplayer.ReadRegister(inRegNum, outRegValue, inRegMask, inRegShift);
+	else if (isRecording())
+	{	//	Always record the whole register, so replay can honor any mask & shift...
+		const uint64_t startUs (mRecorder.Now());
+		ULWord rawValue(0);
+		ok = mCard.ReadRegister(inRegNum, rawValue);
+		mRecorder.RecordReadRegister(startUs, ok, inRegNum, rawValue);
+		if (ok)
+			outRegValue = inRegShift < 32 ? (rawValue & inRegMask) >> inRegShift : 0;
+	}
+	else
+		ok = mCard.ReadRegister(inRegNum, outRegValue, inRegMask, inRegShift);
 	if (ok  &&  inRegNum == kRegBoardID  &&  isSimulatedDevice())
 	{
 		outRegValue = mSimDeviceID & inRegMask;
@@ -336,18 +414,36 @@ bool NTV2DeviceProxy::NTV2ReadRegisterRemote (const ULWord inRegNum, ULWord & ou
 
 bool NTV2DeviceProxy::NTV2WriteRegisterRemote (const ULWord inRegNum, const ULWord inRegVal, const ULWord inRegMask, const ULWord inRegShift)
 {
-	return mCard.WriteRegister(inRegNum, inRegVal, inRegMask, inRegShift);
+	if (isReplaying())
+		return mReplayer.WriteRegister(inRegNum, inRegVal, inRegMask, inRegShift);
+	const uint64_t startUs (isRecording() ? mRecorder.Now() : 0);
+	const bool ok (mCard.WriteRegister(inRegNum, inRegVal, inRegMask, inRegShift));
+	if (isRecording())
+		mRecorder.RecordWriteRegister(startUs, ok, inRegNum, inRegVal, inRegMask, inRegShift);
+	return ok;
 }
 
 
 bool NTV2DeviceProxy::NTV2AutoCirculateRemote (AUTOCIRCULATE_DATA & autoCircData)
 {
-	return mCard.AutoCirculate(autoCircData);
+	if (isReplaying())
+		return mReplayer.AutoCirculate(autoCircData);
+	const uint64_t startUs (isRecording() ? mRecorder.Now() : 0);
+	const bool ok (mCard.AutoCirculate(autoCircData));
+	if (isRecording())
+		mRecorder.RecordAutoCirculate(startUs, ok, autoCircData);
+	return ok;
 }
 
 bool NTV2DeviceProxy::NTV2WaitForInterruptRemote (const INTERRUPT_ENUMS eInterrupt, const ULWord timeOutMs)
 {
-	return mCard.WaitForInterrupt(eInterrupt, timeOutMs);
+	if (isReplaying())
+		return mReplayer.WaitForInterrupt(eInterrupt, timeOutMs);
+	const uint64_t startUs (isRecording() ? mRecorder.Now() : 0);
+	const bool ok (mCard.WaitForInterrupt(eInterrupt, timeOutMs));
+	if (isRecording())
+		mRecorder.RecordWaitForInterrupt(startUs, ok, eInterrupt, timeOutMs);
+	return ok;
 }
 
 bool NTV2DeviceProxy::NTV2DMATransferRemote (const NTV2DMAEngine inDMAEngine,	const bool inIsRead,
@@ -355,13 +451,32 @@ bool NTV2DeviceProxy::NTV2DMATransferRemote (const NTV2DMAEngine inDMAEngine,	co
 												const ULWord inCardOffsetBytes,		const ULWord inNumSegments,
 												const ULWord inSegmentHostPitch,	const ULWord inSegmentCardPitch,	const bool inSynchronous)
 {
-	return mCard.DmaTransfer(inDMAEngine, inIsRead, inFrameNumber, inOutBuffer, inCardOffsetBytes, inNumSegments, inSegmentHostPitch, inSegmentCardPitch, inSynchronous);
+	if (isReplaying())
+		return mReplayer.DMATransfer(inFrameNumber);
+	const uint64_t startUs (isRecording() ? mRecorder.Now() : 0);
+	const bool ok (mCard.DmaTransfer(inDMAEngine, inIsRead, inFrameNumber, inOutBuffer, inCardOffsetBytes, inNumSegments, inSegmentHostPitch, inSegmentCardPitch, inSynchronous));
+	if (isRecording())
+	{
+		const NTV2TraceDMAArgs args = {uint32_t(inDMAEngine), inIsRead ? 1U : 0U, inCardOffsetBytes, inOutBuffer.GetByteCount(),
+										inNumSegments, inSegmentHostPitch, inSegmentCardPitch, inSynchronous ? 1U : 0U};
+		mRecorder.RecordDMATransfer(startUs, ok, inFrameNumber, args);
+	}
+	return ok;
 }
 
 
 bool NTV2DeviceProxy::NTV2MessageRemote (NTV2_HEADER * pInMessage)
 {
-	bool ok(mCard.NTV2Message(pInMessage));
+	bool ok(false);
+	if (isReplaying())
+		ok = mReplayer.Message(pInMessage);
+	else
+	{
+		const uint64_t startUs (isRecording() ? mRecorder.Now() : 0);
+		ok = mCard.NTV2Message(pInMessage);
+		if (isRecording())
+			mRecorder.RecordMessage(startUs, ok, pInMessage);
+	}
 	if (ok  &&  isSimulatedDevice()  &&  pInMessage->GetType() == NTV2_TYPE_GETREGS)
 	{
 		NTV2GetRegisters * pGetRegs = AsNTV2GetRegisters(pInMessage);
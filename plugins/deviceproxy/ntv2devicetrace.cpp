@@ -0,0 +1,406 @@
+/**
+	@file		ntv2devicetrace.cpp
+	@brief		Implements the NTV2DeviceTraceWriter and NTV2DeviceTraceReader classes.
+	@copyright	(C) 2023 AJA Video Systems, Inc.	Proprietary and confidential information.
+**/
+#include "ntv2devicetrace.h"
+#include "ntv2utils.h"
+#include "ntv2version.h"
+#include "ajabase/system/debug.h"
+#include "ajabase/system/systemtime.h"
+#include <cstring>
+
+using namespace std;
+
+#define INSTP(_p_)			xHEX0N(uint64_t(_p_),16)
+#define	TRCFAIL(__x__)		AJA_sERROR  (AJA_DebugUnit_RPCClient, INSTP(this) << "::" << AJAFUNC << ": " << __x__)
+#define	TRCWARN(__x__)		AJA_sWARNING(AJA_DebugUnit_RPCClient, INSTP(this) << "::" << AJAFUNC << ": " << __x__)
+#define	TRCINFO(__x__)		AJA_sINFO   (AJA_DebugUnit_RPCClient, INSTP(this) << "::" << AJAFUNC << ": " << __x__)
+#define	TRCDBG(__x__)		AJA_sDEBUG  (AJA_DebugUnit_RPCClient, INSTP(this) << "::" << AJAFUNC << ": " << __x__)
+
+static const size_t		kTraceStreamBufferBytes	(1024 * 1024);	//	Large stream buffer keeps per-call recording overhead low
+
+static inline ULWord	MaskShift (const ULWord inRawValue, const ULWord inMask, const ULWord inShift)
+{
+	return inShift < 32 ? (inRawValue & inMask) >> inShift : 0;
+}
+
+
+/////////////////////////////////////////////	NTV2DeviceTraceWriter
+
+NTV2DeviceTraceWriter::NTV2DeviceTraceWriter ()
+	:	mFile			(),
+		mStreamBuffer	(),
+		mLock			(),
+		mStartTimeUs	(0),
+		mNumRecords		(0)
+{
+}
+
+NTV2DeviceTraceWriter::~NTV2DeviceTraceWriter ()
+{
+	Close();
+}
+
+bool NTV2DeviceTraceWriter::Open (const string & inPath, const NTV2DeviceID inDeviceID)
+{
+	Close();
+	AJAAutoLock lock(&mLock);
+	mStreamBuffer.resize(kTraceStreamBufferBytes);
+	mFile.rdbuf()->pubsetbuf(&mStreamBuffer[0], streamsize(mStreamBuffer.size()));
+	mFile.open(inPath.c_str(), ios::out | ios::binary | ios::trunc);
+	if (!mFile.is_open())
+		{TRCFAIL("Cannot open '" << inPath << "' for writing");  return false;}
+
+	NTV2TraceFileHeader hdr;
+	::memset(&hdr, 0, sizeof(hdr));
+	::memcpy(hdr.fMagic, NTV2_TRACE_MAGIC, sizeof(hdr.fMagic));
+	hdr.fVersion = NTV2_TRACE_VERSION;
+	hdr.fDeviceID = uint32_t(inDeviceID);
+	hdr.fSDKVersion = AJA_NTV2_SDK_VERSION;
+	hdr.fStartTimeUs = mStartTimeUs = AJATime::GetSystemMicroseconds();
+	mFile.write(reinterpret_cast<const char*>(&hdr), sizeof(hdr));
+	mNumRecords = 0;
+	TRCINFO("Recording " << ::NTV2DeviceIDToString(inDeviceID) << " to '" << inPath << "'");
+	return mFile.good();
+}
+
+void NTV2DeviceTraceWriter::Close (void)
+{
+	AJAAutoLock lock(&mLock);
+	if (!mFile.is_open())
+		return;
+	mFile.close();
+	TRCINFO(DEC(mNumRecords) << " record(s) written");
+}
+
+uint64_t NTV2DeviceTraceWriter::Now (void) const
+{
+	return AJATime::GetSystemMicroseconds() - mStartTimeUs;
+}
+
+void NTV2DeviceTraceWriter::WriteRecord (const NTV2TraceCall inCall, const uint64_t inStartUs, const bool inOK, const ULWord inKey,
+										const void * pInPayload, const size_t inPayloadBytes, const UByte inChannel)
+{
+	const uint64_t endUs (Now());
+	NTV2TraceRecordHeader rec;
+	rec.fCall			= uint16_t(inCall);
+	rec.fResult			= inOK ? 1 : 0;
+	rec.fChannel		= inChannel;
+	rec.fPayloadBytes	= uint32_t(inPayloadBytes);
+	rec.fStartUs		= inStartUs;
+	rec.fDurationUs		= endUs > inStartUs ? uint32_t(endUs - inStartUs) : 0;
+	rec.fKey			= inKey;
+	AJAAutoLock lock(&mLock);
+	if (!mFile.is_open())
+		return;
+	mFile.write(reinterpret_cast<const char*>(&rec), sizeof(rec));
+	if (inPayloadBytes)
+		mFile.write(reinterpret_cast<const char*>(pInPayload), streamsize(inPayloadBytes));
+	mNumRecords++;
+}
+
+void NTV2DeviceTraceWriter::RecordReadRegister (const uint64_t inStartUs, const bool inOK, const ULWord inRegNum, const ULWord inRawValue)
+{
+	WriteRecord (NTV2TraceCall_ReadRegister, inStartUs, inOK, inRegNum, &inRawValue, sizeof(inRawValue));
+}
+
+void NTV2DeviceTraceWriter::RecordWriteRegister (const uint64_t inStartUs, const bool inOK, const ULWord inRegNum, const ULWord inValue, const ULWord inMask, const ULWord inShift)
+{
+	const ULWord payload[3] = {inValue, inMask, inShift};
+	WriteRecord (NTV2TraceCall_WriteRegister, inStartUs, inOK, inRegNum, payload, sizeof(payload));
+}
+
+void NTV2DeviceTraceWriter::RecordWaitForInterrupt (const uint64_t inStartUs, const bool inOK, const INTERRUPT_ENUMS inInterrupt, const ULWord inTimeoutMs)
+{
+	WriteRecord (NTV2TraceCall_WaitForInterrupt, inStartUs, inOK, ULWord(inInterrupt), &inTimeoutMs, sizeof(inTimeoutMs));
+}
+
+void NTV2DeviceTraceWriter::RecordDMATransfer (const uint64_t inStartUs, const bool inOK, const ULWord inFrameNum, const NTV2TraceDMAArgs & inArgs)
+{
+	WriteRecord (NTV2TraceCall_DMATransfer, inStartUs, inOK, inFrameNum, &inArgs, sizeof(inArgs));
+}
+
+void NTV2DeviceTraceWriter::RecordAutoCirculate (const uint64_t inStartUs, const bool inOK, const AUTOCIRCULATE_DATA & inData)
+{
+	WriteRecord (NTV2TraceCall_AutoCirculate, inStartUs, inOK, ULWord(inData.eCommand), AJA_NULL, 0, UByte(inData.channelSpec));
+}
+
+void NTV2DeviceTraceWriter::RecordMessage (const uint64_t inStartUs, const bool inOK, const NTV2_HEADER * pInMessage)
+{
+	if (!pInMessage)
+		return;
+	const ULWord msgType (pInMessage->GetType());
+	if (msgType == NTV2_TYPE_GETREGS)
+	{	//	Record the register values that were read, as regNum/value pairs...
+		NTV2RegisterValueMap regValues;
+		if (inOK)
+			reinterpret_cast<const NTV2GetRegisters*>(pInMessage)->GetRegisterValues(regValues);
+		vector<ULWord> pairs;
+		pairs.reserve(regValues.size() * 2);
+		for (NTV2RegValueMapConstIter it(regValues.begin());  it != regValues.end();  ++it)
+			{pairs.push_back(it->first);  pairs.push_back(it->second);}
+		WriteRecord (NTV2TraceCall_Message, inStartUs, inOK, msgType, pairs.empty() ? AJA_NULL : &pairs[0], pairs.size() * sizeof(ULWord));
+	}
+	else if (msgType == NTV2_TYPE_ACSTATUS)
+	{	//	AUTOCIRCULATE_STATUS is plain data -- record it whole...
+		const AUTOCIRCULATE_STATUS * pStatus (reinterpret_cast<const AUTOCIRCULATE_STATUS*>(pInMessage));
+		WriteRecord (NTV2TraceCall_Message, inStartUs, inOK, msgType, pStatus, sizeof(AUTOCIRCULATE_STATUS), UByte(pStatus->acCrosspoint));
+	}
+	else if (msgType == NTV2_TYPE_ACXFER)
+	{	//	Only the scalar results -- not the video/audio/anc buffers...
+		const AUTOCIRCULATE_TRANSFER * pXfer (reinterpret_cast<const AUTOCIRCULATE_TRANSFER*>(pInMessage));
+		const AUTOCIRCULATE_TRANSFER_STATUS & xs (pXfer->acTransferStatus);
+		NTV2TraceXferResult result;
+		result.fState					= uint32_t(xs.acState);
+		result.fTransferFrame			= xs.acTransferFrame;
+		result.fBufferLevel				= xs.acBufferLevel;
+		result.fFramesProcessed			= xs.acFramesProcessed;
+		result.fFramesDropped			= xs.acFramesDropped;
+		result.fAudioTransferSize		= xs.acAudioTransferSize;
+		result.fAudioStartSample		= xs.acAudioStartSample;
+		result.fAncTransferSize			= xs.acAncTransferSize;
+		result.fAncField2TransferSize	= xs.acAncField2TransferSize;
+		result.fFrameTime				= xs.acFrameStamp.acFrameTime;
+		result.fAudioClockTimeStamp		= xs.acFrameStamp.acAudioClockTimeStamp;
+		result.fRequestedFrame			= xs.acFrameStamp.acRequestedFrame;
+		result.fCurrentFrame			= xs.acFrameStamp.acCurrentFrame;
+		WriteRecord (NTV2TraceCall_Message, inStartUs, inOK, msgType, &result, sizeof(result), UByte(pXfer->acCrosspoint));
+	}
+	else
+		WriteRecord (NTV2TraceCall_Message, inStartUs, inOK, msgType, AJA_NULL, 0);
+}
+
+
+/////////////////////////////////////////////	NTV2DeviceTraceReader
+
+NTV2DeviceTraceReader::NTV2DeviceTraceReader ()
+	:	mData			(),
+		mQueues			(),
+		mRegReads		(),
+		mRegState		(),
+		mLock			(),
+		mNumRecords		(0),
+		mReplayStartUs	(0),
+		mSpeed			(1.0),
+		mLoaded			(false),
+		mNumServed		(0),
+		mNumMissed		(0),
+		mSleptUs		(0)
+{
+	::memset(&mHeader, 0, sizeof(mHeader));
+}
+
+NTV2DeviceTraceReader::~NTV2DeviceTraceReader ()
+{
+}
+
+bool NTV2DeviceTraceReader::Load (const string & inPath)
+{
+	AJAAutoLock lock(&mLock);
+	mLoaded = false;
+	mData.clear();  mQueues.clear();  mRegReads.clear();  mRegState.clear();
+	mNumRecords = 0;
+
+	ifstream ifs(inPath.c_str(), ios::in | ios::binary);
+	if (!ifs)
+		{TRCFAIL("Cannot open '" << inPath << "'");  return false;}
+	if (!ifs.read(reinterpret_cast<char*>(&mHeader), sizeof(mHeader)))
+		{TRCFAIL("'" << inPath << "' too short");  return false;}
+	if (::memcmp(mHeader.fMagic, NTV2_TRACE_MAGIC, sizeof(mHeader.fMagic)))
+		{TRCFAIL("'" << inPath << "' not an NTV2 trace file");  return false;}
+	if (mHeader.fVersion != NTV2_TRACE_VERSION)
+		{TRCFAIL("'" << inPath << "' trace version " << DEC(mHeader.fVersion) << " unsupported");  return false;}
+	mData.assign(istreambuf_iterator<char>(ifs), istreambuf_iterator<char>());
+
+	//	Index every record: register reads (including those done in GETREGS batches) go into per-register
+	//	value queues;  everything else goes into per-call queues...
+	size_t offset(0);
+	while (offset + sizeof(NTV2TraceRecordHeader) <= mData.size())
+	{
+		const NTV2TraceRecordHeader & rec (*reinterpret_cast<const NTV2TraceRecordHeader*>(&mData[offset]));
+		const size_t payloadOffset (offset + sizeof(NTV2TraceRecordHeader));
+		if (payloadOffset + rec.fPayloadBytes > mData.size())
+			{TRCWARN("'" << inPath << "' truncated at record " << DEC(mNumRecords));  break;}
+		const ULWord * pWords (reinterpret_cast<const ULWord*>(&mData[payloadOffset]));
+		if (rec.fCall == NTV2TraceCall_ReadRegister)
+		{
+			if (rec.fResult  &&  rec.fPayloadBytes >= sizeof(ULWord))
+				mRegReads[rec.fKey].push_back(pWords[0]);
+		}
+		else if (rec.fCall == NTV2TraceCall_Message  &&  rec.fKey == NTV2_TYPE_GETREGS)
+		{
+			for (size_t ndx(0);  ndx + 1 < rec.fPayloadBytes / sizeof(ULWord);  ndx += 2)
+				mRegReads[pWords[ndx]].push_back(pWords[ndx+1]);
+		}
+		else
+			mQueues[CallKey(ULWord(rec.fCall) << 8 | rec.fChannel, rec.fKey)].push_back(offset);
+		offset = payloadOffset + rec.fPayloadBytes;
+		mNumRecords++;
+	}
+	mReplayStartUs = AJATime::GetSystemMicroseconds();
+	mNumServed = mNumMissed = mSleptUs = 0;
+	mLoaded = true;
+	TRCINFO("Loaded " << DEC(mNumRecords) << " record(s) of " << ::NTV2DeviceIDToString(GetDeviceID()) << " trace '" << inPath
+			<< "', " << DEC(mRegReads.size()) << " register(s), " << DEC(mQueues.size()) << " call queue(s)");
+	return true;
+}
+
+const NTV2TraceRecordHeader * NTV2DeviceTraceReader::Next (const NTV2TraceCall inCall, const ULWord inKey, const UByte * & outPayload, const UByte inChannel)
+{	//	Caller must hold mLock
+	outPayload = AJA_NULL;
+	CallQueues::iterator it (mQueues.find(CallKey(ULWord(inCall) << 8 | inChannel, inKey)));
+	if (it == mQueues.end()  ||  it->second.empty())
+		{mNumMissed++;  return AJA_NULL;}
+	const size_t offset (it->second.front());
+	it->second.pop_front();
+	mNumServed++;
+	outPayload = &mData[offset + sizeof(NTV2TraceRecordHeader)];
+	return reinterpret_cast<const NTV2TraceRecordHeader*>(&mData[offset]);
+}
+
+void NTV2DeviceTraceReader::SleepUntil (const uint64_t inTraceUs)
+{	//	Caller must NOT hold mLock
+	const uint64_t targetUs (mReplayStartUs + uint64_t(double(inTraceUs) / mSpeed));
+	const uint64_t startUs (AJATime::GetSystemMicroseconds());
+	if (targetUs <= startUs)
+		return;
+	uint64_t nowUs (startUs);
+	do
+	{	//	Never more than a second per sleep, but keep going until the target time is reached
+		const uint64_t sleepUs (targetUs - nowUs);
+		AJATime::SleepInMicroseconds(int32_t(sleepUs > 1000000 ? 1000000 : sleepUs));
+		nowUs = AJATime::GetSystemMicroseconds();
+	} while (nowUs < targetUs);
+	AJAAutoLock lock(&mLock);
+	mSleptUs += nowUs - startUs;	//	Only count the time actually slept
+}
+
+bool NTV2DeviceTraceReader::ReadRegister (const ULWord inRegNum, ULWord & outValue, const ULWord inMask, const ULWord inShift)
+{
+	AJAAutoLock lock(&mLock);
+	RegQueues::iterator it (mRegReads.find(inRegNum));
+	if (it != mRegReads.end()  &&  !it->second.empty())
+	{
+		mRegState[inRegNum] = it->second.front();
+		if (it->second.size() > 1)	//	Keep the last recorded value for all subsequent reads
+			it->second.pop_front();
+		mNumServed++;
+	}
+	NTV2RegValueMapConstIter stateIt (mRegState.find(inRegNum));
+	if (stateIt == mRegState.end())
+		{mNumMissed++;  return false;}	//	Never read nor written
+	outValue = MaskShift(stateIt->second, inMask, inShift);
+	return true;
+}
+
+bool NTV2DeviceTraceReader::WriteRegister (const ULWord inRegNum, const ULWord inValue, const ULWord inMask, const ULWord inShift)
+{
+	AJAAutoLock lock(&mLock);
+	const UByte * pPayload(AJA_NULL);
+	const NTV2TraceRecordHeader * pRec (Next(NTV2TraceCall_WriteRegister, inRegNum, pPayload));
+	if (inShift < 32)
+	{	//	Merge into known state, so subsequent reads of registers that were never recorded see the write...
+		ULWord & state (mRegState[inRegNum]);
+		state = (state & ~inMask) | ((inValue << inShift) & inMask);
+	}
+	return pRec ? pRec->fResult != 0 : true;
+}
+
+bool NTV2DeviceTraceReader::WaitForInterrupt (const INTERRUPT_ENUMS inInterrupt, const ULWord inTimeoutMs)
+{
+	const NTV2TraceRecordHeader * pRec(AJA_NULL);
+	{
+		AJAAutoLock lock(&mLock);
+		const UByte * pPayload(AJA_NULL);
+		pRec = Next(NTV2TraceCall_WaitForInterrupt, ULWord(inInterrupt), pPayload);
+	}
+	if (!pRec)
+	{	//	Trace exhausted -- behave like a timeout
+		AJATime::Sleep(int32_t(inTimeoutMs));
+		return false;
+	}
+	SleepUntil(pRec->fStartUs + pRec->fDurationUs);		//	Pace replay to the recorded timeline
+	return pRec->fResult != 0;
+}
+
+bool NTV2DeviceTraceReader::DMATransfer (const ULWord inFrameNum)
+{
+	uint32_t durationUs(0);
+	bool result(false);
+	{
+		AJAAutoLock lock(&mLock);
+		const UByte * pPayload(AJA_NULL);
+		const NTV2TraceRecordHeader * pRec (Next(NTV2TraceCall_DMATransfer, inFrameNum, pPayload));
+		if (!pRec)
+			return false;
+		durationUs = uint32_t(double(pRec->fDurationUs) / mSpeed);
+		result = pRec->fResult != 0;
+		mSleptUs += durationUs;
+	}
+	if (durationUs)
+		AJATime::SleepInMicroseconds(int32_t(durationUs));	//	Simulate the recorded transfer time
+	return result;
+}
+
+bool NTV2DeviceTraceReader::AutoCirculate (const AUTOCIRCULATE_DATA & inData)
+{
+	AJAAutoLock lock(&mLock);
+	const UByte * pPayload(AJA_NULL);
+	const NTV2TraceRecordHeader * pRec (Next(NTV2TraceCall_AutoCirculate, ULWord(inData.eCommand), pPayload, UByte(inData.channelSpec)));
+	return pRec ? pRec->fResult != 0 : false;
+}
+
+bool NTV2DeviceTraceReader::Message (NTV2_HEADER * pInOutMessage)
+{
+	if (!pInOutMessage)
+		return false;
+	const ULWord msgType (pInOutMessage->GetType());
+	if (msgType == NTV2_TYPE_GETREGS)
+		return false;	//	Causes the SDK to fall back to per-register reads, which are served from the per-register queues
+
+	AJAAutoLock lock(&mLock);
+	const UByte * pPayload(AJA_NULL);
+	const NTV2TraceRecordHeader * pRec(AJA_NULL);
+	if (msgType == NTV2_TYPE_ACSTATUS)
+	{
+		AUTOCIRCULATE_STATUS * pStatus (reinterpret_cast<AUTOCIRCULATE_STATUS*>(pInOutMessage));
+		pRec = Next(NTV2TraceCall_Message, msgType, pPayload, UByte(pStatus->acCrosspoint));
+		if (pRec  &&  pRec->fPayloadBytes == sizeof(AUTOCIRCULATE_STATUS))
+			::memcpy(pStatus, pPayload, sizeof(AUTOCIRCULATE_STATUS));
+	}
+	else if (msgType == NTV2_TYPE_ACXFER)
+	{
+		AUTOCIRCULATE_TRANSFER * pXfer (reinterpret_cast<AUTOCIRCULATE_TRANSFER*>(pInOutMessage));
+		pRec = Next(NTV2TraceCall_Message, msgType, pPayload, UByte(pXfer->acCrosspoint));
+		if (pRec  &&  pRec->fPayloadBytes == sizeof(NTV2TraceXferResult))
+		{
+			NTV2TraceXferResult result;
+			::memcpy(&result, pPayload, sizeof(result));
+			AUTOCIRCULATE_TRANSFER_STATUS & xs (pXfer->acTransferStatus);
+			xs.acState							= NTV2AutoCirculateState(result.fState);
+			xs.acTransferFrame					= result.fTransferFrame;
+			xs.acBufferLevel					= result.fBufferLevel;
+			xs.acFramesProcessed				= result.fFramesProcessed;
+			xs.acFramesDropped					= result.fFramesDropped;
+			xs.acAudioTransferSize				= result.fAudioTransferSize;
+			xs.acAudioStartSample				= result.fAudioStartSample;
+			xs.acAncTransferSize				= result.fAncTransferSize;
+			xs.acAncField2TransferSize			= result.fAncField2TransferSize;
+			xs.acFrameStamp.acFrameTime			= result.fFrameTime;
+			xs.acFrameStamp.acAudioClockTimeStamp	= result.fAudioClockTimeStamp;
+			xs.acFrameStamp.acRequestedFrame	= result.fRequestedFrame;
+			xs.acFrameStamp.acCurrentFrame		= result.fCurrentFrame;
+		}
+	}
+	else
+		pRec = Next(NTV2TraceCall_Message, msgType, pPayload);
+	return pRec ? pRec->fResult != 0 : false;
+}
+
+ostream & NTV2DeviceTraceReader::PrintStats (ostream & oss) const
+{
+	AJAAutoLock lock(const_cast<AJALock*>(&mLock));
+	oss << DEC(mNumServed) << " call(s) served, " << DEC(mNumMissed) << " miss(es), " << DEC(mSleptUs / 1000) << "ms paced";
+	return oss;
+}
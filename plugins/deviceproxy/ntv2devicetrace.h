@@ -0,0 +1,165 @@
+/**
+	@file		ntv2devicetrace.h
+	@brief		Declares the NTV2DeviceTraceWriter and NTV2DeviceTraceReader classes, used by the device proxy
+				to record a device session into a compact binary trace, and to replay it later without hardware.
+	@copyright	(C) 2023 AJA Video Systems, Inc.	Proprietary and confidential information.
+**/
+#ifndef NTV2DEVICETRACE_H
+#define NTV2DEVICETRACE_H
+
+#include "ntv2publicinterface.h"
+#include "ajabase/system/lock.h"
+#include <fstream>
+#include <string>
+#include <vector>
+#include <deque>
+#include <map>
+
+/*****************************************************************************************************************************************************
+	TRACE FILE FORMAT	(host byte order)
+
+	NTV2TraceFileHeader				Once, at the start of the file
+	{
+		NTV2TraceRecordHeader		One per call...
+		payload						...followed by fPayloadBytes of call-specific data (see NTV2TraceCall)
+	}...
+
+	Timestamps are microseconds since the trace was started. Register reads always record the full 32-bit register value,
+	so that replay can apply whatever mask and shift the caller asks for.
+*****************************************************************************************************************************************************/
+
+typedef enum
+{
+	NTV2TraceCall_ReadRegister		= 1,	///< @brief	fKey=regNum,	payload: ULWord rawValue
+	NTV2TraceCall_WriteRegister		= 2,	///< @brief	fKey=regNum,	payload: ULWord value, mask, shift
+	NTV2TraceCall_WaitForInterrupt	= 3,	///< @brief	fKey=INTERRUPT_ENUMS,	payload: ULWord timeoutMs
+	NTV2TraceCall_DMATransfer		= 4,	///< @brief	fKey=frameNum,	payload: NTV2TraceDMAArgs
+	NTV2TraceCall_AutoCirculate		= 5,	///< @brief	fKey=AUTO_CIRC_COMMAND,	payload: ULWord channelSpec
+	NTV2TraceCall_Message			= 6		///< @brief	fKey=NTV2_HEADER type,	payload: GETREGS: regNum/value pairs;  ACSTATUS: AUTOCIRCULATE_STATUS;  ACXFER: NTV2TraceXferResult
+} NTV2TraceCall;
+
+#define	NTV2_TRACE_MAGIC		"NTV2TRC1"
+#define	NTV2_TRACE_VERSION		1
+
+#pragma pack(push, 4)
+typedef struct NTV2TraceFileHeader
+{
+	char		fMagic[8];			///< @brief	Always NTV2_TRACE_MAGIC
+	uint32_t	fVersion;			///< @brief	Always NTV2_TRACE_VERSION
+	uint32_t	fDeviceID;			///< @brief	NTV2DeviceID of the recorded device
+	uint32_t	fSDKVersion;		///< @brief	AJA_NTV2_SDK_VERSION of the recorder
+	uint32_t	fReserved;
+	uint64_t	fStartTimeUs;		///< @brief	Host clock when recording started (microseconds)
+} NTV2TraceFileHeader;
+
+typedef struct NTV2TraceRecordHeader
+{
+	uint16_t	fCall;				///< @brief	NTV2TraceCall
+	uint8_t		fResult;			///< @brief	1 if the call succeeded, 0 if it failed
+	uint8_t		fChannel;			///< @brief	NTV2Crosspoint for AutoCirculate status & transfer messages, otherwise zero
+	uint32_t	fPayloadBytes;		///< @brief	Number of payload bytes that follow this header
+	uint64_t	fStartUs;			///< @brief	When the call started (microseconds since fStartTimeUs)
+	uint32_t	fDurationUs;		///< @brief	How long the call took (microseconds)
+	uint32_t	fKey;				///< @brief	Call-specific key (e.g. register number)
+} NTV2TraceRecordHeader;
+
+typedef struct NTV2TraceDMAArgs
+{
+	uint32_t	fEngine, fIsRead, fCardOffsetBytes, fByteCount, fNumSegments, fHostPitch, fCardPitch, fSynchronous;
+} NTV2TraceDMAArgs;
+
+typedef struct NTV2TraceXferResult		///< @brief	Scalar results of an AUTOCIRCULATE_TRANSFER
+{
+	uint32_t	fState;
+	int32_t		fTransferFrame;
+	uint32_t	fBufferLevel, fFramesProcessed, fFramesDropped;
+	uint32_t	fAudioTransferSize, fAudioStartSample, fAncTransferSize, fAncField2TransferSize;
+	int64_t		fFrameTime;
+	uint64_t	fAudioClockTimeStamp;
+	uint32_t	fRequestedFrame, fCurrentFrame;
+} NTV2TraceXferResult;
+#pragma pack(pop)
+
+
+/**
+	@brief	Writes calls made to an NTV2 device into a binary trace file. Thread-safe.
+**/
+class NTV2DeviceTraceWriter
+{
+	public:
+							NTV2DeviceTraceWriter ();
+		virtual				~NTV2DeviceTraceWriter ();
+		virtual bool		Open (const std::string & inPath, const NTV2DeviceID inDeviceID);
+		virtual void		Close (void);
+		inline bool			IsOpen (void) const		{return mFile.is_open();}
+		virtual uint64_t	Now (void) const;		///< @return	Microseconds since the trace started
+
+		virtual void		RecordReadRegister (const uint64_t inStartUs, const bool inOK, const ULWord inRegNum, const ULWord inRawValue);
+		virtual void		RecordWriteRegister (const uint64_t inStartUs, const bool inOK, const ULWord inRegNum, const ULWord inValue, const ULWord inMask, const ULWord inShift);
+		virtual void		RecordWaitForInterrupt (const uint64_t inStartUs, const bool inOK, const INTERRUPT_ENUMS inInterrupt, const ULWord inTimeoutMs);
+		virtual void		RecordDMATransfer (const uint64_t inStartUs, const bool inOK, const ULWord inFrameNum, const NTV2TraceDMAArgs & inArgs);
+		virtual void		RecordAutoCirculate (const uint64_t inStartUs, const bool inOK, const AUTOCIRCULATE_DATA & inData);
+		virtual void		RecordMessage (const uint64_t inStartUs, const bool inOK, const NTV2_HEADER * pInMessage);
+		inline uint64_t		GetRecordCount (void) const	{return mNumRecords;}
+
+	protected:
+		virtual void		WriteRecord (const NTV2TraceCall inCall, const uint64_t inStartUs, const bool inOK, const ULWord inKey,
+										const void * pInPayload, const size_t inPayloadBytes, const UByte inChannel = 0);
+	private:
+		std::ofstream		mFile;
+		std::vector<char>	mStreamBuffer;
+		AJALock				mLock;
+		uint64_t			mStartTimeUs;
+		uint64_t			mNumRecords;
+};	//	NTV2DeviceTraceWriter
+
+
+/**
+	@brief	Loads a trace written by NTV2DeviceTraceWriter and serves its results back, call by call, in recorded order.
+			Register reads are served per-register, in recorded order, falling back to the last known value.
+			Interrupt waits are paced to the recorded timeline, and DMA transfers take their recorded time.
+**/
+class NTV2DeviceTraceReader
+{
+	public:
+							NTV2DeviceTraceReader ();
+		virtual				~NTV2DeviceTraceReader ();
+		virtual bool		Load (const std::string & inPath);
+		inline bool			IsLoaded (void) const			{return mLoaded;}
+		inline NTV2DeviceID	GetDeviceID (void) const		{return NTV2DeviceID(mHeader.fDeviceID);}
+		inline size_t		GetRecordCount (void) const		{return mNumRecords;}
+		inline void			SetSpeed (const double inSpeed)	{mSpeed = inSpeed > 0.0 ? inSpeed : 1.0;}
+
+		virtual bool		ReadRegister (const ULWord inRegNum, ULWord & outValue, const ULWord inMask, const ULWord inShift);
+		virtual bool		WriteRegister (const ULWord inRegNum, const ULWord inValue, const ULWord inMask, const ULWord inShift);
+		virtual bool		WaitForInterrupt (const INTERRUPT_ENUMS inInterrupt, const ULWord inTimeoutMs);
+		virtual bool		DMATransfer (const ULWord inFrameNum);
+		virtual bool		AutoCirculate (const AUTOCIRCULATE_DATA & inData);
+		virtual bool		Message (NTV2_HEADER * pInOutMessage);
+		virtual std::ostream &	PrintStats (std::ostream & oss) const;
+
+	protected:
+		typedef std::pair<uint32_t, uint32_t>	CallKey;	///< @brief	(NTV2TraceCall << 8 | fChannel) + fKey
+		typedef std::deque<size_t>				RecordNdxs;	///< @brief	Offsets into mData of record headers
+		typedef std::map<CallKey, RecordNdxs>	CallQueues;
+		typedef std::deque<ULWord>				RegValues;
+		typedef std::map<ULWord, RegValues>		RegQueues;
+
+		virtual const NTV2TraceRecordHeader *	Next (const NTV2TraceCall inCall, const ULWord inKey, const UByte * & outPayload, const UByte inChannel = 0);
+		virtual void		SleepUntil (const uint64_t inTraceUs);
+
+	private:
+		NTV2TraceFileHeader		mHeader;
+		std::vector<UByte>		mData;
+		CallQueues				mQueues;
+		RegQueues				mRegReads;		///< @brief	Recorded register values, per register
+		NTV2RegisterValueMap	mRegState;		///< @brief	Last known register values
+		AJALock					mLock;
+		size_t					mNumRecords;
+		uint64_t				mReplayStartUs;
+		double					mSpeed;
+		bool					mLoaded;
+		uint64_t				mNumServed, mNumMissed, mSleptUs;
+};	//	NTV2DeviceTraceReader
+
+#endif	//	NTV2DEVICETRACE_H
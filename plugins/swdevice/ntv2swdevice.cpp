@@ -8,11 +8,20 @@
 #include "ntv2publicinterface.h"
 #include "ntv2utils.h"
 #include "ntv2version.h"
+#include "ntv2supportlogger.h"
+#include "ntv2testpatterngen.h"
+#include "ntv2rp188.h"
+#include "ntv2vpid.h"
+#include "ntv2devicefeatures.h"
+#include "ajaanc/includes/ancillarydata.h"
 //#include "../../../ajadriver/ntv2autocirc.h"		//	<== TBD TBD TBD		Use user-space driver code
+#include "ajabase/system/atomic.h"
 #include "ajabase/system/debug.h"
 #include "ajabase/common/common.h"
 #include "ajabase/system/memory.h"
 #include "ajabase/system/lock.h"
+#include "ajabase/system/systemtime.h"
+#include "ajabase/system/thread.h"
 #include <fstream>
 #include <iomanip>
 #if defined(AJAMac)
@@ -21,6 +30,12 @@
 #elif defined(AJALinux)
 	#include <dlfcn.h>
 #endif
+#if !defined(MSWindows)
+	#include <fcntl.h>
+	#include <sys/mman.h>
+	#include <sys/stat.h>
+	#include <unistd.h>
+#endif
 
 using namespace std;
 
@@ -74,6 +89,36 @@ using namespace std;
 																the local host are supported.
 																NOTE:	The "supportlog --sdram" command line tool can generate these frame
 																		buffer memory dumps.
+																Raw and compact (NTV2SDRAMDumpHeader) dumps are supported. With NoSharedMemory,
+																the file is memory-mapped, and each part is loaded upon its first DMA.
+		Input1..Input8=items	No			n/a					If specified, simulates a signal arriving at the given SDI input. 'items' is a
+																URL-encoded, comma-separated list of:
+																	pattern:name	test pattern to send (default "100% ColorBars")
+																	file:fileURL	raw frames to send in a loop instead of a test pattern
+																					(must already be in the channel's pixel format)
+																	format:name		video format (default "1080p59.94a")
+																	tone[:Hz]		embedded audio tone (default 1000Hz)
+																	anc				a DID 0x50/SID 0x01 packet into the anc extractor buffer(s)
+																	tc				RP188 timecode, starting at 00:00:00:00
+																	loop[:N]		loop back SDI output N (default: same number) instead of
+																					sending a pattern, tone or anc. These add impairments:
+																	delay:frames	latency (default 1 frame)
+																	jitter:frames	up to this many extra (random) frames of latency
+																					(frames still arrive in order:  a late frame
+																					repeats the previous one, an overtaken one is lost)
+																	drop:percent	percentage of frames lost
+																	ber:rate		bit error rate applied to the video
+																	seed:N			impairment random seed (for reproducible runs)
+																On each of the source's VBIs (i.e. at its format's frame rate), the frame is
+																written into the channel's current input frame, tone samples into the
+																capture buffer of the same-numbered audio system, and the SDI input status,
+																VPID and RP188 registers are updated. A loopback source instead reads the output
+																frame, one frame of samples from the output audio system's playout buffer, and
+																the anc inserter's buffers, and delivers them "delay" frames later. Because all
+																instances share the same device memory, another instance's outputs can feed
+																this instance's inputs. The source's "format" should match the output's.
+																Example:  "ntv2://swdevice/?input1=format%3A1080i50%2Ctone%3A440%2Ctc"
+																Example:  "ntv2://swdevice/?input2=loop%3A1%2Cdelay%3A3%2Cdrop%3A0.5"
 
 	EXAMPLE USAGE:
 		To use this "device" in the NTV2Player demo on MacOS:
@@ -120,6 +165,341 @@ static const ULWord			kOffsetToRegBytes	(sizeof(AJANTV2FakeDevice));
 static const uint32_t		kFakeDevCookie		(0xFACEDE00);
 static AJANTV2FakeDevice *	spFakeDevice		(AJA_NULL);
 static AJALock				sLock;
+static const uint64_t		kSDRAMChunkBytes	(8ULL * 1024ULL * 1024ULL);	//	Raw dumps are loaded in 8MB chunks
+
+
+//	Loads an SDRAM dump file (raw, or compact -- see NTV2SDRAMDumpHeader) into frame buffer memory lazily:
+//	the file is memory-mapped, and each chunk (frame, for compact dumps) is copied (or decoded) into SDRAM the
+//	first time it's touched by a DMA. The mapping is released once every chunk has been loaded. Guarded by sLock.
+class SDRAMDumpImage
+{
+	public:
+		SDRAMDumpImage () : mpFile(AJA_NULL), mFileBytes(0), mImageBytes(0), mpIndex(AJA_NULL), mChunkBytes(0), mNumChunks(0), mNumLoaded(0)
+			{::memset(&mHeader, 0, sizeof(mHeader));}
+		~SDRAMDumpImage ()							{Close();}
+		inline bool		IsOpen (void) const			{return mpFile != AJA_NULL;}
+		inline bool		IsCompact (void) const		{return mpIndex != AJA_NULL;}
+		inline size_t	NumChunks (void) const		{return mNumChunks;}
+
+		//	Answers with the size of the SDRAM image in the given file (which, for a compact dump, isn't the file size)
+		static uint64_t	ImageBytes (const string & inFilePath)
+		{
+			ifstream ifile(inFilePath.c_str(), std::ifstream::in | std::ifstream::binary | ios::ate);
+			if (!ifile)
+				return 0;
+			const uint64_t fileBytes (uint64_t(ifile.tellg()));
+			NTV2SDRAMDumpHeader hdr;
+			ifile.seekg(0, ios::beg);
+			if (fileBytes >= sizeof(hdr)  &&  ifile.read(reinterpret_cast<char*>(&hdr), sizeof(hdr)).good())
+				if (!::memcmp(hdr.fMagic, NTV2_SDRAMDUMP_MAGIC, sizeof(hdr.fMagic)))
+					return uint64_t(hdr.fFrameBytes) * uint64_t(hdr.fNumFrames);
+			return fileBytes;
+		}
+
+		bool Open (const string & inFilePath, const NTV2Buffer & inSDRAM)
+		{
+			Close();
+#if defined(MSWindows)
+			ifstream ifile(inFilePath.c_str(), std::ifstream::in | std::ifstream::binary | ios::ate);
+			if (!ifile)
+				{NBFAIL("Unable to open SDRAM dump file '" << inFilePath << "' for reading");  return false;}
+			mFileBytes = uint64_t(ifile.tellg());
+			ifile.seekg(0, ios::beg);
+			if (!mFileData.Allocate(size_t(mFileBytes))  ||  !ifile.read(mFileData, streamsize(mFileBytes)).good())
+				{NBFAIL("Failed reading " << DEC(mFileBytes) << " bytes from '" << inFilePath << "'");  Close();  return false;}
+			mpFile = mFileData;
+#else
+			const int fd (::open(inFilePath.c_str(), O_RDONLY));
+			if (fd < 0)
+				{NBFAIL("Unable to open SDRAM dump file '" << inFilePath << "' for reading");  return false;}
+			struct stat st;
+			if (::fstat(fd, &st) != 0  ||  st.st_size <= 0)
+				{NBFAIL("Unable to stat SDRAM dump file '" << inFilePath << "'");  ::close(fd);  return false;}
+			mFileBytes = uint64_t(st.st_size);
+			void * pMapped (::mmap(AJA_NULL, size_t(mFileBytes), PROT_READ, MAP_PRIVATE, fd, 0));
+			::close(fd);	//	Mapping outlives the descriptor
+			if (pMapped == MAP_FAILED)
+				{NBFAIL("Unable to map " << DEC(mFileBytes) << "-byte SDRAM dump file '" << inFilePath << "'");  mFileBytes = 0;  return false;}
+			mpFile = reinterpret_cast<const UByte*>(pMapped);
+#endif	//	!MSWindows
+			uint64_t imageBytes (mFileBytes);
+			mChunkBytes = kSDRAMChunkBytes;
+			if (mFileBytes >= sizeof(mHeader)  &&  !::memcmp(mpFile, NTV2_SDRAMDUMP_MAGIC, sizeof(mHeader.fMagic)))
+			{	//	Compact dump
+				::memcpy(&mHeader, mpFile, sizeof(mHeader));
+				const uint64_t indexBytes (uint64_t(mHeader.fNumFrames) * sizeof(NTV2SDRAMDumpFrameInfo));
+				if (mHeader.fVersion != NTV2_SDRAMDUMP_VERSION  ||  !mHeader.fFrameBytes  ||  !mHeader.fIndexOffset
+					||  mHeader.fIndexOffset + indexBytes > mFileBytes)
+						{NBFAIL("Bad or incomplete compact SDRAM dump file '" << inFilePath << "'");  Close();  return false;}
+				mpIndex = reinterpret_cast<const NTV2SDRAMDumpFrameInfo*>(mpFile + mHeader.fIndexOffset);
+				for (ULWord frm(0);  frm < mHeader.fNumFrames;  frm++)
+					if (mpIndex[frm].fOffset + mpIndex[frm].fEncodedBytes > mFileBytes)
+						{NBFAIL("Frame " << DEC(frm) << " extends past end of '" << inFilePath << "'");  Close();  return false;}
+				mChunkBytes = mHeader.fFrameBytes;
+				imageBytes = uint64_t(mHeader.fFrameBytes) * uint64_t(mHeader.fNumFrames);
+			}
+			if (imageBytes > inSDRAM.GetByteCount())
+				NBWARN("SDRAM image size " << DEC(imageBytes) << " (" << DEC(imageBytes/1024/1024) << "MB) is larger than device SDRAM size "
+						<< DEC(inSDRAM.GetByteCount()) << " (" << DEC(inSDRAM.GetByteCount()/1024/1024) << "MB)");
+			else if (imageBytes < inSDRAM.GetByteCount())
+				NBWARN("SDRAM image size " << DEC(imageBytes) << " (" << DEC(imageBytes/1024/1024) << "MB) is smaller than device SDRAM size "
+						<< DEC(inSDRAM.GetByteCount()) << " (" << DEC(inSDRAM.GetByteCount()/1024/1024) << "MB)");
+			mImageBytes = std::min(imageBytes, uint64_t(inSDRAM.GetByteCount()));
+			mNumChunks = size_t(IsCompact() ? mImageBytes / mChunkBytes : (mImageBytes + mChunkBytes - 1) / mChunkBytes);
+			mLoaded.assign(mNumChunks, false);
+			mNumLoaded = 0;
+			return true;
+		}
+
+		//	Loads any chunks that overlap the given SDRAM byte range that haven't already been loaded
+		bool Load (NTV2Buffer & inOutSDRAM, const uint64_t inOffset, const uint64_t inByteCount)
+		{
+			if (!IsOpen()  ||  !inByteCount)
+				return true;
+			bool ok (true);
+			const size_t firstChunk (size_t(inOffset / mChunkBytes)),  lastChunk (size_t((inOffset + inByteCount - 1) / mChunkBytes));
+			for (size_t chunk(firstChunk);  chunk <= lastChunk  &&  chunk < mNumChunks;  chunk++)
+				if (!mLoaded.at(chunk))
+					if (!LoadChunk(inOutSDRAM, chunk))
+						ok = false;
+			if (mNumLoaded == mNumChunks)
+				Close();	//	All loaded -- don't need the file anymore
+			return ok;
+		}
+
+		inline bool	LoadAll (NTV2Buffer & inOutSDRAM)		{return Load(inOutSDRAM, 0, mImageBytes);}
+
+		void Close (void)
+		{
+#if defined(MSWindows)
+			mFileData.Deallocate();
+#else
+			if (mpFile)
+				::munmap(const_cast<UByte*>(mpFile), size_t(mFileBytes));
+#endif
+			mpFile = AJA_NULL;
+			mpIndex = AJA_NULL;
+			mFileBytes = mImageBytes = 0;
+			mNumChunks = mNumLoaded = 0;
+			mLoaded.clear();
+		}
+
+	private:
+		bool LoadChunk (NTV2Buffer & inOutSDRAM, const size_t inChunk)
+		{
+			const uint64_t offset (uint64_t(inChunk) * mChunkBytes),  bytes (std::min(mChunkBytes, mImageBytes - offset));
+			UByte * pDst (reinterpret_cast<UByte*>(inOutSDRAM.GetHostAddress(ULWord(offset))));
+			if (!pDst)
+				return false;
+			mLoaded.at(inChunk) = true;
+			mNumLoaded++;
+			if (!IsCompact())
+			{
+				::memcpy(pDst, mpFile + offset, size_t(bytes));
+				return true;
+			}
+			const NTV2SDRAMDumpFrameInfo & info (mpIndex[inChunk]);
+			if (::NTV2DecodeSDRAMDumpFrame(info, info.fEncodedBytes ? mpFile + info.fOffset : AJA_NULL, pDst, size_t(bytes)))
+				return true;
+			NBFAIL("Failed to decode frame " << DEC(inChunk) << " (encoding " << DEC(info.fEncoding) << ")");
+			return false;
+		}
+
+	private:
+		const UByte *					mpFile;			///< @brief	Mapped file contents
+		uint64_t						mFileBytes;		///< @brief	File size, in bytes
+		uint64_t						mImageBytes;	///< @brief	Number of SDRAM bytes to be loaded
+		NTV2SDRAMDumpHeader				mHeader;		///< @brief	Compact dump header
+		const NTV2SDRAMDumpFrameInfo *	mpIndex;		///< @brief	Compact dump frame index (NULL if raw)
+		uint64_t						mChunkBytes;	///< @brief	Load granularity
+		size_t							mNumChunks;
+		size_t							mNumLoaded;
+		std::vector<bool>				mLoaded;		///< @brief	Which chunks have been loaded
+#if defined(MSWindows)
+		NTV2Buffer						mFileData;		///< @brief	File contents (no mmap on Windows)
+#endif
+};	//	SDRAMDumpImage
+
+static SDRAMDumpImage		sSDRAMImage;
+
+//	THESE WERE COPIED FROM ntv2register.cpp, ntv2regvpid.cpp & ntv2audio.cpp:
+static const ULWord gChannelToControlRegNum []				= { kRegCh1Control,		kRegCh2Control,		kRegCh3Control,		kRegCh4Control,
+																kRegCh5Control,		kRegCh6Control,		kRegCh7Control,		kRegCh8Control,		0};
+static const ULWord gChannelToOutputFrameRegNum []			= { kRegCh1OutputFrame,	kRegCh2OutputFrame,	kRegCh3OutputFrame,	kRegCh4OutputFrame,
+																kRegCh5OutputFrame,	kRegCh6OutputFrame,	kRegCh7OutputFrame,	kRegCh8OutputFrame,	0};
+static const ULWord gChannelToInputFrameRegNum []			= { kRegCh1InputFrame,	kRegCh2InputFrame,	kRegCh3InputFrame,	kRegCh4InputFrame,
+																kRegCh5InputFrame,	kRegCh6InputFrame,	kRegCh7InputFrame,	kRegCh8InputFrame,	0};
+static const ULWord gAudioSystemToAudioControlRegNum []		= { kRegAud1Control,		kRegAud2Control,		kRegAud3Control,		kRegAud4Control,
+																kRegAud5Control,		kRegAud6Control,		kRegAud7Control,		kRegAud8Control,		0};
+static const ULWord gChannelToAudioInLastAddrRegNum []		= { kRegAud1InputLastAddr,	kRegAud2InputLastAddr,	kRegAud3InputLastAddr,	kRegAud4InputLastAddr,
+																kRegAud5InputLastAddr,	kRegAud6InputLastAddr,	kRegAud7InputLastAddr,	kRegAud8InputLastAddr,	0};
+static const ULWord gChannelToAudioOutLastAddrRegNum []		= { kRegAud1OutputLastAddr,	kRegAud2OutputLastAddr,	kRegAud3OutputLastAddr,	kRegAud4OutputLastAddr,
+																kRegAud5OutputLastAddr,	kRegAud6OutputLastAddr,	kRegAud7OutputLastAddr,	kRegAud8OutputLastAddr,	0};
+static const ULWord gChlToRP188DBBRegNum []					= { kRegRP188InOut1DBB,			kRegRP188InOut2DBB,			kRegRP188InOut3DBB,			kRegRP188InOut4DBB,
+																kRegRP188InOut5DBB,			kRegRP188InOut6DBB,			kRegRP188InOut7DBB,			kRegRP188InOut8DBB,			0};
+static const ULWord gChlToRP188Bits031RegNum []				= { kRegRP188InOut1Bits0_31,	kRegRP188InOut2Bits0_31,	kRegRP188InOut3Bits0_31,	kRegRP188InOut4Bits0_31,
+																kRegRP188InOut5Bits0_31,	kRegRP188InOut6Bits0_31,	kRegRP188InOut7Bits0_31,	kRegRP188InOut8Bits0_31,	0};
+static const ULWord gChlToRP188Bits3263RegNum []			= { kRegRP188InOut1Bits32_63,	kRegRP188InOut2Bits32_63,	kRegRP188InOut3Bits32_63,	kRegRP188InOut4Bits32_63,
+																kRegRP188InOut5Bits32_63,	kRegRP188InOut6Bits32_63,	kRegRP188InOut7Bits32_63,	kRegRP188InOut8Bits32_63,	0};
+static const ULWord gChannelToSDIInputStatusRegNum []		= { kRegInputStatus,		kRegInputStatus,		kRegInputStatus2,		kRegInputStatus2,
+																kRegInput56Status,		kRegInput56Status,		kRegInput78Status,		kRegInput78Status,	0};
+static const ULWord gChannelToSDIInputRateMask []			= { kRegMaskInput1FrameRate,		kRegMaskInput2FrameRate,		kRegMaskInput1FrameRate,		kRegMaskInput2FrameRate,
+																kRegMaskInput1FrameRate,		kRegMaskInput2FrameRate,		kRegMaskInput1FrameRate,		kRegMaskInput2FrameRate,		0};
+static const ULWord gChannelToSDIInputRateHighMask []		= { kRegMaskInput1FrameRateHigh,	kRegMaskInput2FrameRateHigh,	kRegMaskInput1FrameRateHigh,	kRegMaskInput2FrameRateHigh,
+																kRegMaskInput1FrameRateHigh,	kRegMaskInput2FrameRateHigh,	kRegMaskInput1FrameRateHigh,	kRegMaskInput2FrameRateHigh,	0};
+static const ULWord gChannelToSDIInputRateShift []			= { kRegShiftInput1FrameRate,		kRegShiftInput2FrameRate,		kRegShiftInput1FrameRate,		kRegShiftInput2FrameRate,
+																kRegShiftInput1FrameRate,		kRegShiftInput2FrameRate,		kRegShiftInput1FrameRate,		kRegShiftInput2FrameRate,		0};
+static const ULWord gChannelToSDIInputRateHighShift []		= { kRegShiftInput1FrameRateHigh,	kRegShiftInput2FrameRateHigh,	kRegShiftInput1FrameRateHigh,	kRegShiftInput2FrameRateHigh,
+																kRegShiftInput1FrameRateHigh,	kRegShiftInput2FrameRateHigh,	kRegShiftInput1FrameRateHigh,	kRegShiftInput2FrameRateHigh,	0};
+static const ULWord gChannelToSDIInputGeometryMask []		= { kRegMaskInput1Geometry,			kRegMaskInput2Geometry,			kRegMaskInput1Geometry,			kRegMaskInput2Geometry,
+																kRegMaskInput1Geometry,			kRegMaskInput2Geometry,			kRegMaskInput1Geometry,			kRegMaskInput2Geometry,			0};
+static const ULWord gChannelToSDIInputGeometryHighMask []	= { kRegMaskInput1GeometryHigh,		ULWord(kRegMaskInput2GeometryHigh), kRegMaskInput1GeometryHigh,		ULWord(kRegMaskInput2GeometryHigh),
+																kRegMaskInput1GeometryHigh,		ULWord(kRegMaskInput2GeometryHigh), kRegMaskInput1GeometryHigh,		ULWord(kRegMaskInput2GeometryHigh), 0};
+static const ULWord gChannelToSDIInputGeometryShift []		= { kRegShiftInput1Geometry,		kRegShiftInput2Geometry,		kRegShiftInput1Geometry,		kRegShiftInput2Geometry,
+																kRegShiftInput1Geometry,		kRegShiftInput2Geometry,		kRegShiftInput1Geometry,		kRegShiftInput2Geometry,		0};
+static const ULWord gChannelToSDIInputGeometryHighShift []	= { kRegShiftInput1GeometryHigh,	kRegShiftInput2GeometryHigh,	kRegShiftInput1GeometryHigh,	kRegShiftInput2GeometryHigh,
+																kRegShiftInput1GeometryHigh,	kRegShiftInput2GeometryHigh,	kRegShiftInput1GeometryHigh,	kRegShiftInput2GeometryHigh,	0};
+static const ULWord gChannelToSDIInputProgressiveMask []	= { kRegMaskInput1Progressive,		kRegMaskInput2Progressive,		kRegMaskInput1Progressive,		kRegMaskInput2Progressive,
+																kRegMaskInput1Progressive,		kRegMaskInput2Progressive,		kRegMaskInput1Progressive,		kRegMaskInput2Progressive,		0};
+static const ULWord gChannelToSDIInputProgressiveShift []	= { kRegShiftInput1Progressive,		kRegShiftInput2Progressive,		kRegShiftInput1Progressive,		kRegShiftInput2Progressive,
+																kRegShiftInput1Progressive,		kRegShiftInput2Progressive,		kRegShiftInput1Progressive,		kRegShiftInput2Progressive,		0};
+static const ULWord gChannelToSDIInput3GStatusRegNum []		= { kRegSDIInput3GStatus,		kRegSDIInput3GStatus,		kRegSDIInput3GStatus2,		kRegSDIInput3GStatus2,
+																kRegSDI5678Input3GStatus,	kRegSDI5678Input3GStatus,	kRegSDI5678Input3GStatus,	kRegSDI5678Input3GStatus,	0};
+static const ULWord gChannelToSDIIn3GModeMask []			= { kRegMaskSDIIn3GbpsMode,		kRegMaskSDIIn23GbpsMode,	kRegMaskSDIIn33GbpsMode,	kRegMaskSDIIn43GbpsMode,
+																kRegMaskSDIIn53GbpsMode,	kRegMaskSDIIn63GbpsMode,	kRegMaskSDIIn73GbpsMode,	kRegMaskSDIIn83GbpsMode,	0};
+static const ULWord gChannelToSDIIn3GModeShift []			= { kRegShiftSDIIn3GbpsMode,	kRegShiftSDIIn23GbpsMode,	kRegShiftSDIIn33GbpsMode,	kRegShiftSDIIn43GbpsMode,
+																kRegShiftSDIIn53GbpsMode,	kRegShiftSDIIn63GbpsMode,	kRegShiftSDIIn73GbpsMode,	kRegShiftSDIIn83GbpsMode,	0};
+static const ULWord	gChannelToSDIInVPIDLinkAValidMask []	= {	kRegMaskSDIInVPIDLinkAValid,	kRegMaskSDIIn2VPIDLinkAValid,	kRegMaskSDIIn3VPIDLinkAValid,	kRegMaskSDIIn4VPIDLinkAValid,
+																kRegMaskSDIIn5VPIDLinkAValid,	kRegMaskSDIIn6VPIDLinkAValid,	kRegMaskSDIIn7VPIDLinkAValid,	kRegMaskSDIIn8VPIDLinkAValid,	0};
+static const ULWord	gChannelToSDIInVPIDARegNum []			= {	kRegSDIIn1VPIDA,	kRegSDIIn2VPIDA,	kRegSDIIn3VPIDA,	kRegSDIIn4VPIDA,
+																kRegSDIIn5VPIDA,	kRegSDIIn6VPIDA,	kRegSDIIn7VPIDA,	kRegSDIIn8VPIDA,	0};
+static const ULWord sAncExtBaseRegNum []					= {	4096,	4160,	4224,	4288,	4352,	4416,	4480,	4544	};
+static const ULWord sAncInsBaseRegNum []					= {	4608,	4672,	4736,	4800,	4864,	4928,	4992,	5056	};
+
+
+//	One frame's worth of SDI output captured by a loopback source, waiting in its delay line.
+typedef struct SWLoopSlot
+{
+	bool		fValid;			///< @brief	Holds a captured frame?
+	bool		fDropped;		///< @brief	Lost "on the wire"?
+	NTV2Buffer	fVideo;			///< @brief	Output raster
+	ULWord		fVideoBytes;	///< @brief	Valid bytes in fVideo
+	NTV2Buffer	fAudio;			///< @brief	Output audio samples
+	ULWord		fAudioBytes;	///< @brief	Valid bytes in fAudio
+	ULWord		fAudioChannels;	///< @brief	Number of audio channels per sample in fAudio
+	NTV2Buffer	fAnc[2];		///< @brief	Output anc (GUMP) per field
+	ULWord		fAncBytes[2];	///< @brief	Valid bytes in fAnc
+	SWLoopSlot () : fValid(false), fDropped(false), fVideoBytes(0), fAudioBytes(0), fAudioChannels(0)	{fAncBytes[0] = fAncBytes[1] = 0;}
+} SWLoopSlot;
+
+static const ULWord		kSWMaxLoopFrames		(16);	//	Loopback delay line length (max delay + jitter + 1)
+
+//	Synthetic signal source for one SDI input. On each simulated VBI (at its own video format's frame rate), it writes
+//	a frame (a test pattern, or the next frame from a raw frame file) into the input channel's current input frame,
+//	tone samples into the same-numbered audio system's capture buffer, a test packet into the anc extractor's field
+//	buffer(s), and the next RP188 timecode, and keeps the SDI input status & VPID registers describing its format.
+//	A loopback source instead captures an SDI output's frame, audio & anc each VBI, and delivers it to the input
+//	through a delay line after a configurable latency, with optional frame drops, jitter and bit errors.
+typedef struct SWSignalSource
+{
+	bool					fEnabled;		///< @brief	Configured?
+	NTV2VideoFormat			fVideoFormat;	///< @brief	Video format being "received"
+	NTV2TestPatternSelect	fPattern;		///< @brief	Test pattern to draw (if no frame file)
+	string					fFramesPath;	///< @brief	Raw frame file path (if any)
+	double					fToneHz;		///< @brief	Embedded audio tone frequency (zero if no audio)
+	bool					fAnc;			///< @brief	Insert anc packets?
+	bool					fTimecode;		///< @brief	Insert RP188 timecode?
+	uint64_t				fPeriodUs;		///< @brief	Frame period, in microseconds
+	uint64_t				fFirstVBI;		///< @brief	First VBI produced (timecode zero)
+	uint64_t				fLastVBI;		///< @brief	Most recent VBI produced
+	NTV2PixelFormat			fFramesFBF;		///< @brief	Pixel format of fFrames
+	NTV2Buffer				fFrames;		///< @brief	Rendered test pattern, or frame file contents
+	ULWord					fFrameBytes;	///< @brief	Bytes per frame in fFrames
+	ULWord					fAudioSample;	///< @brief	Tone generator's next sample
+	ULWord					fAudioLastIn;	///< @brief	Capture buffer write offset
+	NTV2Channel				fLoopChannel;	///< @brief	SDI output to loop back from (NTV2_CHANNEL_INVALID if none)
+	ULWord					fLoopDelay;		///< @brief	Loopback latency, in frames
+	ULWord					fLoopJitter;	///< @brief	Max additional random latency, in frames
+	double					fLoopDropPct;	///< @brief	Percentage of frames dropped
+	double					fLoopBER;		///< @brief	Bit error rate
+	double					fLoopBitErrors;	///< @brief	Bit errors owed (fractional carry)
+	uint32_t				fLoopRandom;	///< @brief	Impairment PRNG state (seedable for reproducible runs)
+	uint64_t				fLoopFrames;	///< @brief	Frames captured so far
+	uint64_t				fLoopNextOut;	///< @brief	Oldest frame that can still be delivered (keeps jittered delivery in order)
+	ULWord					fAudioLastOut;	///< @brief	Playout buffer read offset
+	SWLoopSlot				fLoopSlots[kSWMaxLoopFrames];	///< @brief	Delay line
+	SWSignalSource ()
+		:	fEnabled(false), fVideoFormat(NTV2_FORMAT_1080p_5994_A), fPattern(NTV2_TestPatt_ColorBars100), fToneHz(0.0), fAnc(false),
+			fTimecode(false), fPeriodUs(0), fFirstVBI(0), fLastVBI(0), fFramesFBF(NTV2_FBF_INVALID), fFrames(0), fFrameBytes(0),
+			fAudioSample(0), fAudioLastIn(0), fLoopChannel(NTV2_CHANNEL_INVALID), fLoopDelay(1), fLoopJitter(0), fLoopDropPct(0.0),
+			fLoopBER(0.0), fLoopBitErrors(0.0), fLoopRandom(0x12345678), fLoopFrames(0), fLoopNextOut(0), fAudioLastOut(0)		{}
+	//	Returns a pseudo-random number in [0, 1)  (xorshift32 -- deterministic for a given seed)
+	double NextRandom (void)
+	{
+		fLoopRandom ^= fLoopRandom << 13;	fLoopRandom ^= fLoopRandom >> 17;	fLoopRandom ^= fLoopRandom << 5;
+		return double(fLoopRandom) / 4294967296.0;
+	}
+} SWSignalSource;
+
+static const ULWord		kSWFrameBytes			(8UL * 1024UL * 1024UL);	//	Frame size assumed by NTV2DMATransferRemote
+static const ULWord		kSWAudioCaptureOffset	(0x00400000);	//	4MB capture buffer follows 4MB playout buffer
+static const ULWord		kSWAudioCaptureBytes	(0x00400000);
+static const uint64_t	kSWMaxCatchUpVBIs		(8);	//	Don't produce more than this many frames of audio per VBI
+
+static ULWord SWNumAudioChannels (const ULWord inAudioControl)
+{
+	return (inAudioControl & kRegMaskAudio16Channel) ? 16 : ((inAudioControl & kRegMaskNumChannels) ? 8 : 6);
+}
+
+static NTV2ScanGeometry SWScanGeometryForVideoFormat (const NTV2VideoFormat inFormat)
+{
+	switch (::GetNTV2StandardFromVideoFormat(inFormat))
+	{
+		case NTV2_STANDARD_525:			return NTV2_SG_525;
+		case NTV2_STANDARD_625:			return NTV2_SG_625;
+		case NTV2_STANDARD_720:			return NTV2_SG_750;
+		case NTV2_STANDARD_1080:
+		case NTV2_STANDARD_1080p:		return ::GetDisplayWidth(inFormat) == 2048 ? NTV2_SG_2Kx1080 : NTV2_SG_1125;
+		case NTV2_STANDARD_2K:			return NTV2_SG_2Kx1556;
+		default:						break;
+	}
+	return NTV2_SG_UNKNOWN;
+}
+
+static TimecodeFormat SWTimecodeFormatForFrameRate (const NTV2FrameRate inRate)
+{
+	switch (inRate)
+	{
+		case NTV2_FRAMERATE_2398:
+		case NTV2_FRAMERATE_2400:		return kTCFormat24fps;
+		case NTV2_FRAMERATE_2500:		return kTCFormat25fps;
+		case NTV2_FRAMERATE_2997:		return kTCFormat30fpsDF;
+		case NTV2_FRAMERATE_3000:		return kTCFormat30fps;
+		case NTV2_FRAMERATE_4795:
+		case NTV2_FRAMERATE_4800:		return kTCFormat48fps;
+		case NTV2_FRAMERATE_5000:		return kTCFormat50fps;
+		case NTV2_FRAMERATE_5994:		return kTCFormat60fpsDF;
+		case NTV2_FRAMERATE_6000:		return kTCFormat60fps;
+		default:						break;
+	}
+	return kTCFormat30fps;
+}
+
+static string SWLower (const string & inStr)
+{
+	string result(inStr);
+	return aja::lower(result);
+}
+
+static NTV2VideoFormat SWVideoFormatFromString (const string & inStr)
+{
+	const string str (SWLower(inStr));
+	for (NTV2VideoFormat fmt(NTV2_FORMAT_FIRST_HIGH_DEF_FORMAT);  fmt < NTV2_MAX_NUM_VIDEO_FORMATS;  fmt = NTV2VideoFormat(fmt+1))
+		if (NTV2_IS_VALID_VIDEO_FORMAT(fmt))
+			if (SWLower(::NTV2VideoFormatToString(fmt)) == str  ||  SWLower(::NTV2VideoFormatToString(fmt, true)) == str)
+				return fmt;
+	return NTV2_FORMAT_UNKNOWN;
+}
 
 
 //	Specific NTV2RPCAPI implementation to talk to software device
@@ -158,7 +538,20 @@ class NTV2SoftwareDevice : public NTV2RPCAPI
 		virtual	void					InitRegs (void);
 		virtual bool					InitRegsFromSupportLog		(const string & inLogFilePath);
 		static uint32_t					GetSDRAMDumpFileSize		(const string & inFilePath);
-		virtual bool					InitSDRAMFromFile			(const string & inFilePath);
+		virtual bool					InitSDRAMFromFile			(const string & inFilePath, const bool inLazy);
+		virtual bool					SetupSignalSource			(const NTV2Channel inChannel, const string & inConfig);
+		virtual bool					HasSignalSources			(void) const;
+		static void						SignalSourceThreadStatic	(AJAThread * pThread, void * pContext);
+		virtual void					SignalSourceThread			(void);
+		virtual void					ProduceSignals				(const uint64_t inNowUs);
+		virtual void					ProduceInputStatus			(const NTV2Channel inChannel);
+		virtual void					ProduceVideo				(const NTV2Channel inChannel);
+		virtual void					ProduceAudio				(const NTV2Channel inChannel, const ULWord inNumVBIs);
+		virtual void					ProduceAnc					(const NTV2Channel inChannel);
+		virtual void					ProduceTimecode				(const NTV2Channel inChannel);
+		virtual void					ProduceLoopback				(const NTV2Channel inChannel);
+		virtual bool					GetAudioBufferOffset		(const NTV2AudioSystem inAudioSystem, ULWord & outOffset);
+		virtual void					WriteCaptureAudio			(const NTV2Channel inChannel, const NTV2Buffer & inSamples, const ULWord inNumBytes);
 //		virtual NTV2AutoCirc *			ACContext (void)			{return mpContext;}
 
 	//	Instance Data
@@ -174,6 +567,9 @@ class NTV2SoftwareDevice : public NTV2RPCAPI
 		NTV2DeviceID	mDeviceID;			///< @brief	My device ID, if known
 		uint64_t		mSerialNum;			///< @brief	My serial number, if known
 		string			mHostname;			///< @brief	My "host" name
+		SWSignalSource	mSources[NTV2_MAX_NUM_CHANNELS];	///< @brief	Synthetic signal source per SDI input
+		AJAThread		mSourceThread;		///< @brief	Produces my signal sources' data at their frame rates
+		AJAAtomicFlag	mQuitSources;		///< @brief	Set to stop mSourceThread
 //		NTV2AutoCirc*	mpContext;			//	<== TBD TBD TBD		Use user-space driver code
 };	//	NTV2SoftwareDevice
 
@@ -210,7 +606,8 @@ NTV2SoftwareDevice::NTV2SoftwareDevice (void * pInDLLHandle, const NTV2ConnectPa
 		mFBReqBytes		(kDefaultNumFBBytes),
 		mDeviceID		(DEVICE_ID_NOTFOUND),
 		mSerialNum		(0),
-        mHostname		(FAKE_DEVICE_SHARE_NAME)
+        mHostname		(FAKE_DEVICE_SHARE_NAME),
+		mQuitSources	(false)
 //		,mpContext		(AJA_NULL)		//	<== TBD TBD TBD		Use user-space driver code
 {
 	string queryStr(ConnectParam(kConnectParamQuery));
@@ -307,6 +704,11 @@ bool NTV2SoftwareDevice::NTV2Connect (void)
 				{NBFAIL(Name() << " 'SDRAM' file size is " << xHEX0N(mFBReqBytes,8) << " bytes -- expected " << xHEX0N(k128MB,8) << " (128MB) or larger");  return false;}
 			NBINFO(Name() << " 'SDRAM' parameter value '" << sdramPath << "' specified: " << DEC(mFBReqBytes) << "(" << xHEX0N(mFBReqBytes,8) << ") bytes");
 		}
+		else if (key.length() == 6  &&  key.find("input") == 0  &&  key[5] >= '1'  &&  key[5] <= '8')
+		{
+			if (!SetupSignalSource(NTV2Channel(key[5] - '1'), value))
+				return false;
+		}
 		else if (key == "help")
 		{
 			ostringstream oss;
@@ -315,7 +717,21 @@ bool NTV2SoftwareDevice::NTV2Connect (void)
 				<< "Name                Reqd    Default     Desc" << endl
 				<< "nosharedmemory      No      N/A         If specified, device memory is allocated privately instead of globally shared." << endl
 				<< "supportlog=fileurl  No      N/A         Specifies URL-encoded path to support log file to initialize registers." << endl
-				<< "sdram=fileurl       No      N/A         Specifies URL-encoded path to binary data file to initialize SDRAM.";
+				<< "sdram=fileurl       No      N/A         Specifies URL-encoded path to binary data file (raw or compact SDRAM dump) to initialize SDRAM." << endl
+				<< "                                        With nosharedmemory, the file is mapped and loaded on demand." << endl
+				<< "input1..8=items     No      N/A         Simulates a signal on the given SDI input. URL-encoded, comma-separated items:" << endl
+				<< "                                          pattern:name  test pattern (default: 100% color bars)" << endl
+				<< "                                          file:fileurl  raw frames (in the channel's pixel format) to play in a loop" << endl
+				<< "                                          format:name   video format (default: 1080p59.94a)" << endl
+				<< "                                          tone[:hz]     embedded audio tone (default: 1000Hz)" << endl
+				<< "                                          anc           anc packet (DID 0x50 SID 0x01) into the anc extractor buffer" << endl
+				<< "                                          tc            RP188 timecode" << endl
+				<< "                                          loop[:n]      loop back SDI output n (default: same number), with optional:" << endl
+				<< "                                          delay:frames  latency (default: 1 frame)" << endl
+				<< "                                          jitter:frames up to this many extra random frames of latency" << endl
+				<< "                                          drop:percent  percentage of frames lost" << endl
+				<< "                                          ber:rate      video bit error rate" << endl
+				<< "                                          seed:n        impairment random seed";
 			NBINFO(oss.str());
 			cerr << oss.str() << endl;
 			return false;
@@ -432,7 +848,7 @@ bool NTV2SoftwareDevice::NTV2Connect (void)
 
 		//	Set SDRAM...
 		if (!sdramPath.empty())			//	sdramPath specified?
-			if (!InitSDRAMFromFile (sdramPath))	//	Load SDRAM from dump file
+			if (!InitSDRAMFromFile (sdramPath, !useSharedMemory))	//	Load SDRAM from dump file
 			{
 				spFakeDevice = AJA_NULL;
 				NTV2Disconnect();
@@ -447,6 +863,15 @@ bool NTV2SoftwareDevice::NTV2Connect (void)
 		return false;
 	}
 
+	//	Start producing signals...
+	if (HasSignalSources()  &&  !mSourceThread.Active())
+	{
+		mQuitSources.Clear();
+		mSourceThread.Attach(SignalSourceThreadStatic, this);
+		mSourceThread.SetPriority(AJA_ThreadPriority_High);
+		mSourceThread.Start();
+	}
+
 	NBINFO(Description() << " is ready, vers=" << spFakeDevice->fVersion
 			<< " refCnt=" << spFakeDevice->fClientRefCount
 			<< " reg=" << spFakeDevice->fNumRegBytes << " fb=" << spFakeDevice->fNumFBBytes
@@ -456,6 +881,11 @@ bool NTV2SoftwareDevice::NTV2Connect (void)
 
 bool NTV2SoftwareDevice::NTV2Disconnect (void)
 {
+	if (mSourceThread.Active())
+	{
+		mQuitSources.Set();
+		mSourceThread.Stop();
+	}
 	NBINFO("");
 	return true;
 }
@@ -535,10 +965,7 @@ bool NTV2SoftwareDevice::NTV2WriteRegisterRemote (const ULWord inRegNum, const U
 	if (inRegNum * sizeof(ULWord) > mRegMemory.GetByteCount())
 		return false;	//	Bad reg num
 	uint32_t & reg(mRegMemory.U32(int(inRegNum)));
-//	ULWord oldValue(reg & inRegMask);
-	ULWord newValue(inRegVal & inRegMask);
-	if (inRegShift)
-		newValue <<= inRegShift;
+	const ULWord newValue((inRegVal << inRegShift) & inRegMask);	//	Same as the driver:  shift, then mask
 	reg &= ~inRegMask;
 	reg |= newValue;
 	return true;
@@ -561,13 +988,43 @@ bool NTV2SoftwareDevice::NTV2AutoCirculateRemote (AUTOCIRCULATE_DATA & autoCircD
 }
 
 bool NTV2SoftwareDevice::NTV2WaitForInterruptRemote (const INTERRUPT_ENUMS eInterrupt, const ULWord timeOutMs)
-{	(void)eInterrupt; (void)timeOutMs;
-	AJAAutoLock lock(&sLock);
-	if (!spFakeDevice)
-		return false;
-	if (spFakeDevice->fVersion != 1)
-		return false;
-	//	TBD
+{
+	if (!NTV2_IS_INPUT_INTERRUPT(eInterrupt)  &&  !NTV2_IS_OUTPUT_INTERRUPT(eInterrupt))
+		return false;	//	Only vertical interrupts are simulated
+	ULWord frameRate(NTV2_FRAMERATE_UNKNOWN);
+	{
+		AJAAutoLock lock(&sLock);
+		if (!spFakeDevice)
+			return false;
+		if (spFakeDevice->fVersion != 1)
+			return false;
+		if (!mRegMemory)
+			return false;
+		const ULWord globalCtrl(mRegMemory.U32(int(kRegGlobalControl)));
+		frameRate = ((globalCtrl & kRegMaskFrameRate) >> kRegShiftFrameRate)
+					| (((globalCtrl & kRegMaskFrameRateHiBit) >> kRegShiftFrameRateHiBit) << 3);
+	}	//	Don't hold sLock while sleeping
+
+	//	Simulate a VBI at every frame boundary of the device's current frame rate, all channels in lock-step...
+	double fps(::GetFramesPerSecond(NTV2FrameRate(frameRate)));
+	if (fps <= 0.0)
+		fps = 30000.0 / 1001.0;
+	uint64_t	periodUs (uint64_t(1000000.0 / fps));
+	bool		isSourceInput (false);
+	if (NTV2_IS_INPUT_INTERRUPT(eInterrupt))
+		for (NTV2Channel ch(NTV2_CHANNEL1);  ch < NTV2_MAX_NUM_CHANNELS;  ch = NTV2Channel(ch+1))
+			if (::NTV2ChannelToInputInterrupt(ch) == eInterrupt  &&  mSources[ch].fEnabled)
+				{periodUs = mSources[ch].fPeriodUs;  isSourceInput = true;  break;}	//	Input VBIs follow the source's frame rate
+	const uint64_t	nowUs (AJATime::GetSystemMicroseconds());
+	const uint64_t	waitUs (periodUs - (nowUs % periodUs));
+	if (waitUs > uint64_t(timeOutMs) * 1000ULL)
+	{
+		AJATime::SleepInMicroseconds(int32_t(timeOutMs) * 1000);
+		return false;	//	Timed out
+	}
+	AJATime::SleepInMicroseconds(int32_t(waitUs));
+	if (isSourceInput)
+		ProduceSignals(AJATime::GetSystemMicroseconds());	//	Don't make the caller race my source thread
 	return true;
 }
 
@@ -584,15 +1041,26 @@ bool NTV2SoftwareDevice::NTV2DMATransferRemote (const NTV2DMAEngine inDMAEngine,
 	if (!inSynchronous)
 		return false;	//	Must be synchronous
 
+	if (sSDRAMImage.IsOpen())
+	{	//	Load any not-yet-loaded parts of the SDRAM dump file this transfer touches...
+		const uint64_t frameOffset (inFrameNumber * 8ULL*1024ULL*1024ULL);
+		if (inNumSegments)
+			sSDRAMImage.Load(mFBMemory, frameOffset + inCardOffsetBytes,
+							uint64_t(inNumSegments - 1) * inSegmentCardPitch + inOutBuffer.GetByteCount() / inNumSegments);
+		else
+			sSDRAMImage.Load(mFBMemory, frameOffset + inCardOffsetBytes, inOutBuffer.GetByteCount());
+	}
+
 	if (inNumSegments)
 	{
+		const ULWord			cardOffset (inFrameNumber * 8UL*1024UL*1024UL + inCardOffsetBytes);	//	!!! ASSUMES 8MB FRAMES!
 		NTV2SegmentedXferInfo	xferInfo;
-		xferInfo.setDestOffset(inCardOffsetBytes).setSegmentCount(inNumSegments);
+		xferInfo.setSegmentCount(inNumSegments);
 		xferInfo.setSegmentLength(inOutBuffer.GetByteCount() / inNumSegments);
-		xferInfo.setSourceOffset(0);
-		xferInfo.setSourcePitch(inSegmentHostPitch);
-		xferInfo.setDestOffset(inFrameNumber * 8ULL*1024ULL*1024ULL + inCardOffsetBytes);	//	!!! ASSUMES 8MB FRAMES!
-		xferInfo.setDestPitch(inSegmentCardPitch);
+		xferInfo.setSourceOffset(inIsRead ? cardOffset : 0);				//	Source is the device when reading...
+		xferInfo.setSourcePitch(inIsRead ? inSegmentCardPitch : inSegmentHostPitch);
+		xferInfo.setDestOffset(inIsRead ? 0 : cardOffset);					//	...and the host when writing
+		xferInfo.setDestPitch(inIsRead ? inSegmentHostPitch : inSegmentCardPitch);
 		if (inIsRead)
 			return inOutBuffer.CopyFrom(mFBMemory, xferInfo);
 		else
@@ -600,10 +1068,11 @@ bool NTV2SoftwareDevice::NTV2DMATransferRemote (const NTV2DMAEngine inDMAEngine,
 	}
 	else
 	{
+		const ULWord	cardOffset (inFrameNumber * 8UL*1024UL*1024UL + inCardOffsetBytes);	//	!!! ASSUMES 8MB FRAMES!
 		if (inIsRead)
-			return inOutBuffer.CopyFrom(mFBMemory, inFrameNumber * 8UL*1024ULL*1024ULL,  0,  inOutBuffer.GetByteCount());
+			return inOutBuffer.CopyFrom(mFBMemory, cardOffset,  0,  inOutBuffer.GetByteCount());
 		else
-			return mFBMemory.CopyFrom(inOutBuffer, inFrameNumber * 8UL*1024ULL*1024ULL,  0,  inOutBuffer.GetByteCount());
+			return mFBMemory.CopyFrom(inOutBuffer, 0,  cardOffset,  inOutBuffer.GetByteCount());
 	}
 }
 
@@ -625,6 +1094,21 @@ bool NTV2SoftwareDevice::NTV2MessageRemote (NTV2_HEADER * pInMessage)
 		{NBFAIL("Bad NTV2_TRAILER tag");  return false;}
 
 	//	Dispatch...
+	if (pInMessage->GetType() == NTV2_TYPE_GETREGS)
+	{	//	Read the batch here, saving the caller (e.g. a virtualdev on top of me) a call per register...
+		NTV2GetRegisters &	getRegs	(*AsNTV2GetRegisters(pInMessage));
+		NTV2RegNumSet		regNums;
+		if (!getRegs.GetRequestedRegisterNumbers(regNums))
+			return false;
+		for (NTV2RegNumSetConstIter it(regNums.begin());  it != regNums.end();  ++it)
+		{
+			ULWord regValue(0);
+			if (NTV2ReadRegisterRemote (*it, regValue))
+				if (!getRegs.AddRegisterValue(*it, regValue))
+					return false;
+		}
+		return true;
+	}
 /**	switch (pInMessage->GetType())
 	{
 		case NTV2_TYPE_ACSTATUS:		return !AutoCirculateGetStatus (ACContext(), AsAUTOCIRCULATE_STATUS(pInMessage));
@@ -653,6 +1137,493 @@ bool NTV2SoftwareDevice::NTV2MessageRemote (NTV2_HEADER * pInMessage)
 	return false;
 }
 
+bool NTV2SoftwareDevice::SetupSignalSource (const NTV2Channel inChannel, const string & inConfig)
+{
+	SWSignalSource & src (mSources[inChannel]);
+	const NTV2StringList items (aja::split(inConfig, ","));
+	for (NTV2StringListConstIter it(items.begin());  it != items.end();  ++it)
+	{
+		string item(*it), arg;
+		aja::strip(item);
+		const size_t colonPos (item.find(':'));
+		if (colonPos != string::npos)
+			{arg = item.substr(colonPos + 1);  item.erase(colonPos);}
+		item = SWLower(item);
+		if (item.empty())
+			continue;
+		if (item == "pattern")
+		{
+			src.fPattern = NTV2TestPatternGen::findTestPatternByName(arg);
+			if (!NTV2_IS_VALID_PATTERN(src.fPattern))
+				{NBFAIL("'input" << DEC(inChannel+1) << "': unknown test pattern '" << arg << "'");  return false;}
+		}
+		else if (item == "file")
+		{
+			const string URI_head("file://");
+			if (arg.find(URI_head) != 0)
+				{NBFAIL("'input" << DEC(inChannel+1) << "': 'file' URL invalid -- expected '" << URI_head << "' scheme");  return false;}
+			src.fFramesPath = arg.substr(URI_head.length());
+			ifstream ifs(src.fFramesPath.c_str(), ios::binary | ios::ate);
+			const streamoff fileBytes (ifs.good() ? streamoff(ifs.tellg()) : streamoff(0));
+			if (fileBytes <= 0  ||  fileBytes > streamoff(0x7FFFFFFF))
+				{NBFAIL("'input" << DEC(inChannel+1) << "': frame file '" << src.fFramesPath << "' missing, empty or too large");  return false;}
+			if (!src.fFrames.Allocate(ULWord(fileBytes)))
+				{NBFAIL("'input" << DEC(inChannel+1) << "': unable to allocate " << DEC(fileBytes) << " bytes for frame file");  return false;}
+			ifs.seekg(0, ios::beg);
+			if (!ifs.read(reinterpret_cast<char*>(src.fFrames.GetHostPointer()), streamsize(fileBytes)))
+				{NBFAIL("'input" << DEC(inChannel+1) << "': unable to read frame file '" << src.fFramesPath << "'");  return false;}
+		}
+		else if (item == "format")
+		{
+			src.fVideoFormat = SWVideoFormatFromString(arg);
+			if (!NTV2_IS_VALID_VIDEO_FORMAT(src.fVideoFormat))
+				{NBFAIL("'input" << DEC(inChannel+1) << "': unknown video format '" << arg << "'");  return false;}
+		}
+		else if (item == "tone")
+		{
+			src.fToneHz = arg.empty() ? 1000.0 : aja::stod(arg);
+			if (src.fToneHz <= 0.0)
+				{NBFAIL("'input" << DEC(inChannel+1) << "': bad tone frequency '" << arg << "'");  return false;}
+		}
+		else if (item == "anc")
+			src.fAnc = true;
+		else if (item == "tc")
+			src.fTimecode = true;
+		else if (item == "loop")
+		{
+			const int outNum (arg.empty() ? int(inChannel) + 1 : aja::stoi(arg));
+			if (outNum < 1  ||  outNum > int(NTV2_MAX_NUM_CHANNELS))
+				{NBFAIL("'input" << DEC(inChannel+1) << "': bad loopback output '" << arg << "'");  return false;}
+			src.fLoopChannel = NTV2Channel(outNum - 1);
+		}
+		else if (item == "delay")
+			src.fLoopDelay = ULWord(aja::stoul(arg));
+		else if (item == "jitter")
+			src.fLoopJitter = ULWord(aja::stoul(arg));
+		else if (item == "drop")
+			src.fLoopDropPct = aja::stod(arg);
+		else if (item == "ber")
+			src.fLoopBER = aja::stod(arg);
+		else if (item == "seed")
+			src.fLoopRandom = uint32_t(aja::stoul(arg)) | 1;	//	xorshift state must be non-zero
+		else
+			{NBFAIL("'input" << DEC(inChannel+1) << "': unknown source item '" << item << "'");  return false;}
+	}	//	for each item
+
+	if (src.fLoopDelay + src.fLoopJitter >= kSWMaxLoopFrames)
+		{NBFAIL("'input" << DEC(inChannel+1) << "': loopback delay + jitter must be less than " << DEC(kSWMaxLoopFrames) << " frames");  return false;}
+	if (src.fLoopDropPct < 0.0  ||  src.fLoopDropPct > 100.0  ||  src.fLoopBER < 0.0  ||  src.fLoopBER > 0.01)
+		{NBFAIL("'input" << DEC(inChannel+1) << "': 'drop' must be 0-100 (percent), 'ber' must be 0-0.01");  return false;}
+
+	double fps (::GetFramesPerSecond(::GetNTV2FrameRateFromVideoFormat(src.fVideoFormat)));
+	if (fps <= 0.0)
+		fps = 30000.0 / 1001.0;
+	src.fPeriodUs = uint64_t(1000000.0 / fps);	//	One VBI per frame (even for interlaced formats)
+	src.fEnabled = true;
+	if (NTV2_IS_VALID_CHANNEL(src.fLoopChannel))
+		NBINFO("'input" << DEC(inChannel+1) << "' source: " << ::NTV2VideoFormatToString(src.fVideoFormat) << " loopback from output "
+				<< DEC(src.fLoopChannel+1) << " delay=" << DEC(src.fLoopDelay) << " jitter=" << DEC(src.fLoopJitter)
+				<< " drop=" << src.fLoopDropPct << "% ber=" << src.fLoopBER << (src.fTimecode ? " tc" : ""));
+	else
+		NBINFO("'input" << DEC(inChannel+1) << "' source: " << ::NTV2VideoFormatToString(src.fVideoFormat)
+				<< (src.fFramesPath.empty() ? string(" pattern '") + NTV2TestPatternGen::getTestPatternNames().at(src.fPattern) + "'" : string(" file '") + src.fFramesPath + "'")
+				<< (src.fToneHz > 0.0 ? " tone" : "") << (src.fAnc ? " anc" : "") << (src.fTimecode ? " tc" : ""));
+	return true;
+}	//	SetupSignalSource
+
+bool NTV2SoftwareDevice::HasSignalSources (void) const
+{
+	for (size_t ndx(0);  ndx < NTV2_MAX_NUM_CHANNELS;  ndx++)
+		if (mSources[ndx].fEnabled)
+			return true;
+	return false;
+}
+
+void NTV2SoftwareDevice::SignalSourceThreadStatic (AJAThread * pThread, void * pContext)
+{	(void) pThread;
+	NTV2SoftwareDevice * pDevice (reinterpret_cast<NTV2SoftwareDevice*>(pContext));
+	if (pDevice)
+		pDevice->SignalSourceThread();
+}
+
+void NTV2SoftwareDevice::SignalSourceThread (void)
+{
+	NBINFO("started");
+	while (!mQuitSources.IsSet()  &&  !mSourceThread.Terminate())
+	{
+		//	Sleep until the earliest upcoming VBI of any source (but never too long, to stay responsive to Stop)...
+		const uint64_t	nowUs (AJATime::GetSystemMicroseconds());
+		uint64_t		waitUs (100000);
+		for (size_t ndx(0);  ndx < NTV2_MAX_NUM_CHANNELS;  ndx++)
+			if (mSources[ndx].fEnabled  &&  mSources[ndx].fPeriodUs)
+				waitUs = std::min(waitUs, mSources[ndx].fPeriodUs - (nowUs % mSources[ndx].fPeriodUs));
+		AJATime::SleepInMicroseconds(int32_t(waitUs));
+		ProduceSignals(AJATime::GetSystemMicroseconds());
+	}
+	NBINFO("ended");
+}	//	SignalSourceThread
+
+void NTV2SoftwareDevice::ProduceSignals (const uint64_t inNowUs)
+{
+	AJAAutoLock lock(&sLock);
+	if (!spFakeDevice  ||  !mRegMemory  ||  !mFBMemory)
+		return;
+	for (NTV2Channel ch(NTV2_CHANNEL1);  ch < NTV2_MAX_NUM_CHANNELS;  ch = NTV2Channel(ch+1))
+	{
+		SWSignalSource & src (mSources[ch]);
+		if (!src.fEnabled  ||  !src.fPeriodUs)
+			continue;
+		const uint64_t vbi (inNowUs / src.fPeriodUs);
+		if (src.fLastVBI  &&  vbi <= src.fLastVBI)
+			continue;	//	Already produced this VBI (e.g. by NTV2WaitForInterruptRemote)
+		const uint64_t numVBIs (src.fLastVBI ? std::min(vbi - src.fLastVBI, kSWMaxCatchUpVBIs) : 1);
+		if (!src.fFirstVBI)
+			src.fFirstVBI = vbi;
+		src.fLastVBI = vbi;
+
+		ProduceInputStatus(ch);
+		if (NTV2_IS_VALID_CHANNEL(src.fLoopChannel))
+		{
+			for (uint64_t n(0);  n < numVBIs;  n++)
+				ProduceLoopback(ch);	//	Keep the delay line & audio clocks advancing through missed VBIs
+		}
+		else
+		{
+			ProduceVideo(ch);
+			if (src.fToneHz > 0.0)
+				ProduceAudio(ch, ULWord(numVBIs));
+			if (src.fAnc)
+				ProduceAnc(ch);
+		}
+		if (src.fTimecode)
+			ProduceTimecode(ch);
+	}	//	for each channel
+}	//	ProduceSignals
+
+void NTV2SoftwareDevice::ProduceInputStatus (const NTV2Channel inChannel)
+{
+	const SWSignalSource &	src		(mSources[inChannel]);
+	const NTV2VideoFormat	vf		(src.fVideoFormat);
+	const ULWord			rate	(::GetNTV2FrameRateFromVideoFormat(vf));
+	const ULWord			geom	(::SWScanGeometryForVideoFormat(vf));
+	const bool				isProg	(::IsProgressiveTransport(vf));
+	const ULWord			statReg	(gChannelToSDIInputStatusRegNum[inChannel]);
+	NTV2WriteRegisterRemote (statReg, rate & 0x7,			gChannelToSDIInputRateMask[inChannel],			gChannelToSDIInputRateShift[inChannel]);
+	NTV2WriteRegisterRemote (statReg, (rate >> 3) & 0x1,	gChannelToSDIInputRateHighMask[inChannel],		gChannelToSDIInputRateHighShift[inChannel]);
+	NTV2WriteRegisterRemote (statReg, geom & 0x7,			gChannelToSDIInputGeometryMask[inChannel],		gChannelToSDIInputGeometryShift[inChannel]);
+	NTV2WriteRegisterRemote (statReg, (geom >> 3) & 0x1,	gChannelToSDIInputGeometryHighMask[inChannel],	gChannelToSDIInputGeometryHighShift[inChannel]);
+	NTV2WriteRegisterRemote (statReg, isProg ? 1 : 0,		gChannelToSDIInputProgressiveMask[inChannel],	gChannelToSDIInputProgressiveShift[inChannel]);
+	NTV2WriteRegisterRemote (gChannelToSDIInput3GStatusRegNum[inChannel], NTV2_IS_3G_FORMAT(vf) ? 1 : 0,
+							gChannelToSDIIn3GModeMask[inChannel], gChannelToSDIIn3GModeShift[inChannel]);
+
+	CNTV2VPID vpid;
+	if (vpid.SetVPID(vf, NTV2_FBF_10BIT_YCBCR, isProg, true, VPIDChannel_1))
+	{
+		NTV2WriteRegisterRemote (gChannelToSDIInVPIDARegNum[inChannel], mDeviceID == DEVICE_ID_KONALHI ? vpid.GetVPID() : NTV2EndianSwap32(vpid.GetVPID()));
+		NTV2WriteRegisterRemote (gChannelToSDIInput3GStatusRegNum[inChannel], gChannelToSDIInVPIDLinkAValidMask[inChannel], gChannelToSDIInVPIDLinkAValidMask[inChannel]);
+	}
+}	//	ProduceInputStatus
+
+void NTV2SoftwareDevice::ProduceVideo (const NTV2Channel inChannel)
+{
+	SWSignalSource & src (mSources[inChannel]);
+	ULWord ctrlLo(0), ctrlHi(0), frameNum(0);
+	NTV2ReadRegisterRemote (gChannelToControlRegNum[inChannel], ctrlLo, kRegMaskFrameFormat, kRegShiftFrameFormat);
+	NTV2ReadRegisterRemote (gChannelToControlRegNum[inChannel], ctrlHi, kRegMaskFrameFormatHiBit, kRegShiftFrameFormatHiBit);
+	NTV2ReadRegisterRemote (gChannelToInputFrameRegNum[inChannel], frameNum);
+	const NTV2PixelFormat		fbf	(NTV2PixelFormat((ctrlLo & 0xF) | ((ctrlHi & 0x1) << 4)));
+	const NTV2FormatDescriptor	fd	(src.fVideoFormat, fbf);
+	if (!fd.IsValid())
+		return;
+	const ULWord frameBytes (fd.GetTotalRasterBytes());
+	if (frameBytes > kSWFrameBytes)
+		return;	//	Won't fit in an 8MB frame
+
+	if (src.fFramesPath.empty()  &&  (fbf != src.fFramesFBF  ||  frameBytes != src.fFrameBytes))
+	{	//	Host changed the pixel format -- re-render the test pattern...
+		NTV2TestPatternGen	tpg;
+		src.fFramesFBF = NTV2_FBF_INVALID;
+		if (!src.fFrames.Allocate(frameBytes)  ||  !tpg.DrawTestPattern(src.fPattern, fd, src.fFrames))
+			{NBWARN("Ch" << DEC(inChannel+1) << ": can't draw test pattern in " << ::NTV2FrameBufferFormatToString(fbf));  src.fFrameBytes = 0;  return;}
+		src.fFramesFBF = fbf;
+		src.fFrameBytes = frameBytes;
+	}
+	else if (!src.fFramesPath.empty())
+		src.fFrameBytes = frameBytes;	//	Frame file is presumed to already be in the channel's pixel format
+	if (!src.fFrameBytes  ||  src.fFrames.GetByteCount() < src.fFrameBytes)
+		return;
+
+	const ULWord	numFrames	(src.fFrames.GetByteCount() / src.fFrameBytes);
+	const ULWord	srcFrame	(ULWord((src.fLastVBI - src.fFirstVBI) % numFrames));
+	const ULWord	dstOffset	(frameNum * kSWFrameBytes);
+	if (ULWord64(dstOffset) + src.fFrameBytes > mFBMemory.GetByteCount())
+		return;
+	mFBMemory.CopyFrom(src.fFrames, srcFrame * src.fFrameBytes, dstOffset, src.fFrameBytes);
+}	//	ProduceVideo
+
+bool NTV2SoftwareDevice::GetAudioBufferOffset (const NTV2AudioSystem inAudioSystem, ULWord & outOffset)
+{
+	outOffset = 0;
+	if (!::NTV2DeviceCanDoStackedAudio(mDeviceID))
+		return false;	//	Only stacked audio is simulated
+	if (ULWord(inAudioSystem) >= ::NTV2DeviceGetNumAudioSystems(mDeviceID))
+		return false;
+	const ULWord	memSize	(::NTV2DeviceGetActiveMemorySize(mDeviceID));
+	if (memSize < kSWFrameBytes * ULWord(inAudioSystem + 1))
+		return false;
+	outOffset = memSize - kSWFrameBytes * ULWord(inAudioSystem + 1);
+	return ULWord64(outOffset) + kSWAudioCaptureOffset + kSWAudioCaptureBytes <= mFBMemory.GetByteCount();
+}
+
+void NTV2SoftwareDevice::WriteCaptureAudio (const NTV2Channel inChannel, const NTV2Buffer & inSamples, const ULWord inNumBytes)
+{
+	SWSignalSource &		src			(mSources[inChannel]);
+	const NTV2AudioSystem	audioSystem	(static_cast<NTV2AudioSystem>(inChannel));
+	ULWord bufOffset(0);
+	if (!GetAudioBufferOffset(audioSystem, bufOffset))
+		return;
+	bufOffset += kSWAudioCaptureOffset;
+
+	//	Write into the capture buffer, wrapping as needed...
+	ULWord lastIn (src.fAudioLastIn % kSWAudioCaptureBytes);
+	const ULWord numBytes (std::min(inNumBytes, inSamples.GetByteCount()));
+	const ULWord firstPart (std::min(numBytes, kSWAudioCaptureBytes - lastIn));
+	mFBMemory.CopyFrom(inSamples, 0, bufOffset + lastIn, firstPart);
+	if (firstPart < numBytes)
+		mFBMemory.CopyFrom(inSamples, firstPart, bufOffset, numBytes - firstPart);
+	src.fAudioLastIn = (lastIn + numBytes) % kSWAudioCaptureBytes;
+	NTV2WriteRegisterRemote (gChannelToAudioInLastAddrRegNum[audioSystem], src.fAudioLastIn);
+}	//	WriteCaptureAudio
+
+void NTV2SoftwareDevice::ProduceAudio (const NTV2Channel inChannel, const ULWord inNumVBIs)
+{
+	SWSignalSource &		src			(mSources[inChannel]);
+	const NTV2AudioSystem	audioSystem	(static_cast<NTV2AudioSystem>(inChannel));
+	ULWord bufOffset(0), audCtrl(0);
+	if (!GetAudioBufferOffset(audioSystem, bufOffset))
+		return;
+	NTV2ReadRegisterRemote (gAudioSystemToAudioControlRegNum[audioSystem], audCtrl);
+	if (audCtrl & kRegMaskResetAudioInput)
+	{	//	Capture is held in reset -- rewind
+		src.fAudioLastIn = 0;
+		NTV2WriteRegisterRemote (gChannelToAudioInLastAddrRegNum[audioSystem], 0);
+		return;
+	}
+	const ULWord		numChannels	(::SWNumAudioChannels(audCtrl));
+	const NTV2AudioRate	audioRate	((audCtrl & kRegMaskAudioRate) ? NTV2_AUDIO_96K : NTV2_AUDIO_48K);
+	const double		sampleRate	(audioRate == NTV2_AUDIO_96K ? 96000.0 : 48000.0);
+	const NTV2FrameRate	frameRate	(::GetNTV2FrameRateFromVideoFormat(src.fVideoFormat));
+
+	ULWord numSamples(0);
+	for (ULWord vbi(0);  vbi < inNumVBIs;  vbi++)
+		numSamples += ::GetAudioSamplesPerFrame(frameRate, audioRate, ULWord(src.fLastVBI - src.fFirstVBI + 1 - inNumVBIs + vbi));
+	NTV2Buffer samples (numSamples * numChannels * sizeof(ULWord));
+	if (!samples)
+		return;
+	const ULWord numBytes (::AddAudioTone(reinterpret_cast<ULWord*>(samples.GetHostPointer()), src.fAudioSample, numSamples, sampleRate, 0.5, src.fToneHz, 32, false, numChannels));
+	WriteCaptureAudio(inChannel, samples, numBytes);
+}	//	ProduceAudio
+
+void NTV2SoftwareDevice::ProduceAnc (const NTV2Channel inChannel)
+{
+	const SWSignalSource &	src		(mSources[inChannel]);
+	const ULWord			baseReg	(sAncExtBaseRegNum[inChannel]);
+	ULWord ctrl(0), f1Start(0), f1End(0), f2Start(0), f2End(0);
+	NTV2ReadRegisterRemote (baseReg + regAncExtControl, ctrl);
+	if (ctrl & maskDisableExtractor)
+		return;
+	NTV2ReadRegisterRemote (baseReg + regAncExtField1StartAddress, f1Start);
+	NTV2ReadRegisterRemote (baseReg + regAncExtField1EndAddress, f1End);
+	NTV2ReadRegisterRemote (baseReg + regAncExtField2StartAddress, f2Start);
+	NTV2ReadRegisterRemote (baseReg + regAncExtField2EndAddress, f2End);
+
+	//	One packet per field:  DID 0x50 SID 0x01 (user-defined), payload is the frame count...
+	ostringstream payload;  payload << "swdevice ch" << DEC(inChannel+1) << " frame " << DEC(src.fLastVBI - src.fFirstVBI);
+	const string payloadStr (payload.str());
+	AJAAncillaryData pkt;
+	pkt.SetDID(0x50);
+	pkt.SetSID(0x01);
+	pkt.SetLocationLineNumber(9);
+	pkt.SetPayloadData(reinterpret_cast<const uint8_t*>(payloadStr.c_str()), uint32_t(payloadStr.length()));
+
+	const bool isProg (::IsProgressiveTransport(src.fVideoFormat));
+	for (int field(0);  field < (isProg ? 1 : 2);  field++)
+	{
+		const ULWord startAddr (field ? f2Start : f1Start), endAddr (field ? f2End : f1End);
+		uint32_t numBytes(0);
+		if (startAddr < endAddr  &&  ULWord64(endAddr) < mFBMemory.GetByteCount())
+		{
+			if (field)
+				pkt.SetLocationLineNumber(::GetDisplayHeight(src.fVideoFormat) / 2 + 9);	//	Approximate F2 line
+			pkt.GenerateTransmitData(reinterpret_cast<uint8_t*>(mFBMemory.GetHostAddress(startAddr)), endAddr - startAddr, numBytes);
+		}
+		NTV2WriteRegisterRemote (baseReg + (field ? regAncExtField2Status : regAncExtField1Status), numBytes);
+	}
+}	//	ProduceAnc
+
+void NTV2SoftwareDevice::ProduceTimecode (const NTV2Channel inChannel)
+{
+	const SWSignalSource &	src	(mSources[inChannel]);
+	const CRP188			rp188	(ULWord(src.fLastVBI - src.fFirstVBI),
+									::SWTimecodeFormatForFrameRate(::GetNTV2FrameRateFromVideoFormat(src.fVideoFormat)));
+	NTV2_RP188	regs;
+	if (!rp188.GetRP188Reg(regs))
+		return;
+	NTV2WriteRegisterRemote (gChlToRP188DBBRegNum[inChannel], regs.fDBB, kRegMaskRP188DBB);
+	NTV2WriteRegisterRemote (gChlToRP188Bits031RegNum[inChannel], regs.fLo);
+	NTV2WriteRegisterRemote (gChlToRP188Bits3263RegNum[inChannel], regs.fHi);
+}	//	ProduceTimecode
+
+void NTV2SoftwareDevice::ProduceLoopback (const NTV2Channel inChannel)
+{
+	SWSignalSource &	src		(mSources[inChannel]);
+	const NTV2Channel	outCh	(src.fLoopChannel);
+
+	//	Capture this frame from the SDI output into the delay line...
+	SWLoopSlot &	inSlot	(src.fLoopSlots[src.fLoopFrames % kSWMaxLoopFrames]);
+	inSlot.fValid = true;
+	inSlot.fDropped = src.fLoopDropPct > 0.0  &&  src.NextRandom() * 100.0 < src.fLoopDropPct;
+	inSlot.fVideoBytes = inSlot.fAudioBytes = inSlot.fAncBytes[0] = inSlot.fAncBytes[1] = 0;
+	{	//	Video...
+		ULWord ctrlLo(0), ctrlHi(0), frameNum(0);
+		NTV2ReadRegisterRemote (gChannelToControlRegNum[outCh], ctrlLo, kRegMaskFrameFormat, kRegShiftFrameFormat);
+		NTV2ReadRegisterRemote (gChannelToControlRegNum[outCh], ctrlHi, kRegMaskFrameFormatHiBit, kRegShiftFrameFormatHiBit);
+		NTV2ReadRegisterRemote (gChannelToOutputFrameRegNum[outCh], frameNum);
+		const NTV2FormatDescriptor	fd (src.fVideoFormat, NTV2PixelFormat((ctrlLo & 0xF) | ((ctrlHi & 0x1) << 4)));
+		const ULWord				frameBytes (fd.IsValid() ? fd.GetTotalRasterBytes() : 0);
+		if (frameBytes  &&  frameBytes <= kSWFrameBytes  &&  ULWord64(frameNum) * kSWFrameBytes + frameBytes <= mFBMemory.GetByteCount())
+			if (inSlot.fVideo.GetByteCount() >= frameBytes  ||  inSlot.fVideo.Allocate(frameBytes))
+				if (inSlot.fVideo.CopyFrom(mFBMemory, frameNum * kSWFrameBytes, 0, frameBytes))
+					inSlot.fVideoBytes = frameBytes;
+	}
+	{	//	Audio -- the output "plays" one frame's worth of samples from its playout buffer per VBI...
+		const NTV2AudioSystem	audioSystem	(static_cast<NTV2AudioSystem>(outCh));
+		ULWord bufOffset(0), audCtrl(0);
+		if (GetAudioBufferOffset(audioSystem, bufOffset))
+		{
+			NTV2ReadRegisterRemote (gAudioSystemToAudioControlRegNum[audioSystem], audCtrl);
+			const NTV2AudioRate	audioRate	((audCtrl & kRegMaskAudioRate) ? NTV2_AUDIO_96K : NTV2_AUDIO_48K);
+			const ULWord		numSamples	(::GetAudioSamplesPerFrame(::GetNTV2FrameRateFromVideoFormat(src.fVideoFormat), audioRate, ULWord(src.fLoopFrames)));
+			inSlot.fAudioChannels = ::SWNumAudioChannels(audCtrl);
+			inSlot.fAudioBytes = numSamples * inSlot.fAudioChannels * sizeof(ULWord);
+			if (inSlot.fAudio.GetByteCount() < inSlot.fAudioBytes)
+				inSlot.fAudio.Allocate(inSlot.fAudioBytes);
+			inSlot.fAudio.Fill(ULWord(0));
+			if (audCtrl & (kRegMaskResetAudioOutput | kRegMaskPauseAudio))
+			{	//	Playout held in reset or paused -- silence
+				if (audCtrl & kRegMaskResetAudioOutput)
+					src.fAudioLastOut = 0;
+			}
+			else
+			{
+				const ULWord lastOut (src.fAudioLastOut % kSWAudioCaptureOffset);
+				const ULWord firstPart (std::min(inSlot.fAudioBytes, kSWAudioCaptureOffset - lastOut));
+				inSlot.fAudio.CopyFrom(mFBMemory, bufOffset + lastOut, 0, firstPart);
+				if (firstPart < inSlot.fAudioBytes)
+					inSlot.fAudio.CopyFrom(mFBMemory, bufOffset, firstPart, inSlot.fAudioBytes - firstPart);
+				src.fAudioLastOut = (lastOut + inSlot.fAudioBytes) % kSWAudioCaptureOffset;
+			}
+			NTV2WriteRegisterRemote (gChannelToAudioOutLastAddrRegNum[audioSystem], src.fAudioLastOut);
+		}
+	}
+	{	//	Anc -- whatever the inserter would send...
+		const ULWord insReg (sAncInsBaseRegNum[outCh]);
+		ULWord ctrl(0), fieldBytes(0), fieldBytesHi(0), fieldStart[2] = {0, 0};
+		NTV2ReadRegisterRemote (insReg + regAncInsControl, ctrl);
+		NTV2ReadRegisterRemote (insReg + regAncInsFieldBytes, fieldBytes);
+		NTV2ReadRegisterRemote (insReg + regAncInsFieldBytesHigh, fieldBytesHi);
+		NTV2ReadRegisterRemote (insReg + regAncInsField1StartAddr, fieldStart[0]);
+		NTV2ReadRegisterRemote (insReg + regAncInsField2StartAddr, fieldStart[1]);
+		const ULWord numBytes[2] = {	(fieldBytes & maskInsField1Bytes) | ((fieldBytesHi & maskInsField1Bytes) << 16),
+										(fieldBytes >> shiftInsField2Bytes) | ((fieldBytesHi >> shiftInsField2Bytes) << 16)	};
+		for (int field(0);  field < 2  &&  !(ctrl & maskInsDisableInserter);  field++)
+			if (numBytes[field]  &&  ULWord64(fieldStart[field]) + numBytes[field] <= mFBMemory.GetByteCount())
+				if (inSlot.fAnc[field].GetByteCount() >= numBytes[field]  ||  inSlot.fAnc[field].Allocate(numBytes[field]))
+					if (inSlot.fAnc[field].CopyFrom(mFBMemory, fieldStart[field], 0, numBytes[field]))
+						inSlot.fAncBytes[field] = numBytes[field];
+	}
+
+	//	Deliver the frame that's reached the end of the delay line to the SDI input...
+	const ULWord delay (src.fLoopDelay + (src.fLoopJitter ? ULWord(src.NextRandom() * double(src.fLoopJitter + 1)) : 0));
+	src.fLoopFrames++;
+	if (src.fLoopFrames <= delay)
+		return;	//	Nothing's come out the other end yet
+	const uint64_t	outFrame (src.fLoopFrames - 1 - delay);
+	const bool		late (outFrame < src.fLoopNextOut);	//	Jitter must never deliver a frame twice, or out of order
+	SWLoopSlot &	outSlot	(src.fLoopSlots[(late ? src.fLoopNextOut : outFrame) % kSWMaxLoopFrames]);
+	if (!outSlot.fValid)
+		return;
+	if (!late)
+		src.fLoopNextOut = outFrame + 1;	//	Any older frames still in the delay line were overtaken, and are lost
+	const bool	lost (late  ||  outSlot.fDropped);	//	Late or lost frame:  input frame & anc buffers keep stale data,
+													//	but the audio clock keeps running (silence)
+	ULWord frameNum(0);
+	NTV2ReadRegisterRemote (gChannelToInputFrameRegNum[inChannel], frameNum);
+	const ULWord64 dstOffset (ULWord64(frameNum) * kSWFrameBytes);
+	if (!lost  &&  outSlot.fVideoBytes  &&  dstOffset + outSlot.fVideoBytes <= mFBMemory.GetByteCount())
+	{
+		mFBMemory.CopyFrom(outSlot.fVideo, 0, ULWord(dstOffset), outSlot.fVideoBytes);
+		if (src.fLoopBER > 0.0)
+		{	//	Flip randomly-chosen bits...
+			src.fLoopBitErrors += src.fLoopBER * double(outSlot.fVideoBytes) * 8.0;
+			UByte * pFrame (reinterpret_cast<UByte*>(mFBMemory.GetHostAddress(ULWord(dstOffset))));
+			for ( ;  src.fLoopBitErrors >= 1.0;  src.fLoopBitErrors -= 1.0)
+			{
+				const ULWord bitNdx (ULWord(src.NextRandom() * double(outSlot.fVideoBytes) * 8.0));
+				pFrame[bitNdx / 8] ^= UByte(1 << (bitNdx % 8));
+			}
+		}
+	}
+
+	ULWord audCtrl(0);
+	NTV2ReadRegisterRemote (gAudioSystemToAudioControlRegNum[inChannel], audCtrl);
+	if (audCtrl & kRegMaskResetAudioInput)
+	{	//	Capture is held in reset -- rewind
+		src.fAudioLastIn = 0;
+		NTV2WriteRegisterRemote (gChannelToAudioInLastAddrRegNum[inChannel], 0);
+	}
+	else if (outSlot.fAudioBytes  &&  outSlot.fAudioChannels)
+	{	//	Remap to the capture channel count, if it differs from the output's...
+		const ULWord	inChannels	(::SWNumAudioChannels(audCtrl));
+		const ULWord	numSamples	(outSlot.fAudioBytes / (outSlot.fAudioChannels * sizeof(ULWord)));
+		if (!lost  &&  inChannels == outSlot.fAudioChannels)
+			WriteCaptureAudio(inChannel, outSlot.fAudio, outSlot.fAudioBytes);
+		else
+		{
+			NTV2Buffer		samples	(numSamples * inChannels * sizeof(ULWord));
+			const ULWord *	pSrc	(reinterpret_cast<const ULWord*>(outSlot.fAudio.GetHostPointer()));
+			ULWord *		pDst	(reinterpret_cast<ULWord*>(samples.GetHostPointer()));
+			for (ULWord smpl(0);  !lost  &&  pDst  &&  smpl < numSamples;  smpl++)
+				for (ULWord chan(0);  chan < inChannels  &&  chan < outSlot.fAudioChannels;  chan++)
+					pDst[smpl * inChannels + chan] = pSrc[smpl * outSlot.fAudioChannels + chan];
+			WriteCaptureAudio(inChannel, samples, samples.GetByteCount());
+		}
+	}
+	if (lost)
+		return;
+
+	const ULWord extReg (sAncExtBaseRegNum[inChannel]);
+	ULWord extCtrl(0), extStart[2] = {0, 0}, extEnd[2] = {0, 0};
+	NTV2ReadRegisterRemote (extReg + regAncExtControl, extCtrl);
+	if (extCtrl & maskDisableExtractor)
+		return;
+	NTV2ReadRegisterRemote (extReg + regAncExtField1StartAddress, extStart[0]);
+	NTV2ReadRegisterRemote (extReg + regAncExtField1EndAddress, extEnd[0]);
+	NTV2ReadRegisterRemote (extReg + regAncExtField2StartAddress, extStart[1]);
+	NTV2ReadRegisterRemote (extReg + regAncExtField2EndAddress, extEnd[1]);
+	for (int field(0);  field < 2;  field++)
+	{
+		ULWord numBytes(0);
+		if (extStart[field] < extEnd[field]  &&  ULWord64(extEnd[field]) < mFBMemory.GetByteCount())
+		{
+			numBytes = std::min(outSlot.fAncBytes[field], extEnd[field] - extStart[field]);
+			if (numBytes)
+				mFBMemory.CopyFrom(outSlot.fAnc[field], 0, extStart[field], numBytes);
+		}
+		NTV2WriteRegisterRemote (extReg + (field ? regAncExtField2Status : regAncExtField1Status), numBytes);
+	}
+}	//	ProduceLoopback
+
 void NTV2SoftwareDevice::InitRegs (void)
 {
 	NTV2WriteRegisterRemote (kRegGlobalControl, 0x30000202);  // Reg 0  // Frame Rate: 59.94, Frame Geometry: 1920x1080, Standard: 1080p, Reference Source: Reference In, Ch 2 link B 1080p 50/60: Off, LEDs ...., Register Clocking: Sync To Field, Ch 1 RP-188 output: Enabled, Ch 2 RP-188 output: Enabled, Color Correction: Channel: 1 Bank 0
@@ -1157,38 +2128,24 @@ bool NTV2SoftwareDevice::InitRegsFromSupportLog (const string & inLogFilePath)
 
 uint32_t NTV2SoftwareDevice::GetSDRAMDumpFileSize (const string & inFilePath)
 {
-	streampos result(0);
-	ifstream ifile(inFilePath.c_str(), std::ifstream::in | std::ifstream::binary | ios::ate);	//	Open read-only binary, positioned "ate" (at end)
-	if (ifile)
-		return uint32_t(ifile.tellg());
-	return 0;
+	return uint32_t(SDRAMDumpImage::ImageBytes(inFilePath));	//	Compact dumps report their uncompressed size
 }
 
 
-bool NTV2SoftwareDevice::InitSDRAMFromFile (const string & inFilePath)
+bool NTV2SoftwareDevice::InitSDRAMFromFile (const string & inFilePath, const bool inLazy)
 {
-	streampos dumpFileSizeInBytes(0), bytesToRead(0);
-	ifstream ifile(inFilePath.c_str(), std::ifstream::in | std::ifstream::binary | ios::ate);	//	Open read-only binary, positioned "ate" (at end)
-	if (!ifile)
-		{NBFAIL("Unable to open SDRAM dump file '" << inFilePath << "' for reading");  return false;}
-	dumpFileSizeInBytes = ifile.tellg();
-	ifile.seekg(0, ios::beg);	//	Rewind to start
-	if (dumpFileSizeInBytes > streampos(mFBMemory.GetByteCount()))
-	{	NBWARN("SDRAM file size " << DEC(dumpFileSizeInBytes) << " (" << DEC(dumpFileSizeInBytes/1024/1024)
-				<< "MB) is larger than device SDRAM size " << DEC(mFBMemory.GetByteCount()) << " (" << DEC(mFBMemory.GetByteCount()/1024/1024) << "MB)");
-		bytesToRead = streampos(mFBMemory.GetByteCount());
-	}
-	else if (dumpFileSizeInBytes < streampos(mFBMemory.GetByteCount()))
-	{	NBWARN("SDRAM file size " << DEC(dumpFileSizeInBytes) << " (" << DEC(dumpFileSizeInBytes/1024/1024)
-				<< "MB) is smaller than device SDRAM size " << DEC(mFBMemory.GetByteCount()) << " (" << DEC(mFBMemory.GetByteCount()/1024/1024) << "MB)");
-		bytesToRead = dumpFileSizeInBytes;
+	if (!sSDRAMImage.Open(inFilePath, mFBMemory))
+		return false;
+	const bool isCompact (sSDRAMImage.IsCompact());
+	const size_t numChunks (sSDRAMImage.NumChunks());
+	if (inLazy)
+	{	//	Private memory -- load each chunk upon first DMA
+		NBINFO(DEC(numChunks) << (isCompact ? " frame(s)" : " chunk(s)") << " of device SDRAM mapped from '" << inFilePath << "', to be loaded on demand");
+		return true;
 	}
-	else
-		bytesToRead = dumpFileSizeInBytes;
-
-	if (!ifile.read(mFBMemory, streamsize(bytesToRead)).good())
-		{NBFAIL("Failed reading " << DEC(bytesToRead) << "  bytes");  return false;}
-
-	NBINFO(DEC(bytesToRead) << " bytes successfully read into device SDRAM from '" << inFilePath << "'");
+	//	Shared memory -- other processes can't fault chunks in, so load everything now
+	if (!sSDRAMImage.LoadAll(mFBMemory))
+		{NBFAIL("Failed loading device SDRAM from '" << inFilePath << "'");  sSDRAMImage.Close();  return false;}
+	NBINFO(DEC(numChunks) << (isCompact ? " frame(s)" : " chunk(s)") << " successfully loaded into device SDRAM from '" << inFilePath << "'");
 	return true;
 }
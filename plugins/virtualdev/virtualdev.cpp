@@ -113,6 +113,32 @@ typedef AudSysMap::const_iterator				AudSysMapCIter;
 typedef map<ULWord, ULWord>						DATMap;
 typedef DATMap::const_iterator					DATMapCIter;
 
+typedef enum
+{
+	VDevReg_PassThru,		//	Same register on the underlying card
+	VDevReg_Remap,			//	Different register on the underlying card (same mask & shift)
+	VDevReg_XptSelect,		//	Crosspoint select register -- each input xpt field needs translating
+	VDevReg_Special			//	Needs custom handling in NTV2ReadRegisterRemote/NTV2WriteRegisterRemote
+} VDevRegKind;
+
+typedef struct VDevRegXlate
+{
+	VDevRegKind	fKind;
+	ULWord		fValue;		//	VDevReg_Remap: card register number;  VDevReg_XptSelect: index of first XptSelectXlate
+	ULWord		fCount;		//	VDevReg_XptSelect: number of XptSelectXlates
+	VDevRegXlate (const VDevRegKind inKind = VDevReg_PassThru, const ULWord inValue = 0, const ULWord inCount = 0)
+		:	fKind(inKind), fValue(inValue), fCount(inCount)		{}
+} VDevRegXlate;
+typedef vector<VDevRegXlate>					VDevRegXlates;		//	Indexed by VDev register number
+
+typedef struct XptSelectXlate
+{
+	RegInfo		fVDev;		//	VDev xpt select register field
+	RegInfo		fCard;		//	Equivalent card xpt select register field (invalid if none)
+} XptSelectXlate;
+typedef vector<XptSelectXlate>					XptSelectXlates;
+typedef vector<NTV2OutputXptID>					OutXptTable;		//	Indexed by NTV2OutputXptID
+
 /*****************************************************************************************************************************************************
 	NTV2Virtual Device
 
@@ -180,6 +206,10 @@ class NTV2VirtualDev : public NTV2RPCAPI
 		virtual bool				SetupInputXptMapping		(void);
 		virtual bool				SetupOutputXptMapping		(void);
 		virtual bool				SetupXptSelectRegMapping	(void);
+		virtual bool				SetupRegisterXlation		(void);
+		inline const VDevRegXlate &	ReadXlate (const ULWord regNum) const	{return regNum < mReadXlates.size() ? mReadXlates[regNum] : sPassThru;}
+		inline const VDevRegXlate &	WriteXlate (const ULWord regNum) const	{return regNum < mWriteXlates.size() ? mWriteXlates[regNum] : sPassThru;}
+		virtual bool				HandleGetRegisters			(NTV2GetRegisters & inOutGetRegs);
 		virtual NTV2Channel			VDevToCardChannel (const NTV2Channel ch) const;
 		virtual NTV2Channel			CardToVDevChannel (const NTV2Channel ch) const;
 		virtual NTV2Channel			VDevToCardMixer (const NTV2Channel ch) const;
@@ -198,16 +228,8 @@ class NTV2VirtualDev : public NTV2RPCAPI
 		virtual bool				DATKonaToCardFrmOffset (ULWord & inOutFrameNum, ULWord & inOutCardOffset) const;
 		virtual bool				DATKonaToCard (ULWord & byteAddr, ULWord & byteCount) const;
 		virtual bool				DATCardToKonaFrmOffset (ULWord & inOutFrameNum, ULWord & inOutCardOffset) const;
-		virtual bool				isMyAncInsRegister	(const ULWord regNum) const;
-		virtual bool				isMyAncExtRegister	(const ULWord regNum) const;
-		virtual bool				isMyXptSelectRegister(const ULWord regNum) const
-									{return mVDevXptRegInfos.find(regNum) != mVDevXptRegInfos.end();}
 		virtual	bool				HandleReadXptSelectReg	(const ULWord regNum, ULWord & outRegValue, const ULWord regMask = 0xFFFFFFFF, const ULWord regShift = 0);
 		virtual	bool				HandleWriteXptSelectReg	(const ULWord regNum, const ULWord regValue, const ULWord regMask = 0xFFFFFFFF, const ULWord regShift = 0);
-		virtual	bool				HandleReadAncIns	(const ULWord regNum, ULWord & outRegValue, const ULWord regMask = 0xFFFFFFFF, const ULWord regShift = 0);
-		virtual	bool				HandleReadAncExt	(const ULWord regNum, ULWord & outRegValue, const ULWord regMask = 0xFFFFFFFF, const ULWord regShift = 0);
-		virtual	bool				HandleWriteAncIns	(const ULWord regNum, const ULWord inRegValue, const ULWord regMask = 0xFFFFFFFF, const ULWord regShift = 0);
-		virtual	bool				HandleWriteAncExt	(const ULWord regNum, const ULWord inRegValue, const ULWord regMask = 0xFFFFFFFF, const ULWord regShift = 0);
 		virtual bool				HandleReadGlobalControl (const ULWord regNum, ULWord & outValue, const ULWord mask = 0xFFFFFFFF, const ULWord shift = 0);
 		virtual bool				HandleReadChannelControl (const ULWord regNum, ULWord & outValue, const ULWord mask = 0xFFFFFFFF, const ULWord shift = 0);
 		virtual bool				HandleWriteSDITransmitControl (const ULWord regNum, const ULWord inRegValue, const ULWord regMask = 0xFFFFFFFF, const ULWord regShift = 0);
@@ -253,9 +275,17 @@ class NTV2VirtualDev : public NTV2RPCAPI
 		AudSysMap			mKonaToCardAudSys;	///< @brief	NTV2AudioSystem VDev-to-card mapping
 		DATMap				mCardToKonaDAT;		///< @brief	DAT card-to-VDev mapping
 		DATMap				mKonaToCardDAT;		///< @brief	DAT VDev-to-card mapping
+		VDevRegXlates		mReadXlates;		///< @brief	Register read translations, indexed by VDev register number
+		VDevRegXlates		mWriteXlates;		///< @brief	Register write translations, indexed by VDev register number
+		XptSelectXlates		mXptSelectXlates;	///< @brief	VDev-to-card xpt select register fields
+		OutXptTable			mVDevToCardOXptTbl;	///< @brief	Output crosspoint VDev-to-card table
+		OutXptTable			mCardToVDevOXptTbl;	///< @brief	Output crosspoint card-to-VDev table
+		static const VDevRegXlate	sPassThru;	///< @brief	Translation for registers not in the tables
 
 };	//	NTV2VirtualDev
 
+const VDevRegXlate NTV2VirtualDev::sPassThru;
+
 extern "C"
 {
 	EXPORT NTV2RPCClientAPI * CreateClient (void * pInDLLHandle, const NTV2ConnectParams & inParams, const uint32_t inCallerSDKVers);
@@ -543,6 +573,17 @@ bool NTV2VirtualDev::NTV2Connect (void)
 	if (!skippedParams.empty())
 		NBWARN("Skipped unrecognized parameter(s): " << skippedParams);
 
+#if defined(AJAMac) || defined(AJALinux)
+	//	If the underlying device is itself a plugin, it's next to me -- my copy of the SDK doesn't know where the host found me...
+	Dl_info dlInfo;
+	if (NTV2RPCClientAPI::GetPluginsFolder().empty()  &&  ::dladdr(reinterpret_cast<void*>(&CreateClient), &dlInfo)  &&  dlInfo.dli_fname)
+	{
+		const string myPath(dlInfo.dli_fname);
+		if (myPath.rfind('/') != string::npos)
+			NTV2RPCClientAPI::SetPluginsFolder(myPath.substr(0, myPath.rfind('/') + 1));
+	}
+#endif	//	AJAMac or AJALinux
+
 	//	Open the devSpec...
 	if (!CNTV2DeviceScanner::GetFirstDeviceFromArgument(mDevSN, mCard))
 		{NBFAIL("No underlying device '" << mDevSN << "'");  return false;}
@@ -697,7 +738,7 @@ bool NTV2VirtualDev::SetupMapping (void)
 			cerr << "Card AudSys" << DEC(cardAudSys+1) << " " << xHEX0N(cardByteOffset,8)
 				<< " => VDev AudSys" << DEC(konaAudSys+1) << " " << xHEX0N(konaByteOffset,8) << endl;
 	}
-	return true;
+	return SetupRegisterXlation();
 }
 
 bool NTV2VirtualDev::SetupWidgetMapping (void)
@@ -967,14 +1008,12 @@ NTV2InputXptID NTV2VirtualDev::CardToVDevInputXpt (const NTV2InputXptID inCardIn
 
 NTV2OutputXptID NTV2VirtualDev::VDevToCardOutputXpt (const NTV2OutputXptID xpt) const
 {	//	Map VDev output xpt to mCard's output xpt
-	OutXptMapCIter it(mVDevToCardOXpts.find(xpt));
-	return it != mVDevToCardOXpts.end() ? it->second : NTV2_XptBlack;
+	return ULWord(xpt) < mVDevToCardOXptTbl.size() ? mVDevToCardOXptTbl[xpt] : NTV2_XptBlack;
 }
 
 NTV2OutputXptID NTV2VirtualDev::CardToVDevOutputXpt (const NTV2OutputXptID cardXpt) const
 {	//	Unmap mCard's output xpt to VDev output xpt
-	OutXptMapCIter it(mCardToVDevOXpts.find(cardXpt));
-	return it != mCardToVDevOXpts.end() ? it->second : NTV2_XptBlack;
+	return ULWord(cardXpt) < mCardToVDevOXptTbl.size() ? mCardToVDevOXptTbl[cardXpt] : NTV2_XptBlack;
 }
 
 static const INTERRUPT_ENUMS Einputs[] = {eInput1, eInput2, eInput3, eInput4, eInput5, eInput6, eInput7, eInput8};
@@ -1059,31 +1098,145 @@ bool NTV2VirtualDev::DATCardToKonaFrmOffset (ULWord & inOutFrameNum, ULWord & in
 	return true;
 }
 
+static const ULWord AncInsRegOffsetPerChannel (sAncInsBaseRegNum[1] - sAncInsBaseRegNum[0]);
+static const ULWord AncExtRegOffsetPerChannel (sAncExtBaseRegNum[1] - sAncExtBaseRegNum[0]);
+
+static void SetXlate (VDevRegXlates & inOutXlates, const ULWord inRegNum, const VDevRegXlate & inXlate)
+{
+	if (inRegNum >= inOutXlates.size())
+		inOutXlates.resize(inRegNum + 1);
+	inOutXlates[inRegNum] = inXlate;
+}
+
+//	Once the widget/xpt/channel/audio system mappings are known, everything that NTV2ReadRegisterRemote and
+//	NTV2WriteRegisterRemote need to translate a VDev register is fixed, so compile it into flat tables indexed
+//	by register number. A register access then costs one table lookup instead of a chain of range checks,
+//	multimap & map lookups, and a big switch.
+bool NTV2VirtualDev::SetupRegisterXlation (void)
+{
+	mReadXlates.clear();  mWriteXlates.clear();  mXptSelectXlates.clear();
+	const NTV2AudioSystem	aud1(KonaToCardAudSys(NTV2_AUDIOSYSTEM_1)), aud2(KonaToCardAudSys(NTV2_AUDIOSYSTEM_2));
+	const NTV2Channel		mxr1(VDevToCardMixer(NTV2_CHANNEL1));
+
+	//	Registers that are simply renumbered, for both reads & writes...
+	const ULWord remaps[][2] = {	{kRegAud1Control,			gAudioSystemToAudioControlRegNum[aud1]},
+									{kRegAud1SourceSelect,		gAudioSystemToSrcSelectRegNum[aud1]},
+									{kRegAud1OutputLastAddr,	gChannelToAudioOutLastAddrRegNum[aud1]},
+									{kRegAud1InputLastAddr,		gChannelToAudioInLastAddrRegNum[aud1]},
+									{kRegAud1Delay,				gAudioDelayRegisterNumbers[aud1]},
+									{kRegAud2Control,			gAudioSystemToAudioControlRegNum[aud2]},
+									{kRegAud2SourceSelect,		gAudioSystemToSrcSelectRegNum[aud2]},
+									{kRegAud2OutputLastAddr,	gChannelToAudioOutLastAddrRegNum[aud2]},
+									{kRegAud2InputLastAddr,		gChannelToAudioInLastAddrRegNum[aud2]},
+									{kRegAud2Delay,				gAudioDelayRegisterNumbers[aud2]},
+									{kRegVidProc1Control,		gIndexToVidProcControlRegNum[mxr1]},
+									{kRegMixer1Coefficient,		gIndexToVidProcMixCoeffRegNum[mxr1]},
+									{kRegFlatMatteValue,		gIndexToVidProcFlatMatteRegNum[mxr1]}	};
+	for (size_t ndx(0);  ndx < sizeof(remaps) / sizeof(remaps[0]);  ndx++)
+	{
+		SetXlate (mReadXlates, remaps[ndx][0], VDevRegXlate(VDevReg_Remap, remaps[ndx][1]));
+		SetXlate (mWriteXlates, remaps[ndx][0], VDevRegXlate(VDevReg_Remap, remaps[ndx][1]));
+	}
+
+	//	Registers that are renumbered for reads only...
+	const ULWord readRemaps[][2] = {	{kRegAud1Detect,			sAudioDetectRegs[aud1]},
+										{kRegAudDetect2,			sAudioDetectRegs[aud2]},
+										{kRegCh1OutputFrame,		gChannelToOutputFrameRegNum[mChannel]},
+										{kRegCh2OutputFrame,		gChannelToOutputFrameRegNum[mChannel+1]},
+										{kRegCh1InputFrame,			gChannelToInputFrameRegNum[mChannel]},
+										{kRegCh2InputFrame,			gChannelToInputFrameRegNum[mChannel+1]},
+#if !defined(NTV2_DEPRECATE_16_2)
+										{kRegCh1PCIAccessFrame,		gChannelToPCIAccessFrameRegNum[mChannel]},
+										{kRegCh2PCIAccessFrame,		gChannelToPCIAccessFrameRegNum[mChannel+1]},
+#endif	//	NTV2_DEPRECATE_16_2
+										{kRegOutputTimingControl,	gChannelToOutputTimingCtrlRegNum[mChannel+1]},
+										{kRegRXSDI1Status,			gChannelToRXSDIStatusRegs[mChannel]},
+										{kRegRXSDI2Status,			gChannelToRXSDIStatusRegs[mChannel+1]},
+										{kRegRXSDI1CRCErrorCount,	gChannelToRXSDICRCErrorCountRegs[mChannel]},
+										{kRegSDIIn1VPIDA,			gChannelToSDIInVPIDARegNum[mChannel]},
+										{kRegSDIIn1VPIDB,			gChannelToSDIInVPIDBRegNum[mChannel]}	};
+	for (size_t ndx(0);  ndx < sizeof(readRemaps) / sizeof(readRemaps[0]);  ndx++)
+		SetXlate (mReadXlates, readRemaps[ndx][0], VDevRegXlate(VDevReg_Remap, readRemaps[ndx][1]));
+
+	//	Registers that are renumbered for writes only...
+	SetXlate (mWriteXlates, kRegCh1Control, VDevRegXlate(VDevReg_Remap, gChannelToControlRegNum[mChannel]));
+	SetXlate (mWriteXlates, kRegCh2Control, VDevRegXlate(VDevReg_Remap, gChannelToControlRegNum[mChannel+1]));
+
+	//	Registers that need custom handling...
+	const ULWord readSpecials[] = {	kRegBoardID, kRegPCMControl4321, kRegGlobalControl, kRegGlobalControl2, kRegCh1Control, kRegCh2Control,
+									kRegSDITransmitControl, kRegSDIOut1Control, kRegInputStatus, kRegSDIInput3GStatus	};
+	for (size_t ndx(0);  ndx < sizeof(readSpecials) / sizeof(readSpecials[0]);  ndx++)
+		SetXlate (mReadXlates, readSpecials[ndx], VDevRegXlate(VDevReg_Special));
+	const ULWord writeSpecials[] = {kRegPCMControl4321, kRegSDITransmitControl, kRegSDIOut1Control};
+	for (size_t ndx(0);  ndx < sizeof(writeSpecials) / sizeof(writeSpecials[0]);  ndx++)
+		SetXlate (mWriteXlates, writeSpecials[ndx], VDevRegXlate(VDevReg_Special));
+
+	//	Xpt select registers, with each VDev input xpt field resolved to its card xpt select register field...
+	for (XptRegMMapCIter it(mVDevXptRegInfos.begin());  it != mVDevXptRegInfos.end();  )
+	{
+		const ULWord regNum(it->first), firstNdx(ULWord(mXptSelectXlates.size()));
+		for (;  it != mVDevXptRegInfos.end()  &&  it->first == regNum;  ++it)
+		{
+			XptSelectXlate xlate;
+			xlate.fVDev = it->second;
+			const NTV2InputXptID cardInpXpt (VDevToCardInputXpt(it->second.inputXpt()));
+			if (!GetInputXptRegInfo (cardInpXpt, xlate.fCard))
+				xlate.fCard.makeInvalid();
+			mXptSelectXlates.push_back(xlate);
+		}
+		const VDevRegXlate xptXlate (VDevReg_XptSelect, firstNdx, ULWord(mXptSelectXlates.size()) - firstNdx);
+		SetXlate (mReadXlates, regNum, xptXlate);
+		SetXlate (mWriteXlates, regNum, xptXlate);
+	}
+
+	//	Anc inserter/extractor registers map to the target channel's (these take precedence)...
+	for (ULWord regNum(sAncExtBaseRegNum[0]);  regNum < sAncExtBaseRegNum[0] + sAncExtNumRegs;  regNum++)
+	{
+		SetXlate (mReadXlates, regNum, VDevRegXlate(VDevReg_Remap, regNum + ULWord(mChannel) * AncExtRegOffsetPerChannel));
+		SetXlate (mWriteXlates, regNum, VDevRegXlate(VDevReg_Remap, regNum + ULWord(mChannel) * AncExtRegOffsetPerChannel));
+	}
+	for (ULWord regNum(sAncInsBaseRegNum[0]);  regNum < sAncInsBaseRegNum[0] + sAncInsNumRegs;  regNum++)
+	{
+		SetXlate (mReadXlates, regNum, VDevRegXlate(VDevReg_Remap, regNum + ULWord(mChannel+1) * AncInsRegOffsetPerChannel));
+		SetXlate (mWriteXlates, regNum, VDevRegXlate(VDevReg_Remap, regNum + ULWord(mChannel+1) * AncInsRegOffsetPerChannel));
+	}
+
+	//	Output xpt tables (xpt select register fields are 8 bits wide)...
+	mVDevToCardOXptTbl.assign(256, NTV2_XptBlack);
+	mCardToVDevOXptTbl.assign(256, NTV2_XptBlack);
+	for (OutXptMapCIter it(mVDevToCardOXpts.begin());  it != mVDevToCardOXpts.end();  ++it)
+		if (ULWord(it->first) < mVDevToCardOXptTbl.size())
+			mVDevToCardOXptTbl[it->first] = it->second;
+	for (OutXptMapCIter it(mCardToVDevOXpts.begin());  it != mCardToVDevOXpts.end();  ++it)
+		if (ULWord(it->first) < mCardToVDevOXptTbl.size())
+			mCardToVDevOXptTbl[it->first] = it->second;
+
+	NBINFO(DEC(mReadXlates.size()) << " read & " << DEC(mWriteXlates.size()) << " write register translations, "
+			<< DEC(mXptSelectXlates.size()) << " xpt select fields");
+	return true;
+}	//	SetupRegisterXlation
+
 bool NTV2VirtualDev::HandleReadXptSelectReg (const ULWord inRegNum, ULWord & outVal, const ULWord inMask, const ULWord inShift)
 {
-	XptRegMMapCIter pVDevXptRegInfo (mVDevXptRegInfos.find(inRegNum));
-	if (pVDevXptRegInfo == mVDevXptRegInfos.end())
+	const VDevRegXlate & regXlate (ReadXlate(inRegNum));
+	if (regXlate.fKind != VDevReg_XptSelect)
 		return mCard.ReadRegister(inRegNum, outVal, inMask, inShift);
-	while (pVDevXptRegInfo->first == inRegNum)
+	for (ULWord ndx(regXlate.fValue);  ndx < regXlate.fValue + regXlate.fCount;  ndx++)
 	{
-		const RegInfo & konaXptRegInfo (pVDevXptRegInfo->second);
-		if ((konaXptRegInfo.mask() & inMask) != konaXptRegInfo.mask())
-			{++pVDevXptRegInfo;  continue;}	//	skip -- caller isn't interested in this input xpt
-		const NTV2InputXptID cardInpXpt (VDevToCardInputXpt (konaXptRegInfo.inputXpt()));
-		ULWord cardRegNum(0), nibbleNdx(0);
-		if (!CNTV2RegisterExpert::GetCrosspointSelectGroupRegisterInfo (cardInpXpt, cardRegNum, nibbleNdx))
+		const XptSelectXlate & xlate (mXptSelectXlates[ndx]);
+		if ((xlate.fVDev.mask() & inMask) != xlate.fVDev.mask())
+			continue;	//	skip -- caller isn't interested in this input xpt
+		if (!xlate.fCard.isValid())
 			return false;
 		//	Read the card xpt select register, and get the output xpt value for the equivalent card input xpt...
-		const RegInfo cardXptRegInfo (cardRegNum, nibbleNdx, cardInpXpt);
 		ULWord cardOxpt(0);
-		if (!ReadCardRegister (cardXptRegInfo, cardOxpt))
+		if (!ReadCardRegister (xlate.fCard, cardOxpt))
 			return false;
 		//	Translate the card outputXpt to the equivalent VDev outputXpt...
 		const NTV2OutputXptID konaOutXpt (CardToVDevOutputXpt(NTV2OutputXptID(cardOxpt)));
 		//	Update the VDev's xpt select register value...
-		outVal = (outVal & konaXptRegInfo.invMask())	//	Keep everything intact except konaXptRegInfo.mask()
-					| ULWord(konaOutXpt << konaXptRegInfo.shift());	//	and OR-in the konaOutXpt value
-		++pVDevXptRegInfo;
+		outVal = (outVal & xlate.fVDev.invMask())	//	Keep everything intact except fVDev.mask()
+					| ULWord(konaOutXpt << xlate.fVDev.shift());	//	and OR-in the konaOutXpt value
 	}	//	for each VDev input xpt represented in this register
 	if (inShift  &&  inShift < 31)
 		outVal >>= inShift;	//	Perform shift requested by caller
@@ -1092,89 +1245,29 @@ bool NTV2VirtualDev::HandleReadXptSelectReg (const ULWord inRegNum, ULWord & out
 
 bool NTV2VirtualDev::HandleWriteXptSelectReg (const ULWord inRegNum, const ULWord inVal, const ULWord inMask, const ULWord inShift)
 {
-	XptRegMMapCIter pVDevXptRegInfo (mVDevXptRegInfos.find(inRegNum));
-	if (pVDevXptRegInfo == mVDevXptRegInfos.end())
+	const VDevRegXlate & regXlate (WriteXlate(inRegNum));
+	if (regXlate.fKind != VDevReg_XptSelect)
 		return mCard.WriteRegister(inRegNum, inVal, inMask, inShift);	//	Not my register
 
 	NBDBG(CNTV2RegisterExpert::GetDisplayName(inRegNum) << " (" << DEC(inRegNum) << ") val=" << xHEX0N(inVal,8) << "(" << DEC(inVal) << ") msk=" << xHEX0N(inMask,8) << " sh=" << DEC(inShift));
-	while (pVDevXptRegInfo->first == inRegNum)
+	for (ULWord ndx(regXlate.fValue);  ndx < regXlate.fValue + regXlate.fCount;  ndx++)
 	{
-		const RegInfo & konaXptRegInfo (pVDevXptRegInfo->second);
-		NBDBG("VDev " << konaXptRegInfo);
-		if ((konaXptRegInfo.mask() & inMask) != konaXptRegInfo.mask())
-			{++pVDevXptRegInfo;  continue;}	//	skip -- caller isn't interested in this input xpt
-		const NTV2OutputXptID konaOxpt (NTV2OutputXptID(inVal+0));
-		//	Translate the VDev outputXpt to the equivalent card outputXpt...
-		const NTV2OutputXptID cardOutXpt (VDevToCardOutputXpt(konaOxpt));
-		const NTV2InputXptID cardInpXpt (VDevToCardInputXpt (konaXptRegInfo.inputXpt()));
-		ULWord cardRegNum(0), nibbleNdx(0);
-		if (!CNTV2RegisterExpert::GetCrosspointSelectGroupRegisterInfo (cardInpXpt, cardRegNum, nibbleNdx))
+		const XptSelectXlate & xlate (mXptSelectXlates[ndx]);
+		NBDBG("VDev " << xlate.fVDev);
+		if ((xlate.fVDev.mask() & inMask) != xlate.fVDev.mask())
+			continue;	//	skip -- caller isn't interested in this input xpt
+		if (!xlate.fCard.isValid())
 			return false;
+		//	Translate the VDev outputXpt to the equivalent card outputXpt...
+		const NTV2OutputXptID cardOutXpt (VDevToCardOutputXpt(NTV2OutputXptID(inVal+0)));
 		//	Write the the cardOutXpt value into the card xpt select register...
-		const RegInfo cardXptRegInfo (cardRegNum, nibbleNdx, cardInpXpt);
-		NBDBG("'" << mCard.GetDisplayName() << "' " << cardXptRegInfo);
-		if (!WriteCardRegister (cardXptRegInfo, cardOutXpt))
+		NBDBG("'" << mCard.GetDisplayName() << "' " << xlate.fCard);
+		if (!WriteCardRegister (xlate.fCard, cardOutXpt))
 			return false;
-		++pVDevXptRegInfo;
 	}	//	for each VDev input xpt represented in this register
 	return true;
 }	//	HandleWriteXptSelectReg
 
-static const ULWord AncInsRegOffsetPerChannel (sAncInsBaseRegNum[1] - sAncInsBaseRegNum[0]);
-static const ULWord AncExtRegOffsetPerChannel (sAncExtBaseRegNum[1] - sAncExtBaseRegNum[0]);
-
-bool NTV2VirtualDev::HandleReadAncIns (const ULWord regNum, ULWord & outRegValue, const ULWord regMask, const ULWord regShift)
-{
-	ULWord newRegNum(0);
-	if (regNum >= sAncInsBaseRegNum[0] && regNum < sAncInsBaseRegNum[0]+sAncInsNumRegs)
-		newRegNum = regNum + ULWord(mChannel+1) * AncInsRegOffsetPerChannel;	//	Map to anc ins 0 reg on target
-	if (newRegNum)
-		return mCard.ReadRegister (newRegNum, outRegValue, regMask, regShift);
-	outRegValue = 0;	//	Otherwise return zero value and ignore
-	return true;
-}
-
-bool NTV2VirtualDev::HandleWriteAncIns (const ULWord regNum, const ULWord inRegValue, const ULWord regMask, const ULWord regShift)
-{
-	ULWord newRegNum(0);
-	if (regNum >= sAncInsBaseRegNum[0] && regNum < sAncInsBaseRegNum[0]+sAncInsNumRegs)
-		newRegNum = regNum + ULWord(mChannel+1) * AncInsRegOffsetPerChannel;	//	Map to anc ins 0 reg on target
-	if (newRegNum)
-		return mCard.WriteRegister (newRegNum, inRegValue, regMask, regShift);
-	return true;	//	Otherwise ignore
-}
-
-bool NTV2VirtualDev::HandleReadAncExt (const ULWord regNum, ULWord & outRegValue, const ULWord regMask, const ULWord regShift)
-{
-	ULWord newRegNum(0);
-	if (regNum >= sAncExtBaseRegNum[0] && regNum < sAncExtBaseRegNum[0]+sAncExtNumRegs)
-		newRegNum = regNum + ULWord(mChannel) * AncExtRegOffsetPerChannel;		//	Map to anc ext 0 reg on target
-	if (newRegNum)
-		return mCard.ReadRegister (newRegNum, outRegValue, regMask, regShift);
-	outRegValue = 0;	//	Otherwise return zero value and ignore
-	return true;
-}
-
-bool NTV2VirtualDev::HandleWriteAncExt (const ULWord regNum, const ULWord inRegValue, const ULWord regMask, const ULWord regShift)
-{
-	ULWord newRegNum(0);
-	if (regNum >= sAncExtBaseRegNum[0] && regNum < sAncExtBaseRegNum[0]+sAncExtNumRegs)
-		newRegNum = regNum + ULWord(mChannel) * AncExtRegOffsetPerChannel;		//	Map to anc ext 0 reg on target
-	if (newRegNum)
-		return mCard.WriteRegister (newRegNum, inRegValue, regMask, regShift);
-	return true;	//	otherwise ignore
-}
-
-bool NTV2VirtualDev::isMyAncInsRegister	(const ULWord regNum) const
-{
-	return regNum >= sAncInsBaseRegNum[0]  &&  regNum < (sAncInsBaseRegNum[0] + sAncInsNumRegs);
-}
-
-bool NTV2VirtualDev::isMyAncExtRegister (const ULWord regNum) const
-{
-	return regNum >= sAncExtBaseRegNum[0] && regNum < (sAncExtBaseRegNum[0] + sAncExtNumRegs);
-}
-
 bool NTV2VirtualDev::HandleReadGlobalControl (const ULWord regNum, ULWord & outValue, const ULWord mask, const ULWord shift)
 {
 	if (!mCard.ReadRegister(regNum, outValue))	//	Read underlying card global ctrl register, no mask, no shift (yet)
@@ -1326,12 +1419,14 @@ static const ULWord kRegMaskPCMCtrlA2(kRegMaskPCMControlA2P1_2|kRegMaskPCMContro
 bool NTV2VirtualDev::NTV2ReadRegisterRemote (const ULWord inRegNum, ULWord & outValue, const ULWord inRegMask, const ULWord inRegShift)
 {	//	Translate VDev register reads into underlying device's register reads...
 	ULWord regNum(inRegNum), regMask(inRegMask), regShift(inRegShift);
-	if (isMyAncExtRegister(regNum))
-		return HandleReadAncExt (regNum, outValue, regMask, regShift);	//	Handle my anc ext regs
-	if (isMyAncInsRegister(regNum))
-		return HandleReadAncIns (regNum, outValue, regMask, regShift);	//	Handle my anc ins regs
-	if (isMyXptSelectRegister(regNum))
-		return HandleReadXptSelectReg (inRegNum, outValue, inRegMask, inRegShift);	//	Handle my routing regs
+	const VDevRegXlate & xlate (ReadXlate(inRegNum));
+	switch (xlate.fKind)
+	{
+		case VDevReg_PassThru:	return mCard.ReadRegister(inRegNum, outValue, inRegMask, inRegShift);
+		case VDevReg_Remap:		return mCard.ReadRegister(xlate.fValue, outValue, inRegMask, inRegShift);
+		case VDevReg_XptSelect:	return HandleReadXptSelectReg (inRegNum, outValue, inRegMask, inRegShift);	//	Handle my routing regs
+		case VDevReg_Special:	break;
+	}
 	switch (regNum)
 	{
 		case kRegBoardID:
@@ -1340,19 +1435,6 @@ bool NTV2VirtualDev::NTV2ReadRegisterRemote (const ULWord inRegNum, ULWord & out
 				outValue >>= inRegShift;
 			return true;
 
-		case kRegAud1Control:			regNum = gAudioSystemToAudioControlRegNum[KonaToCardAudSys(NTV2_AUDIOSYSTEM_1)];	break;
-		case kRegAud1SourceSelect:		regNum = gAudioSystemToSrcSelectRegNum[KonaToCardAudSys(NTV2_AUDIOSYSTEM_1)];		break;
-		case kRegAud1OutputLastAddr:	regNum = gChannelToAudioOutLastAddrRegNum[KonaToCardAudSys(NTV2_AUDIOSYSTEM_1)];	break;
-		case kRegAud1InputLastAddr:		regNum = gChannelToAudioInLastAddrRegNum[KonaToCardAudSys(NTV2_AUDIOSYSTEM_1)];		break;
-		case kRegAud1Delay:				regNum = gAudioDelayRegisterNumbers[KonaToCardAudSys(NTV2_AUDIOSYSTEM_1)];			break;
-		case kRegAud1Detect:			regNum = sAudioDetectRegs[KonaToCardAudSys(NTV2_AUDIOSYSTEM_1)];					break;
-		case kRegAud2Control:			regNum = gAudioSystemToAudioControlRegNum[KonaToCardAudSys(NTV2_AUDIOSYSTEM_2)];	break;
-		case kRegAud2SourceSelect:		regNum = gAudioSystemToSrcSelectRegNum[KonaToCardAudSys(NTV2_AUDIOSYSTEM_2)];		break;
-		case kRegAud2OutputLastAddr:	regNum = gChannelToAudioOutLastAddrRegNum[KonaToCardAudSys(NTV2_AUDIOSYSTEM_2)];	break;
-		case kRegAud2InputLastAddr:		regNum = gChannelToAudioInLastAddrRegNum[KonaToCardAudSys(NTV2_AUDIOSYSTEM_2)];		break;
-		case kRegAud2Delay:				regNum = gAudioDelayRegisterNumbers[KonaToCardAudSys(NTV2_AUDIOSYSTEM_2)];			break;
-		case kRegAudDetect2:			regNum = sAudioDetectRegs[KonaToCardAudSys(NTV2_AUDIOSYSTEM_2)];					break;
-
 		case kRegPCMControl4321:
 		{	NTV2AudioSystem cardAudSys(KonaToCardAudSys(NTV2_AUDIOSYSTEM_1));
 			//	Mask & Shift for AudSys1 is mapped to KonaToCardAudSys
@@ -1440,24 +1522,6 @@ bool NTV2VirtualDev::NTV2ReadRegisterRemote (const ULWord inRegNum, ULWord & out
 		}
 		break;
 		
-		case kRegCh1OutputFrame:			regNum = gChannelToOutputFrameRegNum[mChannel];			break;
-		case kRegCh2OutputFrame:			regNum = gChannelToOutputFrameRegNum[mChannel+1];		break;
-		case kRegCh1InputFrame:				regNum = gChannelToInputFrameRegNum[mChannel];			break;
-		case kRegCh2InputFrame:				regNum = gChannelToInputFrameRegNum[mChannel+1];		break;
-#if !defined(NTV2_DEPRECATE_16_2)
-		case kRegCh1PCIAccessFrame:			regNum = gChannelToPCIAccessFrameRegNum[mChannel];		break;
-		case kRegCh2PCIAccessFrame:			regNum = gChannelToPCIAccessFrameRegNum[mChannel+1];	break;
-#endif	//	NTV2_DEPRECATE_16_2
-		case kRegOutputTimingControl:		regNum = gChannelToOutputTimingCtrlRegNum[mChannel+1];	break;
-		case kRegVidProc1Control:			regNum = gIndexToVidProcControlRegNum[VDevToCardMixer(NTV2_CHANNEL1)];		break;
-		case kRegMixer1Coefficient:			regNum = gIndexToVidProcMixCoeffRegNum[VDevToCardMixer(NTV2_CHANNEL1)];		break;
-		case kRegFlatMatteValue:			regNum = gIndexToVidProcFlatMatteRegNum[VDevToCardMixer(NTV2_CHANNEL1)];	break;
-		case kRegRXSDI1Status:				regNum = gChannelToRXSDIStatusRegs[mChannel];			break;
-		case kRegRXSDI2Status:				regNum = gChannelToRXSDIStatusRegs[mChannel+1];			break;
-		case kRegRXSDI1CRCErrorCount:		regNum = gChannelToRXSDICRCErrorCountRegs[mChannel];	break;
-		case kRegSDIIn1VPIDA:				regNum = gChannelToSDIInVPIDARegNum[mChannel];			break;
-		case kRegSDIIn1VPIDB:				regNum = gChannelToSDIInVPIDBRegNum[mChannel];			break;
-		
 		case kRegInputStatus:				regNum = gChannelToSDIInputStatusRegNum[mChannel];
 											if (regMask == kRegMaskInput1FrameRate)					regMask = gChannelToSDIInputRateMask[mChannel];
 											else if (regMask == kRegMaskInput2FrameRate)			regMask = gChannelToSDIInputRateMask[mChannel+1];
@@ -1509,26 +1573,17 @@ bool NTV2VirtualDev::NTV2ReadRegisterRemote (const ULWord inRegNum, ULWord & out
 
 bool NTV2VirtualDev::NTV2WriteRegisterRemote (const ULWord inRegNum, const ULWord inRegVal, const ULWord inRegMask, const ULWord inRegShift)
 {
-	if (isMyAncExtRegister(inRegNum))
-		return HandleWriteAncExt(inRegNum, inRegVal, inRegMask, inRegShift);	//	Handle all anc ext regs
-	if (isMyAncInsRegister(inRegNum))
-		return HandleWriteAncIns(inRegNum, inRegVal, inRegMask, inRegShift);	//	Handle all anc ins regs
-	if (isMyXptSelectRegister(inRegNum))
-		return HandleWriteXptSelectReg(inRegNum, inRegVal, inRegMask, inRegShift);
+	const VDevRegXlate & xlate (WriteXlate(inRegNum));
+	switch (xlate.fKind)
+	{
+		case VDevReg_PassThru:	return mCard.WriteRegister(inRegNum, inRegVal, inRegMask, inRegShift);
+		case VDevReg_Remap:		return mCard.WriteRegister(xlate.fValue, inRegVal, inRegMask, inRegShift);
+		case VDevReg_XptSelect:	return HandleWriteXptSelectReg(inRegNum, inRegVal, inRegMask, inRegShift);
+		case VDevReg_Special:	break;
+	}
 	ULWord regNum(inRegNum), regMask(inRegMask), regShift(inRegShift);
 	switch (regNum)
 	{
-		case kRegAud1Control:				regNum = gAudioSystemToAudioControlRegNum[KonaToCardAudSys(NTV2_AUDIOSYSTEM_1)];	break;
-		case kRegAud1SourceSelect:			regNum = gAudioSystemToSrcSelectRegNum[KonaToCardAudSys(NTV2_AUDIOSYSTEM_1)];		break;
-		case kRegAud1OutputLastAddr:		regNum = gChannelToAudioOutLastAddrRegNum[KonaToCardAudSys(NTV2_AUDIOSYSTEM_1)];	break;
-		case kRegAud1InputLastAddr:			regNum = gChannelToAudioInLastAddrRegNum[KonaToCardAudSys(NTV2_AUDIOSYSTEM_1)];		break;
-		case kRegAud1Delay:					regNum = gAudioDelayRegisterNumbers[KonaToCardAudSys(NTV2_AUDIOSYSTEM_1)];			break;
-		case kRegAud2Control:				regNum = gAudioSystemToAudioControlRegNum[KonaToCardAudSys(NTV2_AUDIOSYSTEM_2)];	break;
-		case kRegAud2SourceSelect:			regNum = gAudioSystemToSrcSelectRegNum[KonaToCardAudSys(NTV2_AUDIOSYSTEM_2)];		break;
-		case kRegAud2OutputLastAddr:		regNum = gChannelToAudioOutLastAddrRegNum[KonaToCardAudSys(NTV2_AUDIOSYSTEM_2)];	break;
-		case kRegAud2InputLastAddr:			regNum = gChannelToAudioInLastAddrRegNum[KonaToCardAudSys(NTV2_AUDIOSYSTEM_2)];		break;
-		case kRegAud2Delay:					regNum = gAudioDelayRegisterNumbers[KonaToCardAudSys(NTV2_AUDIOSYSTEM_2)];			break;
-
 		case kRegPCMControl4321:
 		{	NTV2AudioSystem cardAudSys(KonaToCardAudSys(NTV2_AUDIOSYSTEM_1));
 			if (cardAudSys == NTV2_AUDIOSYSTEM_1)
@@ -1571,12 +1626,6 @@ bool NTV2VirtualDev::NTV2WriteRegisterRemote (const ULWord inRegNum, const ULWor
 		}
 
 		case kRegSDITransmitControl:	return HandleWriteSDITransmitControl(inRegNum, inRegVal, inRegMask, inRegShift);
-		case kRegVidProc1Control:	regNum = gIndexToVidProcControlRegNum[VDevToCardMixer(NTV2_CHANNEL1)];		break;
-		case kRegMixer1Coefficient:	regNum = gIndexToVidProcMixCoeffRegNum[VDevToCardMixer(NTV2_CHANNEL1)];		break;
-		case kRegFlatMatteValue:	regNum = gIndexToVidProcFlatMatteRegNum[VDevToCardMixer(NTV2_CHANNEL1)];	break;
-
-		case kRegCh1Control:		regNum = gChannelToControlRegNum[mChannel];		break;
-		case kRegCh2Control:		regNum = gChannelToControlRegNum[mChannel+1];	break;
 
 //		case kRegGlobalControl:
 //		case kRegGlobalControl2:	return HandleWriteGlobalControl(regNum, inRegVal, regMask, regShift);
@@ -1667,16 +1716,49 @@ bool NTV2VirtualDev::NTV2DMATransferRemote (const NTV2DMAEngine inDMAEngine,		co
 								inSegmentCardPitch, inSync);
 }
 
+bool NTV2VirtualDev::HandleGetRegisters (NTV2GetRegisters & inOutGetRegs)
+{	//	Let the underlying device read the whole batch in one go -- that's already right for pass-thru registers.
+	//	Then patch in the values of any translated registers, reading all remapped registers in one more batch,
+	//	and only doing one-at-a-time reads for the few registers that need special handling...
+	NTV2RegNumSet regNums;
+	if (!inOutGetRegs.GetRequestedRegisterNumbers(regNums))
+		return false;
+	if (!mCard.NTV2Message(inOutGetRegs))
+		return false;	//	Caller will fall back to reading one-at-a-time
+
+	NTV2RegisterReads	remapReads;		//	Card registers to read for VDev registers that are just renumbered
+	ULWordSequence		remapVDevRegs;	//	VDev register number for each remapReads entry
+	for (NTV2RegNumSetConstIter it(regNums.begin());  it != regNums.end();  ++it)
+	{
+		const VDevRegXlate & xlate (ReadXlate(*it));
+		if (xlate.fKind == VDevReg_PassThru)
+			continue;
+		if (xlate.fKind == VDevReg_Remap)
+			{remapReads.push_back(NTV2RegInfo(xlate.fValue));  remapVDevRegs.push_back(*it);  continue;}
+		ULWord regValue(0);		//	VDevReg_XptSelect or VDevReg_Special
+		if (!NTV2ReadRegisterRemote (*it, regValue)  ||  !inOutGetRegs.PatchRegister(*it, regValue))
+			return false;
+	}
+	if (remapReads.empty())
+		return true;
+	if (!mCard.ReadRegisters(remapReads))
+		return false;
+	for (size_t ndx(0);  ndx < remapReads.size();  ndx++)
+		if (!inOutGetRegs.PatchRegister(remapVDevRegs.at(ndx), remapReads.at(ndx).registerValue))
+			return false;
+	return true;
+}	//	HandleGetRegisters
+
 bool NTV2VirtualDev::NTV2MessageRemote (NTV2_HEADER * pMsg)
 {
 	if (!pMsg)
 		return false;
-	//	To simplify things, turn GETREGS/SETREGS messages into individual ReadRegister/WriteRegister calls
-	//	so that we have one-stop-shopping for register reads/writes in NTV2ReadRegisterRemote & NTV2WriteRegisterRemote
+	//	To simplify things, turn SETREGS messages into individual WriteRegister calls
+	//	so that we have one-stop-shopping for register writes in NTV2WriteRegisterRemote
 	if (pMsg->GetType() == NTV2_TYPE_SETREGS)
-		return false;	//	force CNTV2DriverInterface::ReadRegisters to call ReadRegister one-at-a-time
-	if (pMsg->GetType() == NTV2_TYPE_GETREGS)
 		return false;	//	force CNTV2Card::WriteRegisters to call WriteRegister one-at-a-time
+	if (pMsg->GetType() == NTV2_TYPE_GETREGS)	//	Batch the pass-thru & remapped register reads
+		return HandleGetRegisters(*AsNTV2GetRegisters(pMsg));
 	if (pMsg->GetType() == NTV2_TYPE_ACSTATUS)		//	AUTOCIRCULATE_STATUS
 	{
 		AUTOCIRCULATE_STATUS * pStatus = reinterpret_cast<AUTOCIRCULATE_STATUS*>(pMsg);
@@ -38,7 +38,7 @@ static void SignalHandler (int inSignal)
 int main(int argc, const char ** argv)
 {
 	char	*pDeviceSpec(AJA_NULL), *pInputFileName(AJA_NULL);
-	int		doStdout(0), doSDRAM(0), waitSeconds(0), forceLoad(0), isVerbose(0), showVersion(0);
+	int		doStdout(0), doSDRAM(0), doCompact(0), doSnapshot(0), waitSeconds(0), forceLoad(0), isVerbose(0), showVersion(0);
 	CNTV2Card device;
 	poptContext	optionsContext;	//	Context for parsing command line arguments
 
@@ -51,6 +51,8 @@ int main(int argc, const char ** argv)
 		{"forceload",	'f',	POPT_ARG_NONE,		&forceLoad,			0,	"load onto different device",		AJA_NULL},
 		{"stdout",		's',	POPT_ARG_NONE,		&doStdout,			0,	"dump to stdout instead of file?",	AJA_NULL},
 		{"sdram",		'r',	POPT_ARG_NONE,		&doSDRAM,			0,	"dump device SDRAM to .raw file?",	AJA_NULL},
+		{"compact",		'c',	POPT_ARG_NONE,		&doCompact,			0,	"compact SDRAM dump (.sdram file)?",	AJA_NULL},
+		{"snapshot",	'n',	POPT_ARG_NONE,		&doSnapshot,		0,	"register snapshot (.regs file)?",	AJA_NULL},
 		{"verbose",		'v',	POPT_ARG_NONE,		&isVerbose,			0,	"verbose mode?",					AJA_NULL},
 		{"wait",		'w',	POPT_ARG_INT,		&waitSeconds,		0,	"time to wait before capture",		"seconds"},
 		POPT_AUTOHELP
@@ -69,6 +71,8 @@ int main(int argc, const char ** argv)
 	const string deviceSpec	(pDeviceSpec ? pDeviceSpec : "0");
 	if (!CNTV2DeviceScanner::GetFirstDeviceFromArgument(deviceSpec, device))
 		{cerr << "## ERROR: Device '" << deviceSpec << "' failed to open or does not exist" << endl;  return 2;}
+	if (doCompact)
+		doSDRAM = 1;	//	--compact implies --sdram
 	if (doStdout && doSDRAM)
 		{cerr << "## ERROR: '--stdout' and '--sdram' options conflict -- use one or the other, but not both" << endl;  return 2;}
 	const string deviceName (CNTV2DeviceScanner::GetDeviceRefName(device));
@@ -107,13 +111,15 @@ int main(int argc, const char ** argv)
 		return 0;	//	Done!
 	}
 
-	if (doStdout)
+	if (doStdout  &&  doSnapshot)
+		logger.WriteRegisterSnapshot(cout);	//	Write snapshot to stdout...
+	else if (doStdout)
 		cout << logger << flush;	//	Write log to stdout...
 	else
 	{	//	Write log to file...
 		ostringstream SupportLogFileName, RamDumpFileName;
 		SupportLogFileName << CNTV2SupportLogger::InventLogFilePathAndName(device);
-		RamDumpFileName << CNTV2SupportLogger::InventLogFilePathAndName(device, "aja_sdram", "raw");
+		RamDumpFileName << CNTV2SupportLogger::InventLogFilePathAndName(device, "aja_sdram", doCompact ? "sdram" : "raw");
 		ofstream ofs(SupportLogFileName.str());
 		if (ofs)
 		{
@@ -122,9 +128,18 @@ int main(int argc, const char ** argv)
 		}
 		if (isVerbose)
 			cout << "## NOTE: Support log for device '" << deviceName << "' written to '" << SupportLogFileName.str() << "'" << endl;
+		if (doSnapshot)
+		{
+			const string snapshotFileName (CNTV2SupportLogger::InventLogFilePathAndName(device, "aja_regsnapshot", "regs"));
+			ofstream snapshotOFS(snapshotFileName.c_str());
+			if (!snapshotOFS  ||  !logger.WriteRegisterSnapshot(snapshotOFS))
+				cerr << "## ERROR: Failed to write register snapshot '" << snapshotFileName << "'" << endl;
+			else if (isVerbose)
+				cout << "## NOTE: Register snapshot for device '" << deviceName << "' written to '" << snapshotFileName << "'" << endl;
+		}
 		if (doSDRAM)
 		{	ostringstream oss;
-			if (!CNTV2SupportLogger::DumpDeviceSDRAM (device, RamDumpFileName.str(), oss))
+			if (!CNTV2SupportLogger::DumpDeviceSDRAM (device, RamDumpFileName.str(), oss, doCompact ? true : false))
 				cerr << oss.str();
 			else if (isVerbose  &&  !oss.str().empty())
 				cout << oss.str();